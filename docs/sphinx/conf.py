@@ -82,4 +82,5 @@ man_pages = [
     ('manuals/roc_send', 'roc-send', u'send real-time audio', [], 1),
     ('manuals/roc_recv', 'roc-recv', u'receive real-time audio', [], 1),
     ('manuals/roc_copy', 'roc-copy', u'copy local audio', [], 1),
+    ('manuals/roc_replay', 'roc-replay', u'replay captured packets', [], 1),
 ]
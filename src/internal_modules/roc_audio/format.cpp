@@ -19,6 +19,9 @@ const FormatTraits formats[] = {
     { Format_Pcm, "pcm",
       Format_SupportsNetwork | Format_SupportsDevices | Format_SupportsFiles },
     { Format_Wav, "wav", Format_SupportsFiles },
+#ifdef ROC_TARGET_LIBOPUS
+    { Format_Opus, "opus", Format_SupportsNetwork },
+#endif // ROC_TARGET_LIBOPUS
 };
 
 } // namespace
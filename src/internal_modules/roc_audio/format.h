@@ -41,6 +41,15 @@ enum Format {
     //!  supported. If sub-format is omitted, default sub-format is used.
     Format_Wav,
 
+    //! Opus compressed packets (RFC 6716).
+    //! @note
+    //!  Can be used for network packets.
+    //! @note
+    //!  This format doesn't use sub-format. Supported rates are 8000, 12000,
+    //!  16000, 24000, and 48000, supported channels are mono and stereo.
+    //!  Only available when built with libopus.
+    Format_Opus,
+
     //! Custom opaque format.
     //! @remarks
     //!  Used to specify custom format for file or device via its string
@@ -26,13 +26,41 @@ bool JitterMeterConfig::deduce_defaults(audio::LatencyTunerProfile latency_profi
 
 JitterMeter::JitterMeter(const JitterMeterConfig& config, core::IArena& arena)
     : config_(config)
-    , jitter_window_(arena, config.jitter_window)
     , smooth_jitter_window_(arena, config.envelope_smoothing_window_len)
-    , envelope_window_(arena, config.peak_quantile_window, config.peak_quantile_coeff)
-    , peak_window_(arena, config.jitter_window)
     , capacitor_charge_(0)
     , capacitor_discharge_resistance_(0)
     , capacitor_discharge_iteration_(0) {
+    switch (config_.estimator) {
+    case JitterEstimator_Exact:
+        jitter_window_.reset(new (jitter_window_)
+                                 stat::MovAggregate<core::nanoseconds_t>(
+                                     arena, config.jitter_window));
+        envelope_window_.reset(new (envelope_window_)
+                                   stat::MovQuantile<core::nanoseconds_t>(
+                                       arena, config.peak_quantile_window,
+                                       config.peak_quantile_coeff));
+        peak_window_.reset(new (peak_window_) stat::MovAggregate<core::nanoseconds_t>(
+            arena, config.jitter_window));
+        break;
+
+    case JitterEstimator_Blocks:
+        block_jitter_window_.reset(new (block_jitter_window_)
+                                       stat::MovBlockAggregate<core::nanoseconds_t>(
+                                           arena, config.jitter_window,
+                                           config.estimator_blocks));
+        block_envelope_window_.reset(
+            new (block_envelope_window_) stat::MovBlockQuantile<core::nanoseconds_t>(
+                arena, config.peak_quantile_window, config.peak_quantile_coeff,
+                config.estimator_blocks, config.estimator_points));
+        block_peak_window_.reset(new (block_peak_window_)
+                                     stat::MovBlockAggregate<core::nanoseconds_t>(
+                                         arena, config.jitter_window,
+                                         config.estimator_blocks));
+        break;
+
+    default:
+        roc_panic("jitter meter: unexpected estimator: %d", (int)config_.estimator);
+    }
 }
 
 const JitterMetrics& JitterMeter::metrics() const {
@@ -40,23 +68,49 @@ const JitterMetrics& JitterMeter::metrics() const {
 }
 
 void JitterMeter::update_jitter(const core::nanoseconds_t jitter) {
+    if (config_.estimator == JitterEstimator_Blocks) {
+        update_blocks_(jitter);
+    } else {
+        update_exact_(jitter);
+    }
+
+    metrics_.curr_jitter = jitter;
+}
+
+void JitterMeter::update_exact_(const core::nanoseconds_t jitter) {
     // Moving average of jitter.
-    jitter_window_.add(jitter);
+    jitter_window_->add(jitter);
 
     // Update current value of jitter envelope based on current value of jitter.
     // Envelope is computed based on smoothed jitter + a leaky peak detector.
     smooth_jitter_window_.add(jitter);
     const core::nanoseconds_t jitter_envelope =
-        update_envelope_(smooth_jitter_window_.mov_max(), jitter_window_.mov_avg());
+        update_envelope_(smooth_jitter_window_.mov_max(), jitter_window_->mov_avg());
 
     // Quantile of envelope.
-    envelope_window_.add(jitter_envelope);
+    envelope_window_->add(jitter_envelope);
     // Moving maximum of quantile of envelope.
-    peak_window_.add(envelope_window_.mov_quantile());
+    peak_window_->add(envelope_window_->mov_quantile());
 
-    metrics_.mean_jitter = jitter_window_.mov_avg();
-    metrics_.peak_jitter = peak_window_.mov_max();
-    metrics_.curr_jitter = jitter;
+    metrics_.mean_jitter = jitter_window_->mov_avg();
+    metrics_.peak_jitter = peak_window_->mov_max();
+    metrics_.curr_envelope = jitter_envelope;
+}
+
+// Same as update_exact_(), but long windows are replaced with their
+// block-based approximations.
+void JitterMeter::update_blocks_(const core::nanoseconds_t jitter) {
+    block_jitter_window_->add(jitter);
+
+    smooth_jitter_window_.add(jitter);
+    const core::nanoseconds_t jitter_envelope = update_envelope_(
+        smooth_jitter_window_.mov_max(), block_jitter_window_->mov_avg());
+
+    block_envelope_window_->add(jitter_envelope);
+    block_peak_window_->add(block_envelope_window_->mov_quantile());
+
+    metrics_.mean_jitter = block_jitter_window_->mov_avg();
+    metrics_.peak_jitter = block_peak_window_->mov_max();
     metrics_.curr_envelope = jitter_envelope;
 }
 
@@ -136,5 +190,17 @@ core::nanoseconds_t JitterMeter::update_envelope_(const core::nanoseconds_t cur_
     return capacitor_charge_;
 }
 
+const char* jitter_estimator_to_str(JitterEstimator estimator) {
+    switch (estimator) {
+    case JitterEstimator_Exact:
+        return "exact";
+
+    case JitterEstimator_Blocks:
+        return "blocks";
+    }
+
+    return "<invalid>";
+}
+
 } // namespace audio
 } // namespace roc
@@ -15,13 +15,31 @@
 #include "roc_audio/latency_config.h"
 #include "roc_core/iarena.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
 #include "roc_core/time.h"
 #include "roc_stat/mov_aggregate.h"
+#include "roc_stat/mov_block_aggregate.h"
+#include "roc_stat/mov_block_quantile.h"
 #include "roc_stat/mov_quantile.h"
 
 namespace roc {
 namespace audio {
 
+//! Jitter estimator.
+//! Defines how sliding window statistics are computed.
+enum JitterEstimator {
+    //! Exact moving statistics.
+    //! Memory is proportional to window sizes (a few megabytes with
+    //! default settings).
+    JitterEstimator_Exact,
+
+    //! Approximate moving statistics based on block summaries.
+    //! Memory is proportional to the number of blocks (a few kilobytes with
+    //! default settings), windows slide by blocks instead of packets, and
+    //! envelope quantile has bounded rank error.
+    JitterEstimator_Blocks
+};
+
 //! Jitter meter parameters.
 //!
 //! Mean jitter is calculated as moving average of last `jitter_window` packets.
@@ -94,13 +112,32 @@ struct JitterMeterConfig {
     //!  of all envelope values across the quantile window.
     double peak_quantile_coeff;
 
+    //! How to compute sliding window statistics.
+    JitterEstimator estimator;
+
+    //! Number of blocks per window for JitterEstimator_Blocks.
+    //! @remarks
+    //!  Windows slide by 1/estimator_blocks of their length. Increase this
+    //!  value to make windows slide more smoothly, at the cost of memory.
+    size_t estimator_blocks;
+
+    //! Number of points kept per block of envelope quantile window for
+    //! JitterEstimator_Blocks.
+    //! @remarks
+    //!  Increase this value to reduce envelope quantile error, at the cost
+    //!  of memory.
+    size_t estimator_points;
+
     JitterMeterConfig()
         : jitter_window(50000)
         , envelope_smoothing_window_len(10)
         , envelope_resistance_exponent(6)
         , envelope_resistance_coeff(0)
         , peak_quantile_window(10000)
-        , peak_quantile_coeff(0.92) {
+        , peak_quantile_coeff(0.92)
+        , estimator(JitterEstimator_Exact)
+        , estimator_blocks(64)
+        , estimator_points(16) {
     }
 
     //! Automatically fill missing settings.
@@ -148,20 +185,33 @@ private:
     core::nanoseconds_t update_envelope_(core::nanoseconds_t cur_jitter,
                                          core::nanoseconds_t avg_jitter);
 
+    void update_exact_(core::nanoseconds_t jitter);
+    void update_blocks_(core::nanoseconds_t jitter);
+
     const JitterMeterConfig config_;
 
     JitterMetrics metrics_;
 
-    stat::MovAggregate<core::nanoseconds_t> jitter_window_;
     stat::MovAggregate<core::nanoseconds_t> smooth_jitter_window_;
-    stat::MovQuantile<core::nanoseconds_t> envelope_window_;
-    stat::MovAggregate<core::nanoseconds_t> peak_window_;
+
+    // Used with JitterEstimator_Exact.
+    core::Optional<stat::MovAggregate<core::nanoseconds_t> > jitter_window_;
+    core::Optional<stat::MovQuantile<core::nanoseconds_t> > envelope_window_;
+    core::Optional<stat::MovAggregate<core::nanoseconds_t> > peak_window_;
+
+    // Used with JitterEstimator_Blocks.
+    core::Optional<stat::MovBlockAggregate<core::nanoseconds_t> > block_jitter_window_;
+    core::Optional<stat::MovBlockQuantile<core::nanoseconds_t> > block_envelope_window_;
+    core::Optional<stat::MovBlockAggregate<core::nanoseconds_t> > block_peak_window_;
 
     core::nanoseconds_t capacitor_charge_;
     double capacitor_discharge_resistance_;
     double capacitor_discharge_iteration_;
 };
 
+//! Get string name of jitter estimator.
+const char* jitter_estimator_to_str(JitterEstimator estimator);
+
 } // namespace audio
 } // namespace roc
 
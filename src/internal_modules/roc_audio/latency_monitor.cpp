@@ -35,6 +35,7 @@ LatencyMonitor::LatencyMonitor(IFrameReader& frame_reader,
     , resampler_(resampler)
     , enable_scaling_(latency_config.tuner_profile != audio::LatencyTunerProfile_Intact)
     , capture_ts_(0)
+    , current_time_(0)
     , packet_sample_spec_(packet_sample_spec)
     , frame_sample_spec_(frame_sample_spec)
     , init_status_(status::NoStatus) {
@@ -86,6 +87,12 @@ status::StatusCode LatencyMonitor::read(Frame& frame,
     return status::StatusOK;
 }
 
+void LatencyMonitor::refresh(core::nanoseconds_t current_time) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    current_time_ = current_time;
+}
+
 void LatencyMonitor::reclock(const core::nanoseconds_t playback_timestamp) {
     roc_panic_if(init_status_ != status::StatusOK);
 
@@ -146,7 +153,8 @@ void LatencyMonitor::compute_niq_latency_() {
 
     // compute delay since last packet
     const core::nanoseconds_t rts = latest_packet->receive_timestamp();
-    const core::nanoseconds_t now = core::timestamp(core::ClockUnix);
+    const core::nanoseconds_t now =
+        current_time_ > 0 ? current_time_ : core::timestamp(core::ClockUnix);
 
     if (rts > 0 && rts < now) {
         latency_metrics_.niq_stalling = now - rts;
@@ -85,6 +85,14 @@ public:
     virtual ROC_NODISCARD status::StatusCode
     read(Frame& frame, packet::stream_timestamp_t duration, FrameReadMode mode);
 
+    //! Update current time.
+    //! @remarks
+    //!  Pipeline invokes this method before reading frame when it's driven
+    //!  by virtual clock (e.g. in replay). Current time is used to compute how
+    //!  long there were no new packets. If it was never invoked, system clock
+    //!  is used.
+    void refresh(core::nanoseconds_t current_time);
+
     //! Report playback timestamp of last frame returned by read.
     //! @remarks
     //!  Pipeline invokes this method after adding last frame to
@@ -118,6 +126,7 @@ private:
     const bool enable_scaling_;
 
     core::nanoseconds_t capture_ts_;
+    core::nanoseconds_t current_time_;
 
     const SampleSpec packet_sample_spec_;
     const SampleSpec frame_sample_spec_;
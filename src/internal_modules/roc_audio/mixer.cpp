@@ -8,6 +8,7 @@
 
 #include "roc_audio/mixer.h"
 #include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/buffer_view.h"
 #include "roc_core/panic.h"
 #include "roc_status/code_to_str.h"
 
@@ -20,6 +21,7 @@ Mixer::Mixer(const SampleSpec& sample_spec,
              core::IArena& arena)
     : frame_factory_(frame_factory)
     , inputs_(arena)
+    , mix_func_(NULL)
     , sample_spec_(sample_spec)
     , enable_timestamps_(enable_timestamps)
     , init_status_(status::NoStatus) {
@@ -33,6 +35,12 @@ Mixer::Mixer(const SampleSpec& sample_spec,
         return;
     }
 
+    direct_frame_ = frame_factory_.allocate_frame_no_buffer();
+    if (!direct_frame_) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
     mix_buffer_ = frame_factory_.new_raw_buffer();
     if (!mix_buffer_) {
         init_status_ = status::StatusNoMem;
@@ -41,6 +49,11 @@ Mixer::Mixer(const SampleSpec& sample_spec,
 
     memset(mix_buffer_.data(), 0, mix_buffer_.size() * sizeof(sample_t));
 
+    const MixerKernel kernel = mixer_kernel_resolve(MixerKernel_Auto);
+    mix_func_ = mixer_kernel_func(kernel);
+
+    roc_log(LogDebug, "mixer: initializing: kernel=%s", mixer_kernel_to_str(kernel));
+
     init_status_ = status::StatusOK;
 }
 
@@ -51,13 +64,7 @@ status::StatusCode Mixer::init_status() const {
 bool Mixer::has_input(IFrameReader& reader) {
     roc_panic_if(init_status_ != status::StatusOK);
 
-    for (size_t ni = 0; ni < inputs_.size(); ni++) {
-        if (inputs_[ni].reader == &reader) {
-            return true;
-        }
-    }
-
-    return false;
+    return find_input_(reader) != NULL;
 }
 
 ROC_NODISCARD status::StatusCode Mixer::add_input(IFrameReader& reader) {
@@ -111,6 +118,28 @@ void Mixer::remove_input(IFrameReader& reader) {
     }
 }
 
+void Mixer::set_input_gain(IFrameReader& reader, sample_t gain) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    Input* input = find_input_(reader);
+    if (!input) {
+        roc_panic("mixer: can't set input gain: reader not found");
+    }
+
+    input->gain = gain;
+}
+
+sample_t Mixer::input_gain(IFrameReader& reader) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    Input* input = find_input_(reader);
+    if (!input) {
+        roc_panic("mixer: can't get input gain: reader not found");
+    }
+
+    return input->gain;
+}
+
 status::StatusCode
 Mixer::read(Frame& out_frame, packet::stream_timestamp_t duration, FrameReadMode mode) {
     roc_panic_if(init_status_ != status::StatusOK);
@@ -215,10 +244,29 @@ status::StatusCode Mixer::mix_all_(sample_t* out_data,
         }
     }
 
+    // If no input has pending samples from previous read, mix buffer contains
+    // only zeros, and we can mix directly into output buffer. Otherwise, we
+    // continue mixing into mix buffer where pending samples are stored.
+    bool mix_into_output = true;
+    for (size_t ni = 0; ni < n_inputs; ni++) {
+        if (inputs_[ni].n_mixed != 0) {
+            mix_into_output = false;
+            break;
+        }
+    }
+
+    // If there is only one input with unity gain, there is nothing to mix,
+    // and input can write samples directly into output buffer.
+    const bool direct_read = mix_into_output && n_inputs == 1 && inputs_[0].gain == 1;
+
     // Mix all inputs into mix buffer.
-    sample_t* mix_data = mix_buffer_.data();
+    sample_t* mix_data = mix_into_output ? out_data : mix_buffer_.data();
     const size_t mix_size = out_size;
 
+    if (mix_into_output && !direct_read) {
+        memset(out_data, 0, out_size * sizeof(sample_t));
+    }
+
     core::nanoseconds_t cts_base = 0;
     double cts_sum = 0;
     size_t cts_count = 0;
@@ -232,10 +280,17 @@ status::StatusCode Mixer::mix_all_(sample_t* out_data,
         // Read samples from input and mix them into mix buffer.
         // Each input tracks how much samples it already added to mix buffer,
         // and will only samples remaining up to requested size.
-        const status::StatusCode code = mix_one_(input, mix_data, mix_size, mode);
+        const status::StatusCode code =
+            mix_one_(input, mix_data, mix_size, direct_read, mode);
 
         if (code != status::StatusOK && code != status::StatusPart
             && code != status::StatusDrain) {
+            if (mix_into_output) {
+                // Preserve samples that were already mixed, so that inputs
+                // remain consistent with mix buffer.
+                memcpy(mix_buffer_.data(), out_data,
+                       std::max(max_mix_size, input.n_mixed) * sizeof(sample_t));
+            }
             return code;
         }
 
@@ -276,15 +331,31 @@ status::StatusCode Mixer::mix_all_(sample_t* out_data,
     // Below we return first min_mix_size samples to user and shift remaining
     // samples from min_mix_size to max_mix_size to the beginning of mix buffer.
 
+    if (mix_into_output) {
+        // Mixed samples are already in output frame, and mix buffer is zeroed.
+        // Save remaining samples to the beginning of mix buffer.
+        if (min_mix_size < max_mix_size) {
+            memcpy(mix_buffer_.data(), out_data + min_mix_size,
+                   (max_mix_size - min_mix_size) * sizeof(sample_t));
+        }
+    }
+
     if (min_mix_size != 0) {
-        // Copy mixed samples to output frame.
-        memcpy(out_data, mix_data, min_mix_size * sizeof(sample_t));
+        if (!mix_into_output) {
+            // Copy mixed samples to output frame.
+            memcpy(out_data, mix_data, min_mix_size * sizeof(sample_t));
+
+            // Shift mixed samples to beginning of mix buffer.
+            if (min_mix_size < max_mix_size) {
+                memmove(mix_data, mix_data + min_mix_size,
+                        (max_mix_size - min_mix_size) * sizeof(sample_t));
+            }
 
-        // Shift mixed samples to beginning of mix buffer.
-        if (min_mix_size < max_mix_size) {
-            memmove(mix_data, mix_data + min_mix_size,
-                    (max_mix_size - min_mix_size) * sizeof(sample_t));
+            // Zeroise shifted samples.
+            memset(mix_data + (max_mix_size - min_mix_size), 0,
+                   min_mix_size * sizeof(sample_t));
         }
+
         for (size_t ni = 0; ni < n_inputs; ni++) {
             Input& input = inputs_[ni];
 
@@ -293,10 +364,6 @@ status::StatusCode Mixer::mix_all_(sample_t* out_data,
                 input.cts += sample_spec_.samples_overall_2_ns(min_mix_size);
             }
         }
-
-        // Zeroise shifted samples.
-        memset(mix_data + (max_mix_size - min_mix_size), 0,
-               min_mix_size * sizeof(sample_t));
     }
 
     roc_panic_if(min_mix_size > out_size);
@@ -313,13 +380,21 @@ status::StatusCode Mixer::mix_all_(sample_t* out_data,
     return status::StatusOK;
 }
 
-status::StatusCode
-Mixer::mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode mode) {
+status::StatusCode Mixer::mix_one_(Input& input,
+                                   sample_t* mix_data,
+                                   size_t mix_size,
+                                   bool direct_read,
+                                   FrameReadMode mode) {
     roc_panic_if(input.n_mixed % sample_spec_.num_channels() != 0);
     roc_panic_if(mix_size % sample_spec_.num_channels() != 0);
 
     // If input returned StatusFinish, don't call it anymore.
     if (input.is_finished && input.n_mixed < mix_size) {
+        if (direct_read) {
+            // Output buffer was not zeroised in advance.
+            memset(mix_data + input.n_mixed, 0,
+                   (mix_size - input.n_mixed) * sizeof(sample_t));
+        }
         input.n_mixed = mix_size;
     }
 
@@ -338,16 +413,30 @@ Mixer::mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode
             sample_spec_.cap_frame_duration(remained_duration,
                                             frame_factory_.byte_buffer_size());
 
-        if (!frame_factory_.reallocate_frame(
-                *in_frame_, sample_spec_.stream_timestamp_2_bytes(capped_duration))) {
+        const size_t capped_size = sample_spec_.stream_timestamp_2_bytes(capped_duration);
+
+        // In direct mode, input frame refers to the remaining part of output
+        // buffer, and input writes samples right there.
+        core::BufferView direct_view(mix_data + input.n_mixed, capped_size);
+        Frame* in_frame = in_frame_.get();
+
+        if (direct_read) {
+            direct_frame_->set_buffer(direct_view);
+            in_frame = direct_frame_.get();
+        } else if (!frame_factory_.reallocate_frame(*in_frame_, capped_size)) {
             return status::StatusNoMem;
         }
 
         const status::StatusCode code =
-            input.reader->read(*in_frame_, capped_duration, mode);
+            input.reader->read(*in_frame, capped_duration, mode);
 
         if (code == status::StatusFinish) {
             // Stream ended and will be removed soon, pad it with zeros until that.
+            if (direct_read) {
+                direct_frame_->clear();
+                memset(mix_data + input.n_mixed, 0,
+                       (mix_size - input.n_mixed) * sizeof(sample_t));
+            }
             input.n_mixed = mix_size;
             input.is_finished = true;
             break;
@@ -357,6 +446,7 @@ Mixer::mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode
             // Soft read stopped early.
             roc_panic_if_msg(mode != ModeSoft,
                              "mixer: unexpected drained read in hard-read mode");
+            direct_frame_->clear();
             break;
         }
 
@@ -364,28 +454,26 @@ Mixer::mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode
             // Pipeline failure.
             roc_log(LogError, "mixer: can't read frame: status=%s",
                     status::code_to_str(code));
+            direct_frame_->clear();
             return code;
         }
 
-        sample_spec_.validate_frame(*in_frame_);
+        sample_spec_.validate_frame(*in_frame);
 
         // Mix samples.
-        const size_t in_size = in_frame_->num_raw_samples();
-        const sample_t* in_samples = in_frame_->raw_samples();
-        sample_t* mix_samples = mix_data + input.n_mixed;
-
-        for (size_t n = 0; n < in_size; n++) {
-            *mix_samples += *in_samples;
-
-            *mix_samples = std::min(*mix_samples, Sample_Max);
-            *mix_samples = std::max(*mix_samples, Sample_Min);
-
-            mix_samples++;
-            in_samples++;
+        const size_t in_size = in_frame->num_raw_samples();
+
+        if (!direct_read) {
+            mix_func_(mix_data + input.n_mixed, in_frame->raw_samples(), in_size,
+                      input.gain);
+        } else if (in_frame->raw_samples() != mix_data + input.n_mixed) {
+            // Input replaced our buffer with its own, fallback to copying.
+            memcpy(mix_data + input.n_mixed, in_frame->raw_samples(),
+                   in_size * sizeof(sample_t));
         }
 
         // Interpolate CTS of the first sample in mix buffer.
-        core::nanoseconds_t in_cts = in_frame_->capture_timestamp();
+        core::nanoseconds_t in_cts = in_frame->capture_timestamp();
         if (in_cts > 0) {
             in_cts -= sample_spec_.samples_overall_2_ns(input.n_mixed);
         }
@@ -396,6 +484,9 @@ Mixer::mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode
         }
 
         input.n_mixed += in_size;
+
+        // Detach output buffer before view goes out of scope.
+        direct_frame_->clear();
     }
 
     if (input.n_mixed == 0) {
@@ -413,5 +504,15 @@ Mixer::mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode
     return status::StatusOK;
 }
 
+Mixer::Input* Mixer::find_input_(IFrameReader& reader) {
+    for (size_t ni = 0; ni < inputs_.size(); ni++) {
+        if (inputs_[ni].reader == &reader) {
+            return &inputs_[ni];
+        }
+    }
+
+    return NULL;
+}
+
 } // namespace audio
 } // namespace roc
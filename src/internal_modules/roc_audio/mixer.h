@@ -14,6 +14,7 @@
 
 #include "roc_audio/frame_factory.h"
 #include "roc_audio/iframe_reader.h"
+#include "roc_audio/mixer_kernel.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/array.h"
 #include "roc_core/iarena.h"
@@ -47,6 +48,17 @@ namespace audio {
 //!
 //!    (This makes sense only when all inputs are synchronized and their
 //!    timestamps are close to each other).
+//!
+//!  - Each input may have its own gain, which is applied to its samples
+//!    before adding them to the mix.
+//!
+//!  - Samples are mixed using the fastest SIMD kernel supported by CPU,
+//!    which is selected at runtime (see MixerKernel).
+//!
+//!  - If there is only one input with unity gain, mixer doesn't use intermediate
+//!    buffers, and passes output frame buffer to input reader, so that the
+//!    last pipeline element that produces samples writes them directly into
+//!    the output frame.
 class Mixer : public IFrameReader, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -68,6 +80,15 @@ public:
     //! Remove input reader.
     void remove_input(IFrameReader& reader);
 
+    //! Set gain of input reader.
+    //! @remarks
+    //!  Samples of this input are multiplied by @p gain before mixing.
+    //!  Default gain is 1 (unchanged).
+    void set_input_gain(IFrameReader& reader, sample_t gain);
+
+    //! Get gain of input reader.
+    sample_t input_gain(IFrameReader& reader);
+
     //! Read audio frame.
     //! @remarks
     //!  Reads samples from every input reader, mixes them, and fills @p frame
@@ -86,6 +107,8 @@ private:
         size_t n_mixed;
         // capture timestamp of first sample in mix_frame_
         core::nanoseconds_t cts;
+        // multiplier applied to input samples
+        sample_t gain;
         // if true, input returned StatusFinish and should not be used
         bool is_finished;
 
@@ -93,10 +116,13 @@ private:
             : reader(NULL)
             , n_mixed(0)
             , cts(0)
+            , gain(1)
             , is_finished(false) {
         }
     };
 
+    Input* find_input_(IFrameReader& reader);
+
     status::StatusCode mix_all_repeat_(sample_t* out_data,
                                        size_t& out_size,
                                        core::nanoseconds_t& out_cts,
@@ -107,8 +133,11 @@ private:
                                 core::nanoseconds_t& out_cts,
                                 FrameReadMode mode);
 
-    status::StatusCode
-    mix_one_(Input& input, sample_t* mix_data, size_t mix_size, FrameReadMode mode);
+    status::StatusCode mix_one_(Input& input,
+                                sample_t* mix_data,
+                                size_t mix_size,
+                                bool direct_read,
+                                FrameReadMode mode);
 
     FrameFactory& frame_factory_;
 
@@ -117,9 +146,15 @@ private:
     // intermediate frame for reading
     FramePtr in_frame_;
 
+    // frame without own buffer, for reading directly into output
+    FramePtr direct_frame_;
+
     // intermediate buffer for mixing
     core::Slice<sample_t> mix_buffer_;
 
+    // function that adds input samples to mix buffer
+    MixerKernelFunc mix_func_;
+
     const SampleSpec sample_spec_;
     const bool enable_timestamps_;
 
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/panic.h"
+
+#if defined(ROC_CPU_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+void mix_scalar(sample_t* mix_samples,
+                const sample_t* in_samples,
+                size_t n_samples,
+                sample_t gain) {
+    for (size_t n = 0; n < n_samples; n++) {
+        sample_t s = mix_samples[n] + in_samples[n] * gain;
+
+        s = std::min(s, Sample_Max);
+        s = std::max(s, Sample_Min);
+
+        mix_samples[n] = s;
+    }
+}
+
+#if defined(ROC_CPU_X86_SIMD)
+
+ROC_CPU_TARGET("sse2")
+void mix_sse2(sample_t* mix_samples,
+              const sample_t* in_samples,
+              size_t n_samples,
+              sample_t gain) {
+    const __m128 v_gain = _mm_set1_ps(gain);
+    const __m128 v_min = _mm_set1_ps(Sample_Min);
+    const __m128 v_max = _mm_set1_ps(Sample_Max);
+
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        __m128 s = _mm_loadu_ps(mix_samples + n);
+        s = _mm_add_ps(s, _mm_mul_ps(_mm_loadu_ps(in_samples + n), v_gain));
+        s = _mm_max_ps(_mm_min_ps(s, v_max), v_min);
+        _mm_storeu_ps(mix_samples + n, s);
+    }
+
+    mix_scalar(mix_samples + n, in_samples + n, n_samples - n, gain);
+}
+
+ROC_CPU_TARGET("avx2")
+void mix_avx2(sample_t* mix_samples,
+              const sample_t* in_samples,
+              size_t n_samples,
+              sample_t gain) {
+    const __m256 v_gain = _mm256_set1_ps(gain);
+    const __m256 v_min = _mm256_set1_ps(Sample_Min);
+    const __m256 v_max = _mm256_set1_ps(Sample_Max);
+
+    size_t n = 0;
+
+    // Two vectors per iteration to hide latency of add.
+    for (; n + 16 <= n_samples; n += 16) {
+        __m256 s0 = _mm256_loadu_ps(mix_samples + n);
+        __m256 s1 = _mm256_loadu_ps(mix_samples + n + 8);
+        s0 = _mm256_add_ps(s0, _mm256_mul_ps(_mm256_loadu_ps(in_samples + n), v_gain));
+        s1 = _mm256_add_ps(s1,
+                           _mm256_mul_ps(_mm256_loadu_ps(in_samples + n + 8), v_gain));
+        s0 = _mm256_max_ps(_mm256_min_ps(s0, v_max), v_min);
+        s1 = _mm256_max_ps(_mm256_min_ps(s1, v_max), v_min);
+        _mm256_storeu_ps(mix_samples + n, s0);
+        _mm256_storeu_ps(mix_samples + n + 8, s1);
+    }
+
+    for (; n + 8 <= n_samples; n += 8) {
+        __m256 s = _mm256_loadu_ps(mix_samples + n);
+        s = _mm256_add_ps(s, _mm256_mul_ps(_mm256_loadu_ps(in_samples + n), v_gain));
+        s = _mm256_max_ps(_mm256_min_ps(s, v_max), v_min);
+        _mm256_storeu_ps(mix_samples + n, s);
+    }
+
+    mix_scalar(mix_samples + n, in_samples + n, n_samples - n, gain);
+}
+
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON)
+
+void mix_neon(sample_t* mix_samples,
+              const sample_t* in_samples,
+              size_t n_samples,
+              sample_t gain) {
+    const float32x4_t v_gain = vdupq_n_f32(gain);
+    const float32x4_t v_min = vdupq_n_f32(Sample_Min);
+    const float32x4_t v_max = vdupq_n_f32(Sample_Max);
+
+    size_t n = 0;
+
+    for (; n + 4 <= n_samples; n += 4) {
+        float32x4_t s = vld1q_f32(mix_samples + n);
+        s = vaddq_f32(s, vmulq_f32(vld1q_f32(in_samples + n), v_gain));
+        s = vmaxq_f32(vminq_f32(s, v_max), v_min);
+        vst1q_f32(mix_samples + n, s);
+    }
+
+    mix_scalar(mix_samples + n, in_samples + n, n_samples - n, gain);
+}
+
+#endif // ROC_CPU_ARM_NEON
+
+} // namespace
+
+bool mixer_kernel_supported(MixerKernel kernel) {
+    switch (kernel) {
+    case MixerKernel_Auto:
+    case MixerKernel_Scalar:
+        return true;
+
+    case MixerKernel_SSE2:
+#if defined(ROC_CPU_X86_SIMD)
+        return core::cpu_supports(core::CpuFeature_SSE2);
+#else
+        return false;
+#endif
+
+    case MixerKernel_AVX2:
+#if defined(ROC_CPU_X86_SIMD)
+        return core::cpu_supports(core::CpuFeature_AVX2);
+#else
+        return false;
+#endif
+
+    case MixerKernel_NEON:
+#if defined(ROC_CPU_ARM_NEON)
+        return true;
+#else
+        return false;
+#endif
+
+    case MixerKernel_Max:
+        break;
+    }
+
+    return false;
+}
+
+MixerKernel mixer_kernel_resolve(MixerKernel kernel) {
+    if (kernel != MixerKernel_Auto) {
+        return kernel;
+    }
+
+    if (mixer_kernel_supported(MixerKernel_AVX2)) {
+        return MixerKernel_AVX2;
+    }
+    if (mixer_kernel_supported(MixerKernel_SSE2)) {
+        return MixerKernel_SSE2;
+    }
+    if (mixer_kernel_supported(MixerKernel_NEON)) {
+        return MixerKernel_NEON;
+    }
+
+    return MixerKernel_Scalar;
+}
+
+MixerKernelFunc mixer_kernel_func(MixerKernel kernel) {
+    kernel = mixer_kernel_resolve(kernel);
+
+    roc_panic_if_msg(!mixer_kernel_supported(kernel),
+                     "mixer kernel: kernel not supported by cpu: kernel=%s",
+                     mixer_kernel_to_str(kernel));
+
+    switch (kernel) {
+    case MixerKernel_Scalar:
+        return &mix_scalar;
+
+#if defined(ROC_CPU_X86_SIMD)
+    case MixerKernel_SSE2:
+        return &mix_sse2;
+
+    case MixerKernel_AVX2:
+        return &mix_avx2;
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+    case MixerKernel_NEON:
+        return &mix_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("mixer kernel: unexpected kernel: kernel=%s",
+              mixer_kernel_to_str(kernel));
+}
+
+const char* mixer_kernel_to_str(MixerKernel kernel) {
+    switch (kernel) {
+    case MixerKernel_Auto:
+        return "auto";
+
+    case MixerKernel_Scalar:
+        return "scalar";
+
+    case MixerKernel_SSE2:
+        return "sse2";
+
+    case MixerKernel_AVX2:
+        return "avx2";
+
+    case MixerKernel_NEON:
+        return "neon";
+
+    case MixerKernel_Max:
+        break;
+    }
+
+    return "invalid";
+}
+
+} // namespace audio
+} // namespace roc
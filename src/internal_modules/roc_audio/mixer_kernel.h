@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/mixer_kernel.h
+//! @brief Mixer kernels.
+
+#ifndef ROC_AUDIO_MIXER_KERNEL_H_
+#define ROC_AUDIO_MIXER_KERNEL_H_
+
+#include "roc_audio/sample.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Mixer kernel implementations.
+enum MixerKernel {
+    //! Resolved to the fastest kernel supported by current CPU.
+    MixerKernel_Auto,
+
+    //! Portable scalar implementation.
+    MixerKernel_Scalar,
+
+    //! x86 SSE2 implementation.
+    MixerKernel_SSE2,
+
+    //! x86 AVX2 implementation.
+    MixerKernel_AVX2,
+
+    //! ARM NEON implementation.
+    MixerKernel_NEON,
+
+    //! Maximum enum value.
+    MixerKernel_Max
+};
+
+//! Mixer kernel function.
+//! @remarks
+//!  For every n in [0; n_samples), computes:
+//!  @code
+//!   mix_samples[n] = clamp(mix_samples[n] + in_samples[n] * gain,
+//!                          Sample_Min, Sample_Max)
+//!  @endcode
+//!  Buffers don't need to be aligned.
+typedef void (*MixerKernelFunc)(sample_t* mix_samples,
+                                const sample_t* in_samples,
+                                size_t n_samples,
+                                sample_t gain);
+
+//! Check if kernel can be used on current CPU.
+bool mixer_kernel_supported(MixerKernel kernel);
+
+//! Resolve MixerKernel_Auto to the fastest supported kernel.
+//! Other values are returned as is.
+MixerKernel mixer_kernel_resolve(MixerKernel kernel);
+
+//! Get kernel function.
+//! @pre
+//!  @p kernel should be supported by current CPU.
+MixerKernelFunc mixer_kernel_func(MixerKernel kernel);
+
+//! Get string name of mixer kernel.
+const char* mixer_kernel_to_str(MixerKernel kernel);
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_MIXER_KERNEL_H_
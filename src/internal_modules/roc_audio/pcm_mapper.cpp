@@ -28,6 +28,9 @@ PcmMapper::PcmMapper(PcmSubformat input_fmt, PcmSubformat output_fmt)
     if (!(map_func_ = pcm_subformat_mapfn(input_fmt, output_fmt))) {
         roc_panic("pcm mapper: unable to select mapping function");
     }
+
+    // May be NULL if there is no fast path for this pair or CPU.
+    fast_map_func_ = pcm_subformat_fast_mapfn(input_fmt, output_fmt);
 }
 
 PcmSubformat PcmMapper::input_format() const {
@@ -82,7 +85,17 @@ size_t PcmMapper::map(const void* in_data,
     n_samples =
         std::min(n_samples, (out_byte_size * 8 - out_bit_off) / output_traits_.bit_width);
 
-    if (n_samples != 0) {
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (fast_map_func_ && in_bit_off % 8 == 0 && out_bit_off % 8 == 0) {
+        fast_map_func_((const uint8_t*)in_data + in_bit_off / 8,
+                       (uint8_t*)out_data + out_bit_off / 8, n_samples);
+
+        in_bit_off += n_samples * input_traits_.bit_width;
+        out_bit_off += n_samples * output_traits_.bit_width;
+    } else {
         map_func_((const uint8_t*)in_data, in_bit_off, (uint8_t*)out_data, out_bit_off,
                   n_samples);
     }
@@ -67,6 +67,9 @@ public:
     //! @note
     //!  increments @p in_bit_off and @p out_bit_off by the number
     //!  of mapped bits
+    //! @note
+    //!  if both offsets are byte-aligned and there is a SIMD fast path
+    //!  for the format pair, it is used instead of generic mapping
     size_t map(const void* in_data,
                size_t in_byte_size,
                size_t& in_bit_off,
@@ -83,6 +86,7 @@ private:
     const PcmTraits output_traits_;
 
     PcmMapFn map_func_;
+    PcmFastMapFn fast_map_func_;
 };
 
 } // namespace audio
@@ -5,9 +5,18 @@
 #include "roc_audio/pcm_subformat.h"
 #include "roc_audio/pcm_subformat_rw.h"
 #include "roc_core/attributes.h"
+#include "roc_core/cpu_features.h"
 #include "roc_core/cpu_traits.h"
 #include "roc_core/stddefs.h"
 
+#if defined(ROC_CPU_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
 namespace roc {
 namespace audio {
 
@@ -4163,6 +4172,460 @@ PcmMapFn pcm_map_from_raw(PcmSubformat raw_format) {
     return NULL;
 }
 
+// Map samples using generic mapper, starting from byte boundary
+template <PcmCode InCode, PcmEndian InEndian, PcmCode OutCode, PcmEndian OutEndian>
+inline void pcm_fast_map_tail(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+    size_t in_bit_off = 0;
+    size_t out_bit_off = 0;
+
+    pcm_mapper<InCode, InEndian, OutCode, OutEndian>::map(in_data, in_bit_off, out_data,
+                                                          out_bit_off, n_samples);
+}
+
+// Byte-aligned fast path implementation
+//
+// Defined for pairs of byte-aligned code and raw code. Processes multiple
+// samples per iteration using SIMD, and falls back to generic mapper for
+// the remaining samples. Results are identical to generic mapper.
+//
+// select() returns best implementation for current CPU, or NULL.
+template <PcmCode InCode, PcmEndian InEndian, PcmCode OutCode, PcmEndian OutEndian>
+struct pcm_fast_mapper;
+
+// SInt16 to raw
+template <PcmEndian InEndian>
+struct pcm_fast_mapper<PcmCode_SInt16, InEndian, PcmCode_Float32, PcmEndian_Default> {
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const __m128i swap =
+            _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+
+        float* out = (float*)out_data;
+        size_t n = 0;
+
+        for (; n + 8 <= n_samples; n += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(in_data + n * 2));
+            if (InEndian != PcmEndian_Default) {
+                v = _mm_shuffle_epi8(v, swap);
+            }
+            // sign extension
+            const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+            const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+            _mm_storeu_ps(out + n, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+            _mm_storeu_ps(out + n + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+        }
+
+        pcm_fast_map_tail<PcmCode_SInt16, InEndian, PcmCode_Float32, PcmEndian_Default>(
+            in_data + n * 2, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+    static void map_neon(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const float32x4_t scale = vdupq_n_f32(1.0f / 32768.0f);
+
+        float* out = (float*)out_data;
+        size_t n = 0;
+
+        for (; n + 8 <= n_samples; n += 8) {
+            uint8x16_t b = vld1q_u8(in_data + n * 2);
+            if (InEndian != PcmEndian_Default) {
+                b = vrev16q_u8(b);
+            }
+            const int16x8_t v = vreinterpretq_s16_u8(b);
+            const int32x4_t lo = vmovl_s16(vget_low_s16(v));
+            const int32x4_t hi = vmovl_s16(vget_high_s16(v));
+            vst1q_f32(out + n, vmulq_f32(vcvtq_f32_s32(lo), scale));
+            vst1q_f32(out + n + 4, vmulq_f32(vcvtq_f32_s32(hi), scale));
+        }
+
+        pcm_fast_map_tail<PcmCode_SInt16, InEndian, PcmCode_Float32, PcmEndian_Default>(
+            in_data + n * 2, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_ARM_NEON
+
+    static PcmFastMapFn select() {
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+        return &map_neon;
+#endif
+        return NULL;
+    }
+};
+
+// Raw to SInt16
+template <PcmEndian OutEndian>
+struct pcm_fast_mapper<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt16, OutEndian> {
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const __m128i swap =
+            _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+        const __m128 scale = _mm_set1_ps(32768.0f);
+        const __m128 min_val = _mm_set1_ps(-32768.0f);
+        const __m128 max_val = _mm_set1_ps(32767.0f);
+
+        const float* in = (const float*)in_data;
+        size_t n = 0;
+
+        for (; n + 8 <= n_samples; n += 8) {
+            __m128 lo = _mm_mul_ps(_mm_loadu_ps(in + n), scale);
+            __m128 hi = _mm_mul_ps(_mm_loadu_ps(in + n + 4), scale);
+            // clip
+            lo = _mm_max_ps(_mm_min_ps(lo, max_val), min_val);
+            hi = _mm_max_ps(_mm_min_ps(hi, max_val), min_val);
+            __m128i v = _mm_packs_epi32(_mm_cvttps_epi32(lo), _mm_cvttps_epi32(hi));
+            if (OutEndian != PcmEndian_Default) {
+                v = _mm_shuffle_epi8(v, swap);
+            }
+            _mm_storeu_si128((__m128i*)(out_data + n * 2), v);
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt16, OutEndian>(
+            in_data + n * 4, out_data + n * 2, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+    static void map_neon(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const float32x4_t scale = vdupq_n_f32(32768.0f);
+
+        const float* in = (const float*)in_data;
+        size_t n = 0;
+
+        for (; n + 8 <= n_samples; n += 8) {
+            // conversion rounds towards zero and saturates,
+            // narrowing clips to 16 bits
+            const int32x4_t lo = vcvtq_s32_f32(vmulq_f32(vld1q_f32(in + n), scale));
+            const int32x4_t hi = vcvtq_s32_f32(vmulq_f32(vld1q_f32(in + n + 4), scale));
+            uint8x16_t b =
+                vreinterpretq_u8_s16(vcombine_s16(vqmovn_s32(lo), vqmovn_s32(hi)));
+            if (OutEndian != PcmEndian_Default) {
+                b = vrev16q_u8(b);
+            }
+            vst1q_u8(out_data + n * 2, b);
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt16, OutEndian>(
+            in_data + n * 4, out_data + n * 2, n_samples - n);
+    }
+#endif // ROC_CPU_ARM_NEON
+
+    static PcmFastMapFn select() {
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+        return &map_neon;
+#endif
+        return NULL;
+    }
+};
+
+// SInt24 to raw
+template <PcmEndian InEndian>
+struct pcm_fast_mapper<PcmCode_SInt24, InEndian, PcmCode_Float32, PcmEndian_Default> {
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        // move each 3-octet sample to upper octets of 32-bit lane
+        const __m128i shuffle = InEndian != PcmEndian_Default
+            ? _mm_setr_epi8(-1, 2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9)
+            : _mm_setr_epi8(-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+        const __m128 scale = _mm_set1_ps(1.0f / 8388608.0f);
+
+        float* out = (float*)out_data;
+        size_t n = 0;
+
+        // 4 samples per iteration, but 16 octets are loaded
+        for (; n + 6 <= n_samples; n += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(in_data + n * 3));
+            // sign extension
+            v = _mm_srai_epi32(_mm_shuffle_epi8(v, shuffle), 8);
+            _mm_storeu_ps(out + n, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+        }
+
+        pcm_fast_map_tail<PcmCode_SInt24, InEndian, PcmCode_Float32, PcmEndian_Default>(
+            in_data + n * 3, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+    static PcmFastMapFn select() {
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+        return NULL;
+    }
+};
+
+// Raw to SInt24
+template <PcmEndian OutEndian>
+struct pcm_fast_mapper<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt24, OutEndian> {
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        // move lower 3 octets of each 32-bit lane to first 12 octets
+        const __m128i shuffle = OutEndian != PcmEndian_Default
+            ? _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1)
+            : _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+        const __m128 scale = _mm_set1_ps(8388608.0f);
+        const __m128 min_val = _mm_set1_ps(-8388608.0f);
+        const __m128 max_val = _mm_set1_ps(8388607.0f);
+
+        const float* in = (const float*)in_data;
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            __m128 s = _mm_mul_ps(_mm_loadu_ps(in + n), scale);
+            // clip
+            s = _mm_max_ps(_mm_min_ps(s, max_val), min_val);
+            const __m128i v = _mm_shuffle_epi8(_mm_cvttps_epi32(s), shuffle);
+            // store 12 octets
+            const int32_t last = _mm_cvtsi128_si32(_mm_srli_si128(v, 8));
+            _mm_storel_epi64((__m128i*)(out_data + n * 3), v);
+            memcpy(out_data + n * 3 + 8, &last, 4);
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt24, OutEndian>(
+            in_data + n * 4, out_data + n * 3, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+    static PcmFastMapFn select() {
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+        return NULL;
+    }
+};
+
+// SInt32 to raw
+template <PcmEndian InEndian>
+struct pcm_fast_mapper<PcmCode_SInt32, InEndian, PcmCode_Float32, PcmEndian_Default> {
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const __m128i swap =
+            _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        const __m128 scale = _mm_set1_ps(1.0f / 2147483648.0f);
+
+        float* out = (float*)out_data;
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            __m128i v = _mm_loadu_si128((const __m128i*)(in_data + n * 4));
+            if (InEndian != PcmEndian_Default) {
+                v = _mm_shuffle_epi8(v, swap);
+            }
+            _mm_storeu_ps(out + n, _mm_mul_ps(_mm_cvtepi32_ps(v), scale));
+        }
+
+        pcm_fast_map_tail<PcmCode_SInt32, InEndian, PcmCode_Float32, PcmEndian_Default>(
+            in_data + n * 4, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+    static void map_neon(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const float32x4_t scale = vdupq_n_f32(1.0f / 2147483648.0f);
+
+        float* out = (float*)out_data;
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            uint8x16_t b = vld1q_u8(in_data + n * 4);
+            if (InEndian != PcmEndian_Default) {
+                b = vrev32q_u8(b);
+            }
+            const int32x4_t v = vreinterpretq_s32_u8(b);
+            vst1q_f32(out + n, vmulq_f32(vcvtq_f32_s32(v), scale));
+        }
+
+        pcm_fast_map_tail<PcmCode_SInt32, InEndian, PcmCode_Float32, PcmEndian_Default>(
+            in_data + n * 4, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_ARM_NEON
+
+    static PcmFastMapFn select() {
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+        return &map_neon;
+#endif
+        return NULL;
+    }
+};
+
+// Raw to SInt32
+template <PcmEndian OutEndian>
+struct pcm_fast_mapper<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt32, OutEndian> {
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const __m128i swap =
+            _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        const __m128 scale = _mm_set1_ps(2147483648.0f);
+
+        const float* in = (const float*)in_data;
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            const __m128 s = _mm_mul_ps(_mm_loadu_ps(in + n), scale);
+            // conversion returns min value on overflow, which is correct
+            // for negative values; positive values are clipped to max value
+            const __m128i overflow = _mm_castps_si128(_mm_cmpge_ps(s, scale));
+            __m128i v = _mm_xor_si128(_mm_cvttps_epi32(s), overflow);
+            if (OutEndian != PcmEndian_Default) {
+                v = _mm_shuffle_epi8(v, swap);
+            }
+            _mm_storeu_si128((__m128i*)(out_data + n * 4), v);
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt32, OutEndian>(
+            in_data + n * 4, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+    static void map_neon(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const float32x4_t scale = vdupq_n_f32(2147483648.0f);
+
+        const float* in = (const float*)in_data;
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            // conversion rounds towards zero and saturates
+            const int32x4_t v = vcvtq_s32_f32(vmulq_f32(vld1q_f32(in + n), scale));
+            uint8x16_t b = vreinterpretq_u8_s32(v);
+            if (OutEndian != PcmEndian_Default) {
+                b = vrev32q_u8(b);
+            }
+            vst1q_u8(out_data + n * 4, b);
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, PcmEndian_Default, PcmCode_SInt32, OutEndian>(
+            in_data + n * 4, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_ARM_NEON
+
+    static PcmFastMapFn select() {
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+        return &map_neon;
+#endif
+        return NULL;
+    }
+};
+
+// Float32 to/from raw
+template <PcmEndian InEndian, PcmEndian OutEndian>
+struct pcm_fast_mapper<PcmCode_Float32, InEndian, PcmCode_Float32, OutEndian> {
+    static void map_copy(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        memcpy(out_data, in_data, n_samples * 4);
+    }
+
+#if defined(ROC_CPU_X86_SIMD)
+    ROC_CPU_TARGET("ssse3")
+    static void map_ssse3(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        const __m128i swap =
+            _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            const __m128i v = _mm_loadu_si128((const __m128i*)(in_data + n * 4));
+            _mm_storeu_si128((__m128i*)(out_data + n * 4), _mm_shuffle_epi8(v, swap));
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, InEndian, PcmCode_Float32, OutEndian>(
+            in_data + n * 4, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+    static void map_neon(const uint8_t* in_data, uint8_t* out_data, size_t n_samples) {
+        size_t n = 0;
+
+        for (; n + 4 <= n_samples; n += 4) {
+            vst1q_u8(out_data + n * 4, vrev32q_u8(vld1q_u8(in_data + n * 4)));
+        }
+
+        pcm_fast_map_tail<PcmCode_Float32, InEndian, PcmCode_Float32, OutEndian>(
+            in_data + n * 4, out_data + n * 4, n_samples - n);
+    }
+#endif // ROC_CPU_ARM_NEON
+
+    static PcmFastMapFn select() {
+        if (InEndian == OutEndian) {
+            return &map_copy;
+        }
+#if defined(ROC_CPU_X86_SIMD)
+        if (core::cpu_supports(core::CpuFeature_SSSE3)) {
+            return &map_ssse3;
+        }
+#endif
+#if defined(ROC_CPU_ARM_NEON) && ROC_CPU_ENDIAN == ROC_CPU_LE
+        return &map_neon;
+#endif
+        return NULL;
+    }
+};
+
+// Select fast mapping function
+template <PcmCode InCode, PcmEndian InEndian>
+PcmFastMapFn pcm_fast_map_to_raw(PcmSubformat raw_format) {
+    switch (raw_format) {
+#if ROC_CPU_ENDIAN == ROC_CPU_BE
+    case PcmSubformat_Float32:
+    case PcmSubformat_Float32_Be:
+#else
+    case PcmSubformat_Float32:
+    case PcmSubformat_Float32_Le:
+#endif
+        return pcm_fast_mapper<InCode, InEndian, PcmCode_Float32, PcmEndian_Default>::select();
+    default:
+        break;
+    }
+    return NULL;
+}
+
+// Select fast mapping function
+template <PcmCode OutCode, PcmEndian OutEndian>
+PcmFastMapFn pcm_fast_map_from_raw(PcmSubformat raw_format) {
+    switch (raw_format) {
+#if ROC_CPU_ENDIAN == ROC_CPU_BE
+    case PcmSubformat_Float32:
+    case PcmSubformat_Float32_Be:
+#else
+    case PcmSubformat_Float32:
+    case PcmSubformat_Float32_Le:
+#endif
+        return pcm_fast_mapper<PcmCode_Float32, PcmEndian_Default, OutCode, OutEndian>::select();
+    default:
+        break;
+    }
+    return NULL;
+}
+
 } // namespace
 
 // Select mapping function
@@ -4511,6 +4974,88 @@ PcmMapFn pcm_subformat_mapfn(PcmSubformat in_format, PcmSubformat out_format) {
     return NULL;
 }
 
+// Select fast mapping function
+PcmFastMapFn pcm_subformat_fast_mapfn(PcmSubformat in_format, PcmSubformat out_format) {
+    // non-raw to raw
+    switch (in_format) {
+    case PcmSubformat_SInt16:
+        return pcm_fast_map_to_raw<PcmCode_SInt16, PcmEndian_Default>(out_format);
+    case PcmSubformat_SInt16_Be:
+        return pcm_fast_map_to_raw<PcmCode_SInt16, PcmEndian_Big>(out_format);
+    case PcmSubformat_SInt16_Le:
+        return pcm_fast_map_to_raw<PcmCode_SInt16, PcmEndian_Little>(out_format);
+    case PcmSubformat_SInt24:
+        return pcm_fast_map_to_raw<PcmCode_SInt24, PcmEndian_Default>(out_format);
+    case PcmSubformat_SInt24_Be:
+        return pcm_fast_map_to_raw<PcmCode_SInt24, PcmEndian_Big>(out_format);
+    case PcmSubformat_SInt24_Le:
+        return pcm_fast_map_to_raw<PcmCode_SInt24, PcmEndian_Little>(out_format);
+    case PcmSubformat_SInt32:
+        return pcm_fast_map_to_raw<PcmCode_SInt32, PcmEndian_Default>(out_format);
+    case PcmSubformat_SInt32_Be:
+        return pcm_fast_map_to_raw<PcmCode_SInt32, PcmEndian_Big>(out_format);
+    case PcmSubformat_SInt32_Le:
+        return pcm_fast_map_to_raw<PcmCode_SInt32, PcmEndian_Little>(out_format);
+#if ROC_CPU_ENDIAN != ROC_CPU_BE
+    case PcmSubformat_Float32_Be:
+        return pcm_fast_map_to_raw<PcmCode_Float32, PcmEndian_Big>(out_format);
+#else
+    case PcmSubformat_Float32_Le:
+        return pcm_fast_map_to_raw<PcmCode_Float32, PcmEndian_Little>(out_format);
+#endif
+    default:
+        break;
+    }
+
+    // raw to non-raw
+    switch (out_format) {
+    case PcmSubformat_SInt16:
+        return pcm_fast_map_from_raw<PcmCode_SInt16, PcmEndian_Default>(in_format);
+    case PcmSubformat_SInt16_Be:
+        return pcm_fast_map_from_raw<PcmCode_SInt16, PcmEndian_Big>(in_format);
+    case PcmSubformat_SInt16_Le:
+        return pcm_fast_map_from_raw<PcmCode_SInt16, PcmEndian_Little>(in_format);
+    case PcmSubformat_SInt24:
+        return pcm_fast_map_from_raw<PcmCode_SInt24, PcmEndian_Default>(in_format);
+    case PcmSubformat_SInt24_Be:
+        return pcm_fast_map_from_raw<PcmCode_SInt24, PcmEndian_Big>(in_format);
+    case PcmSubformat_SInt24_Le:
+        return pcm_fast_map_from_raw<PcmCode_SInt24, PcmEndian_Little>(in_format);
+    case PcmSubformat_SInt32:
+        return pcm_fast_map_from_raw<PcmCode_SInt32, PcmEndian_Default>(in_format);
+    case PcmSubformat_SInt32_Be:
+        return pcm_fast_map_from_raw<PcmCode_SInt32, PcmEndian_Big>(in_format);
+    case PcmSubformat_SInt32_Le:
+        return pcm_fast_map_from_raw<PcmCode_SInt32, PcmEndian_Little>(in_format);
+#if ROC_CPU_ENDIAN != ROC_CPU_BE
+    case PcmSubformat_Float32_Be:
+        return pcm_fast_map_from_raw<PcmCode_Float32, PcmEndian_Big>(in_format);
+#else
+    case PcmSubformat_Float32_Le:
+        return pcm_fast_map_from_raw<PcmCode_Float32, PcmEndian_Little>(in_format);
+#endif
+    default:
+        break;
+    }
+
+    // raw to raw
+    switch (out_format) {
+    case PcmSubformat_Float32:
+        return pcm_fast_map_from_raw<PcmCode_Float32, PcmEndian_Default>(in_format);
+#if ROC_CPU_ENDIAN == ROC_CPU_BE
+    case PcmSubformat_Float32_Be:
+        return pcm_fast_map_from_raw<PcmCode_Float32, PcmEndian_Default>(in_format);
+#else
+    case PcmSubformat_Float32_Le:
+        return pcm_fast_map_from_raw<PcmCode_Float32, PcmEndian_Default>(in_format);
+#endif
+    default:
+        break;
+    }
+
+    return NULL;
+}
+
 // Get format traits
 PcmTraits pcm_subformat_traits(PcmSubformat format) {
     PcmTraits traits;
@@ -304,6 +304,21 @@ typedef void (*PcmMapFn)(const uint8_t* in_data,
 //! Get mapping function for given PCM format pair.
 PcmMapFn pcm_subformat_mapfn(PcmSubformat in_format, PcmSubformat out_format);
 
+//! PCM fast-path mapping function.
+//! @remarks
+//!  Same as PcmMapFn, but both buffers should start at byte boundary,
+//!  and bit offsets are not tracked.
+typedef void (*PcmFastMapFn)(const uint8_t* in_data, uint8_t* out_data, size_t n_samples);
+
+//! Get fast-path mapping function for given PCM format pair.
+//! @remarks
+//!  Fast paths use SIMD and are available only for some byte-aligned formats
+//!  (16, 24, and 32-bit signed integers and 32-bit floats, any endian).
+//!  Results are identical to the function returned by pcm_subformat_mapfn().
+//! @returns
+//!  NULL if there is no fast path for given formats on current CPU.
+PcmFastMapFn pcm_subformat_fast_mapfn(PcmSubformat in_format, PcmSubformat out_format);
+
 //! Get format traits for given PCM format.
 PcmTraits pcm_subformat_traits(PcmSubformat format);
 
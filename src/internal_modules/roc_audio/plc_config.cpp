@@ -11,9 +11,9 @@
 namespace roc {
 namespace audio {
 
-bool PlcConfig::deduce_defaults() {
+bool PlcConfig::deduce_defaults(bool has_codec_plc) {
     if (backend == PlcBackend_Default) {
-        backend = PlcBackend_None;
+        backend = has_codec_plc ? PlcBackend_Codec : PlcBackend_None;
     }
 
     return true;
@@ -27,6 +27,8 @@ const char* plc_backend_to_str(PlcBackend backend) {
         return "none";
     case PlcBackend_Beep:
         return "beep";
+    case PlcBackend_Codec:
+        return "codec";
     case PlcBackend_Max:
         break;
     }
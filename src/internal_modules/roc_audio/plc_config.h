@@ -28,6 +28,10 @@ enum PlcBackend {
     //! Insert loud beep instead of losses.
     PlcBackend_Beep,
 
+    //! Use PLC built into packet encoding codec, if any.
+    //! If the codec doesn't provide PLC, losses are not concealed.
+    PlcBackend_Codec,
+
     //! Maximum enum value.
     PlcBackend_Max
 };
@@ -44,7 +48,10 @@ struct PlcConfig {
     }
 
     //! Automatically fill missing settings.
-    ROC_NODISCARD bool deduce_defaults();
+    //! @remarks
+    //!  @p has_codec_plc defines whether packet encoding provides its own PLC.
+    //!  If it does, it's used by default, otherwise PLC is disabled by default.
+    ROC_NODISCARD bool deduce_defaults(bool has_codec_plc);
 };
 
 //! Get string name of PLC backend.
@@ -0,0 +1,615 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/polyphase_resampler.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+#if defined(ROC_CPU_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Position and step are kept in Q32.32 format.
+const uint32_t FRACT_BIT_COUNT = 32;
+const uint64_t FRACT_PART_MASK = 0xFFFFFFFFu;
+
+// Cutoff frequency, relative to Nyquist frequency of lower rate.
+const float CUTOFF_FREQ = 0.9f;
+
+// Filter bank is built for scaling a bit higher than requested, and is
+// rebuilt only when scaling exceeds it or becomes noticeably lower.
+const float BANK_MARGIN = 1.01f;
+const float BANK_HYSTERESIS = 1.02f;
+
+// Number of taps is rounded up to multiple of this, so that dot product
+// can be computed using full vectors.
+const size_t TAPS_ALIGN = 8;
+
+// Returns log2(n) assuming that n is a power of two.
+inline size_t calc_bits(size_t n) {
+    size_t c = 0;
+    while ((n & 1) == 0 && c != sizeof(n) * 8) {
+        n >>= 1;
+        c++;
+    }
+    return c;
+}
+
+inline size_t get_window_interp(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 64;
+
+    case ResamplerProfile_Medium:
+        return 128;
+
+    case ResamplerProfile_High:
+        return 512;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+inline size_t get_window_size(ResamplerProfile profile) {
+    switch (profile) {
+    case ResamplerProfile_Low:
+        return 16;
+
+    case ResamplerProfile_Medium:
+        return 32;
+
+    case ResamplerProfile_High:
+        return 64;
+    }
+
+    roc_panic("polyphase resampler: unexpected profile");
+}
+
+inline size_t get_frame_size(size_t window_size,
+                             const SampleSpec& in_spec,
+                             const SampleSpec& out_spec) {
+    const float scaling =
+        (float)in_spec.sample_rate() / (float)out_spec.sample_rate() * 1.5f;
+
+    return (size_t)std::ceil(window_size * scaling);
+}
+
+// Number of taps on the left side of the window, including the tap at
+// the current position, for given bank scaling.
+inline size_t get_left_taps(size_t window_size, float bank_scaling) {
+    return (size_t)std::ceil((double)window_size * (double)bank_scaling
+                             / (double)CUTOFF_FREQ);
+}
+
+// Total number of taps for given number of left taps.
+inline size_t get_total_taps(size_t left_taps) {
+    return (left_taps * 2 + TAPS_ALIGN - 1) / TAPS_ALIGN * TAPS_ALIGN;
+}
+
+void dot_scalar(const sample_t* x,
+                const sample_t* h0,
+                const sample_t* h1,
+                size_t n_taps,
+                sample_t& res0,
+                sample_t& res1) {
+    sample_t acc0 = 0, acc1 = 0;
+
+    for (size_t n = 0; n < n_taps; n++) {
+        acc0 += x[n] * h0[n];
+        acc1 += x[n] * h1[n];
+    }
+
+    res0 = acc0;
+    res1 = acc1;
+}
+
+#if defined(ROC_CPU_X86_SIMD)
+
+ROC_CPU_TARGET("sse2")
+void dot_sse2(const sample_t* x,
+              const sample_t* h0,
+              const sample_t* h1,
+              size_t n_taps,
+              sample_t& res0,
+              sample_t& res1) {
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    for (size_t n = 0; n < n_taps; n += 4) {
+        const __m128 v = _mm_loadu_ps(x + n);
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(v, _mm_loadu_ps(h0 + n)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(v, _mm_loadu_ps(h1 + n)));
+    }
+
+    // Horizontal sums of both accumulators at once.
+    __m128 lo = _mm_unpacklo_ps(acc0, acc1);
+    __m128 hi = _mm_unpackhi_ps(acc0, acc1);
+    __m128 sum = _mm_add_ps(lo, hi);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+
+    float out[4];
+    _mm_storeu_ps(out, sum);
+
+    res0 = out[0];
+    res1 = out[1];
+}
+
+ROC_CPU_TARGET("avx2")
+void dot_avx2(const sample_t* x,
+              const sample_t* h0,
+              const sample_t* h1,
+              size_t n_taps,
+              sample_t& res0,
+              sample_t& res1) {
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    for (size_t n = 0; n < n_taps; n += 8) {
+        const __m256 v = _mm256_loadu_ps(x + n);
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(v, _mm256_loadu_ps(h0 + n)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(v, _mm256_loadu_ps(h1 + n)));
+    }
+
+    const __m128 s0 =
+        _mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1));
+    const __m128 s1 =
+        _mm_add_ps(_mm256_castps256_ps128(acc1), _mm256_extractf128_ps(acc1, 1));
+
+    __m128 lo = _mm_unpacklo_ps(s0, s1);
+    __m128 hi = _mm_unpackhi_ps(s0, s1);
+    __m128 sum = _mm_add_ps(lo, hi);
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+
+    float out[4];
+    _mm_storeu_ps(out, sum);
+
+    res0 = out[0];
+    res1 = out[1];
+}
+
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON)
+
+void dot_neon(const sample_t* x,
+              const sample_t* h0,
+              const sample_t* h1,
+              size_t n_taps,
+              sample_t& res0,
+              sample_t& res1) {
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+
+    for (size_t n = 0; n < n_taps; n += 4) {
+        const float32x4_t v = vld1q_f32(x + n);
+        acc0 = vmlaq_f32(acc0, v, vld1q_f32(h0 + n));
+        acc1 = vmlaq_f32(acc1, v, vld1q_f32(h1 + n));
+    }
+
+    float out0[4], out1[4];
+    vst1q_f32(out0, acc0);
+    vst1q_f32(out1, acc1);
+
+    res0 = (out0[0] + out0[1]) + (out0[2] + out0[3]);
+    res1 = (out1[0] + out1[1]) + (out1[2] + out1[3]);
+}
+
+#endif // ROC_CPU_ARM_NEON
+
+PolyphaseResampler::DotFunc select_dot_func() {
+#if defined(ROC_CPU_X86_SIMD)
+    if (core::cpu_supports(core::CpuFeature_AVX2)) {
+        return &dot_avx2;
+    }
+    if (core::cpu_supports(core::CpuFeature_SSE2)) {
+        return &dot_sse2;
+    }
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+    return &dot_neon;
+#else
+    return &dot_scalar;
+#endif
+}
+
+} // namespace
+
+PolyphaseResampler::PolyphaseResampler(const ResamplerConfig& config,
+                                       const SampleSpec& in_spec,
+                                       const SampleSpec& out_spec,
+                                       FrameFactory& frame_factory,
+                                       core::IArena& arena)
+    : IResampler(arena)
+    , in_spec_(in_spec)
+    , out_spec_(out_spec)
+    , n_chans_(in_spec.num_channels())
+    , window_size_(get_window_size(config.profile))
+    , window_interp_(get_window_interp(config.profile))
+    , window_interp_bits_(calc_bits(window_interp_))
+    , frame_size_ch_(get_frame_size(window_size_, in_spec, out_spec))
+    , frame_size_(frame_size_ch_ * in_spec.num_channels())
+    , cutoff_freq_(CUTOFF_FREQ)
+    , sinc_table_(arena)
+    , bank_(arena)
+    , n_taps_(0)
+    , n_left_taps_(0)
+    , bank_scaling_(0)
+    , max_left_taps_(0)
+    , hist_(arena)
+    , hist_stride_(0)
+    , hist_size_(0)
+    , pos_(0)
+    , step_(0)
+    , scaling_(1.0f)
+    , dot_func_(select_dot_func())
+    , init_status_(status::NoStatus) {
+    if (!in_spec_.is_complete() || !out_spec_.is_complete() || !in_spec_.is_raw()
+        || !out_spec_.is_raw()) {
+        roc_panic("polyphase resampler: required complete sample specs with raw format:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_spec_).c_str(),
+                  sample_spec_to_str(out_spec_).c_str());
+    }
+
+    if (in_spec_.channel_set() != out_spec_.channel_set()) {
+        roc_panic("polyphase resampler: required identical input and output channel sets:"
+                  " in_spec=%s out_spec=%s",
+                  sample_spec_to_str(in_spec_).c_str(),
+                  sample_spec_to_str(out_spec_).c_str());
+    }
+
+    roc_log(
+        LogDebug,
+        "polyphase resampler: initializing:"
+        " profile=%s window_interp=%lu window_size=%lu frame_size=%lu channels_num=%lu",
+        resampler_profile_to_str(config.profile), (unsigned long)window_interp_,
+        (unsigned long)window_size_, (unsigned long)frame_size_,
+        (unsigned long)n_chans_);
+
+    if (!check_config_()) {
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (!fill_sinc_()) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    if (!alloc_buffers_(frame_factory)) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    if (!build_bank_(1.0f)) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+PolyphaseResampler::~PolyphaseResampler() {
+}
+
+status::StatusCode PolyphaseResampler::init_status() const {
+    return init_status_;
+}
+
+bool PolyphaseResampler::set_scaling(size_t input_sample_rate,
+                                     size_t output_sample_rate,
+                                     float multiplier) {
+    if (input_sample_rate == 0 || output_sample_rate == 0) {
+        roc_log(LogError, "polyphase resampler: invalid rate");
+        return false;
+    }
+
+    const float new_scaling = float(input_sample_rate) / output_sample_rate * multiplier;
+
+    // Filter out obviously invalid values.
+    if (new_scaling <= 0) {
+        roc_log(LogError, "polyphase resampler: invalid scaling");
+        return false;
+    }
+
+    // Same limit as in builtin resampler, so that backends are interchangeable.
+    // History buffer is sized according to it.
+    if (window_size_ * new_scaling > frame_size_ch_ - 1) {
+        roc_log(LogError,
+                "polyphase resampler: scaling does not fit frame size:"
+                " window_size=%lu frame_size=%lu scaling=%.5f",
+                (unsigned long)window_size_, (unsigned long)frame_size_,
+                (double)new_scaling);
+        return false;
+    }
+
+    // When upscaling, cutoff frequency is shifted according to scaling,
+    // which requires different filter bank.
+    const float eff_scaling = std::max(new_scaling, 1.0f);
+
+    if (eff_scaling > bank_scaling_ || eff_scaling < bank_scaling_ / BANK_HYSTERESIS) {
+        const float new_bank_scaling =
+            eff_scaling > 1.0f ? eff_scaling * BANK_MARGIN : 1.0f;
+
+        if (!build_bank_(new_bank_scaling)) {
+            return false;
+        }
+    }
+
+    scaling_ = new_scaling;
+    step_ = (uint64_t)((double)scaling_ * (double)((uint64_t)1 << FRACT_BIT_COUNT));
+
+    return true;
+}
+
+const core::Slice<sample_t>& PolyphaseResampler::begin_push_input() {
+    return in_frame_;
+}
+
+void PolyphaseResampler::end_push_input() {
+    compact_history_();
+
+    const sample_t* in_data = in_frame_.data();
+
+    for (size_t ch = 0; ch < n_chans_; ch++) {
+        sample_t* hist_data = hist_.data() + ch * hist_stride_ + hist_size_;
+
+        for (size_t n = 0; n < frame_size_ch_; n++) {
+            hist_data[n] = in_data[n * n_chans_ + ch];
+        }
+    }
+
+    hist_size_ += frame_size_ch_;
+}
+
+size_t PolyphaseResampler::pop_output(sample_t* out_data, size_t out_size) {
+    roc_panic_if_msg(step_ == 0,
+                     "polyphase resampler:"
+                     " set_scaling() must be called before any resampling could be done");
+
+    const size_t phase_shift = FRACT_BIT_COUNT - window_interp_bits_;
+    const uint64_t interp_mask = ((uint64_t)1 << phase_shift) - 1;
+    const float interp_scale = 1.0f / (float)((uint64_t)1 << phase_shift);
+
+    size_t out_pos = 0;
+
+    for (; out_pos + n_chans_ <= out_size; out_pos += n_chans_) {
+        const size_t index = (size_t)(pos_ >> FRACT_BIT_COUNT);
+
+        // Stop when window's right side goes beyond pushed samples.
+        if (index + 1 + n_taps_ - n_left_taps_ > hist_size_) {
+            break;
+        }
+
+        const uint32_t fract = (uint32_t)(pos_ & FRACT_PART_MASK);
+        const size_t phase = fract >> phase_shift;
+        const float interp = (float)(fract & interp_mask) * interp_scale;
+
+        const sample_t* h0 = bank_.data() + phase * n_taps_;
+        const sample_t* h1 = h0 + n_taps_;
+
+        const sample_t* x = hist_.data() + index + 1 - n_left_taps_;
+
+        for (size_t ch = 0; ch < n_chans_; ch++) {
+            sample_t s0, s1;
+            dot_func_(x, h0, h1, n_taps_, s0, s1);
+
+            out_data[out_pos + ch] = s0 + interp * (s1 - s0);
+            x += hist_stride_;
+        }
+
+        pos_ += step_;
+    }
+
+    return out_pos;
+}
+
+float PolyphaseResampler::n_left_to_process() const {
+    const double pos = (double)pos_ / (double)((uint64_t)1 << FRACT_BIT_COUNT);
+    const double n_left = (double)hist_size_ - pos;
+
+    return n_left > 0 ? (float)n_left * n_chans_ : 0.0f;
+}
+
+bool PolyphaseResampler::check_config_() const {
+    if (frame_size_ != frame_size_ch_ * n_chans_) {
+        roc_log(LogError,
+                "polyphase resampler: frame_size is not multiple of num_channels:"
+                " frame_size=%lu num_channels=%lu",
+                (unsigned long)frame_size_, (unsigned long)n_chans_);
+        return false;
+    }
+
+    if ((size_t)1 << window_interp_bits_ != window_interp_
+        || window_interp_bits_ >= FRACT_BIT_COUNT) {
+        roc_log(LogError,
+                "polyphase resampler: window_interp is not power of two:"
+                " window_interp=%lu",
+                (unsigned long)window_interp_);
+        return false;
+    }
+
+    return true;
+}
+
+bool PolyphaseResampler::alloc_buffers_(FrameFactory& frame_factory) {
+    in_frame_ = frame_factory.new_raw_buffer();
+
+    if (!in_frame_) {
+        roc_log(LogError, "polyphase resampler: can't allocate frame buffer");
+        return false;
+    }
+
+    in_frame_.reslice(0, frame_size_);
+
+    // Maximum scaling accepted by set_scaling(), and corresponding maximum
+    // size of the left side of the window.
+    const float max_scaling = (float)(frame_size_ch_ - 1) / (float)window_size_;
+    max_left_taps_ =
+        get_left_taps(window_size_, std::max(max_scaling, 1.0f) * BANK_MARGIN) + 1;
+
+    // History should fit left side of the window, unprocessed samples of
+    // right side of the window, and one new frame.
+    hist_stride_ = max_left_taps_ + get_total_taps(max_left_taps_) + frame_size_ch_;
+
+    if (!hist_.resize(hist_stride_ * n_chans_)) {
+        roc_log(LogError, "polyphase resampler: can't allocate history buffer");
+        return false;
+    }
+
+    // History starts with zeros, so that first output samples have full
+    // left side of the window.
+    for (size_t n = 0; n < hist_.size(); n++) {
+        hist_[n] = 0;
+    }
+
+    hist_size_ = max_left_taps_ - 1;
+    pos_ = (uint64_t)hist_size_ << FRACT_BIT_COUNT;
+
+    return true;
+}
+
+bool PolyphaseResampler::fill_sinc_() {
+    if (!sinc_table_.resize(window_size_ * window_interp_ + 2)) {
+        roc_log(LogError, "polyphase resampler: can't allocate sinc table");
+        return false;
+    }
+
+    const double sinc_step = 1.0 / (double)window_interp_;
+    double sinc_t = sinc_step;
+
+    sinc_table_[0] = 1.0f;
+    for (size_t i = 1; i < sinc_table_.size(); ++i) {
+        const double window = 0.54
+            - 0.46
+                * std::cos(2 * M_PI
+                           * ((double)(i - 1) / 2.0 / (double)sinc_table_.size() + 0.5));
+        sinc_table_[i] = (float)(std::sin(M_PI * sinc_t) / M_PI / sinc_t * window);
+        sinc_t += sinc_step;
+    }
+    sinc_table_[sinc_table_.size() - 2] = 0;
+    sinc_table_[sinc_table_.size() - 1] = 0;
+
+    return true;
+}
+
+// Builds filter bank for given scaling.
+//
+// Phase p of the bank corresponds to output position with fractional part
+// p / window_interp. Tap j of the phase is applied to input sample located
+// at (n_left_taps - 1 - j - fract) from output position. Last phase has
+// fractional part 1, which allows to interpolate between two neighbour
+// phases without special cases.
+bool PolyphaseResampler::build_bank_(float bank_scaling) {
+    const size_t n_left_taps = get_left_taps(window_size_, bank_scaling);
+    const size_t n_taps = get_total_taps(n_left_taps);
+
+    roc_panic_if(n_left_taps > max_left_taps_);
+
+    if (!bank_.resize((window_interp_ + 1) * n_taps)) {
+        roc_log(LogError, "polyphase resampler: can't allocate filter bank");
+        return false;
+    }
+
+    const double sinc_step = (double)cutoff_freq_ / (double)bank_scaling;
+    const double gain = 1.0 / (double)bank_scaling;
+
+    for (size_t p = 0; p <= window_interp_; p++) {
+        sample_t* h = bank_.data() + p * n_taps;
+
+        const double fract = (double)p / (double)window_interp_;
+
+        for (size_t j = 0; j < n_taps; j++) {
+            const double dist = fract + (double)n_left_taps - 1.0 - (double)j;
+
+            h[j] = (sample_t)((double)sinc_(std::fabs(dist) * sinc_step) * gain);
+        }
+    }
+
+    n_left_taps_ = n_left_taps;
+    n_taps_ = n_taps;
+    bank_scaling_ = bank_scaling;
+
+    roc_log(LogTrace,
+            "polyphase resampler: built filter bank: scaling=%.5f taps=%lu phases=%lu",
+            (double)bank_scaling_, (unsigned long)n_taps_,
+            (unsigned long)window_interp_ + 1);
+
+    return true;
+}
+
+// Computes windowed sinc value in x position using linear interpolation
+// between table values.
+sample_t PolyphaseResampler::sinc_(double x) const {
+    const double table_pos = x * (double)window_interp_;
+
+    if (table_pos >= (double)(sinc_table_.size() - 2)) {
+        return 0;
+    }
+
+    const size_t index = (size_t)table_pos;
+    const double fract = table_pos - (double)index;
+
+    const sample_t hl = sinc_table_[index];
+    const sample_t hh = sinc_table_[index + 1];
+
+    return (sample_t)((double)hl + fract * (double)(hh - hl));
+}
+
+// Drops samples that are not needed anymore from the beginning of history,
+// to make room for new frame.
+void PolyphaseResampler::compact_history_() {
+    size_t index = (size_t)(pos_ >> FRACT_BIT_COUNT);
+
+    // Keep enough samples on the left for any supported bank.
+    size_t start = index + 1 - max_left_taps_;
+
+    if (start > hist_size_) {
+        start = hist_size_;
+    }
+
+    // If previous frames were not fully processed, drop oldest samples.
+    if (hist_size_ - start + frame_size_ch_ > hist_stride_) {
+        start = hist_size_ + frame_size_ch_ - hist_stride_;
+    }
+
+    if (start == 0) {
+        return;
+    }
+
+    for (size_t ch = 0; ch < n_chans_; ch++) {
+        sample_t* hist_data = hist_.data() + ch * hist_stride_;
+
+        memmove(hist_data, hist_data + start, (hist_size_ - start) * sizeof(sample_t));
+    }
+
+    hist_size_ -= start;
+
+    if (index < start + max_left_taps_ - 1) {
+        index = start + max_left_taps_ - 1;
+        pos_ &= FRACT_PART_MASK;
+        pos_ |= (uint64_t)index << FRACT_BIT_COUNT;
+    }
+
+    pos_ -= (uint64_t)start << FRACT_BIT_COUNT;
+}
+
+} // namespace audio
+} // namespace roc
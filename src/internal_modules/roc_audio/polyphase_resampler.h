@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/polyphase_resampler.h
+//! @brief Polyphase resampler.
+
+#ifndef ROC_AUDIO_POLYPHASE_RESAMPLER_H_
+#define ROC_AUDIO_POLYPHASE_RESAMPLER_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iresampler.h"
+#include "roc_audio/resampler_config.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Polyphase resampler.
+//!
+//! Implements same bandlimited interpolation as BuiltinResampler, with same
+//! window and quality settings, but instead of interpolating windowed sinc
+//! for every tap, precomputes a bank of filters, one per fractional position
+//! (phase) of output sample. Every output sample is then computed as a pair
+//! of dot products with two neighbour phases, linearly interpolated. Dot
+//! products are vectorized.
+//!
+//! Input samples are kept per-channel in contiguous history buffers, so that
+//! filter taps can be applied without per-sample index computations.
+//!
+//! Filter bank depends on cutoff frequency, which depends on scaling when it
+//! is above one. To avoid rebuilding it on every small scaling change, bank is
+//! built with a small margin and rebuilt only when scaling goes beyond it.
+//!
+//! Compared to BuiltinResampler, uses more memory for the filter bank,
+//! but significantly less CPU.
+class PolyphaseResampler : public IResampler, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    PolyphaseResampler(const ResamplerConfig& config,
+                       const SampleSpec& in_spec,
+                       const SampleSpec& out_spec,
+                       FrameFactory& frame_factory,
+                       core::IArena& arena);
+
+    ~PolyphaseResampler();
+
+    //! Check if the object was successfully constructed.
+    virtual status::StatusCode init_status() const;
+
+    //! Set new resample factor.
+    virtual bool set_scaling(size_t input_rate, size_t output_rate, float multiplier);
+
+    //! Get buffer to be filled with input data.
+    virtual const core::Slice<sample_t>& begin_push_input();
+
+    //! Commit buffer with input data.
+    virtual void end_push_input();
+
+    //! Read samples from input frame and fill output frame.
+    virtual size_t pop_output(sample_t* out_data, size_t out_size);
+
+    //! How many samples were pushed but not processed yet.
+    virtual float n_left_to_process() const;
+
+    //! Dot product function.
+    //! Computes dot products of @p x with @p h0 and @p h1.
+    //! @p n_taps is a multiple of 8.
+    typedef void (*DotFunc)(const sample_t* x,
+                            const sample_t* h0,
+                            const sample_t* h1,
+                            size_t n_taps,
+                            sample_t& res0,
+                            sample_t& res1);
+
+private:
+    bool check_config_() const;
+
+    bool alloc_buffers_(FrameFactory& frame_factory);
+    bool fill_sinc_();
+
+    bool build_bank_(float bank_scaling);
+    sample_t sinc_(double x) const;
+
+    void compact_history_();
+
+    const SampleSpec in_spec_;
+    const SampleSpec out_spec_;
+
+    const size_t n_chans_;
+
+    const size_t window_size_;
+    const size_t window_interp_;
+    size_t window_interp_bits_;
+
+    const size_t frame_size_ch_;
+    const size_t frame_size_;
+
+    const sample_t cutoff_freq_;
+
+    core::Slice<sample_t> in_frame_;
+
+    // fine-grained windowed sinc table, same as in BuiltinResampler
+    core::Array<sample_t> sinc_table_;
+
+    // filter bank, (window_interp_ + 1) phases of n_taps_ each
+    core::Array<sample_t> bank_;
+    size_t n_taps_;
+    size_t n_left_taps_;
+    float bank_scaling_;
+
+    // maximum number of left taps for any supported scaling
+    size_t max_left_taps_;
+
+    // per-channel input history, each channel has hist_stride_ samples
+    core::Array<sample_t> hist_;
+    size_t hist_stride_;
+    size_t hist_size_;
+
+    // position of next output sample in history, Q32.32
+    uint64_t pos_;
+    // distance between output samples in input samples, Q32.32
+    uint64_t step_;
+
+    float scaling_;
+
+    DotFunc dot_func_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_POLYPHASE_RESAMPLER_H_
@@ -10,6 +10,7 @@
 #include "roc_audio/beep_plc.h"
 #include "roc_audio/builtin_resampler.h"
 #include "roc_audio/decimation_resampler.h"
+#include "roc_audio/polyphase_resampler.h"
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
@@ -84,6 +85,13 @@ ProcessorMap::ProcessorMap(core::IArena& arena)
         node->ctor_fn = (void*)(ResamplerFunc)&resampler_ctor_fn<BuiltinResampler>;
         register_builtin_node_(node);
     }
+    {
+        Node* node = allocate_builtin_node_();
+        node->type = NodeType_Resampler;
+        node->id = ResamplerBackend_Polyphase;
+        node->ctor_fn = (void*)(ResamplerFunc)&resampler_ctor_fn<PolyphaseResampler>;
+        register_builtin_node_(node);
+    }
 
     // plc
     {
@@ -50,6 +50,9 @@ const char* resampler_backend_to_str(ResamplerBackend backend) {
     case ResamplerBackend_SpeexDec:
         return "speexdec";
 
+    case ResamplerBackend_Polyphase:
+        return "polyphase";
+
     case ResamplerBackend_Max:
         break;
     }
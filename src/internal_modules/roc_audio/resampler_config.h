@@ -38,6 +38,12 @@ enum ResamplerBackend {
     //! May be disabled at build time.
     ResamplerBackend_SpeexDec,
 
+    //! Built-in polyphase resampler.
+    //! Same windowed sinc interpolation as built-in resampler, but with
+    //! precomputed filter bank and vectorized dot products.
+    //! High precision, high quality, fast. Uses more memory than built-in.
+    ResamplerBackend_Polyphase,
+
     //! Maximum enum value.
     ResamplerBackend_Max
 };
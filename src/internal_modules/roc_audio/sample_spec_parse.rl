@@ -145,6 +145,10 @@ bool parse_subformat(const char* str, SampleSpec& sample_spec) {
         }
     } break;
 
+    case Format_Opus:
+        // Opus doesn't have sub-formats.
+        break;
+
     case Format_Invalid:
     case Format_Max:
         break;
@@ -350,6 +354,7 @@ bool validate_sample_spec(const SampleSpec& sample_spec) {
         break;
 
     case Format_Invalid:
+    case Format_Opus:
     case Format_Custom:
     case Format_Max:
         break;
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+bool is_supported_rate(size_t sample_rate) {
+    return sample_rate == 8000 || sample_rate == 12000 || sample_rate == 16000
+        || sample_rate == 24000 || sample_rate == 48000;
+}
+
+} // namespace
+
+IFrameDecoder* OpusDecoder::construct(const SampleSpec& sample_spec,
+                                      core::IArena& arena) {
+    return new (arena) OpusDecoder(sample_spec, arena);
+}
+
+OpusDecoder::OpusDecoder(const SampleSpec& sample_spec, core::IArena& arena)
+    : IFrameDecoder(arena)
+    , arena_(arena)
+    , decoder_(NULL)
+    , sample_rate_(sample_spec.sample_rate())
+    , n_chans_(sample_spec.num_channels())
+    , step_len_(0)
+    , max_len_(0)
+    , max_plc_len_(0)
+    , stream_pos_(0)
+    , stream_avail_(0)
+    , frame_data_(NULL)
+    , frame_size_(0)
+    , frame_decoded_(false)
+    , frame_buf_(arena)
+    , frame_buf_pos_(0)
+    , plc_buf_(arena)
+    , plc_buf_pos_(0)
+    , plc_buf_size_(0)
+    , decoder_pos_(0)
+    , has_decoder_pos_(false)
+    , init_status_(status::NoStatus) {
+    if (sample_spec.format() != Format_Opus || !is_supported_rate(sample_rate_)
+        || n_chans_ < 1 || n_chans_ > 2) {
+        roc_log(LogError,
+                "opus decoder: unsupported sample spec: spec=%s:"
+                " expected rate 8000, 12000, 16000, 24000, or 48000,"
+                " and 1 or 2 channels",
+                sample_spec_to_str(sample_spec).c_str());
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    // Opus packet can't be longer than 120ms, and concealment is done
+    // in chunks of up to 60ms, which is maximum Opus frame length.
+    step_len_ = sample_rate_ / 400;
+    max_len_ = step_len_ * 48;
+    max_plc_len_ = step_len_ * 24;
+
+    if (!(decoder_ = (::OpusDecoder*)arena_.allocate(
+              (size_t)opus_decoder_get_size((int)n_chans_)))) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    const int err = opus_decoder_init(decoder_, (opus_int32)sample_rate_, (int)n_chans_);
+    if (err != OPUS_OK) {
+        roc_log(LogError, "opus decoder: opus_decoder_init(): [%d] %s", err,
+                opus_strerror(err));
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (!frame_buf_.resize(max_len_ * n_chans_)
+        || !plc_buf_.resize(max_plc_len_ * n_chans_)) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    roc_log(LogDebug, "opus decoder: initializing: spec=%s",
+            sample_spec_to_str(sample_spec).c_str());
+
+    init_status_ = status::StatusOK;
+}
+
+OpusDecoder::~OpusDecoder() {
+    if (decoder_) {
+        arena_.deallocate(decoder_);
+    }
+}
+
+status::StatusCode OpusDecoder::init_status() const {
+    return init_status_;
+}
+
+packet::stream_timestamp_t OpusDecoder::position() const {
+    return stream_pos_;
+}
+
+packet::stream_timestamp_t OpusDecoder::available() const {
+    return stream_avail_;
+}
+
+size_t OpusDecoder::decoded_sample_count(const void* frame_data,
+                                         size_t frame_size) const {
+    roc_panic_if(init_status_ != status::StatusOK);
+    roc_panic_if_not(frame_data);
+
+    const int n_samples =
+        opus_packet_get_nb_samples((const unsigned char*)frame_data,
+                                   (opus_int32)frame_size, (opus_int32)sample_rate_);
+
+    if (n_samples <= 0 || (size_t)n_samples > max_len_) {
+        return 0;
+    }
+
+    return (size_t)n_samples;
+}
+
+void OpusDecoder::begin_frame(packet::stream_timestamp_t frame_position,
+                              const void* frame_data,
+                              size_t frame_size) {
+    roc_panic_if(init_status_ != status::StatusOK);
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("opus decoder: unpaired begin/end");
+    }
+
+    frame_data_ = (const uint8_t*)frame_data;
+    frame_size_ = frame_size;
+    frame_decoded_ = false;
+
+    stream_pos_ = frame_position;
+    stream_avail_ =
+        (packet::stream_timestamp_t)decoded_sample_count(frame_data, frame_size);
+}
+
+size_t OpusDecoder::read_samples(sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus decoder: read should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    if (!frame_decoded_) {
+        decode_frame_();
+    }
+
+    memcpy(samples, frame_buf_.data() + frame_buf_pos_ * n_chans_,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    frame_buf_pos_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+
+    return n_samples;
+}
+
+size_t OpusDecoder::drop_samples(size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus decoder: shift should be called only between begin/end");
+    }
+
+    if (n_samples > (size_t)stream_avail_) {
+        n_samples = (size_t)stream_avail_;
+    }
+
+    if (n_samples == 0) {
+        return 0;
+    }
+
+    // Dropped samples still have to be decoded to keep decoder state continuous.
+    if (!frame_decoded_) {
+        decode_frame_();
+    }
+
+    frame_buf_pos_ += n_samples;
+
+    stream_pos_ += (packet::stream_timestamp_t)n_samples;
+    stream_avail_ -= (packet::stream_timestamp_t)n_samples;
+
+    return n_samples;
+}
+
+void OpusDecoder::end_frame() {
+    if (!frame_data_) {
+        roc_panic("opus decoder: unpaired begin/end");
+    }
+
+    stream_avail_ = 0;
+
+    frame_data_ = NULL;
+    frame_size_ = 0;
+    frame_decoded_ = false;
+}
+
+void OpusDecoder::conceal(sample_t* samples, size_t n_samples) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    while (n_samples != 0) {
+        if (plc_buf_pos_ == plc_buf_size_) {
+            generate_concealment_(n_samples);
+        }
+
+        const size_t n_copy = std::min(n_samples, plc_buf_size_ - plc_buf_pos_);
+
+        memcpy(samples, plc_buf_.data() + plc_buf_pos_ * n_chans_,
+               n_copy * n_chans_ * sizeof(sample_t));
+
+        samples += n_copy * n_chans_;
+        n_samples -= n_copy;
+        plc_buf_pos_ += n_copy;
+    }
+}
+
+void OpusDecoder::decode_frame_() {
+    roc_panic_if(frame_decoded_);
+
+    const size_t frame_len = (size_t)stream_avail_;
+
+    const int ret = opus_decode_float(decoder_, frame_data_, (opus_int32)frame_size_,
+                                      frame_buf_.data(), (int)max_len_, 0);
+
+    size_t n_decoded = 0;
+    if (ret < 0) {
+        roc_log(LogDebug, "opus decoder: can't decode frame: [%d] %s", ret,
+                opus_strerror(ret));
+    } else {
+        n_decoded = std::min((size_t)ret, frame_len);
+    }
+
+    if (n_decoded < frame_len) {
+        memset(frame_buf_.data() + n_decoded * n_chans_, 0,
+               (frame_len - n_decoded) * n_chans_ * sizeof(sample_t));
+    }
+
+    frame_decoded_ = true;
+    frame_buf_pos_ = 0;
+
+    // Decoder state now corresponds to the end of the frame.
+    decoder_pos_ = stream_pos_ + stream_avail_;
+    has_decoder_pos_ = true;
+
+    // Leftovers of previous concealment are not relevant anymore.
+    plc_buf_pos_ = plc_buf_size_ = 0;
+}
+
+void OpusDecoder::generate_concealment_(size_t n_samples) {
+    size_t n_generated = 0;
+    int ret = 0;
+
+    if (frame_data_ && !frame_decoded_ && has_decoder_pos_) {
+        // If the frame following the loss is already started, and the loss
+        // spans exactly until the frame, decode the loss using in-band FEC
+        // data of the frame. If the frame has no FEC data, libopus falls
+        // back to regular concealment.
+        const packet::stream_timestamp_diff_t gap =
+            packet::stream_timestamp_diff(stream_pos_, decoder_pos_);
+
+        if (gap > 0 && (size_t)gap <= max_plc_len_ && (size_t)gap % step_len_ == 0) {
+            n_generated = (size_t)gap;
+            ret = opus_decode_float(decoder_, frame_data_, (opus_int32)frame_size_,
+                                    plc_buf_.data(), (int)n_generated, 1);
+        }
+    }
+
+    if (n_generated == 0) {
+        // Regular concealment, in chunks of multiple of 2.5ms, as required
+        // by libopus. Extra samples are kept for next call.
+        n_generated = (n_samples + step_len_ - 1) / step_len_ * step_len_;
+        if (n_generated > max_plc_len_) {
+            n_generated = max_plc_len_;
+        }
+        ret = opus_decode_float(decoder_, NULL, 0, plc_buf_.data(), (int)n_generated, 0);
+    }
+
+    if (ret < 0) {
+        roc_log(LogDebug, "opus decoder: can't conceal loss: [%d] %s", ret,
+                opus_strerror(ret));
+        ret = 0;
+    }
+    if ((size_t)ret < n_generated) {
+        memset(plc_buf_.data() + (size_t)ret * n_chans_, 0,
+               (n_generated - (size_t)ret) * n_chans_ * sizeof(sample_t));
+    }
+
+    plc_buf_pos_ = 0;
+    plc_buf_size_ = n_generated;
+
+    decoder_pos_ += (packet::stream_timestamp_t)n_generated;
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_libopus/roc_audio/opus_decoder.h
+//! @brief Opus decoder.
+
+#ifndef ROC_AUDIO_OPUS_DECODER_H_
+#define ROC_AUDIO_OPUS_DECODER_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/units.h"
+
+#include <opus/opus.h>
+
+namespace roc {
+namespace audio {
+
+//! Opus decoder.
+//!
+//! Decodes Opus packets using libopus.
+//!
+//! Besides IFrameDecoder interface, provides conceal() method, which generates
+//! samples for lost packets using decoder state. It is used by OpusPlc.
+//!
+//! Decoding of a frame is deferred until its samples are requested for the
+//! first time. Thanks to this, when depacketizer reports a gap before the
+//! frame, the frame is already known, but decoder state is not yet advanced,
+//! and conceal() can recover the end of the gap from in-band FEC data
+//! carried by the frame.
+class OpusDecoder : public IFrameDecoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameDecoder* construct(const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Initialize.
+    OpusDecoder(const SampleSpec& sample_spec, core::IArena& arena);
+
+    virtual ~OpusDecoder();
+
+    //! Check if the object was successfully constructed.
+    virtual status::StatusCode init_status() const;
+
+    //! Get current stream position.
+    virtual packet::stream_timestamp_t position() const;
+
+    //! Get number of samples available for decoding.
+    virtual packet::stream_timestamp_t available() const;
+
+    //! Get number of samples per channel, that can be decoded from given frame.
+    virtual size_t decoded_sample_count(const void* frame_data, size_t frame_size) const;
+
+    //! Start decoding a new frame.
+    virtual void begin_frame(packet::stream_timestamp_t frame_position,
+                             const void* frame_data,
+                             size_t frame_size);
+
+    //! Read samples from current frame.
+    virtual size_t read_samples(sample_t* samples, size_t n_samples);
+
+    //! Shift samples from current frame.
+    virtual size_t drop_samples(size_t n_samples);
+
+    //! Finish decoding current frame.
+    virtual void end_frame();
+
+    //! Generate samples for lost packets.
+    //! @remarks
+    //!  Writes @p n_samples samples per channel to @p samples. Samples are
+    //!  extrapolated from previously decoded frames; if the frame following the
+    //!  loss is already started, its in-band FEC data is used when possible.
+    //!  Should be called in place of reading samples that are missing in stream,
+    //!  so that decoder state stays continuous.
+    void conceal(sample_t* samples, size_t n_samples);
+
+private:
+    void decode_frame_();
+    void generate_concealment_(size_t n_samples);
+
+    core::IArena& arena_;
+
+    ::OpusDecoder* decoder_;
+
+    const size_t sample_rate_;
+    const size_t n_chans_;
+    size_t step_len_;
+    size_t max_len_;
+    size_t max_plc_len_;
+
+    packet::stream_timestamp_t stream_pos_;
+    packet::stream_timestamp_t stream_avail_;
+
+    const uint8_t* frame_data_;
+    size_t frame_size_;
+    bool frame_decoded_;
+
+    core::Array<sample_t> frame_buf_;
+    size_t frame_buf_pos_;
+
+    core::Array<sample_t> plc_buf_;
+    size_t plc_buf_pos_;
+    size_t plc_buf_size_;
+
+    packet::stream_timestamp_t decoder_pos_;
+    bool has_decoder_pos_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_DECODER_H_
@@ -0,0 +1,404 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_encoder.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+// Target bitrate, bits per second. Low enough for libopus to choose SILK
+// or hybrid mode for voice, because in-band FEC exists only in these modes;
+// at higher bitrates libopus switches to CELT.
+const size_t BitrateMono = 24000;
+const size_t BitrateStereo = 32000;
+
+// Expected packet loss percentage, tells encoder how much in-band FEC to add.
+const int ExpectedLossPercent = 10;
+
+// Maximum size of a single Opus frame, bytes.
+const size_t MaxFrameBytes = 1275;
+
+// TOC config of CELT-only fullband 2.5ms frame, next three configs are
+// 5ms, 10ms, and 20ms frames (RFC 6716, 3.1).
+const int CeltFullbandConfig = 28;
+
+// Upper bound of overhead added when combining frames into one packet, bytes.
+inline size_t repacketizer_overhead(size_t n_frames) {
+    return 2 + n_frames * 2;
+}
+
+// Frame durations that opus_encode_float() can produce with a single call,
+// in units of 2.5ms.
+const size_t native_durations[] = { 1, 2, 4, 8, 16, 24, 32, 40, 48 };
+
+bool is_native_duration(size_t n_steps) {
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(native_durations); n++) {
+        if (native_durations[n] == n_steps) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int bandwidth_for_rate(size_t sample_rate) {
+    switch (sample_rate) {
+    case 8000:
+        return OPUS_BANDWIDTH_NARROWBAND;
+    case 12000:
+        return OPUS_BANDWIDTH_MEDIUMBAND;
+    case 16000:
+        return OPUS_BANDWIDTH_WIDEBAND;
+    case 24000:
+        return OPUS_BANDWIDTH_SUPERWIDEBAND;
+    case 48000:
+        return OPUS_BANDWIDTH_FULLBAND;
+    }
+    return 0;
+}
+
+size_t bitrate_for_chans(size_t n_chans) {
+    return n_chans == 1 ? BitrateMono : BitrateStereo;
+}
+
+} // namespace
+
+IFrameEncoder* OpusEncoder::construct(const SampleSpec& sample_spec,
+                                      core::IArena& arena) {
+    return new (arena) OpusEncoder(sample_spec, arena);
+}
+
+OpusEncoder::OpusEncoder(const SampleSpec& sample_spec, core::IArena& arena)
+    : IFrameEncoder(arena)
+    , arena_(arena)
+    , encoder_(NULL)
+    , repacketizer_(NULL)
+    , sample_rate_(sample_spec.sample_rate())
+    , n_chans_(sample_spec.num_channels())
+    , bitrate_(0)
+    , step_len_(0)
+    , max_len_(0)
+    , buffer_(arena)
+    , buffer_pos_(0)
+    , scratch_(arena)
+    , frame_data_(NULL)
+    , frame_size_(0)
+    , init_status_(status::NoStatus) {
+    if (sample_spec.format() != Format_Opus || bandwidth_for_rate(sample_rate_) == 0
+        || n_chans_ < 1 || n_chans_ > 2) {
+        roc_log(LogError,
+                "opus encoder: unsupported sample spec: spec=%s:"
+                " expected rate 8000, 12000, 16000, 24000, or 48000,"
+                " and 1 or 2 channels",
+                sample_spec_to_str(sample_spec).c_str());
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    bitrate_ = bitrate_for_chans(n_chans_);
+    step_len_ = sample_rate_ / 400;
+    max_len_ = step_len_ * 48;
+
+    if (!(encoder_ = (::OpusEncoder*)arena_.allocate(
+              (size_t)opus_encoder_get_size((int)n_chans_)))) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    // VoIP application and voice signal hint make libopus prefer SILK and
+    // hybrid modes, which are the only modes that carry in-band FEC.
+    int err = opus_encoder_init(encoder_, (opus_int32)sample_rate_, (int)n_chans_,
+                                OPUS_APPLICATION_VOIP);
+    if (err != OPUS_OK) {
+        roc_log(LogError, "opus encoder: opus_encoder_init(): [%d] %s", err,
+                opus_strerror(err));
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if ((err = opus_encoder_ctl(encoder_, OPUS_SET_BITRATE((opus_int32)bitrate_)))
+            != OPUS_OK
+        || (err = opus_encoder_ctl(encoder_, OPUS_SET_VBR(0))) != OPUS_OK
+        || (err = opus_encoder_ctl(encoder_, OPUS_SET_SIGNAL(OPUS_SIGNAL_VOICE)))
+            != OPUS_OK
+        || (err = opus_encoder_ctl(encoder_,
+                                   OPUS_SET_BANDWIDTH(bandwidth_for_rate(sample_rate_))))
+            != OPUS_OK
+        || (err = opus_encoder_ctl(encoder_, OPUS_SET_INBAND_FEC(1))) != OPUS_OK
+        || (err = opus_encoder_ctl(encoder_,
+                                   OPUS_SET_PACKET_LOSS_PERC(ExpectedLossPercent)))
+            != OPUS_OK) {
+        roc_log(LogError, "opus encoder: opus_encoder_ctl(): [%d] %s", err,
+                opus_strerror(err));
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (!(repacketizer_ = (::OpusRepacketizer*)arena_.allocate(
+              (size_t)opus_repacketizer_get_size()))) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+    opus_repacketizer_init(repacketizer_);
+
+    if (!buffer_.resize(max_len_ * n_chans_)) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    // Combined frames are either 2.5ms or 5ms long, see choose_layout_().
+    const size_t scratch_size =
+        std::max(max_len_ / step_len_ * subframe_byte_count_(step_len_),
+                 max_len_ / (step_len_ * 2) * subframe_byte_count_(step_len_ * 2));
+
+    if (!scratch_.resize(scratch_size)) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    roc_log(LogDebug,
+            "opus encoder: initializing: bitrate=%lu loss_perc=%d spec=%s",
+            (unsigned long)bitrate_, ExpectedLossPercent,
+            sample_spec_to_str(sample_spec).c_str());
+
+    init_status_ = status::StatusOK;
+}
+
+OpusEncoder::~OpusEncoder() {
+    if (encoder_) {
+        arena_.deallocate(encoder_);
+    }
+    if (repacketizer_) {
+        arena_.deallocate(repacketizer_);
+    }
+}
+
+status::StatusCode OpusEncoder::init_status() const {
+    return init_status_;
+}
+
+size_t OpusEncoder::encoded_byte_count(size_t num_samples) const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    size_t subframe_len = 0, n_subframes = 0;
+    choose_layout_(num_samples, subframe_len, n_subframes);
+
+    size_t n_bytes = n_subframes * subframe_byte_count_(subframe_len);
+    if (n_subframes > 1) {
+        n_bytes += repacketizer_overhead(n_subframes);
+    }
+
+    return n_bytes;
+}
+
+void OpusEncoder::begin_frame(void* frame_data, size_t frame_size) {
+    roc_panic_if(init_status_ != status::StatusOK);
+    roc_panic_if_not(frame_data);
+
+    if (frame_data_) {
+        roc_panic("opus encoder: unpaired begin/end");
+    }
+
+    frame_data_ = (uint8_t*)frame_data;
+    frame_size_ = frame_size;
+    buffer_pos_ = 0;
+}
+
+size_t OpusEncoder::write_samples(const sample_t* samples, size_t n_samples) {
+    if (!frame_data_) {
+        roc_panic("opus encoder: write should be called only between begin/end");
+    }
+
+    if (n_samples > max_len_ - buffer_pos_) {
+        n_samples = max_len_ - buffer_pos_;
+    }
+
+    memcpy(buffer_.data() + buffer_pos_ * n_chans_, samples,
+           n_samples * n_chans_ * sizeof(sample_t));
+
+    buffer_pos_ += n_samples;
+
+    return n_samples;
+}
+
+void OpusEncoder::end_frame() {
+    if (!frame_data_) {
+        roc_panic("opus encoder: unpaired begin/end");
+    }
+
+    if (buffer_pos_ != 0) {
+        const size_t packet_size = encoded_byte_count(buffer_pos_);
+        roc_panic_if_msg(packet_size > frame_size_,
+                         "opus encoder: frame too small: frame_size=%lu packet_size=%lu",
+                         (unsigned long)frame_size_, (unsigned long)packet_size);
+
+        size_t written_size = 0;
+        if (!encode_(packet_size, written_size)) {
+            // Receiver will conceal empty packet as a loss.
+            written_size = write_empty_(packet_size);
+        }
+
+        if (written_size < packet_size) {
+            // Pad packet up to the fixed size; padding is part of Opus packet
+            // and is skipped by decoder.
+            const int err = opus_packet_pad(frame_data_, (opus_int32)written_size,
+                                            (opus_int32)packet_size);
+            if (err != OPUS_OK) {
+                roc_log(LogError, "opus encoder: opus_packet_pad(): [%d] %s", err,
+                        opus_strerror(err));
+            }
+        }
+    }
+
+    frame_data_ = NULL;
+    frame_size_ = 0;
+    buffer_pos_ = 0;
+}
+
+// Select how to split frame of given duration into Opus frames.
+// Frame is rounded up to a multiple of 2.5ms. If the result is not natively
+// supported by Opus, it is split into 5ms or 2.5ms frames. Such short frames
+// always use CELT mode and share the same TOC byte, which is required to
+// combine them into one packet.
+void OpusEncoder::choose_layout_(size_t n_samples,
+                                 size_t& subframe_len,
+                                 size_t& n_subframes) const {
+    roc_panic_if_msg(n_samples == 0 || n_samples > max_len_,
+                     "opus encoder: frame duration should be in range (0; 120ms]:"
+                     " n_samples=%lu max_samples=%lu",
+                     (unsigned long)n_samples, (unsigned long)max_len_);
+
+    const size_t n_steps = (n_samples + step_len_ - 1) / step_len_;
+
+    if (is_native_duration(n_steps)) {
+        subframe_len = n_steps * step_len_;
+        n_subframes = 1;
+    } else if (n_steps % 2 == 0) {
+        subframe_len = step_len_ * 2;
+        n_subframes = n_steps / 2;
+    } else {
+        subframe_len = step_len_;
+        n_subframes = n_steps;
+    }
+}
+
+size_t OpusEncoder::subframe_byte_count_(size_t subframe_len) const {
+    size_t n_bytes = bitrate_ * subframe_len / (sample_rate_ * 8);
+
+    // Frames above 60ms are internally split into multiple Opus frames.
+    if (subframe_len > step_len_ * 24) {
+        const size_t n_frames = subframe_len / (step_len_ * 8);
+        n_bytes = std::min(n_bytes, n_frames * MaxFrameBytes)
+            + repacketizer_overhead(n_frames);
+    } else {
+        n_bytes = std::min(n_bytes, MaxFrameBytes);
+    }
+
+    return n_bytes;
+}
+
+bool OpusEncoder::encode_(size_t packet_size, size_t& written_size) {
+    size_t subframe_len = 0, n_subframes = 0;
+    choose_layout_(buffer_pos_, subframe_len, n_subframes);
+
+    // Zero-pad samples up to the encoded duration.
+    const size_t padded_len = subframe_len * n_subframes;
+    if (padded_len > buffer_pos_) {
+        memset(buffer_.data() + buffer_pos_ * n_chans_, 0,
+               (padded_len - buffer_pos_) * n_chans_ * sizeof(sample_t));
+    }
+
+    opus_int32 ret = 0;
+
+    if (n_subframes == 1) {
+        ret = opus_encode_float(encoder_, buffer_.data(), (int)subframe_len, frame_data_,
+                                (opus_int32)packet_size);
+        if (ret < 0) {
+            roc_log(LogError, "opus encoder: opus_encode_float(): [%d] %s", (int)ret,
+                    opus_strerror((int)ret));
+            return false;
+        }
+        written_size = (size_t)ret;
+        return true;
+    }
+
+    const size_t subframe_size = subframe_byte_count_(subframe_len);
+    roc_panic_if(subframe_size * n_subframes > scratch_.size());
+
+    opus_repacketizer_init(repacketizer_);
+
+    for (size_t n = 0; n < n_subframes; n++) {
+        uint8_t* subframe_data = scratch_.data() + n * subframe_size;
+
+        ret = opus_encode_float(encoder_, buffer_.data() + n * subframe_len * n_chans_,
+                                (int)subframe_len, subframe_data,
+                                (opus_int32)subframe_size);
+        if (ret < 0) {
+            roc_log(LogError, "opus encoder: opus_encode_float(): [%d] %s", (int)ret,
+                    opus_strerror((int)ret));
+            return false;
+        }
+
+        const int err = opus_repacketizer_cat(repacketizer_, subframe_data, ret);
+        if (err != OPUS_OK) {
+            roc_log(LogError, "opus encoder: opus_repacketizer_cat(): [%d] %s", err,
+                    opus_strerror(err));
+            return false;
+        }
+    }
+
+    ret = opus_repacketizer_out(repacketizer_, frame_data_, (opus_int32)packet_size);
+    if (ret < 0) {
+        roc_log(LogError, "opus encoder: opus_repacketizer_out(): [%d] %s", (int)ret,
+                opus_strerror((int)ret));
+        return false;
+    }
+
+    written_size = (size_t)ret;
+    return true;
+}
+
+// Write packet of the same duration as the encoded one would have, but with
+// zero-length frames, which are decoded as lost frames (RFC 6716, 3.2.1).
+// All frames are CELT fullband, since such frames can have any duration
+// from 2.5ms to 20ms, and their number (up to 48) is encoded in code 3 packet.
+size_t OpusEncoder::write_empty_(size_t packet_size) {
+    roc_panic_if(packet_size < 2);
+
+    const size_t n_steps = (buffer_pos_ + step_len_ - 1) / step_len_;
+
+    // CELT frame durations in units of 2.5ms, and corresponding TOC configs.
+    size_t frame_steps = 8;
+    int toc_config = CeltFullbandConfig + 3;
+
+    while (n_steps % frame_steps != 0) {
+        frame_steps /= 2;
+        toc_config--;
+    }
+
+    const size_t n_frames = n_steps / frame_steps;
+
+    if (n_frames == 1) {
+        // Code 0: one frame.
+        frame_data_[0] = uint8_t(toc_config << 3);
+        return 1;
+    }
+
+    // Code 3: arbitrary number of frames, constant bitrate, no padding.
+    frame_data_[0] = uint8_t((toc_config << 3) | 3);
+    frame_data_[1] = uint8_t(n_frames);
+    return 2;
+}
+
+} // namespace audio
+} // namespace roc
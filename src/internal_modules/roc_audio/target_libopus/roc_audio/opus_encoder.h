@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_libopus/roc_audio/opus_encoder.h
+//! @brief Opus encoder.
+
+#ifndef ROC_AUDIO_OPUS_ENCODER_H_
+#define ROC_AUDIO_OPUS_ENCODER_H_
+
+#include "roc_audio/iframe_encoder.h"
+#include "roc_audio/sample.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+#include <opus/opus.h>
+
+namespace roc {
+namespace audio {
+
+//! Opus encoder.
+//!
+//! Encodes each frame into a single Opus packet using libopus.
+//!
+//! Encoder runs in constant bitrate mode, and pads every packet to the
+//! size reported by encoded_byte_count(), so that all packets of the same
+//! duration have equal payload size, as expected by packetizer and FEC.
+//!
+//! Frame duration must be a multiple of 2.5ms and can't exceed 120ms.
+//! If duration is not one of the durations natively supported by Opus,
+//! frame is encoded as multiple shorter Opus frames combined into one packet.
+//!
+//! In-band FEC is enabled, so that decoder can recover a lost packet from
+//! the next one. Opus produces in-band FEC data only in SILK and hybrid
+//! modes, so encoder is configured for VoIP, with a bitrate low enough for
+//! these modes (24 kbit/s for mono, 32 kbit/s for stereo). These modes are
+//! available only for frames of 10ms or longer and with native Opus duration
+//! (10, 20, 40, 60, 80, 100, or 120ms). Shorter frames, and frames combined
+//! from 2.5ms or 5ms frames, are encoded in CELT mode and have no FEC data.
+//! That's why Opus encodings have rtp::Encoding::min_packet_length of 10ms.
+//!
+//! If libopus fails to encode frame, error is logged, and encoder writes
+//! a packet of the same duration with empty frames, which receiver treats
+//! as lost.
+class OpusEncoder : public IFrameEncoder, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    static IFrameEncoder* construct(const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Initialize.
+    OpusEncoder(const SampleSpec& sample_spec, core::IArena& arena);
+
+    virtual ~OpusEncoder();
+
+    //! Check if the object was successfully constructed.
+    virtual status::StatusCode init_status() const;
+
+    //! Get encoded frame size in bytes for given number of samples per channel.
+    virtual size_t encoded_byte_count(size_t num_samples) const;
+
+    //! Start encoding a new frame.
+    virtual void begin_frame(void* frame, size_t frame_size);
+
+    //! Encode samples.
+    virtual size_t write_samples(const sample_t* samples, size_t n_samples);
+
+    //! Finish encoding frame.
+    virtual void end_frame();
+
+private:
+    void
+    choose_layout_(size_t n_samples, size_t& subframe_len, size_t& n_subframes) const;
+    size_t subframe_byte_count_(size_t subframe_len) const;
+    bool encode_(size_t packet_size, size_t& written_size);
+    size_t write_empty_(size_t packet_size);
+
+    core::IArena& arena_;
+
+    ::OpusEncoder* encoder_;
+    ::OpusRepacketizer* repacketizer_;
+
+    const size_t sample_rate_;
+    const size_t n_chans_;
+    size_t bitrate_;
+    size_t step_len_;
+    size_t max_len_;
+
+    core::Array<sample_t> buffer_;
+    size_t buffer_pos_;
+
+    core::Array<uint8_t> scratch_;
+
+    uint8_t* frame_data_;
+    size_t frame_size_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_ENCODER_H_
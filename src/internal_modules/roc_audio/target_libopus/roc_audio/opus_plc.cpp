@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_audio/opus_plc.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+
+IPlc* OpusPlc::construct(IFrameDecoder& decoder,
+                         const SampleSpec& sample_spec,
+                         core::IArena& arena) {
+    return new (arena) OpusPlc(static_cast<OpusDecoder&>(decoder), sample_spec, arena);
+}
+
+OpusPlc::OpusPlc(OpusDecoder& decoder,
+                 const SampleSpec& sample_spec,
+                 core::IArena& arena)
+    : IPlc(arena)
+    , decoder_(decoder)
+    , sample_spec_(sample_spec) {
+    if (!sample_spec_.is_complete() || !sample_spec_.is_raw()) {
+        roc_panic("opus plc: required complete sample specs with raw format: spec=%s",
+                  sample_spec_to_str(sample_spec_).c_str());
+    }
+}
+
+OpusPlc::~OpusPlc() {
+}
+
+status::StatusCode OpusPlc::init_status() const {
+    return decoder_.init_status();
+}
+
+SampleSpec OpusPlc::sample_spec() const {
+    return sample_spec_;
+}
+
+packet::stream_timestamp_t OpusPlc::lookbehind_len() {
+    return 0;
+}
+
+packet::stream_timestamp_t OpusPlc::lookahead_len() {
+    // Look-ahead would make depacketizer decode frames following the loss
+    // before the loss is concealed.
+    return 0;
+}
+
+void OpusPlc::process_history(Frame& hist_frame) {
+    // Decoder already knows history.
+}
+
+void OpusPlc::process_loss(Frame& lost_frame, Frame* prev_frame, Frame* next_frame) {
+    sample_spec_.validate_frame(lost_frame);
+
+    decoder_.conceal(lost_frame.raw_samples(),
+                     lost_frame.num_raw_samples() / sample_spec_.num_channels());
+}
+
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_audio/target_libopus/roc_audio/opus_plc.h
+//! @brief Opus PLC.
+
+#ifndef ROC_AUDIO_OPUS_PLC_H_
+#define ROC_AUDIO_OPUS_PLC_H_
+
+#include "roc_audio/iframe_decoder.h"
+#include "roc_audio/iplc.h"
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace audio {
+
+//! Opus PLC.
+//!
+//! Fills losses using concealment built into Opus decoder, including
+//! recovery from in-band FEC data of the packet following the loss.
+//!
+//! Unlike other PLC backends, it is bound to the decoder instance used by
+//! depacketizer of the same session, and relies on the fact that PlcReader
+//! processes each lost frame right after depacketizer produced it.
+class OpusPlc : public IPlc, public core::NonCopyable<> {
+public:
+    //! Construction function.
+    //! @p decoder should be an instance of OpusDecoder.
+    static IPlc*
+    construct(IFrameDecoder& decoder, const SampleSpec& sample_spec, core::IArena& arena);
+
+    //! Initialize.
+    OpusPlc(OpusDecoder& decoder, const SampleSpec& sample_spec, core::IArena& arena);
+
+    virtual ~OpusPlc();
+
+    //! Check if the object was successfully constructed.
+    virtual status::StatusCode init_status() const;
+
+    //! Sample specification expected by PLC.
+    virtual SampleSpec sample_spec() const;
+
+    //! How many samples before lost frame are needed for interpolation.
+    virtual packet::stream_timestamp_t lookbehind_len();
+
+    //! How many samples after lost frame are needed for interpolation.
+    virtual packet::stream_timestamp_t lookahead_len();
+
+    //! When next frame has no losses, PLC reader calls this method.
+    virtual void process_history(Frame& hist_frame);
+
+    //! When next frame is lost, PLC reader calls this method.
+    virtual void process_loss(Frame& lost_frame, Frame* prev_frame, Frame* next_frame);
+
+private:
+    OpusDecoder& decoder_;
+    const SampleSpec sample_spec_;
+};
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_AUDIO_OPUS_PLC_H_
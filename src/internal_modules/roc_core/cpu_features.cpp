@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/cpu_features.h"
+#include "roc_core/atomic_ops.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Set in cached features mask after detection is done.
+const unsigned DetectedFlag = (1u << 31);
+
+unsigned cached_features = 0;
+
+unsigned detect_features() {
+    unsigned features = DetectedFlag;
+
+#if defined(ROC_CPU_X86_SIMD)
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2")) {
+        features |= CpuFeature_SSE2;
+    }
+    if (__builtin_cpu_supports("ssse3")) {
+        features |= CpuFeature_SSSE3;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        features |= CpuFeature_SSE41;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        features |= CpuFeature_AVX2;
+    }
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+    features |= CpuFeature_NEON;
+#endif
+
+    return features;
+}
+
+} // namespace
+
+unsigned cpu_features() {
+    unsigned features = AtomicOps::load_acquire(cached_features);
+
+    if (!(features & DetectedFlag)) {
+        // Detection is idempotent, so concurrent first calls are harmless.
+        features = detect_features();
+        AtomicOps::store_release(cached_features, features);
+    }
+
+    return features & ~DetectedFlag;
+}
+
+bool cpu_supports(CpuFeature feature) {
+    return (cpu_features() & (unsigned)feature) != 0;
+}
+
+const char* cpu_feature_to_str(CpuFeature feature) {
+    switch (feature) {
+    case CpuFeature_SSE2:
+        return "sse2";
+    case CpuFeature_SSSE3:
+        return "ssse3";
+    case CpuFeature_SSE41:
+        return "sse4.1";
+    case CpuFeature_AVX2:
+        return "avx2";
+    case CpuFeature_NEON:
+        return "neon";
+    }
+
+    return "invalid";
+}
+
+} // namespace core
+} // namespace roc
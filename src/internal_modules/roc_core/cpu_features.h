@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/cpu_features.h
+//! @brief Runtime detection of CPU instruction set extensions.
+
+#ifndef ROC_CORE_CPU_FEATURES_H_
+#define ROC_CORE_CPU_FEATURES_H_
+
+#include "roc_core/stddefs.h"
+
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+//! Defined if x86 SIMD code paths can be compiled and selected at runtime.
+//! Functions using instructions beyond the build baseline should be marked
+//! with ROC_CPU_TARGET() and called only when cpu_supports() allows it.
+#define ROC_CPU_X86_SIMD
+//! Enable instruction set for a single function.
+#define ROC_CPU_TARGET(isa) __attribute__((target(isa)))
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+//! Defined if NEON code paths can be compiled.
+//! NEON is enabled at build time, so no runtime check is needed.
+#define ROC_CPU_ARM_NEON
+#endif
+
+namespace roc {
+namespace core {
+
+//! CPU instruction set extensions.
+enum CpuFeature {
+    //! x86 SSE2.
+    CpuFeature_SSE2 = (1 << 0),
+
+    //! x86 SSSE3.
+    CpuFeature_SSSE3 = (1 << 1),
+
+    //! x86 SSE4.1.
+    CpuFeature_SSE41 = (1 << 2),
+
+    //! x86 AVX2.
+    CpuFeature_AVX2 = (1 << 3),
+
+    //! ARM NEON (Advanced SIMD).
+    CpuFeature_NEON = (1 << 4)
+};
+
+//! Get bitmask of CpuFeature values supported by current CPU.
+//! @remarks
+//!  Only reports features for which there are compiled code paths
+//!  (see ROC_CPU_X86_SIMD and ROC_CPU_ARM_NEON).
+//!  Result is computed once and cached. Thread-safe.
+unsigned cpu_features();
+
+//! Check if given feature is supported by current CPU.
+bool cpu_supports(CpuFeature feature);
+
+//! Get string name of CPU feature.
+const char* cpu_feature_to_str(CpuFeature feature);
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_CPU_FEATURES_H_
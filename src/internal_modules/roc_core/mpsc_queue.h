@@ -18,6 +18,7 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/ownership_policy.h"
 #include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
 
 namespace roc {
 namespace core {
@@ -77,6 +78,40 @@ public:
         impl_.push_back(data);
     }
 
+    //! Add multiple objects to the end of the queue.
+    //! Can be called concurrently.
+    //! Acquires ownership of all elements of @p elems.
+    //! @remarks
+    //!  Elements are linked into a chain before adding, and the whole chain is
+    //!  then published using a single atomic exchange, so the cost of this
+    //!  operation (in terms of atomics and cache line transfers between producer
+    //!  and consumer) is the same as of one push_back() call.
+    //! @note
+    //!  Has same guarantees as push_back(). Elements are either all visible to
+    //!  the consumer, or not visible at all.
+    void push_back_many(const Pointer* elems, size_t n_elems) {
+        if (n_elems == 0) {
+            return;
+        }
+
+        MpscQueueData* first = NULL;
+        MpscQueueData* last = NULL;
+
+        for (size_t n = 0; n < n_elems; n++) {
+            OwnershipPolicy<T>::acquire(*elems[n]);
+
+            MpscQueueData* data = to_node_data_(*elems[n]);
+            if (last) {
+                AtomicOps::store_relaxed(last->next, data);
+            } else {
+                first = data;
+            }
+            last = data;
+        }
+
+        impl_.push_back_chain(first, last);
+    }
+
     //! Try to remove object from the beginning of the queue (non-blocking version).
     //! Should NOT be called concurrently.
     //! Releases ownership of the returned object.
@@ -123,7 +158,42 @@ public:
         return elem;
     }
 
+    //! Try to remove multiple objects from the beginning of the queue
+    //! (non-blocking version).
+    //! Should NOT be called concurrently.
+    //! Releases ownership of the returned objects.
+    //! @remarks
+    //!  - Removes up to @p max_elems objects and writes them to @p elems.
+    //!  - Returns number of removed objects, which may be zero.
+    //!  - Has same guarantees as try_pop_front_exclusive(), i.e. may return less
+    //!    objects than there are in the queue if concurrent push_back() or
+    //!    push_back_many() call is running.
+    size_t try_pop_front_many_exclusive(Pointer* elems, size_t max_elems) {
+        MpscQueueData* nodes[MaxPopBatch];
+
+        size_t n_elems = 0;
+
+        while (n_elems < max_elems) {
+            const size_t n_nodes = impl_.pop_front_many(
+                nodes, std::min(max_elems - n_elems, (size_t)MaxPopBatch), false);
+
+            for (size_t n = 0; n < n_nodes; n++) {
+                elems[n_elems] = from_node_data_(nodes[n]);
+                OwnershipPolicy<T>::release(*elems[n_elems]);
+                n_elems++;
+            }
+
+            if (n_nodes < MaxPopBatch) {
+                break;
+            }
+        }
+
+        return n_elems;
+    }
+
 private:
+    enum { MaxPopBatch = 32 };
+
     static MpscQueueData* to_node_data_(T& elem) {
         return static_cast<Node&>(elem).mpsc_queue_data();
     }
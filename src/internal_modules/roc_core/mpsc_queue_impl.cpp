@@ -15,7 +15,8 @@ namespace core {
 
 MpscQueueImpl::MpscQueueImpl()
     : tail_(&stub_)
-    , head_(&stub_) {
+    , head_(&stub_)
+    , stub_in_list_(true) {
 }
 
 MpscQueueImpl::~MpscQueueImpl() {
@@ -29,6 +30,16 @@ void MpscQueueImpl::push_back(MpscQueueData* node) {
     push_node_(node);
 }
 
+void MpscQueueImpl::push_back_chain(MpscQueueData* first, MpscQueueData* last) {
+    for (MpscQueueData* node = first;; node = AtomicOps::load_relaxed(node->next)) {
+        change_owner_(node, NULL, this);
+        if (node == last) {
+            break;
+        }
+    }
+    push_chain_(first, last);
+}
+
 MpscQueueData* MpscQueueImpl::pop_front(bool can_spin) {
     MpscQueueData* node = pop_node_(can_spin);
     if (node != NULL) {
@@ -37,10 +48,78 @@ MpscQueueData* MpscQueueImpl::pop_front(bool can_spin) {
     return node;
 }
 
+// Unlike pop_front(), doesn't pop nodes one by one. Instead, appends stub to
+// the end of the queue with a single exchange of tail, which detaches all nodes
+// between head and stub: producers now link new nodes after stub, so these
+// nodes are accessed only by consumer. Then walks detached nodes without
+// checking tail and without read-modify-write operations for every node.
+size_t MpscQueueImpl::pop_front_many(MpscQueueData** nodes,
+                                     size_t max_nodes,
+                                     bool can_spin) {
+    size_t n_nodes = 0;
+
+    while (n_nodes < max_nodes) {
+        MpscQueueData* head = AtomicOps::load_relaxed(head_);
+
+        if (head == &stub_) {
+            MpscQueueData* next = AtomicOps::load_acquire(stub_.next);
+            if (!next) {
+                if (AtomicOps::load_seq_cst(tail_) == &stub_) {
+                    // queue is empty
+                    break;
+                }
+                // queue is not empty, so stub->next == NULL means that
+                // a push_node_() call is in progress
+                if (!(next = (can_spin ? wait_next_(&stub_) : try_wait_next_(&stub_)))) {
+                    break;
+                }
+            }
+            // remove stub from the beginning of the list
+            AtomicOps::store_relaxed(head_, next);
+            stub_in_list_ = false;
+            head = next;
+        }
+
+        if (!stub_in_list_) {
+            // detach all nodes from head to current tail
+            push_node_(&stub_);
+            stub_in_list_ = true;
+        }
+
+        // Walk detached nodes until stub. Links between them are still loaded
+        // with acquire, because producers that added them may not have linked
+        // them yet (they update tail before linking).
+        while (n_nodes < max_nodes && head != &stub_) {
+            MpscQueueData* next = can_spin ? wait_next_(head) : try_wait_next_(head);
+            if (!next) {
+                // this may happen only if can_spin is false
+                AtomicOps::store_relaxed(head_, head);
+                return n_nodes;
+            }
+
+            release_owner_(head);
+            nodes[n_nodes++] = head;
+
+            head = next;
+        }
+
+        AtomicOps::store_relaxed(head_, head);
+    }
+
+    return n_nodes;
+}
+
 void MpscQueueImpl::push_node_(MpscQueueData* node) {
-    AtomicOps::store_relaxed(node->next, (MpscQueueData*)NULL);
-    MpscQueueData* prev = AtomicOps::exchange_seq_cst(tail_, node);
-    AtomicOps::store_release(prev->next, node);
+    push_chain_(node, node);
+}
+
+// Publish chain of nodes with a single atomic exchange.
+// Links between nodes of the chain are already set by the caller. They don't
+// need to be atomic, because they're published by the release store below.
+void MpscQueueImpl::push_chain_(MpscQueueData* first, MpscQueueData* last) {
+    AtomicOps::store_relaxed(last->next, (MpscQueueData*)NULL);
+    MpscQueueData* prev = AtomicOps::exchange_seq_cst(tail_, last);
+    AtomicOps::store_release(prev->next, first);
 }
 
 MpscQueueData* MpscQueueImpl::pop_node_(bool can_spin) {
@@ -63,6 +142,7 @@ MpscQueueData* MpscQueueImpl::pop_node_(bool can_spin) {
         }
         // remove stub from the beginning of the list
         AtomicOps::store_relaxed(head_, next);
+        stub_in_list_ = false;
         head = next;
         next = AtomicOps::load_acquire(next->next);
     }
@@ -75,6 +155,7 @@ MpscQueueData* MpscQueueImpl::pop_node_(bool can_spin) {
             // add stub to the end of the list to ensure that we always
             // have head->next when removing head and head wont become NULL
             push_node_(&stub_);
+            stub_in_list_ = true;
         }
 
         // if head->next == NULL here means that a push_node_() call is in progress
@@ -134,5 +215,17 @@ void MpscQueueImpl::change_owner_(MpscQueueData* node, void* from, void* to) {
     }
 }
 
+// Same as change_owner_(node, this, NULL), but without compare-and-swap.
+// Used for detached nodes: while node is still owned by this queue, nobody
+// else is allowed to change its owner, so plain load and store are enough.
+void MpscQueueImpl::release_owner_(MpscQueueData* node) {
+    void* cur = AtomicOps::load_relaxed(node->queue);
+    if (cur != this) {
+        roc_panic("mpsc queue: unexpected node owner: from=%p to=%p cur=%p",
+                  (void*)this, (void*)NULL, cur);
+    }
+    AtomicOps::store_relaxed(node->queue, (void*)NULL);
+}
+
 } // namespace core
 } // namespace roc
@@ -30,22 +30,39 @@ public:
     //! Add object to the end of the queue.
     void push_back(MpscQueueData* node);
 
+    //! Add chain of objects to the end of the queue.
+    //! @pre
+    //!  Nodes from @p first to @p last should be linked via next field.
+    void push_back_chain(MpscQueueData* first, MpscQueueData* last);
+
     //! Remove object from the beginning of the queue.
     MpscQueueData* pop_front(bool can_spin);
 
+    //! Remove up to @p max_nodes objects from the beginning of the queue.
+    //! Returns number of removed nodes written to @p nodes.
+    //! @remarks
+    //!  Detaches all nodes present in the queue using one atomic exchange,
+    //!  instead of checking queue tail for every removed node.
+    size_t pop_front_many(MpscQueueData** nodes, size_t max_nodes, bool can_spin);
+
 private:
     void push_node_(MpscQueueData* node);
+    void push_chain_(MpscQueueData* first, MpscQueueData* last);
     MpscQueueData* pop_node_(bool can_spin);
 
     MpscQueueData* wait_next_(MpscQueueData* node);
     MpscQueueData* try_wait_next_(MpscQueueData* node);
 
     void change_owner_(MpscQueueData* node, void* from, void* to);
+    void release_owner_(MpscQueueData* node);
 
     MpscQueueData* tail_;
     MpscQueueData* head_;
 
     MpscQueueData stub_;
+    // True if stub is reachable from head.
+    // Accessed only by consumer.
+    bool stub_in_list_;
 };
 
 } // namespace core
@@ -152,5 +152,66 @@ bool parse_size(const char* str, size_t& result) {
     return true;
 }
 
+bool parse_cpu_list(const char* str, uint64_t& result) {
+    if (str == NULL) {
+        roc_log(LogError, "parse cpu list: string is null");
+        return false;
+    }
+
+    const unsigned long max_cpu = 63;
+
+    uint64_t mask = 0;
+    const char* pos = str;
+
+    for (;;) {
+        if (!isdigit(*pos)) {
+            roc_log(LogError,
+                    "parse cpu list: invalid format: expected"
+                    " <cpu>[-<cpu>][,<cpu>[-<cpu>]...]");
+            return false;
+        }
+
+        char* end = NULL;
+        const unsigned long first = strtoul(pos, &end, 10);
+        unsigned long last = first;
+
+        if (*end == '-') {
+            pos = end + 1;
+            if (!isdigit(*pos)) {
+                roc_log(LogError,
+                        "parse cpu list: invalid format: expected"
+                        " <cpu>[-<cpu>][,<cpu>[-<cpu>]...]");
+                return false;
+            }
+            last = strtoul(pos, &end, 10);
+        }
+
+        if (first > last || last > max_cpu) {
+            roc_log(LogError,
+                    "parse cpu list: cpu out of range: first=%lu last=%lu maximum=%lu",
+                    first, last, max_cpu);
+            return false;
+        }
+
+        for (unsigned long cpu = first; cpu <= last; cpu++) {
+            mask |= (uint64_t)1 << cpu;
+        }
+
+        if (*end == '\0') {
+            break;
+        }
+        if (*end != ',') {
+            roc_log(LogError,
+                    "parse cpu list: invalid format: expected"
+                    " <cpu>[-<cpu>][,<cpu>[-<cpu>]...]");
+            return false;
+        }
+        pos = end + 1;
+    }
+
+    result = mask;
+    return true;
+}
+
 } // namespace core
 } // namespace roc
@@ -46,6 +46,17 @@ ROC_NODISCARD bool parse_duration(const char* string, nanoseconds_t& result);
 //!  false if string can't be parsed.
 ROC_NODISCARD bool parse_size(const char* string, size_t& result);
 
+//! Parse list of CPU indices into bitmask.
+//!
+//! @remarks
+//!  The input string should be a comma-separated list of CPU indices
+//!  or ranges, e.g. "0", "0,2", "1-3", "0,4-7". Indices should be
+//!  in range [0; 63]. Bit N of result corresponds to CPU N.
+//!
+//! @returns
+//!  false if string can't be parsed.
+ROC_NODISCARD bool parse_cpu_list(const char* string, uint64_t& result);
+
 } // namespace core
 } // namespace roc
 
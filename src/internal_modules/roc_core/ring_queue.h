@@ -77,12 +77,12 @@ public:
     }
 
     //! Is the queue empty.
-    bool is_empty() {
+    bool is_empty() const {
         return begin_ == end_;
     }
 
     //! Is the queue full.
-    bool is_full() {
+    bool is_full() const {
         return begin_ == (end_ + 1) % buff_len_;
     }
 
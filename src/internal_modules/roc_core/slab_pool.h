@@ -126,6 +126,27 @@ public:
         return impl_.num_guard_failures();
     }
 
+    //! Enable sharded magazine cache.
+    //! @remarks
+    //!  Reduces lock contention when pool is used from many threads.
+    //!  Should be called before pool is used concurrently.
+    //! @remarks
+    //!  Cache keeps up to SlabPoolCache::NumShards * 2 magazines of free
+    //!  slots, which remain allocated from arena. @p max_cached_bytes limits
+    //!  this memory by reducing magazine size; if zero, magazines have
+    //!  maximum size (SlabPoolCache::MaxMagazineSize slots). When pool
+    //!  can't allocate more memory from arena, cached slots are returned
+    //!  to pool before reporting failure.
+    //! @see SlabPoolCache.
+    ROC_NODISCARD bool enable_cache(size_t max_cached_bytes = 0) {
+        return impl_.enable_cache(max_cached_bytes);
+    }
+
+    //! Get sharded cache statistics.
+    SlabPoolCacheStats cache_stats() const {
+        return impl_.cache_stats();
+    }
+
 private:
     enum {
         SlotSize = (sizeof(SlabPoolImpl::SlotHeader) + sizeof(SlabPoolImpl::SlotCanary)
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/slab_pool_cache.h"
+#include "roc_core/atomic_ops.h"
+#include "roc_core/panic.h"
+#include "roc_core/slab_pool_impl.h"
+
+namespace roc {
+namespace core {
+
+namespace {
+
+// Map current thread to shard index.
+// Stacks of different threads are located in different memory regions, so
+// the address of a local variable, with low bits dropped, is a cheap and
+// portable per-thread value. Mapping doesn't need to be exact: if two threads
+// get the same shard, they will just contend on it.
+size_t current_shard(size_t n_shards) {
+    char marker = 0;
+    uint64_t h = (uint64_t)(uintptr_t)&marker >> 16;
+
+    // Fibonacci hashing.
+    h *= 0x9E3779B97F4A7C15ull;
+
+    return (size_t)(h >> 32) % n_shards;
+}
+
+} // namespace
+
+SlabPoolCache::Shard::Shard()
+    : lock(0)
+    , loaded(0) {
+    n_slots[0] = n_slots[1] = 0;
+}
+
+SlabPoolCache::SlabPoolCache(SlabPoolImpl& pool, size_t magazine_size)
+    : pool_(pool)
+    , magazine_size_(magazine_size)
+    , n_contended_(0)
+    , n_reclaimed_(0) {
+    roc_panic_if_msg(magazine_size_ < 1 || magazine_size_ > MaxMagazineSize,
+                     "slab pool cache: invalid magazine size: size=%lu max=%lu",
+                     (unsigned long)magazine_size_, (unsigned long)MaxMagazineSize);
+}
+
+SlabPoolCache::~SlabPoolCache() {
+    for (size_t n = 0; n < NumShards; n++) {
+        flush_shard_(shards_[n]);
+    }
+}
+
+void* SlabPoolCache::acquire() {
+    void* slot = NULL;
+
+    if (Shard* shard = lock_shard_()) {
+        slot = acquire_from_shard_(*shard);
+        unlock_shard_(shard);
+    } else {
+        pool_.acquire_slots_(&slot, 1);
+    }
+
+    if (!slot) {
+        // Pool is exhausted, but other shards may still keep free slots.
+        reclaim_();
+        pool_.acquire_slots_(&slot, 1);
+    }
+
+    return slot;
+}
+
+void SlabPoolCache::release(void* slot) {
+    roc_panic_if(!slot);
+
+    if (Shard* shard = lock_shard_()) {
+        release_to_shard_(*shard, slot);
+        unlock_shard_(shard);
+    } else {
+        pool_.release_slots_(&slot, 1);
+    }
+}
+
+size_t SlabPoolCache::magazine_size() const {
+    return magazine_size_;
+}
+
+size_t SlabPoolCache::max_cached_slots() const {
+    return NumShards * 2 * magazine_size_;
+}
+
+SlabPoolCacheStats SlabPoolCache::stats() const {
+    SlabPoolCacheStats total;
+
+    for (size_t n = 0; n < NumShards; n++) {
+        Shard& shard = shards_[n];
+
+        while (AtomicOps::exchange_acquire(shard.lock, 1) != 0) {
+        }
+
+        total.alloc_hits += shard.stats.alloc_hits;
+        total.alloc_misses += shard.stats.alloc_misses;
+        total.dealloc_hits += shard.stats.dealloc_hits;
+        total.dealloc_misses += shard.stats.dealloc_misses;
+        total.cached_slots += shard.n_slots[0] + shard.n_slots[1];
+
+        AtomicOps::store_release(shard.lock, 0);
+    }
+
+    total.contended = AtomicOps::load_relaxed(n_contended_);
+    total.reclaimed = AtomicOps::load_relaxed(n_reclaimed_);
+
+    return total;
+}
+
+void* SlabPoolCache::acquire_from_shard_(Shard& shard) {
+    // loaded magazine is empty, but previous is not
+    if (shard.n_slots[shard.loaded] == 0 && shard.n_slots[shard.loaded ^ 1] != 0) {
+        shard.loaded ^= 1;
+    }
+
+    size_t& n_slots = shard.n_slots[shard.loaded];
+    void** magazine = shard.magazines[shard.loaded];
+
+    if (n_slots != 0) {
+        shard.stats.alloc_hits++;
+    } else {
+        // both magazines are empty, refill loaded one
+        shard.stats.alloc_misses++;
+        n_slots = pool_.acquire_slots_(magazine, magazine_size_);
+    }
+
+    if (n_slots == 0) {
+        return NULL;
+    }
+
+    return magazine[--n_slots];
+}
+
+void SlabPoolCache::release_to_shard_(Shard& shard, void* slot) {
+    // loaded magazine is full, but previous is not
+    if (shard.n_slots[shard.loaded] == magazine_size_
+        && shard.n_slots[shard.loaded ^ 1] != magazine_size_) {
+        shard.loaded ^= 1;
+    }
+
+    size_t& n_slots = shard.n_slots[shard.loaded];
+    void** magazine = shard.magazines[shard.loaded];
+
+    if (n_slots != magazine_size_) {
+        shard.stats.dealloc_hits++;
+    } else {
+        // both magazines are full, flush loaded one
+        shard.stats.dealloc_misses++;
+        pool_.release_slots_(magazine, n_slots);
+        n_slots = 0;
+    }
+
+    magazine[n_slots++] = slot;
+}
+
+SlabPoolCache::Shard* SlabPoolCache::lock_shard_() {
+    const size_t index = current_shard(NumShards);
+
+    // Try own shard and its neighbour, then give up.
+    for (size_t n = 0; n < 2; n++) {
+        Shard* shard = &shards_[(index + n) % NumShards];
+
+        if (AtomicOps::load_relaxed(shard->lock) == 0
+            && AtomicOps::exchange_acquire(shard->lock, 1) == 0) {
+            return shard;
+        }
+    }
+
+    AtomicOps::fetch_add_relaxed(n_contended_, 1);
+    return NULL;
+}
+
+void SlabPoolCache::unlock_shard_(Shard* shard) {
+    AtomicOps::store_release(shard->lock, 0);
+}
+
+void SlabPoolCache::flush_shard_(Shard& shard) {
+    for (size_t n = 0; n < 2; n++) {
+        pool_.release_slots_(shard.magazines[n], shard.n_slots[n]);
+        shard.n_slots[n] = 0;
+    }
+}
+
+void SlabPoolCache::reclaim_() {
+    // Shards are only try-locked: waiting for a busy shard here could
+    // deadlock with its owner, and busy shard is being used anyway.
+    for (size_t n = 0; n < NumShards; n++) {
+        Shard& shard = shards_[n];
+
+        if (AtomicOps::exchange_acquire(shard.lock, 1) != 0) {
+            continue;
+        }
+
+        const size_t n_slots = shard.n_slots[0] + shard.n_slots[1];
+        if (n_slots != 0) {
+            flush_shard_(shard);
+            AtomicOps::fetch_add_relaxed(n_reclaimed_, (uint64_t)n_slots);
+        }
+
+        AtomicOps::store_release(shard.lock, 0);
+    }
+}
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_core/slab_pool_cache.h
+//! @brief Sharded magazine cache for slab pool.
+
+#ifndef ROC_CORE_SLAB_POOL_CACHE_H_
+#define ROC_CORE_SLAB_POOL_CACHE_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace core {
+
+class SlabPoolImpl;
+
+//! Slab pool cache statistics.
+struct SlabPoolCacheStats {
+    //! Number of allocations served from cache.
+    uint64_t alloc_hits;
+    //! Number of allocations that required refilling cache from pool.
+    uint64_t alloc_misses;
+    //! Number of deallocations absorbed by cache.
+    uint64_t dealloc_hits;
+    //! Number of deallocations that required flushing cache to pool.
+    uint64_t dealloc_misses;
+    //! Number of operations that bypassed cache because shard was busy.
+    uint64_t contended;
+    //! Number of slots returned from cache to exhausted pool.
+    uint64_t reclaimed;
+    //! Number of free slots currently kept in cache.
+    uint64_t cached_slots;
+
+    SlabPoolCacheStats()
+        : alloc_hits(0)
+        , alloc_misses(0)
+        , dealloc_hits(0)
+        , dealloc_misses(0)
+        , contended(0)
+        , reclaimed(0)
+        , cached_slots(0) {
+    }
+};
+
+//! Sharded magazine cache for slab pool.
+//!
+//! Sits in front of SlabPoolImpl and reduces contention on its mutex.
+//!
+//! This is not a true per-thread cache: threads don't own anything and don't
+//! register themselves. Cache consists of a fixed number of shards, and each
+//! thread picks a shard based on the address of its stack, so that in most
+//! cases different threads use different shards. This keeps the cache usable
+//! from any thread (network, pipeline, and user threads) without thread-local
+//! storage or per-thread handles, at the cost of occasional collisions.
+//!
+//! Every shard holds two "magazines" (small arrays of free slots), as described
+//! in Bonwick's "Magazines and Vmem" paper. Allocations and deallocations are
+//! served from the loaded magazine; when it becomes empty or full, it's swapped
+//! with the previous one, and only when both are empty or full, a whole
+//! magazine is refilled from or flushed to the pool under a single lock.
+//!
+//! Shards are protected with a try-lock. If the shard is already used by
+//! another thread that was mapped to the same shard, the operation goes
+//! directly to the pool instead of waiting.
+//!
+//! Slots kept in magazines are free, but from the pool's point of view they
+//! are in use. Up to NumShards * 2 * magazine_size() slots can be held this
+//! way, so magazine size is derived from the memory budget passed to
+//! SlabPoolImpl::enable_cache(). When the pool can't allocate a slot (e.g.
+//! arena limit is reached), cache returns slots from all shards that are
+//! not busy back to the pool and retries, so cached slots are never lost
+//! for other threads.
+//!
+//! @see SlabPoolImpl.
+class SlabPoolCache : public NonCopyable<> {
+public:
+    //! Number of shards.
+    static const size_t NumShards = 16;
+
+    //! Maximum number of slots in one magazine.
+    static const size_t MaxMagazineSize = 32;
+
+    //! Initialize.
+    //! @p magazine_size should be in range [1; MaxMagazineSize].
+    SlabPoolCache(SlabPoolImpl& pool, size_t magazine_size);
+
+    //! Return all cached slots to pool.
+    ~SlabPoolCache();
+
+    //! Get slot from cache, refilling cache if needed.
+    //! @returns
+    //!  NULL if cache is empty and pool can't allocate more slots.
+    void* acquire();
+
+    //! Return slot to cache, flushing cache if needed.
+    void release(void* slot);
+
+    //! Get number of slots in one magazine.
+    size_t magazine_size() const;
+
+    //! Get maximum number of free slots that can be kept in cache.
+    size_t max_cached_slots() const;
+
+    //! Get statistics.
+    SlabPoolCacheStats stats() const;
+
+private:
+    struct Shard {
+        int lock;
+
+        // magazines[loaded] is the loaded magazine,
+        // magazines[loaded ^ 1] is the previous one
+        size_t loaded;
+        size_t n_slots[2];
+        void* magazines[2][MaxMagazineSize];
+
+        SlabPoolCacheStats stats;
+
+        // avoid false sharing of lock with neighbour shard
+        char padding[64];
+
+        Shard();
+    };
+
+    Shard* lock_shard_();
+    void unlock_shard_(Shard* shard);
+
+    void* acquire_from_shard_(Shard& shard);
+    void release_to_shard_(Shard& shard, void* slot);
+
+    void flush_shard_(Shard& shard);
+    void reclaim_();
+
+    SlabPoolImpl& pool_;
+    const size_t magazine_size_;
+
+    mutable Shard shards_[NumShards];
+    uint64_t n_contended_;
+    uint64_t n_reclaimed_;
+};
+
+} // namespace core
+} // namespace roc
+
+#endif // ROC_CORE_SLAB_POOL_CACHE_H_
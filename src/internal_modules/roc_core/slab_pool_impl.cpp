@@ -52,7 +52,8 @@ SlabPoolImpl::SlabPoolImpl(const char* name,
     , object_size_(object_size)
     , object_size_padding_(slot_size_ - unaligned_slot_size_)
     , guards_(guards)
-    , num_guard_failures_(0) {
+    , num_guard_failures_(0)
+    , cache_(NULL) {
     roc_panic_if_not(slab_cur_slots_ > 0);
     roc_panic_if_not(slab_cur_slots_ <= slab_max_slots_ || slab_max_slots_ == 0);
 
@@ -71,6 +72,23 @@ SlabPoolImpl::SlabPoolImpl(const char* name,
 }
 
 SlabPoolImpl::~SlabPoolImpl() {
+    if (cache_) {
+        const SlabPoolCacheStats stats = cache_->stats();
+
+        roc_log(LogDebug,
+                "slab pool (%s): cache stats:"
+                " alloc_hits=%lu alloc_misses=%lu dealloc_hits=%lu dealloc_misses=%lu"
+                " contended=%lu reclaimed=%lu",
+                name_, (unsigned long)stats.alloc_hits,
+                (unsigned long)stats.alloc_misses, (unsigned long)stats.dealloc_hits,
+                (unsigned long)stats.dealloc_misses, (unsigned long)stats.contended,
+                (unsigned long)stats.reclaimed);
+
+        cache_->~SlabPoolCache();
+        arena_.deallocate(cache_);
+        cache_ = NULL;
+    }
+
     deallocate_everything_();
 }
 
@@ -83,7 +101,9 @@ bool SlabPoolImpl::reserve(size_t n_objects) {
 void* SlabPoolImpl::allocate() {
     Slot* slot;
 
-    {
+    if (cache_) {
+        slot = (Slot*)cache_->acquire();
+    } else {
         Mutex::Lock lock(mutex_);
 
         slot = acquire_slot_();
@@ -107,7 +127,9 @@ void SlabPoolImpl::deallocate(void* memory) {
         return;
     }
 
-    {
+    if (cache_) {
+        cache_->release(slot);
+    } else {
         Mutex::Lock lock(mutex_);
 
         release_slot_(slot);
@@ -130,6 +152,56 @@ size_t SlabPoolImpl::num_guard_failures() const {
     return num_guard_failures_;
 }
 
+bool SlabPoolImpl::enable_cache(size_t max_cached_bytes) {
+    if (cache_) {
+        return true;
+    }
+
+    size_t magazine_size = SlabPoolCache::MaxMagazineSize;
+
+    if (max_cached_bytes != 0) {
+        // every shard holds two magazines
+        const size_t max_shard_slots =
+            max_cached_bytes / slot_size_ / (SlabPoolCache::NumShards * 2);
+
+        magazine_size = std::min(magazine_size, max_shard_slots);
+    }
+
+    if (magazine_size == 0) {
+        roc_log(LogDebug,
+                "slab pool (%s): not enabling cache, limit is too small:"
+                " max_cached_bytes=%lu slot_size=%lu",
+                name_, (unsigned long)max_cached_bytes, (unsigned long)slot_size_);
+        return true;
+    }
+
+    void* memory = arena_.allocate(sizeof(SlabPoolCache));
+    if (!memory) {
+        roc_log(LogError, "slab pool (%s): can't allocate cache", name_);
+        return false;
+    }
+
+    cache_ = new (memory) SlabPoolCache(*this, magazine_size);
+
+    roc_log(LogDebug,
+            "slab pool (%s): enabled cache:"
+            " n_shards=%lu magazine_size=%lu max_cached=%lu(%lu slots)",
+            name_, (unsigned long)SlabPoolCache::NumShards,
+            (unsigned long)magazine_size,
+            (unsigned long)(cache_->max_cached_slots() * slot_size_),
+            (unsigned long)cache_->max_cached_slots());
+
+    return true;
+}
+
+SlabPoolCacheStats SlabPoolImpl::cache_stats() const {
+    if (!cache_) {
+        return SlabPoolCacheStats();
+    }
+
+    return cache_->stats();
+}
+
 void* SlabPoolImpl::give_slot_to_user_(Slot* slot) {
     slot->~Slot();
 
@@ -209,6 +281,34 @@ void SlabPoolImpl::release_slot_(Slot* slot) {
     free_slots_.push_front(*slot);
 }
 
+size_t SlabPoolImpl::acquire_slots_(void** slots, size_t n_slots) {
+    Mutex::Lock lock(mutex_);
+
+    size_t n = 0;
+
+    for (; n < n_slots; n++) {
+        Slot* slot = acquire_slot_();
+        if (!slot) {
+            break;
+        }
+        slots[n] = slot;
+    }
+
+    return n;
+}
+
+void SlabPoolImpl::release_slots_(void** slots, size_t n_slots) {
+    if (n_slots == 0) {
+        return;
+    }
+
+    Mutex::Lock lock(mutex_);
+
+    for (size_t n = 0; n < n_slots; n++) {
+        release_slot_((Slot*)slots[n]);
+    }
+}
+
 bool SlabPoolImpl::reserve_slots_(size_t desired_slots) {
     if (desired_slots > free_slots_.size()) {
         increase_slab_size_(desired_slots - free_slots_.size());
@@ -18,6 +18,7 @@
 #include "roc_core/list.h"
 #include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/slab_pool_cache.h"
 #include "roc_core/stddefs.h"
 
 namespace roc {
@@ -42,6 +43,10 @@ namespace core {
 //! If user data requires padding to be maximum-aligned, this padding
 //! also becomes part of the trailing canary guard.
 //!
+//! Optionally, pool can use SlabPoolCache, which keeps free slots in
+//! magazines sharded between threads and refills and flushes them in
+//! batches, to reduce contention on the pool mutex.
+//!
 //! @see SlabPool.
 class SlabPoolImpl : public NonCopyable<> {
 public:
@@ -87,7 +92,23 @@ public:
     //! Get number of guard failures.
     size_t num_guard_failures() const;
 
+    //! Enable sharded cache.
+    //! @remarks
+    //!  Should be called before pool is used concurrently.
+    //!  Cache memory is allocated from arena.
+    //!  @p max_cached_bytes limits memory of free slots kept in cache;
+    //!  if zero, magazines have maximum size. If the limit is too small
+    //!  for even one slot per magazine, cache is not enabled.
+    ROC_NODISCARD bool enable_cache(size_t max_cached_bytes);
+
+    //! Get sharded cache statistics.
+    //! @remarks
+    //!  Returns zero statistics if cache is not enabled.
+    SlabPoolCacheStats cache_stats() const;
+
 private:
+    friend class SlabPoolCache;
+
     struct Slab : ListNode<> {};
     struct Slot : ListNode<> {};
 
@@ -96,6 +117,9 @@ private:
 
     Slot* acquire_slot_();
     void release_slot_(Slot* slot);
+
+    size_t acquire_slots_(void** slots, size_t n_slots);
+    void release_slots_(void** slots, size_t n_slots);
     bool reserve_slots_(size_t desired_slots);
 
     void increase_slab_size_(size_t desired_n_slots);
@@ -133,6 +157,8 @@ private:
 
     const size_t guards_;
     mutable size_t num_guard_failures_;
+
+    SlabPoolCache* cache_;
 };
 
 } // namespace core
@@ -11,9 +11,14 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 
+#include <errno.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <unistd.h>
 
 #if defined(__linux__)
+#include <linux/capability.h>
 #include <sys/syscall.h>
 #elif defined(__FreeBSD__) || defined(__OpenBSD__)
 #include <pthread_np.h>
@@ -24,6 +29,152 @@
 namespace roc {
 namespace core {
 
+namespace {
+
+Atomic<size_t> config_failures;
+
+// Protects mlock_count.
+pthread_mutex_t mlock_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Number of successful lock_memory() calls not yet paired with unlock_memory().
+size_t mlock_count = 0;
+
+int policy_to_os(ThreadPolicy policy) {
+    switch (policy) {
+    case ThreadPolicy_Fifo:
+        return SCHED_FIFO;
+    case ThreadPolicy_RoundRobin:
+        return SCHED_RR;
+    case ThreadPolicy_Default:
+        break;
+    }
+    return SCHED_OTHER;
+}
+
+const char* os_policy_to_str(int policy) {
+    switch (policy) {
+    case SCHED_FIFO:
+        return "fifo";
+    case SCHED_RR:
+        return "rr";
+    case SCHED_OTHER:
+        return "other";
+    }
+    return "unknown";
+}
+
+bool set_policy(const ThreadConfig& config) {
+    const int policy = policy_to_os(config.policy);
+
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority =
+        config.priority != 0 ? config.priority : sched_get_priority_min(policy);
+
+    if (int err = pthread_setschedparam(pthread_self(), policy, &param)) {
+        roc_log(LogError,
+                "thread: can't set scheduling policy: policy=%s priority=%d:"
+                " pthread_setschedparam(): %s",
+                thread_policy_to_str(config.policy), (int)param.sched_priority,
+                errno_to_str(err).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool set_affinity(const ThreadConfig& config) {
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    for (size_t n = 0; n < 64; n++) {
+        if (config.cpu_mask & ((uint64_t)1 << n)) {
+            CPU_SET(n, &cpu_set);
+        }
+    }
+
+    if (int err = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set)) {
+        roc_log(LogError,
+                "thread: can't set cpu affinity: cpu_mask=0x%llx:"
+                " pthread_setaffinity_np(): %s",
+                (unsigned long long)config.cpu_mask, errno_to_str(err).c_str());
+        return false;
+    }
+
+    return true;
+#else
+    roc_log(LogError,
+            "thread: can't set cpu affinity: cpu_mask=0x%llx:"
+            " not supported on this platform",
+            (unsigned long long)config.cpu_mask);
+    return false;
+#endif
+}
+
+uint64_t get_affinity() {
+    uint64_t mask = 0;
+
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+
+    if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0) {
+        for (size_t n = 0; n < 64; n++) {
+            if (CPU_ISSET(n, &cpu_set)) {
+                mask |= (uint64_t)1 << n;
+            }
+        }
+    }
+#endif
+
+    return mask;
+}
+
+// Check if process may lock unlimited amount of memory.
+// Otherwise, locking future pages can make any allocation in the process
+// fail when RLIMIT_MEMLOCK is reached.
+bool can_lock_unlimited() {
+    rlimit lim;
+    memset(&lim, 0, sizeof(lim));
+
+    if (getrlimit(RLIMIT_MEMLOCK, &lim) == 0 && lim.rlim_cur == RLIM_INFINITY) {
+        return true;
+    }
+
+#if defined(__linux__) && defined(SYS_capget)
+    __user_cap_header_struct cap_header;
+    memset(&cap_header, 0, sizeof(cap_header));
+    cap_header.version = _LINUX_CAPABILITY_VERSION_3;
+    cap_header.pid = 0;
+
+    __user_cap_data_struct cap_data[_LINUX_CAPABILITY_U32S_3];
+    memset(cap_data, 0, sizeof(cap_data));
+
+    if (syscall(SYS_capget, &cap_header, cap_data) == 0
+        && (cap_data[CAP_TO_INDEX(CAP_IPC_LOCK)].effective
+            & CAP_TO_MASK(CAP_IPC_LOCK))) {
+        return true;
+    }
+#endif
+
+    return false;
+}
+
+} // namespace
+
+const char* thread_policy_to_str(ThreadPolicy policy) {
+    switch (policy) {
+    case ThreadPolicy_Default:
+        return "default";
+    case ThreadPolicy_Fifo:
+        return "fifo";
+    case ThreadPolicy_RoundRobin:
+        return "rr";
+    }
+    return "<invalid>";
+}
+
 uint64_t Thread::get_pid() {
     return (uint64_t)getpid();
 }
@@ -61,11 +212,96 @@ bool Thread::enable_realtime() {
     return true;
 }
 
+bool Thread::apply_config(const ThreadConfig& config) {
+    if (config.is_default()) {
+        return true;
+    }
+
+    bool ok = true;
+
+    if (config.policy != ThreadPolicy_Default && !set_policy(config)) {
+        ok = false;
+    }
+
+    if (config.cpu_mask != 0 && !set_affinity(config)) {
+        ok = false;
+    }
+
+    // Report what OS actually uses, which may differ from what was requested.
+    int policy = SCHED_OTHER;
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    (void)pthread_getschedparam(pthread_self(), &policy, &param);
+
+    roc_log(ok ? LogInfo : LogError,
+            "thread: %s scheduling parameters: tid=%llu"
+            " effective_policy=%s effective_priority=%d effective_cpu_mask=0x%llx",
+            ok ? "applied" : "failed to apply",
+            (unsigned long long)get_tid(), os_policy_to_str(policy),
+            (int)param.sched_priority, (unsigned long long)get_affinity());
+
+    if (!ok) {
+        config_failures++;
+    }
+
+    return ok;
+}
+
+bool Thread::lock_memory() {
+    pthread_mutex_lock(&mlock_mutex);
+
+    const bool lock_future = can_lock_unlimited();
+
+    if (mlockall(lock_future ? (MCL_CURRENT | MCL_FUTURE) : MCL_CURRENT) != 0) {
+        roc_log(LogError, "thread: can't lock memory: mlockall(): %s",
+                errno_to_str(errno).c_str());
+        config_failures++;
+        pthread_mutex_unlock(&mlock_mutex);
+        return false;
+    }
+
+    mlock_count++;
+
+    roc_log(LogInfo, "thread: locked process memory: future_pages=%d lock_count=%lu",
+            (int)lock_future, (unsigned long)mlock_count);
+
+    pthread_mutex_unlock(&mlock_mutex);
+    return true;
+}
+
+void Thread::unlock_memory() {
+    pthread_mutex_lock(&mlock_mutex);
+
+    roc_panic_if_msg(mlock_count == 0,
+                     "thread: unlock_memory() called without lock_memory()");
+
+    if (--mlock_count == 0) {
+        if (munlockall() != 0) {
+            roc_log(LogError, "thread: can't unlock memory: munlockall(): %s",
+                    errno_to_str(errno).c_str());
+        } else {
+            roc_log(LogInfo, "thread: unlocked process memory");
+        }
+    }
+
+    pthread_mutex_unlock(&mlock_mutex);
+}
+
+size_t Thread::num_config_failures() {
+    return config_failures;
+}
+
 Thread::Thread()
     : started_(0)
     , joinable_(0) {
 }
 
+Thread::Thread(const ThreadConfig& config)
+    : config_(config)
+    , started_(0)
+    , joinable_(0) {
+}
+
 Thread::~Thread() {
     if (is_joinable()) {
         roc_panic("thread: thread was not joined before calling destructor");
@@ -111,7 +347,12 @@ void Thread::join() {
 }
 
 void* Thread::thread_runner_(void* ptr) {
-    static_cast<Thread*>(ptr)->run();
+    Thread& thread = *static_cast<Thread*>(ptr);
+
+    // On failure, thread keeps running with default parameters.
+    apply_config(thread.config_);
+
+    thread.run();
     return NULL;
 }
 
@@ -23,6 +23,48 @@
 namespace roc {
 namespace core {
 
+//! Thread scheduling policy.
+enum ThreadPolicy {
+    //! Don't change scheduling policy.
+    ThreadPolicy_Default,
+
+    //! Realtime first-in, first-out policy (SCHED_FIFO).
+    ThreadPolicy_Fifo,
+
+    //! Realtime round-robin policy (SCHED_RR).
+    ThreadPolicy_RoundRobin
+};
+
+//! Thread scheduling parameters.
+struct ThreadConfig {
+    //! Scheduling policy.
+    ThreadPolicy policy;
+
+    //! Scheduling priority.
+    //! Used only with realtime policies. If zero, minimum priority
+    //! for policy is used.
+    int priority;
+
+    //! Bitmask of CPUs on which thread is allowed to run.
+    //! Bit N corresponds to CPU N. If zero, affinity is not changed.
+    //! Supported only on Linux.
+    uint64_t cpu_mask;
+
+    ThreadConfig()
+        : policy(ThreadPolicy_Default)
+        , priority(0)
+        , cpu_mask(0) {
+    }
+
+    //! Check if config requests any changes.
+    bool is_default() const {
+        return policy == ThreadPolicy_Default && cpu_mask == 0;
+    }
+};
+
+//! Get string name of thread policy.
+const char* thread_policy_to_str(ThreadPolicy policy);
+
 //! Base class for thread objects.
 class Thread : public NonCopyable<Thread> {
 public:
@@ -35,6 +77,35 @@ public:
     //! Raise current thread priority to realtime.
     ROC_NODISCARD static bool enable_realtime();
 
+    //! Apply scheduling parameters to current thread.
+    //! @remarks
+    //!  Logs effective parameters. On failure, logs error and increments
+    //!  the counter returned by num_config_failures().
+    static bool apply_config(const ThreadConfig& config);
+
+    //! Lock pages of process in memory.
+    //! @remarks
+    //!  Prevents page faults in realtime threads. Affects the whole process,
+    //!  not only current thread. Usually requires privileges or large enough
+    //!  RLIMIT_MEMLOCK.
+    //!  Always locks pages that are currently mapped (MCL_CURRENT). Pages
+    //!  mapped later are locked too (MCL_FUTURE) only if RLIMIT_MEMLOCK is
+    //!  unlimited or process has CAP_IPC_LOCK, because otherwise any
+    //!  allocation in the process would fail after reaching the limit.
+    //!  Calls are reference-counted: memory is unlocked when unlock_memory()
+    //!  was called for every successful lock_memory().
+    ROC_NODISCARD static bool lock_memory();
+
+    //! Unlock pages of process locked by lock_memory().
+    //! @remarks
+    //!  Calls munlockall() when it's called for the last successful
+    //!  lock_memory(); otherwise only decrements reference counter.
+    static void unlock_memory();
+
+    //! Get number of failed apply_config() and lock_memory() calls
+    //! since process start.
+    static size_t num_config_failures();
+
     //! Check if thread was started and can be joined.
     //! @returns
     //!  true if start() was called and join() was not called yet.
@@ -55,12 +126,18 @@ protected:
 
     Thread();
 
+    //! Initialize with scheduling parameters.
+    //! Parameters are applied to the new thread before calling run().
+    explicit Thread(const ThreadConfig& config);
+
     //! Method to be executed in thread.
     virtual void run() = 0;
 
 private:
     static void* thread_runner_(void* ptr);
 
+    const ThreadConfig config_;
+
     pthread_t thread_;
 
     int started_;
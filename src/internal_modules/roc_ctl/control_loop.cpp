@@ -90,9 +90,12 @@ ControlLoop::Tasks::PipelineProcessing::PipelineProcessing(
     , pipeline_(pipeline) {
 }
 
-ControlLoop::ControlLoop(netio::NetworkLoop& network_loop, core::IArena& arena)
+ControlLoop::ControlLoop(netio::NetworkLoop& network_loop,
+                         core::IArena& arena,
+                         const core::ThreadConfig& thread_config)
     : network_loop_(network_loop)
-    , arena_(arena) {
+    , arena_(arena)
+    , task_queue_(thread_config) {
 }
 
 ControlLoop::~ControlLoop() {
@@ -174,7 +174,10 @@ public:
     };
 
     //! Initialize.
-    ControlLoop(netio::NetworkLoop& network_loop, core::IArena& arena);
+    //! @p thread_config defines scheduling parameters of control thread.
+    ControlLoop(netio::NetworkLoop& network_loop,
+                core::IArena& arena,
+                const core::ThreadConfig& thread_config = core::ThreadConfig());
 
     virtual ~ControlLoop();
 
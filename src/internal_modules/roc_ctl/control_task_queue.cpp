@@ -14,8 +14,9 @@
 namespace roc {
 namespace ctl {
 
-ControlTaskQueue::ControlTaskQueue()
-    : started_(false)
+ControlTaskQueue::ControlTaskQueue(const core::ThreadConfig& thread_config)
+    : Thread(thread_config)
+    , started_(false)
     , stop_(false)
     , fetch_ready_(true)
     , ready_queue_size_(0)
@@ -127,8 +127,10 @@ class ControlTaskQueue : private core::Thread {
 public:
     //! Initialize.
     //! @remarks
-    //!  Starts background thread.
-    ControlTaskQueue();
+    //!  Starts background thread. @p thread_config defines scheduling
+    //!  parameters of background thread.
+    explicit ControlTaskQueue(
+        const core::ThreadConfig& thread_config = core::ThreadConfig());
 
     //! Destroy.
     //! @remarks
@@ -15,7 +15,8 @@ namespace roc {
 namespace dbgio {
 
 CsvDumper::CsvDumper(const CsvConfig& config, core::IArena& arena)
-    : config_(config)
+    : Thread(config.thread_config)
+    , config_(config)
     , open_flag_(false)
     , stop_flag_(false)
     , file_(NULL)
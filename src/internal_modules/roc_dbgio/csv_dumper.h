@@ -64,6 +64,11 @@ struct CsvConfig {
     //! While rate limit is reached, entries are dropped.
     size_t max_burst_size;
 
+    //! Scheduling parameters of background thread.
+    //! Thread performs blocking file I/O, so it usually should not use
+    //! realtime policy, but may be restricted to specific CPUs.
+    core::ThreadConfig thread_config;
+
     CsvConfig()
         : dump_file(NULL)
         , max_queued(1000)
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_dbgio/packet_capture_format.h
+//! @brief Packet capture file format.
+
+#ifndef ROC_DBGIO_PACKET_CAPTURE_FORMAT_H_
+#define ROC_DBGIO_PACKET_CAPTURE_FORMAT_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace dbgio {
+
+//! Packet capture file magic ("RCAP").
+static const uint32_t PacketCapture_Magic = 0x50414352;
+
+//! Packet capture format version.
+static const uint16_t PacketCapture_Version = 1;
+
+//! Maximum length of host string in capture record.
+static const size_t PacketCapture_MaxHostLen = 64;
+
+//! Packet capture file header.
+//! @remarks
+//!  Capture file consists of file header followed by records, one per
+//!  packet, in order in which packets entered receiver pipeline.
+//!  All integers are little-endian.
+ROC_PACKED_BEGIN struct PacketCaptureFileHeader {
+    //! Magic number (PacketCapture_Magic).
+    uint32_t magic;
+    //! Format version (PacketCapture_Version).
+    uint16_t version;
+    //! Reserved, zero.
+    uint16_t reserved;
+} ROC_PACKED_END;
+
+//! Packet capture record header.
+//! @remarks
+//!  Followed by @p host_len bytes of source host (IP address string, without
+//!  terminator), and then by @p packet_size bytes of packet, as received
+//!  from network.
+ROC_PACKED_BEGIN struct PacketCaptureRecordHeader {
+    //! Packet receive timestamp, nanoseconds since Unix epoch.
+    int64_t receive_timestamp;
+    //! Size of packet in bytes.
+    uint32_t packet_size;
+    //! Protocol of receiver endpoint (address::Protocol).
+    uint8_t proto;
+    //! Length of source host string.
+    uint8_t host_len;
+    //! Source port.
+    uint16_t port;
+} ROC_PACKED_END;
+
+} // namespace dbgio
+} // namespace roc
+
+#endif // ROC_DBGIO_PACKET_CAPTURE_FORMAT_H_
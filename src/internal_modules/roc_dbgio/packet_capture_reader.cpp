@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_dbgio/packet_capture_reader.h"
+#include "roc_address/protocol_map.h"
+#include "roc_core/endian_ops.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_dbgio/packet_capture_format.h"
+
+namespace roc {
+namespace dbgio {
+
+PacketCaptureReader::PacketCaptureReader(packet::PacketFactory& packet_factory)
+    : packet_factory_(packet_factory)
+    , file_(NULL)
+    , path_(NULL)
+    , n_read_(0)
+    , n_skipped_(0) {
+}
+
+PacketCaptureReader::~PacketCaptureReader() {
+    close();
+}
+
+status::StatusCode PacketCaptureReader::open(const char* path) {
+    roc_panic_if(!path);
+
+    if (file_) {
+        roc_panic("packet capture: open() already called");
+    }
+
+    file_ = fopen(path, "rb");
+    if (!file_) {
+        roc_log(LogError, "packet capture: failed to open input file \"%s\": %s", path,
+                core::errno_to_str().c_str());
+        return status::StatusErrFile;
+    }
+
+    path_ = path;
+
+    PacketCaptureFileHeader header;
+    if (!read_bytes_(&header, sizeof(header))) {
+        roc_log(LogError, "packet capture: failed to read header from \"%s\"", path);
+        close();
+        return status::StatusErrFile;
+    }
+
+    const uint32_t magic = core::EndianOps::swap_native_le(header.magic);
+    const uint16_t version = core::EndianOps::swap_native_le(header.version);
+
+    if (magic != PacketCapture_Magic) {
+        roc_log(LogError, "packet capture: not a capture file: \"%s\"", path);
+        close();
+        return status::StatusErrFile;
+    }
+
+    if (version != PacketCapture_Version) {
+        roc_log(LogError,
+                "packet capture: unsupported capture version:"
+                " file=\"%s\" version=%u supported=%u",
+                path, (unsigned)version, (unsigned)PacketCapture_Version);
+        close();
+        return status::StatusErrFile;
+    }
+
+    return status::StatusOK;
+}
+
+void PacketCaptureReader::close() {
+    if (!file_) {
+        return;
+    }
+
+    if (fclose(file_) != 0) {
+        roc_log(LogError, "packet capture: failed to close input file: %s",
+                core::errno_to_str().c_str());
+    }
+
+    roc_log(LogDebug, "packet capture: closed input file: n_read=%lu n_skipped=%lu",
+            (unsigned long)n_read_, (unsigned long)n_skipped_);
+
+    file_ = NULL;
+}
+
+status::StatusCode PacketCaptureReader::read(packet::PacketPtr& packet,
+                                             address::Protocol& proto) {
+    roc_panic_if(!file_);
+
+    for (;;) {
+        PacketCaptureRecordHeader header;
+        if (!read_bytes_(&header, sizeof(header))) {
+            return ferror(file_) ? status::StatusErrFile : status::StatusFinish;
+        }
+
+        const core::nanoseconds_t receive_ts =
+            (core::nanoseconds_t)core::EndianOps::swap_native_le(
+                header.receive_timestamp);
+        const size_t packet_size = core::EndianOps::swap_native_le(header.packet_size);
+        const int port = core::EndianOps::swap_native_le(header.port);
+
+        char host[PacketCapture_MaxHostLen + 1] = {};
+        if (header.host_len > PacketCapture_MaxHostLen) {
+            roc_log(LogError, "packet capture: corrupted record in \"%s\"", path_);
+            return status::StatusErrFile;
+        }
+        if (header.host_len != 0 && !read_bytes_(host, header.host_len)) {
+            break;
+        }
+
+        const address::ProtocolAttrs* proto_attrs =
+            address::ProtocolMap::instance().find_by_id(
+                (address::Protocol)header.proto);
+
+        if (!proto_attrs || packet_size > packet_factory_.packet_buffer_size()) {
+            roc_log(LogDebug,
+                    "packet capture: skipping record: proto=%u size=%lu max_size=%lu",
+                    (unsigned)header.proto, (unsigned long)packet_size,
+                    (unsigned long)packet_factory_.packet_buffer_size());
+            if (!skip_bytes_(packet_size)) {
+                break;
+            }
+            n_skipped_++;
+            continue;
+        }
+
+        core::BufferPtr bp = packet_factory_.new_packet_buffer();
+        if (!bp) {
+            return status::StatusNoMem;
+        }
+
+        if (packet_size != 0 && !read_bytes_(bp->data(), packet_size)) {
+            break;
+        }
+
+        packet::PacketPtr pp = packet_factory_.new_packet();
+        if (!pp) {
+            return status::StatusNoMem;
+        }
+
+        pp->add_flags(packet::Packet::FlagUDP);
+
+        if (header.host_len != 0 && !pp->udp()->src_addr.set_host_port_auto(host, port)) {
+            roc_log(LogDebug, "packet capture: can't parse source address: %s:%d", host,
+                    port);
+        }
+        pp->udp()->receive_timestamp = receive_ts;
+
+        pp->set_buffer(core::Slice<uint8_t>(*bp, 0, packet_size));
+
+        packet = pp;
+        proto = proto_attrs->protocol;
+
+        n_read_++;
+
+        return status::StatusOK;
+    }
+
+    if (ferror(file_)) {
+        roc_log(LogError, "packet capture: failed to read input file: %s",
+                core::errno_to_str().c_str());
+        return status::StatusErrFile;
+    }
+
+    // Writer may be interrupted in the middle of record.
+    roc_log(LogInfo, "packet capture: ignoring truncated record at end of \"%s\"",
+            path_);
+
+    return status::StatusFinish;
+}
+
+size_t PacketCaptureReader::num_skipped() const {
+    return n_skipped_;
+}
+
+bool PacketCaptureReader::read_bytes_(void* data, size_t size) {
+    return fread(data, size, 1, file_) == 1;
+}
+
+bool PacketCaptureReader::skip_bytes_(size_t size) {
+    return fseek(file_, (long)size, SEEK_CUR) == 0;
+}
+
+} // namespace dbgio
+} // namespace roc
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_dbgio/packet_capture_reader.h
+//! @brief Packet capture reader.
+
+#ifndef ROC_DBGIO_PACKET_CAPTURE_READER_H_
+#define ROC_DBGIO_PACKET_CAPTURE_READER_H_
+
+#include "roc_address/protocol.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace dbgio {
+
+//! Packet capture reader.
+//! Reads packets from file written by PacketCaptureWriter.
+//! Packets are constructed in the same way as network I/O constructs
+//! received packets, i.e. they have UDP flag, source address and receive
+//! timestamp, and their buffer is not parsed yet.
+class PacketCaptureReader : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    explicit PacketCaptureReader(packet::PacketFactory& packet_factory);
+    ~PacketCaptureReader();
+
+    //! Open capture file and check header.
+    ROC_NODISCARD status::StatusCode open(const char* path);
+
+    //! Close file.
+    void close();
+
+    //! Read next packet.
+    //! @remarks
+    //!  Returns @p packet and protocol of endpoint that received it.
+    //!  Records that can't be represented, e.g. with unknown protocol, or
+    //!  larger than packet buffer, are skipped.
+    //! @returns
+    //!  status::StatusOK if packet was read, status::StatusFinish at the
+    //!  end of file, or error.
+    ROC_NODISCARD status::StatusCode read(packet::PacketPtr& packet,
+                                          address::Protocol& proto);
+
+    //! Number of records skipped so far.
+    size_t num_skipped() const;
+
+private:
+    bool read_bytes_(void* data, size_t size);
+    bool skip_bytes_(size_t size);
+
+    packet::PacketFactory& packet_factory_;
+
+    FILE* file_;
+    const char* path_;
+
+    size_t n_read_;
+    size_t n_skipped_;
+};
+
+} // namespace dbgio
+} // namespace roc
+
+#endif // ROC_DBGIO_PACKET_CAPTURE_READER_H_
@@ -0,0 +1,204 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_dbgio/packet_capture_writer.h"
+#include "roc_core/endian_ops.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_dbgio/packet_capture_format.h"
+
+namespace roc {
+namespace dbgio {
+
+PacketCaptureWriter::PacketCaptureWriter(const PacketCaptureConfig& config,
+                                         core::IArena& arena)
+    : config_(config)
+    , open_flag_(false)
+    , stop_flag_(false)
+    , file_(NULL)
+    , ringbuf_(arena, config.max_queued)
+    , n_written_(0)
+    , n_dropped_(0) {
+    if (!config.capture_file) {
+        roc_panic("packet capture: capture file is null");
+    }
+}
+
+PacketCaptureWriter::~PacketCaptureWriter() {
+    if (open_flag_ && !stop_flag_) {
+        roc_panic("packet capture: close() not called before destructor");
+    }
+}
+
+status::StatusCode PacketCaptureWriter::open() {
+    core::Mutex::Lock lock(open_mutex_);
+
+    if (open_flag_) {
+        roc_panic("packet capture: open() already called");
+    }
+
+    open_flag_ = true;
+
+    if (!ringbuf_.is_valid()) {
+        return status::StatusNoMem;
+    }
+
+    if (!open_(config_.capture_file)) {
+        return status::StatusErrFile;
+    }
+
+    if (!Thread::start()) {
+        return status::StatusErrThread;
+    }
+
+    return status::StatusOK;
+}
+
+void PacketCaptureWriter::close() {
+    core::Mutex::Lock lock(open_mutex_);
+
+    stop_flag_ = true;
+    write_sem_.post();
+
+    Thread::join();
+
+    close_();
+
+    roc_log(LogInfo, "packet capture: captured %lu packets, dropped %lu packets",
+            (unsigned long)n_written_, (unsigned long)n_dropped_);
+}
+
+void PacketCaptureWriter::write(const packet::PacketPtr& packet,
+                                address::Protocol proto) {
+    roc_panic_if(!open_flag_);
+    roc_panic_if(!packet);
+
+    if (stop_flag_) {
+        return;
+    }
+
+    if (!write_mutex_.try_lock()) {
+        n_dropped_++;
+        return;
+    }
+
+    Entry entry;
+    entry.packet = packet;
+    entry.proto = proto;
+
+    if (!ringbuf_.push_back(entry)) {
+        n_dropped_++;
+    }
+
+    write_mutex_.unlock();
+    write_sem_.post();
+}
+
+void PacketCaptureWriter::run() {
+    roc_log(LogDebug, "packet capture: running background thread");
+
+    while (!stop_flag_ || !ringbuf_.is_empty()) {
+        if (ringbuf_.is_empty()) {
+            write_sem_.wait();
+        }
+
+        Entry entry;
+        while (ringbuf_.pop_front(entry)) {
+            if (!dump_(entry)) {
+                break;
+            }
+            n_written_++;
+        }
+    }
+
+    roc_log(LogDebug, "packet capture: exiting background thread");
+}
+
+bool PacketCaptureWriter::open_(const char* path) {
+    roc_panic_if(file_);
+
+    file_ = fopen(path, "wb");
+    if (!file_) {
+        roc_log(LogError, "packet capture: failed to open output file \"%s\": %s", path,
+                core::errno_to_str().c_str());
+        return false;
+    }
+
+    if (!dump_header_()) {
+        close_();
+        return false;
+    }
+
+    return true;
+}
+
+void PacketCaptureWriter::close_() {
+    if (file_) {
+        if (fclose(file_) != 0) {
+            roc_log(LogError, "packet capture: failed to close output file: %s",
+                    core::errno_to_str().c_str());
+        }
+        file_ = NULL;
+    }
+}
+
+bool PacketCaptureWriter::dump_header_() {
+    PacketCaptureFileHeader header;
+    header.magic = core::EndianOps::swap_native_le(PacketCapture_Magic);
+    header.version = core::EndianOps::swap_native_le(PacketCapture_Version);
+    header.reserved = 0;
+
+    if (fwrite(&header, sizeof(header), 1, file_) != 1) {
+        roc_log(LogError, "packet capture: failed to write output file: %s",
+                core::errno_to_str().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+bool PacketCaptureWriter::dump_(const Entry& entry) {
+    roc_panic_if(!file_);
+
+    const packet::Packet& packet = *entry.packet;
+
+    char host[PacketCapture_MaxHostLen + 1] = {};
+    int port = 0;
+    core::nanoseconds_t receive_ts = 0;
+
+    if (packet.has_flags(packet::Packet::FlagUDP)) {
+        if (!packet.udp()->src_addr.get_host(host, sizeof(host))) {
+            host[0] = '\0';
+        }
+        port = packet.udp()->src_addr.port();
+        receive_ts = packet.udp()->receive_timestamp;
+    }
+
+    PacketCaptureRecordHeader header;
+    header.receive_timestamp = core::EndianOps::swap_native_le((int64_t)receive_ts);
+    header.packet_size =
+        core::EndianOps::swap_native_le((uint32_t)packet.buffer().size());
+    header.proto = (uint8_t)entry.proto;
+    header.host_len = (uint8_t)strlen(host);
+    header.port = core::EndianOps::swap_native_le((uint16_t)(port > 0 ? port : 0));
+
+    if (fwrite(&header, sizeof(header), 1, file_) != 1
+        || (header.host_len != 0 && fwrite(host, header.host_len, 1, file_) != 1)
+        || (packet.buffer().size() != 0
+            && fwrite(packet.buffer().data(), packet.buffer().size(), 1, file_) != 1)) {
+        roc_log(LogError, "packet capture: failed to write output file: %s",
+                core::errno_to_str().c_str());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace dbgio
+} // namespace roc
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_dbgio/packet_capture_writer.h
+//! @brief Asynchronous packet capture writer.
+
+#ifndef ROC_DBGIO_PACKET_CAPTURE_WRITER_H_
+#define ROC_DBGIO_PACKET_CAPTURE_WRITER_H_
+
+#include "roc_address/protocol.h"
+#include "roc_core/atomic.h"
+#include "roc_core/mutex.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/spsc_ring_buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_packet/packet.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace dbgio {
+
+//! Packet capture configuration.
+struct PacketCaptureConfig {
+    //! Path to the output capture file.
+    //! If null, capture is disabled.
+    const char* capture_file;
+
+    //! Maximum number of queued packets.
+    //! If queue becomes larger, packets are not captured.
+    size_t max_queued;
+
+    PacketCaptureConfig()
+        : capture_file(NULL)
+        , max_queued(2000) {
+    }
+};
+
+//! Asynchronous packet capture writer.
+//! Writes packets to capture file from background thread.
+//! Recommended to be used from a single thread.
+//! @remarks
+//!  Queued packets hold references to packet buffers until they're written,
+//!  so queue size also limits how many buffers capture can keep from pool.
+//!  See packet_capture_format.h for file format.
+class PacketCaptureWriter : private core::Thread {
+public:
+    //! Initialize.
+    PacketCaptureWriter(const PacketCaptureConfig& config, core::IArena& arena);
+    ~PacketCaptureWriter();
+
+    //! Open file and start background thread.
+    ROC_NODISCARD status::StatusCode open();
+
+    //! Stop background thread and close file.
+    void close();
+
+    //! Enqueue packet for writing.
+    //! @remarks
+    //!  @p packet should be a UDP packet, as received from network,
+    //!  and @p proto should be the protocol of endpoint that received it.
+    //!  Packet contents should not be modified after this call.
+    //!  If queue size limit is exceeded, packet is not captured.
+    //!  Lock-free operation.
+    void write(const packet::PacketPtr& packet, address::Protocol proto);
+
+private:
+    struct Entry {
+        packet::PacketPtr packet;
+        address::Protocol proto;
+
+        Entry()
+            : proto(address::Proto_None) {
+        }
+    };
+
+    virtual void run();
+
+    bool open_(const char* path);
+    void close_();
+    bool dump_header_();
+    bool dump_(const Entry& entry);
+
+    const PacketCaptureConfig config_;
+
+    core::Mutex open_mutex_;
+    core::Atomic<int> open_flag_;
+    core::Atomic<int> stop_flag_;
+    FILE* file_;
+
+    core::Mutex write_mutex_;
+    core::Semaphore write_sem_;
+    core::SpscRingBuffer<Entry> ringbuf_;
+
+    size_t n_written_;
+    core::Atomic<int> n_dropped_;
+};
+
+} // namespace dbgio
+} // namespace roc
+
+#endif // ROC_DBGIO_PACKET_CAPTURE_WRITER_H_
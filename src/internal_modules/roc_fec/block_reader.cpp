@@ -15,6 +15,12 @@
 namespace roc {
 namespace fec {
 
+namespace {
+
+enum { DecodeTimeBins = 1000 };
+
+} // namespace
+
 BlockReader::BlockReader(const BlockReaderConfig& config,
                          packet::FecScheme fec_scheme,
                          IBlockDecoder& block_decoder,
@@ -28,7 +34,7 @@ BlockReader::BlockReader(const BlockReaderConfig& config,
     , repair_reader_(repair_reader)
     , parser_(parser)
     , packet_factory_(packet_factory)
-    , source_queue_(0)
+    , source_queue_(0, packet::DefaultSortedQueueWindow, arena)
     , repair_queue_(0)
     , source_block_(arena)
     , repair_block_(arena)
@@ -43,12 +49,31 @@ BlockReader::BlockReader(const BlockReaderConfig& config,
     , n_packets_(0)
     , prev_block_timestamp_valid_(false)
     , block_max_duration_(0)
+    , incremental_(config.incremental_decoding)
+    , decoder_started_(false)
+    , decoder_stopped_(false)
+    , n_fed_(0)
+    , block_decoded_(false)
+    , block_decode_time_(0)
+    , decode_time_hist_(arena,
+                        0,
+                        config.decode_time_range,
+                        DecodeTimeBins,
+                        config.decode_time_window)
+    , decode_time_agg_(arena, config.decode_time_window)
     , max_sbn_jump_(config.max_sbn_jump)
     , fec_scheme_(fec_scheme)
     , init_status_(status::NoStatus) {
     if ((init_status_ = block_decoder_.init_status()) != status::StatusOK) {
         return;
     }
+    if ((init_status_ = source_queue_.init_status()) != status::StatusOK) {
+        return;
+    }
+    if (!decode_time_hist_.is_valid() || !decode_time_agg_.is_valid()) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
     init_status_ = status::StatusOK;
 }
 
@@ -66,6 +91,24 @@ packet::stream_timestamp_t BlockReader::max_block_duration() const {
     return (packet::stream_timestamp_t)block_max_duration_;
 }
 
+BlockReaderMetrics BlockReader::metrics() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    BlockReaderMetrics metrics = metrics_;
+
+    if (metrics.decoded_blocks == 0) {
+        return metrics;
+    }
+
+    metrics.decode_time_max = decode_time_agg_.mov_max();
+    metrics.decode_time_p50 =
+        std::min(decode_time_hist_.mov_quantile(0.50), metrics.decode_time_max);
+    metrics.decode_time_p99 =
+        std::min(decode_time_hist_.mov_quantile(0.99), metrics.decode_time_max);
+
+    return metrics;
+}
+
 status::StatusCode BlockReader::read(packet::PacketPtr& pp, packet::PacketReadMode mode) {
     roc_panic_if(init_status_ != status::StatusOK);
 
@@ -222,6 +265,11 @@ status::StatusCode BlockReader::next_block_() {
         prev_block_timestamp_valid_ = false;
     }
 
+    if (decoder_started_) {
+        end_decoding_();
+    }
+    update_decode_time_();
+
     for (size_t n = 0; n < source_block_.size(); n++) {
         source_block_[n] = NULL;
     }
@@ -239,10 +287,20 @@ status::StatusCode BlockReader::next_block_() {
 
     can_repair_ = false;
 
+    decoder_stopped_ = false;
+    n_fed_ = 0;
+
     return fill_block_();
 }
 
 status::StatusCode BlockReader::try_repair_() {
+    if (incremental_) {
+        // Decoder already has all packets of the block, and packets that
+        // it could recover so far were already collected; head packet is
+        // still missing, so run full decoding.
+        return finish_decoding_();
+    }
+
     const bool is_block_resized =
         source_block_resized_ && repair_block_resized_ && payload_resized_;
 
@@ -251,7 +309,9 @@ status::StatusCode BlockReader::try_repair_() {
         return status::StatusOK;
     }
 
-    const status::StatusCode code = block_decoder_.begin_block(
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    status::StatusCode code = block_decoder_.begin_block(
         source_block_.size(), repair_block_.size(), payload_size_);
 
     if (code != status::StatusOK) {
@@ -278,30 +338,142 @@ status::StatusCode BlockReader::try_repair_() {
                                   repair_block_[n]->fec()->payload);
     }
 
+    code = repair_source_packets_();
+
+    block_decoder_.end_block();
+    can_repair_ = false;
+
+    block_decoded_ = true;
+    block_decode_time_ += core::timestamp(core::ClockMonotonic) - start_time;
+
+    return code;
+}
+
+status::StatusCode BlockReader::try_repair_incrementally_() {
+    if (decoder_stopped_) {
+        // All lost packets were already recovered.
+        return status::StatusOK;
+    }
+
+    if (!decoder_started_) {
+        const status::StatusCode code = begin_decoding_();
+        if (code != status::StatusOK || !decoder_started_) {
+            return code;
+        }
+    }
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    // Collect packets that decoder already recovered from packets fed so
+    // far (e.g. by iterative decoding); this never runs full decoding.
+    const status::StatusCode code = collect_source_packets_();
+
+    block_decode_time_ += core::timestamp(core::ClockMonotonic) - start_time;
+
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    return maybe_stop_decoding_();
+}
+
+status::StatusCode BlockReader::finish_decoding_() {
+    if (!decoder_started_ || !can_repair_ || n_fed_ < source_block_.size()) {
+        // Nothing to repair, no new packets since last attempt, or too few
+        // packets to repair anything.
+        return status::StatusOK;
+    }
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    // Full decoding is expensive, so it's requested only for the packet
+    // that is needed right now; other packets recovered by it are collected
+    // without requesting decoding again.
+    status::StatusCode code = repair_source_packet_(head_index_);
+    can_repair_ = false;
+
+    if (code == status::StatusOK) {
+        code = collect_source_packets_();
+    }
+
+    block_decode_time_ += core::timestamp(core::ClockMonotonic) - start_time;
+
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    return maybe_stop_decoding_();
+}
+
+status::StatusCode BlockReader::maybe_stop_decoding_() {
+    if (!has_missing_packets_(head_index_)) {
+        // Every packet that is not read yet is present, so the rest of
+        // the block is not needed for decoding.
+        roc_log(LogTrace,
+                "fec block reader: all lost packets recovered, stop decoding:"
+                " sbn=%lu next_esi=%lu n_fed=%lu",
+                (unsigned long)cur_sbn_, (unsigned long)head_index_,
+                (unsigned long)n_fed_);
+
+        end_decoding_();
+        decoder_stopped_ = true;
+        metrics_.early_stopped_blocks++;
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode BlockReader::repair_source_packets_() {
     for (size_t n = 0; n < source_block_.size(); n++) {
         if (source_block_[n]) {
             continue;
         }
 
-        core::Slice<uint8_t> buffer = block_decoder_.repair_buffer(n);
-        if (!buffer) {
-            continue;
+        const status::StatusCode code = repair_source_packet_(n);
+        if (code != status::StatusOK) {
+            return code;
         }
+    }
 
-        packet::PacketPtr packet;
-        const status::StatusCode code = parse_repaired_packet_(buffer, packet);
-        if (code == status::StatusBadPacket) {
+    return status::StatusOK;
+}
+
+status::StatusCode BlockReader::repair_source_packet_(size_t index) {
+    return store_repaired_packet_(index, block_decoder_.repair_buffer(index));
+}
+
+status::StatusCode BlockReader::collect_source_packets_() {
+    for (size_t n = head_index_; n < source_block_.size(); n++) {
+        if (source_block_[n]) {
             continue;
         }
+
+        const status::StatusCode code =
+            store_repaired_packet_(n, block_decoder_.get_buffer(n));
         if (code != status::StatusOK) {
             return code;
         }
+    }
+
+    return status::StatusOK;
+}
 
-        source_block_[n] = packet;
+status::StatusCode BlockReader::store_repaired_packet_(size_t index,
+                                                       const core::Slice<uint8_t>& buffer) {
+    if (!buffer) {
+        return status::StatusOK;
     }
 
-    block_decoder_.end_block();
-    can_repair_ = false;
+    packet::PacketPtr packet;
+    const status::StatusCode code = parse_repaired_packet_(buffer, packet);
+    if (code == status::StatusBadPacket) {
+        return status::StatusOK;
+    }
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    source_block_[index] = packet;
 
     return status::StatusOK;
 }
@@ -380,6 +552,14 @@ status::StatusCode BlockReader::fill_block_() {
         return code;
     }
 
+    if (incremental_) {
+        // Pass new packets to decoder and try to repair losses before
+        // they are actually needed.
+        if ((code = try_repair_incrementally_()) != status::StatusOK) {
+            return code;
+        }
+    }
+
     return status::StatusOK;
 }
 
@@ -448,6 +628,10 @@ status::StatusCode BlockReader::fill_source_block_() {
             can_repair_ = true;
             source_block_[p_num] = pp;
             n_added++;
+
+            if (decoder_started_) {
+                feed_decoder_(p_num, pp);
+            }
         }
     }
 
@@ -526,6 +710,10 @@ status::StatusCode BlockReader::fill_repair_block_() {
             can_repair_ = true;
             repair_block_[p_num] = pp;
             n_added++;
+
+            if (decoder_started_) {
+                feed_decoder_(source_block_.size() + p_num, pp);
+            }
         }
     }
 
@@ -856,6 +1044,95 @@ status::StatusCode BlockReader::update_repair_block_size_(size_t new_blen) {
     return status::StatusOK;
 }
 
+status::StatusCode BlockReader::begin_decoding_() {
+    const bool is_block_resized =
+        source_block_resized_ && repair_block_resized_ && payload_resized_;
+
+    if (!is_block_resized || !has_missing_packets_(head_index_)) {
+        // Block size is not known yet, or there is nothing to repair.
+        return status::StatusOK;
+    }
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    const status::StatusCode code = block_decoder_.begin_block(
+        source_block_.size(), repair_block_.size(), payload_size_);
+
+    if (code != status::StatusOK) {
+        roc_log(LogError,
+                "fec block reader: can't begin decoder block:"
+                " sbl=%lu rbl=%lu payload_size=%lu",
+                (unsigned long)source_block_.size(), (unsigned long)repair_block_.size(),
+                (unsigned long)payload_size_);
+        return code;
+    }
+
+    block_decode_time_ += core::timestamp(core::ClockMonotonic) - start_time;
+
+    roc_log(LogTrace, "fec block reader: start decoding: sbn=%lu next_esi=%lu",
+            (unsigned long)cur_sbn_, (unsigned long)head_index_);
+
+    decoder_started_ = true;
+    block_decoded_ = true;
+
+    // Pass packets received so far, following ones will be passed
+    // when they arrive.
+    for (size_t n = 0; n < source_block_.size(); n++) {
+        if (source_block_[n]) {
+            feed_decoder_(n, source_block_[n]);
+        }
+    }
+
+    for (size_t n = 0; n < repair_block_.size(); n++) {
+        if (repair_block_[n]) {
+            feed_decoder_(source_block_.size() + n, repair_block_[n]);
+        }
+    }
+
+    can_repair_ = true;
+
+    return status::StatusOK;
+}
+
+void BlockReader::end_decoding_() {
+    roc_panic_if(!decoder_started_);
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    block_decoder_.end_block();
+
+    block_decode_time_ += core::timestamp(core::ClockMonotonic) - start_time;
+
+    decoder_started_ = false;
+}
+
+void BlockReader::feed_decoder_(size_t index, const packet::PacketPtr& pp) {
+    roc_panic_if(!decoder_started_);
+
+    if (pp->has_flags(packet::Packet::FlagRestored)) {
+        // Was produced by decoder itself.
+        return;
+    }
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    block_decoder_.set_buffer(index, pp->fec()->payload);
+
+    block_decode_time_ += core::timestamp(core::ClockMonotonic) - start_time;
+
+    n_fed_++;
+}
+
+bool BlockReader::has_missing_packets_(size_t from_index) const {
+    for (size_t n = from_index; n < source_block_.size(); n++) {
+        if (!source_block_[n]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 void BlockReader::drop_repair_packets_from_prev_blocks_() {
     unsigned n_dropped = 0;
 
@@ -909,5 +1186,17 @@ void BlockReader::update_block_duration_(const packet::PacketPtr& curr_block_pkt
     }
 }
 
+void BlockReader::update_decode_time_() {
+    if (block_decoded_) {
+        decode_time_hist_.add(block_decode_time_);
+        decode_time_agg_.add(block_decode_time_);
+
+        metrics_.decoded_blocks++;
+    }
+
+    block_decoded_ = false;
+    block_decode_time_ = 0;
+}
+
 } // namespace fec
 } // namespace roc
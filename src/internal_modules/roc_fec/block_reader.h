@@ -16,12 +16,15 @@
 #include "roc_core/iarena.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
+#include "roc_core/time.h"
 #include "roc_fec/iblock_decoder.h"
 #include "roc_packet/iparser.h"
 #include "roc_packet/ireader.h"
 #include "roc_packet/packet.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/sorted_queue.h"
+#include "roc_stat/mov_aggregate.h"
+#include "roc_stat/mov_histogram.h"
 
 namespace roc {
 namespace fec {
@@ -31,8 +34,64 @@ struct BlockReaderConfig {
     //! Maximum allowed source block number jump.
     size_t max_sbn_jump;
 
+    //! Feed packets to decoder as they arrive.
+    //! @remarks
+    //!  By default, when a loss is detected, the whole block is passed to
+    //!  decoder at once, at the moment when the lost packet is needed.
+    //!  In incremental mode, decoder block is started as soon as a loss is
+    //!  detected, and every subsequent packet is passed to decoder when it
+    //!  arrives. Packets that decoder recovers along the way (e.g. by
+    //!  LDPC-Staircase iterative decoding) are collected without running
+    //!  full decoding. Full decoding is requested only when a lost packet
+    //!  is needed and is not recovered yet. Decoding is stopped early when
+    //!  all lost packets that were not yet read are recovered, and the rest
+    //!  of block packets are not passed to decoder.
+    bool incremental_decoding;
+
+    //! Number of recent blocks used to compute decode time metrics.
+    size_t decode_time_window;
+
+    //! Upper bound of decode time histogram, nanoseconds.
+    //! Longer decode times are counted in the last bin (but still
+    //! reported by max).
+    core::nanoseconds_t decode_time_range;
+
     BlockReaderConfig()
-        : max_sbn_jump(100) {
+        : max_sbn_jump(100)
+        , incremental_decoding(false)
+        , decode_time_window(100)
+        , decode_time_range(core::Millisecond * 10) {
+    }
+};
+
+//! FEC reader metrics.
+struct BlockReaderMetrics {
+    //! Cumulative count of blocks passed to decoder.
+    //! @note
+    //!  Blocks without losses are not passed to decoder.
+    uint64_t decoded_blocks;
+
+    //! Cumulative count of blocks for which decoding was stopped early,
+    //! because all lost packets were recovered.
+    //! @note
+    //!  Counted only in incremental mode.
+    uint64_t early_stopped_blocks;
+
+    //! Median time spent in decoder per block, nanoseconds.
+    core::nanoseconds_t decode_time_p50;
+
+    //! 99th percentile of time spent in decoder per block, nanoseconds.
+    core::nanoseconds_t decode_time_p99;
+
+    //! Maximum time spent in decoder per block, nanoseconds.
+    core::nanoseconds_t decode_time_max;
+
+    BlockReaderMetrics()
+        : decoded_blocks(0)
+        , early_stopped_blocks(0)
+        , decode_time_p50(0)
+        , decode_time_p99(0)
+        , decode_time_max(0) {
     }
 };
 
@@ -69,6 +128,12 @@ public:
     //! Get maximal FEC block duration seen since last block resize.
     packet::stream_timestamp_t max_block_duration() const;
 
+    //! Get metrics.
+    //! @remarks
+    //!  Decode time percentiles are computed over recent blocks that
+    //!  were passed to decoder.
+    BlockReaderMetrics metrics() const;
+
     //! Read packet.
     //! @remarks
     //!  When a packet loss is detected, try to restore it from repair packets.
@@ -82,6 +147,14 @@ private:
     status::StatusCode next_block_();
 
     status::StatusCode try_repair_();
+    status::StatusCode try_repair_incrementally_();
+    status::StatusCode finish_decoding_();
+    status::StatusCode maybe_stop_decoding_();
+    status::StatusCode repair_source_packets_();
+    status::StatusCode repair_source_packet_(size_t index);
+    status::StatusCode collect_source_packets_();
+    status::StatusCode store_repaired_packet_(size_t index,
+                                              const core::Slice<uint8_t>& buffer);
     status::StatusCode parse_repaired_packet_(const core::Slice<uint8_t>& buffer,
                                               packet::PacketPtr& packet);
 
@@ -109,8 +182,14 @@ private:
     status::StatusCode update_source_block_size_(size_t);
     status::StatusCode update_repair_block_size_(size_t);
 
+    status::StatusCode begin_decoding_();
+    void end_decoding_();
+    void feed_decoder_(size_t index, const packet::PacketPtr& pp);
+    bool has_missing_packets_(size_t from_index) const;
+
     void drop_repair_packets_from_prev_blocks_();
     void update_block_duration_(const packet::PacketPtr& curr_block_pkt);
+    void update_decode_time_();
 
     IBlockDecoder& block_decoder_;
 
@@ -143,6 +222,19 @@ private:
     packet::stream_timestamp_t prev_block_timestamp_;
     packet::stream_timestamp_diff_t block_max_duration_;
 
+    // incremental decoding state of current block
+    const bool incremental_;
+    bool decoder_started_;
+    bool decoder_stopped_;
+    size_t n_fed_;
+
+    // decode time of current block and recent blocks
+    bool block_decoded_;
+    core::nanoseconds_t block_decode_time_;
+    stat::MovHistogram<core::nanoseconds_t> decode_time_hist_;
+    stat::MovAggregate<core::nanoseconds_t> decode_time_agg_;
+    BlockReaderMetrics metrics_;
+
     const size_t max_sbn_jump_;
     const packet::FecScheme fec_scheme_;
 
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/block_tuner.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Loss is never expected to be higher than this.
+// Limits repair ratio for very high loss values.
+const float MaxTargetLoss = 0.9f;
+
+// Peak to average loss ratio at which block length reaches maximum.
+// E.g. 4 means that all loss happened in quarter of report intervals.
+const float MaxBurstiness = 4.0f;
+
+} // namespace
+
+void BlockTunerConfig::deduce_defaults(const BlockWriterConfig& writer_config) {
+    if (min_source_packets == 0) {
+        min_source_packets = writer_config.n_source_packets;
+    }
+    if (max_source_packets == 0) {
+        max_source_packets = writer_config.n_source_packets;
+    }
+}
+
+BlockTuner::BlockTuner(const BlockTunerConfig& config,
+                       const BlockWriterConfig& writer_config,
+                       size_t max_block_length)
+    : config_(config)
+    , max_block_length_(max_block_length)
+    , cur_sblen_(writer_config.n_source_packets)
+    , cur_rblen_(writer_config.n_repair_packets)
+    , has_prev_report_(false)
+    , prev_expected_(0)
+    , prev_lost_(0)
+    , loss_hist_pos_(0)
+    , loss_hist_size_(0)
+    , mean_loss_(0)
+    , peak_loss_(0)
+    , last_change_time_(0)
+    , init_status_(status::NoStatus) {
+    if (config_.min_source_packets == 0
+        || config_.min_source_packets > config_.max_source_packets
+        || config_.max_source_packets >= max_block_length_) {
+        roc_log(LogError,
+                "fec block tuner: invalid config: source packets out of bounds:"
+                " min_sbl=%lu max_sbl=%lu max_blen=%lu",
+                (unsigned long)config_.min_source_packets,
+                (unsigned long)config_.max_source_packets,
+                (unsigned long)max_block_length_);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (config_.min_repair_ratio < 0
+        || config_.min_repair_ratio > config_.max_repair_ratio) {
+        roc_log(LogError,
+                "fec block tuner: invalid config: repair ratio out of bounds:"
+                " min_ratio=%.3f max_ratio=%.3f",
+                (double)config_.min_repair_ratio, (double)config_.max_repair_ratio);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (config_.loss_margin <= 0 || config_.loss_window == 0
+        || config_.loss_window > MaxLossWindow) {
+        roc_log(LogError,
+                "fec block tuner: invalid config:"
+                " loss_margin=%.3f loss_window=%lu max_loss_window=%lu",
+                (double)config_.loss_margin, (unsigned long)config_.loss_window,
+                (unsigned long)MaxLossWindow);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+status::StatusCode BlockTuner::init_status() const {
+    return init_status_;
+}
+
+bool BlockTuner::update(uint64_t expected_packets,
+                        int64_t lost_packets,
+                        core::nanoseconds_t current_time) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (has_prev_report_ && expected_packets < prev_expected_) {
+        // Receiver restarted counting, e.g. after stream reset.
+        loss_hist_pos_ = 0;
+        loss_hist_size_ = 0;
+        has_prev_report_ = false;
+    }
+
+    if (!has_prev_report_ || expected_packets == prev_expected_) {
+        has_prev_report_ = true;
+        prev_expected_ = expected_packets;
+        prev_lost_ = lost_packets;
+        return false;
+    }
+
+    float loss =
+        float(lost_packets - prev_lost_) / float(expected_packets - prev_expected_);
+    if (loss < 0) {
+        // Duplicates.
+        loss = 0;
+    }
+    if (loss > 1) {
+        loss = 1;
+    }
+
+    prev_expected_ = expected_packets;
+    prev_lost_ = lost_packets;
+
+    add_loss_(loss);
+
+    size_t new_sblen = 0, new_rblen = 0;
+    compute_sizes_(new_sblen, new_rblen);
+
+    if (new_sblen == cur_sblen_ && new_rblen == cur_rblen_) {
+        return false;
+    }
+
+    // Shorter blocks with the same ratio also reduce robustness.
+    const bool is_decrease = new_sblen < cur_sblen_
+        || float(new_rblen) / float(new_sblen) < float(cur_rblen_) / float(cur_sblen_);
+
+    if (is_decrease) {
+        // Don't decrease redundancy until we have full history, and until
+        // cooldown period after previous change expires.
+        if (loss_hist_size_ < config_.loss_window
+            || (last_change_time_ != 0
+                && current_time - last_change_time_ < config_.decrease_cooldown)) {
+            return false;
+        }
+    }
+
+    roc_log(LogDebug,
+            "fec block tuner: changing block size:"
+            " cur_sbl=%lu cur_rbl=%lu new_sbl=%lu new_rbl=%lu"
+            " mean_loss=%.4f peak_loss=%.4f",
+            (unsigned long)cur_sblen_, (unsigned long)cur_rblen_,
+            (unsigned long)new_sblen, (unsigned long)new_rblen, (double)mean_loss_,
+            (double)peak_loss_);
+
+    cur_sblen_ = new_sblen;
+    cur_rblen_ = new_rblen;
+    last_change_time_ = current_time;
+
+    return true;
+}
+
+size_t BlockTuner::n_source_packets() const {
+    return cur_sblen_;
+}
+
+size_t BlockTuner::n_repair_packets() const {
+    return cur_rblen_;
+}
+
+float BlockTuner::repair_ratio() const {
+    return cur_sblen_ != 0 ? float(cur_rblen_) / float(cur_sblen_) : 0.f;
+}
+
+float BlockTuner::mean_loss() const {
+    return mean_loss_;
+}
+
+float BlockTuner::peak_loss() const {
+    return peak_loss_;
+}
+
+void BlockTuner::add_loss_(float loss) {
+    loss_hist_[loss_hist_pos_] = loss;
+    loss_hist_pos_ = (loss_hist_pos_ + 1) % config_.loss_window;
+    if (loss_hist_size_ < config_.loss_window) {
+        loss_hist_size_++;
+    }
+
+    float sum = 0, peak = 0;
+    for (size_t n = 0; n < loss_hist_size_; n++) {
+        sum += loss_hist_[n];
+        peak = std::max(peak, loss_hist_[n]);
+    }
+
+    mean_loss_ = sum / float(loss_hist_size_);
+    peak_loss_ = peak;
+}
+
+void BlockTuner::compute_sizes_(size_t& sblen, size_t& rblen) const {
+    // Block length grows with burstiness.
+    float burst_pos = 0;
+    if (mean_loss_ > 0) {
+        burst_pos = (peak_loss_ / mean_loss_ - 1.f) / (MaxBurstiness - 1.f);
+        burst_pos = std::min(std::max(burst_pos, 0.f), 1.f);
+    }
+
+    sblen = config_.min_source_packets
+        + (size_t)(float(config_.max_source_packets - config_.min_source_packets)
+                       * burst_pos
+                   + 0.5f);
+
+    // Fraction of repair packets in block should cover expected loss.
+    // If r/(s+r) = loss, then r/s = loss/(1-loss).
+    float target_loss = std::max(mean_loss_ * config_.loss_margin, peak_loss_);
+    target_loss = std::min(target_loss, MaxTargetLoss);
+
+    float ratio = target_loss / (1.f - target_loss);
+    ratio = std::min(std::max(ratio, config_.min_repair_ratio), config_.max_repair_ratio);
+
+    // Small epsilon prevents rounding up because of float rounding errors.
+    rblen = (size_t)std::ceil(float(sblen) * ratio - 1e-4f);
+
+    if (sblen + rblen > max_block_length_) {
+        rblen = max_block_length_ - sblen;
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/block_tuner.h
+//! @brief FEC block size tuner.
+
+#ifndef ROC_FEC_BLOCK_TUNER_H_
+#define ROC_FEC_BLOCK_TUNER_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_fec/block_writer.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace fec {
+
+//! FEC block tuner parameters.
+struct BlockTunerConfig {
+    //! Minimum number of source packets in block.
+    //! If zero, BlockWriterConfig::n_source_packets is used.
+    size_t min_source_packets;
+
+    //! Maximum number of source packets in block.
+    //! If zero, BlockWriterConfig::n_source_packets is used.
+    //! Larger blocks tolerate longer loss bursts, but increase latency.
+    size_t max_source_packets;
+
+    //! Minimum ratio of repair packets to source packets.
+    float min_repair_ratio;
+
+    //! Maximum ratio of repair packets to source packets.
+    float max_repair_ratio;
+
+    //! How much repair packets should exceed expected lost packets.
+    //! Estimated average loss is multiplied by this value.
+    float loss_margin;
+
+    //! Number of loss reports used to estimate loss.
+    size_t loss_window;
+
+    //! Minimum interval between redundancy decrease and previous change.
+    //! Redundancy is increased immediately, but decreased only if loss
+    //! stays low for this period.
+    core::nanoseconds_t decrease_cooldown;
+
+    BlockTunerConfig()
+        : min_source_packets(0)
+        , max_source_packets(0)
+        , min_repair_ratio(0.1f)
+        , max_repair_ratio(1.0f)
+        , loss_margin(1.5f)
+        , loss_window(8)
+        , decrease_cooldown(10 * core::Second) {
+    }
+
+    //! Automatically fill missing settings.
+    void deduce_defaults(const BlockWriterConfig& writer_config);
+};
+
+//! FEC block size tuner.
+//!
+//! Selects number of source and repair packets in FEC block based on packet
+//! loss reported by receiver, within configured bounds.
+//!
+//! Receiver reports cumulative counts of expected and lost packets. Tuner
+//! computes loss ratio for every report interval, and keeps a short history
+//! of such ratios. From the history, it finds average loss and peak loss:
+//!
+//!  - the ratio of repair packets is selected so that a block has enough
+//!    repair packets to cover both average loss (multiplied by loss margin)
+//!    and peak loss
+//!
+//!  - reports don't include loss burst lengths, so tuner uses the ratio of
+//!    peak loss to average loss as a measure of burstiness; the more loss is
+//!    concentrated in short periods, the longer blocks are selected, because
+//!    with the same repair ratio, longer blocks recover longer bursts
+//!
+//! Selected sizes should be passed to BlockWriter::resize(), which applies
+//! them starting from next block. Receiver handles block size changes
+//! automatically.
+class BlockTuner : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p max_block_length is maximum block length supported by encoder.
+    BlockTuner(const BlockTunerConfig& config,
+               const BlockWriterConfig& writer_config,
+               size_t max_block_length);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Process loss report.
+    //! @p expected_packets and @p lost_packets are cumulative counters
+    //! reported by receiver.
+    //! @returns
+    //!  true if block sizes were changed.
+    bool update(uint64_t expected_packets,
+                int64_t lost_packets,
+                core::nanoseconds_t current_time);
+
+    //! Get selected number of source packets in block.
+    size_t n_source_packets() const;
+
+    //! Get selected number of repair packets in block.
+    size_t n_repair_packets() const;
+
+    //! Get selected ratio of repair packets to source packets.
+    float repair_ratio() const;
+
+    //! Get average loss ratio over loss window.
+    float mean_loss() const;
+
+    //! Get maximum loss ratio over loss window.
+    float peak_loss() const;
+
+private:
+    enum { MaxLossWindow = 64 };
+
+    void add_loss_(float loss);
+    void compute_sizes_(size_t& sblen, size_t& rblen) const;
+
+    const BlockTunerConfig config_;
+    const size_t max_block_length_;
+
+    size_t cur_sblen_;
+    size_t cur_rblen_;
+
+    bool has_prev_report_;
+    uint64_t prev_expected_;
+    int64_t prev_lost_;
+
+    float loss_hist_[MaxLossWindow];
+    size_t loss_hist_pos_;
+    size_t loss_hist_size_;
+
+    float mean_loss_;
+    float peak_loss_;
+
+    core::nanoseconds_t last_change_time_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_BLOCK_TUNER_H_
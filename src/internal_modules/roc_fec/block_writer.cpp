@@ -75,6 +75,18 @@ packet::stream_timestamp_t BlockWriter::max_block_duration() const {
     return (packet::stream_timestamp_t)block_max_duration_;
 }
 
+size_t BlockWriter::n_source_packets() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return next_sblen_;
+}
+
+size_t BlockWriter::n_repair_packets() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return next_rblen_;
+}
+
 status::StatusCode BlockWriter::resize(size_t sblen, size_t rblen) {
     roc_panic_if(init_status_ != status::StatusOK);
 
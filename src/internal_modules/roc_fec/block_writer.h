@@ -65,6 +65,16 @@ public:
     //! Get maximal FEC block duration seen since last block resize.
     packet::stream_timestamp_t max_block_duration() const;
 
+    //! Get number of source packets per block.
+    //! @note
+    //!  Returns value set by last resize(), which may be not applied yet.
+    size_t n_source_packets() const;
+
+    //! Get number of repair packets per block.
+    //! @note
+    //!  Returns value set by last resize(), which may be not applied yet.
+    size_t n_repair_packets() const;
+
     //! Set number of source packets per block.
     //! @note
     //!  Actual reallocation may happen later.
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/codec_config.h"
+
+namespace roc {
+namespace fec {
+
+const char* codec_backend_to_str(CodecBackend backend) {
+    switch (backend) {
+    case CodecBackend_Default:
+        return "default";
+
+    case CodecBackend_Builtin:
+        return "builtin";
+
+    case CodecBackend_OpenFEC:
+        return "openfec";
+    }
+
+    return "invalid";
+}
+
+} // namespace fec
+} // namespace roc
@@ -18,11 +18,28 @@
 namespace roc {
 namespace fec {
 
+//! FEC codec backend.
+enum CodecBackend {
+    //! Select first available backend supporting requested scheme.
+    CodecBackend_Default,
+
+    //! Built-in implementation.
+    //! Supports Reed-Solomon scheme.
+    CodecBackend_Builtin,
+
+    //! OpenFEC library.
+    //! Supports Reed-Solomon and LDPC-Staircase schemes.
+    CodecBackend_OpenFEC
+};
+
 //! FEC codec parameters.
 struct CodecConfig {
     //! FEC scheme.
     packet::FecScheme scheme;
 
+    //! FEC backend.
+    CodecBackend backend;
+
     //! Seed for LDPC scheme.
     int32_t ldpc_prng_seed;
 
@@ -34,12 +51,16 @@ struct CodecConfig {
 
     CodecConfig()
         : scheme(packet::FEC_None)
+        , backend(CodecBackend_Default)
         , ldpc_prng_seed(1297501556)
         , ldpc_N1(7)
         , rs_m(8) {
     }
 };
 
+//! Get string name of FEC codec backend.
+const char* codec_backend_to_str(CodecBackend backend);
+
 } // namespace fec
 } // namespace roc
 
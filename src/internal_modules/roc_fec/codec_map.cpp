@@ -11,6 +11,8 @@
 #include "roc_core/log.h"
 #include "roc_core/panic.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_fec/rs8m_encoder.h"
 #include "roc_packet/fec_scheme.h"
 
 #ifdef ROC_TARGET_OPENFEC
@@ -34,11 +36,21 @@ ROC_NOUNUSED I* ctor_func(const CodecConfig& config,
 
 // clang-format off
 CodecMap::CodecMap()
-    : n_codecs_(0) {
+    : n_codecs_(0)
+    , n_schemes_(0) {
+    {
+        Codec codec;
+        codec.scheme = packet::FEC_ReedSolomon_M8;
+        codec.backend = CodecBackend_Builtin;
+        codec.encoder_ctor = ctor_func<IBlockEncoder, Rs8mEncoder>;
+        codec.decoder_ctor = ctor_func<IBlockDecoder, Rs8mDecoder>;
+        add_codec_(codec);
+    }
 #if defined(ROC_TARGET_OPENFEC) && defined(OF_USE_REED_SOLOMON_2_M_CODEC)
     {
         Codec codec;
         codec.scheme = packet::FEC_ReedSolomon_M8;
+        codec.backend = CodecBackend_OpenFEC;
         codec.encoder_ctor = ctor_func<IBlockEncoder, OpenfecEncoder>;
         codec.decoder_ctor = ctor_func<IBlockDecoder, OpenfecDecoder>;
         add_codec_(codec);
@@ -48,6 +60,7 @@ CodecMap::CodecMap()
     {
         Codec codec;
         codec.scheme = packet::FEC_LDPC_Staircase;
+        codec.backend = CodecBackend_OpenFEC;
         codec.encoder_ctor = ctor_func<IBlockEncoder, OpenfecEncoder>;
         codec.decoder_ctor = ctor_func<IBlockDecoder, OpenfecDecoder>;
         add_codec_(codec);
@@ -57,22 +70,26 @@ CodecMap::CodecMap()
 // clang-format on
 
 size_t CodecMap::num_schemes() const {
-    return n_codecs_;
+    return n_schemes_;
 }
 
 packet::FecScheme CodecMap::nth_scheme(size_t n) const {
-    roc_panic_if(n >= n_codecs_);
-    return codecs_[n].scheme;
+    roc_panic_if(n >= n_schemes_);
+    return schemes_[n];
 }
 
 bool CodecMap::has_scheme(packet::FecScheme scheme) const {
-    return find_codec_(scheme);
+    return find_codec_(scheme, CodecBackend_Default);
+}
+
+bool CodecMap::has_backend(packet::FecScheme scheme, CodecBackend backend) const {
+    return find_codec_(scheme, backend);
 }
 
 IBlockEncoder* CodecMap::new_block_encoder(const CodecConfig& config,
                                            packet::PacketFactory& packet_factory,
                                            core::IArena& arena) const {
-    const Codec* codec = find_codec_(config.scheme);
+    const Codec* codec = find_codec_(config.scheme, config.backend);
     if (!codec) {
         return NULL;
     }
@@ -82,7 +99,7 @@ IBlockEncoder* CodecMap::new_block_encoder(const CodecConfig& config,
 IBlockDecoder* CodecMap::new_block_decoder(const CodecConfig& config,
                                            packet::PacketFactory& packet_factory,
                                            core::IArena& arena) const {
-    const Codec* codec = find_codec_(config.scheme);
+    const Codec* codec = find_codec_(config.scheme, config.backend);
     if (!codec) {
         return NULL;
     }
@@ -92,17 +109,29 @@ IBlockDecoder* CodecMap::new_block_decoder(const CodecConfig& config,
 void CodecMap::add_codec_(const Codec& codec) {
     roc_panic_if(n_codecs_ == MaxCodecs);
     codecs_[n_codecs_++] = codec;
+
+    for (size_t n = 0; n < n_schemes_; n++) {
+        if (schemes_[n] == codec.scheme) {
+            return;
+        }
+    }
+    schemes_[n_schemes_++] = codec.scheme;
 }
 
-const CodecMap::Codec* CodecMap::find_codec_(packet::FecScheme scheme) const {
+const CodecMap::Codec* CodecMap::find_codec_(packet::FecScheme scheme,
+                                             CodecBackend backend) const {
     for (size_t n = 0; n < n_codecs_; n++) {
-        if (codecs_[n].scheme == scheme) {
-            return &codecs_[n];
+        if (codecs_[n].scheme != scheme) {
+            continue;
+        }
+        if (backend != CodecBackend_Default && codecs_[n].backend != backend) {
+            continue;
         }
+        return &codecs_[n];
     }
 
-    roc_log(LogError, "codec map: no codec available for fec scheme '%s'",
-            packet::fec_scheme_to_str(scheme));
+    roc_log(LogError, "codec map: no codec available for fec scheme '%s' backend '%s'",
+            packet::fec_scheme_to_str(scheme), codec_backend_to_str(backend));
 
     return NULL;
 }
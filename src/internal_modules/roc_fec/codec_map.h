@@ -40,10 +40,14 @@ public:
     //! Check whether given FEC scheme is supported.
     bool has_scheme(packet::FecScheme scheme) const;
 
+    //! Check whether given FEC scheme is supported by given backend.
+    bool has_backend(packet::FecScheme scheme, CodecBackend backend) const;
+
     //! Create a new block encoder.
     //!
     //! @remarks
-    //!  The codec type is determined by @p config.
+    //!  The codec type is determined by @p config. If backend is default,
+    //!  the first registered backend supporting the scheme is used.
     //!
     //! @returns
     //!  NULL if parameters are invalid or given codec support is not enabled.
@@ -54,7 +58,8 @@ public:
     //! Create a new block decoder.
     //!
     //! @remarks
-    //!  The codec type is determined by @p config.
+    //!  The codec type is determined by @p config. If backend is default,
+    //!  the first registered backend supporting the scheme is used.
     //!
     //! @returns
     //!  NULL if parameters are invalid or given codec support is not enabled.
@@ -65,10 +70,11 @@ public:
 private:
     friend class core::Singleton<CodecMap>;
 
-    enum { MaxCodecs = 2 };
+    enum { MaxCodecs = 4 };
 
     struct Codec {
         packet::FecScheme scheme;
+        CodecBackend backend;
 
         IBlockEncoder* (*encoder_ctor)(const CodecConfig& config,
                                        packet::PacketFactory& packet_factory,
@@ -82,10 +88,13 @@ private:
     CodecMap();
 
     void add_codec_(const Codec& codec);
-    const Codec* find_codec_(packet::FecScheme scheme) const;
+    const Codec* find_codec_(packet::FecScheme scheme, CodecBackend backend) const;
 
     size_t n_codecs_;
     Codec codecs_[MaxCodecs];
+
+    size_t n_schemes_;
+    packet::FecScheme schemes_[MaxCodecs];
 };
 
 } // namespace fec
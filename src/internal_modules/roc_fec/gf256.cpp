@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/gf256.h"
+#include "roc_core/cpu_features.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/panic.h"
+#include "roc_core/singleton.h"
+
+#if defined(ROC_CPU_X86_SIMD)
+#include <immintrin.h>
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Primitive polynomial x^8 + x^4 + x^3 + x^2 + 1, same as used by
+// Reed-Solomon codec from RFC 5510 and OpenFEC.
+const unsigned PrimPoly = 0x11D;
+
+// Number of non-zero field elements.
+const size_t FieldOrder = 255;
+
+class Gf256Tables : public core::NonCopyable<> {
+public:
+    static const Gf256Tables& instance() {
+        return core::Singleton<Gf256Tables>::instance();
+    }
+
+    uint8_t mul(uint8_t a, uint8_t b) const {
+        if (a == 0 || b == 0) {
+            return 0;
+        }
+        return exp[log[a] + log[b]];
+    }
+
+    // exp[n] = alpha^n, doubled to avoid modulo in mul()
+    uint8_t exp[FieldOrder * 2];
+    // log[alpha^n] = n
+    uint8_t log[256];
+    // split[c][0..15] = c * n, split[c][16..31] = c * (n << 4)
+    uint8_t split[256][32];
+
+private:
+    friend class core::Singleton<Gf256Tables>;
+
+    Gf256Tables() {
+        unsigned x = 1;
+        for (size_t n = 0; n < FieldOrder; n++) {
+            exp[n] = (uint8_t)x;
+            exp[n + FieldOrder] = (uint8_t)x;
+            log[x] = (uint8_t)n;
+
+            x <<= 1;
+            if (x & 0x100) {
+                x ^= PrimPoly;
+            }
+        }
+        log[0] = 0;
+
+        for (size_t c = 0; c < 256; c++) {
+            for (size_t n = 0; n < 16; n++) {
+                split[c][n] = mul((uint8_t)c, (uint8_t)n);
+                split[c][n + 16] = mul((uint8_t)c, (uint8_t)(n << 4));
+            }
+        }
+    }
+};
+
+void mul_add_scalar(uint8_t* dst, const uint8_t* src, size_t size, uint8_t coef) {
+    if (coef == 0) {
+        return;
+    }
+
+    const uint8_t* lo = Gf256Tables::instance().split[coef];
+    const uint8_t* hi = lo + 16;
+
+    for (size_t n = 0; n < size; n++) {
+        dst[n] ^= lo[src[n] & 0xf] ^ hi[src[n] >> 4];
+    }
+}
+
+#if defined(ROC_CPU_X86_SIMD)
+
+ROC_CPU_TARGET("ssse3")
+void mul_add_ssse3(uint8_t* dst, const uint8_t* src, size_t size, uint8_t coef) {
+    if (coef == 0) {
+        return;
+    }
+
+    const uint8_t* tab = Gf256Tables::instance().split[coef];
+
+    const __m128i v_lo = _mm_loadu_si128((const __m128i*)tab);
+    const __m128i v_hi = _mm_loadu_si128((const __m128i*)(tab + 16));
+    const __m128i v_mask = _mm_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const __m128i x = _mm_loadu_si128((const __m128i*)(src + n));
+
+        const __m128i p =
+            _mm_xor_si128(_mm_shuffle_epi8(v_lo, _mm_and_si128(x, v_mask)),
+                          _mm_shuffle_epi8(
+                              v_hi, _mm_and_si128(_mm_srli_epi64(x, 4), v_mask)));
+
+        _mm_storeu_si128((__m128i*)(dst + n),
+                         _mm_xor_si128(_mm_loadu_si128((const __m128i*)(dst + n)), p));
+    }
+
+    mul_add_scalar(dst + n, src + n, size - n, coef);
+}
+
+ROC_CPU_TARGET("avx2")
+void mul_add_avx2(uint8_t* dst, const uint8_t* src, size_t size, uint8_t coef) {
+    if (coef == 0) {
+        return;
+    }
+
+    const uint8_t* tab = Gf256Tables::instance().split[coef];
+
+    // vpshufb works within 128-bit lanes, so tables are duplicated in both lanes.
+    const __m256i v_lo =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)tab));
+    const __m256i v_hi =
+        _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(tab + 16)));
+    const __m256i v_mask = _mm256_set1_epi8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 32 <= size; n += 32) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(src + n));
+
+        const __m256i p = _mm256_xor_si256(
+            _mm256_shuffle_epi8(v_lo, _mm256_and_si256(x, v_mask)),
+            _mm256_shuffle_epi8(v_hi,
+                                _mm256_and_si256(_mm256_srli_epi64(x, 4), v_mask)));
+
+        _mm256_storeu_si256(
+            (__m256i*)(dst + n),
+            _mm256_xor_si256(_mm256_loadu_si256((const __m256i*)(dst + n)), p));
+    }
+
+    mul_add_scalar(dst + n, src + n, size - n, coef);
+}
+
+#endif // ROC_CPU_X86_SIMD
+
+#if defined(ROC_CPU_ARM_NEON)
+
+inline uint8x16_t neon_lookup(uint8x16_t tab, uint8x16_t idx) {
+#if defined(__aarch64__)
+    return vqtbl1q_u8(tab, idx);
+#else
+    uint8x8x2_t t;
+    t.val[0] = vget_low_u8(tab);
+    t.val[1] = vget_high_u8(tab);
+    return vcombine_u8(vtbl2_u8(t, vget_low_u8(idx)), vtbl2_u8(t, vget_high_u8(idx)));
+#endif
+}
+
+void mul_add_neon(uint8_t* dst, const uint8_t* src, size_t size, uint8_t coef) {
+    if (coef == 0) {
+        return;
+    }
+
+    const uint8_t* tab = Gf256Tables::instance().split[coef];
+
+    const uint8x16_t v_lo = vld1q_u8(tab);
+    const uint8x16_t v_hi = vld1q_u8(tab + 16);
+    const uint8x16_t v_mask = vdupq_n_u8(0x0f);
+
+    size_t n = 0;
+
+    for (; n + 16 <= size; n += 16) {
+        const uint8x16_t x = vld1q_u8(src + n);
+
+        const uint8x16_t p = veorq_u8(neon_lookup(v_lo, vandq_u8(x, v_mask)),
+                                      neon_lookup(v_hi, vshrq_n_u8(x, 4)));
+
+        vst1q_u8(dst + n, veorq_u8(vld1q_u8(dst + n), p));
+    }
+
+    mul_add_scalar(dst + n, src + n, size - n, coef);
+}
+
+#endif // ROC_CPU_ARM_NEON
+
+} // namespace
+
+bool gf256_kernel_supported(Gf256Kernel kernel) {
+    switch (kernel) {
+    case Gf256Kernel_Auto:
+    case Gf256Kernel_Scalar:
+        return true;
+
+    case Gf256Kernel_SSSE3:
+#if defined(ROC_CPU_X86_SIMD)
+        return core::cpu_supports(core::CpuFeature_SSSE3);
+#else
+        return false;
+#endif
+
+    case Gf256Kernel_AVX2:
+#if defined(ROC_CPU_X86_SIMD)
+        return core::cpu_supports(core::CpuFeature_AVX2);
+#else
+        return false;
+#endif
+
+    case Gf256Kernel_NEON:
+#if defined(ROC_CPU_ARM_NEON)
+        return true;
+#else
+        return false;
+#endif
+
+    case Gf256Kernel_Max:
+        break;
+    }
+
+    return false;
+}
+
+Gf256Kernel gf256_kernel_resolve(Gf256Kernel kernel) {
+    if (kernel != Gf256Kernel_Auto) {
+        return kernel;
+    }
+
+    if (gf256_kernel_supported(Gf256Kernel_AVX2)) {
+        return Gf256Kernel_AVX2;
+    }
+    if (gf256_kernel_supported(Gf256Kernel_SSSE3)) {
+        return Gf256Kernel_SSSE3;
+    }
+    if (gf256_kernel_supported(Gf256Kernel_NEON)) {
+        return Gf256Kernel_NEON;
+    }
+
+    return Gf256Kernel_Scalar;
+}
+
+Gf256KernelFunc gf256_kernel_func(Gf256Kernel kernel) {
+    kernel = gf256_kernel_resolve(kernel);
+
+    roc_panic_if_msg(!gf256_kernel_supported(kernel),
+                     "gf256: kernel not supported by cpu: kernel=%s",
+                     gf256_kernel_to_str(kernel));
+
+    switch (kernel) {
+    case Gf256Kernel_Scalar:
+        return &mul_add_scalar;
+
+#if defined(ROC_CPU_X86_SIMD)
+    case Gf256Kernel_SSSE3:
+        return &mul_add_ssse3;
+
+    case Gf256Kernel_AVX2:
+        return &mul_add_avx2;
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+    case Gf256Kernel_NEON:
+        return &mul_add_neon;
+#endif
+
+    default:
+        break;
+    }
+
+    roc_panic("gf256: unexpected kernel: kernel=%s", gf256_kernel_to_str(kernel));
+}
+
+const char* gf256_kernel_to_str(Gf256Kernel kernel) {
+    switch (kernel) {
+    case Gf256Kernel_Auto:
+        return "auto";
+
+    case Gf256Kernel_Scalar:
+        return "scalar";
+
+    case Gf256Kernel_SSSE3:
+        return "ssse3";
+
+    case Gf256Kernel_AVX2:
+        return "avx2";
+
+    case Gf256Kernel_NEON:
+        return "neon";
+
+    case Gf256Kernel_Max:
+        break;
+    }
+
+    return "invalid";
+}
+
+uint8_t gf256_mul(uint8_t a, uint8_t b) {
+    return Gf256Tables::instance().mul(a, b);
+}
+
+uint8_t gf256_div(uint8_t a, uint8_t b) {
+    roc_panic_if_msg(b == 0, "gf256: division by zero");
+
+    if (a == 0) {
+        return 0;
+    }
+
+    const Gf256Tables& tables = Gf256Tables::instance();
+
+    return tables.exp[tables.log[a] + FieldOrder - tables.log[b]];
+}
+
+uint8_t gf256_exp(size_t n) {
+    return Gf256Tables::instance().exp[n % FieldOrder];
+}
+
+bool gf256_invert_matrix(uint8_t* matrix, uint8_t* inverse, size_t n) {
+    roc_panic_if(!matrix || !inverse);
+
+    for (size_t row = 0; row < n; row++) {
+        for (size_t col = 0; col < n; col++) {
+            inverse[row * n + col] = (row == col);
+        }
+    }
+
+    // Gauss-Jordan elimination.
+    for (size_t col = 0; col < n; col++) {
+        size_t pivot = col;
+        while (pivot < n && matrix[pivot * n + col] == 0) {
+            pivot++;
+        }
+        if (pivot == n) {
+            return false;
+        }
+
+        if (pivot != col) {
+            for (size_t k = 0; k < n; k++) {
+                std::swap(matrix[pivot * n + k], matrix[col * n + k]);
+                std::swap(inverse[pivot * n + k], inverse[col * n + k]);
+            }
+        }
+
+        const uint8_t scale = gf256_div(1, matrix[col * n + col]);
+        if (scale != 1) {
+            for (size_t k = 0; k < n; k++) {
+                matrix[col * n + k] = gf256_mul(matrix[col * n + k], scale);
+                inverse[col * n + k] = gf256_mul(inverse[col * n + k], scale);
+            }
+        }
+
+        for (size_t row = 0; row < n; row++) {
+            const uint8_t factor = matrix[row * n + col];
+            if (row == col || factor == 0) {
+                continue;
+            }
+            for (size_t k = 0; k < n; k++) {
+                matrix[row * n + k] ^= gf256_mul(matrix[col * n + k], factor);
+                inverse[row * n + k] ^= gf256_mul(inverse[col * n + k], factor);
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/gf256.h
+//! @brief GF(2^8) arithmetic.
+
+#ifndef ROC_FEC_GF256_H_
+#define ROC_FEC_GF256_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! GF(2^8) region kernel implementations.
+enum Gf256Kernel {
+    //! Resolved to the fastest kernel supported by current CPU.
+    Gf256Kernel_Auto,
+
+    //! Portable scalar implementation.
+    Gf256Kernel_Scalar,
+
+    //! x86 SSSE3 implementation.
+    Gf256Kernel_SSSE3,
+
+    //! x86 AVX2 implementation.
+    Gf256Kernel_AVX2,
+
+    //! ARM NEON implementation.
+    Gf256Kernel_NEON,
+
+    //! Maximum enum value.
+    Gf256Kernel_Max
+};
+
+//! GF(2^8) region kernel function.
+//! @remarks
+//!  For every n in [0; size), computes:
+//!  @code
+//!   dst[n] = dst[n] + coef * src[n]
+//!  @endcode
+//!  where addition and multiplication are performed in GF(2^8).
+//!  Buffers don't need to be aligned.
+//! @note
+//!  Multiplication is implemented using "split tables": for every
+//!  coefficient, there are two 16-byte tables with products of low
+//!  and high nibbles, so that SIMD byte shuffle instructions can
+//!  multiply 16 or 32 bytes at once.
+typedef void (*Gf256KernelFunc)(uint8_t* dst,
+                                const uint8_t* src,
+                                size_t size,
+                                uint8_t coef);
+
+//! Check if kernel can be used on current CPU.
+bool gf256_kernel_supported(Gf256Kernel kernel);
+
+//! Resolve Gf256Kernel_Auto to the fastest supported kernel.
+//! Other values are returned as is.
+Gf256Kernel gf256_kernel_resolve(Gf256Kernel kernel);
+
+//! Get kernel function.
+//! @pre
+//!  @p kernel should be supported by current CPU.
+Gf256KernelFunc gf256_kernel_func(Gf256Kernel kernel);
+
+//! Get string name of kernel.
+const char* gf256_kernel_to_str(Gf256Kernel kernel);
+
+//! Multiply two field elements.
+uint8_t gf256_mul(uint8_t a, uint8_t b);
+
+//! Divide two field elements.
+//! @pre
+//!  @p b should be non-zero.
+uint8_t gf256_div(uint8_t a, uint8_t b);
+
+//! Get n-th power of primitive element.
+uint8_t gf256_exp(size_t n);
+
+//! Invert n x n matrix.
+//! @remarks
+//!  @p matrix is stored by rows and is destroyed during inversion.
+//!  Result is written to @p inverse, which should have the same size.
+//! @returns
+//!  false if matrix is singular.
+bool gf256_invert_matrix(uint8_t* matrix, uint8_t* inverse, size_t n);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_GF256_H_
@@ -44,11 +44,28 @@ public:
     begin_block(size_t sblen, size_t rblen, size_t payload_size) = 0;
 
     //! Store source or repair packet buffer for current block.
+    //! @remarks
+    //!  May be called after repair_buffer(), when more packets arrive.
+    //!  If the packet was already repaired, repaired buffer is kept.
     //! @pre
     //!  This method may be called only between begin_block() and end_block().
     virtual void set_buffer(size_t index, const core::Slice<uint8_t>& buffer) = 0;
 
+    //! Get source packet buffer if it's already available.
+    //! @remarks
+    //!  Returns buffer if the packet was received, or if it was already
+    //!  repaired, e.g. by iterative decoding performed when buffers were
+    //!  added. Unlike repair_buffer(), never runs full decoding of the block,
+    //!  so it's cheap to call after every set_buffer().
+    //! @pre
+    //!  This method may be called only between begin_block() and end_block().
+    virtual core::Slice<uint8_t> get_buffer(size_t index) = 0;
+
     //! Repair source packet buffer.
+    //! @remarks
+    //!  May run full decoding of the block. Depending on the codec, full
+    //!  decoding may be performed only once per block, and buffers added
+    //!  after it are stored but are not used to repair other packets.
     //! @pre
     //!  This method may be called only between begin_block() and end_block().
     virtual core::Slice<uint8_t> repair_buffer(size_t index) = 0;
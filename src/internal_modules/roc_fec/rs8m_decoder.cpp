@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_decoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_packet/fec_scheme.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mDecoder::Rs8mDecoder(const CodecConfig& config,
+                         packet::PacketFactory& packet_factory,
+                         core::IArena& arena)
+    : IBlockDecoder(arena)
+    , sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , packet_factory_(packet_factory)
+    , buff_tab_(arena)
+    , recv_tab_(arena)
+    , matrix_(arena)
+    , matrix_sblen_(0)
+    , matrix_rblen_(0)
+    , lost_(arena)
+    , used_(arena)
+    , sub_matrix_(arena)
+    , inv_matrix_(arena)
+    , coefs_(arena)
+    , has_new_packets_(false)
+    , kernel_(NULL)
+    , init_status_(status::NoStatus) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8 || config.rs_m != 8) {
+        roc_log(LogError, "rs8m decoder: unsupported fec scheme: scheme=%s m=%u",
+                packet::fec_scheme_to_str(config.scheme), (unsigned)config.rs_m);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    const Gf256Kernel kernel = gf256_kernel_resolve(Gf256Kernel_Auto);
+    kernel_ = gf256_kernel_func(kernel);
+
+    roc_log(LogDebug, "rs8m decoder: initializing: kernel=%s",
+            gf256_kernel_to_str(kernel));
+
+    init_status_ = status::StatusOK;
+}
+
+Rs8mDecoder::~Rs8mDecoder() {
+}
+
+status::StatusCode Rs8mDecoder::init_status() const {
+    return init_status_;
+}
+
+size_t Rs8mDecoder::max_block_length() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return Rs8mMaxBlockLength;
+}
+
+status::StatusCode
+Rs8mDecoder::begin_block(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (sblen == 0 || sblen + rblen > Rs8mMaxBlockLength) {
+        roc_log(LogError,
+                "rs8m decoder: invalid block size: sblen=%lu rblen=%lu max_blen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen,
+                (unsigned long)Rs8mMaxBlockLength);
+        return status::StatusBadConfig;
+    }
+
+    const size_t max_lost = std::min(sblen, rblen);
+
+    if (!buff_tab_.resize(sblen + rblen) || !recv_tab_.resize(sblen + rblen)
+        || !matrix_.resize(sblen * rblen) || !lost_.resize(sblen)
+        || !used_.resize(rblen) || !sub_matrix_.resize(max_lost * max_lost)
+        || !inv_matrix_.resize(max_lost * max_lost) || !coefs_.resize(sblen)) {
+        roc_log(LogError,
+                "rs8m decoder: failed to resize tabs in begin_block, sblen=%lu, rblen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen);
+        return status::StatusNoMem;
+    }
+
+    if (matrix_sblen_ != sblen || matrix_rblen_ != rblen) {
+        if (rblen != 0) {
+            rs8m_repair_matrix(matrix_.data(), sblen, rblen);
+        }
+        matrix_sblen_ = sblen;
+        matrix_rblen_ = rblen;
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    for (size_t i = 0; i < buff_tab_.size(); i++) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    has_new_packets_ = false;
+
+    return status::StatusOK;
+}
+
+void Rs8mDecoder::set_buffer(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m decoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m decoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    if (recv_tab_[index]) {
+        roc_panic("rs8m decoder: can't overwrite buffer: index=%lu",
+                  (unsigned long)index);
+    }
+
+    if (buff_tab_[index]) {
+        // packet was already repaired and arrived later, keep repaired copy
+        return;
+    }
+
+    buff_tab_[index] = buffer;
+    recv_tab_[index] = true;
+
+    has_new_packets_ = true;
+}
+
+core::Slice<uint8_t> Rs8mDecoder::get_buffer(size_t index) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    return buff_tab_[index];
+}
+
+core::Slice<uint8_t> Rs8mDecoder::repair_buffer(size_t index) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buff_tab_[index] && index < sblen_) {
+        decode_();
+    }
+
+    return buff_tab_[index];
+}
+
+void Rs8mDecoder::end_block() {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    report_();
+
+    for (size_t i = 0; i < buff_tab_.size(); i++) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+        recv_tab_[i] = false;
+    }
+
+    has_new_packets_ = false;
+}
+
+void Rs8mDecoder::decode_() {
+    if (!has_new_packets_) {
+        return;
+    }
+    has_new_packets_ = false;
+
+    size_t n_lost = 0;
+    for (size_t i = 0; i < sblen_; i++) {
+        if (!buff_tab_[i]) {
+            lost_[n_lost++] = i;
+        }
+    }
+
+    size_t n_used = 0;
+    for (size_t r = 0; r < rblen_ && n_used < n_lost; r++) {
+        if (buff_tab_[sblen_ + r]) {
+            used_[n_used++] = r;
+        }
+    }
+
+    if (n_lost == 0 || n_used < n_lost) {
+        // Nothing to repair or not enough packets.
+        return;
+    }
+
+    // Lost packets L and used repair packets U are related as:
+    //  A * s_L = y_U - B * s_K
+    // where A and B are parts of repair matrix at rows U and columns L and K,
+    // and K are received source packets. Hence:
+    //  s_L = inv(A) * y_U + inv(A) * B * s_K
+    for (size_t i = 0; i < n_lost; i++) {
+        for (size_t j = 0; j < n_lost; j++) {
+            sub_matrix_[i * n_lost + j] = matrix_[used_[i] * sblen_ + lost_[j]];
+        }
+    }
+
+    if (!gf256_invert_matrix(sub_matrix_.data(), inv_matrix_.data(), n_lost)) {
+        roc_log(LogError, "rs8m decoder: can't invert matrix: n_lost=%lu",
+                (unsigned long)n_lost);
+        return;
+    }
+
+    for (size_t j = 0; j < n_lost; j++) {
+        const uint8_t* inv_row = inv_matrix_.data() + j * n_lost;
+
+        core::Slice<uint8_t> buffer = make_buffer_();
+        if (!buffer) {
+            return;
+        }
+
+        uint8_t* data = buffer.data();
+        memset(data, 0, payload_size_);
+
+        for (size_t c = 0; c < sblen_; c++) {
+            if (!recv_tab_[c]) {
+                continue;
+            }
+            uint8_t coef = 0;
+            for (size_t i = 0; i < n_lost; i++) {
+                coef ^= gf256_mul(inv_row[i], matrix_[used_[i] * sblen_ + c]);
+            }
+            kernel_(data, buff_tab_[c].data(), payload_size_, coef);
+        }
+
+        for (size_t i = 0; i < n_lost; i++) {
+            kernel_(data, buff_tab_[sblen_ + used_[i]].data(), payload_size_,
+                    inv_row[i]);
+        }
+
+        buff_tab_[lost_[j]] = buffer;
+    }
+}
+
+core::Slice<uint8_t> Rs8mDecoder::make_buffer_() {
+    core::Slice<uint8_t> buffer = packet_factory_.new_packet_buffer();
+
+    if (!buffer) {
+        roc_log(LogError, "rs8m decoder: can't allocate buffer");
+        return core::Slice<uint8_t>();
+    }
+
+    if (buffer.capacity() < payload_size_) {
+        roc_log(LogError, "rs8m decoder: packet size too large: size=%lu max=%lu",
+                (unsigned long)payload_size_, (unsigned long)buffer.capacity());
+        return core::Slice<uint8_t>();
+    }
+
+    buffer.reslice(0, payload_size_);
+
+    return buffer;
+}
+
+void Rs8mDecoder::report_() {
+    size_t n_lost = 0, n_repaired = 0;
+
+    for (size_t i = 0; i < sblen_; i++) {
+        if (recv_tab_[i]) {
+            continue;
+        }
+        n_lost++;
+        if (buff_tab_[i]) {
+            n_repaired++;
+        }
+    }
+
+    if (n_lost == 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "rs8m decoder: repaired %u/%u/%u", (unsigned)n_repaired,
+            (unsigned)n_lost, (unsigned)sblen_);
+}
+
+} // namespace fec
+} // namespace roc
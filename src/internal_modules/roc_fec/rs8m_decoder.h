@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_decoder.h
+//! @brief Built-in Reed-Solomon decoder.
+
+#ifndef ROC_FEC_RS8M_DECODER_H_
+#define ROC_FEC_RS8M_DECODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/iblock_decoder.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace fec {
+
+//! Built-in Reed-Solomon decoder over GF(2^8).
+//!
+//! Compatible with OpenFEC Reed-Solomon codec with m=8.
+//!
+//! When there are E lost source packets and at least E repair packets,
+//! inverts E x E sub-matrix of generator matrix and computes every lost
+//! packet as a linear combination of received packets. Decoding is
+//! performed lazily, on first repair_buffer() call for a lost packet
+//! after new packets were added; get_buffer() never triggers it.
+class Rs8mDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    Rs8mDecoder(const CodecConfig& config,
+                packet::PacketFactory& packet_factory,
+                core::IArena& arena);
+
+    virtual ~Rs8mDecoder();
+
+    //! Check if the object was successfully constructed.
+    virtual status::StatusCode init_status() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Start block.
+    virtual ROC_NODISCARD status::StatusCode
+    begin_block(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store source or repair packet buffer for current block.
+    virtual void set_buffer(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Get source packet buffer if it's already available.
+    virtual core::Slice<uint8_t> get_buffer(size_t index);
+
+    //! Repair source packet buffer.
+    virtual core::Slice<uint8_t> repair_buffer(size_t index);
+
+    //! Finish block.
+    virtual void end_block();
+
+private:
+    void decode_();
+    core::Slice<uint8_t> make_buffer_();
+    void report_();
+
+    size_t sblen_;
+    size_t rblen_;
+
+    size_t payload_size_;
+
+    packet::PacketFactory& packet_factory_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+    core::Array<bool> recv_tab_;
+
+    // rblen x sblen repair part of generator matrix
+    core::Array<uint8_t> matrix_;
+    size_t matrix_sblen_;
+    size_t matrix_rblen_;
+
+    // scratch space for decoding
+    core::Array<size_t> lost_;
+    core::Array<size_t> used_;
+    core::Array<uint8_t> sub_matrix_;
+    core::Array<uint8_t> inv_matrix_;
+    core::Array<uint8_t> coefs_;
+
+    bool has_new_packets_;
+
+    Gf256KernelFunc kernel_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_DECODER_H_
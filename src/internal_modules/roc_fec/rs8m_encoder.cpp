@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_encoder.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_packet/fec_scheme.h"
+
+namespace roc {
+namespace fec {
+
+Rs8mEncoder::Rs8mEncoder(const CodecConfig& config,
+                         packet::PacketFactory& packet_factory,
+                         core::IArena& arena)
+    : IBlockEncoder(arena)
+    , sblen_(0)
+    , rblen_(0)
+    , payload_size_(0)
+    , buff_tab_(arena)
+    , matrix_(arena)
+    , kernel_(NULL)
+    , init_status_(status::NoStatus) {
+    if (config.scheme != packet::FEC_ReedSolomon_M8 || config.rs_m != 8) {
+        roc_log(LogError, "rs8m encoder: unsupported fec scheme: scheme=%s m=%u",
+                packet::fec_scheme_to_str(config.scheme), (unsigned)config.rs_m);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    const Gf256Kernel kernel = gf256_kernel_resolve(Gf256Kernel_Auto);
+    kernel_ = gf256_kernel_func(kernel);
+
+    roc_log(LogDebug, "rs8m encoder: initializing: kernel=%s",
+            gf256_kernel_to_str(kernel));
+
+    init_status_ = status::StatusOK;
+}
+
+Rs8mEncoder::~Rs8mEncoder() {
+}
+
+status::StatusCode Rs8mEncoder::init_status() const {
+    return init_status_;
+}
+
+size_t Rs8mEncoder::max_block_length() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return Rs8mMaxBlockLength;
+}
+
+size_t Rs8mEncoder::buffer_alignment() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return Alignment;
+}
+
+status::StatusCode
+Rs8mEncoder::begin_block(size_t sblen, size_t rblen, size_t payload_size) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (sblen == 0 || sblen + rblen > Rs8mMaxBlockLength) {
+        roc_log(LogError,
+                "rs8m encoder: invalid block size: sblen=%lu rblen=%lu max_blen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen,
+                (unsigned long)Rs8mMaxBlockLength);
+        return status::StatusBadConfig;
+    }
+
+    if (sblen_ == sblen && rblen_ == rblen && payload_size_ == payload_size) {
+        return status::StatusOK;
+    }
+
+    if (!buff_tab_.resize(sblen + rblen) || !matrix_.resize(sblen * rblen)) {
+        roc_log(LogError,
+                "rs8m encoder: failed to resize tabs in begin_block, sblen=%lu, rblen=%lu",
+                (unsigned long)sblen, (unsigned long)rblen);
+        return status::StatusNoMem;
+    }
+
+    if (sblen_ != sblen || rblen_ != rblen) {
+        if (rblen != 0) {
+            rs8m_repair_matrix(matrix_.data(), sblen, rblen);
+        }
+    }
+
+    sblen_ = sblen;
+    rblen_ = rblen;
+    payload_size_ = payload_size;
+
+    return status::StatusOK;
+}
+
+void Rs8mEncoder::set_buffer(size_t index, const core::Slice<uint8_t>& buffer) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("rs8m encoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buffer) {
+        roc_panic("rs8m encoder: null buffer");
+    }
+
+    if (buffer.size() == 0 || buffer.size() != payload_size_) {
+        roc_panic("rs8m encoder: invalid payload size: cur=%lu new=%lu",
+                  (unsigned long)payload_size_, (unsigned long)buffer.size());
+    }
+
+    buff_tab_[index] = buffer;
+}
+
+void Rs8mEncoder::fill_buffers() {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    for (size_t r = 0; r < rblen_; r++) {
+        uint8_t* repair = buff_tab_[sblen_ + r].data();
+        roc_panic_if_msg(!repair, "rs8m encoder: missing repair buffer: index=%lu",
+                         (unsigned long)(sblen_ + r));
+
+        const uint8_t* coefs = matrix_.data() + r * sblen_;
+
+        memset(repair, 0, payload_size_);
+
+        for (size_t c = 0; c < sblen_; c++) {
+            const uint8_t* source = buff_tab_[c].data();
+            roc_panic_if_msg(!source, "rs8m encoder: missing source buffer: index=%lu",
+                             (unsigned long)c);
+
+            kernel_(repair, source, payload_size_, coefs[c]);
+        }
+    }
+}
+
+void Rs8mEncoder::end_block() {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    for (size_t i = 0; i < buff_tab_.size(); ++i) {
+        buff_tab_[i] = core::Slice<uint8_t>();
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_encoder.h
+//! @brief Built-in Reed-Solomon encoder.
+
+#ifndef ROC_FEC_RS8M_ENCODER_H_
+#define ROC_FEC_RS8M_ENCODER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/slice.h"
+#include "roc_fec/codec_config.h"
+#include "roc_fec/gf256.h"
+#include "roc_fec/iblock_encoder.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace fec {
+
+//! Built-in Reed-Solomon encoder over GF(2^8).
+//!
+//! Produces the same repair symbols as OpenFEC Reed-Solomon codec with m=8,
+//! so it may be used on one side of the connection while another side uses
+//! OpenFEC. Multiplication of symbols by matrix coefficients is performed
+//! by Gf256KernelFunc, which uses SIMD byte shuffles when available.
+class Rs8mEncoder : public IBlockEncoder, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    Rs8mEncoder(const CodecConfig& config,
+                packet::PacketFactory& packet_factory,
+                core::IArena& arena);
+
+    virtual ~Rs8mEncoder();
+
+    //! Check if the object was successfully constructed.
+    virtual status::StatusCode init_status() const;
+
+    //! Get the maximum number of encoding symbols for the scheme being used.
+    virtual size_t max_block_length() const;
+
+    //! Get buffer alignment requirement.
+    virtual size_t buffer_alignment() const;
+
+    //! Start block.
+    virtual ROC_NODISCARD status::StatusCode
+    begin_block(size_t sblen, size_t rblen, size_t payload_size);
+
+    //! Store packet data for current block.
+    virtual void set_buffer(size_t index, const core::Slice<uint8_t>& buffer);
+
+    //! Fill repair packets.
+    virtual void fill_buffers();
+
+    //! Finish block.
+    virtual void end_block();
+
+private:
+    enum { Alignment = 8 };
+
+    size_t sblen_;
+    size_t rblen_;
+
+    size_t payload_size_;
+
+    core::Array<core::Slice<uint8_t> > buff_tab_;
+    core::Array<uint8_t> matrix_;
+
+    Gf256KernelFunc kernel_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_ENCODER_H_
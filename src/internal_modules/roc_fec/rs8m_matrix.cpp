@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_fec/rs8m_matrix.h"
+#include "roc_core/panic.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+// Evaluation point of encoding symbol with given index.
+uint8_t eval_point(size_t index) {
+    return index == 0 ? 0 : gf256_exp(index - 1);
+}
+
+} // namespace
+
+void rs8m_repair_matrix(uint8_t* matrix, size_t n_source, size_t n_repair) {
+    roc_panic_if(!matrix);
+    roc_panic_if_msg(n_source == 0 || n_repair == 0
+                         || n_source + n_repair > Rs8mMaxBlockLength,
+                     "rs8m matrix: invalid block size: n_source=%lu n_repair=%lu",
+                     (unsigned long)n_source, (unsigned long)n_repair);
+
+    // First row temporarily holds Lagrange denominators:
+    //  denom[c] = prod_{j!=c} (p_c - p_j)
+    // Rows are filled in reverse order, so that first row is overwritten last.
+    uint8_t* denom = matrix;
+
+    for (size_t c = 0; c < n_source; c++) {
+        const uint8_t p_c = eval_point(c);
+        uint8_t d = 1;
+        for (size_t j = 0; j < n_source; j++) {
+            if (j != c) {
+                d = gf256_mul(d, p_c ^ eval_point(j));
+            }
+        }
+        denom[c] = d;
+    }
+
+    for (size_t r = n_repair; r > 0; r--) {
+        const uint8_t x = eval_point(n_source + r - 1);
+
+        // prod_j (x - p_j), never zero since x differs from all p_j
+        uint8_t num = 1;
+        for (size_t j = 0; j < n_source; j++) {
+            num = gf256_mul(num, x ^ eval_point(j));
+        }
+
+        uint8_t* row = matrix + (r - 1) * n_source;
+
+        for (size_t c = 0; c < n_source; c++) {
+            row[c] = gf256_div(gf256_div(num, x ^ eval_point(c)), denom[c]);
+        }
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_fec/rs8m_matrix.h
+//! @brief Reed-Solomon generator matrix.
+
+#ifndef ROC_FEC_RS8M_MATRIX_H_
+#define ROC_FEC_RS8M_MATRIX_H_
+
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace fec {
+
+//! Maximum number of encoding symbols in Reed-Solomon block over GF(2^8).
+const size_t Rs8mMaxBlockLength = 255;
+
+//! Build repair part of systematic Reed-Solomon generator matrix.
+//!
+//! @remarks
+//!  Fills @p matrix with @p n_repair rows and @p n_source columns, stored
+//!  by rows. Repair symbol with index @c n_source+r is computed as sum of
+//!  @c matrix[r*n_source+c] multiplied by source symbol @c c.
+//!
+//! @remarks
+//!  The matrix is the same as built by OpenFEC and by Rizzo's codec it's
+//!  based on: a Vandermonde matrix with evaluation points 0, 1, alpha,
+//!  alpha^2, ..., multiplied by inverse of its top square part. Element
+//!  in row @c R and column @c c equals Lagrange basis polynomial for
+//!  point @c c evaluated at point @c R, which is what is computed here.
+//!
+//! @pre
+//!  @c n_source+n_repair should not exceed Rs8mMaxBlockLength.
+void rs8m_repair_matrix(uint8_t* matrix, size_t n_source, size_t n_repair);
+
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_RS8M_MATRIX_H_
@@ -35,7 +35,8 @@ OpenfecDecoder::OpenfecDecoder(const CodecConfig& config,
     , recv_tab_(arena)
     , status_(arena)
     , has_new_packets_(false)
-    , decoding_finished_(false)
+    , has_new_symbols_(false)
+    , decoding_attempted_(false)
     , init_status_(status::NoStatus) {
     switch (config.scheme) {
 #ifdef OF_USE_REED_SOLOMON_2_M_CODEC
@@ -134,17 +135,35 @@ void OpenfecDecoder::set_buffer(size_t index, const core::Slice<uint8_t>& buffer
                   (unsigned long)payload_size_, (unsigned long)buffer.size());
     }
 
-    if (buff_tab_[index]) {
+    if (recv_tab_[index]) {
         roc_panic("openfec decoder: can't overwrite buffer: index=%lu",
                   (unsigned long)index);
     }
 
+    if (max_index_ < index) {
+        max_index_ = index;
+    }
+
+    if (buff_tab_[index] || data_tab_[index]) {
+        // packet was already repaired, e.g. by iterative decoding,
+        // and arrived later; keep repaired copy
+        roc_log(LogTrace, "openfec decoder: packet already repaired: index=%lu",
+                (unsigned long)index);
+        return;
+    }
+
     has_new_packets_ = true;
 
     buff_tab_[index] = buffer;
     data_tab_[index] = buffer.data();
     recv_tab_[index] = true;
 
+    if (decoding_attempted_) {
+        // session can't accept new symbols after of_finish_decoding(),
+        // so packet is only stored as received
+        return;
+    }
+
     // register new packet and try to repair more packets
     roc_log(LogTrace, "openfec decoder: of_decode_with_new_symbol(): index=%lu",
             (unsigned long)index);
@@ -154,9 +173,23 @@ void OpenfecDecoder::set_buffer(size_t index, const core::Slice<uint8_t>& buffer
         roc_panic("openfec decoder: can't add packet to OF session");
     }
 
-    if (max_index_ < index) {
-        max_index_ = index;
+    has_new_symbols_ = true;
+}
+
+core::Slice<uint8_t> OpenfecDecoder::get_buffer(size_t index) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (index >= sblen_ + rblen_) {
+        roc_panic("openfec decoder: index out of bounds: index=%lu size=%lu",
+                  (unsigned long)index, (unsigned long)(sblen_ + rblen_));
+    }
+
+    if (!buff_tab_[index]) {
+        collect_();
+        fix_buffer_(index);
     }
+
+    return buff_tab_[index];
 }
 
 core::Slice<uint8_t> OpenfecDecoder::repair_buffer(size_t index) {
@@ -181,7 +214,8 @@ void OpenfecDecoder::end_block() {
     reset_tabs_();
 
     has_new_packets_ = false;
-    decoding_finished_ = false;
+    has_new_symbols_ = false;
+    decoding_attempted_ = false;
 }
 
 void OpenfecDecoder::update_session_params_(size_t sblen,
@@ -220,7 +254,11 @@ bool OpenfecDecoder::resize_tabs_(size_t size) {
 void OpenfecDecoder::update_() {
     roc_panic_if(of_sess_ == NULL);
 
-    if (!has_new_packets_) {
+    if (!has_new_packets_ || decoding_attempted_) {
+        // of_finish_decoding() is a full decoding of the block and it's not
+        // allowed to call it twice on the same session; recreating session
+        // and decoding again for every new packet is too expensive, so full
+        // decoding is performed at most once per block
         return;
     }
 
@@ -231,37 +269,38 @@ void OpenfecDecoder::update_() {
     of_get_source_symbols_tab(of_sess_, &data_tab_[0]);
 
     has_new_packets_ = false;
+    has_new_symbols_ = false;
 }
 
-void OpenfecDecoder::decode_() {
-    if (decoding_finished_ && is_optimal_()) {
-        return;
-    }
+void OpenfecDecoder::collect_() {
+    roc_panic_if(of_sess_ == NULL);
 
-    if (!has_n_packets_(sblen_)) {
+    if (!has_new_symbols_ || decoding_attempted_) {
         return;
     }
 
-    if (decoding_finished_) {
-        // it's not allowed to decode twice, so we recreate the session
-        reset_session_();
+    // fetch source symbols that were already repaired by iterative decoding
+    // in of_decode_with_new_symbol(), without running of_finish_decoding()
+    roc_log(LogTrace, "openfec decoder: of_get_source_symbols_tab()");
+
+    of_get_source_symbols_tab(of_sess_, &data_tab_[0]);
 
-        roc_log(LogTrace, "openfec decoder: of_set_available_symbols()");
+    has_new_symbols_ = false;
+}
 
-        if (of_set_available_symbols(of_sess_, &data_tab_[0]) != OF_STATUS_OK) {
-            roc_panic("openfec decoder: can't add packets to OF session");
-        }
+void OpenfecDecoder::decode_() {
+    if (!has_n_packets_(sblen_)) {
+        return;
     }
 
     // try to repair more packets
     roc_log(LogTrace, "openfec decoder: of_finish_decoding()");
 
+    decoding_attempted_ = true;
+
     if (of_finish_decoding(of_sess_) != OF_STATUS_OK) {
         roc_log(LogTrace, "openfec decoder: of_finish_decoding() returned error");
-        return;
     }
-
-    decoding_finished_ = true;
 }
 
 // note: we have to calculate this every time because OpenFEC
@@ -278,16 +317,6 @@ bool OpenfecDecoder::has_n_packets_(size_t n_packets) const {
     return false;
 }
 
-// returns true if the codec requires exactly k packets
-// (number of source packets in block) to repair any
-// source packet
-//
-// non-optimal codecs may require more packets, and the
-// exact amount may be different every block
-bool OpenfecDecoder::is_optimal_() const {
-    return codec_id_ == OF_CODEC_REED_SOLOMON_GF_2_M_STABLE;
-}
-
 void OpenfecDecoder::reset_session_() {
     if (of_sess_ != NULL) {
         of_release_codec_instance(of_sess_);
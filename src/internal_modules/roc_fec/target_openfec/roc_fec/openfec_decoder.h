@@ -51,6 +51,9 @@ public:
     //! Store source or repair packet buffer for current block.
     virtual void set_buffer(size_t index, const core::Slice<uint8_t>& buffer);
 
+    //! Get source packet buffer if it's already available.
+    virtual core::Slice<uint8_t> get_buffer(size_t index);
+
     //! Repair source packet buffer.
     virtual core::Slice<uint8_t> repair_buffer(size_t index);
 
@@ -64,10 +67,10 @@ private:
     bool resize_tabs_(size_t size);
 
     void update_();
+    void collect_();
     void decode_();
 
     bool has_n_packets_(size_t n_packets) const;
-    bool is_optimal_() const;
 
     void reset_session_();
     void destroy_session_();
@@ -114,8 +117,13 @@ private:
     // for debug logging
     core::Array<char> status_;
 
+    // new packets were added since last decoding
     bool has_new_packets_;
-    bool decoding_finished_;
+    // new symbols were passed to of_decode_with_new_symbol() since
+    // last of_get_source_symbols_tab()
+    bool has_new_symbols_;
+    // of_finish_decoding() was called for current block
+    bool decoding_attempted_;
 
     size_t max_block_length_;
 
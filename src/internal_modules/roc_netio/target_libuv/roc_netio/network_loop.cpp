@@ -51,6 +51,18 @@ NetworkLoop::Tasks::StartUdpRecv::StartUdpRecv(PortHandle handle,
     }
     port_ = (BasicPort*)handle;
     inbound_writer_ = &inbound_writer;
+    inbound_batch_writer_ = NULL;
+}
+
+NetworkLoop::Tasks::StartUdpRecv::StartUdpRecv(PortHandle handle,
+                                               packet::IBatchWriter& inbound_writer) {
+    func_ = &NetworkLoop::task_start_udp_recv_;
+    if (!handle) {
+        roc_panic("network loop: port handle is null");
+    }
+    port_ = (BasicPort*)handle;
+    inbound_writer_ = &inbound_writer;
+    inbound_batch_writer_ = &inbound_writer;
 }
 
 NetworkLoop::Tasks::AddTcpServerPort::AddTcpServerPort(TcpServerConfig& config,
@@ -104,8 +116,10 @@ NetworkLoop::Tasks::ResolveEndpointAddress::get_address() const {
 
 NetworkLoop::NetworkLoop(core::IPool& packet_pool,
                          core::IPool& buffer_pool,
-                         core::IArena& arena)
-    : packet_factory_(packet_pool, buffer_pool)
+                         core::IArena& arena,
+                         const core::ThreadConfig& thread_config)
+    : Thread(thread_config)
+    , packet_factory_(packet_pool, buffer_pool)
     , arena_(arena)
     , started_(false)
     , loop_initialized_(false)
@@ -174,6 +188,9 @@ NetworkLoop::~NetworkLoop() {
         }
     }
 
+    roc_log(LogDebug, "network loop: finished: recv_packets=%lu send_packets=%lu",
+            (unsigned long)num_received_packets(), (unsigned long)num_sent_packets());
+
     roc_panic_if(is_joinable());
     roc_panic_if(open_ports_.size());
     roc_panic_if(closing_ports_.size());
@@ -189,6 +206,34 @@ size_t NetworkLoop::num_ports() const {
     return (size_t)num_open_ports_;
 }
 
+size_t NetworkLoop::num_received_packets() const {
+    return udp_counters_.received_packets;
+}
+
+size_t NetworkLoop::num_received_batches() const {
+    return udp_counters_.received_batches;
+}
+
+size_t NetworkLoop::num_sent_packets() const {
+    return udp_counters_.sent_packets;
+}
+
+size_t NetworkLoop::num_kernel_timestamped_packets() const {
+    return udp_counters_.kernel_timestamped_packets;
+}
+
+core::nanoseconds_t NetworkLoop::mean_kernel_timestamp_delay() const {
+    const size_t n_packets = udp_counters_.kernel_timestamped_packets;
+    if (n_packets == 0) {
+        return 0;
+    }
+    return udp_counters_.kernel_timestamp_delay / (core::nanoseconds_t)n_packets;
+}
+
+core::nanoseconds_t NetworkLoop::max_kernel_timestamp_delay() const {
+    return udp_counters_.kernel_timestamp_max_delay;
+}
+
 void NetworkLoop::schedule(NetworkTask& task, INetworkTaskCompleter& completer) {
     roc_panic_if(init_status_ != status::StatusOK);
 
@@ -390,8 +435,8 @@ void NetworkLoop::close_all_sems_() {
 void NetworkLoop::task_add_udp_port_(NetworkTask& base_task) {
     Tasks::AddUdpPort& task = (Tasks::AddUdpPort&)base_task;
 
-    core::SharedPtr<UdpPort> port =
-        new (arena_) UdpPort(*task.config_, loop_, packet_factory_, arena_);
+    core::SharedPtr<UdpPort> port = new (arena_)
+        UdpPort(*task.config_, loop_, packet_factory_, udp_counters_, arena_);
     if (!port) {
         roc_log(LogError, "network loop: can't add udp port %s: allocate failed",
                 address::socket_addr_to_str(task.config_->bind_address).c_str());
@@ -452,7 +497,7 @@ void NetworkLoop::task_start_udp_recv_(NetworkTask& base_task) {
 
     core::SharedPtr<UdpPort> port = (UdpPort*)task.port_.get();
 
-    if (!port->start_recv(*task.inbound_writer_)) {
+    if (!port->start_recv(*task.inbound_writer_, task.inbound_batch_writer_)) {
         roc_log(LogError, "network loop: can't start receiving on port %s",
                 task.port_->descriptor());
         task.success_ = false;
@@ -25,6 +25,7 @@
 #include "roc_core/optional.h"
 #include "roc_core/semaphore.h"
 #include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
 #include "roc_netio/iconn.h"
@@ -37,6 +38,7 @@
 #include "roc_netio/tcp_connection_port.h"
 #include "roc_netio/tcp_server_port.h"
 #include "roc_netio/udp_port.h"
+#include "roc_packet/ibatch_writer.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
@@ -105,10 +107,17 @@ public:
             //!  It is invoked from network thread. It should not block the caller.
             StartUdpRecv(PortHandle handle, packet::IWriter& inbound_writer);
 
+            //! Set task parameters.
+            //! @remarks
+            //!  Same as above, but packets received during one event loop
+            //!  iteration are passed to @p inbound_writer all at once.
+            StartUdpRecv(PortHandle handle, packet::IBatchWriter& inbound_writer);
+
         private:
             friend class NetworkLoop;
 
             packet::IWriter* inbound_writer_;
+            packet::IBatchWriter* inbound_batch_writer_;
         };
 
         //! Add TCP server port.
@@ -189,7 +198,11 @@ public:
     //! Initialize.
     //! @remarks
     //!  Start background thread if the object was successfully constructed.
-    NetworkLoop(core::IPool& packet_pool, core::IPool& buffer_pool, core::IArena& arena);
+    //!  @p thread_config defines scheduling parameters of background thread.
+    NetworkLoop(core::IPool& packet_pool,
+                core::IPool& buffer_pool,
+                core::IArena& arena,
+                const core::ThreadConfig& thread_config = core::ThreadConfig());
 
     //! Destroy. Stop all receivers and senders.
     //! @remarks
@@ -202,6 +215,35 @@ public:
     //! Get number of receiver and sender ports.
     size_t num_ports() const;
 
+    //! Get number of packets received by UDP ports of this loop.
+    //! Includes ports that were already removed.
+    size_t num_received_packets() const;
+
+    //! Get number of receive system calls that returned packets, made by
+    //! UDP ports of this loop.
+    //! Includes ports that were already removed.
+    size_t num_received_batches() const;
+
+    //! Get number of packets sent by UDP ports of this loop.
+    //! Includes ports that were already removed.
+    size_t num_sent_packets() const;
+
+    //! Get number of packets received by UDP ports of this loop, for which
+    //! kernel receive timestamp was used.
+    //! Includes ports that were already removed.
+    size_t num_kernel_timestamped_packets() const;
+
+    //! Get average difference between user-space and kernel receive timestamps
+    //! of packets received by UDP ports of this loop.
+    //! Shows how much event loop scheduling delay is excluded from receive
+    //! timestamps by using kernel timestamps. Zero if there were no such packets.
+    core::nanoseconds_t mean_kernel_timestamp_delay() const;
+
+    //! Get maximum difference between user-space and kernel receive timestamps
+    //! of packets received by UDP ports of this loop.
+    //! Zero if there were no such packets.
+    core::nanoseconds_t max_kernel_timestamp_delay() const;
+
     //! Enqueue a task for asynchronous execution and return.
     //! The task should not be destroyed until the callback is called.
     //! The @p completer will be invoked on event loop thread after the
@@ -270,6 +312,8 @@ private:
 
     core::Atomic<int> num_open_ports_;
 
+    UdpCounters udp_counters_;
+
     status::StatusCode init_status_;
 };
 
@@ -23,11 +23,16 @@ namespace {
 
 const core::nanoseconds_t PacketLogInterval = 20 * core::Second;
 
+// Maximum number of receive system calls per one poll event, to avoid
+// starving other handles under high packet rate. Same limit as in libuv.
+const size_t MaxRecvCalls = 32;
+
 } // namespace
 
 UdpPort::UdpPort(const UdpConfig& config,
                  uv_loop_t& event_loop,
                  packet::PacketFactory& packet_factory,
+                 UdpCounters& counters,
                  core::IArena& arena)
     : BasicPort(arena)
     , config_(config)
@@ -36,13 +41,21 @@ UdpPort::UdpPort(const UdpConfig& config,
     , loop_(event_loop)
     , handle_initialized_(false)
     , write_sem_initialized_(false)
+    , recv_check_initialized_(false)
+    , recv_poll_initialized_(false)
+    , recv_fd_(SocketInvalid)
     , multicast_group_joined_(false)
     , recv_started_(false)
+    , recv_polling_(false)
+    , kernel_timestamps_(false)
     , want_close_(false)
     , closed_(false)
     , fd_()
     , packet_factory_(packet_factory)
+    , counters_(counters)
     , inbound_writer_(NULL)
+    , inbound_batch_writer_(NULL)
+    , recv_batch_len_(0)
     , rate_limiter_(PacketLogInterval, 1) {
     BasicPort::update_descriptor();
 }
@@ -59,13 +72,51 @@ UdpPort::~UdpPort() {
     }
 }
 
+bool UdpPort::batched_recv_supported() {
+    return socket_recv_batch_supported();
+}
+
 const address::SocketAddr& UdpPort::bind_address() const {
     return config_.bind_address;
 }
 
 bool UdpPort::open() {
-    if (int err = uv_udp_init(&loop_, &handle_)) {
-        roc_log(LogError, "udp port: %s: uv_udp_init(): [%s] %s", descriptor(),
+    if (config_.recv_batch_size < 1 || config_.recv_batch_size > UdpConfig::MaxBatchSize
+        || config_.send_batch_size < 1
+        || config_.send_batch_size > UdpConfig::MaxBatchSize) {
+        roc_log(LogError,
+                "udp port: %s: invalid batch size: recv_batch=%lu send_batch=%lu max=%lu",
+                descriptor(), (unsigned long)config_.recv_batch_size,
+                (unsigned long)config_.send_batch_size,
+                (unsigned long)UdpConfig::MaxBatchSize);
+        return false;
+    }
+
+    // By default, libuv creates socket lazily during bind. If we need to set
+    // socket options before bind, we ask libuv to create socket right away.
+    unsigned init_flags = AF_UNSPEC;
+    if (config_.enable_reuseport) {
+        init_flags =
+            config_.bind_address.family() == address::Family_IPv6 ? AF_INET6 : AF_INET;
+    }
+
+    if (config_.recv_batch_size > 1) {
+        if (!batched_recv_supported()) {
+            roc_log(LogError,
+                    "udp port: %s: batched receive is not supported on this platform:"
+                    " recv_batch=%lu",
+                    descriptor(), (unsigned long)config_.recv_batch_size);
+            return false;
+        }
+
+        // libuv before 1.40 can't receive batches, and later versions receive
+        // them into own buffer with 64K per datagram, which would need a copy.
+        // So we read datagrams ourselves, directly into packet buffers.
+        recv_polling_ = true;
+    }
+
+    if (int err = uv_udp_init_ex(&loop_, &handle_, init_flags)) {
+        roc_log(LogError, "udp port: %s: uv_udp_init_ex(): [%s] %s", descriptor(),
                 uv_err_name(err), uv_strerror(err));
         return false;
     }
@@ -73,6 +124,19 @@ bool UdpPort::open() {
     handle_.data = this;
     handle_initialized_ = true;
 
+    if (config_.enable_reuseport) {
+        uv_os_fd_t fd = -1;
+        if (int err = uv_fileno((uv_handle_t*)&handle_, &fd)) {
+            roc_log(LogError, "udp port: %s: uv_fileno(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+        if (!socket_set_reuseport(fd)) {
+            roc_log(LogError, "udp port: %s: can't enable SO_REUSEPORT", descriptor());
+            return false;
+        }
+    }
+
     unsigned flags = 0;
     if ((config_.enable_reuseaddr || config_.bind_address.is_multicast())
         && config_.bind_address.port() > 0) {
@@ -124,7 +188,26 @@ bool UdpPort::open() {
 
     update_descriptor();
 
-    roc_log(LogDebug, "udp port: %s: opened port", descriptor());
+    if (config_.enable_kernel_timestamps) {
+        if (!socket_enable_recv_timestamps(fd_)) {
+            roc_log(LogDebug,
+                    "udp port: %s: kernel timestamps not supported,"
+                    " using user-space timestamps",
+                    descriptor());
+        } else {
+            // libuv doesn't pass ancillary data to recv_cb_(), so we read
+            // datagrams and their timestamps ourselves.
+            kernel_timestamps_ = true;
+            recv_polling_ = true;
+        }
+    }
+
+    roc_log(LogDebug,
+            "udp port: %s: opened port: recv_batch=%lu send_batch=%lu reuseport=%d"
+            " kernel_ts=%d",
+            descriptor(), (unsigned long)config_.recv_batch_size,
+            (unsigned long)config_.send_batch_size, (int)config_.enable_reuseport,
+            (int)kernel_timestamps_);
 
     return true;
 }
@@ -169,7 +252,8 @@ packet::IWriter* UdpPort::start_send() {
     return this;
 }
 
-bool UdpPort::start_recv(packet::IWriter& inbound_writer) {
+bool UdpPort::start_recv(packet::IWriter& inbound_writer,
+                         packet::IBatchWriter* inbound_batch_writer) {
     if (!handle_initialized_) {
         return false;
     }
@@ -180,8 +264,32 @@ bool UdpPort::start_recv(packet::IWriter& inbound_writer) {
         }
     }
 
+    if (inbound_batch_writer && !recv_check_initialized_) {
+        // Check handle is invoked once per loop iteration, right after polling
+        // for I/O, so that all packets received during iteration are handed
+        // over to the writer at once.
+        if (int err = uv_check_init(&loop_, &recv_check_)) {
+            roc_log(LogError, "udp port: %s: uv_check_init(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+
+        recv_check_.data = this;
+        recv_check_initialized_ = true;
+
+        if (int err = uv_check_start(&recv_check_, recv_check_cb_)) {
+            roc_log(LogError, "udp port: %s: uv_check_start(): [%s] %s", descriptor(),
+                    uv_err_name(err), uv_strerror(err));
+            return false;
+        }
+    }
+
     if (!recv_started_) {
-        if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
+        if (recv_polling_) {
+            if (!start_polling_()) {
+                return false;
+            }
+        } else if (int err = uv_udp_recv_start(&handle_, alloc_cb_, recv_cb_)) {
             roc_log(LogError, "udp port: %s: uv_udp_recv_start(): [%s] %s", descriptor(),
                     uv_err_name(err), uv_strerror(err));
             return false;
@@ -189,7 +297,10 @@ bool UdpPort::start_recv(packet::IWriter& inbound_writer) {
         recv_started_ = true;
     }
 
+    flush_recv_batch_();
+
     inbound_writer_ = &inbound_writer;
+    inbound_batch_writer_ = inbound_batch_writer;
     return true;
 }
 
@@ -200,11 +311,22 @@ void UdpPort::close_cb_(uv_handle_t* handle) {
 
     if (handle == (uv_handle_t*)&self.handle_) {
         self.handle_initialized_ = false;
-    } else {
+    } else if (handle == (uv_handle_t*)&self.write_sem_) {
         self.write_sem_initialized_ = false;
+    } else if (handle == (uv_handle_t*)&self.recv_check_) {
+        self.recv_check_initialized_ = false;
+    } else {
+        self.recv_poll_initialized_ = false;
+
+        if (!socket_close(self.recv_fd_)) {
+            roc_log(LogError, "udp port: %s: can't close duplicated socket",
+                    self.descriptor());
+        }
+        self.recv_fd_ = SocketInvalid;
     }
 
-    if (self.handle_initialized_ || self.write_sem_initialized_) {
+    if (self.handle_initialized_ || self.write_sem_initialized_
+        || self.recv_check_initialized_ || self.recv_poll_initialized_) {
         return;
     }
 
@@ -309,78 +431,244 @@ void UdpPort::recv_cb_(uv_udp_t* handle,
         return;
     }
 
-    self.received_packets_++;
+    // libuv reads one datagram per system call
+    self.received_batches_++;
+    self.counters_.received_batches++;
+
+    self.receive_datagram_(bp, (size_t)nread, src_addr, core::timestamp(core::ClockUnix));
+}
+
+void UdpPort::recv_poll_cb_(uv_poll_t* handle, int status, int events) {
+    roc_panic_if_not(handle);
+
+    UdpPort& self = *(UdpPort*)handle->data;
+
+    if (status < 0) {
+        roc_log(LogError, "udp port: %s: poll error: [%s] %s", self.descriptor(),
+                uv_err_name(status), uv_strerror(status));
+        return;
+    }
+
+    if (events & UV_READABLE) {
+        self.poll_datagrams_();
+    }
+}
+
+bool UdpPort::start_polling_() {
+    // libuv doesn't allow to poll descriptor that is already watched by
+    // another handle, and UDP handle watches socket while sending packets
+    // asynchronously. So we poll a duplicate of socket descriptor.
+    if (!socket_duplicate(fd_, recv_fd_)) {
+        roc_log(LogError, "udp port: %s: can't duplicate socket", descriptor());
+        return false;
+    }
+
+    if (int err = uv_poll_init_socket(&loop_, &recv_poll_, recv_fd_)) {
+        roc_log(LogError, "udp port: %s: uv_poll_init_socket(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        if (!socket_close(recv_fd_)) {
+            roc_log(LogError, "udp port: %s: can't close duplicated socket",
+                    descriptor());
+        }
+        recv_fd_ = SocketInvalid;
+        return false;
+    }
+
+    recv_poll_.data = this;
+    recv_poll_initialized_ = true;
+
+    if (int err = uv_poll_start(&recv_poll_, UV_READABLE, recv_poll_cb_)) {
+        roc_log(LogError, "udp port: %s: uv_poll_start(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return false;
+    }
+
+    return true;
+}
+
+void UdpPort::poll_datagrams_() {
+    SocketRecvDatagram datagrams[UdpConfig::MaxBatchSize];
+
+    for (size_t n_call = 0; n_call < MaxRecvCalls; n_call++) {
+        // Datagrams are received directly into packet buffers. Buffers that
+        // were not used by previous call are kept for the next one.
+        size_t n_bufs = 0;
+        for (; n_bufs < config_.recv_batch_size; n_bufs++) {
+            if (!recv_buffers_[n_bufs]) {
+                recv_buffers_[n_bufs] = packet_factory_.new_packet_buffer();
+                if (!recv_buffers_[n_bufs]) {
+                    roc_log(LogError, "udp port: %s: can't allocate buffer",
+                            descriptor());
+                    break;
+                }
+            }
+
+            datagrams[n_bufs].buf = recv_buffers_[n_bufs]->data();
+            datagrams[n_bufs].bufsz = recv_buffers_[n_bufs]->size();
+        }
+
+        if (n_bufs == 0) {
+            return;
+        }
+
+        const ssize_t ret = socket_try_recv_batch(recv_fd_, datagrams, n_bufs);
+        if (ret < 0) {
+            if (ret != SockErr_WouldBlock) {
+                roc_log(LogError, "udp port: %s: network error: num=%d dst=%s",
+                        descriptor(), (int)received_packets_,
+                        address::socket_addr_to_str(config_.bind_address).c_str());
+            }
+            return;
+        }
+
+        const core::nanoseconds_t user_ts = core::timestamp(core::ClockUnix);
+
+        received_batches_++;
+        counters_.received_batches++;
+
+        for (size_t n = 0; n < (size_t)ret; n++) {
+            const SocketRecvDatagram& dgm = datagrams[n];
+
+            if (dgm.truncated) {
+                roc_log(LogDebug,
+                        "udp port: %s:"
+                        " ignoring too large packet: num=%d src=%s dst=%s max=%ld",
+                        descriptor(), (int)received_packets_,
+                        address::socket_addr_to_str(dgm.remote_address).c_str(),
+                        address::socket_addr_to_str(config_.bind_address).c_str(),
+                        (long)dgm.bufsz);
+                continue;
+            }
+
+            if (dgm.nread == 0) {
+                roc_log(LogTrace, "udp port: %s: empty packet: num=%d src=%s dst=%s",
+                        descriptor(), (int)received_packets_,
+                        address::socket_addr_to_str(dgm.remote_address).c_str(),
+                        address::socket_addr_to_str(config_.bind_address).c_str());
+                continue;
+            }
+
+            core::BufferPtr bp = recv_buffers_[n];
+            recv_buffers_[n] = NULL;
+
+            receive_datagram_(bp, dgm.nread, dgm.remote_address,
+                              receive_timestamp_(dgm.timestamp, user_ts));
+        }
+
+        if ((size_t)ret < n_bufs) {
+            // no more data for now
+            return;
+        }
+    }
+}
+
+core::nanoseconds_t UdpPort::receive_timestamp_(core::nanoseconds_t kernel_ts,
+                                                core::nanoseconds_t user_ts) {
+    if (kernel_ts <= 0 || kernel_ts > user_ts) {
+        return user_ts;
+    }
+
+    const core::nanoseconds_t delay = user_ts - kernel_ts;
+
+    // Counters are updated only from network loop thread.
+    counters_.kernel_timestamped_packets++;
+    counters_.kernel_timestamp_delay += delay;
+    if (delay > counters_.kernel_timestamp_max_delay) {
+        counters_.kernel_timestamp_max_delay = delay;
+    }
+
+    return kernel_ts;
+}
+
+void UdpPort::receive_datagram_(const core::BufferPtr& bp,
+                                size_t nread,
+                                const address::SocketAddr& src_addr,
+                                core::nanoseconds_t timestamp) {
+    received_packets_++;
+    counters_.received_packets++;
 
     roc_log(LogTrace, "udp port: %s: received packet: num=%d src=%s dst=%s nread=%ld",
-            self.descriptor(), (int)self.received_packets_,
+            descriptor(), (int)received_packets_,
             address::socket_addr_to_str(src_addr).c_str(),
-            address::socket_addr_to_str(self.config_.bind_address).c_str(), (long)nread);
+            address::socket_addr_to_str(config_.bind_address).c_str(), (long)nread);
 
-    if ((size_t)nread > bp->size()) {
+    if (nread > bp->size()) {
         roc_panic("udp port: %s: unexpected buffer size: got %ld, max %ld",
-                  self.descriptor(), (long)nread, (long)bp->size());
+                  descriptor(), (long)nread, (long)bp->size());
     }
 
-    packet::PacketPtr pp = self.packet_factory_.new_packet();
+    packet::PacketPtr pp = packet_factory_.new_packet();
     if (!pp) {
-        roc_log(LogError, "udp port: %s: can't allocate packet", self.descriptor());
+        roc_log(LogError, "udp port: %s: can't allocate packet", descriptor());
         return;
     }
 
     pp->add_flags(packet::Packet::FlagUDP);
 
     pp->udp()->src_addr = src_addr;
-    pp->udp()->dst_addr = self.config_.bind_address;
-    pp->udp()->receive_timestamp = core::timestamp(core::ClockUnix);
+    pp->udp()->dst_addr = config_.bind_address;
+    pp->udp()->receive_timestamp = timestamp;
 
-    pp->set_buffer(core::Slice<uint8_t>(*bp, 0, (size_t)nread));
+    pp->set_buffer(core::Slice<uint8_t>(*bp, 0, nread));
 
-    if (self.inbound_writer_) {
-        const status::StatusCode code = self.inbound_writer_->write(pp);
-        if (code != status::StatusOK) {
-            roc_panic("udp port: %s: can't writer packet: status=%s", self.descriptor(),
-                      status::code_to_str(code));
-        }
-    }
+    deliver_packet_(pp);
 }
 
-void UdpPort::write_sem_cb_(uv_async_t* handle) {
+void UdpPort::recv_check_cb_(uv_check_t* handle) {
     roc_panic_if_not(handle);
 
     UdpPort& self = *(UdpPort*)handle->data;
 
-    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
-    // try_pop_front_exclusive() may return NULL if the queue is not empty, but
-    // push_back() is currently in progress. In this case we can exit the loop
-    // before processing all packets, but write() always calls uv_async_send()
-    // after push_back(), so we'll wake up soon and process the rest packets.
-    while (packet::PacketPtr pp = self.outbound_queue_.try_pop_front_exclusive()) {
-        packet::UDP& udp = *pp->udp();
+    self.flush_recv_batch_();
+}
 
-        const int packet_num = ++self.sent_packets_;
-        ++self.sent_packets_blk_;
+void UdpPort::deliver_packet_(const packet::PacketPtr& pp) {
+    if (inbound_batch_writer_) {
+        recv_batch_[recv_batch_len_++] = pp;
+        if (recv_batch_len_ == UdpConfig::MaxBatchSize) {
+            flush_recv_batch_();
+        }
+        return;
+    }
 
-        roc_log(LogTrace, "udp port: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
-                self.descriptor(), packet_num,
-                address::socket_addr_to_str(self.config_.bind_address).c_str(),
-                address::socket_addr_to_str(udp.dst_addr).c_str(),
-                (long)pp->buffer().size());
+    if (inbound_writer_) {
+        const status::StatusCode code = inbound_writer_->write(pp);
+        if (code != status::StatusOK) {
+            roc_panic("udp port: %s: can't writer packet: status=%s", descriptor(),
+                      status::code_to_str(code));
+        }
+    }
+}
 
-        uv_buf_t buf;
-        buf.base = (char*)pp->buffer().data();
-        buf.len = pp->buffer().size();
+void UdpPort::flush_recv_batch_() {
+    if (recv_batch_len_ == 0) {
+        return;
+    }
 
-        udp.request.data = &self;
+    roc_panic_if(!inbound_batch_writer_);
 
-        if (int err = uv_udp_send(&udp.request, &self.handle_, &buf, 1,
-                                  udp.dst_addr.saddr(), send_cb_)) {
-            roc_log(LogError, "udp port: %s: uv_udp_send(): [%s] %s", self.descriptor(),
-                    uv_err_name(err), uv_strerror(err));
-            continue;
-        }
+    const status::StatusCode code =
+        inbound_batch_writer_->write_batch(recv_batch_, recv_batch_len_);
+    if (code != status::StatusOK) {
+        roc_panic("udp port: %s: can't write packet batch: status=%s", descriptor(),
+                  status::code_to_str(code));
+    }
 
-        // will be decremented in send_cb_()
-        pp->incref();
+    for (size_t n = 0; n < recv_batch_len_; n++) {
+        recv_batch_[n] = NULL;
+    }
+    recv_batch_len_ = 0;
+}
+
+void UdpPort::write_sem_cb_(uv_async_t* handle) {
+    roc_panic_if_not(handle);
+
+    UdpPort& self = *(UdpPort*)handle->data;
+
+    if (self.config_.send_batch_size > 1) {
+        self.send_queued_batched_();
+    } else {
+        self.send_queued_();
     }
 }
 
@@ -409,11 +697,7 @@ void UdpPort::send_cb_(uv_udp_send_t* req, int status) {
                 (long)pp->buffer().size(), uv_err_name(status), uv_strerror(status));
     }
 
-    const int pending_packets = --self.pending_packets_;
-
-    if (pending_packets == 0 && self.want_close_) {
-        self.start_closing_();
-    }
+    self.release_pending_(1);
 }
 
 status::StatusCode UdpPort::write(const packet::PacketPtr& pp) {
@@ -463,11 +747,13 @@ bool UdpPort::try_nonblocking_write_(const packet::PacketPtr& pp) {
     }
 
     const packet::UDP& udp = *pp->udp();
-    const bool success =
-        socket_try_send_to(fd_, pp->buffer().data(), pp->buffer().size(), udp.dst_addr);
+    const bool success = socket_try_send_to(fd_, pp->buffer().data(), pp->buffer().size(),
+                                            udp.dst_addr)
+        >= 0;
 
     if (success) {
         const int packet_num = ++sent_packets_;
+        ++counters_.sent_packets;
         roc_log(LogTrace,
                 "udp port: %s: sent packet non-blocking: num=%d src=%s dst=%s sz=%ld",
                 descriptor(), packet_num,
@@ -479,8 +765,132 @@ bool UdpPort::try_nonblocking_write_(const packet::PacketPtr& pp) {
     return success;
 }
 
+void UdpPort::send_queued_() {
+    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
+    // try_pop_front_exclusive() may return NULL if the queue is not empty, but
+    // push_back() is currently in progress. In this case we can exit the loop
+    // before processing all packets, but write() always calls uv_async_send()
+    // after push_back(), so we'll wake up soon and process the rest packets.
+    while (packet::PacketPtr pp = outbound_queue_.try_pop_front_exclusive()) {
+        send_async_(pp);
+    }
+}
+
+void UdpPort::send_queued_batched_() {
+    packet::PacketPtr batch[UdpConfig::MaxBatchSize];
+    SocketDatagram datagrams[UdpConfig::MaxBatchSize];
+
+    // Set when socket buffer becomes full. Remaining packets are passed to
+    // libuv, which will send them when socket becomes writable.
+    // If libuv already has queued packets, we also pass new packets to libuv,
+    // to preserve order.
+    bool would_block = uv_udp_get_send_queue_count(&handle_) != 0;
+
+    for (;;) {
+        // Same as in send_queued_(), if push_back() is in progress, we may exit
+        // early, and will be woken up again by uv_async_send().
+        size_t batch_size = 0;
+        while (batch_size < config_.send_batch_size) {
+            packet::PacketPtr pp = outbound_queue_.try_pop_front_exclusive();
+            if (!pp) {
+                break;
+            }
+
+            datagrams[batch_size].buf = pp->buffer().data();
+            datagrams[batch_size].bufsz = pp->buffer().size();
+            datagrams[batch_size].remote_address = &pp->udp()->dst_addr;
+
+            batch[batch_size++] = pp;
+        }
+
+        if (batch_size == 0) {
+            break;
+        }
+
+        size_t n_sent = 0;
+
+        if (!would_block) {
+            const ssize_t ret = socket_try_send_batch(fd_, datagrams, batch_size);
+            if (ret > 0) {
+                n_sent = (size_t)ret;
+            } else if (ret == SockErr_WouldBlock) {
+                would_block = true;
+            }
+        }
+
+        if (n_sent != 0) {
+            ++sent_batches_;
+        }
+
+        for (size_t n = 0; n < n_sent; n++) {
+            const int packet_num = ++sent_packets_;
+            ++counters_.sent_packets;
+            ++sent_packets_batched_;
+
+            roc_log(LogTrace,
+                    "udp port: %s: sent packet batched: num=%d src=%s dst=%s sz=%ld",
+                    descriptor(), packet_num,
+                    address::socket_addr_to_str(config_.bind_address).c_str(),
+                    address::socket_addr_to_str(batch[n]->udp()->dst_addr).c_str(),
+                    (long)batch[n]->buffer().size());
+
+            batch[n] = NULL;
+        }
+
+        // Packets that were not sent synchronously are sent asynchronously
+        // by libuv, which will also report errors, if any.
+        for (size_t n = n_sent; n < batch_size; n++) {
+            send_async_(batch[n]);
+            batch[n] = NULL;
+        }
+
+        // May start closing, so should be the last action.
+        if (n_sent != 0) {
+            release_pending_((int)n_sent);
+        }
+    }
+}
+
+void UdpPort::send_async_(const packet::PacketPtr& pp) {
+    packet::UDP& udp = *pp->udp();
+
+    const int packet_num = ++sent_packets_;
+    ++counters_.sent_packets;
+    ++sent_packets_blk_;
+
+    roc_log(LogTrace, "udp port: %s: sending packet: num=%d src=%s dst=%s sz=%ld",
+            descriptor(), packet_num,
+            address::socket_addr_to_str(config_.bind_address).c_str(),
+            address::socket_addr_to_str(udp.dst_addr).c_str(), (long)pp->buffer().size());
+
+    uv_buf_t buf;
+    buf.base = (char*)pp->buffer().data();
+    buf.len = pp->buffer().size();
+
+    udp.request.data = this;
+
+    if (int err = uv_udp_send(&udp.request, &handle_, &buf, 1, udp.dst_addr.saddr(),
+                              send_cb_)) {
+        roc_log(LogError, "udp port: %s: uv_udp_send(): [%s] %s", descriptor(),
+                uv_err_name(err), uv_strerror(err));
+        return;
+    }
+
+    // will be decremented in send_cb_()
+    pp->incref();
+}
+
+void UdpPort::release_pending_(int n_packets) {
+    const int pending_packets = (pending_packets_ -= n_packets);
+
+    if (pending_packets == 0 && want_close_) {
+        start_closing_();
+    }
+}
+
 bool UdpPort::fully_closed_() const {
-    if (!handle_initialized_ && !write_sem_initialized_) {
+    if (!handle_initialized_ && !write_sem_initialized_ && !recv_check_initialized_
+        && !recv_poll_initialized_) {
         return true;
     }
 
@@ -499,13 +909,25 @@ void UdpPort::start_closing_() {
     roc_log(LogDebug, "udp port: %s: initiating asynchronous close", descriptor());
 
     if (recv_started_) {
-        if (int err = uv_udp_recv_stop(&handle_)) {
+        if (recv_polling_) {
+            if (int err = uv_poll_stop(&recv_poll_)) {
+                roc_log(LogError, "udp port: %s: uv_poll_stop(): [%s] %s", descriptor(),
+                        uv_err_name(err), uv_strerror(err));
+            }
+        } else if (int err = uv_udp_recv_stop(&handle_)) {
             roc_log(LogError, "udp port: %s: uv_udp_recv_stop(): [%s] %s", descriptor(),
                     uv_err_name(err), uv_strerror(err));
         }
         recv_started_ = false;
     }
 
+    for (size_t n = 0; n < UdpConfig::MaxBatchSize; n++) {
+        recv_buffers_[n] = NULL;
+    }
+
+    // Hand over packets received during current loop iteration.
+    flush_recv_batch_();
+
     if (multicast_group_joined_) {
         leave_multicast_group_();
     }
@@ -517,6 +939,14 @@ void UdpPort::start_closing_() {
     if (write_sem_initialized_ && !uv_is_closing((uv_handle_t*)&write_sem_)) {
         uv_close((uv_handle_t*)&write_sem_, close_cb_);
     }
+
+    if (recv_check_initialized_ && !uv_is_closing((uv_handle_t*)&recv_check_)) {
+        uv_close((uv_handle_t*)&recv_check_, close_cb_);
+    }
+
+    if (recv_poll_initialized_ && !uv_is_closing((uv_handle_t*)&recv_poll_)) {
+        uv_close((uv_handle_t*)&recv_poll_, close_cb_);
+    }
 }
 
 bool UdpPort::join_multicast_group_() {
@@ -569,11 +999,17 @@ void UdpPort::report_stats_() {
     }
 
     const int recv_packets = received_packets_;
+    const int recv_batches = received_batches_;
     const int sent_packets = sent_packets_;
-    const int sent_packets_nb = (sent_packets - sent_packets_blk_);
-
-    roc_log(LogDebug, "udp port: %s: recv=%d send=%d send_nb=%d", descriptor(),
-            recv_packets, sent_packets, sent_packets_nb);
+    const int sent_packets_batched = sent_packets_batched_;
+    const int sent_packets_nb = (sent_packets - sent_packets_blk_ - sent_packets_batched);
+    const int sent_batches = sent_batches_;
+
+    roc_log(LogDebug,
+            "udp port: %s: recv=%d recv_batches=%d send=%d send_nb=%d"
+            " send_batched=%d send_batches=%d",
+            descriptor(), recv_packets, recv_batches, sent_packets, sent_packets_nb,
+            sent_packets_batched, sent_batches);
 }
 
 void UdpPort::format_descriptor(core::StringBuilder& b) {
@@ -15,13 +15,18 @@
 #include <uv.h>
 
 #include "roc_address/socket_addr.h"
+#include "roc_core/atomic.h"
+#include "roc_core/buffer.h"
 #include "roc_core/iarena.h"
 #include "roc_core/list.h"
 #include "roc_core/list_node.h"
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/rate_limiter.h"
+#include "roc_core/time.h"
 #include "roc_netio/basic_port.h"
 #include "roc_netio/iclose_handler.h"
+#include "roc_netio/socket_ops.h"
+#include "roc_packet/ibatch_writer.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/packet_factory.h"
 
@@ -45,15 +50,55 @@ struct UdpConfig {
     //! binding to non-ephemeral port.
     bool enable_reuseaddr;
 
+    //! If set, enable SO_REUSEPORT before binding socket.
+    //! Allows several ports, possibly in different network loops, to bind
+    //! to the same address; kernel then distributes incoming datagrams
+    //! between them. All such ports should have this flag set.
+    bool enable_reuseport;
+
     //! If true, allow non-blocking writes directly in write() method.
     //! If non-blocking write can't be performed, port falls back to
     //! regular asynchronous write.
     //! Used only if sending is started.
     bool enable_non_blocking;
 
+    //! Maximum number of datagrams received by one system call.
+    //! If greater than 1, port reads datagrams itself using recvmmsg(),
+    //! directly into packet buffers, one buffer per datagram.
+    //! Port fails to open if this is not supported by platform,
+    //! see UdpPort::batched_recv_supported().
+    //! Used only if receiving is started.
+    size_t recv_batch_size;
+
+    //! Maximum number of queued datagrams sent by one system call.
+    //! If greater than 1, packets accumulated in outbound queue are flushed
+    //! from network thread using sendmmsg() when it's supported by platform.
+    //! Used only if sending is started.
+    size_t send_batch_size;
+
+    //! If set, use kernel receive timestamps for received packets.
+    //! Kernel timestamps are taken when datagram arrives to socket, so unlike
+    //! user-space timestamps, they don't include event loop scheduling delay.
+    //! Timestamps are delivered with datagrams (SO_TIMESTAMPNS), so port reads
+    //! datagrams itself instead of using libuv receive, up to recv_batch_size
+    //! datagrams per system call.
+    //! Falls back to user-space timestamps if not supported by platform.
+    //! Used only if receiving is started.
+    bool enable_kernel_timestamps;
+
+    //! Limits.
+    enum {
+        //! Maximum allowed value for recv_batch_size and send_batch_size.
+        MaxBatchSize = 32
+    };
+
     UdpConfig()
         : enable_reuseaddr(false)
-        , enable_non_blocking(true) {
+        , enable_reuseport(false)
+        , enable_non_blocking(true)
+        , recv_batch_size(1)
+        , send_batch_size(1)
+        , enable_kernel_timestamps(false) {
         multicast_interface[0] = '\0';
     }
 
@@ -62,10 +107,38 @@ struct UdpConfig {
         return bind_address == other.bind_address
             && strcmp(multicast_interface, other.multicast_interface) == 0
             && enable_reuseaddr == other.enable_reuseaddr
-            && enable_non_blocking == other.enable_non_blocking;
+            && enable_reuseport == other.enable_reuseport
+            && enable_non_blocking == other.enable_non_blocking
+            && recv_batch_size == other.recv_batch_size
+            && send_batch_size == other.send_batch_size
+            && enable_kernel_timestamps == other.enable_kernel_timestamps;
     }
 };
 
+//! UDP packet counters.
+//! Shared by all UDP ports of a network loop.
+struct UdpCounters {
+    //! Number of packets received by ports.
+    core::Atomic<size_t> received_packets;
+
+    //! Number of receive system calls that returned packets.
+    core::Atomic<size_t> received_batches;
+
+    //! Number of packets sent by ports.
+    core::Atomic<size_t> sent_packets;
+
+    //! Number of received packets with kernel timestamps.
+    core::Atomic<size_t> kernel_timestamped_packets;
+
+    //! Sum of differences between user-space and kernel timestamps
+    //! of received packets, in nanoseconds.
+    core::Atomic<int64_t> kernel_timestamp_delay;
+
+    //! Maximum difference between user-space and kernel timestamps
+    //! of received packets, in nanoseconds.
+    core::Atomic<int64_t> kernel_timestamp_max_delay;
+};
+
 //! UDP sender/receiver port.
 class UdpPort : public BasicPort, private packet::IWriter {
 public:
@@ -73,11 +146,15 @@ public:
     UdpPort(const UdpConfig& config,
             uv_loop_t& event_loop,
             packet::PacketFactory& packet_factory,
+            UdpCounters& counters,
             core::IArena& arena);
 
     //! Destroy.
     virtual ~UdpPort();
 
+    //! Check if batched receive (recv_batch_size > 1) is supported by platform.
+    static bool batched_recv_supported();
+
     //! Get bind address.
     const address::SocketAddr& bind_address() const;
 
@@ -97,7 +174,10 @@ public:
     //! @remarks
     //!  Received packets will be written to inbound_writer.
     //!  Writer will be invoked from network thread.
-    bool start_recv(packet::IWriter& inbound_writer);
+    //!  If inbound_batch_writer is non-NULL, packets received during one
+    //!  event loop iteration are accumulated and written to it at once.
+    bool start_recv(packet::IWriter& inbound_writer,
+                    packet::IBatchWriter* inbound_batch_writer);
 
 protected:
     //! Format descriptor.
@@ -112,6 +192,8 @@ private:
                          const uv_buf_t* buf,
                          const sockaddr* addr,
                          unsigned flags);
+    static void recv_check_cb_(uv_check_t* handle);
+    static void recv_poll_cb_(uv_poll_t* handle, int status, int events);
 
     static void write_sem_cb_(uv_async_t* handle);
     static void send_cb_(uv_udp_send_t* req, int status);
@@ -121,6 +203,22 @@ private:
     void write_(const packet::PacketPtr& packet);
     bool try_nonblocking_write_(const packet::PacketPtr& pp);
 
+    bool start_polling_();
+    void poll_datagrams_();
+    core::nanoseconds_t receive_timestamp_(core::nanoseconds_t kernel_ts,
+                                           core::nanoseconds_t user_ts);
+    void receive_datagram_(const core::BufferPtr& bp,
+                           size_t nread,
+                           const address::SocketAddr& src_addr,
+                           core::nanoseconds_t timestamp);
+    void deliver_packet_(const packet::PacketPtr& pp);
+    void flush_recv_batch_();
+
+    void send_queued_();
+    void send_queued_batched_();
+    void send_async_(const packet::PacketPtr& pp);
+    void release_pending_(int n_packets);
+
     bool fully_closed_() const;
     void start_closing_();
 
@@ -142,16 +240,33 @@ private:
     uv_async_t write_sem_;
     bool write_sem_initialized_;
 
+    // used in batched handoff mode
+    uv_check_t recv_check_;
+    bool recv_check_initialized_;
+
+    // used when port reads datagrams itself instead of libuv
+    uv_poll_t recv_poll_;
+    bool recv_poll_initialized_;
+    SocketHandle recv_fd_;
+    core::BufferPtr recv_buffers_[UdpConfig::MaxBatchSize];
+
     bool multicast_group_joined_;
     bool recv_started_;
+    bool recv_polling_;
+    bool kernel_timestamps_;
     bool want_close_;
     bool closed_;
 
     uv_os_fd_t fd_;
 
     packet::PacketFactory& packet_factory_;
+    UdpCounters& counters_;
 
     packet::IWriter* inbound_writer_;
+    packet::IBatchWriter* inbound_batch_writer_;
+    packet::PacketPtr recv_batch_[UdpConfig::MaxBatchSize];
+    size_t recv_batch_len_;
+
     core::MpscQueue<packet::Packet> outbound_queue_;
 
     core::RateLimiter rate_limiter_;
@@ -159,7 +274,10 @@ private:
     core::Atomic<int> pending_packets_;
     core::Atomic<int> sent_packets_;
     core::Atomic<int> sent_packets_blk_;
+    core::Atomic<int> sent_packets_batched_;
+    core::Atomic<int> sent_batches_;
     core::Atomic<int> received_packets_;
+    core::Atomic<int> received_batches_;
 };
 
 } // namespace netio
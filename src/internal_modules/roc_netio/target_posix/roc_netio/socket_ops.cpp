@@ -6,13 +6,20 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE // for sendmmsg() and recvmmsg()
+#endif
+
 #include <errno.h>
 #include <fcntl.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <signal.h>
+#include <string.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <time.h>
 #include <unistd.h>
 
@@ -130,6 +137,77 @@ bool set_int_option(
     return true;
 }
 
+// Buffer for ancillary data of one received datagram.
+union RecvControl {
+    cmsghdr align;
+#if defined(SO_TIMESTAMPNS)
+    char buf[CMSG_SPACE(sizeof(timespec))];
+#else
+    char buf[CMSG_SPACE(sizeof(timeval))];
+#endif
+};
+
+void prepare_recv_msg(msghdr& msg,
+                      iovec& iov,
+                      sockaddr_storage& addr,
+                      RecvControl& control,
+                      const SocketRecvDatagram& datagram) {
+    roc_panic_if(!datagram.buf);
+
+    iov.iov_base = datagram.buf;
+    iov.iov_len = datagram.bufsz;
+
+    memset(&msg, 0, sizeof(msg));
+
+    msg.msg_name = &addr;
+    msg.msg_namelen = sizeof(addr);
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control.buf;
+    msg.msg_controllen = sizeof(control.buf);
+}
+
+void parse_recv_msg(msghdr& msg,
+                    const sockaddr_storage& addr,
+                    size_t nread,
+                    SocketRecvDatagram& datagram) {
+    datagram.nread = nread;
+    datagram.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+    datagram.timestamp = 0;
+
+    datagram.remote_address.clear();
+    if (msg.msg_namelen != 0) {
+        if (!datagram.remote_address.set_host_port_saddr((const sockaddr*)&addr)) {
+            roc_log(LogError, "socket: can't determine source address of datagram");
+        }
+    }
+
+    if (msg.msg_controllen == 0) {
+        return;
+    }
+
+    for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+        if (cmsg->cmsg_level != SOL_SOCKET) {
+            continue;
+        }
+#if defined(SO_TIMESTAMPNS)
+        if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            datagram.timestamp =
+                core::nanoseconds_t(ts.tv_sec) * core::Second + ts.tv_nsec;
+        }
+#elif defined(SO_TIMESTAMP)
+        if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+            timeval tv;
+            memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+            datagram.timestamp = core::nanoseconds_t(tv.tv_sec) * core::Second
+                + core::nanoseconds_t(tv.tv_usec) * core::Microsecond;
+        }
+#endif
+    }
+}
+
 #if !defined(SOCK_CLOEXEC)
 
 // This function is used if SOCK_CLOEXEC is not available.
@@ -343,6 +421,48 @@ bool socket_setup(SocketHandle sock, const SocketOpts& options) {
     return true;
 }
 
+bool socket_set_reuseport(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+#if defined(SO_REUSEPORT)
+    return set_int_option(sock, SOL_SOCKET, SO_REUSEPORT, "SO_REUSEPORT", 1);
+#else
+    roc_log(LogError, "socket: SO_REUSEPORT is not supported on this platform");
+    return false;
+#endif
+}
+
+bool socket_enable_recv_timestamps(SocketHandle sock) {
+    roc_panic_if(sock < 0);
+
+#if defined(SO_TIMESTAMPNS)
+    // Kernel attaches SCM_TIMESTAMPNS control message to every datagram,
+    // which is read by the same system call as the datagram itself.
+    return set_int_option(sock, SOL_SOCKET, SO_TIMESTAMPNS, "SO_TIMESTAMPNS", 1);
+#elif defined(SO_TIMESTAMP)
+    return set_int_option(sock, SOL_SOCKET, SO_TIMESTAMP, "SO_TIMESTAMP", 1);
+#else
+    roc_log(LogDebug, "socket: receive timestamps are not supported on this platform");
+    return false;
+#endif
+}
+
+bool socket_duplicate(SocketHandle sock, SocketHandle& new_sock) {
+    roc_panic_if(sock < 0);
+
+    while ((new_sock = fcntl(sock, F_DUPFD_CLOEXEC, 0)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            roc_log(LogError, "socket: fcntl(F_DUPFD_CLOEXEC): %s",
+                    core::errno_to_str().c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
 bool socket_bind(SocketHandle sock, address::SocketAddr& local_address) {
     roc_panic_if(sock < 0);
     roc_panic_if(!local_address.has_host_port());
@@ -653,6 +773,180 @@ ssize_t socket_try_send_to(SocketHandle sock,
     return ret;
 }
 
+ssize_t socket_try_send_batch(SocketHandle sock,
+                              const SocketDatagram* datagrams,
+                              size_t n_datagrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+    roc_panic_if(n_datagrams == 0);
+
+#if defined(__linux__)
+    enum { MaxBatch = 64 };
+
+    if (n_datagrams > MaxBatch) {
+        n_datagrams = MaxBatch;
+    }
+
+    mmsghdr msgs[MaxBatch];
+    iovec iovs[MaxBatch];
+
+    memset(msgs, 0, n_datagrams * sizeof(mmsghdr));
+
+    for (size_t n = 0; n < n_datagrams; n++) {
+        roc_panic_if(!datagrams[n].buf);
+        roc_panic_if(!datagrams[n].remote_address);
+        roc_panic_if(!datagrams[n].remote_address->has_host_port());
+
+        iovs[n].iov_base = const_cast<void*>(datagrams[n].buf);
+        iovs[n].iov_len = datagrams[n].bufsz;
+
+        msgs[n].msg_hdr.msg_name =
+            const_cast<sockaddr*>(datagrams[n].remote_address->saddr());
+        msgs[n].msg_hdr.msg_namelen = datagrams[n].remote_address->slen();
+        msgs[n].msg_hdr.msg_iov = &iovs[n];
+        msgs[n].msg_hdr.msg_iovlen = 1;
+    }
+
+    int ret;
+    while ((ret = sendmmsg(sock, msgs, (unsigned)n_datagrams, MSG_DONTWAIT)) == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret < 0 && is_ewouldblock(errno)) {
+        return SockErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: sendmmsg(): %s", core::errno_to_str().c_str());
+        return SockErr_Failure;
+    }
+
+    for (int n = 0; n < ret; n++) {
+        if (msgs[n].msg_len != datagrams[n].bufsz) {
+            roc_log(LogError,
+                    "socket: sendmmsg() processed less bytes than expected: "
+                    "requested=%lu processed=%lu",
+                    (unsigned long)datagrams[n].bufsz, (unsigned long)msgs[n].msg_len);
+            return n > 0 ? (ssize_t)n : (ssize_t)SockErr_Failure;
+        }
+    }
+
+    return ret;
+#else
+    size_t n_sent = 0;
+
+    for (; n_sent < n_datagrams; n_sent++) {
+        const ssize_t ret =
+            socket_try_send_to(sock, datagrams[n_sent].buf, datagrams[n_sent].bufsz,
+                               *datagrams[n_sent].remote_address);
+        if (ret < 0) {
+            if (n_sent == 0) {
+                return ret;
+            }
+            break;
+        }
+    }
+
+    return (ssize_t)n_sent;
+#endif
+}
+
+ssize_t socket_try_recv_batch(SocketHandle sock,
+                              SocketRecvDatagram* datagrams,
+                              size_t n_datagrams) {
+    roc_panic_if(sock < 0);
+    roc_panic_if(!datagrams);
+    roc_panic_if(n_datagrams == 0);
+
+    enum { MaxBatch = 64 };
+
+    if (n_datagrams > MaxBatch) {
+        n_datagrams = MaxBatch;
+    }
+
+    iovec iovs[MaxBatch];
+    sockaddr_storage addrs[MaxBatch];
+    RecvControl controls[MaxBatch];
+
+#if defined(__linux__)
+    mmsghdr msgs[MaxBatch];
+
+    for (size_t n = 0; n < n_datagrams; n++) {
+        prepare_recv_msg(msgs[n].msg_hdr, iovs[n], addrs[n], controls[n], datagrams[n]);
+        msgs[n].msg_len = 0;
+    }
+
+    int ret;
+    while ((ret = recvmmsg(sock, msgs, (unsigned)n_datagrams, MSG_DONTWAIT, NULL))
+           == -1) {
+        roc_panic_if(is_malformed(errno));
+
+        if (errno != EINTR) {
+            break;
+        }
+    }
+
+    if (ret < 0 && is_ewouldblock(errno)) {
+        return SockErr_WouldBlock;
+    }
+
+    if (ret < 0) {
+        roc_log(LogError, "socket: recvmmsg(): %s", core::errno_to_str().c_str());
+        return SockErr_Failure;
+    }
+
+    for (int n = 0; n < ret; n++) {
+        parse_recv_msg(msgs[n].msg_hdr, addrs[n], msgs[n].msg_len, datagrams[n]);
+    }
+
+    return ret;
+#else
+    size_t n_recv = 0;
+
+    for (; n_recv < n_datagrams; n_recv++) {
+        msghdr msg;
+        prepare_recv_msg(msg, iovs[n_recv], addrs[n_recv], controls[n_recv],
+                         datagrams[n_recv]);
+
+        ssize_t ret;
+        while ((ret = recvmsg(sock, &msg, MSG_DONTWAIT)) == -1) {
+            roc_panic_if(is_malformed(errno));
+
+            if (errno != EINTR) {
+                break;
+            }
+        }
+
+        if (ret < 0) {
+            if (n_recv != 0) {
+                break;
+            }
+            if (is_ewouldblock(errno)) {
+                return SockErr_WouldBlock;
+            }
+            roc_log(LogError, "socket: recvmsg(): %s", core::errno_to_str().c_str());
+            return SockErr_Failure;
+        }
+
+        parse_recv_msg(msg, addrs[n_recv], (size_t)ret, datagrams[n_recv]);
+    }
+
+    return (ssize_t)n_recv;
+#endif
+}
+
+bool socket_recv_batch_supported() {
+#if defined(__linux__)
+    return true;
+#else
+    return false;
+#endif
+}
+
 bool socket_shutdown(SocketHandle sock) {
     roc_panic_if(sock < 0);
 
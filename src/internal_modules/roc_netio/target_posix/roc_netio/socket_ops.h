@@ -15,6 +15,7 @@
 #include "roc_address/socket_addr.h"
 #include "roc_core/attributes.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 
 namespace roc {
 namespace netio {
@@ -47,6 +48,58 @@ enum SocketError {
     SockErr_Failure = -3
 };
 
+//! Datagram to be sent by socket_try_send_batch().
+struct SocketDatagram {
+    //! Datagram payload.
+    const void* buf;
+
+    //! Payload size.
+    size_t bufsz;
+
+    //! Destination address.
+    const address::SocketAddr* remote_address;
+
+    SocketDatagram()
+        : buf(NULL)
+        , bufsz(0)
+        , remote_address(NULL) {
+    }
+};
+
+//! Datagram to be received by socket_try_recv_batch().
+struct SocketRecvDatagram {
+    //! Buffer for datagram payload.
+    void* buf;
+
+    //! Buffer size.
+    size_t bufsz;
+
+    //! Number of received bytes.
+    //! Set by socket_try_recv_batch().
+    size_t nread;
+
+    //! Set if datagram was larger than buffer and was truncated.
+    //! Set by socket_try_recv_batch().
+    bool truncated;
+
+    //! Source address.
+    //! Set by socket_try_recv_batch().
+    address::SocketAddr remote_address;
+
+    //! Kernel receive timestamp, or zero if not available.
+    //! Uses the same clock as core::ClockUnix.
+    //! Set by socket_try_recv_batch().
+    core::nanoseconds_t timestamp;
+
+    SocketRecvDatagram()
+        : buf(NULL)
+        , bufsz(0)
+        , nread(0)
+        , truncated(false)
+        , timestamp(0) {
+    }
+};
+
 //! Platform-specific socket handle.
 typedef int SocketHandle;
 
@@ -65,6 +118,22 @@ ROC_NODISCARD bool socket_accept(SocketHandle sock,
 //! Set socket options.
 ROC_NODISCARD bool socket_setup(SocketHandle sock, const SocketOpts& options);
 
+//! Enable SO_REUSEPORT on socket.
+//! Allows multiple sockets to bind to the same address and port; kernel
+//! distributes incoming datagrams between them.
+//! Should be called before binding. Fails if not supported by platform.
+ROC_NODISCARD bool socket_set_reuseport(SocketHandle sock);
+
+//! Enable kernel receive timestamps on datagram socket.
+//! After this, socket_try_recv_batch() reports time when each datagram
+//! was received by kernel.
+//! Fails if not supported by platform.
+ROC_NODISCARD bool socket_enable_recv_timestamps(SocketHandle sock);
+
+//! Duplicate socket handle.
+//! New handle refers to the same socket and has close-on-exec flag.
+ROC_NODISCARD bool socket_duplicate(SocketHandle sock, SocketHandle& new_sock);
+
 //! Bind socket to local address.
 ROC_NODISCARD bool socket_bind(SocketHandle sock, address::SocketAddr& local_address);
 
@@ -98,6 +167,35 @@ ROC_NODISCARD ssize_t socket_try_send_to(SocketHandle sock,
                                          size_t bufsz,
                                          const address::SocketAddr& remote_address);
 
+//! Try to send multiple datagrams via socket, without blocking.
+//! @remarks
+//!  Uses sendmmsg() if it's supported by platform, which sends all datagrams
+//!  using one system call. Otherwise, sends datagrams one by one.
+//!  Datagrams are sent in order, and sending stops on first datagram that
+//!  can't be sent.
+//! @returns number of fully sent datagrams (> 0) or SocketError (< 0) if
+//!  no datagrams were sent.
+ROC_NODISCARD ssize_t socket_try_send_batch(SocketHandle sock,
+                                            const SocketDatagram* datagrams,
+                                            size_t n_datagrams);
+
+//! Try to receive multiple datagrams from socket, without blocking.
+//! @remarks
+//!  Uses recvmmsg() if it's supported by platform, which receives all datagrams
+//!  using one system call. Otherwise, receives datagrams one by one.
+//!  Each datagram is received directly into its own buffer. Source address
+//!  and, if enabled by socket_enable_recv_timestamps(), kernel timestamp are
+//!  taken from the same system call.
+//! @returns number of received datagrams (> 0) or SocketError (< 0) if
+//!  no datagrams were received.
+ROC_NODISCARD ssize_t socket_try_recv_batch(SocketHandle sock,
+                                            SocketRecvDatagram* datagrams,
+                                            size_t n_datagrams);
+
+//! Check if socket_try_recv_batch() receives multiple datagrams using
+//! one system call on this platform.
+bool socket_recv_batch_supported();
+
 //! Gracefully shutdown connection.
 ROC_NODISCARD bool socket_shutdown(SocketHandle sock);
 
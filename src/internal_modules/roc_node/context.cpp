@@ -23,10 +23,100 @@ Context::Context(const ContextConfig& config, core::IArena& arena)
           "frame_buffer_pool", arena_, sizeof(core::Buffer) + config.max_frame_size)
     , processor_map_(arena_)
     , encoding_map_(arena_)
-    , network_loop_(packet_pool_, packet_buffer_pool_, arena_)
-    , control_loop_(network_loop_, arena_)
+    , network_loop_(packet_pool_, packet_buffer_pool_, arena_, config.network_thread)
+    , num_network_loops_(1)
+    , next_network_loop_(0)
+    , enable_reuseport_(config.enable_reuseport)
+    , enable_kernel_timestamps_(config.enable_kernel_timestamps)
+    , udp_recv_batch_size_(config.udp_recv_batch_size)
+    , udp_send_batch_size_(config.udp_send_batch_size)
+    , memory_locked_(false)
+    , control_loop_(network_loop_, arena_, config.control_thread)
     , init_status_(status::NoStatus) {
-    roc_log(LogDebug, "context: initializing");
+    roc_log(LogDebug,
+            "context: initializing: network_threads=%lu reuseport=%d kernel_ts=%d"
+            " recv_batch=%lu send_batch=%lu",
+            (unsigned long)config.num_network_threads, (int)config.enable_reuseport,
+            (int)config.enable_kernel_timestamps,
+            (unsigned long)config.udp_recv_batch_size,
+            (unsigned long)config.udp_send_batch_size);
+
+    roc_log(LogDebug,
+            "context: threads: net_policy=%s net_prio=%d net_cpus=0x%llx"
+            " ctl_policy=%s ctl_prio=%d ctl_cpus=0x%llx"
+            " mlock=%d prewarm_packets=%lu prewarm_frames=%lu",
+            core::thread_policy_to_str(config.network_thread.policy),
+            config.network_thread.priority,
+            (unsigned long long)config.network_thread.cpu_mask,
+            core::thread_policy_to_str(config.control_thread.policy),
+            config.control_thread.priority,
+            (unsigned long long)config.control_thread.cpu_mask, (int)config.enable_mlock,
+            (unsigned long)config.prewarm_packets, (unsigned long)config.prewarm_frames);
+
+    if (config.num_network_threads < 1
+        || config.num_network_threads > MaxNetworkLoops) {
+        roc_log(LogError,
+                "context: invalid number of network threads: got=%lu expected=[1; %lu]",
+                (unsigned long)config.num_network_threads,
+                (unsigned long)MaxNetworkLoops);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (config.udp_recv_batch_size < 1
+        || config.udp_recv_batch_size > netio::UdpConfig::MaxBatchSize
+        || config.udp_send_batch_size < 1
+        || config.udp_send_batch_size > netio::UdpConfig::MaxBatchSize) {
+        roc_log(LogError,
+                "context: invalid udp batch size: recv_batch=%lu send_batch=%lu"
+                " expected=[1; %lu]",
+                (unsigned long)config.udp_recv_batch_size,
+                (unsigned long)config.udp_send_batch_size,
+                (unsigned long)netio::UdpConfig::MaxBatchSize);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (config.udp_recv_batch_size > 1 && !netio::UdpPort::batched_recv_supported()) {
+        roc_log(LogError,
+                "context: udp receive batching is not supported on this platform:"
+                " recv_batch=%lu",
+                (unsigned long)config.udp_recv_batch_size);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    // These pools are shared by network threads, pipeline threads, and user
+    // threads, so use sharded caches to reduce contention on pool mutexes.
+    // Cached objects stay allocated, so cache size is bounded for every pool.
+    // Pools are not used by network loop until ports are added.
+    if (!packet_pool_.enable_cache(MaxPoolCacheBytes)
+        || !packet_buffer_pool_.enable_cache(MaxPoolCacheBytes)
+        || !frame_pool_.enable_cache(MaxPoolCacheBytes)
+        || !frame_buffer_pool_.enable_cache(MaxPoolCacheBytes)) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    if (config.prewarm_packets != 0) {
+        if (!packet_pool_.reserve(config.prewarm_packets)
+            || !packet_buffer_pool_.reserve(config.prewarm_packets)) {
+            roc_log(LogError, "context: can't preallocate packets: count=%lu",
+                    (unsigned long)config.prewarm_packets);
+            init_status_ = status::StatusNoMem;
+            return;
+        }
+    }
+
+    if (config.prewarm_frames != 0) {
+        if (!frame_pool_.reserve(config.prewarm_frames)
+            || !frame_buffer_pool_.reserve(config.prewarm_frames)) {
+            roc_log(LogError, "context: can't preallocate frames: count=%lu",
+                    (unsigned long)config.prewarm_frames);
+            init_status_ = status::StatusNoMem;
+            return;
+        }
+    }
 
     if ((init_status_ = network_loop_.init_status()) != status::StatusOK) {
         roc_log(LogError, "context: can't create network loop: status=%s",
@@ -34,17 +124,64 @@ Context::Context(const ContextConfig& config, core::IArena& arena)
         return;
     }
 
+    for (; num_network_loops_ < config.num_network_threads; num_network_loops_++) {
+        core::Optional<netio::NetworkLoop>& loop =
+            extra_network_loops_[num_network_loops_ - 1];
+
+        loop.reset(new (loop) netio::NetworkLoop(packet_pool_, packet_buffer_pool_,
+                                                 arena_, config.network_thread));
+
+        if ((init_status_ = loop->init_status()) != status::StatusOK) {
+            roc_log(LogError, "context: can't create network loop: status=%s",
+                    status::code_to_str(init_status_));
+            return;
+        }
+    }
+
     if ((init_status_ = control_loop_.init_status()) != status::StatusOK) {
         roc_log(LogError, "context: can't create control loop: status=%s",
                 status::code_to_str(init_status_));
         return;
     }
 
+    if (config.enable_mlock) {
+        // Future pages are locked only if it's allowed without limits, so
+        // memory is locked after pools are prewarmed and threads are started,
+        // to cover pool slabs and thread stacks.
+        memory_locked_ = core::Thread::lock_memory();
+    }
+
     init_status_ = status::StatusOK;
 }
 
 Context::~Context() {
     roc_log(LogDebug, "context: deinitializing");
+
+    for (size_t n = 0; n < num_network_loops_; n++) {
+        netio::NetworkLoop& loop = network_loop(n);
+        if (loop.init_status() != status::StatusOK) {
+            continue;
+        }
+        roc_log(LogDebug,
+                "context: network loop %lu: recv_packets=%lu recv_batches=%lu"
+                " send_packets=%lu kernel_ts_packets=%lu kernel_ts_delay=%.3fms"
+                " kernel_ts_max_delay=%.3fms",
+                (unsigned long)n, (unsigned long)loop.num_received_packets(),
+                (unsigned long)loop.num_received_batches(),
+                (unsigned long)loop.num_sent_packets(),
+                (unsigned long)loop.num_kernel_timestamped_packets(),
+                (double)loop.mean_kernel_timestamp_delay() / core::Millisecond,
+                (double)loop.max_kernel_timestamp_delay() / core::Millisecond);
+    }
+
+    if (core::Thread::num_config_failures() != 0) {
+        roc_log(LogDebug, "context: thread config failures: count=%lu",
+                (unsigned long)core::Thread::num_config_failures());
+    }
+
+    if (memory_locked_) {
+        core::Thread::unlock_memory();
+    }
 }
 
 status::StatusCode Context::init_status() const {
@@ -79,10 +216,90 @@ rtp::EncodingMap& Context::encoding_map() {
     return encoding_map_;
 }
 
+size_t Context::num_network_loops() const {
+    return num_network_loops_;
+}
+
+bool Context::reuseport_enabled() const {
+    return enable_reuseport_;
+}
+
+bool Context::kernel_timestamps_enabled() const {
+    return enable_kernel_timestamps_;
+}
+
+size_t Context::udp_recv_batch_size() const {
+    return udp_recv_batch_size_;
+}
+
+size_t Context::udp_send_batch_size() const {
+    return udp_send_batch_size_;
+}
+
+bool Context::memory_locked() const {
+    return memory_locked_;
+}
+
+size_t Context::num_thread_config_failures() const {
+    return core::Thread::num_config_failures();
+}
+
+ContextMetrics Context::metrics() const {
+    ContextMetrics metrics;
+
+    metrics.memory_locked = memory_locked();
+    metrics.thread_config_failures = num_thread_config_failures();
+
+    core::nanoseconds_t total_delay = 0;
+
+    for (size_t n = 0; n < num_network_loops_; n++) {
+        const netio::NetworkLoop& loop =
+            n == 0 ? network_loop_ : *extra_network_loops_[n - 1];
+        if (loop.init_status() != status::StatusOK) {
+            continue;
+        }
+
+        const size_t n_packets = loop.num_kernel_timestamped_packets();
+
+        metrics.kernel_timestamped_packets += n_packets;
+        total_delay +=
+            loop.mean_kernel_timestamp_delay() * (core::nanoseconds_t)n_packets;
+
+        if (loop.max_kernel_timestamp_delay() > metrics.kernel_timestamp_max_delay) {
+            metrics.kernel_timestamp_max_delay = loop.max_kernel_timestamp_delay();
+        }
+    }
+
+    if (metrics.kernel_timestamped_packets != 0) {
+        metrics.kernel_timestamp_mean_delay =
+            total_delay / (core::nanoseconds_t)metrics.kernel_timestamped_packets;
+    }
+
+    return metrics;
+}
+
 netio::NetworkLoop& Context::network_loop() {
     return network_loop_;
 }
 
+netio::NetworkLoop& Context::network_loop(size_t index) {
+    roc_panic_if_msg(index >= num_network_loops_,
+                     "context: network loop index out of bounds: index=%lu size=%lu",
+                     (unsigned long)index, (unsigned long)num_network_loops_);
+
+    if (index == 0) {
+        return network_loop_;
+    }
+
+    return *extra_network_loops_[index - 1];
+}
+
+netio::NetworkLoop& Context::select_network_loop() {
+    const size_t index = next_network_loop_++;
+
+    return network_loop(index % num_network_loops_);
+}
+
 ctl::ControlLoop& Context::control_loop() {
     return control_loop_;
 }
@@ -17,8 +17,10 @@
 #include "roc_core/allocation_policy.h"
 #include "roc_core/atomic.h"
 #include "roc_core/iarena.h"
+#include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/slab_pool.h"
+#include "roc_core/thread.h"
 #include "roc_ctl/control_loop.h"
 #include "roc_netio/network_loop.h"
 #include "roc_packet/packet_factory.h"
@@ -35,15 +37,106 @@ struct ContextConfig {
     //! Maximum size in bytes of an audio frame.
     size_t max_frame_size;
 
+    //! Number of network threads.
+    //! Each thread runs its own network loop. Ports are distributed
+    //! between loops in round-robin order.
+    size_t num_network_threads;
+
+    //! Enable SO_REUSEPORT for receiving ports.
+    //! If set, every receiving port is bound once in each network loop,
+    //! and kernel distributes incoming packets between loop threads.
+    bool enable_reuseport;
+
+    //! Use kernel receive timestamps for received packets.
+    //! If set, receive timestamps don't include network loop scheduling
+    //! delay. Ignored if not supported by platform.
+    bool enable_kernel_timestamps;
+
+    //! Maximum number of datagrams received by one system call.
+    //! See netio::UdpConfig::recv_batch_size.
+    size_t udp_recv_batch_size;
+
+    //! Maximum number of datagrams sent by one system call.
+    //! See netio::UdpConfig::send_batch_size.
+    size_t udp_send_batch_size;
+
+    //! Scheduling parameters of network threads.
+    core::ThreadConfig network_thread;
+
+    //! Scheduling parameters of control thread.
+    core::ThreadConfig control_thread;
+
+    //! Lock process memory to avoid page faults in realtime threads.
+    //! @remarks
+    //!  Affects the whole process. See core::Thread::lock_memory().
+    //!  Memory is locked after pools are prewarmed and threads are started,
+    //!  and is unlocked when the last context that locked it is destroyed.
+    //!  Failure is logged and reported via ContextMetrics, but doesn't
+    //!  prevent context from working.
+    bool enable_mlock;
+
+    //! Number of packets to preallocate in context pools.
+    //! Allocations are done during initialization instead of during
+    //! streaming. Together with enable_mlock, this also avoids page faults.
+    size_t prewarm_packets;
+
+    //! Number of frames to preallocate in context pools.
+    size_t prewarm_frames;
+
     ContextConfig()
         : max_packet_size(2048)
-        , max_frame_size(4096) {
+        , max_frame_size(4096)
+        , num_network_threads(1)
+        , enable_reuseport(false)
+        , enable_kernel_timestamps(false)
+        , udp_recv_batch_size(1)
+        , udp_send_batch_size(1)
+        , enable_mlock(false)
+        , prewarm_packets(0)
+        , prewarm_frames(0) {
+    }
+};
+
+//! Context metrics.
+struct ContextMetrics {
+    //! Whether process memory was locked by this context.
+    bool memory_locked;
+
+    //! Number of failures to apply thread scheduling parameters or to
+    //! lock memory, since process start.
+    size_t thread_config_failures;
+
+    //! Number of received packets for which kernel timestamp was used.
+    size_t kernel_timestamped_packets;
+
+    //! Average difference between user-space and kernel receive timestamps.
+    //! Shows network thread scheduling delay excluded by kernel timestamps.
+    core::nanoseconds_t kernel_timestamp_mean_delay;
+
+    //! Maximum difference between user-space and kernel receive timestamps.
+    core::nanoseconds_t kernel_timestamp_max_delay;
+
+    ContextMetrics()
+        : memory_locked(false)
+        , thread_config_failures(0)
+        , kernel_timestamped_packets(0)
+        , kernel_timestamp_mean_delay(0)
+        , kernel_timestamp_max_delay(0) {
     }
 };
 
 //! Node context.
 class Context : public core::RefCounted<Context, core::NoopAllocation> {
 public:
+    //! Limits.
+    enum {
+        //! Maximum number of network loops.
+        MaxNetworkLoops = 16,
+
+        //! Maximum number of bytes of free objects kept in cache of each pool.
+        MaxPoolCacheBytes = 1024 * 1024
+    };
+
     //! Initialize.
     Context(const ContextConfig& config, core::IArena& arena);
 
@@ -74,9 +167,46 @@ public:
     //! Get encoding map.
     rtp::EncodingMap& encoding_map();
 
-    //! Get network event loop.
+    //! Get number of network event loops.
+    size_t num_network_loops() const;
+
+    //! Check if receiving ports should be bound in every network loop
+    //! using SO_REUSEPORT.
+    bool reuseport_enabled() const;
+
+    //! Check if receiving ports should use kernel receive timestamps.
+    bool kernel_timestamps_enabled() const;
+
+    //! Get maximum number of datagrams received by one system call.
+    size_t udp_recv_batch_size() const;
+
+    //! Get maximum number of datagrams sent by one system call.
+    size_t udp_send_batch_size() const;
+
+    //! Check if process memory was successfully locked.
+    bool memory_locked() const;
+
+    //! Get number of failures to apply thread scheduling parameters
+    //! or to lock memory.
+    //! @remarks
+    //!  Counter is process-wide, because memory locking and thread
+    //!  scheduling affect the whole process.
+    size_t num_thread_config_failures() const;
+
+    //! Get context metrics.
+    ContextMetrics metrics() const;
+
+    //! Get primary network event loop.
+    //! Used for tasks not bound to a specific port, like address resolving.
     netio::NetworkLoop& network_loop();
 
+    //! Get network event loop by index.
+    netio::NetworkLoop& network_loop(size_t index);
+
+    //! Select network event loop for new port.
+    //! Loops are selected in round-robin order.
+    netio::NetworkLoop& select_network_loop();
+
     //! Get control event loop.
     ctl::ControlLoop& control_loop();
 
@@ -93,6 +223,15 @@ private:
     rtp::EncodingMap encoding_map_;
 
     netio::NetworkLoop network_loop_;
+    core::Optional<netio::NetworkLoop> extra_network_loops_[MaxNetworkLoops - 1];
+    size_t num_network_loops_;
+    core::Atomic<size_t> next_network_loop_;
+    const bool enable_reuseport_;
+    const bool enable_kernel_timestamps_;
+    const size_t udp_recv_batch_size_;
+    const size_t udp_send_batch_size_;
+    bool memory_locked_;
+
     ctl::ControlLoop control_loop_;
 
     status::StatusCode init_status_;
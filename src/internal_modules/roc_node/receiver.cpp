@@ -94,7 +94,7 @@ bool Receiver::configure(slot_index_t slot_index,
         return false;
     }
 
-    if (slot->ports[iface].handle) {
+    if (slot->ports[iface].n_handles != 0) {
         roc_log(LogError,
                 "receiver node:"
                 " can't configure %s interface of slot %lu:"
@@ -168,25 +168,46 @@ bool Receiver::bind(slot_index_t slot_index,
     }
 
     port.config.bind_address = resolve_task.get_address();
+    port.config.enable_reuseport = context().reuseport_enabled();
+    port.config.enable_kernel_timestamps = context().kernel_timestamps_enabled();
+    port.config.recv_batch_size = context().udp_recv_batch_size();
 
-    netio::NetworkLoop::Tasks::AddUdpPort port_task(port.config);
-    if (!context().network_loop().schedule_and_wait(port_task)) {
-        roc_log(LogError,
-                "receiver node:"
-                " can't bind %s interface of slot %lu:"
-                " can't bind interface to local port",
-                address::interface_to_str(iface), (unsigned long)slot_index);
-        break_slot_(*slot);
-        return false;
-    }
+    // With SO_REUSEPORT, bind same address in every network loop, and let kernel
+    // distribute packets between loop threads. Otherwise, bind in one loop.
+    const size_t n_handles =
+        context().reuseport_enabled() ? context().num_network_loops() : 1;
+
+    for (size_t n = 0; n < n_handles; n++) {
+        netio::NetworkLoop& loop = context().reuseport_enabled()
+            ? context().network_loop(n)
+            : context().select_network_loop();
+
+        // If port number is zero, first bind selects it, and others reuse it.
+        netio::UdpConfig config = port.config;
+
+        netio::NetworkLoop::Tasks::AddUdpPort port_task(config);
+        if (!loop.schedule_and_wait(port_task)) {
+            roc_log(LogError,
+                    "receiver node:"
+                    " can't bind %s interface of slot %lu:"
+                    " can't bind interface to local port",
+                    address::interface_to_str(iface), (unsigned long)slot_index);
+            break_slot_(*slot);
+            return false;
+        }
 
-    port.handle = port_task.get_handle();
+        port.config.bind_address = config.bind_address;
+
+        port.loops[port.n_handles] = &loop;
+        port.handles[port.n_handles] = port_task.get_handle();
+        port.n_handles++;
+    }
 
     packet::IWriter* outbound_writer = NULL;
 
     if (iface == address::Iface_AudioControl) {
-        netio::NetworkLoop::Tasks::StartUdpSend send_task(port.handle);
-        if (!context().network_loop().schedule_and_wait(send_task)) {
+        netio::NetworkLoop::Tasks::StartUdpSend send_task(port.handles[0]);
+        if (!port.loops[0]->schedule_and_wait(send_task)) {
             roc_log(LogError,
                     "receiver node:"
                     " can't bind %s interface of slot %lu:"
@@ -211,16 +232,18 @@ bool Receiver::bind(slot_index_t slot_index,
         return false;
     }
 
-    netio::NetworkLoop::Tasks::StartUdpRecv recv_task(
-        port.handle, *endpoint_task.get_inbound_writer());
-    if (!context().network_loop().schedule_and_wait(recv_task)) {
-        roc_log(LogError,
-                "receiver node:"
-                " can't bind %s interface of slot %lu:"
-                " can't start receiving on local port",
-                address::interface_to_str(iface), (unsigned long)slot_index);
-        break_slot_(*slot);
-        return false;
+    for (size_t n = 0; n < port.n_handles; n++) {
+        netio::NetworkLoop::Tasks::StartUdpRecv recv_task(
+            port.handles[n], *endpoint_task.get_inbound_writer());
+        if (!port.loops[n]->schedule_and_wait(recv_task)) {
+            roc_log(LogError,
+                    "receiver node:"
+                    " can't bind %s interface of slot %lu:"
+                    " can't start receiving on local port",
+                    address::interface_to_str(iface), (unsigned long)slot_index);
+            break_slot_(*slot);
+            return false;
+        }
     }
 
     if (uri.port() == 0) {
@@ -287,15 +310,22 @@ bool Receiver::get_metrics(slot_index_t slot_index,
         }
     }
 
-    pipeline::ReceiverLoop::Tasks::QuerySlot task(
-        slot->handle, slot_metrics_,
-        party_metrics_.size() != 0 ? party_metrics_.data() : NULL, party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
-        roc_log(LogError,
-                "receiver node:"
-                " can't get metrics of slot %lu: operation failed",
-                (unsigned long)slot_index);
-        return false;
+    pipeline::ReceiverParticipantMetrics* party_metrics =
+        party_metrics_.size() != 0 ? party_metrics_.data() : NULL;
+
+    // If pipeline publishes metrics snapshots, read them without waiting
+    // for pipeline thread; otherwise, query metrics via pipeline task.
+    if (!pipeline_.read_slot_metrics(slot->handle, slot_metrics_, party_metrics,
+                                     party_metrics_size)) {
+        pipeline::ReceiverLoop::Tasks::QuerySlot task(slot->handle, slot_metrics_,
+                                                      party_metrics, party_metrics_size);
+        if (!pipeline_.schedule_and_wait(task)) {
+            roc_log(LogError,
+                    "receiver node:"
+                    " can't get metrics of slot %lu: operation failed",
+                    (unsigned long)slot_index);
+            return false;
+        }
     }
 
     if (slot_metrics_arg) {
@@ -409,14 +439,16 @@ core::SharedPtr<Receiver::Slot> Receiver::get_slot_(slot_index_t slot_index,
 void Receiver::cleanup_slot_(Slot& slot) {
     // First remove network ports, because they write to pipeline slot.
     for (size_t p = 0; p < address::Iface_Max; p++) {
-        if (slot.ports[p].handle) {
-            netio::NetworkLoop::Tasks::RemovePort task(slot.ports[p].handle);
-            if (!context().network_loop().schedule_and_wait(task)) {
+        Port& port = slot.ports[p];
+
+        for (size_t n = 0; n < port.n_handles; n++) {
+            netio::NetworkLoop::Tasks::RemovePort task(port.handles[n]);
+            if (!port.loops[n]->schedule_and_wait(task)) {
                 roc_panic("receiver node: can't remove network port of slot %lu",
                           (unsigned long)slot.index);
             }
-            slot.ports[p].handle = NULL;
         }
+        port.n_handles = 0;
     }
 
     // Then remove pipeline slot.
@@ -90,10 +90,14 @@ public:
 private:
     struct Port {
         netio::UdpConfig config;
-        netio::NetworkLoop::PortHandle handle;
+        // Usually port is bound in one network loop. If SO_REUSEPORT is enabled,
+        // it is bound once in every network loop, and there are multiple handles.
+        netio::NetworkLoop* loops[Context::MaxNetworkLoops];
+        netio::NetworkLoop::PortHandle handles[Context::MaxNetworkLoops];
+        size_t n_handles;
 
         Port()
-            : handle(NULL) {
+            : n_handles(0) {
         }
     };
 
@@ -188,8 +188,12 @@ bool Sender::connect(slot_index_t slot_index,
     }
 
     if (!port.handle) {
+        netio::NetworkLoop& loop = context().select_network_loop();
+
+        port.config.send_batch_size = context().udp_send_batch_size();
+
         netio::NetworkLoop::Tasks::AddUdpPort port_task(port.config);
-        if (!context().network_loop().schedule_and_wait(port_task)) {
+        if (!loop.schedule_and_wait(port_task)) {
             roc_log(LogError,
                     "sender node:"
                     " can't connect %s interface of slot %lu:"
@@ -199,6 +203,7 @@ bool Sender::connect(slot_index_t slot_index,
             return false;
         }
 
+        port.loop = &loop;
         port.handle = port_task.get_handle();
 
         roc_log(LogInfo, "sender node: bound %s interface to %s",
@@ -208,7 +213,7 @@ bool Sender::connect(slot_index_t slot_index,
 
     if (!port.outbound_writer) {
         netio::NetworkLoop::Tasks::StartUdpSend send_task(port.handle);
-        if (!context().network_loop().schedule_and_wait(send_task)) {
+        if (!port.loop->schedule_and_wait(send_task)) {
             roc_log(LogError,
                     "sender node:"
                     " can't connect %s interface of slot %lu:"
@@ -236,7 +241,7 @@ bool Sender::connect(slot_index_t slot_index,
     if (iface == address::Iface_AudioControl && endpoint_task.get_inbound_writer()) {
         netio::NetworkLoop::Tasks::StartUdpRecv recv_task(
             port.handle, *endpoint_task.get_inbound_writer());
-        if (!context().network_loop().schedule_and_wait(recv_task)) {
+        if (!port.loop->schedule_and_wait(recv_task)) {
             roc_log(LogError,
                     "sender node:"
                     " can't connect %s interface of slot %lu:"
@@ -306,15 +311,22 @@ bool Sender::get_metrics(slot_index_t slot_index,
         }
     }
 
-    pipeline::SenderLoop::Tasks::QuerySlot task(
-        slot->handle, slot_metrics_,
-        party_metrics_.size() != 0 ? party_metrics_.data() : NULL, party_metrics_size);
-    if (!pipeline_.schedule_and_wait(task)) {
-        roc_log(LogError,
-                "sender node:"
-                " can't get metrics of slot %lu: operation failed",
-                (unsigned long)slot_index);
-        return false;
+    pipeline::SenderParticipantMetrics* party_metrics =
+        party_metrics_.size() != 0 ? party_metrics_.data() : NULL;
+
+    // If pipeline publishes metrics snapshots, read them without waiting
+    // for pipeline thread; otherwise, query metrics via pipeline task.
+    if (!pipeline_.read_slot_metrics(slot->handle, slot_metrics_, party_metrics,
+                                     party_metrics_size)) {
+        pipeline::SenderLoop::Tasks::QuerySlot task(slot->handle, slot_metrics_,
+                                                    party_metrics, party_metrics_size);
+        if (!pipeline_.schedule_and_wait(task)) {
+            roc_log(LogError,
+                    "sender node:"
+                    " can't get metrics of slot %lu: operation failed",
+                    (unsigned long)slot_index);
+            return false;
+        }
     }
 
     if (slot_metrics_arg) {
@@ -483,10 +495,11 @@ void Sender::cleanup_slot_(Slot& slot) {
     for (size_t p = 0; p < address::Iface_Max; p++) {
         if (slot.ports[p].handle) {
             netio::NetworkLoop::Tasks::RemovePort task(slot.ports[p].handle);
-            if (!context().network_loop().schedule_and_wait(task)) {
+            if (!slot.ports[p].loop->schedule_and_wait(task)) {
                 roc_panic("sender node: can't remove network port of slot %lu",
                           (unsigned long)slot.index);
             }
+            slot.ports[p].loop = NULL;
             slot.ports[p].handle = NULL;
         }
     }
@@ -96,11 +96,13 @@ private:
     struct Port {
         netio::UdpConfig config;
         netio::UdpConfig orig_config;
+        netio::NetworkLoop* loop;
         netio::NetworkLoop::PortHandle handle;
         packet::IWriter* outbound_writer;
 
         Port()
-            : handle(NULL)
+            : loop(NULL)
+            , handle(NULL)
             , outbound_writer(NULL) {
         }
     };
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/fanout.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace packet {
+
+Fanout::Fanout(PacketFactory& packet_factory, core::IArena& arena)
+    : packet_factory_(packet_factory)
+    , outputs_(arena)
+    , n_copies_(0)
+    , init_status_(status::StatusOK) {
+}
+
+status::StatusCode Fanout::init_status() const {
+    return init_status_;
+}
+
+size_t Fanout::num_outputs() const {
+    return outputs_.size();
+}
+
+bool Fanout::has_output(IWriter& writer) const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    for (size_t no = 0; no < outputs_.size(); no++) {
+        if (outputs_[no] == &writer) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+status::StatusCode Fanout::add_output(IWriter& writer) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (!outputs_.push_back(&writer)) {
+        roc_log(LogError, "packet fanout: can't add output: allocation failed");
+        return status::StatusNoMem;
+    }
+
+    return status::StatusOK;
+}
+
+void Fanout::remove_output(IWriter& writer) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    size_t rm_idx = (size_t)-1;
+
+    for (size_t no = 0; no < outputs_.size(); no++) {
+        if (outputs_[no] == &writer) {
+            rm_idx = no;
+            break;
+        }
+    }
+
+    if (rm_idx == (size_t)-1) {
+        roc_panic("packet fanout: can't remove output: writer not found");
+    }
+
+    for (size_t no = rm_idx + 1; no < outputs_.size(); no++) {
+        outputs_[no - 1] = outputs_[no];
+    }
+
+    if (!outputs_.resize(outputs_.size() - 1)) {
+        roc_panic("packet fanout: can't remove output: resize failed");
+    }
+}
+
+status::StatusCode Fanout::write(const PacketPtr& packet) {
+    roc_panic_if(init_status_ != status::StatusOK);
+    roc_panic_if(!packet);
+
+    if (outputs_.size() == 0) {
+        return status::StatusOK;
+    }
+
+    // Make copies before passing original packet anywhere, because outputs
+    // may modify it (e.g. set destination address).
+    // If some output fails, we still write packet to other outputs,
+    // and report first error.
+    status::StatusCode first_code = status::StatusOK;
+
+    for (size_t no = 1; no < outputs_.size(); no++) {
+        status::StatusCode code = status::NoStatus;
+
+        PacketPtr copy = copy_packet_(*packet);
+        if (copy) {
+            code = outputs_[no]->write(copy);
+        } else {
+            roc_log(LogError, "packet fanout: can't allocate packet copy");
+            code = status::StatusNoMem;
+        }
+
+        if (code != status::StatusOK && first_code == status::StatusOK) {
+            first_code = code;
+        }
+    }
+
+    const status::StatusCode code = outputs_[0]->write(packet);
+    if (code != status::StatusOK && first_code == status::StatusOK) {
+        first_code = code;
+    }
+
+    return first_code;
+}
+
+size_t Fanout::num_copies() const {
+    return n_copies_;
+}
+
+PacketPtr Fanout::copy_packet_(const Packet& packet) {
+    PacketPtr copy = packet_factory_.new_packet();
+    if (!copy) {
+        return NULL;
+    }
+
+    copy->add_flags(packet.flags());
+
+    if (packet.udp()) {
+        *copy->udp() = *packet.udp();
+    }
+    if (packet.rtp()) {
+        *copy->rtp() = *packet.rtp();
+    }
+    if (packet.fec()) {
+        *copy->fec() = *packet.fec();
+    }
+    if (packet.rtcp()) {
+        *copy->rtcp() = *packet.rtcp();
+    }
+
+    copy->set_buffer(packet.buffer());
+
+    n_copies_++;
+
+    return copy;
+}
+
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/fanout.h
+//! @brief Duplicate packets to multiple writers.
+
+#ifndef ROC_PACKET_FANOUT_H_
+#define ROC_PACKET_FANOUT_H_
+
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+
+//! Duplicate packets to multiple writers.
+//!
+//! Every output receives its own packet object, because packets may be
+//! modified and queued independently by each output (e.g. get different
+//! destination address). However, all copies share the same buffer, so
+//! the packet data itself is not copied. The original packet is passed
+//! to the first output, and copies are passed to others.
+//!
+//! Packets are expected to be already composed, since composing would
+//! modify shared buffer.
+class Fanout : public IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    Fanout(PacketFactory& packet_factory, core::IArena& arena);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Get number of outputs.
+    size_t num_outputs() const;
+
+    //! Check if writer is already added.
+    bool has_output(IWriter& writer) const;
+
+    //! Add output writer.
+    ROC_NODISCARD status::StatusCode add_output(IWriter& writer);
+
+    //! Remove output writer.
+    void remove_output(IWriter& writer);
+
+    //! Write packet to every output.
+    //! @remarks
+    //!  If there are no outputs, packet is dropped. If some output fails,
+    //!  packet is still written to the rest of outputs, and first error
+    //!  is returned.
+    virtual ROC_NODISCARD status::StatusCode write(const PacketPtr& packet);
+
+    //! Get number of copies made since creation.
+    size_t num_copies() const;
+
+private:
+    PacketPtr copy_packet_(const Packet& packet);
+
+    PacketFactory& packet_factory_;
+
+    core::Array<IWriter*, 8> outputs_;
+    size_t n_copies_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_FANOUT_H_
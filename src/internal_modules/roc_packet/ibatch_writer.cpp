@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_packet/ibatch_writer.h"
+
+namespace roc {
+namespace packet {
+
+IBatchWriter::~IBatchWriter() {
+}
+
+} // namespace packet
+} // namespace roc
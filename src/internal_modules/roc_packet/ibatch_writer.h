@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_packet/ibatch_writer.h
+//! @brief Packet batch writer interface.
+
+#ifndef ROC_PACKET_IBATCH_WRITER_H_
+#define ROC_PACKET_IBATCH_WRITER_H_
+
+#include "roc_core/attributes.h"
+#include "roc_packet/iwriter.h"
+#include "roc_packet/packet.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace packet {
+
+//! Packet batch writer interface.
+//! @remarks
+//!  Extends IWriter with an operation to write multiple packets at once,
+//!  which may be cheaper than writing them one by one, e.g. when packets
+//!  are passed to another thread.
+class IBatchWriter : public IWriter {
+public:
+    virtual ~IBatchWriter();
+
+    //! Write multiple packets.
+    //!
+    //! @note
+    //!  Has same semantics as calling write() for every packet, but packets
+    //!  may become visible to the reader all at once.
+    //!
+    //! @returns
+    //!  - If all packets were successfully and completely written, returns
+    //!    status::StatusOK, otherwise, returns an error.
+    //!  - In case of error, it's not guaranteed that pipeline state didn't change,
+    //!    e.g. part of the packets may be written.
+    //!
+    //! @see status::StatusCode.
+    virtual ROC_NODISCARD status::StatusCode write_batch(const PacketPtr* packets,
+                                                         size_t n_packets) = 0;
+};
+
+} // namespace packet
+} // namespace roc
+
+#endif // ROC_PACKET_IBATCH_WRITER_H_
@@ -14,12 +14,63 @@
 namespace roc {
 namespace packet {
 
+namespace {
+
+// Seqnums are compared using 16-bit signed difference, so the window
+// can't cover more than half of the seqnum space.
+const size_t MaxWindowSize = 1 << 15;
+
+} // namespace
+
 SortedQueue::SortedQueue(size_t max_size)
-    : max_size_(max_size) {
+    : max_size_(max_size)
+    , arena_(NULL)
+    , ring_(NULL)
+    , ring_size_(0)
+    , init_status_(status::StatusOK) {
+}
+
+SortedQueue::SortedQueue(size_t max_size, size_t window_size, core::IArena& arena)
+    : max_size_(max_size)
+    , arena_(&arena)
+    , ring_(NULL)
+    , ring_size_(0)
+    , init_status_(status::NoStatus) {
+    if (window_size == 0 || window_size > MaxWindowSize) {
+        roc_log(LogError,
+                "sorted queue: invalid window size: got=%lu expected=[1; %lu]",
+                (unsigned long)window_size, (unsigned long)MaxWindowSize);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    ring_size_ = 1;
+    while (ring_size_ < window_size) {
+        ring_size_ <<= 1;
+    }
+
+    ring_ = (Packet**)arena_->allocate(ring_size_ * sizeof(Packet*));
+    if (!ring_) {
+        roc_log(LogError, "sorted queue: can't allocate ring: window_size=%lu",
+                (unsigned long)ring_size_);
+        ring_size_ = 0;
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    memset(ring_, 0, ring_size_ * sizeof(Packet*));
+
+    init_status_ = status::StatusOK;
+}
+
+SortedQueue::~SortedQueue() {
+    if (ring_) {
+        arena_->deallocate(ring_);
+    }
 }
 
 status::StatusCode SortedQueue::init_status() const {
-    return status::StatusOK;
+    return init_status_;
 }
 
 size_t SortedQueue::size() const {
@@ -39,6 +90,8 @@ PacketPtr SortedQueue::tail() const {
 }
 
 status::StatusCode SortedQueue::write(const PacketPtr& packet) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
     if (!packet) {
         roc_panic("sorted queue: attempting to add null packet");
     }
@@ -55,6 +108,25 @@ status::StatusCode SortedQueue::write(const PacketPtr& packet) {
         latest_ = packet;
     }
 
+    Packet* next = NULL;
+    bool is_dup = false;
+
+    if (ring_find_pos_(*packet, next, is_dup)) {
+        if (is_dup) {
+            roc_log(LogDebug, "sorted queue: dropping duplicate packet");
+            return status::StatusOK;
+        }
+
+        if (next) {
+            list_.insert_before(*packet, *next);
+        } else {
+            list_.push_back(*packet);
+        }
+
+        ring_add_(*packet);
+        return status::StatusOK;
+    }
+
     PacketPtr pos = list_.back();
 
     for (; pos; pos = list_.prevof(*pos)) {
@@ -78,20 +150,114 @@ status::StatusCode SortedQueue::write(const PacketPtr& packet) {
         list_.push_front(*packet);
     }
 
+    ring_add_(*packet);
     return status::StatusOK;
 }
 
 status::StatusCode SortedQueue::read(PacketPtr& packet, PacketReadMode mode) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
     packet = list_.front();
     if (!packet) {
         return status::StatusDrain;
     }
 
     if (mode == ModeFetch) {
+        ring_remove_(*packet);
         list_.remove(*packet);
     }
     return status::StatusOK;
 }
 
+// Find insertion position using ring.
+// Returns false if ring can't be used for this packet and caller should
+// fall back to list scan. Otherwise, sets @p next to the packet before which
+// the new packet should be inserted, or to NULL if it should be appended.
+//
+// Ring invariant: every queued RTP packet with seqnum in (tail - ring_size_; tail]
+// is stored in its slot. Packets are added to the ring only when they are within
+// the window relative to the current tail, and since the tail only moves forward
+// while packets are queued, an in-window packet can't be overwritten by another
+// packet mapped to the same slot.
+bool SortedQueue::ring_find_pos_(const Packet& packet,
+                                 Packet*& next,
+                                 bool& is_dup) const {
+    if (!ring_) {
+        return false;
+    }
+
+    const Packet* tail = list_.back().get();
+    if (!tail || !tail->rtp() || !packet.rtp()) {
+        return false;
+    }
+
+    const seqnum_t sn = packet.rtp()->seqnum;
+    const seqnum_t tail_sn = tail->rtp()->seqnum;
+    const seqnum_diff_t dist = seqnum_diff(tail_sn, sn);
+
+    if (dist < 0) {
+        // Newer than tail, append.
+        next = NULL;
+        return true;
+    }
+
+    if ((size_t)dist >= ring_size_) {
+        // Window overflow.
+        return false;
+    }
+
+    const size_t mask = ring_size_ - 1;
+
+    const Packet* same = ring_[sn & mask];
+    if (same && same->rtp()->seqnum == sn) {
+        is_dup = true;
+        return true;
+    }
+
+    for (seqnum_t next_sn = seqnum_t(sn + 1);; next_sn++) {
+        Packet* candidate = ring_[next_sn & mask];
+        if (candidate && candidate->rtp()->seqnum == next_sn) {
+            next = candidate;
+            return true;
+        }
+        if (next_sn == tail_sn) {
+            break;
+        }
+    }
+
+    // Should not happen because tail is always in the ring,
+    // but list scan is a safe fallback anyway.
+    return false;
+}
+
+void SortedQueue::ring_add_(Packet& packet) {
+    if (!ring_ || !packet.rtp()) {
+        return;
+    }
+
+    const Packet* tail = list_.back().get();
+    if (!tail->rtp()) {
+        return;
+    }
+
+    const seqnum_diff_t dist = seqnum_diff(tail->rtp()->seqnum, packet.rtp()->seqnum);
+    if (dist < 0 || (size_t)dist >= ring_size_) {
+        return;
+    }
+
+    ring_[packet.rtp()->seqnum & (ring_size_ - 1)] = &packet;
+}
+
+void SortedQueue::ring_remove_(Packet& packet) {
+    if (!ring_ || !packet.rtp()) {
+        return;
+    }
+
+    Packet*& slot = ring_[packet.rtp()->seqnum & (ring_size_ - 1)];
+    if (slot == &packet) {
+        slot = NULL;
+    }
+}
+
 } // namespace packet
 } // namespace roc
@@ -12,6 +12,7 @@
 #ifndef ROC_PACKET_SORTED_QUEUE_H_
 #define ROC_PACKET_SORTED_QUEUE_H_
 
+#include "roc_core/iarena.h"
 #include "roc_core/list.h"
 #include "roc_core/noncopyable.h"
 #include "roc_packet/ireader.h"
@@ -21,18 +22,40 @@
 namespace roc {
 namespace packet {
 
+//! Default size of seqnum window for SortedQueue.
+//! @remarks
+//!  Enough for a few seconds of packets with typical packet durations.
+const size_t DefaultSortedQueueWindow = 1024;
+
 //! Sorted packet queue.
 //! @remarks
 //!  Packets order is determined by Packet::compare() method.
+//!
+//!  Packets are stored in a list. Optionally, queue can maintain a ring
+//!  indexed by RTP seqnum modulo window size, which covers seqnums from
+//!  (tail - window) to tail. When a reordered RTP packet falls into the
+//!  window, its position is found by looking up its successors in the ring,
+//!  which is typically O(1), instead of scanning the list from the tail.
+//!  Packets without RTP header or outside of the window fall back to the
+//!  list scan.
 //! @note
 //!  Not thread safe.
 class SortedQueue : public IWriter, public IReader, public core::NonCopyable<> {
 public:
-    //! Construct empty queue.
+    //! Construct empty queue without seqnum window.
     //! @remarks
     //!  If @p max_size is non-zero, it specifies maximum number of packets in queue.
     explicit SortedQueue(size_t max_size);
 
+    //! Construct empty queue with seqnum window.
+    //! @remarks
+    //!  If @p max_size is non-zero, it specifies maximum number of packets in queue.
+    //!  @p window_size defines the number of seqnums covered by ring index, it's
+    //!  rounded up to a power of two. The ring is allocated from @p arena.
+    SortedQueue(size_t max_size, size_t window_size, core::IArena& arena);
+
+    ~SortedQueue();
+
     //! Check if the object was successfully constructed.
     status::StatusCode init_status() const;
 
@@ -75,9 +98,19 @@ public:
     virtual ROC_NODISCARD status::StatusCode read(PacketPtr& packet, PacketReadMode mode);
 
 private:
+    bool ring_find_pos_(const Packet& packet, Packet*& next, bool& is_dup) const;
+    void ring_add_(Packet& packet);
+    void ring_remove_(Packet& packet);
+
     core::List<Packet> list_;
     PacketPtr latest_;
     const size_t max_size_;
+
+    core::IArena* arena_;
+    Packet** ring_;
+    size_t ring_size_;
+
+    status::StatusCode init_status_;
 };
 
 } // namespace packet
@@ -21,10 +21,17 @@ SenderSinkConfig::SenderSinkConfig()
     , enable_cpu_clock(false)
     , enable_auto_cts(false)
     , enable_interleaving(false)
-    , enable_profiling(false) {
+    , enable_adaptive_fec(false)
+    , enable_profiling(false)
+    , enable_stage_profiling(false)
+    , enable_shared_encoding(false)
+    , enable_metrics_snapshots(false)
+    , metrics_snapshot_interval(DefaultMetricsSnapshotInterval) {
 }
 
 bool SenderSinkConfig::deduce_defaults(audio::ProcessorMap& processor_map) {
+    fec_tuner.deduce_defaults(fec_writer);
+
     if (!latency.deduce_defaults(DefaultLatency, false)) {
         return false;
     }
@@ -56,7 +63,11 @@ ReceiverCommonConfig::ReceiverCommonConfig()
     : output_sample_spec(DefaultSampleSpec)
     , enable_cpu_clock(false)
     , enable_auto_reclock(false)
-    , enable_profiling(false) {
+    , enable_virtual_clock(false)
+    , enable_profiling(false)
+    , enable_stage_profiling(false)
+    , enable_metrics_snapshots(false)
+    , metrics_snapshot_interval(DefaultMetricsSnapshotInterval) {
 }
 
 bool ReceiverCommonConfig::deduce_defaults(audio::ProcessorMap& processor_map) {
@@ -70,9 +81,8 @@ ReceiverSessionConfig::ReceiverSessionConfig()
 }
 
 bool ReceiverSessionConfig::deduce_defaults(audio::ProcessorMap& processor_map) {
-    if (!plc.deduce_defaults()) {
-        return false;
-    }
+    // PLC defaults depend on packet encoding, which is not known until
+    // session is created, so they're deduced in ReceiverSession.
 
     if (!latency.deduce_defaults(DefaultLatency, true)) {
         return false;
@@ -100,7 +110,8 @@ bool ReceiverSessionConfig::deduce_defaults(audio::ProcessorMap& processor_map)
 
 // ReceiverSourceConfig
 
-ReceiverSourceConfig::ReceiverSourceConfig() {
+ReceiverSourceConfig::ReceiverSourceConfig()
+    : num_session_workers(0) {
 }
 
 bool ReceiverSourceConfig::deduce_defaults(audio::ProcessorMap& processor_map) {
@@ -25,11 +25,14 @@
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
 #include "roc_dbgio/csv_dumper.h"
+#include "roc_dbgio/packet_capture_writer.h"
 #include "roc_fec/block_reader.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/block_writer.h"
 #include "roc_fec/codec_config.h"
 #include "roc_packet/units.h"
 #include "roc_pipeline/pipeline_loop.h"
+#include "roc_pipeline/stage_profiler.h"
 #include "roc_rtcp/config.h"
 #include "roc_rtp/filter.h"
 
@@ -55,6 +58,12 @@ const core::nanoseconds_t DefaultPacketLength = 5 * core::Millisecond;
 //!  networks allow lower latencies, and some networks require higher.
 const core::nanoseconds_t DefaultLatency = 200 * core::Millisecond;
 
+//! Default interval of publishing metrics snapshots.
+//! @remarks
+//!  Collecting metrics of all participants is not free, so it is done
+//!  once per interval instead of every frame.
+const core::nanoseconds_t DefaultMetricsSnapshotInterval = 10 * core::Millisecond;
+
 //! Parameters of sender sink and sender session.
 struct SenderSinkConfig {
     //! Input sample spec
@@ -75,6 +84,10 @@ struct SenderSinkConfig {
     //! FEC encoder parameters.
     fec::CodecConfig fec_encoder;
 
+    //! FEC block tuner parameters.
+    //! Used if adaptive FEC is enabled.
+    fec::BlockTunerConfig fec_tuner;
+
     //! Feedback parameters.
     audio::FeedbackConfig feedback;
 
@@ -90,6 +103,9 @@ struct SenderSinkConfig {
     //! Profiler configuration.
     audio::ProfilerConfig profiler;
 
+    //! Stage profiler configuration.
+    StageProfilerConfig stage_profiler;
+
     //! RTCP config.
     rtcp::Config rtcp;
 
@@ -102,9 +118,36 @@ struct SenderSinkConfig {
     //! Interleave packets.
     bool enable_interleaving;
 
+    //! Adjust FEC block size based on loss reported by receiver.
+    //! Requires FEC and RTCP. Not used with multicast control endpoint.
+    bool enable_adaptive_fec;
+
     //! Profile moving average of frames being written.
     bool enable_profiling;
 
+    //! Measure time spent in every pipeline stage.
+    //! Results are reported via stage metrics.
+    bool enable_stage_profiling;
+
+    //! Share encoding between slots with identical endpoint protocols.
+    //! Frames are encoded once, and every slot gets copies of the packets.
+    //! Slots sharing encoding send identical streams with the same SSRC and
+    //! seqnums, and if SSRC is changed because of collision reported via one
+    //! slot, it's changed for all of them.
+    //! Has effect only if latency tuning is disabled (tuner profile is intact),
+    //! since otherwise every slot adjusts its own resampler, and if adaptive FEC
+    //! is disabled, since otherwise every slot adjusts its own FEC block size.
+    bool enable_shared_encoding;
+
+    //! Periodically publish snapshot of slot metrics.
+    //! Allows to query metrics from any thread without waiting for pipeline.
+    bool enable_metrics_snapshots;
+
+    //! How often to publish snapshot of slot metrics.
+    //! Measured in stream time, i.e. duration of processed frames.
+    //! If zero, snapshot is published after every frame.
+    core::nanoseconds_t metrics_snapshot_interval;
+
     //! Parameters for a logger in csv format with some run-time metrics.
     dbgio::CsvConfig dumper;
 
@@ -132,6 +175,9 @@ struct ReceiverCommonConfig {
     //! Profiler configuration.
     audio::ProfilerConfig profiler;
 
+    //! Stage profiler configuration.
+    StageProfilerConfig stage_profiler;
+
     //! RTP filter parameters.
     rtp::FilterConfig rtp_filter;
 
@@ -144,12 +190,35 @@ struct ReceiverCommonConfig {
     //! Automatically invoke reclock before returning frames with invocation time.
     bool enable_auto_reclock;
 
+    //! Pipeline is driven by virtual clock passed to refresh() instead of
+    //! system clock, e.g. when replaying captured packets.
+    //! If set, time passed to refresh() is also used to measure how long
+    //! there were no packets. Otherwise, system clock is used for that.
+    bool enable_virtual_clock;
+
     //! Profile moving average of frames being written.
     bool enable_profiling;
 
+    //! Measure time spent in every pipeline stage.
+    //! Results are reported via stage metrics.
+    bool enable_stage_profiling;
+
+    //! Periodically publish snapshot of slot metrics.
+    //! Allows to query metrics from any thread without waiting for pipeline.
+    bool enable_metrics_snapshots;
+
+    //! How often to publish snapshot of slot metrics.
+    //! Measured in stream time, i.e. duration of processed frames.
+    //! If zero, snapshot is published after every frame.
+    core::nanoseconds_t metrics_snapshot_interval;
+
     //! Parameters for a logger in csv format with some run-time metrics.
     dbgio::CsvConfig dumper;
 
+    //! Parameters for capturing packets received by pipeline.
+    //! Capture can be replayed later using roc-replay tool.
+    dbgio::PacketCaptureConfig capture;
+
     //! Initialize config.
     ReceiverCommonConfig();
 
@@ -169,6 +238,7 @@ struct ReceiverSessionConfig {
     fec::CodecConfig fec_decoder;
 
     //! PLC parameters.
+    //! If backend is default, it's chosen by session depending on encoding.
     audio::PlcConfig plc;
 
     //! Latency parameters.
@@ -205,6 +275,12 @@ struct ReceiverSourceConfig {
     //! Default parameters for a session.
     ReceiverSessionConfig session_defaults;
 
+    //! Number of worker threads for reading sessions in parallel.
+    //! If zero, all sessions are read sequentially on pipeline thread.
+    //! Otherwise, before mixing, sessions are read in parallel by workers
+    //! and pipeline thread.
+    size_t num_session_workers;
+
     //! Initialize config.
     ReceiverSourceConfig();
 
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/frame_prefetcher.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+FramePrefetcher::FramePrefetcher(audio::IFrameReader& reader,
+                                 const audio::SampleSpec& sample_spec,
+                                 audio::FrameFactory& frame_factory,
+                                 core::IArena& arena)
+    : core::RefCounted<FramePrefetcher, core::ArenaAllocation>(arena)
+    , reader_(reader)
+    , frame_factory_(frame_factory)
+    , sample_spec_(sample_spec)
+    , frame_pos_(0)
+    , frame_size_(0)
+    , pending_status_(status::NoStatus)
+    , init_status_(status::NoStatus) {
+    roc_panic_if_msg(!sample_spec_.is_complete() || !sample_spec_.is_raw(),
+                     "frame prefetcher: required complete sample spec with raw format:"
+                     " spec=%s",
+                     audio::sample_spec_to_str(sample_spec_).c_str());
+
+    frame_ = frame_factory_.allocate_frame(0);
+    if (!frame_) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+status::StatusCode FramePrefetcher::init_status() const {
+    return init_status_;
+}
+
+audio::IFrameReader& FramePrefetcher::inner_reader() const {
+    return reader_;
+}
+
+void FramePrefetcher::prefetch(packet::stream_timestamp_t duration,
+                               audio::FrameReadMode mode) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (frame_pos_ < frame_size_ || pending_status_ != status::NoStatus) {
+        return;
+    }
+
+    const packet::stream_timestamp_t capped_duration =
+        sample_spec_.cap_frame_duration(duration, frame_factory_.byte_buffer_size());
+
+    frame_pos_ = 0;
+    frame_size_ = 0;
+
+    if (!frame_factory_.reallocate_frame(
+            *frame_, sample_spec_.stream_timestamp_2_bytes(capped_duration))) {
+        pending_status_ = status::StatusNoMem;
+        return;
+    }
+
+    const status::StatusCode code = reader_.read(*frame_, capped_duration, mode);
+
+    if (code == status::StatusOK || code == status::StatusPart) {
+        sample_spec_.validate_frame(*frame_);
+        frame_size_ = frame_->num_raw_samples();
+    } else {
+        // Drain, finish, or error, will be reported from next read().
+        pending_status_ = code;
+    }
+}
+
+status::StatusCode FramePrefetcher::read(audio::Frame& frame,
+                                         packet::stream_timestamp_t duration,
+                                         audio::FrameReadMode mode) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (frame_pos_ < frame_size_) {
+        const size_t n_samples =
+            std::min((size_t)duration * sample_spec_.num_channels(),
+                     frame_size_ - frame_pos_);
+
+        if (!frame_factory_.reallocate_frame(frame,
+                                             n_samples * sizeof(audio::sample_t))) {
+            return status::StatusNoMem;
+        }
+
+        frame.set_raw(true);
+        frame.set_flags(frame_->flags());
+
+        memcpy(frame.raw_samples(), frame_->raw_samples() + frame_pos_,
+               n_samples * sizeof(audio::sample_t));
+
+        frame.set_num_raw_samples(n_samples);
+        frame.set_duration(
+            packet::stream_timestamp_t(n_samples / sample_spec_.num_channels()));
+        if (frame_->capture_timestamp() != 0) {
+            frame.set_capture_timestamp(frame_->capture_timestamp()
+                                        + sample_spec_.samples_overall_2_ns(frame_pos_));
+        } else {
+            frame.set_capture_timestamp(0);
+        }
+
+        frame_pos_ += n_samples;
+
+        return frame.duration() < duration ? status::StatusPart : status::StatusOK;
+    }
+
+    if (pending_status_ != status::NoStatus) {
+        const status::StatusCode code = pending_status_;
+        pending_status_ = status::NoStatus;
+        return code;
+    }
+
+    return reader_.read(frame, duration, mode);
+}
+
+} // namespace pipeline
+} // namespace roc
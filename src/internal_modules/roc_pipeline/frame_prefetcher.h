@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/frame_prefetcher.h
+//! @brief Frame prefetcher.
+
+#ifndef ROC_PIPELINE_FRAME_PREFETCHER_H_
+#define ROC_PIPELINE_FRAME_PREFETCHER_H_
+
+#include "roc_audio/frame.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/iframe_reader.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list_node.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/ref_counted.h"
+#include "roc_packet/units.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Frame prefetcher.
+//!
+//! Wraps frame reader and allows to read a frame from it in advance,
+//! possibly from another thread, and then return it from read().
+//!
+//! Used to pull receiver sessions in parallel, before mixer combines them:
+//! prefetch() is invoked for every session from worker threads, and then
+//! mixer invokes read() from pipeline thread, which returns prefetched
+//! samples without invoking session pipeline.
+//!
+//! If prefetched samples are exhausted, read() falls back to reading
+//! from wrapped reader directly.
+//!
+//! prefetch() and read() should never be called concurrently.
+class FramePrefetcher : public core::RefCounted<FramePrefetcher, core::ArenaAllocation>,
+                        public core::ListNode<FramePrefetcher>,
+                        public audio::IFrameReader {
+public:
+    //! Initialize.
+    FramePrefetcher(audio::IFrameReader& reader,
+                    const audio::SampleSpec& sample_spec,
+                    audio::FrameFactory& frame_factory,
+                    core::IArena& arena);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Get wrapped reader.
+    audio::IFrameReader& inner_reader() const;
+
+    //! Read frame from wrapped reader and store it until next read().
+    //! @remarks
+    //!  Does nothing if there are samples or status remaining from
+    //!  previous prefetch.
+    void prefetch(packet::stream_timestamp_t duration, audio::FrameReadMode mode);
+
+    //! Read frame.
+    //! @remarks
+    //!  Returns prefetched samples, if any, otherwise reads from wrapped reader.
+    virtual ROC_NODISCARD status::StatusCode read(audio::Frame& frame,
+                                                  packet::stream_timestamp_t duration,
+                                                  audio::FrameReadMode mode);
+
+private:
+    audio::IFrameReader& reader_;
+    audio::FrameFactory& frame_factory_;
+
+    const audio::SampleSpec sample_spec_;
+
+    audio::FramePtr frame_;
+    size_t frame_pos_;
+    size_t frame_size_;
+
+    status::StatusCode pending_status_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_FRAME_PREFETCHER_H_
@@ -15,8 +15,10 @@
 #include "roc_audio/depacketizer.h"
 #include "roc_audio/latency_config.h"
 #include "roc_core/stddefs.h"
+#include "roc_fec/block_reader.h"
 #include "roc_packet/ilink_meter.h"
 #include "roc_packet/units.h"
+#include "roc_pipeline/stage_metrics.h"
 
 namespace roc {
 namespace pipeline {
@@ -44,10 +46,39 @@ struct SenderSlotMetrics {
     //! Is slot configuration complete (all endpoints bound).
     bool is_complete;
 
+    //! Number of slots sharing encoding pipeline with this slot,
+    //! including this slot itself. Zero if encoding is not shared.
+    size_t shared_encoding_slots;
+
+    //! Number of packet copies made for slots sharing encoding pipeline.
+    //! Every copy is a packet that was not encoded again.
+    size_t shared_packet_copies;
+
+    //! Number of source packets in FEC block.
+    //! Zero if FEC is not used.
+    size_t fec_source_packets;
+
+    //! Number of repair packets in FEC block.
+    //! Zero if FEC is not used.
+    size_t fec_repair_packets;
+
+    //! Ratio of repair packets to source packets in FEC block.
+    //! Changes over time if adaptive FEC is enabled.
+    float fec_repair_ratio;
+
+    //! Per-stage timing metrics, indexed by PipelineStage.
+    //! Filled only if stage profiling is enabled.
+    StageMetrics stages[Stage_Max];
+
     SenderSlotMetrics()
         : source_id(0)
         , num_participants(0)
-        , is_complete(false) {
+        , is_complete(false)
+        , shared_encoding_slots(0)
+        , shared_packet_copies(0)
+        , fec_source_packets(0)
+        , fec_repair_packets(0)
+        , fec_repair_ratio(0) {
     }
 };
 
@@ -62,6 +93,14 @@ struct ReceiverParticipantMetrics {
     //! Depacketizer metrics.
     audio::DepacketizerMetrics depacketizer;
 
+    //! FEC reader metrics.
+    //! Filled only if FEC is used.
+    fec::BlockReaderMetrics fec_reader;
+
+    //! Per-stage timing metrics, indexed by PipelineStage.
+    //! Filled only if stage profiling is enabled.
+    StageMetrics stages[Stage_Max];
+
     ReceiverParticipantMetrics() {
     }
 };
@@ -74,6 +113,11 @@ struct ReceiverSlotMetrics {
     //! Number of participants (remote senders) connected to slot.
     size_t num_participants;
 
+    //! Per-stage timing metrics of stages shared by all participants,
+    //! indexed by PipelineStage.
+    //! Filled only if stage profiling is enabled.
+    StageMetrics stages[Stage_Max];
+
     ReceiverSlotMetrics()
         : source_id(0)
         , num_participants(0) {
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/metrics_snapshot.h
+//! @brief Lock-free snapshot of slot metrics.
+
+#ifndef ROC_PIPELINE_METRICS_SNAPSHOT_H_
+#define ROC_PIPELINE_METRICS_SNAPSHOT_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_core/seqlock.h"
+#include "roc_core/stddefs.h"
+#include "roc_pipeline/metrics.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Lock-free snapshot of slot metrics.
+//!
+//! Pipeline thread periodically collects metrics of slot and its participants
+//! and publishes them via seqlock. Other threads can read the last published
+//! copy without scheduling a task and waiting for pipeline.
+//!
+//! Snapshot holds metrics of up to MaxParticipants participants. If slot
+//! has more participants and the caller asks for more, read() fails, and
+//! the caller should query metrics from pipeline thread instead.
+template <class SlotMetrics, class PartyMetrics>
+class MetricsSnapshot : public core::NonCopyable<> {
+public:
+    //! Limits.
+    enum {
+        //! Maximum number of participants stored in snapshot.
+        MaxParticipants = 8
+    };
+
+    //! Initialize.
+    MetricsSnapshot()
+        : seqlock_(Data()) {
+    }
+
+    //! Collect metrics from slot and publish them.
+    //! @remarks
+    //!  Slot should provide get_metrics() method like ReceiverSlot and
+    //!  SenderSlot. Should be called only from pipeline thread.
+    template <class Slot> void publish(const Slot& slot) {
+        scratch_.party_count = MaxParticipants;
+        slot.get_metrics(scratch_.slot, scratch_.parties, &scratch_.party_count);
+        scratch_.is_published = true;
+
+        seqlock_.exclusive_store(scratch_);
+    }
+
+    //! Read last published metrics.
+    //! @remarks
+    //!  Has the same semantics as get_metrics() of slot: @p party_count
+    //!  defines size of @p party_metrics array, and is updated to the
+    //!  number of returned participants. Can be called from any thread.
+    //!  Wait-free.
+    //! @returns
+    //!  false if nothing was published yet, if concurrent publish is in
+    //!  progress, or if snapshot doesn't have metrics of all requested
+    //!  participants. In this case output arguments are not modified.
+    bool read(SlotMetrics& slot_metrics,
+              PartyMetrics* party_metrics,
+              size_t* party_count) const {
+        Data data;
+        if (!seqlock_.try_load(data)) {
+            return false;
+        }
+
+        if (!data.is_published) {
+            return false;
+        }
+
+        if (party_metrics && party_count && *party_count > data.party_count
+            && data.slot.num_participants > data.party_count) {
+            return false;
+        }
+
+        slot_metrics = data.slot;
+
+        if (party_metrics && party_count) {
+            *party_count = std::min(*party_count, data.party_count);
+
+            for (size_t n = 0; n < *party_count; n++) {
+                party_metrics[n] = data.parties[n];
+            }
+        } else if (party_count) {
+            *party_count = 0;
+        }
+
+        return true;
+    }
+
+private:
+    struct Data {
+        SlotMetrics slot;
+        PartyMetrics parties[MaxParticipants];
+        size_t party_count;
+        bool is_published;
+
+        Data()
+            : party_count(0)
+            , is_published(false) {
+        }
+    };
+
+    core::Seqlock<Data> seqlock_;
+    Data scratch_;
+};
+
+//! Snapshot of receiver slot metrics.
+typedef MetricsSnapshot<ReceiverSlotMetrics, ReceiverParticipantMetrics>
+    ReceiverMetricsSnapshot;
+
+//! Snapshot of sender slot metrics.
+typedef MetricsSnapshot<SenderSlotMetrics, SenderParticipantMetrics>
+    SenderMetricsSnapshot;
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_METRICS_SNAPSHOT_H_
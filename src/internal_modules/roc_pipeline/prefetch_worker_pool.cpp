@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/prefetch_worker_pool.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+PrefetchWorkerPool::Worker::Worker(PrefetchWorkerPool& pool)
+    : pool_(pool) {
+}
+
+void PrefetchWorkerPool::Worker::run() {
+    pool_.worker_loop_();
+}
+
+PrefetchWorkerPool::PrefetchWorkerPool(size_t num_workers, core::IArena& arena)
+    : prefetchers_(arena)
+    , n_workers_(0)
+    , start_cond_(mutex_)
+    , done_cond_(mutex_)
+    , generation_(0)
+    , n_finished_workers_(0)
+    , stop_(false)
+    , job_duration_(0)
+    , job_mode_(audio::ModeHard)
+    , next_job_(0)
+    , init_status_(status::NoStatus) {
+    roc_log(LogDebug, "prefetch worker pool: initializing: num_workers=%lu",
+            (unsigned long)num_workers);
+
+    if (num_workers < 1 || num_workers > MaxWorkers) {
+        roc_log(LogError,
+                "prefetch worker pool: invalid number of workers: got=%lu"
+                " expected=[1; %lu]",
+                (unsigned long)num_workers, (unsigned long)MaxWorkers);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    for (; n_workers_ < num_workers; n_workers_++) {
+        core::Optional<Worker>& worker = workers_[n_workers_];
+
+        worker.reset(new (worker) Worker(*this));
+
+        if (!worker->start()) {
+            roc_log(LogError, "prefetch worker pool: can't start worker thread");
+            worker.reset();
+            init_status_ = status::StatusErrThread;
+            return;
+        }
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+PrefetchWorkerPool::~PrefetchWorkerPool() {
+    stop_workers_();
+}
+
+status::StatusCode PrefetchWorkerPool::init_status() const {
+    return init_status_;
+}
+
+size_t PrefetchWorkerPool::num_workers() const {
+    return n_workers_;
+}
+
+status::StatusCode PrefetchWorkerPool::add_prefetcher(FramePrefetcher& prefetcher) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (!prefetchers_.push_back(&prefetcher)) {
+        roc_log(LogError,
+                "prefetch worker pool: can't add prefetcher: allocation failed");
+        return status::StatusNoMem;
+    }
+
+    return status::StatusOK;
+}
+
+void PrefetchWorkerPool::remove_prefetcher(FramePrefetcher& prefetcher) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    for (size_t n = 0; n < prefetchers_.size(); n++) {
+        if (prefetchers_[n] != &prefetcher) {
+            continue;
+        }
+
+        for (size_t m = n + 1; m < prefetchers_.size(); m++) {
+            prefetchers_[m - 1] = prefetchers_[m];
+        }
+
+        if (!prefetchers_.resize(prefetchers_.size() - 1)) {
+            roc_panic("prefetch worker pool: can't remove prefetcher: resize failed");
+        }
+        return;
+    }
+
+    roc_panic("prefetch worker pool: can't remove prefetcher: prefetcher not found");
+}
+
+void PrefetchWorkerPool::prefetch(packet::stream_timestamp_t duration,
+                                  audio::FrameReadMode mode) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    // With only one prefetcher there is nothing to parallelize,
+    // and mixer will read session directly.
+    if (prefetchers_.size() < 2) {
+        return;
+    }
+
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        job_duration_ = duration;
+        job_mode_ = mode;
+        next_job_ = 0;
+
+        n_finished_workers_ = 0;
+        generation_++;
+
+        start_cond_.broadcast();
+    }
+
+    process_jobs_();
+
+    // Wait until every worker finishes current generation, so that none of them
+    // accesses prefetchers after we return.
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        while (n_finished_workers_ != n_workers_) {
+            done_cond_.wait();
+        }
+    }
+}
+
+void PrefetchWorkerPool::worker_loop_() {
+    uint64_t seen_generation = 0;
+
+    for (;;) {
+        {
+            core::Mutex::Lock lock(mutex_);
+
+            while (!stop_ && generation_ == seen_generation) {
+                start_cond_.wait();
+            }
+
+            if (stop_) {
+                return;
+            }
+
+            seen_generation = generation_;
+        }
+
+        process_jobs_();
+
+        {
+            core::Mutex::Lock lock(mutex_);
+
+            if (++n_finished_workers_ == n_workers_) {
+                done_cond_.signal();
+            }
+        }
+    }
+}
+
+void PrefetchWorkerPool::process_jobs_() {
+    const size_t n_jobs = prefetchers_.size();
+
+    for (;;) {
+        const size_t job = next_job_++;
+        if (job >= n_jobs) {
+            break;
+        }
+
+        prefetchers_[job]->prefetch(job_duration_, job_mode_);
+    }
+}
+
+void PrefetchWorkerPool::stop_workers_() {
+    {
+        core::Mutex::Lock lock(mutex_);
+
+        stop_ = true;
+        start_cond_.broadcast();
+    }
+
+    for (size_t n = 0; n < n_workers_; n++) {
+        if (workers_[n]->is_joinable()) {
+            workers_[n]->join();
+        }
+        workers_[n].reset();
+    }
+
+    n_workers_ = 0;
+}
+
+} // namespace pipeline
+} // namespace roc
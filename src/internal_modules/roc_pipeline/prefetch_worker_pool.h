@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/prefetch_worker_pool.h
+//! @brief Prefetch worker pool.
+
+#ifndef ROC_PIPELINE_PREFETCH_WORKER_POOL_H_
+#define ROC_PIPELINE_PREFETCH_WORKER_POOL_H_
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_core/array.h"
+#include "roc_core/atomic.h"
+#include "roc_core/attributes.h"
+#include "roc_core/cond.h"
+#include "roc_core/iarena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/thread.h"
+#include "roc_packet/units.h"
+#include "roc_pipeline/frame_prefetcher.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Prefetch worker pool.
+//!
+//! Holds a set of worker threads and a set of registered prefetchers.
+//! On every prefetch() call, distributes prefetchers between workers
+//! and calling thread, and waits until all of them are processed.
+//!
+//! Used by receiver to pull frames from multiple sessions in parallel
+//! before mixing them.
+//!
+//! All methods should be called from the same thread (pipeline thread).
+class PrefetchWorkerPool : public core::NonCopyable<> {
+public:
+    //! Limits.
+    enum {
+        //! Maximum number of worker threads.
+        MaxWorkers = 16
+    };
+
+    //! Initialize.
+    //! @remarks
+    //!  Starts @p num_workers threads. Calling thread participates in
+    //!  processing as well.
+    PrefetchWorkerPool(size_t num_workers, core::IArena& arena);
+
+    ~PrefetchWorkerPool();
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Get number of worker threads.
+    size_t num_workers() const;
+
+    //! Register prefetcher.
+    ROC_NODISCARD status::StatusCode add_prefetcher(FramePrefetcher& prefetcher);
+
+    //! Unregister prefetcher.
+    void remove_prefetcher(FramePrefetcher& prefetcher);
+
+    //! Invoke prefetch() on all registered prefetchers.
+    //! @remarks
+    //!  Blocks until all prefetchers are processed.
+    void prefetch(packet::stream_timestamp_t duration, audio::FrameReadMode mode);
+
+private:
+    class Worker : public core::Thread {
+    public:
+        Worker(PrefetchWorkerPool& pool);
+
+    private:
+        virtual void run();
+
+        PrefetchWorkerPool& pool_;
+    };
+
+    void worker_loop_();
+    void process_jobs_();
+    void stop_workers_();
+
+    core::Array<FramePrefetcher*, 8> prefetchers_;
+
+    core::Optional<Worker> workers_[MaxWorkers];
+    size_t n_workers_;
+
+    core::Mutex mutex_;
+    core::Cond start_cond_;
+    core::Cond done_cond_;
+
+    uint64_t generation_;
+    size_t n_finished_workers_;
+    bool stop_;
+
+    packet::stream_timestamp_t job_duration_;
+    audio::FrameReadMode job_mode_;
+    core::Atomic<size_t> next_job_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_PREFETCH_WORKER_POOL_H_
@@ -24,6 +24,7 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
                                    rtp::EncodingMap& encoding_map,
                                    const address::SocketAddr& inbound_address,
                                    packet::IWriter* outbound_writer,
+                                   dbgio::PacketCaptureWriter* capture_writer,
                                    core::IArena& arena)
     : core::RefCounted<ReceiverEndpoint, core::ArenaAllocation>(arena)
     , proto_(proto)
@@ -32,6 +33,7 @@ ReceiverEndpoint::ReceiverEndpoint(address::Protocol proto,
     , composer_(NULL)
     , parser_(NULL)
     , inbound_address_(inbound_address)
+    , capture_writer_(capture_writer)
     , init_status_(status::NoStatus) {
     packet::IComposer* composer = NULL;
     packet::IParser* parser = NULL;
@@ -193,7 +195,7 @@ const address::SocketAddr& ReceiverEndpoint::inbound_address() const {
     return inbound_address_;
 }
 
-packet::IWriter& ReceiverEndpoint::inbound_writer() {
+packet::IBatchWriter& ReceiverEndpoint::inbound_writer() {
     roc_panic_if(init_status_ != status::StatusOK);
 
     return *this;
@@ -204,17 +206,40 @@ status::StatusCode ReceiverEndpoint::pull_packets(core::nanoseconds_t current_ti
 
     roc_panic_if(!parser_);
 
-    // Using try_pop_front_exclusive() makes this method lock-free and wait-free.
-    // It may return NULL either if the queue is empty or if the packets in the
-    // queue were added in a very short time or are being added currently. It's
+    // Using try_pop_front_many_exclusive() makes this method lock-free and
+    // wait-free. It may return less packets than there are in the queue, if the
+    // packets were added in a very short time or are being added currently. It's
     // acceptable to consider such packets late and pull them next time.
-    while (packet::PacketPtr packet = inbound_queue_.try_pop_front_exclusive()) {
-        const status::StatusCode code = handle_packet_(packet, current_time);
-        state_tracker_.unregister_packet();
+    packet::PacketPtr packets[MaxPullBatch];
+
+    for (;;) {
+        const size_t n_packets =
+            inbound_queue_.try_pop_front_many_exclusive(packets, MaxPullBatch);
+        if (n_packets == 0) {
+            break;
+        }
+
+        status::StatusCode code = status::StatusOK;
+
+        // Packets are already removed from queue, so if one of them fails,
+        // we still handle the rest of the batch and report first error.
+        for (size_t n = 0; n < n_packets; n++) {
+            const status::StatusCode pkt_code = handle_packet_(packets[n], current_time);
+            if (code == status::StatusOK) {
+                code = pkt_code;
+            }
+            packets[n] = NULL;
+        }
+
+        state_tracker_.unregister_packets(n_packets);
 
         if (code != status::StatusOK) {
             return code;
         }
+
+        if (n_packets < MaxPullBatch) {
+            break;
+        }
     }
 
     return status::StatusOK;
@@ -224,6 +249,11 @@ status::StatusCode ReceiverEndpoint::handle_packet_(const packet::PacketPtr& pac
                                                     core::nanoseconds_t current_time) {
     status::StatusCode code = status::NoStatus;
 
+    if (capture_writer_) {
+        // Capture packet before parsing, as it was received from network.
+        capture_writer_->write(packet, proto_);
+    }
+
     if ((code = parser_->parse(*packet, packet->buffer())) != status::StatusOK) {
         roc_log(LogDebug,
                 "receiver endpoint: dropping bad packet: can't parse: status=%s",
@@ -254,11 +284,33 @@ status::StatusCode ReceiverEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!packet);
     roc_panic_if(!parser_);
 
-    state_tracker_.register_packet();
+    state_tracker_.register_packets(1);
     inbound_queue_.push_back(*packet);
 
     return status::StatusOK;
 }
 
+// Implementation of inbound_writer().write_batch()
+status::StatusCode ReceiverEndpoint::write_batch(const packet::PacketPtr* packets,
+                                                 size_t n_packets) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    roc_panic_if(!packets);
+    roc_panic_if(!parser_);
+
+    if (n_packets == 0) {
+        return status::StatusOK;
+    }
+
+    for (size_t n = 0; n < n_packets; n++) {
+        roc_panic_if(!packets[n]);
+    }
+
+    state_tracker_.register_packets(n_packets);
+    inbound_queue_.push_back_many(packets, n_packets);
+
+    return status::StatusOK;
+}
+
 } // namespace pipeline
 } // namespace roc
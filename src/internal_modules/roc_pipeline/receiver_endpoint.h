@@ -19,6 +19,8 @@
 #include "roc_core/optional.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/scoped_ptr.h"
+#include "roc_dbgio/packet_capture_writer.h"
+#include "roc_packet/ibatch_writer.h"
 #include "roc_packet/iparser.h"
 #include "roc_packet/iwriter.h"
 #include "roc_packet/shipper.h"
@@ -41,7 +43,7 @@ class ReceiverSessionGroup;
 //!  - a reference to session group to which packets are routed
 class ReceiverEndpoint : public core::RefCounted<ReceiverEndpoint, core::ArenaAllocation>,
                          public core::ListNode<>,
-                         private packet::IWriter {
+                         private packet::IBatchWriter {
 public:
     //! Initialize.
     ReceiverEndpoint(address::Protocol proto,
@@ -50,6 +52,7 @@ public:
                      rtp::EncodingMap& encoding_map,
                      const address::SocketAddr& inbound_address,
                      packet::IWriter* outbound_writer,
+                     dbgio::PacketCaptureWriter* capture_writer,
                      core::IArena& arena);
 
     //! Check if the pipeline was successfully constructed.
@@ -86,17 +89,28 @@ public:
     //!  Packets passed to this writer will be pulled into pipeline.
     //!  This writer is thread-safe and lock-free, packets can be written
     //!  to it from netio thread.
-    packet::IWriter& inbound_writer();
+    //! @note
+    //!  Netio thread can use write_batch() to pass all packets received
+    //!  during one wakeup, which hands them over to pipeline thread at once.
+    packet::IBatchWriter& inbound_writer();
 
     //! Pull packets written to inbound writer into pipeline.
     //! @remarks
     //!  Packets are written to inbound_writer() from network thread.
     //!  They don't appear in pipeline immediately. Instead, pipeline thread
     //!  should periodically call pull_packets() to make them available.
+    //! @note
+    //!  Packets are pulled in batches. If handling of a packet fails, the rest
+    //!  of the batch is still handled, and the first error is returned.
     ROC_NODISCARD status::StatusCode pull_packets(core::nanoseconds_t current_time);
 
 private:
+    // Max number of packets pulled from inbound queue at once.
+    enum { MaxPullBatch = 32 };
+
     virtual ROC_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+    virtual ROC_NODISCARD status::StatusCode write_batch(const packet::PacketPtr* packets,
+                                                         size_t n_packets);
 
     status::StatusCode handle_packet_(const packet::PacketPtr& packet,
                                       core::nanoseconds_t current_time);
@@ -121,6 +135,8 @@ private:
     address::SocketAddr inbound_address_;
     core::MpscQueue<packet::Packet> inbound_queue_;
 
+    dbgio::PacketCaptureWriter* capture_writer_;
+
     status::StatusCode init_status_;
 };
 
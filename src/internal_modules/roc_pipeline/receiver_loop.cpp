@@ -78,7 +78,7 @@ ReceiverLoop::Tasks::AddEndpoint::AddEndpoint(SlotHandle slot,
     outbound_writer_ = outbound_writer;
 }
 
-packet::IWriter* ReceiverLoop::Tasks::AddEndpoint::get_inbound_writer() const {
+packet::IBatchWriter* ReceiverLoop::Tasks::AddEndpoint::get_inbound_writer() const {
     if (!success()) {
         return NULL;
     }
@@ -137,6 +137,19 @@ sndio::ISource& ReceiverLoop::source() {
     return *this;
 }
 
+bool ReceiverLoop::read_slot_metrics(SlotHandle slot,
+                                     ReceiverSlotMetrics& slot_metrics,
+                                     ReceiverParticipantMetrics* party_metrics,
+                                     size_t* party_count) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (!slot) {
+        roc_panic("receiver loop: slot handle is null");
+    }
+
+    return ((ReceiverSlot*)slot)->read_metrics(slot_metrics, party_metrics, party_count);
+}
+
 sndio::DeviceType ReceiverLoop::type() const {
     core::Mutex::Lock lock(source_mutex_);
 
@@ -17,6 +17,7 @@
 #include "roc_core/mutex.h"
 #include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
+#include "roc_packet/ibatch_writer.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
 #include "roc_pipeline/pipeline_loop.h"
@@ -62,7 +63,7 @@ public:
         address::Interface iface_;                  //!< Interface.
         address::Protocol proto_;                   //!< Protocol.
         address::SocketAddr inbound_address_;       //!< Inbound packet address.
-        packet::IWriter* inbound_writer_;           //!< Inbound packet writer.
+        packet::IBatchWriter* inbound_writer_;      //!< Inbound packet writer.
         packet::IWriter* outbound_writer_;          //!< Outbound packet writer.
         ReceiverSlotMetrics* slot_metrics_;         //!< Output slot metrics.
         ReceiverParticipantMetrics* party_metrics_; //!< Output participant metrics.
@@ -117,7 +118,7 @@ public:
             //! Get packet writer for inbound packets for the endpoint.
             //! @remarks
             //!  The returned writer may be used from any thread.
-            packet::IWriter* get_inbound_writer() const;
+            packet::IBatchWriter* get_inbound_writer() const;
         };
     };
 
@@ -141,6 +142,19 @@ public:
     //!  Samples received from remote peers become available in this source.
     sndio::ISource& source();
 
+    //! Read slot metrics from last published snapshot.
+    //! @remarks
+    //!  Doesn't schedule a task and doesn't wait for pipeline thread.
+    //!  Can be called from any thread, while slot is not deleted.
+    //!  Requires enable_metrics_snapshots in config.
+    //! @returns
+    //!  false if snapshot is not available; QuerySlot task should be
+    //!  used in this case.
+    bool read_slot_metrics(SlotHandle slot,
+                           ReceiverSlotMetrics& slot_metrics,
+                           ReceiverParticipantMetrics* party_metrics,
+                           size_t* party_count);
+
 private:
     // Methods of sndio::ISource
     virtual sndio::DeviceType type() const;
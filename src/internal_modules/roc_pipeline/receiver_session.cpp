@@ -21,10 +21,12 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                                  packet::PacketFactory& packet_factory,
                                  audio::FrameFactory& frame_factory,
                                  core::IArena& arena,
-                                 dbgio::CsvDumper* dumper)
+                                 dbgio::CsvDumper* dumper,
+                                 StageProfiler* parent_profiler)
     : core::RefCounted<ReceiverSession, core::ArenaAllocation>(arena)
     , frame_reader_(NULL)
     , dumper_(dumper)
+    , enable_virtual_clock_(common_config.enable_virtual_clock)
     , init_status_(status::NoStatus)
     , fail_status_(status::NoStatus) {
     const rtp::Encoding* pkt_encoding =
@@ -37,6 +39,14 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         return;
     }
 
+    if (common_config.enable_stage_profiling) {
+        stage_profiler_.reset(new (stage_profiler_) StageProfiler(
+            common_config.stage_profiler, parent_profiler, arena));
+        if ((init_status_ = stage_profiler_->init_status()) != status::StatusOK) {
+            return;
+        }
+    }
+
     packet_router_.reset(new (packet_router_) packet::Router(arena));
     if ((init_status_ = packet_router_->init_status()) != status::StatusOK) {
         return;
@@ -47,7 +57,8 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
     // packets in the queues.
     packet::IWriter* pkt_writer = NULL;
 
-    source_queue_.reset(new (source_queue_) packet::SortedQueue(0));
+    source_queue_.reset(new (source_queue_) packet::SortedQueue(
+        0, packet::DefaultSortedQueueWindow, arena));
     if ((init_status_ = source_queue_->init_status()) != status::StatusOK) {
         return;
     }
@@ -146,6 +157,15 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         }
         pkt_reader = fec_reader_.get();
 
+        if (stage_profiler_) {
+            fec_stage_reader_.reset(new (fec_stage_reader_) StagePacketReader(
+                *pkt_reader, *stage_profiler_, Stage_FecDecoder));
+            if ((init_status_ = fec_stage_reader_->init_status()) != status::StatusOK) {
+                return;
+            }
+            pkt_reader = fec_stage_reader_.get();
+        }
+
         fec_filter_.reset(new (fec_filter_) rtp::Filter(*pkt_reader, *payload_decoder_,
                                                         common_config.rtp_filter,
                                                         pkt_encoding->sample_spec));
@@ -179,9 +199,31 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
         }
         frm_reader = depacketizer_.get();
 
-        if (session_config.plc.backend != audio::PlcBackend_None) {
-            plc_.reset(processor_map.new_plc(session_config.plc, out_spec, frame_factory,
-                                             arena));
+        if ((init_status_ = profile_stage_(frm_reader, Stage_Depacketizer))
+            != status::StatusOK) {
+            return;
+        }
+
+        // By default, codec PLC is used if encoding provides it, and PLC
+        // is disabled otherwise.
+        audio::PlcConfig plc_config = session_config.plc;
+        if (!plc_config.deduce_defaults(pkt_encoding->new_plc != NULL)) {
+            init_status_ = status::StatusBadConfig;
+            return;
+        }
+
+        // Codec PLC is used only if encoding provides it, otherwise losses
+        // are not concealed.
+        const bool use_codec_plc = plc_config.backend == audio::PlcBackend_Codec;
+
+        if (use_codec_plc ? pkt_encoding->new_plc != NULL
+                          : plc_config.backend != audio::PlcBackend_None) {
+            if (use_codec_plc) {
+                plc_.reset(pkt_encoding->new_plc(*payload_decoder_, out_spec, arena));
+            } else {
+                plc_.reset(
+                    processor_map.new_plc(plc_config, out_spec, frame_factory, arena));
+            }
             if (!plc_) {
                 init_status_ = status::StatusNoMem;
                 return;
@@ -196,6 +238,11 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                 return;
             }
             frm_reader = plc_reader_.get();
+
+            if ((init_status_ = profile_stage_(frm_reader, Stage_Plc))
+                != status::StatusOK) {
+                return;
+            }
         }
 
         if (session_config.watchdog.no_playback_timeout >= 0
@@ -206,6 +253,11 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
                 return;
             }
             frm_reader = watchdog_.get();
+
+            if ((init_status_ = profile_stage_(frm_reader, Stage_Watchdog))
+                != status::StatusOK) {
+                return;
+            }
         }
     }
 
@@ -226,6 +278,11 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
         frm_reader = channel_mapper_reader_.get();
+
+        if ((init_status_ = profile_stage_(frm_reader, Stage_ChannelMapper))
+            != status::StatusOK) {
+            return;
+        }
     }
 
     if (session_config.latency.tuner_profile != audio::LatencyTunerProfile_Intact
@@ -255,6 +312,11 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
         frm_reader = resampler_reader_.get();
+
+        if ((init_status_ = profile_stage_(frm_reader, Stage_Resampler))
+            != status::StatusOK) {
+            return;
+        }
     }
 
     {
@@ -270,6 +332,11 @@ ReceiverSession::ReceiverSession(const ReceiverSessionConfig& session_config,
             return;
         }
         frm_reader = latency_monitor_.get();
+
+        if ((init_status_ = profile_stage_(frm_reader, Stage_LatencyMonitor))
+            != status::StatusOK) {
+            return;
+        }
     }
 
     // Top-level frame reader that is added to mixer.
@@ -296,6 +363,12 @@ status::StatusCode ReceiverSession::refresh(core::nanoseconds_t current_time,
         return fail_status_;
     }
 
+    if (enable_virtual_clock_) {
+        // Otherwise latency monitor uses system clock at the moment of reading
+        // frame, which is more precise than time of last refresh.
+        latency_monitor_->refresh(current_time);
+    }
+
     return status::StatusOK;
 }
 
@@ -344,6 +417,24 @@ status::StatusCode ReceiverSession::read(audio::Frame& frame,
     return code;
 }
 
+status::StatusCode ReceiverSession::profile_stage_(audio::IFrameReader*& frm_reader,
+                                                   PipelineStage stage) {
+    if (!stage_profiler_) {
+        return status::StatusOK;
+    }
+
+    stage_readers_[stage].reset(new (stage_readers_[stage]) StageFrameReader(
+        *frm_reader, *stage_profiler_, stage));
+
+    const status::StatusCode code = stage_readers_[stage]->init_status();
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    frm_reader = stage_readers_[stage].get();
+    return status::StatusOK;
+}
+
 size_t ReceiverSession::num_reports() const {
     roc_panic_if(init_status_ != status::StatusOK);
 
@@ -439,6 +530,16 @@ ReceiverParticipantMetrics ReceiverSession::get_metrics() const {
     metrics.latency = latency_monitor_->metrics();
     metrics.depacketizer = depacketizer_->metrics();
 
+    if (fec_reader_) {
+        metrics.fec_reader = fec_reader_->metrics();
+    }
+
+    if (stage_profiler_) {
+        for (size_t n = 0; n < Stage_Max; n++) {
+            metrics.stages[n] = stage_profiler_->get_metrics((PipelineStage)n);
+        }
+    }
+
     return metrics;
 }
 
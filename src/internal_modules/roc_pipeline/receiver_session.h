@@ -44,6 +44,8 @@
 #include "roc_packet/units.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_pipeline/stage_reader.h"
 #include "roc_rtcp/reports.h"
 #include "roc_rtp/encoding_map.h"
 #include "roc_rtp/filter.h"
@@ -64,6 +66,9 @@ class ReceiverSession : public core::RefCounted<ReceiverSession, core::ArenaAllo
                         private audio::IFrameReader {
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p parent_profiler is optional; if stage profiling is enabled, it is
+    //!  notified about time spent in session, to exclude it from enclosing stage.
     ReceiverSession(const ReceiverSessionConfig& session_config,
                     const ReceiverCommonConfig& common_config,
                     audio::ProcessorMap& processor_map,
@@ -71,7 +76,8 @@ public:
                     packet::PacketFactory& packet_factory,
                     audio::FrameFactory& frame_factory,
                     core::IArena& arena,
-                    dbgio::CsvDumper* dumper);
+                    dbgio::CsvDumper* dumper,
+                    StageProfiler* parent_profiler);
 
     //! Check if the pipeline was successfully constructed.
     status::StatusCode init_status() const;
@@ -126,6 +132,9 @@ private:
                                     packet::stream_timestamp_t duration,
                                     audio::FrameReadMode mode);
 
+    status::StatusCode profile_stage_(audio::IFrameReader*& frm_reader,
+                                      PipelineStage stage);
+
     audio::IFrameReader* frame_reader_;
 
     core::Optional<packet::Router> packet_router_;
@@ -158,8 +167,14 @@ private:
 
     core::Optional<audio::LatencyMonitor> latency_monitor_;
 
+    core::Optional<StageProfiler> stage_profiler_;
+    core::Optional<StagePacketReader> fec_stage_reader_;
+    core::Optional<StageFrameReader> stage_readers_[Stage_Max];
+
     dbgio::CsvDumper* dumper_;
 
+    const bool enable_virtual_clock_;
+
     status::StatusCode init_status_;
     status::StatusCode fail_status_;
 };
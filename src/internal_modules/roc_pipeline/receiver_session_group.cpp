@@ -24,7 +24,9 @@ ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_co
                                            packet::PacketFactory& packet_factory,
                                            audio::FrameFactory& frame_factory,
                                            core::IArena& arena,
-                                           dbgio::CsvDumper* dumper)
+                                           dbgio::CsvDumper* dumper,
+                                           StageProfiler* stage_profiler,
+                                           PrefetchWorkerPool* worker_pool)
     : source_config_(source_config)
     , slot_config_(slot_config)
     , state_tracker_(state_tracker)
@@ -36,6 +38,8 @@ ReceiverSessionGroup::ReceiverSessionGroup(const ReceiverSourceConfig& source_co
     , frame_factory_(frame_factory)
     , session_router_(arena)
     , dumper_(dumper)
+    , stage_profiler_(stage_profiler)
+    , worker_pool_(worker_pool)
     , init_status_(status::NoStatus) {
     identity_.reset(new (identity_) rtp::Identity());
     if ((init_status_ = identity_->init_status()) != status::StatusOK) {
@@ -162,6 +166,12 @@ void ReceiverSessionGroup::get_slot_metrics(ReceiverSlotMetrics& slot_metrics) c
 
     slot_metrics.source_id = identity_->ssrc();
     slot_metrics.num_participants = sessions_.size();
+
+    if (stage_profiler_) {
+        for (size_t n = 0; n < Stage_Max; n++) {
+            slot_metrics.stages[n] = stage_profiler_->get_metrics((PipelineStage)n);
+        }
+    }
 }
 
 void ReceiverSessionGroup::get_participant_metrics(
@@ -391,7 +401,8 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
 
     core::SharedPtr<ReceiverSession> sess = new (arena_)
         ReceiverSession(sess_config, source_config_.common, processor_map_, encoding_map_,
-                        packet_factory_, frame_factory_, arena_, dumper_);
+                        packet_factory_, frame_factory_, arena_, dumper_,
+                        stage_profiler_);
 
     if (!sess) {
         roc_log(LogError, "session group: can't create session, allocation failed");
@@ -422,7 +433,7 @@ ReceiverSessionGroup::create_session_(const packet::PacketPtr& packet) {
         return code;
     }
 
-    code = mixer_.add_input(sess->frame_reader());
+    code = add_mixer_input_(sess);
     if (code != status::StatusOK) {
         roc_log(LogError,
                 "session group: can't create session, can't add input: status=%s",
@@ -446,13 +457,73 @@ void ReceiverSessionGroup::remove_session_(core::SharedPtr<ReceiverSession> sess
         roc_log(LogInfo, "session group: removing session");
     }
 
-    mixer_.remove_input(sess->frame_reader());
+    remove_mixer_input_(sess);
     sessions_.remove(*sess);
 
     session_router_.remove_session(sess);
     state_tracker_.unregister_session();
 }
 
+status::StatusCode
+ReceiverSessionGroup::add_mixer_input_(const core::SharedPtr<ReceiverSession>& sess) {
+    if (!worker_pool_) {
+        return mixer_.add_input(sess->frame_reader());
+    }
+
+    // Mixer reads session via prefetcher, which is filled by worker pool
+    // before mixer starts reading.
+    const audio::SampleSpec prefetch_spec(
+        source_config_.common.output_sample_spec.sample_rate(), audio::PcmSubformat_Raw,
+        source_config_.common.output_sample_spec.channel_set());
+
+    core::SharedPtr<FramePrefetcher> prefetcher = new (arena_)
+        FramePrefetcher(sess->frame_reader(), prefetch_spec, frame_factory_, arena_);
+
+    if (!prefetcher) {
+        return status::StatusNoMem;
+    }
+
+    status::StatusCode code = prefetcher->init_status();
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    if ((code = mixer_.add_input(*prefetcher)) != status::StatusOK) {
+        return code;
+    }
+
+    if ((code = worker_pool_->add_prefetcher(*prefetcher)) != status::StatusOK) {
+        mixer_.remove_input(*prefetcher);
+        return code;
+    }
+
+    prefetchers_.push_back(*prefetcher);
+
+    return status::StatusOK;
+}
+
+void ReceiverSessionGroup::remove_mixer_input_(
+    const core::SharedPtr<ReceiverSession>& sess) {
+    if (!worker_pool_) {
+        mixer_.remove_input(sess->frame_reader());
+        return;
+    }
+
+    for (core::SharedPtr<FramePrefetcher> prefetcher = prefetchers_.front(); prefetcher;
+         prefetcher = prefetchers_.nextof(*prefetcher)) {
+        if (&prefetcher->inner_reader() != &sess->frame_reader()) {
+            continue;
+        }
+
+        worker_pool_->remove_prefetcher(*prefetcher);
+        mixer_.remove_input(*prefetcher);
+        prefetchers_.remove(*prefetcher);
+        return;
+    }
+
+    roc_panic("session group: can't remove session: prefetcher not found");
+}
+
 void ReceiverSessionGroup::remove_all_sessions_() {
     roc_log(LogDebug, "session group: removing all sessions");
 
@@ -20,10 +20,13 @@
 #include "roc_core/noncopyable.h"
 #include "roc_dbgio/csv_dumper.h"
 #include "roc_packet/packet_factory.h"
+#include "roc_pipeline/frame_prefetcher.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/prefetch_worker_pool.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session.h"
 #include "roc_pipeline/receiver_session_router.h"
+#include "roc_pipeline/stage_profiler.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtcp/communicator.h"
 #include "roc_rtcp/composer.h"
@@ -47,9 +50,14 @@ namespace pipeline {
 //!
 //! It also exchanges control information with remote senders using rtcp::Communicator
 //! and updates routing based on that control information.
+//!
+//! If worker pool is provided, every session is wrapped into FramePrefetcher,
+//! registered in the pool, so that sessions can be read in parallel before mixing.
 class ReceiverSessionGroup : public core::NonCopyable<>, private rtcp::IParticipant {
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p worker_pool is optional.
     ReceiverSessionGroup(const ReceiverSourceConfig& source_config,
                          const ReceiverSlotConfig& slot_config,
                          StateTracker& state_tracker,
@@ -59,7 +67,9 @@ public:
                          packet::PacketFactory& packet_factory,
                          audio::FrameFactory& frame_factory,
                          core::IArena& arena,
-                         dbgio::CsvDumper* dumper);
+                         dbgio::CsvDumper* dumper,
+                         StageProfiler* stage_profiler,
+                         PrefetchWorkerPool* worker_pool);
 
     ~ReceiverSessionGroup();
 
@@ -135,6 +145,8 @@ private:
     bool can_create_session_(const packet::PacketPtr& packet);
 
     status::StatusCode create_session_(const packet::PacketPtr& packet);
+    status::StatusCode add_mixer_input_(const core::SharedPtr<ReceiverSession>& sess);
+    void remove_mixer_input_(const core::SharedPtr<ReceiverSession>& sess);
     void remove_session_(core::SharedPtr<ReceiverSession> sess, status::StatusCode code);
     void remove_all_sessions_();
 
@@ -163,7 +175,14 @@ private:
             sessions_;
     ReceiverSessionRouter session_router_;
 
+    core::List<FramePrefetcher,
+               core::RefCountedOwnership,
+               core::ListNode<FramePrefetcher> >
+        prefetchers_;
+
     dbgio::CsvDumper* dumper_;
+    StageProfiler* stage_profiler_;
+    PrefetchWorkerPool* worker_pool_;
 
     status::StatusCode init_status_;
 };
@@ -22,9 +22,13 @@ ReceiverSlot::ReceiverSlot(const ReceiverSourceConfig& source_config,
                            packet::PacketFactory& packet_factory,
                            audio::FrameFactory& frame_factory,
                            core::IArena& arena,
-                           dbgio::CsvDumper* dumper)
+                           dbgio::CsvDumper* dumper,
+                           dbgio::PacketCaptureWriter* capture_writer,
+                           StageProfiler* stage_profiler,
+                           PrefetchWorkerPool* worker_pool)
     : core::RefCounted<ReceiverSlot, core::ArenaAllocation>(arena)
     , encoding_map_(encoding_map)
+    , capture_writer_(capture_writer)
     , state_tracker_(state_tracker)
     , session_group_(source_config,
                      slot_config,
@@ -35,7 +39,9 @@ ReceiverSlot::ReceiverSlot(const ReceiverSourceConfig& source_config,
                      packet_factory,
                      frame_factory,
                      arena,
-                     dumper)
+                     dumper,
+                     stage_profiler,
+                     worker_pool)
     , init_status_(status::NoStatus) {
     roc_log(LogDebug, "receiver slot: initializing");
 
@@ -133,6 +139,20 @@ void ReceiverSlot::get_metrics(ReceiverSlotMetrics& slot_metrics,
     }
 }
 
+void ReceiverSlot::publish_metrics() {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    metrics_snapshot_.publish(*this);
+}
+
+bool ReceiverSlot::read_metrics(ReceiverSlotMetrics& slot_metrics,
+                                ReceiverParticipantMetrics* party_metrics,
+                                size_t* party_count) const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return metrics_snapshot_.read(slot_metrics, party_metrics, party_count);
+}
+
 ReceiverEndpoint*
 ReceiverSlot::create_source_endpoint_(address::Protocol proto,
                                       const address::SocketAddr& inbound_address,
@@ -154,7 +174,7 @@ ReceiverSlot::create_source_endpoint_(address::Protocol proto,
 
     source_endpoint_.reset(new (source_endpoint_) ReceiverEndpoint(
         proto, state_tracker_, session_group_, encoding_map_, inbound_address,
-        outbound_writer, arena()));
+        outbound_writer, capture_writer_, arena()));
 
     if (!source_endpoint_ || source_endpoint_->init_status() != status::StatusOK) {
         // TODO(gh-183): forward status (control ops)
@@ -187,7 +207,7 @@ ReceiverSlot::create_repair_endpoint_(address::Protocol proto,
 
     repair_endpoint_.reset(new (repair_endpoint_) ReceiverEndpoint(
         proto, state_tracker_, session_group_, encoding_map_, inbound_address,
-        outbound_writer, arena()));
+        outbound_writer, capture_writer_, arena()));
 
     if (!repair_endpoint_ || repair_endpoint_->init_status() != status::StatusOK) {
         // TODO(gh-183): forward status (control ops)
@@ -214,7 +234,7 @@ ReceiverSlot::create_control_endpoint_(address::Protocol proto,
 
     control_endpoint_.reset(new (control_endpoint_) ReceiverEndpoint(
         proto, state_tracker_, session_group_, encoding_map_, inbound_address,
-        outbound_writer, arena()));
+        outbound_writer, capture_writer_, arena()));
 
     if (!control_endpoint_ || control_endpoint_->init_status() != status::StatusOK) {
         // TODO(gh-183): forward status (control ops)
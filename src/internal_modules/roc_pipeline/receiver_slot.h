@@ -21,10 +21,13 @@
 #include "roc_core/list_node.h"
 #include "roc_core/ref_counted.h"
 #include "roc_dbgio/csv_dumper.h"
+#include "roc_dbgio/packet_capture_writer.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/metrics_snapshot.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session_group.h"
+#include "roc_pipeline/stage_profiler.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtp/encoding_map.h"
 
@@ -49,7 +52,10 @@ public:
                  packet::PacketFactory& packet_factory,
                  audio::FrameFactory& frame_factory,
                  core::IArena& arena,
-                 dbgio::CsvDumper* dumper);
+                 dbgio::CsvDumper* dumper,
+                 dbgio::PacketCaptureWriter* capture_writer,
+                 StageProfiler* stage_profiler,
+                 PrefetchWorkerPool* worker_pool);
 
     //! Check if the pipeline was successfully constructed.
     status::StatusCode init_status() const;
@@ -82,6 +88,21 @@ public:
                      ReceiverParticipantMetrics* party_metrics,
                      size_t* party_count) const;
 
+    //! Publish snapshot of slot metrics.
+    //! @remarks
+    //!  Invoked periodically by pipeline if metrics snapshots are enabled.
+    void publish_metrics();
+
+    //! Get metrics from last published snapshot.
+    //! @remarks
+    //!  Unlike get_metrics(), can be called from any thread.
+    //! @returns
+    //!  false if snapshot is not available; get_metrics() should be
+    //!  called from pipeline thread in this case.
+    bool read_metrics(ReceiverSlotMetrics& slot_metrics,
+                      ReceiverParticipantMetrics* party_metrics,
+                      size_t* party_count) const;
+
 private:
     ReceiverEndpoint* create_source_endpoint_(address::Protocol proto,
                                               const address::SocketAddr& inbound_address,
@@ -94,6 +115,7 @@ private:
                                                packet::IWriter* outbound_writer);
 
     rtp::EncodingMap& encoding_map_;
+    dbgio::PacketCaptureWriter* capture_writer_;
 
     StateTracker& state_tracker_;
     ReceiverSessionGroup session_group_;
@@ -102,6 +124,8 @@ private:
     core::Optional<ReceiverEndpoint> repair_endpoint_;
     core::Optional<ReceiverEndpoint> control_endpoint_;
 
+    ReceiverMetricsSnapshot metrics_snapshot_;
+
     status::StatusCode init_status_;
 };
 
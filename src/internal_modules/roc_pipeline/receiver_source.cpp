@@ -31,12 +31,22 @@ ReceiverSource::ReceiverSource(const ReceiverSourceConfig& source_config,
     , frame_factory_(frame_pool, frame_buffer_pool)
     , arena_(arena)
     , frame_reader_(NULL)
+    , metrics_interval_(0)
+    , metrics_elapsed_(0)
     , init_status_(status::NoStatus) {
     if (!source_config_.deduce_defaults(processor_map)) {
         init_status_ = status::StatusBadConfig;
         return;
     }
 
+    if (source_config_.common.metrics_snapshot_interval > 0) {
+        metrics_interval_ =
+            source_config_.common.output_sample_spec.ns_2_stream_timestamp(
+                source_config_.common.metrics_snapshot_interval);
+    }
+    // publish first snapshot after first frame
+    metrics_elapsed_ = metrics_interval_;
+
     if (source_config.common.dumper.dump_file) {
         dumper_.reset(new (dumper_) dbgio::CsvDumper(source_config.common.dumper, arena));
         if ((init_status_ = dumper_->open()) != status::StatusOK) {
@@ -44,6 +54,14 @@ ReceiverSource::ReceiverSource(const ReceiverSourceConfig& source_config,
         }
     }
 
+    if (source_config.common.capture.capture_file) {
+        capture_writer_.reset(new (capture_writer_) dbgio::PacketCaptureWriter(
+            source_config.common.capture, arena));
+        if ((init_status_ = capture_writer_->open()) != status::StatusOK) {
+            return;
+        }
+    }
+
     audio::IFrameReader* frm_reader = NULL;
 
     {
@@ -57,6 +75,29 @@ ReceiverSource::ReceiverSource(const ReceiverSourceConfig& source_config,
             return;
         }
         frm_reader = mixer_.get();
+
+        if (source_config_.num_session_workers != 0) {
+            worker_pool_.reset(new (worker_pool_) PrefetchWorkerPool(
+                source_config_.num_session_workers, arena));
+            if ((init_status_ = worker_pool_->init_status()) != status::StatusOK) {
+                return;
+            }
+        }
+
+        if (source_config_.common.enable_stage_profiling) {
+            stage_profiler_.reset(new (stage_profiler_) StageProfiler(
+                source_config_.common.stage_profiler, NULL, arena));
+            if ((init_status_ = stage_profiler_->init_status()) != status::StatusOK) {
+                return;
+            }
+
+            mixer_stage_.reset(new (mixer_stage_) StageFrameReader(
+                *frm_reader, *stage_profiler_, Stage_Mixer));
+            if ((init_status_ = mixer_stage_->init_status()) != status::StatusOK) {
+                return;
+            }
+            frm_reader = mixer_stage_.get();
+        }
     }
 
     if (!source_config_.common.output_sample_spec.is_raw()) {
@@ -92,6 +133,9 @@ ReceiverSource::~ReceiverSource() {
     if (dumper_) {
         dumper_->close();
     }
+    if (capture_writer_) {
+        capture_writer_->close();
+    }
 }
 
 status::StatusCode ReceiverSource::init_status() const {
@@ -110,7 +154,8 @@ ReceiverSlot* ReceiverSource::create_slot(const ReceiverSlotConfig& slot_config)
 
     core::SharedPtr<ReceiverSlot> slot = new (arena_) ReceiverSlot(
         source_config_, slot_config, state_tracker_, *mixer_, processor_map_,
-        encoding_map_, packet_factory_, frame_factory_, arena_, dumper_.get());
+        encoding_map_, packet_factory_, frame_factory_, arena_, dumper_.get(),
+        capture_writer_.get(), stage_profiler_.get(), worker_pool_.get());
 
     if (!slot) {
         roc_log(LogError, "receiver source: can't create slot, allocation failed");
@@ -270,6 +315,12 @@ status::StatusCode ReceiverSource::read(audio::Frame& frame,
         return status::StatusBadState;
     }
 
+    if (worker_pool_) {
+        // Pull sessions of all slots in parallel. Then mixer will
+        // get prefetched frames without invoking session pipelines.
+        worker_pool_->prefetch(duration, mode);
+    }
+
     const status::StatusCode code = frame_reader_->read(frame, duration, mode);
 
     if (code != status::StatusOK && code != status::StatusPart
@@ -279,6 +330,10 @@ status::StatusCode ReceiverSource::read(audio::Frame& frame,
         state_tracker_.set_broken();
     }
 
+    if (source_config_.common.enable_metrics_snapshots) {
+        publish_metrics_(frame.duration());
+    }
+
     return code;
 }
 
@@ -298,5 +353,20 @@ void ReceiverSource::dispose() {
     arena_.dispose_object(*this);
 }
 
+void ReceiverSource::publish_metrics_(packet::stream_timestamp_t duration) {
+    // Collecting metrics of all sessions on every frame would be too
+    // expensive, so snapshot is published once per interval.
+    metrics_elapsed_ += duration;
+    if (metrics_elapsed_ < metrics_interval_) {
+        return;
+    }
+    metrics_elapsed_ = 0;
+
+    for (core::SharedPtr<ReceiverSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        slot->publish_metrics();
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -22,10 +22,14 @@
 #include "roc_core/optional.h"
 #include "roc_core/stddefs.h"
 #include "roc_dbgio/csv_dumper.h"
+#include "roc_dbgio/packet_capture_writer.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
+#include "roc_pipeline/prefetch_worker_pool.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_slot.h"
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_pipeline/stage_reader.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtp/encoding_map.h"
 #include "roc_sndio/isource.h"
@@ -38,6 +42,7 @@ namespace pipeline {
 //! Contains:
 //!  - one or more receiver slots
 //!  - mixer, to mix audio from all slots
+//!  - optional worker pool, to read sessions of all slots in parallel
 //!
 //! Pipeline:
 //!  - input: packets
@@ -132,6 +137,8 @@ public:
     virtual void dispose();
 
 private:
+    void publish_metrics_(packet::stream_timestamp_t duration);
+
     ReceiverSourceConfig source_config_;
 
     audio::ProcessorMap& processor_map_;
@@ -144,15 +151,23 @@ private:
     StateTracker state_tracker_;
 
     core::Optional<dbgio::CsvDumper> dumper_;
+    core::Optional<dbgio::PacketCaptureWriter> capture_writer_;
 
     core::Optional<audio::Mixer> mixer_;
+    core::Optional<StageProfiler> stage_profiler_;
+    core::Optional<StageFrameReader> mixer_stage_;
     core::Optional<audio::ProfilingReader> profiler_;
     core::Optional<audio::PcmMapperReader> pcm_mapper_;
 
+    core::Optional<PrefetchWorkerPool> worker_pool_;
+
     core::List<ReceiverSlot> slots_;
 
     audio::IFrameReader* frame_reader_;
 
+    packet::stream_timestamp_t metrics_interval_;
+    packet::stream_timestamp_t metrics_elapsed_;
+
     status::StatusCode init_status_;
 };
 
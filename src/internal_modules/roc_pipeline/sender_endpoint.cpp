@@ -198,7 +198,7 @@ status::StatusCode SenderEndpoint::pull_packets(core::nanoseconds_t current_time
     // acceptable to consider such packets late and pull them next time.
     while (packet::PacketPtr packet = inbound_queue_.try_pop_front_exclusive()) {
         const status::StatusCode code = handle_packet_(packet, current_time);
-        state_tracker_.unregister_packet();
+        state_tracker_.unregister_packets(1);
 
         if (code != status::StatusOK) {
             return code;
@@ -241,7 +241,7 @@ status::StatusCode SenderEndpoint::write(const packet::PacketPtr& packet) {
     roc_panic_if(!packet);
     roc_panic_if(!parser_);
 
-    state_tracker_.register_packet();
+    state_tracker_.register_packets(1);
     inbound_queue_.push_back(*packet);
 
     return status::StatusOK;
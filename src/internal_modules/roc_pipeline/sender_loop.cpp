@@ -137,6 +137,19 @@ sndio::ISink& SenderLoop::sink() {
     return *this;
 }
 
+bool SenderLoop::read_slot_metrics(SlotHandle slot,
+                                   SenderSlotMetrics& slot_metrics,
+                                   SenderParticipantMetrics* party_metrics,
+                                   size_t* party_count) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    if (!slot) {
+        roc_panic("sender loop: slot handle is null");
+    }
+
+    return ((SenderSlot*)slot)->read_metrics(slot_metrics, party_metrics, party_count);
+}
+
 sndio::DeviceType SenderLoop::type() const {
     core::Mutex::Lock lock(sink_mutex_);
 
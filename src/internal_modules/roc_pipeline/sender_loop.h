@@ -139,6 +139,19 @@ public:
     //!  Samples written to the sink are sent to remote peers.
     sndio::ISink& sink();
 
+    //! Read slot metrics from last published snapshot.
+    //! @remarks
+    //!  Doesn't schedule a task and doesn't wait for pipeline thread.
+    //!  Can be called from any thread, while slot is not deleted.
+    //!  Requires enable_metrics_snapshots in config.
+    //! @returns
+    //!  false if snapshot is not available; QuerySlot task should be
+    //!  used in this case.
+    bool read_slot_metrics(SlotHandle slot,
+                           SenderSlotMetrics& slot_metrics,
+                           SenderParticipantMetrics* party_metrics,
+                           size_t* party_count);
+
 private:
     // Methods of sndio::ISink
     virtual sndio::DeviceType type() const;
@@ -28,6 +28,7 @@ SenderSession::SenderSession(const SenderSinkConfig& sink_config,
     , packet_factory_(packet_factory)
     , frame_factory_(frame_factory)
     , frame_writer_(NULL)
+    , shared_session_(NULL)
     , dumper_(dumper)
     , init_status_(status::NoStatus)
     , fail_status_(status::NoStatus) {
@@ -49,7 +50,7 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     roc_panic_if(init_status_ != status::StatusOK);
 
     roc_panic_if(!source_endpoint);
-    roc_panic_if(frame_writer_);
+    roc_panic_if(frame_writer_ || shared_session_);
 
     status::StatusCode status = status::NoStatus;
 
@@ -62,6 +63,14 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
         return status::StatusBadConfig;
     }
 
+    if (sink_config_.enable_stage_profiling) {
+        stage_profiler_.reset(new (stage_profiler_) StageProfiler(
+            sink_config_.stage_profiler, NULL, arena_));
+        if ((status = stage_profiler_->init_status()) != status::StatusOK) {
+            return status;
+        }
+    }
+
     // First part of pipeline: chained packet writers from packetizer to endpoint.
     // Packetizer writes packet to this pipeline, and it the end it writes
     // packets into endpoint outbound writers.
@@ -114,6 +123,24 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return status;
         }
         pkt_writer = fec_writer_.get();
+
+        if (sink_config_.enable_adaptive_fec) {
+            fec_tuner_.reset(new (fec_tuner_) fec::BlockTuner(
+                sink_config_.fec_tuner, sink_config_.fec_writer,
+                fec_encoder_->max_block_length()));
+            if ((status = fec_tuner_->init_status()) != status::StatusOK) {
+                return status;
+            }
+        }
+
+        if (stage_profiler_) {
+            fec_stage_writer_.reset(new (fec_stage_writer_) StagePacketWriter(
+                *pkt_writer, *stage_profiler_, Stage_FecEncoder));
+            if ((status = fec_stage_writer_->init_status()) != status::StatusOK) {
+                return status;
+            }
+            pkt_writer = fec_stage_writer_.get();
+        }
     }
 
     timestamp_extractor_.reset(new (timestamp_extractor_) rtp::TimestampExtractor(
@@ -147,13 +174,28 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
                                         audio::PcmSubformat_Raw,
                                         pkt_encoding->sample_spec.channel_set());
 
+        core::nanoseconds_t packet_length = sink_config_.packet_length;
+        if (packet_length < pkt_encoding->min_packet_length) {
+            roc_log(LogInfo,
+                    "sender session: increasing packet length to minimum supported"
+                    " by encoding: pt=%u packet_len=%.3fms min_packet_len=%.3fms",
+                    (unsigned)sink_config_.payload_type,
+                    (double)packet_length / core::Millisecond,
+                    (double)pkt_encoding->min_packet_length / core::Millisecond);
+            packet_length = pkt_encoding->min_packet_length;
+        }
+
         packetizer_.reset(new (packetizer_) audio::Packetizer(
             *pkt_writer, source_endpoint->outbound_composer(), *sequencer_,
-            *payload_encoder_, packet_factory_, sink_config_.packet_length, in_spec));
+            *payload_encoder_, packet_factory_, packet_length, in_spec));
         if ((status = packetizer_->init_status()) != status::StatusOK) {
             return status;
         }
         frm_writer = packetizer_.get();
+
+        if ((status = profile_stage_(frm_writer, Stage_Packetizer)) != status::StatusOK) {
+            return status;
+        }
     }
 
     if (pkt_encoding->sample_spec.channel_set()
@@ -173,6 +215,11 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return status;
         }
         frm_writer = channel_mapper_writer_.get();
+
+        if ((status = profile_stage_(frm_writer, Stage_ChannelMapper))
+            != status::StatusOK) {
+            return status;
+        }
     }
 
     if (sink_config_.latency.tuner_profile != audio::LatencyTunerProfile_Intact
@@ -202,6 +249,10 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return status;
         }
         frm_writer = resampler_writer_.get();
+
+        if ((status = profile_stage_(frm_writer, Stage_Resampler)) != status::StatusOK) {
+            return status;
+        }
     }
 
     {
@@ -216,6 +267,11 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
             return status;
         }
         frm_writer = feedback_monitor_.get();
+
+        if ((status = profile_stage_(frm_writer, Stage_FeedbackMonitor))
+            != status::StatusOK) {
+            return status;
+        }
     }
 
     // Top-level frame writer that is added to fanout.
@@ -224,6 +280,40 @@ SenderSession::create_transport_pipeline(SenderEndpoint* source_endpoint,
     return status::StatusOK;
 }
 
+status::StatusCode SenderSession::attach_shared_pipeline(SenderSession& shared_session) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    roc_panic_if(frame_writer_ || shared_session_);
+    roc_panic_if(!shared_session.frame_writer_);
+
+    roc_panic_if_msg(sink_config_.latency.tuner_profile
+                         != audio::LatencyTunerProfile_Intact,
+                     "sender session: shared pipeline requires intact tuner profile");
+
+    // Feedback monitor only collects reports from our own receivers.
+    // It is never written to, and doesn't need resampler since scaling
+    // is disabled with intact tuner profile.
+    const audio::SampleSpec inout_spec(sink_config_.input_sample_spec.sample_rate(),
+                                       audio::PcmSubformat_Raw,
+                                       sink_config_.input_sample_spec.channel_set());
+
+    feedback_monitor_.reset(new (feedback_monitor_) audio::FeedbackMonitor(
+        *shared_session.frame_writer_, *shared_session.packetizer_, NULL,
+        sink_config_.feedback, sink_config_.latency, sink_config_.freq_est, inout_spec,
+        dumper_));
+
+    const status::StatusCode code = feedback_monitor_->init_status();
+    if (code != status::StatusOK) {
+        feedback_monitor_.reset();
+        return code;
+    }
+
+    shared_session_ = &shared_session;
+    start_feedback_monitor_();
+
+    return status::StatusOK;
+}
+
 status::StatusCode
 SenderSession::create_control_pipeline(SenderEndpoint* control_endpoint) {
     roc_panic_if(init_status_ != status::StatusOK);
@@ -324,10 +414,27 @@ status::StatusCode SenderSession::write(audio::Frame& frame) {
 void SenderSession::get_slot_metrics(SenderSlotMetrics& slot_metrics) const {
     roc_panic_if(init_status_ != status::StatusOK);
 
-    slot_metrics.source_id = identity_->ssrc();
+    // Encoding is performed by shared session, if any.
+    const SenderSession& encoder = shared_session_ ? *shared_session_ : *this;
+
+    slot_metrics.source_id = identity_ref_().ssrc();
     slot_metrics.num_participants =
         feedback_monitor_ ? feedback_monitor_->num_participants() : 0;
-    slot_metrics.is_complete = (frame_writer_ != NULL);
+    slot_metrics.is_complete = (frame_writer_ != NULL || shared_session_ != NULL);
+
+    if (encoder.fec_writer_) {
+        slot_metrics.fec_source_packets = encoder.fec_writer_->n_source_packets();
+        slot_metrics.fec_repair_packets = encoder.fec_writer_->n_repair_packets();
+        slot_metrics.fec_repair_ratio = float(slot_metrics.fec_repair_packets)
+            / float(slot_metrics.fec_source_packets);
+    }
+
+    if (encoder.stage_profiler_) {
+        for (size_t n = 0; n < Stage_Max; n++) {
+            slot_metrics.stages[n] =
+                encoder.stage_profiler_->get_metrics((PipelineStage)n);
+        }
+    }
 }
 
 void SenderSession::get_participant_metrics(SenderParticipantMetrics* party_metrics,
@@ -350,8 +457,8 @@ void SenderSession::get_participant_metrics(SenderParticipantMetrics* party_metr
 rtcp::ParticipantInfo SenderSession::participant_info() {
     rtcp::ParticipantInfo part_info;
 
-    part_info.cname = identity_->cname();
-    part_info.source_id = identity_->ssrc();
+    part_info.cname = identity_ref_().cname();
+    part_info.source_id = identity_ref_().ssrc();
     part_info.report_mode = rtcp::Report_ToAddress;
     part_info.report_address = rtcp_outbound_addr_;
 
@@ -359,7 +466,8 @@ rtcp::ParticipantInfo SenderSession::participant_info() {
 }
 
 void SenderSession::change_source_id() {
-    const status::StatusCode code = identity_->change_ssrc();
+    // If pipeline is shared, SSRC is changed for all slots sharing it.
+    const status::StatusCode code = identity_ref_().change_ssrc();
 
     if (code != status::StatusOK) {
         roc_panic("sender session: can't change SSRC: status=%s",
@@ -368,12 +476,20 @@ void SenderSession::change_source_id() {
 }
 
 bool SenderSession::has_send_stream() {
+    if (shared_session_) {
+        return shared_session_->has_send_stream();
+    }
+
     return timestamp_extractor_ && timestamp_extractor_->has_mapping();
 }
 
 rtcp::SendReport SenderSession::query_send_stream(core::nanoseconds_t report_time) {
     roc_panic_if(!has_send_stream());
 
+    if (shared_session_) {
+        return shared_session_->query_send_stream(report_time);
+    }
+
     const audio::PacketizerMetrics& packet_metrics = packetizer_->metrics();
 
     rtcp::SendReport report;
@@ -409,11 +525,19 @@ SenderSession::notify_send_stream(packet::stream_source_t recv_source_id,
 
         feedback_monitor_->process_feedback(recv_source_id, latency_metrics,
                                             link_metrics);
+
+        if (fec_tuner_) {
+            update_fec_tuner_();
+        }
     }
 
     return status::StatusOK;
 }
 
+rtp::Identity& SenderSession::identity_ref_() const {
+    return shared_session_ ? *shared_session_->identity_ : *identity_;
+}
+
 void SenderSession::start_feedback_monitor_() {
     if (!feedback_monitor_) {
         // Transport endpoint not created yet.
@@ -439,6 +563,47 @@ void SenderSession::start_feedback_monitor_() {
     feedback_monitor_->start();
 }
 
+void SenderSession::update_fec_tuner_() {
+    if (feedback_monitor_->num_participants() == 0) {
+        // Report was not accepted by feedback monitor.
+        return;
+    }
+
+    // Use metrics accepted by feedback monitor, which filters out reports
+    // from unexpected receivers and fills missing packet counters.
+    const packet::LinkMetrics& link_metrics = feedback_monitor_->link_metrics(0);
+
+    if (!fec_tuner_->update(link_metrics.expected_packets, link_metrics.lost_packets,
+                            core::timestamp(core::ClockMonotonic))) {
+        return;
+    }
+
+    const status::StatusCode code = fec_writer_->resize(
+        fec_tuner_->n_source_packets(), fec_tuner_->n_repair_packets());
+    if (code != status::StatusOK) {
+        roc_log(LogError, "sender session: can't resize fec block: status=%s",
+                status::code_to_str(code));
+    }
+}
+
+status::StatusCode SenderSession::profile_stage_(audio::IFrameWriter*& frm_writer,
+                                                 PipelineStage stage) {
+    if (!stage_profiler_) {
+        return status::StatusOK;
+    }
+
+    stage_writers_[stage].reset(new (stage_writers_[stage]) StageFrameWriter(
+        *frm_writer, *stage_profiler_, stage));
+
+    const status::StatusCode code = stage_writers_[stage]->init_status();
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    frm_writer = stage_writers_[stage].get();
+    return status::StatusOK;
+}
+
 status::StatusCode
 SenderSession::route_control_packet_(const packet::PacketPtr& packet,
                                      core::nanoseconds_t current_time) {
@@ -26,6 +26,7 @@
 #include "roc_core/optional.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_dbgio/csv_dumper.h"
+#include "roc_fec/block_tuner.h"
 #include "roc_fec/block_writer.h"
 #include "roc_fec/iblock_encoder.h"
 #include "roc_packet/interleaver.h"
@@ -34,6 +35,8 @@
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
 #include "roc_pipeline/sender_endpoint.h"
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_pipeline/stage_writer.h"
 #include "roc_rtcp/communicator.h"
 #include "roc_rtcp/composer.h"
 #include "roc_rtcp/iparticipant.h"
@@ -72,6 +75,18 @@ public:
     create_transport_pipeline(SenderEndpoint* source_endpoint,
                               SenderEndpoint* repair_endpoint);
 
+    //! Attach to transport sub-pipeline of another session.
+    //! @remarks
+    //!  Used instead of create_transport_pipeline() when encoding is shared
+    //!  between slots. Frames are written only to @p shared_session, and this
+    //!  session gets copies of its packets via packet fanout. This session
+    //!  reuses identity (SSRC) of @p shared_session and keeps only its own
+    //!  control sub-pipeline and feedback monitor.
+    //! @note
+    //!  @p shared_session should outlive this session.
+    ROC_NODISCARD status::StatusCode
+    attach_shared_pipeline(SenderSession& shared_session);
+
     //! Create control sub-pipeline.
     ROC_NODISCARD status::StatusCode
     create_control_pipeline(SenderEndpoint* control_endpoint);
@@ -131,7 +146,13 @@ private:
     // Implementation of audio::IFrameWriter.
     virtual status::StatusCode write(audio::Frame& frame);
 
+    rtp::Identity& identity_ref_() const;
+
     void start_feedback_monitor_();
+    void update_fec_tuner_();
+
+    status::StatusCode profile_stage_(audio::IFrameWriter*& frm_writer,
+                                      PipelineStage stage);
 
     status::StatusCode route_control_packet_(const packet::PacketPtr& packet,
                                              core::nanoseconds_t current_time);
@@ -155,6 +176,7 @@ private:
 
     core::ScopedPtr<fec::IBlockEncoder> fec_encoder_;
     core::Optional<fec::BlockWriter> fec_writer_;
+    core::Optional<fec::BlockTuner> fec_tuner_;
 
     core::Optional<rtp::TimestampExtractor> timestamp_extractor_;
 
@@ -166,11 +188,17 @@ private:
 
     core::Optional<audio::FeedbackMonitor> feedback_monitor_;
 
+    core::Optional<StageProfiler> stage_profiler_;
+    core::Optional<StagePacketWriter> fec_stage_writer_;
+    core::Optional<StageFrameWriter> stage_writers_[Stage_Max];
+
     core::Optional<rtcp::Communicator> rtcp_communicator_;
     address::SocketAddr rtcp_outbound_addr_;
 
     audio::IFrameWriter* frame_writer_;
 
+    SenderSession* shared_session_;
+
     dbgio::CsvDumper* dumper_;
 
     status::StatusCode init_status_;
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/sender_shared_session.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+SenderSharedSession::SenderSharedSession(const SenderSinkConfig& sink_config,
+                                         address::Protocol source_proto,
+                                         address::Protocol repair_proto,
+                                         StateTracker& state_tracker,
+                                         audio::ProcessorMap& processor_map,
+                                         rtp::EncodingMap& encoding_map,
+                                         packet::PacketFactory& packet_factory,
+                                         audio::FrameFactory& frame_factory,
+                                         core::IArena& arena,
+                                         dbgio::CsvDumper* dumper)
+    : core::RefCounted<SenderSharedSession, core::ArenaAllocation>(arena)
+    , source_proto_(source_proto)
+    , repair_proto_(repair_proto)
+    , source_fanout_(packet_factory, arena)
+    , repair_fanout_(packet_factory, arena)
+    , session_(sink_config,
+               processor_map,
+               encoding_map,
+               packet_factory,
+               frame_factory,
+               arena,
+               dumper)
+    , n_members_(0)
+    , init_status_(status::NoStatus) {
+    roc_log(LogDebug,
+            "sender shared session: initializing: source_proto=%s repair_proto=%s",
+            address::proto_to_str(source_proto),
+            repair_proto != address::Proto_None ? address::proto_to_str(repair_proto)
+                                                : "none");
+
+    if ((init_status_ = source_fanout_.init_status()) != status::StatusOK
+        || (init_status_ = repair_fanout_.init_status()) != status::StatusOK
+        || (init_status_ = session_.init_status()) != status::StatusOK) {
+        return;
+    }
+
+    // Internal endpoints don't have outbound address. They compose packets and
+    // pass them to fanouts, and then endpoints of member slots set destination
+    // address and pass packets to network.
+    source_endpoint_.reset(new (source_endpoint_) SenderEndpoint(
+        source_proto, state_tracker, session_, address::SocketAddr(), source_fanout_,
+        arena));
+    if ((init_status_ = source_endpoint_->init_status()) != status::StatusOK) {
+        return;
+    }
+
+    if (repair_proto != address::Proto_None) {
+        repair_endpoint_.reset(new (repair_endpoint_) SenderEndpoint(
+            repair_proto, state_tracker, session_, address::SocketAddr(), repair_fanout_,
+            arena));
+        if ((init_status_ = repair_endpoint_->init_status()) != status::StatusOK) {
+            return;
+        }
+    }
+
+    if ((init_status_ = session_.create_transport_pipeline(source_endpoint_.get(),
+                                                           repair_endpoint_.get()))
+        != status::StatusOK) {
+        return;
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+status::StatusCode SenderSharedSession::init_status() const {
+    return init_status_;
+}
+
+bool SenderSharedSession::matches(address::Protocol source_proto,
+                                  address::Protocol repair_proto) const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return source_proto_ == source_proto && repair_proto_ == repair_proto;
+}
+
+SenderSession& SenderSharedSession::session() {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return session_;
+}
+
+size_t SenderSharedSession::num_members() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return n_members_;
+}
+
+size_t SenderSharedSession::num_packet_copies() const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return source_fanout_.num_copies() + repair_fanout_.num_copies();
+}
+
+status::StatusCode SenderSharedSession::add_member(SenderEndpoint& source_endpoint,
+                                                   SenderEndpoint* repair_endpoint) {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    roc_panic_if_msg(!matches(source_endpoint.proto(),
+                              repair_endpoint ? repair_endpoint->proto()
+                                              : address::Proto_None),
+                     "sender shared session: endpoint protocols mismatch");
+
+    status::StatusCode code = status::NoStatus;
+
+    if ((code = source_fanout_.add_output(source_endpoint.outbound_writer()))
+        != status::StatusOK) {
+        return code;
+    }
+
+    if (repair_endpoint) {
+        if ((code = repair_fanout_.add_output(repair_endpoint->outbound_writer()))
+            != status::StatusOK) {
+            source_fanout_.remove_output(source_endpoint.outbound_writer());
+            return code;
+        }
+    }
+
+    n_members_++;
+
+    roc_log(LogDebug, "sender shared session: added member: n_members=%lu",
+            (unsigned long)n_members_);
+
+    return status::StatusOK;
+}
+
+void SenderSharedSession::remove_member(SenderEndpoint& source_endpoint,
+                                        SenderEndpoint* repair_endpoint) {
+    roc_panic_if(init_status_ != status::StatusOK);
+    roc_panic_if(n_members_ == 0);
+
+    source_fanout_.remove_output(source_endpoint.outbound_writer());
+
+    if (repair_endpoint) {
+        repair_fanout_.remove_output(repair_endpoint->outbound_writer());
+    }
+
+    n_members_--;
+
+    roc_log(LogDebug, "sender shared session: removed member: n_members=%lu",
+            (unsigned long)n_members_);
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/sender_shared_session.h
+//! @brief Sender session shared by multiple slots.
+
+#ifndef ROC_PIPELINE_SENDER_SHARED_SESSION_H_
+#define ROC_PIPELINE_SENDER_SHARED_SESSION_H_
+
+#include "roc_address/protocol.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/processor_map.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list_node.h"
+#include "roc_core/optional.h"
+#include "roc_core/ref_counted.h"
+#include "roc_dbgio/csv_dumper.h"
+#include "roc_packet/fanout.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/sender_endpoint.h"
+#include "roc_pipeline/sender_session.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Sender session shared by multiple slots.
+//!
+//! Contains:
+//!  - one sender session with transport pipeline (resampler, channel mapper,
+//!    packetizer, FEC encoder)
+//!  - internal source and repair endpoints, which compose packets produced
+//!    by that session
+//!  - packet fanouts, which pass composed packets to outbound writers of
+//!    every member slot
+//!
+//! Used when multiple slots of the same sink use identical endpoint protocols,
+//! and hence identical encoding. Instead of encoding every frame for every
+//! slot, frame is encoded once, and member slots get copies of composed
+//! packets, which share the same buffer and differ only in destination address.
+class SenderSharedSession
+    : public core::RefCounted<SenderSharedSession, core::ArenaAllocation>,
+      public core::ListNode<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p repair_proto is Proto_None if there is no repair endpoint.
+    SenderSharedSession(const SenderSinkConfig& sink_config,
+                        address::Protocol source_proto,
+                        address::Protocol repair_proto,
+                        StateTracker& state_tracker,
+                        audio::ProcessorMap& processor_map,
+                        rtp::EncodingMap& encoding_map,
+                        packet::PacketFactory& packet_factory,
+                        audio::FrameFactory& frame_factory,
+                        core::IArena& arena,
+                        dbgio::CsvDumper* dumper);
+
+    //! Check if the pipeline was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Check if session can be shared by endpoints with given protocols.
+    bool matches(address::Protocol source_proto, address::Protocol repair_proto) const;
+
+    //! Get underlying session.
+    SenderSession& session();
+
+    //! Get number of member slots.
+    size_t num_members() const;
+
+    //! Get number of packet copies made for members.
+    size_t num_packet_copies() const;
+
+    //! Add member slot endpoints.
+    //! @remarks
+    //!  Packets produced by session will be written to their outbound writers.
+    ROC_NODISCARD status::StatusCode add_member(SenderEndpoint& source_endpoint,
+                                                SenderEndpoint* repair_endpoint);
+
+    //! Remove member slot endpoints.
+    void remove_member(SenderEndpoint& source_endpoint, SenderEndpoint* repair_endpoint);
+
+private:
+    const address::Protocol source_proto_;
+    const address::Protocol repair_proto_;
+
+    packet::Fanout source_fanout_;
+    packet::Fanout repair_fanout_;
+
+    SenderSession session_;
+
+    core::Optional<SenderEndpoint> source_endpoint_;
+    core::Optional<SenderEndpoint> repair_endpoint_;
+
+    size_t n_members_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_SENDER_SHARED_SESSION_H_
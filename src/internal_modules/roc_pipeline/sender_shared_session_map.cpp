@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/sender_shared_session_map.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+SenderSharedSessionMap::SenderSharedSessionMap(const SenderSinkConfig& sink_config,
+                                               StateTracker& state_tracker,
+                                               audio::ProcessorMap& processor_map,
+                                               rtp::EncodingMap& encoding_map,
+                                               audio::Fanout& fanout,
+                                               packet::PacketFactory& packet_factory,
+                                               audio::FrameFactory& frame_factory,
+                                               core::IArena& arena,
+                                               dbgio::CsvDumper* dumper)
+    : sink_config_(sink_config)
+    , state_tracker_(state_tracker)
+    , processor_map_(processor_map)
+    , encoding_map_(encoding_map)
+    , fanout_(fanout)
+    , packet_factory_(packet_factory)
+    , frame_factory_(frame_factory)
+    , arena_(arena)
+    , dumper_(dumper) {
+}
+
+size_t SenderSharedSessionMap::num_sessions() const {
+    return sessions_.size();
+}
+
+core::SharedPtr<SenderSharedSession>
+SenderSharedSessionMap::attach(SenderEndpoint& source_endpoint,
+                               SenderEndpoint* repair_endpoint) {
+    const address::Protocol source_proto = source_endpoint.proto();
+    const address::Protocol repair_proto =
+        repair_endpoint ? repair_endpoint->proto() : address::Proto_None;
+
+    core::SharedPtr<SenderSharedSession> session;
+
+    for (session = sessions_.front(); session; session = sessions_.nextof(*session)) {
+        if (session->matches(source_proto, repair_proto)) {
+            break;
+        }
+    }
+
+    if (!session) {
+        if (!(session = create_session_(source_proto, repair_proto))) {
+            return NULL;
+        }
+    }
+
+    if (session->add_member(source_endpoint, repair_endpoint) != status::StatusOK) {
+        roc_log(LogError, "sender shared session map: can't add member to session");
+        if (session->num_members() == 0) {
+            fanout_.remove_output(*session->session().frame_writer());
+            sessions_.remove(*session);
+        }
+        return NULL;
+    }
+
+    roc_log(LogInfo,
+            "sender shared session map: attached slot to shared session:"
+            " source_proto=%s repair_proto=%s n_members=%lu",
+            address::proto_to_str(source_proto),
+            repair_proto != address::Proto_None ? address::proto_to_str(repair_proto)
+                                                : "none",
+            (unsigned long)session->num_members());
+
+    return session;
+}
+
+void SenderSharedSessionMap::detach(SenderSharedSession& session,
+                                    SenderEndpoint& source_endpoint,
+                                    SenderEndpoint* repair_endpoint) {
+    roc_panic_if(!sessions_.contains(session));
+
+    session.remove_member(source_endpoint, repair_endpoint);
+
+    if (session.num_members() != 0) {
+        return;
+    }
+
+    roc_log(LogDebug, "sender shared session map: removing session without members");
+
+    fanout_.remove_output(*session.session().frame_writer());
+    sessions_.remove(session);
+}
+
+core::SharedPtr<SenderSharedSession>
+SenderSharedSessionMap::create_session_(address::Protocol source_proto,
+                                        address::Protocol repair_proto) {
+    core::SharedPtr<SenderSharedSession> session = new (arena_) SenderSharedSession(
+        sink_config_, source_proto, repair_proto, state_tracker_, processor_map_,
+        encoding_map_, packet_factory_, frame_factory_, arena_, dumper_);
+
+    if (!session) {
+        roc_log(LogError,
+                "sender shared session map: can't create session, allocation failed");
+        return NULL;
+    }
+
+    if (session->init_status() != status::StatusOK) {
+        roc_log(LogError,
+                "sender shared session map: can't create session,"
+                " initialization failed: status=%s",
+                status::code_to_str(session->init_status()));
+        return NULL;
+    }
+
+    if (fanout_.add_output(*session->session().frame_writer()) != status::StatusOK) {
+        roc_log(LogError, "sender shared session map: can't add session to fanout");
+        return NULL;
+    }
+
+    sessions_.push_back(*session);
+
+    return session;
+}
+
+} // namespace pipeline
+} // namespace roc
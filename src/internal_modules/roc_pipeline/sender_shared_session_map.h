@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/sender_shared_session_map.h
+//! @brief Sender shared session map.
+
+#ifndef ROC_PIPELINE_SENDER_SHARED_SESSION_MAP_H_
+#define ROC_PIPELINE_SENDER_SHARED_SESSION_MAP_H_
+
+#include "roc_audio/fanout.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/processor_map.h"
+#include "roc_core/iarena.h"
+#include "roc_core/list.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/shared_ptr.h"
+#include "roc_dbgio/csv_dumper.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/config.h"
+#include "roc_pipeline/sender_endpoint.h"
+#include "roc_pipeline/sender_shared_session.h"
+#include "roc_pipeline/state_tracker.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Sender shared session map.
+//!
+//! Keeps shared sessions of a sender sink, one per every combination of
+//! endpoint protocols. Since all slots of a sink use the same sink config,
+//! slots with identical protocols produce identical packets and can share
+//! the same session.
+//!
+//! When the first member is attached to shared session, session's frame writer
+//! is added to sink's audio fanout. When the last member is detached, frame writer
+//! is removed from fanout and session is destroyed.
+class SenderSharedSessionMap : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    SenderSharedSessionMap(const SenderSinkConfig& sink_config,
+                           StateTracker& state_tracker,
+                           audio::ProcessorMap& processor_map,
+                           rtp::EncodingMap& encoding_map,
+                           audio::Fanout& fanout,
+                           packet::PacketFactory& packet_factory,
+                           audio::FrameFactory& frame_factory,
+                           core::IArena& arena,
+                           dbgio::CsvDumper* dumper);
+
+    //! Get number of shared sessions.
+    size_t num_sessions() const;
+
+    //! Attach slot endpoints to matching shared session.
+    //! @remarks
+    //!  Creates new shared session if there is no matching one.
+    //! @returns
+    //!  NULL if session can't be created.
+    core::SharedPtr<SenderSharedSession> attach(SenderEndpoint& source_endpoint,
+                                                SenderEndpoint* repair_endpoint);
+
+    //! Detach slot endpoints from shared session.
+    void detach(SenderSharedSession& session,
+                SenderEndpoint& source_endpoint,
+                SenderEndpoint* repair_endpoint);
+
+private:
+    core::SharedPtr<SenderSharedSession> create_session_(address::Protocol source_proto,
+                                                         address::Protocol repair_proto);
+
+    const SenderSinkConfig sink_config_;
+
+    StateTracker& state_tracker_;
+    audio::ProcessorMap& processor_map_;
+    rtp::EncodingMap& encoding_map_;
+    audio::Fanout& fanout_;
+
+    packet::PacketFactory& packet_factory_;
+    audio::FrameFactory& frame_factory_;
+    core::IArena& arena_;
+
+    dbgio::CsvDumper* dumper_;
+
+    core::List<SenderSharedSession> sessions_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_SENDER_SHARED_SESSION_MAP_H_
@@ -31,12 +31,21 @@ SenderSink::SenderSink(const SenderSinkConfig& sink_config,
     , frame_factory_(frame_pool, frame_buffer_pool)
     , arena_(arena)
     , frame_writer_(NULL)
+    , metrics_interval_(0)
+    , metrics_elapsed_(0)
     , init_status_(status::NoStatus) {
     if (!sink_config_.deduce_defaults(processor_map)) {
         init_status_ = status::StatusBadConfig;
         return;
     }
 
+    if (sink_config_.metrics_snapshot_interval > 0) {
+        metrics_interval_ = sink_config_.input_sample_spec.ns_2_stream_timestamp(
+            sink_config_.metrics_snapshot_interval);
+    }
+    // publish first snapshot after first frame
+    metrics_elapsed_ = metrics_interval_;
+
     if (sink_config_.dumper.dump_file) {
         dumper_.reset(new (dumper_) dbgio::CsvDumper(sink_config_.dumper, arena));
         if ((init_status_ = dumper_->open()) != status::StatusOK) {
@@ -58,6 +67,26 @@ SenderSink::SenderSink(const SenderSinkConfig& sink_config,
         frm_writer = fanout_.get();
     }
 
+    if (sink_config_.enable_shared_encoding) {
+        if (sink_config_.latency.tuner_profile != audio::LatencyTunerProfile_Intact) {
+            roc_log(LogInfo,
+                    "sender sink: shared encoding disabled:"
+                    " requires intact latency tuner profile, got '%s'",
+                    audio::latency_tuner_profile_to_str(
+                        sink_config_.latency.tuner_profile));
+        } else if (sink_config_.enable_adaptive_fec) {
+            // Follower sessions don't have FEC tuner, so adaptive FEC
+            // would be silently ignored for them.
+            roc_log(LogInfo,
+                    "sender sink: shared encoding disabled:"
+                    " not supported with adaptive fec");
+        } else {
+            shared_sessions_.reset(new (shared_sessions_) SenderSharedSessionMap(
+                sink_config_, state_tracker_, processor_map_, encoding_map_, *fanout_,
+                packet_factory_, frame_factory_, arena_, dumper_.get()));
+        }
+    }
+
     if (!sink_config_.input_sample_spec.is_raw()) {
         const audio::SampleSpec out_spec(sink_config_.input_sample_spec.sample_rate(),
                                          audio::PcmSubformat_Raw,
@@ -106,7 +135,8 @@ SenderSlot* SenderSink::create_slot(const SenderSlotConfig& slot_config) {
 
     core::SharedPtr<SenderSlot> slot = new (arena_) SenderSlot(
         sink_config_, slot_config, state_tracker_, processor_map_, encoding_map_,
-        *fanout_, packet_factory_, frame_factory_, arena_, dumper_.get());
+        *fanout_, shared_sessions_.get(), packet_factory_, frame_factory_, arena_,
+        dumper_.get());
 
     if (!slot) {
         roc_log(LogError, "sender sink: can't create slot, allocation failed");
@@ -251,6 +281,10 @@ status::StatusCode SenderSink::write(audio::Frame& frame) {
         state_tracker_.set_broken();
     }
 
+    if (sink_config_.enable_metrics_snapshots) {
+        publish_metrics_(frame.duration());
+    }
+
     return code;
 }
 
@@ -274,5 +308,20 @@ void SenderSink::dispose() {
     arena_.dispose_object(*this);
 }
 
+void SenderSink::publish_metrics_(packet::stream_timestamp_t duration) {
+    // Collecting metrics of all sessions on every frame would be too
+    // expensive, so snapshot is published once per interval.
+    metrics_elapsed_ += duration;
+    if (metrics_elapsed_ < metrics_interval_) {
+        return;
+    }
+    metrics_elapsed_ = 0;
+
+    for (core::SharedPtr<SenderSlot> slot = slots_.front(); slot;
+         slot = slots_.nextof(*slot)) {
+        slot->publish_metrics();
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -25,6 +25,7 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/sender_endpoint.h"
+#include "roc_pipeline/sender_shared_session_map.h"
 #include "roc_pipeline/sender_slot.h"
 #include "roc_pipeline/state_tracker.h"
 #include "roc_rtp/encoding_map.h"
@@ -124,6 +125,8 @@ public:
     virtual void dispose();
 
 private:
+    void publish_metrics_(packet::stream_timestamp_t duration);
+
     SenderSinkConfig sink_config_;
 
     audio::ProcessorMap& processor_map_;
@@ -141,10 +144,15 @@ private:
     core::Optional<audio::ProfilingWriter> profiler_;
     core::Optional<audio::PcmMapperWriter> pcm_mapper_;
 
+    core::Optional<SenderSharedSessionMap> shared_sessions_;
+
     core::List<SenderSlot> slots_;
 
     audio::IFrameWriter* frame_writer_;
 
+    packet::stream_timestamp_t metrics_interval_;
+    packet::stream_timestamp_t metrics_elapsed_;
+
     status::StatusCode init_status_;
 };
 
@@ -20,6 +20,7 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
                        audio::ProcessorMap& processor_map,
                        rtp::EncodingMap& encoding_map,
                        audio::Fanout& fanout,
+                       SenderSharedSessionMap* shared_sessions,
                        packet::PacketFactory& packet_factory,
                        audio::FrameFactory& frame_factory,
                        core::IArena& arena,
@@ -27,6 +28,7 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
     : core::RefCounted<SenderSlot, core::ArenaAllocation>(arena)
     , sink_config_(sink_config)
     , fanout_(fanout)
+    , shared_sessions_(shared_sessions)
     , state_tracker_(state_tracker)
     , session_(sink_config,
                processor_map,
@@ -46,6 +48,12 @@ SenderSlot::SenderSlot(const SenderSinkConfig& sink_config,
 }
 
 SenderSlot::~SenderSlot() {
+    if (shared_session_) {
+        shared_sessions_->detach(*shared_session_, *source_endpoint_,
+                                 repair_endpoint_.get());
+        state_tracker_.unregister_session();
+    }
+
     if (session_.frame_writer() && fanout_.has_output(*session_.frame_writer())) {
         fanout_.remove_output(*session_.frame_writer());
         state_tracker_.unregister_session();
@@ -100,22 +108,14 @@ SenderEndpoint* SenderSlot::add_endpoint(address::Interface iface,
         if (source_endpoint_
             && (repair_endpoint_
                 || sink_config_.fec_encoder.scheme == packet::FEC_None)) {
-            if (session_.create_transport_pipeline(source_endpoint_.get(),
-                                                   repair_endpoint_.get())
-                != status::StatusOK) {
+            const status::StatusCode code = shared_sessions_
+                ? attach_shared_pipeline_()
+                : create_transport_pipeline_();
+            if (code != status::StatusOK) {
                 // TODO(gh-183): forward status (control ops)
                 return NULL;
             }
         }
-        if (session_.frame_writer()) {
-            if (!fanout_.has_output(*session_.frame_writer())) {
-                if (fanout_.add_output(*session_.frame_writer()) != status::StatusOK) {
-                    // TODO(gh-183): forward status (control ops)
-                    return NULL;
-                }
-                state_tracker_.register_session();
-            }
-        }
         break;
 
     case address::Iface_AudioControl:
@@ -173,11 +173,69 @@ void SenderSlot::get_metrics(SenderSlotMetrics& slot_metrics,
 
     session_.get_slot_metrics(slot_metrics);
 
+    if (shared_session_) {
+        slot_metrics.shared_encoding_slots = shared_session_->num_members();
+        slot_metrics.shared_packet_copies = shared_session_->num_packet_copies();
+    }
+
     if (party_metrics || party_count) {
         session_.get_participant_metrics(party_metrics, party_count);
     }
 }
 
+void SenderSlot::publish_metrics() {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    metrics_snapshot_.publish(*this);
+}
+
+bool SenderSlot::read_metrics(SenderSlotMetrics& slot_metrics,
+                              SenderParticipantMetrics* party_metrics,
+                              size_t* party_count) const {
+    roc_panic_if(init_status_ != status::StatusOK);
+
+    return metrics_snapshot_.read(slot_metrics, party_metrics, party_count);
+}
+
+status::StatusCode SenderSlot::create_transport_pipeline_() {
+    status::StatusCode code = status::NoStatus;
+
+    if ((code = session_.create_transport_pipeline(source_endpoint_.get(),
+                                                   repair_endpoint_.get()))
+        != status::StatusOK) {
+        return code;
+    }
+
+    if ((code = fanout_.add_output(*session_.frame_writer())) != status::StatusOK) {
+        return code;
+    }
+
+    state_tracker_.register_session();
+
+    return status::StatusOK;
+}
+
+status::StatusCode SenderSlot::attach_shared_pipeline_() {
+    shared_session_ =
+        shared_sessions_->attach(*source_endpoint_, repair_endpoint_.get());
+    if (!shared_session_) {
+        return status::StatusNoMem;
+    }
+
+    const status::StatusCode code =
+        session_.attach_shared_pipeline(shared_session_->session());
+    if (code != status::StatusOK) {
+        shared_sessions_->detach(*shared_session_, *source_endpoint_,
+                                 repair_endpoint_.get());
+        shared_session_ = NULL;
+        return code;
+    }
+
+    state_tracker_.register_session();
+
+    return status::StatusOK;
+}
+
 SenderEndpoint*
 SenderSlot::create_source_endpoint_(address::Protocol proto,
                                     const address::SocketAddr& outbound_address,
@@ -25,8 +25,10 @@
 #include "roc_packet/packet_factory.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/metrics.h"
+#include "roc_pipeline/metrics_snapshot.h"
 #include "roc_pipeline/sender_endpoint.h"
 #include "roc_pipeline/sender_session.h"
+#include "roc_pipeline/sender_shared_session_map.h"
 #include "roc_pipeline/state_tracker.h"
 
 namespace roc {
@@ -37,16 +39,24 @@ namespace pipeline {
 //! Contains:
 //!  - one or more related sender endpoints, one per each type
 //!  - one session associated with those endpoints
+//!
+//! If shared session map is provided, slot doesn't create its own transport
+//! sub-pipeline. Instead, it attaches its endpoints to a shared session with
+//! matching protocols, and its own session uses transport sub-pipeline of
+//! the shared session.
 class SenderSlot : public core::RefCounted<SenderSlot, core::ArenaAllocation>,
                    public core::ListNode<> {
 public:
     //! Initialize.
+    //! @remarks
+    //!  @p shared_sessions is NULL if encoding is not shared between slots.
     SenderSlot(const SenderSinkConfig& sink_config,
                const SenderSlotConfig& slot_config,
                StateTracker& state_tracker,
                audio::ProcessorMap& processor_map,
                rtp::EncodingMap& encoding_map,
                audio::Fanout& fanout,
+               SenderSharedSessionMap* shared_sessions,
                packet::PacketFactory& packet_factory,
                audio::FrameFactory& frame_factory,
                core::IArena& arena,
@@ -76,7 +86,25 @@ public:
                      SenderParticipantMetrics* party_metrics,
                      size_t* party_count) const;
 
+    //! Publish snapshot of slot metrics.
+    //! @remarks
+    //!  Invoked periodically by pipeline if metrics snapshots are enabled.
+    void publish_metrics();
+
+    //! Get metrics from last published snapshot.
+    //! @remarks
+    //!  Unlike get_metrics(), can be called from any thread.
+    //! @returns
+    //!  false if snapshot is not available; get_metrics() should be
+    //!  called from pipeline thread in this case.
+    bool read_metrics(SenderSlotMetrics& slot_metrics,
+                      SenderParticipantMetrics* party_metrics,
+                      size_t* party_count) const;
+
 private:
+    status::StatusCode create_transport_pipeline_();
+    status::StatusCode attach_shared_pipeline_();
+
     SenderEndpoint* create_source_endpoint_(address::Protocol proto,
                                             const address::SocketAddr& outbound_address,
                                             packet::IWriter& outbound_writer);
@@ -91,6 +119,10 @@ private:
 
     audio::Fanout& fanout_;
 
+    SenderSharedSessionMap* shared_sessions_;
+    // Declared before session_ to outlive it.
+    core::SharedPtr<SenderSharedSession> shared_session_;
+
     core::Optional<SenderEndpoint> source_endpoint_;
     core::Optional<SenderEndpoint> repair_endpoint_;
     core::Optional<SenderEndpoint> control_endpoint_;
@@ -98,6 +130,8 @@ private:
     StateTracker& state_tracker_;
     SenderSession session_;
 
+    SenderMetricsSnapshot metrics_snapshot_;
+
     status::StatusCode init_status_;
 };
 
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_metrics.h"
+
+namespace roc {
+namespace pipeline {
+
+const char* pipeline_stage_to_str(PipelineStage stage) {
+    switch (stage) {
+    case Stage_FeedbackMonitor:
+        return "feedback_monitor";
+    case Stage_Resampler:
+        return "resampler";
+    case Stage_ChannelMapper:
+        return "channel_mapper";
+    case Stage_Packetizer:
+        return "packetizer";
+    case Stage_FecEncoder:
+        return "fec_encoder";
+    case Stage_FecDecoder:
+        return "fec_decoder";
+    case Stage_Depacketizer:
+        return "depacketizer";
+    case Stage_Plc:
+        return "plc";
+    case Stage_Watchdog:
+        return "watchdog";
+    case Stage_LatencyMonitor:
+        return "latency_monitor";
+    case Stage_Mixer:
+        return "mixer";
+    case Stage_Max:
+        break;
+    }
+
+    return "invalid";
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_metrics.h
+//! @brief Pipeline stage metrics.
+
+#ifndef ROC_PIPELINE_STAGE_METRICS_H_
+#define ROC_PIPELINE_STAGE_METRICS_H_
+
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Pipeline stage.
+//! Identifies a reader or writer in sender or receiver pipeline,
+//! which timing is measured by StageProfiler.
+enum PipelineStage {
+    //! Sender: feedback monitor (latency tuning and rate adjustment).
+    Stage_FeedbackMonitor,
+
+    //! Sender and receiver: resampler.
+    Stage_Resampler,
+
+    //! Sender and receiver: channel mapper.
+    Stage_ChannelMapper,
+
+    //! Sender: packetizer, including payload encoder.
+    Stage_Packetizer,
+
+    //! Sender: FEC block writer, including FEC encoder.
+    Stage_FecEncoder,
+
+    //! Receiver: FEC block reader, including FEC decoder.
+    Stage_FecDecoder,
+
+    //! Receiver: depacketizer, including payload decoder.
+    Stage_Depacketizer,
+
+    //! Receiver: packet loss concealment.
+    Stage_Plc,
+
+    //! Receiver: watchdog.
+    Stage_Watchdog,
+
+    //! Receiver: latency monitor (latency tuning and rate adjustment).
+    Stage_LatencyMonitor,
+
+    //! Receiver: mixer.
+    Stage_Mixer,
+
+    //! Maximum enum value.
+    Stage_Max
+};
+
+//! Get string name of pipeline stage.
+const char* pipeline_stage_to_str(PipelineStage stage);
+
+//! Timing metrics of pipeline stage.
+//! @remarks
+//!  Each value is time spent by stage itself during one read or write call,
+//!  excluding time spent in nested stages. Values are computed over a moving
+//!  window of recent calls.
+struct StageMetrics {
+    //! Whether stage is present in pipeline and is profiled.
+    bool is_active;
+
+    //! Total number of calls.
+    uint64_t num_calls;
+
+    //! Median call time, nanoseconds.
+    core::nanoseconds_t p50_time;
+
+    //! 99th percentile of call time, nanoseconds.
+    core::nanoseconds_t p99_time;
+
+    //! Maximum call time, nanoseconds.
+    core::nanoseconds_t max_time;
+
+    StageMetrics()
+        : is_active(false)
+        , num_calls(0)
+        , p50_time(0)
+        , p99_time(0)
+        , max_time(0) {
+    }
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_METRICS_H_
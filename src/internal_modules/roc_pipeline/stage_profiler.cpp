@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace pipeline {
+
+StageProfiler::StageProfiler(const StageProfilerConfig& config,
+                             StageProfiler* parent,
+                             core::IArena& arena)
+    : config_(config)
+    , parent_(parent)
+    , arena_(arena)
+    , depth_(0)
+    , init_status_(status::NoStatus) {
+    if (config_.window_length == 0 || config_.histogram_range <= 0
+        || config_.histogram_bins == 0) {
+        roc_log(LogError,
+                "stage profiler: invalid config:"
+                " window_length=%lu histogram_range=%.3fms histogram_bins=%lu",
+                (unsigned long)config_.window_length,
+                (double)config_.histogram_range / core::Millisecond,
+                (unsigned long)config_.histogram_bins);
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+status::StatusCode StageProfiler::init_status() const {
+    return init_status_;
+}
+
+status::StatusCode StageProfiler::add_stage(PipelineStage stage) {
+    roc_panic_if(init_status_ != status::StatusOK);
+    roc_panic_if_msg(stage < 0 || stage >= Stage_Max,
+                     "stage profiler: invalid stage: %d", (int)stage);
+
+    if (stages_[stage]) {
+        return status::StatusOK;
+    }
+
+    stages_[stage].reset(new (stages_[stage]) Stage(config_, arena_));
+
+    if (!stages_[stage]->histogram.is_valid()
+        || !stages_[stage]->recent.resize(config_.window_length)) {
+        stages_[stage].reset();
+        return status::StatusNoMem;
+    }
+
+    return status::StatusOK;
+}
+
+void StageProfiler::begin_call() {
+    roc_panic_if_msg(depth_ >= MaxDepth, "stage profiler: call depth exceeded");
+
+    call_start_[depth_] = core::timestamp(core::ClockMonotonic);
+    call_nested_[depth_] = 0;
+    depth_++;
+}
+
+void StageProfiler::end_call(PipelineStage stage) {
+    roc_panic_if_msg(depth_ == 0, "stage profiler: unpaired end_call()");
+    roc_panic_if_msg(!stages_[stage], "stage profiler: stage not added: %s",
+                     pipeline_stage_to_str(stage));
+
+    depth_--;
+
+    const core::nanoseconds_t elapsed =
+        core::timestamp(core::ClockMonotonic) - call_start_[depth_];
+
+    core::nanoseconds_t self_time = elapsed - call_nested_[depth_];
+    if (self_time < 0) {
+        self_time = 0;
+    }
+
+    Stage& st = *stages_[stage];
+
+    st.histogram.add(self_time);
+    st.recent[st.recent_pos] = self_time;
+    st.recent_pos = (st.recent_pos + 1) % st.recent.size();
+    st.num_calls++;
+
+    add_nested_(elapsed);
+}
+
+StageMetrics StageProfiler::get_metrics(PipelineStage stage) const {
+    roc_panic_if_msg(stage < 0 || stage >= Stage_Max,
+                     "stage profiler: invalid stage: %d", (int)stage);
+
+    StageMetrics metrics;
+
+    if (!stages_[stage]) {
+        return metrics;
+    }
+
+    const Stage& st = *stages_[stage];
+
+    metrics.is_active = true;
+    metrics.num_calls = st.num_calls;
+
+    if (st.num_calls == 0) {
+        return metrics;
+    }
+
+    metrics.p50_time = st.histogram.mov_quantile(0.50);
+    metrics.p99_time = st.histogram.mov_quantile(0.99);
+
+    const size_t n_recent =
+        st.num_calls < st.recent.size() ? (size_t)st.num_calls : st.recent.size();
+
+    for (size_t n = 0; n < n_recent; n++) {
+        if (st.recent[n] > metrics.max_time) {
+            metrics.max_time = st.recent[n];
+        }
+    }
+
+    // histogram quantiles are rounded up to bin boundary
+    if (metrics.p50_time > metrics.max_time) {
+        metrics.p50_time = metrics.max_time;
+    }
+    if (metrics.p99_time > metrics.max_time) {
+        metrics.p99_time = metrics.max_time;
+    }
+
+    return metrics;
+}
+
+void StageProfiler::add_nested_(core::nanoseconds_t elapsed) {
+    if (depth_ != 0) {
+        call_nested_[depth_ - 1] += elapsed;
+    } else if (parent_) {
+        parent_->add_nested_(elapsed);
+    }
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_profiler.h
+//! @brief Pipeline stage profiler.
+
+#ifndef ROC_PIPELINE_STAGE_PROFILER_H_
+#define ROC_PIPELINE_STAGE_PROFILER_H_
+
+#include "roc_core/array.h"
+#include "roc_core/attributes.h"
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/stage_metrics.h"
+#include "roc_stat/mov_histogram.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Stage profiler parameters.
+struct StageProfilerConfig {
+    //! Number of recent calls used to compute metrics.
+    size_t window_length;
+
+    //! Upper bound of histogram range, nanoseconds.
+    //! Longer calls are counted in the last bin (but still reported by max_time).
+    core::nanoseconds_t histogram_range;
+
+    //! Number of histogram bins.
+    //! Defines precision of reported percentiles.
+    size_t histogram_bins;
+
+    //! Initialize.
+    StageProfilerConfig()
+        : window_length(1000)
+        , histogram_range(core::Millisecond)
+        , histogram_bins(1000) {
+    }
+};
+
+//! Pipeline stage profiler.
+//!
+//! Measures wall-clock time of read() or write() calls of pipeline stages
+//! and maintains moving histogram of call durations per stage.
+//!
+//! Stages form a call chain: e.g. when resampler reads from channel mapper,
+//! channel mapper call is nested into resampler call. Profiler tracks nesting
+//! and accounts each stage only for its own time, i.e. time of nested profiled
+//! calls is subtracted from time of enclosing call.
+//!
+//! Profilers can be chained too: when a profiler has a parent, time of its
+//! top-level calls is subtracted from the parent's current call. This is used
+//! to exclude time spent in sessions from time of the mixer.
+//!
+//! Profiler is not thread-safe and should be used from pipeline thread only,
+//! which is also where metrics are queried.
+class StageProfiler : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p parent is optional.
+    StageProfiler(const StageProfilerConfig& config,
+                  StageProfiler* parent,
+                  core::IArena& arena);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Enable profiling of given stage.
+    ROC_NODISCARD status::StatusCode add_stage(PipelineStage stage);
+
+    //! Mark beginning of call.
+    //! Should be followed by end_call().
+    void begin_call();
+
+    //! Mark end of call of given stage.
+    //! Should be preceded by begin_call().
+    void end_call(PipelineStage stage);
+
+    //! Get metrics of given stage.
+    StageMetrics get_metrics(PipelineStage stage) const;
+
+private:
+    enum { MaxDepth = 16 };
+
+    struct Stage {
+        Stage(const StageProfilerConfig& config, core::IArena& arena)
+            : histogram(arena,
+                        0,
+                        config.histogram_range,
+                        config.histogram_bins,
+                        config.window_length)
+            , recent(arena)
+            , recent_pos(0)
+            , num_calls(0) {
+        }
+
+        stat::MovHistogram<core::nanoseconds_t> histogram;
+        core::Array<core::nanoseconds_t> recent;
+        size_t recent_pos;
+        uint64_t num_calls;
+    };
+
+    void add_nested_(core::nanoseconds_t elapsed);
+
+    const StageProfilerConfig config_;
+    StageProfiler* parent_;
+    core::IArena& arena_;
+
+    core::Optional<Stage> stages_[Stage_Max];
+
+    core::nanoseconds_t call_start_[MaxDepth];
+    core::nanoseconds_t call_nested_[MaxDepth];
+    size_t depth_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_PROFILER_H_
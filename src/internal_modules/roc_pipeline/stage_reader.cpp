@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_reader.h"
+
+namespace roc {
+namespace pipeline {
+
+StageFrameReader::StageFrameReader(audio::IFrameReader& reader,
+                                   StageProfiler& profiler,
+                                   PipelineStage stage)
+    : reader_(reader)
+    , profiler_(profiler)
+    , stage_(stage)
+    , init_status_(status::NoStatus) {
+    init_status_ = profiler_.add_stage(stage_);
+}
+
+status::StatusCode StageFrameReader::init_status() const {
+    return init_status_;
+}
+
+status::StatusCode StageFrameReader::read(audio::Frame& frame,
+                                          packet::stream_timestamp_t duration,
+                                          audio::FrameReadMode mode) {
+    profiler_.begin_call();
+    const status::StatusCode code = reader_.read(frame, duration, mode);
+    profiler_.end_call(stage_);
+
+    return code;
+}
+
+StagePacketReader::StagePacketReader(packet::IReader& reader,
+                                     StageProfiler& profiler,
+                                     PipelineStage stage)
+    : reader_(reader)
+    , profiler_(profiler)
+    , stage_(stage)
+    , init_status_(status::NoStatus) {
+    init_status_ = profiler_.add_stage(stage_);
+}
+
+status::StatusCode StagePacketReader::init_status() const {
+    return init_status_;
+}
+
+status::StatusCode StagePacketReader::read(packet::PacketPtr& packet,
+                                           packet::PacketReadMode mode) {
+    profiler_.begin_call();
+    const status::StatusCode code = reader_.read(packet, mode);
+    profiler_.end_call(stage_);
+
+    return code;
+}
+
+} // namespace pipeline
+} // namespace roc
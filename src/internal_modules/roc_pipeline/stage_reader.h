@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_reader.h
+//! @brief Profiled stage readers.
+
+#ifndef ROC_PIPELINE_STAGE_READER_H_
+#define ROC_PIPELINE_STAGE_READER_H_
+
+#include "roc_audio/iframe_reader.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/ireader.h"
+#include "roc_pipeline/stage_profiler.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Frame reader that measures time of pipeline stage.
+//! Passes all reads to the underlying reader and reports
+//! their duration to StageProfiler.
+class StageFrameReader : public audio::IFrameReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p reader is the last reader of the stage.
+    StageFrameReader(audio::IFrameReader& reader,
+                     StageProfiler& profiler,
+                     PipelineStage stage);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Read audio frame.
+    virtual ROC_NODISCARD status::StatusCode read(audio::Frame& frame,
+                                                  packet::stream_timestamp_t duration,
+                                                  audio::FrameReadMode mode);
+
+private:
+    audio::IFrameReader& reader_;
+    StageProfiler& profiler_;
+    const PipelineStage stage_;
+
+    status::StatusCode init_status_;
+};
+
+//! Packet reader that measures time of pipeline stage.
+//! Passes all reads to the underlying reader and reports
+//! their duration to StageProfiler.
+class StagePacketReader : public packet::IReader, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p reader is the last reader of the stage.
+    StagePacketReader(packet::IReader& reader,
+                      StageProfiler& profiler,
+                      PipelineStage stage);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Read packet.
+    virtual ROC_NODISCARD status::StatusCode read(packet::PacketPtr& packet,
+                                                  packet::PacketReadMode mode);
+
+private:
+    packet::IReader& reader_;
+    StageProfiler& profiler_;
+    const PipelineStage stage_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_READER_H_
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_pipeline/stage_writer.h"
+
+namespace roc {
+namespace pipeline {
+
+StageFrameWriter::StageFrameWriter(audio::IFrameWriter& writer,
+                                   StageProfiler& profiler,
+                                   PipelineStage stage)
+    : writer_(writer)
+    , profiler_(profiler)
+    , stage_(stage)
+    , init_status_(status::NoStatus) {
+    init_status_ = profiler_.add_stage(stage_);
+}
+
+status::StatusCode StageFrameWriter::init_status() const {
+    return init_status_;
+}
+
+status::StatusCode StageFrameWriter::write(audio::Frame& frame) {
+    profiler_.begin_call();
+    const status::StatusCode code = writer_.write(frame);
+    profiler_.end_call(stage_);
+
+    return code;
+}
+
+StagePacketWriter::StagePacketWriter(packet::IWriter& writer,
+                                     StageProfiler& profiler,
+                                     PipelineStage stage)
+    : writer_(writer)
+    , profiler_(profiler)
+    , stage_(stage)
+    , init_status_(status::NoStatus) {
+    init_status_ = profiler_.add_stage(stage_);
+}
+
+status::StatusCode StagePacketWriter::init_status() const {
+    return init_status_;
+}
+
+status::StatusCode StagePacketWriter::write(const packet::PacketPtr& packet) {
+    profiler_.begin_call();
+    const status::StatusCode code = writer_.write(packet);
+    profiler_.end_call(stage_);
+
+    return code;
+}
+
+} // namespace pipeline
+} // namespace roc
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_pipeline/stage_writer.h
+//! @brief Profiled stage writers.
+
+#ifndef ROC_PIPELINE_STAGE_WRITER_H_
+#define ROC_PIPELINE_STAGE_WRITER_H_
+
+#include "roc_audio/iframe_writer.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/iwriter.h"
+#include "roc_pipeline/stage_profiler.h"
+
+namespace roc {
+namespace pipeline {
+
+//! Frame writer that measures time of pipeline stage.
+//! Passes all writes to the underlying writer and reports
+//! their duration to StageProfiler.
+class StageFrameWriter : public audio::IFrameWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p writer is the first writer of the stage.
+    StageFrameWriter(audio::IFrameWriter& writer,
+                     StageProfiler& profiler,
+                     PipelineStage stage);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Write audio frame.
+    virtual ROC_NODISCARD status::StatusCode write(audio::Frame& frame);
+
+private:
+    audio::IFrameWriter& writer_;
+    StageProfiler& profiler_;
+    const PipelineStage stage_;
+
+    status::StatusCode init_status_;
+};
+
+//! Packet writer that measures time of pipeline stage.
+//! Passes all writes to the underlying writer and reports
+//! their duration to StageProfiler.
+class StagePacketWriter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @p writer is the first writer of the stage.
+    StagePacketWriter(packet::IWriter& writer,
+                      StageProfiler& profiler,
+                      PipelineStage stage);
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Write packet.
+    virtual ROC_NODISCARD status::StatusCode write(const packet::PacketPtr& packet);
+
+private:
+    packet::IWriter& writer_;
+    StageProfiler& profiler_;
+    const PipelineStage stage_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace pipeline
+} // namespace roc
+
+#endif // ROC_PIPELINE_STAGE_WRITER_H_
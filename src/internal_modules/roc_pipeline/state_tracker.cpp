@@ -74,12 +74,12 @@ void StateTracker::unregister_session() {
     }
 }
 
-void StateTracker::register_packet() {
-    pending_packets_++;
+void StateTracker::register_packets(size_t n_packets) {
+    pending_packets_ += (int)n_packets;
 }
 
-void StateTracker::unregister_packet() {
-    if (--pending_packets_ < 0) {
+void StateTracker::unregister_packets(size_t n_packets) {
+    if ((pending_packets_ -= (int)n_packets) < 0) {
         roc_panic("state tracker: unpaired register/unregister packet");
     }
 }
@@ -56,11 +56,11 @@ public:
     //! Decrement active sessions counter.
     void unregister_session();
 
-    //! Increment pending packets counter.
-    void register_packet();
+    //! Increment pending packets counter by given number of packets.
+    void register_packets(size_t n_packets);
 
-    //! Decrement pending packets counter.
-    void unregister_packet();
+    //! Decrement pending packets counter by given number of packets.
+    void unregister_packets(size_t n_packets);
 
 private:
     core::Atomic<int> halt_state_;
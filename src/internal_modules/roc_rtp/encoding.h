@@ -14,10 +14,12 @@
 
 #include "roc_audio/iframe_decoder.h"
 #include "roc_audio/iframe_encoder.h"
+#include "roc_audio/iplc.h"
 #include "roc_audio/pcm_subformat.h"
 #include "roc_audio/sample_spec.h"
 #include "roc_core/attributes.h"
 #include "roc_core/iarena.h"
+#include "roc_core/time.h"
 #include "roc_rtp/headers.h"
 
 namespace roc {
@@ -34,6 +36,12 @@ struct Encoding {
     //! Packet flags.
     unsigned packet_flags;
 
+    //! Minimum packet duration.
+    //! Optional. If set, and sender is configured to use shorter packets,
+    //! this duration is used instead. E.g., Opus in-band FEC is available
+    //! only for frames of 10ms or longer.
+    core::nanoseconds_t min_packet_length;
+
     //! Create frame encoder.
     audio::IFrameEncoder* (*new_encoder)(const audio::SampleSpec& sample_spec,
                                          core::IArena& arena);
@@ -42,13 +50,22 @@ struct Encoding {
     audio::IFrameDecoder* (*new_decoder)(const audio::SampleSpec& sample_spec,
                                          core::IArena& arena);
 
+    //! Create PLC built into codec.
+    //! Optional. If set, it's used when PLC backend is audio::PlcBackend_Codec.
+    //! @p decoder is the instance created by new_decoder.
+    audio::IPlc* (*new_plc)(audio::IFrameDecoder& decoder,
+                            const audio::SampleSpec& sample_spec,
+                            core::IArena& arena);
+
     //! Initialize.
     Encoding()
         : payload_type(0)
         , sample_spec()
         , packet_flags(0)
+        , min_packet_length(0)
         , new_encoder(NULL)
-        , new_decoder(NULL) {
+        , new_decoder(NULL)
+        , new_plc(NULL) {
     }
 };
 
@@ -14,6 +14,12 @@
 #include "roc_core/panic.h"
 #include "roc_status/code_to_str.h"
 
+#ifdef ROC_TARGET_LIBOPUS
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_audio/opus_plc.h"
+#endif // ROC_TARGET_LIBOPUS
+
 namespace roc {
 namespace rtp {
 
@@ -40,6 +46,32 @@ EncodingMap::EncodingMap(core::IArena& arena)
 
         register_builtin_encoding_(enc);
     }
+#ifdef ROC_TARGET_LIBOPUS
+    {
+        Encoding enc;
+        enc.payload_type = PayloadType_Opus_Mono;
+        enc.sample_spec.set_format(audio::Format_Opus);
+        enc.sample_spec.set_sample_rate(48000);
+        enc.sample_spec.set_channel_set(
+            audio::ChannelSet(audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
+                              audio::ChanMask_Surround_Mono));
+        enc.packet_flags = packet::Packet::FlagAudio;
+
+        register_builtin_encoding_(enc);
+    }
+    {
+        Encoding enc;
+        enc.payload_type = PayloadType_Opus_Stereo;
+        enc.sample_spec.set_format(audio::Format_Opus);
+        enc.sample_spec.set_sample_rate(48000);
+        enc.sample_spec.set_channel_set(
+            audio::ChannelSet(audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
+                              audio::ChanMask_Surround_Stereo));
+        enc.packet_flags = packet::Packet::FlagAudio;
+
+        register_builtin_encoding_(enc);
+    }
+#endif // ROC_TARGET_LIBOPUS
 }
 
 const Encoding* EncodingMap::find_by_pt(unsigned int pt) const {
@@ -172,6 +204,25 @@ void EncodingMap::resolve_codecs_(Encoding& enc) {
         }
         break;
 
+#ifdef ROC_TARGET_LIBOPUS
+    case audio::Format_Opus:
+        if (!enc.new_encoder) {
+            enc.new_encoder = &audio::OpusEncoder::construct;
+            // Shorter frames are encoded without in-band FEC.
+            if (!enc.min_packet_length) {
+                enc.min_packet_length = 10 * core::Millisecond;
+            }
+        }
+        if (!enc.new_decoder) {
+            enc.new_decoder = &audio::OpusDecoder::construct;
+            // PLC works on top of our decoder.
+            if (!enc.new_plc) {
+                enc.new_plc = &audio::OpusPlc::construct;
+            }
+        }
+        break;
+#endif // ROC_TARGET_LIBOPUS
+
     default:
         break;
     }
@@ -27,9 +27,15 @@ enum Version {
 };
 
 //! RTP payload type.
+//! @remarks
+//!  Opus has no static payload type. To avoid collisions with encodings
+//!  negotiated in dynamic range (96-127), it uses numbers from range that
+//!  is unassigned by RTP A/V Profile (RFC 3551).
 enum PayloadType {
-    PayloadType_L16_Stereo = 10, //!< Audio, 16-bit PCM, 2 channels, 44100 Hz.
-    PayloadType_L16_Mono = 11    //!< Audio, 16-bit PCM, 1 channel, 44100 Hz.
+    PayloadType_L16_Stereo = 10,  //!< Audio, 16-bit PCM, 2 channels, 44100 Hz.
+    PayloadType_L16_Mono = 11,    //!< Audio, 16-bit PCM, 1 channel, 44100 Hz.
+    PayloadType_Opus_Stereo = 20, //!< Audio, Opus, 2 channels, 48000 Hz.
+    PayloadType_Opus_Mono = 21    //!< Audio, Opus, 1 channel, 48000 Hz.
 };
 
 enum {
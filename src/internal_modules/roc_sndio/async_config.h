@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/async_config.h
+//! @brief Asynchronous I/O config.
+
+#ifndef ROC_SNDIO_ASYNC_CONFIG_H_
+#define ROC_SNDIO_ASYNC_CONFIG_H_
+
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
+
+namespace roc {
+namespace sndio {
+
+//! Asynchronous source and sink config.
+struct AsyncConfig {
+    //! How much audio to buffer in background thread.
+    //! Source reads this much ahead of the reader, sink keeps this much
+    //! behind the writer before blocking it.
+    core::nanoseconds_t buffer_length;
+
+    //! Duration of frames exchanged with background thread.
+    //! Source uses it as the size of a single read from underlying source.
+    //! Sink uses it only to compute buffer size in frames.
+    //! If zero, default value is used.
+    core::nanoseconds_t frame_length;
+
+    //! Scheduling parameters of background thread.
+    core::ThreadConfig thread_config;
+
+    //! Initialize.
+    AsyncConfig()
+        : buffer_length(500 * core::Millisecond)
+        , frame_length(0) {
+    }
+};
+
+//! Asynchronous source and sink metrics.
+struct AsyncMetrics {
+    //! Number of frames currently buffered.
+    size_t buffered_frames;
+
+    //! Maximum number of buffered frames.
+    size_t max_frames;
+
+    //! How many times the caller had to wait for background thread.
+    //! For source, it happens when buffer is empty.
+    //! For sink, it happens when buffer is full.
+    uint64_t stall_count;
+
+    //! Total time spent by the caller waiting for background thread.
+    core::nanoseconds_t stall_duration;
+
+    AsyncMetrics()
+        : buffered_frames(0)
+        , max_frames(0)
+        , stall_count(0)
+        , stall_duration(0) {
+    }
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_ASYNC_CONFIG_H_
@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/async_sink.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
+#include "roc_status/code_to_str.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+const core::nanoseconds_t DefaultFrameLength = 10 * core::Millisecond;
+
+size_t max_frames(const AsyncConfig& config) {
+    const core::nanoseconds_t frame_len =
+        config.frame_length > 0 ? config.frame_length : DefaultFrameLength;
+
+    size_t n_frames = 1;
+    if (config.buffer_length > frame_len) {
+        n_frames = (size_t)((config.buffer_length + frame_len - 1) / frame_len);
+    }
+
+    return n_frames;
+}
+
+} // namespace
+
+AsyncSink::AsyncSink(ISink& inner_sink,
+                     audio::FrameFactory& frame_factory,
+                     core::IArena& arena,
+                     const AsyncConfig& config)
+    : IDevice(arena)
+    , ISink(arena)
+    , core::Thread(config.thread_config)
+    , inner_sink_(inner_sink)
+    , frame_factory_(frame_factory)
+    , sample_spec_(inner_sink.sample_spec())
+    , frame_length_(inner_sink.frame_length())
+    , max_frames_(max_frames(config))
+    , ring_(arena, max_frames_)
+    , n_frames_(0)
+    , stop_(0)
+    , io_status_(status::StatusOK)
+    , stall_count_(0)
+    , stall_duration_(0)
+    , closed_(true)
+    , init_status_(status::NoStatus) {
+    if (inner_sink.has_clock()) {
+        roc_log(LogError, "async sink: sinks with own clock are not supported");
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (!ring_.is_valid()) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    roc_log(LogDebug, "async sink: initializing: max_frames=%lu",
+            (unsigned long)max_frames_);
+
+    if (!Thread::start()) {
+        roc_log(LogError, "async sink: can't start background thread");
+        init_status_ = status::StatusErrThread;
+        return;
+    }
+
+    closed_ = false;
+    init_status_ = status::StatusOK;
+}
+
+AsyncSink::~AsyncSink() {
+    const status::StatusCode code = close();
+    if (code != status::StatusOK) {
+        roc_log(LogError, "async sink: close failed: status=%s",
+                status::code_to_str(code));
+    }
+}
+
+status::StatusCode AsyncSink::init_status() const {
+    return init_status_;
+}
+
+AsyncMetrics AsyncSink::metrics() const {
+    AsyncMetrics metrics;
+
+    const int n_frames = n_frames_;
+    metrics.buffered_frames = n_frames > 0 ? (size_t)n_frames : 0;
+    metrics.max_frames = max_frames_;
+    metrics.stall_count = stall_count_;
+    metrics.stall_duration = stall_duration_;
+
+    return metrics;
+}
+
+DeviceType AsyncSink::type() const {
+    return DeviceType_Sink;
+}
+
+ISink* AsyncSink::to_sink() {
+    return this;
+}
+
+ISource* AsyncSink::to_source() {
+    return NULL;
+}
+
+audio::SampleSpec AsyncSink::sample_spec() const {
+    return sample_spec_;
+}
+
+core::nanoseconds_t AsyncSink::frame_length() const {
+    return frame_length_;
+}
+
+bool AsyncSink::has_state() const {
+    return false;
+}
+
+bool AsyncSink::has_latency() const {
+    return false;
+}
+
+bool AsyncSink::has_clock() const {
+    return false;
+}
+
+status::StatusCode AsyncSink::write(audio::Frame& frame) {
+    if (closed_) {
+        roc_panic("async sink: not opened");
+    }
+
+    const status::StatusCode io_status = (status::StatusCode)(int)io_status_;
+    if (io_status != status::StatusOK) {
+        return io_status;
+    }
+
+    if (n_frames_ >= (int)max_frames_) {
+        // Buffer is full, wait until background thread writes a frame.
+        const core::nanoseconds_t stall_start = core::timestamp(core::ClockMonotonic);
+        stall_count_++;
+
+        while (n_frames_ >= (int)max_frames_) {
+            space_sem_.wait();
+        }
+
+        stall_duration_ += core::timestamp(core::ClockMonotonic) - stall_start;
+    }
+
+    audio::FramePtr frame_copy = frame_factory_.allocate_frame(frame.num_bytes());
+    if (!frame_copy) {
+        roc_log(LogError, "async sink: can't allocate frame");
+        return status::StatusNoMem;
+    }
+
+    memcpy(frame_copy->bytes(), frame.bytes(), frame.num_bytes());
+
+    frame_copy->set_raw(frame.is_raw());
+    frame_copy->set_flags(frame.flags());
+    if (frame.has_duration()) {
+        frame_copy->set_duration(frame.duration());
+    }
+    frame_copy->set_capture_timestamp(frame.capture_timestamp());
+
+    n_frames_++;
+
+    if (!ring_.push_back(frame_copy)) {
+        roc_panic("async sink: ring buffer overflow");
+    }
+
+    write_sem_.post();
+
+    return status::StatusOK;
+}
+
+status::StatusCode AsyncSink::flush() {
+    if (closed_) {
+        roc_panic("async sink: not opened");
+    }
+
+    wait_drained_();
+
+    const status::StatusCode io_status = (status::StatusCode)(int)io_status_;
+    if (io_status != status::StatusOK) {
+        return io_status;
+    }
+
+    // Background thread is idle until next write(), so we can safely
+    // access underlying sink here.
+    return inner_sink_.flush();
+}
+
+status::StatusCode AsyncSink::close() {
+    if (closed_) {
+        return status::StatusOK;
+    }
+
+    closed_ = true;
+
+    stop_thread_();
+
+    roc_log(LogDebug, "async sink: closing: stall_count=%lu stall_duration=%.3fms",
+            (unsigned long)stall_count_, (double)stall_duration_ / core::Millisecond);
+
+    const status::StatusCode code = inner_sink_.close();
+
+    // Report error of last buffered writes, if any, even if underlying
+    // sink was closed successfully.
+    const status::StatusCode io_status = (status::StatusCode)(int)io_status_;
+    if (io_status != status::StatusOK) {
+        return io_status;
+    }
+
+    return code;
+}
+
+void AsyncSink::dispose() {
+    arena().dispose_object(*this);
+}
+
+void AsyncSink::run() {
+    roc_log(LogDebug, "async sink: running background thread");
+
+    for (;;) {
+        audio::FramePtr frame;
+
+        if (!ring_.pop_front(frame)) {
+            if (stop_) {
+                break;
+            }
+            write_sem_.wait();
+            continue;
+        }
+
+        // After failure, keep draining buffer, so that writer is never
+        // blocked forever, but don't touch underlying sink anymore.
+        if (io_status_ == status::StatusOK) {
+            const status::StatusCode code = inner_sink_.write(*frame);
+
+            if (code != status::StatusOK) {
+                roc_log(LogError, "async sink: can't write frame: status=%s",
+                        status::code_to_str(code));
+                io_status_ = code;
+            }
+        }
+
+        frame = NULL;
+
+        n_frames_--;
+        space_sem_.post();
+    }
+
+    roc_log(LogDebug, "async sink: exiting background thread");
+}
+
+// Stop background thread after it writes all buffered frames.
+void AsyncSink::stop_thread_() {
+    if (!Thread::is_joinable()) {
+        return;
+    }
+
+    stop_ = 1;
+    write_sem_.post();
+
+    Thread::join();
+}
+
+void AsyncSink::wait_drained_() {
+    while (n_frames_ > 0) {
+        space_sem_.wait();
+    }
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/async_sink.h
+//! @brief Asynchronous sink.
+
+#ifndef ROC_SNDIO_ASYNC_SINK_H_
+#define ROC_SNDIO_ASYNC_SINK_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/atomic.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/spsc_ring_buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_sndio/async_config.h"
+#include "roc_sndio/isink.h"
+
+namespace roc {
+namespace sndio {
+
+//! Asynchronous sink.
+//! @remarks
+//!  Decorates another sink and writes to it from background thread.
+//!  write() copies frame into a lock-free ring buffer and returns.
+//!  Caller is blocked only when background thread didn't keep up and
+//!  buffer became full ("stall").
+//!
+//!  Intended for sinks without own clock, like files, to keep slow
+//!  disk I/O away from the thread that drives the pipeline. Sinks
+//!  with own clock are not supported.
+//!
+//!  Underlying sink is accessed only from background thread, except
+//!  construction, flush() and close(), when buffer is drained and
+//!  background thread is idle or stopped.
+class AsyncSink : public ISink, private core::Thread {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Starts background thread.
+    AsyncSink(ISink& inner_sink,
+              audio::FrameFactory& frame_factory,
+              core::IArena& arena,
+              const AsyncConfig& config);
+
+    virtual ~AsyncSink();
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Get metrics.
+    //! @remarks
+    //!  Can be called from any thread.
+    AsyncMetrics metrics() const;
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Try to cast to ISink.
+    virtual ISink* to_sink();
+
+    //! Try to cast to ISource.
+    virtual ISource* to_source();
+
+    //! Get sample specification of the sink.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get recommended frame length of the sink.
+    virtual core::nanoseconds_t frame_length() const;
+
+    //! Check if the sink supports state updates.
+    virtual bool has_state() const;
+
+    //! Check if the sink supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the sink has own clock.
+    virtual bool has_clock() const;
+
+    //! Write frame.
+    //! @remarks
+    //!  Returns error if background thread failed to write one of the
+    //!  previous frames.
+    virtual ROC_NODISCARD status::StatusCode write(audio::Frame& frame);
+
+    //! Flush buffered data.
+    //! @remarks
+    //!  Waits until background thread writes all buffered frames, and
+    //!  then flushes underlying sink.
+    virtual ROC_NODISCARD status::StatusCode flush();
+
+    //! Explicitly close the sink.
+    //! @remarks
+    //!  Waits until background thread writes all buffered frames, stops
+    //!  it, and closes underlying sink.
+    virtual ROC_NODISCARD status::StatusCode close();
+
+    //! Destroy object and return memory to arena.
+    virtual void dispose();
+
+private:
+    virtual void run();
+
+    void stop_thread_();
+    void wait_drained_();
+
+    ISink& inner_sink_;
+    audio::FrameFactory& frame_factory_;
+
+    audio::SampleSpec sample_spec_;
+    core::nanoseconds_t frame_length_;
+
+    const size_t max_frames_;
+    core::SpscRingBuffer<audio::FramePtr> ring_;
+    core::Atomic<int> n_frames_;
+
+    core::Semaphore write_sem_;
+    core::Semaphore space_sem_;
+
+    core::Atomic<int> stop_;
+    core::Atomic<int> io_status_;
+
+    core::Atomic<uint64_t> stall_count_;
+    core::Atomic<int64_t> stall_duration_;
+
+    bool closed_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_ASYNC_SINK_H_
@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/async_source.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_core/time.h"
+#include "roc_status/code_to_str.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+const core::nanoseconds_t DefaultFrameLength = 10 * core::Millisecond;
+
+// Rewind handshake between rewind() and background thread.
+enum RewindState {
+    // No rewind in progress.
+    Rewind_Idle,
+    // rewind() asked background thread to rewind underlying source.
+    Rewind_Requested,
+    // Background thread rewound source and waits until rewind()
+    // drops old frames.
+    Rewind_Done
+};
+
+core::nanoseconds_t chunk_length(const AsyncConfig& config) {
+    return config.frame_length > 0 ? config.frame_length : DefaultFrameLength;
+}
+
+size_t max_frames(const AsyncConfig& config) {
+    const core::nanoseconds_t frame_len = chunk_length(config);
+
+    size_t n_frames = 1;
+    if (config.buffer_length > frame_len) {
+        n_frames = (size_t)((config.buffer_length + frame_len - 1) / frame_len);
+    }
+
+    return n_frames;
+}
+
+} // namespace
+
+AsyncSource::AsyncSource(ISource& inner_source,
+                         audio::FrameFactory& frame_factory,
+                         core::IArena& arena,
+                         const AsyncConfig& config)
+    : IDevice(arena)
+    , ISource(arena)
+    , core::Thread(config.thread_config)
+    , inner_source_(inner_source)
+    , frame_factory_(frame_factory)
+    , sample_spec_(inner_source.sample_spec())
+    , frame_length_(inner_source.frame_length())
+    , chunk_size_(0)
+    , chunk_duration_(0)
+    , max_frames_(max_frames(config))
+    , ring_(arena, max_frames_)
+    , n_frames_(0)
+    , stop_(0)
+    , io_status_(status::NoStatus)
+    , rewind_state_(Rewind_Idle)
+    , rewind_status_(status::NoStatus)
+    , cur_pos_(0)
+    , stall_count_(0)
+    , stall_duration_(0)
+    , closed_(true)
+    , init_status_(status::NoStatus) {
+    if (inner_source.has_clock()) {
+        roc_log(LogError, "async source: sources with own clock are not supported");
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if (!sample_spec_.is_complete()) {
+        roc_panic("async source: required complete sample spec: spec=%s",
+                  audio::sample_spec_to_str(sample_spec_).c_str());
+    }
+
+    if (!ring_.is_valid()) {
+        init_status_ = status::StatusNoMem;
+        return;
+    }
+
+    chunk_duration_ = sample_spec_.ns_2_stream_timestamp(chunk_length(config));
+    chunk_size_ = sample_spec_.stream_timestamp_2_bytes(chunk_duration_);
+
+    if (chunk_size_ > frame_factory_.byte_buffer_size()) {
+        chunk_duration_ =
+            sample_spec_.bytes_2_stream_timestamp(frame_factory_.byte_buffer_size());
+        chunk_size_ = sample_spec_.stream_timestamp_2_bytes(chunk_duration_);
+    }
+
+    if (chunk_duration_ == 0) {
+        roc_log(LogError, "async source: frame length is too small");
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    roc_log(LogDebug,
+            "async source: initializing: max_frames=%lu frame_duration=%lu spec=%s",
+            (unsigned long)max_frames_, (unsigned long)chunk_duration_,
+            audio::sample_spec_to_str(sample_spec_).c_str());
+
+    if (!Thread::start()) {
+        roc_log(LogError, "async source: can't start background thread");
+        init_status_ = status::StatusErrThread;
+        return;
+    }
+
+    closed_ = false;
+    init_status_ = status::StatusOK;
+}
+
+AsyncSource::~AsyncSource() {
+    const status::StatusCode code = close();
+    if (code != status::StatusOK) {
+        roc_log(LogError, "async source: close failed: status=%s",
+                status::code_to_str(code));
+    }
+}
+
+status::StatusCode AsyncSource::init_status() const {
+    return init_status_;
+}
+
+AsyncMetrics AsyncSource::metrics() const {
+    AsyncMetrics metrics;
+
+    const int n_frames = n_frames_;
+    metrics.buffered_frames = n_frames > 0 ? (size_t)n_frames : 0;
+    metrics.max_frames = max_frames_;
+    metrics.stall_count = stall_count_;
+    metrics.stall_duration = stall_duration_;
+
+    return metrics;
+}
+
+DeviceType AsyncSource::type() const {
+    return DeviceType_Source;
+}
+
+ISink* AsyncSource::to_sink() {
+    return NULL;
+}
+
+ISource* AsyncSource::to_source() {
+    return this;
+}
+
+audio::SampleSpec AsyncSource::sample_spec() const {
+    return sample_spec_;
+}
+
+core::nanoseconds_t AsyncSource::frame_length() const {
+    return frame_length_;
+}
+
+bool AsyncSource::has_state() const {
+    return false;
+}
+
+bool AsyncSource::has_latency() const {
+    return false;
+}
+
+bool AsyncSource::has_clock() const {
+    return false;
+}
+
+status::StatusCode AsyncSource::rewind() {
+    roc_log(LogDebug, "async source: rewinding");
+
+    if (closed_) {
+        roc_panic("async source: not opened");
+    }
+
+    // Thread can't be restarted, so instead of stopping it, we ask it
+    // to rewind underlying source and wait until it's done.
+    rewind_state_ = Rewind_Requested;
+    space_sem_.post();
+
+    while (rewind_state_ != Rewind_Done) {
+        read_sem_.wait();
+    }
+
+    // Background thread is paused now, so we can safely drop frames
+    // that were read before rewind.
+    drop_frames_();
+
+    const status::StatusCode code = (status::StatusCode)(int)rewind_status_;
+
+    rewind_state_ = Rewind_Idle;
+    space_sem_.post();
+
+    return code;
+}
+
+void AsyncSource::reclock(core::nanoseconds_t timestamp) {
+    // no-op
+}
+
+status::StatusCode AsyncSource::read(audio::Frame& frame,
+                                     packet::stream_timestamp_t duration,
+                                     audio::FrameReadMode mode) {
+    if (closed_) {
+        roc_panic("async source: not opened");
+    }
+
+    if (!frame_factory_.reallocate_frame(
+            frame, sample_spec_.stream_timestamp_2_bytes(duration))) {
+        return status::StatusNoMem;
+    }
+
+    frame.set_raw(sample_spec_.is_raw());
+
+    uint8_t* frame_data = frame.bytes();
+    const size_t frame_size = frame.num_bytes();
+    size_t frame_pos = 0;
+
+    status::StatusCode code = status::StatusOK;
+
+    while (frame_pos < frame_size) {
+        if (!cur_frame_) {
+            if ((code = next_frame_()) != status::StatusOK) {
+                break;
+            }
+        }
+
+        const size_t n_bytes =
+            std::min(frame_size - frame_pos, cur_frame_->num_bytes() - cur_pos_);
+
+        memcpy(frame_data + frame_pos, cur_frame_->bytes() + cur_pos_, n_bytes);
+
+        frame_pos += n_bytes;
+        cur_pos_ += n_bytes;
+
+        if (cur_pos_ == cur_frame_->num_bytes()) {
+            cur_frame_ = NULL;
+            cur_pos_ = 0;
+        }
+    }
+
+    if (code != status::StatusOK && code != status::StatusFinish) {
+        return code;
+    }
+
+    if (frame_pos == 0) {
+        return status::StatusFinish;
+    }
+
+    frame.set_num_bytes(frame_pos);
+    frame.set_duration(sample_spec_.bytes_2_stream_timestamp(frame_pos));
+
+    if (frame.duration() < duration) {
+        return status::StatusPart;
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode AsyncSource::close() {
+    if (closed_) {
+        return status::StatusOK;
+    }
+
+    closed_ = true;
+
+    stop_thread_();
+    drop_frames_();
+
+    roc_log(LogDebug, "async source: closing: stall_count=%lu stall_duration=%.3fms",
+            (unsigned long)stall_count_,
+            (double)stall_duration_ / core::Millisecond);
+
+    return inner_source_.close();
+}
+
+void AsyncSource::dispose() {
+    arena().dispose_object(*this);
+}
+
+void AsyncSource::run() {
+    roc_log(LogDebug, "async source: running background thread");
+
+    while (!stop_) {
+        if (rewind_state_ == Rewind_Requested) {
+            handle_rewind_();
+            continue;
+        }
+
+        if (io_status_ != status::NoStatus || n_frames_ >= (int)max_frames_) {
+            // Source is finished or failed, or buffer is full, wait until
+            // reader takes a frame, requests rewind, or closes source.
+            space_sem_.wait();
+            continue;
+        }
+
+        audio::FramePtr frame = frame_factory_.allocate_frame(chunk_size_);
+        if (!frame) {
+            roc_log(LogError, "async source: can't allocate frame");
+            io_status_ = status::StatusNoMem;
+            read_sem_.post();
+            continue;
+        }
+
+        const status::StatusCode code =
+            inner_source_.read(*frame, chunk_duration_, audio::ModeHard);
+
+        if (code != status::StatusOK && code != status::StatusPart) {
+            if (code != status::StatusFinish) {
+                roc_log(LogError, "async source: can't read frame: status=%s",
+                        status::code_to_str(code));
+            }
+            io_status_ = code;
+            read_sem_.post();
+            continue;
+        }
+
+        n_frames_++;
+
+        if (!ring_.push_back(frame)) {
+            roc_panic("async source: ring buffer overflow");
+        }
+
+        read_sem_.post();
+    }
+
+    roc_log(LogDebug, "async source: exiting background thread");
+}
+
+void AsyncSource::stop_thread_() {
+    if (!Thread::is_joinable()) {
+        return;
+    }
+
+    stop_ = 1;
+    space_sem_.post();
+
+    Thread::join();
+}
+
+// Called from background thread when rewind() requests it.
+void AsyncSource::handle_rewind_() {
+    const status::StatusCode code = inner_source_.rewind();
+
+    if (code != status::StatusOK) {
+        roc_log(LogError, "async source: can't rewind source: status=%s",
+                status::code_to_str(code));
+    }
+
+    rewind_status_ = code;
+    io_status_ = code == status::StatusOK ? status::NoStatus : code;
+
+    rewind_state_ = Rewind_Done;
+    read_sem_.post();
+
+    // Don't push new frames until rewind() drops old ones.
+    while (rewind_state_ == Rewind_Done && !stop_) {
+        space_sem_.wait();
+    }
+}
+
+void AsyncSource::drop_frames_() {
+    cur_frame_ = NULL;
+    cur_pos_ = 0;
+
+    audio::FramePtr frame;
+    while (ring_.pop_front(frame)) {
+    }
+
+    n_frames_ = 0;
+}
+
+// Fetch next frame from ring buffer. If it's empty, block until
+// background thread adds a frame or reports end of stream or error.
+status::StatusCode AsyncSource::next_frame_() {
+    core::nanoseconds_t stall_start = 0;
+
+    for (;;) {
+        // Load status before checking buffer, because background thread
+        // sets status only after pushing last frame.
+        const status::StatusCode io_status = (status::StatusCode)(int)io_status_;
+
+        if (ring_.pop_front(cur_frame_)) {
+            cur_pos_ = 0;
+            n_frames_--;
+            space_sem_.post();
+            break;
+        }
+
+        if (io_status != status::NoStatus) {
+            if (stall_start != 0) {
+                stall_duration_ += core::timestamp(core::ClockMonotonic) - stall_start;
+            }
+            return io_status;
+        }
+
+        if (stall_start == 0) {
+            stall_start = core::timestamp(core::ClockMonotonic);
+            stall_count_++;
+        }
+
+        read_sem_.wait();
+    }
+
+    if (stall_start != 0) {
+        stall_duration_ += core::timestamp(core::ClockMonotonic) - stall_start;
+    }
+
+    return status::StatusOK;
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/async_source.h
+//! @brief Asynchronous source.
+
+#ifndef ROC_SNDIO_ASYNC_SOURCE_H_
+#define ROC_SNDIO_ASYNC_SOURCE_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/atomic.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/spsc_ring_buffer.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_sndio/async_config.h"
+#include "roc_sndio/isource.h"
+
+namespace roc {
+namespace sndio {
+
+//! Asynchronous source.
+//! @remarks
+//!  Decorates another source and reads from it in background thread.
+//!  Read frames are queued into a lock-free ring buffer, and read()
+//!  copies samples from there. Caller is blocked only when background
+//!  thread didn't keep up and buffer became empty ("stall").
+//!
+//!  Intended for sources without own clock, like files, to keep slow
+//!  disk I/O away from the thread that drives the pipeline. Sources
+//!  with own clock are not supported.
+//!
+//!  Underlying source is accessed only from background thread, except
+//!  construction and close(), when background thread is not running.
+class AsyncSource : public ISource, private core::Thread {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  Starts background thread.
+    AsyncSource(ISource& inner_source,
+                audio::FrameFactory& frame_factory,
+                core::IArena& arena,
+                const AsyncConfig& config);
+
+    virtual ~AsyncSource();
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Get metrics.
+    //! @remarks
+    //!  Can be called from any thread.
+    AsyncMetrics metrics() const;
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Try to cast to ISink.
+    virtual ISink* to_sink();
+
+    //! Try to cast to ISource.
+    virtual ISource* to_source();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get recommended frame length of the source.
+    virtual core::nanoseconds_t frame_length() const;
+
+    //! Check if the source supports state updates.
+    virtual bool has_state() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Restart reading from beginning.
+    //! @remarks
+    //!  Asks background thread to rewind underlying source, waits until
+    //!  it's done, and drops frames buffered before rewind.
+    virtual ROC_NODISCARD status::StatusCode rewind();
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual ROC_NODISCARD status::StatusCode read(audio::Frame& frame,
+                                                  packet::stream_timestamp_t duration,
+                                                  audio::FrameReadMode mode);
+
+    //! Explicitly close the source.
+    //! @remarks
+    //!  Stops background thread and closes underlying source.
+    virtual ROC_NODISCARD status::StatusCode close();
+
+    //! Destroy object and return memory to arena.
+    virtual void dispose();
+
+private:
+    virtual void run();
+
+    void stop_thread_();
+    void drop_frames_();
+    void handle_rewind_();
+
+    status::StatusCode next_frame_();
+
+    ISource& inner_source_;
+    audio::FrameFactory& frame_factory_;
+
+    audio::SampleSpec sample_spec_;
+    core::nanoseconds_t frame_length_;
+
+    size_t chunk_size_;
+    packet::stream_timestamp_t chunk_duration_;
+
+    const size_t max_frames_;
+    core::SpscRingBuffer<audio::FramePtr> ring_;
+    core::Atomic<int> n_frames_;
+
+    core::Semaphore read_sem_;
+    core::Semaphore space_sem_;
+
+    core::Atomic<int> stop_;
+    core::Atomic<int> io_status_;
+
+    core::Atomic<int> rewind_state_;
+    core::Atomic<int> rewind_status_;
+
+    audio::FramePtr cur_frame_;
+    size_t cur_pos_;
+
+    core::Atomic<uint64_t> stall_count_;
+    core::Atomic<int64_t> stall_duration_;
+
+    bool closed_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_ASYNC_SOURCE_H_
@@ -51,7 +51,12 @@ BackendDispatcher::BackendDispatcher(core::IPool& frame_pool,
                                      core::IPool& buffer_pool,
                                      core::IArena& arena)
     : frame_factory_(frame_pool, buffer_pool)
-    , arena_(arena) {
+    , arena_(arena)
+    , thread_safe_only_(false) {
+}
+
+void BackendDispatcher::set_thread_safe_only(bool enabled) {
+    thread_safe_only_ = enabled;
 }
 
 status::StatusCode BackendDispatcher::open_default_sink(const IoConfig& io_config,
@@ -202,11 +207,23 @@ bool BackendDispatcher::get_supported_subformats(const char* group,
     return true;
 }
 
+bool BackendDispatcher::use_backend_(const IBackend& backend) const {
+    if (thread_safe_only_ && !backend.is_thread_safe()) {
+        roc_log(LogDebug, "backend dispatcher: skipping non-thread-safe backend: %s",
+                backend.name());
+        return false;
+    }
+
+    return true;
+}
+
 status::StatusCode BackendDispatcher::open_default_device_(DeviceType device_type,
                                                            const IoConfig& io_config,
                                                            IDevice** result) {
     roc_panic_if(!result);
 
+    core::Mutex::Lock lock(BackendMap::instance().open_mutex());
+
     status::StatusCode code = status::StatusNoDriver;
 
     // Try all drivers with Driver_DefaultDevice flag.
@@ -216,7 +233,8 @@ status::StatusCode BackendDispatcher::open_default_device_(DeviceType device_typ
     for (size_t n = 0; n < BackendMap::instance().num_drivers(); n++) {
         const DriverInfo& driver_info = BackendMap::instance().nth_driver(n);
 
-        if (!match_driver(driver_info, driver_flags, NULL)) {
+        if (!match_driver(driver_info, driver_flags, NULL)
+            || !use_backend_(*driver_info.backend)) {
             continue;
         }
 
@@ -250,6 +268,8 @@ status::StatusCode BackendDispatcher::open_file_or_device_(DeviceType device_typ
     roc_panic_if(!path);
     roc_panic_if(!result);
 
+    core::Mutex::Lock lock(BackendMap::instance().open_mutex());
+
     if (strcmp(driver, "file") == 0) {
         if (io_config.latency != 0) {
             roc_log(LogError,
@@ -288,7 +308,8 @@ status::StatusCode BackendDispatcher::open_device_(DeviceType device_type,
     for (size_t n = 0; n < BackendMap::instance().num_drivers(); n++) {
         const DriverInfo& driver_info = BackendMap::instance().nth_driver(n);
 
-        if (!match_driver(driver_info, driver_flags, driver)) {
+        if (!match_driver(driver_info, driver_flags, driver)
+            || !use_backend_(*driver_info.backend)) {
             continue;
         }
 
@@ -332,7 +353,8 @@ status::StatusCode BackendDispatcher::open_file_(DeviceType device_type,
             const FormatInfo& format_info = BackendMap::instance().nth_format(n);
 
             if (!match_format(format_info, driver_flags,
-                              io_config.sample_spec.format_name())) {
+                              io_config.sample_spec.format_name())
+                || !use_backend_(*format_info.backend)) {
                 continue;
             }
 
@@ -355,6 +377,9 @@ status::StatusCode BackendDispatcher::open_file_(DeviceType device_type,
         // Try all backends.
         for (size_t n = 0; n < BackendMap::instance().num_backends(); n++) {
             IBackend& backend = BackendMap::instance().nth_backend(n);
+            if (!use_backend_(backend)) {
+                continue;
+            }
 
             code = backend.open_device(device_type, driver, path, io_config,
                                        frame_factory_, arena_, result);
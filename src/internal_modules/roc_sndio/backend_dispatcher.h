@@ -37,6 +37,14 @@ public:
                       core::IPool& buffer_pool,
                       core::IArena& arena);
 
+    //! Use only backends that allow concurrent use of devices.
+    //! @remarks
+    //!  Should be enabled if devices opened by this dispatcher may be used
+    //!  at the same time as devices opened by other threads.
+    //!  Backends that are not thread-safe (see IBackend::is_thread_safe())
+    //!  are skipped when opening devices.
+    void set_thread_safe_only(bool enabled);
+
     //! Create and open default sink.
     ROC_NODISCARD status::StatusCode open_default_sink(const IoConfig& io_config,
                                                        core::ScopedPtr<ISink>& result);
@@ -69,6 +77,8 @@ public:
                                                 core::StringList& result);
 
 private:
+    bool use_backend_(const IBackend& backend) const;
+
     status::StatusCode open_default_device_(DeviceType device_type,
                                             const IoConfig& io_config,
                                             IDevice** result);
@@ -93,6 +103,8 @@ private:
 
     audio::FrameFactory frame_factory_;
     core::IArena& arena_;
+
+    bool thread_safe_only_;
 };
 
 } // namespace sndio
@@ -50,12 +50,22 @@ const FormatInfo& BackendMap::nth_format(size_t format_index) const {
     return formats_[format_index];
 }
 
+core::Mutex& BackendMap::open_mutex() {
+    return open_mutex_;
+}
+
 void BackendMap::register_backends_() {
 #ifdef ROC_TARGET_PULSEAUDIO
     pulseaudio_backend_.reset(new (pulseaudio_backend_) PulseaudioBackend);
     add_backend_(pulseaudio_backend_.get());
 #endif // ROC_TARGET_PULSEAUDIO
 
+#ifdef ROC_TARGET_POSIX
+    // Goes before other file backends, but is used only if enabled in config.
+    mmap_backend_.reset(new (mmap_backend_) MmapBackend);
+    add_backend_(mmap_backend_.get());
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_SNDFILE
     sndfile_backend_.reset(new (sndfile_backend_) SndfileBackend);
     add_backend_(sndfile_backend_.get());
@@ -12,6 +12,7 @@
 #ifndef ROC_SNDIO_BACKEND_MAP_H_
 #define ROC_SNDIO_BACKEND_MAP_H_
 
+#include "roc_core/mutex.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/optional.h"
 #include "roc_core/singleton.h"
@@ -22,6 +23,10 @@
 #include "roc_sndio/pulseaudio_backend.h"
 #endif // ROC_TARGET_PULSEAUDIO
 
+#ifdef ROC_TARGET_POSIX
+#include "roc_sndio/mmap_backend.h"
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_SNDFILE
 #include "roc_sndio/sndfile_backend.h"
 #endif // ROC_TARGET_SNDFILE
@@ -61,6 +66,10 @@ public:
     //! Get driver by index.
     const FormatInfo& nth_format(size_t format_index) const;
 
+    //! Get mutex that serializes opening of devices.
+    //! Some backend libraries report open errors via global state.
+    core::Mutex& open_mutex();
+
 private:
     friend class core::Singleton<BackendMap>;
 
@@ -76,6 +85,10 @@ private:
     core::Optional<PulseaudioBackend> pulseaudio_backend_;
 #endif // ROC_TARGET_PULSEAUDIO
 
+#ifdef ROC_TARGET_POSIX
+    core::Optional<MmapBackend> mmap_backend_;
+#endif // ROC_TARGET_POSIX
+
 #ifdef ROC_TARGET_SNDFILE
     core::Optional<SndfileBackend> sndfile_backend_;
 #endif // ROC_TARGET_SNDFILE
@@ -89,6 +102,8 @@ private:
     core::Array<IBackend*, MaxBackends> backends_;
     core::Array<DriverInfo, MaxDrivers> drivers_;
     core::Array<FormatInfo, MaxFormats> formats_;
+
+    core::Mutex open_mutex_;
 };
 
 } // namespace sndio
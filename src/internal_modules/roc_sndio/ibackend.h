@@ -37,6 +37,12 @@ public:
     //! Returns name of backend.
     virtual const char* name() const = 0;
 
+    //! Check if devices of this backend can be used concurrently.
+    //! @remarks
+    //!  If true, different devices may be used from different threads at the
+    //!  same time. Opening of devices is serialized by BackendDispatcher anyway.
+    virtual bool is_thread_safe() const = 0;
+
     //! Append supported drivers to the list.
     virtual ROC_NODISCARD bool
     discover_drivers(core::Array<DriverInfo, MaxDrivers>& result) = 0;
@@ -20,6 +20,37 @@
 namespace roc {
 namespace sndio {
 
+//! Device buffer config.
+//! @remarks
+//!  Fine-grained tuning of device buffer, for drivers that support it
+//!  (currently PulseAudio). Negative durations mean that the driver
+//!  derives the value from latency and frame length.
+struct IoBufferConfig {
+    //! Target length of playback buffer.
+    core::nanoseconds_t target_length;
+
+    //! Minimum size of a single playback request.
+    core::nanoseconds_t min_request;
+
+    //! How much data to accumulate before starting playback.
+    core::nanoseconds_t prebuffer;
+
+    //! Size of a single recording fragment.
+    core::nanoseconds_t fragment_size;
+
+    //! Allow sound server to adjust device latency to requested buffer.
+    bool adjust_latency;
+
+    //! Initialize.
+    IoBufferConfig()
+        : target_length(-1)
+        , min_request(-1)
+        , prebuffer(-1)
+        , fragment_size(-1)
+        , adjust_latency(true) {
+    }
+};
+
 //! Sink and source config.
 struct IoConfig {
     //! Sample spec
@@ -31,11 +62,32 @@ struct IoConfig {
     //! Duration of the internal frames, in nanoseconds.
     core::nanoseconds_t frame_length;
 
+    //! Device buffer tuning.
+    IoBufferConfig buffer;
+
+    //! Exchange audio with device from driver callbacks.
+    //! @remarks
+    //!  If enabled, read() and write() don't lock driver's event loop, but
+    //!  instead use a lock-free ring buffer, which is drained or filled by
+    //!  driver callbacks. Supported only by drivers with asynchronous API
+    //!  (currently PulseAudio) and ignored by others.
+    bool callback_mode;
+
+    //! Read files via memory mapping, when supported.
+    //! @remarks
+    //!  Reduces CPU usage when reading large WAV files. Supported only for
+    //!  input WAV files on POSIX targets, and ignored otherwise. The file
+    //!  should not be truncated while it's being read, otherwise the process
+    //!  gets SIGBUS.
+    bool enable_mmap;
+
     //! Initialize.
     IoConfig()
         : sample_spec()
         , latency(0)
-        , frame_length(0) {
+        , frame_length(0)
+        , callback_mode(false)
+        , enable_mmap(false) {
     }
 };
 
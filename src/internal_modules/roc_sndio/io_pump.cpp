@@ -39,6 +39,7 @@ IoPump::IoPump(core::IPool& frame_pool,
     , was_active_(false)
     , stop_(0)
     , transferred_bytes_(0)
+    , transferred_samples_(0)
     , init_status_(status::NoStatus) {
     if (!io_config.sample_spec.is_complete() || !io_config.sample_spec.is_pcm()) {
         roc_panic("io pump: required complete sample spec with pcm format: spec=%s",
@@ -107,6 +108,10 @@ void IoPump::stop() {
     stop_ = 1;
 }
 
+core::nanoseconds_t IoPump::transferred_duration() const {
+    return sample_spec_.samples_per_chan_2_ns((size_t)transferred_samples_);
+}
+
 status::StatusCode IoPump::next_() {
     status::StatusCode code = status::NoStatus;
 
@@ -297,6 +302,7 @@ status::StatusCode IoPump::transfer_frame_(ISource& source, ISink& sink) {
     }
 
     transferred_bytes_ += frame_->num_bytes();
+    transferred_samples_ += frame_->duration();
 
     return status::StatusOK;
 }
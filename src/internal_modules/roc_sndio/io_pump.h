@@ -21,6 +21,7 @@
 #include "roc_core/noncopyable.h"
 #include "roc_core/slice.h"
 #include "roc_core/stddefs.h"
+#include "roc_core/time.h"
 #include "roc_packet/units.h"
 #include "roc_sndio/io_config.h"
 #include "roc_sndio/isink.h"
@@ -66,6 +67,11 @@ public:
     //!  May be called from any thread.
     void stop();
 
+    //! Get total duration of transferred frames.
+    //! @remarks
+    //!  Should not be called concurrently with run().
+    core::nanoseconds_t transferred_duration() const;
+
 private:
     status::StatusCode next_();
     status::StatusCode switch_source_(ISource* new_source);
@@ -91,6 +97,7 @@ private:
     core::Atomic<int> stop_;
 
     uint64_t transferred_bytes_;
+    uint64_t transferred_samples_;
 
     status::StatusCode init_status_;
 };
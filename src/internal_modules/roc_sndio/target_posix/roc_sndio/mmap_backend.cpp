@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_core/log.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_sndio/mmap_backend.h"
+#include "roc_sndio/mmap_wav_source.h"
+#include "roc_status/code_to_str.h"
+
+namespace roc {
+namespace sndio {
+
+MmapBackend::MmapBackend() {
+}
+
+const char* MmapBackend::name() const {
+    return "mmap";
+}
+
+bool MmapBackend::is_thread_safe() const {
+    return true;
+}
+
+bool MmapBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& result) {
+    if (!result.push_back(DriverInfo("file", Driver_File | Driver_SupportsSource, this))) {
+        return false;
+    }
+    return true;
+}
+
+bool MmapBackend::discover_formats(core::Array<FormatInfo, MaxFormats>& result) {
+    if (!result.push_back(
+            FormatInfo("file", "wav", Driver_File | Driver_SupportsSource, this))) {
+        return false;
+    }
+    return true;
+}
+
+bool MmapBackend::discover_subformat_groups(core::StringList& result) {
+    // no sub-formats except pcm
+    return true;
+}
+
+bool MmapBackend::discover_subformats(const char* group, core::StringList& result) {
+    // no sub-formats except pcm
+    return true;
+}
+
+status::StatusCode MmapBackend::open_device(DeviceType device_type,
+                                           const char* driver,
+                                           const char* path,
+                                           const IoConfig& io_config,
+                                           audio::FrameFactory& frame_factory,
+                                           core::IArena& arena,
+                                           IDevice** result) {
+    roc_panic_if(!driver);
+    roc_panic_if(!path);
+
+    if (!io_config.enable_mmap) {
+        // Not enabled, go to next backend.
+        return status::StatusNoDriver;
+    }
+
+    if (strcmp(driver, "file") != 0) {
+        // Not file://, go to next backend.
+        return status::StatusNoDriver;
+    }
+
+    if (device_type != DeviceType_Source) {
+        // Writing via mapping is not faster than buffered I/O, and can't
+        // report errors like disk full, go to next backend.
+        return status::StatusNoDriver;
+    }
+
+    core::ScopedPtr<MmapWavSource> source(
+        new (arena) MmapWavSource(frame_factory, arena, io_config, path));
+
+    if (!source) {
+        roc_log(LogDebug, "mmap backend: can't allocate source: path=%s", path);
+        return status::StatusNoMem;
+    }
+
+    if (source->init_status() != status::StatusOK) {
+        roc_log(LogDebug, "mmap backend: can't open source: path=%s status=%s", path,
+                status::code_to_str(source->init_status()));
+        return source->init_status();
+    }
+
+    *result = source.hijack();
+    return status::StatusOK;
+}
+
+} // namespace sndio
+} // namespace roc
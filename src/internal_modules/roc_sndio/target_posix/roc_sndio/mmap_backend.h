@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_backend.h
+//! @brief Memory-mapped WAV backend.
+
+#ifndef ROC_SNDIO_MMAP_BACKEND_H_
+#define ROC_SNDIO_MMAP_BACKEND_H_
+
+#include "roc_core/noncopyable.h"
+#include "roc_sndio/ibackend.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped WAV backend.
+//! @remarks
+//!  Reads WAV files via memory mapping instead of buffered stream I/O.
+//!  Used only when enabled via IoConfig::enable_mmap. Handles only sources
+//!  and regular files with PCM samples; everything else is left to other
+//!  backends.
+class MmapBackend : public IBackend, core::NonCopyable<> {
+public:
+    MmapBackend();
+
+    //! Returns name of backend.
+    virtual const char* name() const;
+
+    //! Check if devices of this backend can be used concurrently.
+    virtual bool is_thread_safe() const;
+
+    //! Append supported drivers to the list.
+    virtual ROC_NODISCARD bool
+    discover_drivers(core::Array<DriverInfo, MaxDrivers>& result);
+
+    //! Append supported formats to the list.
+    virtual ROC_NODISCARD bool
+    discover_formats(core::Array<FormatInfo, MaxFormats>& result);
+
+    //! Append supported groups of sub-formats to the list.
+    virtual ROC_NODISCARD bool discover_subformat_groups(core::StringList& result);
+
+    //! Append supported sub-formats of a group to the list.
+    virtual ROC_NODISCARD bool discover_subformats(const char* group,
+                                                   core::StringList& result);
+
+    //! Create and open a sink or source.
+    virtual ROC_NODISCARD status::StatusCode
+    open_device(DeviceType device_type,
+                const char* driver,
+                const char* path,
+                const IoConfig& io_config,
+                audio::FrameFactory& frame_factory,
+                core::IArena& arena,
+                IDevice** result);
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_BACKEND_H_
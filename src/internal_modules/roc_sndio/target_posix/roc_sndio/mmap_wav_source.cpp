@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <dr_wav.h>
+
+#include "roc_audio/pcm_subformat.h"
+#include "roc_audio/sample_spec_to_str.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+#include "roc_sndio/mmap_wav_source.h"
+#include "roc_status/code_to_str.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+audio::PcmSubformat wav_subformat(uint16_t format_tag, uint16_t bits_per_sample) {
+    if (format_tag == DR_WAVE_FORMAT_PCM) {
+        switch (bits_per_sample) {
+        case 8:
+            // 8-bit WAV samples are unsigned.
+            return audio::PcmSubformat_UInt8;
+        case 16:
+            return audio::PcmSubformat_SInt16_Le;
+        case 24:
+            return audio::PcmSubformat_SInt24_Le;
+        case 32:
+            return audio::PcmSubformat_SInt32_Le;
+        default:
+            break;
+        }
+    }
+
+    if (format_tag == DR_WAVE_FORMAT_IEEE_FLOAT) {
+        switch (bits_per_sample) {
+        case 32:
+            return audio::PcmSubformat_Float32_Le;
+        case 64:
+            return audio::PcmSubformat_Float64_Le;
+        default:
+            break;
+        }
+    }
+
+    return audio::PcmSubformat_Invalid;
+}
+
+} // namespace
+
+MmapWavSource::MmapWavSource(audio::FrameFactory& frame_factory,
+                             core::IArena& arena,
+                             const IoConfig& io_config,
+                             const char* path)
+    : IDevice(arena)
+    , ISource(arena)
+    , frame_factory_(frame_factory)
+    , is_raw_(false)
+    , sample_bytes_(0)
+    , fd_(-1)
+    , file_size_(0)
+    , data_begin_(0)
+    , data_end_(0)
+    , data_pos_(0)
+    , init_status_(status::NoStatus) {
+    if (io_config.sample_spec.has_format()) {
+        if (io_config.sample_spec.format() != audio::Format_Wav) {
+            roc_log(LogDebug,
+                    "mmap wav source: requested format '%s' not supported by backend:"
+                    " spec=%s",
+                    io_config.sample_spec.format_name(),
+                    audio::sample_spec_to_str(io_config.sample_spec).c_str());
+            // Not a wav file, go to next backend.
+            init_status_ = status::StatusNoFormat;
+            return;
+        }
+    }
+
+    if (io_config.sample_spec.has_subformat() || io_config.sample_spec.has_sample_rate()
+        || io_config.sample_spec.has_channel_set()) {
+        roc_log(LogError,
+                "mmap wav source: invalid io encoding: <subformat>, <rate> and <channels>"
+                " not allowed for input file when <format> is 'wav', set them to \"-\"");
+        init_status_ = status::StatusBadConfig;
+        return;
+    }
+
+    if ((init_status_ = open_(path)) != status::StatusOK) {
+        return;
+    }
+
+    init_status_ = status::StatusOK;
+}
+
+MmapWavSource::~MmapWavSource() {
+    const status::StatusCode code = close();
+    if (code != status::StatusOK) {
+        roc_log(LogError, "mmap wav source: close failed: status=%s",
+                status::code_to_str(code));
+    }
+}
+
+status::StatusCode MmapWavSource::init_status() const {
+    return init_status_;
+}
+
+DeviceType MmapWavSource::type() const {
+    return DeviceType_Source;
+}
+
+ISink* MmapWavSource::to_sink() {
+    return NULL;
+}
+
+ISource* MmapWavSource::to_source() {
+    return this;
+}
+
+audio::SampleSpec MmapWavSource::sample_spec() const {
+    if (fd_ == -1) {
+        roc_panic("mmap wav source: not opened");
+    }
+
+    return sample_spec_;
+}
+
+core::nanoseconds_t MmapWavSource::frame_length() const {
+    return 0;
+}
+
+bool MmapWavSource::has_state() const {
+    return false;
+}
+
+bool MmapWavSource::has_latency() const {
+    return false;
+}
+
+bool MmapWavSource::has_clock() const {
+    return false;
+}
+
+status::StatusCode MmapWavSource::rewind() {
+    roc_log(LogDebug, "mmap wav source: rewinding");
+
+    if (fd_ == -1) {
+        roc_panic("mmap wav source: not opened");
+    }
+
+    data_pos_ = data_begin_;
+
+    return status::StatusOK;
+}
+
+void MmapWavSource::reclock(core::nanoseconds_t timestamp) {
+    // no-op
+}
+
+status::StatusCode MmapWavSource::read(audio::Frame& frame,
+                                       packet::stream_timestamp_t duration,
+                                       audio::FrameReadMode mode) {
+    if (fd_ == -1) {
+        roc_panic("mmap wav source: not opened");
+    }
+
+    if (data_pos_ == data_end_) {
+        return status::StatusFinish;
+    }
+
+    if (!frame_factory_.reallocate_frame(
+            frame, sample_spec_.stream_timestamp_2_bytes(duration))) {
+        return status::StatusNoMem;
+    }
+
+    frame.set_raw(true);
+
+    const size_t frame_bytes = frame.num_raw_samples() * sizeof(audio::sample_t);
+    const size_t frame_size = std::min(frame.num_raw_samples(),
+                                       (size_t)((data_end_ - data_pos_) / sample_bytes_));
+
+    size_t frame_pos = 0;
+
+    while (frame_pos < frame_size) {
+        // Move window if it doesn't have at least one sample at current position.
+        if (!window_->map(data_pos_, sample_bytes_, file_size_)) {
+            roc_log(LogError, "mmap wav source: can't map input file");
+            return status::StatusErrFile;
+        }
+
+        const uint64_t n_bytes =
+            std::min((uint64_t)window_->available(data_pos_), data_end_ - data_pos_);
+        const size_t n_samples =
+            std::min(frame_size - frame_pos, (size_t)(n_bytes / sample_bytes_));
+
+        if (is_raw_) {
+            memcpy(frame.raw_samples() + frame_pos, window_->at(data_pos_),
+                   n_samples * sample_bytes_);
+        } else {
+            size_t in_bit_off = 0;
+            size_t out_bit_off = frame_pos * sizeof(audio::sample_t) * 8;
+
+            const size_t n_mapped = pcm_mapper_->map(
+                window_->at(data_pos_), n_samples * sample_bytes_, in_bit_off,
+                frame.raw_samples(), frame_bytes, out_bit_off, n_samples);
+
+            roc_panic_if_msg(n_mapped != n_samples,
+                             "mmap wav source: unexpected number of mapped samples:"
+                             " expected=%lu actual=%lu",
+                             (unsigned long)n_samples, (unsigned long)n_mapped);
+        }
+
+        frame_pos += n_samples;
+        data_pos_ += n_samples * sample_bytes_;
+    }
+
+    if (data_pos_ == data_end_) {
+        roc_log(LogDebug, "mmap wav source: got eof from input file");
+    }
+
+    if (frame_size == 0) {
+        return status::StatusFinish;
+    }
+
+    frame.set_num_raw_samples(frame_size);
+    frame.set_duration(
+        packet::stream_timestamp_t(frame_size / sample_spec_.num_channels()));
+
+    if (frame.duration() < duration) {
+        return status::StatusPart;
+    }
+
+    return status::StatusOK;
+}
+
+status::StatusCode MmapWavSource::close() {
+    return close_();
+}
+
+void MmapWavSource::dispose() {
+    arena().dispose_object(*this);
+}
+
+status::StatusCode MmapWavSource::open_(const char* path) {
+    roc_log(LogDebug, "mmap wav source: opening: path=%s", path);
+
+    if (strcmp(path, "-") == 0) {
+        // Stdin can't be mapped, go to next backend.
+        roc_log(LogDebug, "mmap wav source: can't map stdin");
+        return status::StatusNoFormat;
+    }
+
+    if ((fd_ = ::open(path, O_RDONLY | O_CLOEXEC)) == -1) {
+        roc_log(LogError, "mmap wav source: can't open input file: %s",
+                core::errno_to_str(errno).c_str());
+        return status::StatusErrFile;
+    }
+
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        roc_log(LogError, "mmap wav source: can't stat input file: %s",
+                core::errno_to_str(errno).c_str());
+        (void)close_();
+        return status::StatusErrFile;
+    }
+
+    if (!S_ISREG(st.st_mode)) {
+        // Pipes and devices can't be mapped, go to next backend.
+        roc_log(LogDebug, "mmap wav source: input is not a regular file");
+        (void)close_();
+        return status::StatusNoFormat;
+    }
+
+    file_size_ = (uint64_t)st.st_size;
+
+    window_.reset(new (window_) MmapWindow(fd_, WindowSize));
+
+    const status::StatusCode code = parse_header_();
+    if (code != status::StatusOK) {
+        (void)close_();
+        return code;
+    }
+
+    roc_log(LogInfo, "mmap wav source: opened input file: %s",
+            audio::sample_spec_to_str(sample_spec_).c_str());
+
+    return status::StatusOK;
+}
+
+status::StatusCode MmapWavSource::parse_header_() {
+    // Header is expected to be in the first window.
+    const size_t header_size = (size_t)std::min(file_size_, (uint64_t)WindowSize);
+
+    if (header_size == 0) {
+        roc_log(LogDebug, "mmap wav source: input file is empty");
+        return status::StatusNoFormat;
+    }
+
+    if (!window_->map(0, header_size, file_size_)) {
+        roc_log(LogError, "mmap wav source: can't map input file");
+        return status::StatusErrFile;
+    }
+
+    drwav wav;
+    if (!drwav_init_memory(&wav, window_->at(0), header_size, NULL)) {
+        roc_log(LogDebug, "mmap wav source: can't recognize input file format");
+        return status::StatusNoFormat;
+    }
+
+    const drwav_container container = wav.container;
+    const audio::PcmSubformat subformat =
+        wav_subformat(wav.translatedFormatTag, wav.bitsPerSample);
+    const size_t num_channels = wav.channels;
+    const size_t sample_rate = wav.sampleRate;
+    const size_t block_align = wav.fmt.blockAlign;
+
+    data_begin_ = wav.dataChunkDataPos;
+    data_end_ = std::min(data_begin_ + (uint64_t)wav.dataChunkDataSize, file_size_);
+
+    (void)drwav_uninit(&wav);
+
+    if (container != drwav_container_riff || subformat == audio::PcmSubformat_Invalid) {
+        // Compressed or exotic file, go to next backend.
+        roc_log(LogDebug, "mmap wav source: unsupported wav encoding");
+        return status::StatusNoFormat;
+    }
+
+    sample_bytes_ = audio::pcm_subformat_traits(subformat).bit_width / 8;
+
+    if (block_align != sample_bytes_ * num_channels) {
+        roc_log(LogDebug, "mmap wav source: unsupported wav block alignment");
+        return status::StatusNoFormat;
+    }
+
+    // Ignore trailing incomplete frame.
+    data_end_ = data_begin_ + (data_end_ - data_begin_) / block_align * block_align;
+    data_pos_ = data_begin_;
+
+    pcm_mapper_.reset(new (pcm_mapper_)
+                          audio::PcmMapper(subformat, audio::PcmSubformat_Raw));
+
+    is_raw_ = audio::pcm_subformat_traits(subformat).native_alias
+        == audio::PcmSubformat_Raw;
+
+    sample_spec_.set_format(audio::Format_Pcm);
+    sample_spec_.set_pcm_subformat(audio::PcmSubformat_Raw);
+    sample_spec_.set_sample_rate(sample_rate);
+    sample_spec_.channel_set().set_layout(audio::ChanLayout_Surround);
+    sample_spec_.channel_set().set_order(audio::ChanOrder_Smpte);
+    sample_spec_.channel_set().set_count(num_channels);
+
+    return status::StatusOK;
+}
+
+status::StatusCode MmapWavSource::close_() {
+    if (fd_ == -1) {
+        return status::StatusOK;
+    }
+
+    roc_log(LogDebug, "mmap wav source: closing input file");
+
+    status::StatusCode code = status::StatusOK;
+
+    if (window_) {
+        if (!window_->unmap()) {
+            code = status::StatusErrFile;
+        }
+        window_.reset();
+    }
+
+    if (::close(fd_) != 0) {
+        roc_log(LogError, "mmap wav source: can't properly close input file: %s",
+                core::errno_to_str(errno).c_str());
+        code = status::StatusErrFile;
+    }
+    fd_ = -1;
+
+    return code;
+}
+
+} // namespace sndio
+} // namespace roc
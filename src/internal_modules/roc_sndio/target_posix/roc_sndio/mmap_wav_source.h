@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_wav_source.h
+//! @brief Memory-mapped WAV source.
+
+#ifndef ROC_SNDIO_MMAP_WAV_SOURCE_H_
+#define ROC_SNDIO_MMAP_WAV_SOURCE_H_
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/pcm_mapper.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_sndio/io_config.h"
+#include "roc_sndio/isource.h"
+#include "roc_sndio/mmap_window.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped WAV source.
+//! @remarks
+//!  Reads samples from input WAV file mapped into memory. Samples are
+//!  converted to raw format directly from the mapping into frame buffer,
+//!  without intermediate copies. If samples in file are already in raw
+//!  format, they're just copied.
+//!
+//!  Only regular files with PCM integer or float samples are supported.
+//!  For other files, StatusNoFormat is reported, so that another backend
+//!  can be tried.
+//!
+//!  If the file is truncated by another process while it's being read,
+//!  accessing the mapping causes SIGBUS. This is why the source is used
+//!  only when explicitly enabled.
+class MmapWavSource : public ISource, private core::NonCopyable<> {
+public:
+    //! Initialize.
+    MmapWavSource(audio::FrameFactory& frame_factory,
+                  core::IArena& arena,
+                  const IoConfig& io_config,
+                  const char* path);
+    ~MmapWavSource();
+
+    //! Check if the object was successfully constructed.
+    status::StatusCode init_status() const;
+
+    //! Get device type.
+    virtual DeviceType type() const;
+
+    //! Try to cast to ISink.
+    virtual ISink* to_sink();
+
+    //! Try to cast to ISource.
+    virtual ISource* to_source();
+
+    //! Get sample specification of the source.
+    virtual audio::SampleSpec sample_spec() const;
+
+    //! Get recommended frame length of the source.
+    virtual core::nanoseconds_t frame_length() const;
+
+    //! Check if the source supports state updates.
+    virtual bool has_state() const;
+
+    //! Check if the source supports latency reports.
+    virtual bool has_latency() const;
+
+    //! Check if the source has own clock.
+    virtual bool has_clock() const;
+
+    //! Restart reading from beginning.
+    virtual ROC_NODISCARD status::StatusCode rewind();
+
+    //! Adjust source clock to match consumer clock.
+    virtual void reclock(core::nanoseconds_t timestamp);
+
+    //! Read frame.
+    virtual ROC_NODISCARD status::StatusCode read(audio::Frame& frame,
+                                                  packet::stream_timestamp_t duration,
+                                                  audio::FrameReadMode mode);
+
+    //! Explicitly close the source.
+    virtual ROC_NODISCARD status::StatusCode close();
+
+    //! Destroy object and return memory to arena.
+    virtual void dispose();
+
+private:
+    enum { WindowSize = 8 * 1024 * 1024 };
+
+    status::StatusCode open_(const char* path);
+    status::StatusCode parse_header_();
+    status::StatusCode close_();
+
+    audio::FrameFactory& frame_factory_;
+
+    audio::SampleSpec sample_spec_;
+
+    core::Optional<audio::PcmMapper> pcm_mapper_;
+    bool is_raw_;
+    size_t sample_bytes_;
+
+    int fd_;
+    core::Optional<MmapWindow> window_;
+
+    uint64_t file_size_;
+    uint64_t data_begin_;
+    uint64_t data_end_;
+    uint64_t data_pos_;
+
+    status::StatusCode init_status_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_WAV_SOURCE_H_
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_sndio/mmap_window.h"
+#include "roc_core/errno_to_str.h"
+#include "roc_core/log.h"
+#include "roc_core/panic.h"
+
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace roc {
+namespace sndio {
+
+MmapWindow::MmapWindow(int fd, size_t window_size)
+    : fd_(fd)
+    , window_size_(window_size)
+    , page_size_(0)
+    , data_(NULL)
+    , offset_(0)
+    , size_(0) {
+    const long page_size = sysconf(_SC_PAGESIZE);
+    page_size_ = page_size > 0 ? (size_t)page_size : 4096;
+}
+
+MmapWindow::~MmapWindow() {
+    if (!unmap()) {
+        roc_log(LogError, "mmap window: can't unmap window on destruction");
+    }
+}
+
+bool MmapWindow::map(uint64_t offset, size_t size, uint64_t file_size) {
+    roc_panic_if_msg(offset + size > file_size,
+                     "mmap window: requested range is outside of file:"
+                     " offset=%llu size=%lu file_size=%llu",
+                     (unsigned long long)offset, (unsigned long)size,
+                     (unsigned long long)file_size);
+
+    if (data_ && offset >= offset_ && offset + size <= offset_ + size_) {
+        return true;
+    }
+
+    if (!unmap()) {
+        return false;
+    }
+
+    // Mapping offset must be page-aligned.
+    const uint64_t map_offset = offset - offset % page_size_;
+
+    size_t map_size = std::max(window_size_, size + (size_t)(offset - map_offset));
+    map_size = (map_size + page_size_ - 1) / page_size_ * page_size_;
+
+    if (map_offset + map_size > file_size) {
+        // Accessing pages beyond end of file causes SIGBUS.
+        map_size = (size_t)(file_size - map_offset);
+    }
+
+    if (map_size == 0) {
+        return true;
+    }
+
+    void* data = mmap(NULL, map_size, PROT_READ, MAP_SHARED, fd_, (off_t)map_offset);
+    if (data == MAP_FAILED) {
+        roc_log(LogError, "mmap window: mmap(): offset=%llu size=%lu: %s",
+                (unsigned long long)map_offset, (unsigned long)map_size,
+                core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    if (madvise(data, map_size, MADV_SEQUENTIAL) != 0) {
+        roc_log(LogDebug, "mmap window: madvise(): %s",
+                core::errno_to_str(errno).c_str());
+    }
+
+    data_ = (uint8_t*)data;
+    offset_ = map_offset;
+    size_ = map_size;
+
+    return true;
+}
+
+bool MmapWindow::unmap() {
+    if (!data_) {
+        return true;
+    }
+
+    void* data = data_;
+    const size_t size = size_;
+
+    data_ = NULL;
+    offset_ = 0;
+    size_ = 0;
+
+    if (munmap(data, size) != 0) {
+        roc_log(LogError, "mmap window: munmap(): %s", core::errno_to_str(errno).c_str());
+        return false;
+    }
+
+    return true;
+}
+
+const uint8_t* MmapWindow::at(uint64_t offset) const {
+    roc_panic_if_msg(!data_ || offset < offset_ || offset >= offset_ + size_,
+                     "mmap window: offset is outside of mapping:"
+                     " offset=%llu map_offset=%llu map_size=%lu",
+                     (unsigned long long)offset, (unsigned long long)offset_,
+                     (unsigned long)size_);
+
+    return data_ + (offset - offset_);
+}
+
+size_t MmapWindow::available(uint64_t offset) const {
+    if (!data_ || offset < offset_ || offset >= offset_ + size_) {
+        return 0;
+    }
+
+    return (size_t)(offset_ + size_ - offset);
+}
+
+} // namespace sndio
+} // namespace roc
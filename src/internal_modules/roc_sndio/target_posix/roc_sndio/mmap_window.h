@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_sndio/target_posix/roc_sndio/mmap_window.h
+//! @brief Memory-mapped file window.
+
+#ifndef ROC_SNDIO_MMAP_WINDOW_H_
+#define ROC_SNDIO_MMAP_WINDOW_H_
+
+#include "roc_core/attributes.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace sndio {
+
+//! Memory-mapped file window.
+//! @remarks
+//!  Maps a part of file into memory, and moves mapping forward when
+//!  requested range is not covered by current mapping. This allows to
+//!  process files larger than address space, while keeping the number of
+//!  system calls low.
+//! @note
+//!  Mapping is read-only and is created with sequential access hint, so that
+//!  kernel can read ahead more aggressively and drop pages that were already
+//!  processed.
+class MmapWindow : public core::NonCopyable<> {
+public:
+    //! Initialize.
+    //! @remarks
+    //!  @p fd should be opened for reading and remain open while window is
+    //!  mapped. @p window_size is the preferred size of mapping.
+    MmapWindow(int fd, size_t window_size);
+
+    ~MmapWindow();
+
+    //! Ensure that given range of file is mapped.
+    //! @remarks
+    //!  If the range is not covered by current mapping, creates a new
+    //!  mapping starting from the page containing @p offset. The mapping
+    //!  is at least @p size bytes long, but is never extended beyond
+    //!  @p file_size, which should be the current size of the file.
+    //! @returns
+    //!  false if mapping failed.
+    ROC_NODISCARD bool map(uint64_t offset, size_t size, uint64_t file_size);
+
+    //! Unmap current mapping, if any.
+    ROC_NODISCARD bool unmap();
+
+    //! Get pointer to the byte at given file offset.
+    //! @pre
+    //!  Offset should be inside current mapping.
+    const uint8_t* at(uint64_t offset) const;
+
+    //! Get number of mapped bytes starting from given file offset.
+    //! @returns
+    //!  zero if offset is outside of current mapping.
+    size_t available(uint64_t offset) const;
+
+private:
+    const int fd_;
+    const size_t window_size_;
+    size_t page_size_;
+
+    uint8_t* data_;
+    uint64_t offset_;
+    size_t size_;
+};
+
+} // namespace sndio
+} // namespace roc
+
+#endif // ROC_SNDIO_MMAP_WINDOW_H_
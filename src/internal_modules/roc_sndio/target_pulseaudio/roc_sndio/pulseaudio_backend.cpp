@@ -24,6 +24,10 @@ const char* PulseaudioBackend::name() const {
     return "pulseaudio";
 }
 
+bool PulseaudioBackend::is_thread_safe() const {
+    return true;
+}
+
 bool PulseaudioBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& result) {
     if (!result.push_back(DriverInfo("pulse",
                                      Driver_Device | Driver_DefaultDevice
@@ -34,6 +34,25 @@ const core::nanoseconds_t DefaultFrameLength = 10 * core::Millisecond;
 const core::nanoseconds_t MinTimeout = core::Millisecond * 50;
 const core::nanoseconds_t MaxTimeout = core::Second * 2;
 
+// Minimum number of chunks in ring buffer used in callback mode.
+const size_t MinRingChunks = 2;
+
+// In callback mode, stream is restarted if there were no callbacks during
+// this time. Stream callbacks may be as rare as the buffer size, which is
+// why we don't use timeout derived from latency here.
+const core::nanoseconds_t CallbackTimeout = MaxTimeout;
+
+uint32_t duration_2_bytes(const audio::SampleSpec& sample_spec,
+                          core::nanoseconds_t duration,
+                          uint32_t default_value) {
+    if (duration < 0) {
+        return default_value;
+    }
+
+    return (uint32_t)sample_spec.stream_timestamp_2_bytes(
+        sample_spec.ns_2_stream_timestamp(duration));
+}
+
 audio::PcmSubformat from_pulse_format(pa_sample_format fmt) {
     switch (fmt) {
     case PA_SAMPLE_U8:
@@ -140,6 +159,8 @@ PulseaudioDevice::PulseaudioDevice(audio::FrameFactory& frame_factory,
     , target_latency_samples_(0)
     , timeout_ns_(0)
     , timeout_samples_(0)
+    , buffer_config_(io_config.buffer)
+    , callback_mode_(io_config.callback_mode)
     , record_frag_data_(NULL)
     , record_frag_size_(0)
     , record_frag_flag_(false)
@@ -151,6 +172,20 @@ PulseaudioDevice::PulseaudioDevice(audio::FrameFactory& frame_factory,
     , stream_(NULL)
     , timer_(NULL)
     , timer_deadline_ns_(0)
+    , ring_chunk_size_(0)
+    , ring_n_chunks_(0)
+    , ring_fill_(0)
+    , ring_open_(0)
+    , ring_broken_(0)
+    , user_chunk_(NULL)
+    , user_chunk_pos_(0)
+    , cb_chunk_(NULL)
+    , cb_chunk_pos_(0)
+    , cb_started_(false)
+    , n_underruns_(0)
+    , n_overruns_(0)
+    , measured_latency_(0)
+    , has_measured_latency_(0)
     , rate_limiter_(ReportInterval, 1)
     , init_status_(status::NoStatus) {
     if (io_config.sample_spec.has_format()
@@ -303,6 +338,13 @@ bool PulseaudioDevice::has_latency() const {
 core::nanoseconds_t PulseaudioDevice::latency() const {
     want_mainloop_();
 
+    if (callback_mode_) {
+        if (!has_measured_latency_) {
+            return target_latency_ns_;
+        }
+        return (core::nanoseconds_t)measured_latency_ + ring_latency_();
+    }
+
     pa_threaded_mainloop_lock(mainloop_);
 
     core::nanoseconds_t latency = 0;
@@ -322,6 +364,34 @@ bool PulseaudioDevice::has_clock() const {
     return true;
 }
 
+PulseaudioMetrics PulseaudioDevice::metrics() const {
+    want_mainloop_();
+
+    PulseaudioMetrics metrics;
+
+    if (callback_mode_) {
+        metrics.underrun_count = n_underruns_;
+        metrics.overrun_count = n_overruns_;
+        if (has_measured_latency_) {
+            metrics.stream_latency = (core::nanoseconds_t)measured_latency_;
+        }
+        metrics.ring_latency = ring_latency_();
+        return metrics;
+    }
+
+    pa_threaded_mainloop_lock(mainloop_);
+
+    if (stream_ && pa_stream_get_timing_info(stream_)) {
+        if (!get_latency_(metrics.stream_latency)) {
+            metrics.stream_latency = 0;
+        }
+    }
+
+    pa_threaded_mainloop_unlock(mainloop_);
+
+    return metrics;
+}
+
 status::StatusCode PulseaudioDevice::rewind() {
     close_();
 
@@ -353,16 +423,40 @@ status::StatusCode PulseaudioDevice::read(audio::Frame& frame,
     frame.set_raw(sample_spec_.is_raw());
     frame.set_duration(duration);
 
+    if (callback_mode_) {
+        return handle_ring_request_(frame.bytes(), frame.num_bytes());
+    }
+
     return handle_request_(frame.bytes(), frame.num_bytes());
 }
 
 status::StatusCode PulseaudioDevice::write(audio::Frame& frame) {
     roc_panic_if(device_type_ != DeviceType_Sink);
 
+    if (callback_mode_) {
+        return handle_ring_request_(frame.bytes(), frame.num_bytes());
+    }
+
     return handle_request_(frame.bytes(), frame.num_bytes());
 }
 
 status::StatusCode PulseaudioDevice::flush() {
+    if (!callback_mode_ || device_type_ != DeviceType_Sink || !ring_open_) {
+        return status::StatusOK;
+    }
+
+    // Publish partially filled chunk, padding it with silence,
+    // so that playback callback doesn't wait for the rest of it.
+    if (user_chunk_ && user_chunk_pos_ != 0) {
+        pa_silence_memory(user_chunk_ + user_chunk_pos_,
+                          ring_chunk_size_ - user_chunk_pos_, &stream_spec_);
+
+        ring_->end_write();
+        user_chunk_ = NULL;
+        user_chunk_pos_ = 0;
+        ring_fill_++;
+    }
+
     return status::StatusOK;
 }
 
@@ -422,6 +516,61 @@ status::StatusCode PulseaudioDevice::handle_request_(uint8_t* data, size_t size)
     return status::StatusOK;
 }
 
+// Used instead of handle_request_() in callback mode.
+// Exchanges data with ring buffer and doesn't lock mainloop, unless
+// the stream is closed or broken and should be restarted.
+status::StatusCode PulseaudioDevice::handle_ring_request_(uint8_t* data, size_t size) {
+    want_mainloop_();
+
+    while (size > 0) {
+        if (!ring_open_) {
+            pa_threaded_mainloop_lock(mainloop_);
+
+            const status::StatusCode code = open_status_;
+
+            pa_threaded_mainloop_unlock(mainloop_);
+
+            if (code != status::StatusOK) {
+                return code;
+            }
+        }
+
+        if (ring_broken_) {
+            roc_log(LogInfo, "pulseaudio %s: restarting stream",
+                    device_type_to_str(device_type_));
+
+            close_();
+
+            const status::StatusCode code = open_();
+
+            if (code != status::StatusOK) {
+                roc_log(LogError, "pulseaudio %s: can't restart stream: status=%s",
+                        device_type_to_str(device_type_), code_to_str(code));
+
+                return code;
+            }
+
+            continue;
+        }
+
+        const size_t n_bytes = device_type_ == DeviceType_Sink
+            ? write_ring_(data, size)
+            : read_ring_(data, size);
+
+        if (n_bytes == 0) {
+            // Ring buffer is full (sink) or empty (source), wait until
+            // stream callback makes progress or reports failure.
+            ring_sem_.wait();
+            continue;
+        }
+
+        data += n_bytes;
+        size -= n_bytes;
+    }
+
+    return status::StatusOK;
+}
+
 void PulseaudioDevice::want_mainloop_() const {
     if (!mainloop_) {
         roc_panic("pulseaudio %s: can't use unopened device",
@@ -493,6 +642,13 @@ void PulseaudioDevice::close_() {
     open_done_ = false;
     open_status_ = status::NoStatus;
 
+    if (callback_mode_) {
+        ring_open_ = 0;
+        reset_ring_();
+        // Wake up read() or write(), if it's waiting.
+        ring_sem_.post();
+    }
+
     pa_threaded_mainloop_unlock(mainloop_);
 }
 
@@ -508,6 +664,13 @@ void PulseaudioDevice::set_open_status_(status::StatusCode code) {
     open_done_ = true;
     open_status_ = code;
 
+    if (callback_mode_ && code == status::StatusOK) {
+        ring_broken_ = 0;
+        ring_open_ = 1;
+        // Watchdog for stream callbacks, restarted by every callback.
+        start_timer_(CallbackTimeout);
+    }
+
     pa_threaded_mainloop_signal(mainloop_, 0);
 }
 
@@ -749,9 +912,12 @@ bool PulseaudioDevice::init_stream_params_(const pa_sample_spec& device_spec) {
     switch (device_type_) {
     case DeviceType_Sink:
         buff_attrs_.maxlength = (uint32_t)-1;
-        buff_attrs_.tlength = (uint32_t)target_latency_bytes;
-        buff_attrs_.prebuf = (uint32_t)-1;
-        buff_attrs_.minreq = (uint32_t)frame_len_bytes;
+        buff_attrs_.tlength = duration_2_bytes(
+            sample_spec_, buffer_config_.target_length, (uint32_t)target_latency_bytes);
+        buff_attrs_.prebuf =
+            duration_2_bytes(sample_spec_, buffer_config_.prebuffer, (uint32_t)-1);
+        buff_attrs_.minreq = duration_2_bytes(sample_spec_, buffer_config_.min_request,
+                                              (uint32_t)frame_len_bytes);
         buff_attrs_.fragsize = 0;
         break;
 
@@ -760,10 +926,17 @@ bool PulseaudioDevice::init_stream_params_(const pa_sample_spec& device_spec) {
         buff_attrs_.tlength = 0;
         buff_attrs_.prebuf = 0;
         buff_attrs_.minreq = 0;
-        buff_attrs_.fragsize = (uint32_t)target_latency_bytes;
+        buff_attrs_.fragsize = duration_2_bytes(
+            sample_spec_, buffer_config_.fragment_size, (uint32_t)target_latency_bytes);
         break;
     }
 
+    if (callback_mode_) {
+        if (!init_ring_(frame_len_bytes)) {
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -786,12 +959,21 @@ bool PulseaudioDevice::open_stream_() {
 
     const pa_stream_flags_t flags = pa_stream_flags_t(
         // adjust device latency based on requested stream latency
-        PA_STREAM_ADJUST_LATENCY
+        (buffer_config_.adjust_latency ? PA_STREAM_ADJUST_LATENCY : 0)
         // periodically send updated latency from server to client
         | PA_STREAM_AUTO_TIMING_UPDATE
         // interpolate actual latency instead of going to server each time
         | PA_STREAM_INTERPOLATE_TIMING);
 
+    roc_log(LogDebug,
+            "pulseaudio %s: buffer attributes:"
+            " maxlength=%ld tlength=%ld prebuf=%ld minreq=%ld fragsize=%ld"
+            " adjust_latency=%d callback_mode=%d",
+            device_type_to_str(device_type_), (long)(int32_t)buff_attrs_.maxlength,
+            (long)(int32_t)buff_attrs_.tlength, (long)(int32_t)buff_attrs_.prebuf,
+            (long)(int32_t)buff_attrs_.minreq, (long)(int32_t)buff_attrs_.fragsize,
+            (int)buffer_config_.adjust_latency, (int)callback_mode_);
+
     pa_stream_set_state_callback(stream_, stream_state_cb_, this);
 
     switch (device_type_) {
@@ -985,12 +1167,19 @@ void PulseaudioDevice::stream_state_cb_(pa_stream* stream, void* userdata) {
     roc_log(LogTrace, "pulseaudio %s: stream state callback",
             device_type_to_str(self.device_type_));
 
+    const pa_stream_state_t state = pa_stream_get_state(stream);
+
     if (self.open_done_) {
+        if (self.callback_mode_
+            && (state == PA_STREAM_FAILED || state == PA_STREAM_TERMINATED)) {
+            roc_log(LogError, "pulseaudio %s: stream failed",
+                    device_type_to_str(self.device_type_));
+
+            self.set_ring_broken_();
+        }
         return;
     }
 
-    const pa_stream_state_t state = pa_stream_get_state(stream);
-
     switch (state) {
     case PA_STREAM_READY:
         roc_log(LogTrace, "pulseaudio %s: successfully opened stream",
@@ -1020,11 +1209,304 @@ void PulseaudioDevice::stream_request_cb_(pa_stream*, size_t length, void* userd
     roc_log(LogTrace, "pulseaudio %s: stream request callback",
             device_type_to_str(self.device_type_));
 
+    if (self.callback_mode_) {
+        if (!self.ring_open_) {
+            return;
+        }
+
+        switch (self.device_type_) {
+        case DeviceType_Sink:
+            self.playback_callback_(length);
+            break;
+
+        case DeviceType_Source:
+            self.record_callback_();
+            break;
+        }
+
+        return;
+    }
+
     if (length != 0) {
         pa_threaded_mainloop_signal(self.mainloop_, 0);
     }
 }
 
+bool PulseaudioDevice::init_ring_(size_t chunk_size) {
+    if (ring_) {
+        // Chunk size depends only on frame length and sample spec,
+        // which are not changed when stream is restarted.
+        roc_panic_if(chunk_size != ring_chunk_size_);
+        return true;
+    }
+
+    // Ring buffer should be able to hold at least one stream request,
+    // plus one chunk that is being filled or drained by user.
+    const size_t request_size = device_type_ == DeviceType_Sink
+        ? (size_t)buff_attrs_.minreq
+        : (size_t)buff_attrs_.fragsize;
+
+    ring_chunk_size_ = chunk_size;
+    ring_n_chunks_ = (request_size + chunk_size - 1) / chunk_size + 1;
+
+    if (ring_n_chunks_ < MinRingChunks) {
+        ring_n_chunks_ = MinRingChunks;
+    }
+
+    roc_log(LogDebug,
+            "pulseaudio %s: initializing ring buffer: chunk_size=%lu n_chunks=%lu",
+            device_type_to_str(device_type_), (unsigned long)ring_chunk_size_,
+            (unsigned long)ring_n_chunks_);
+
+    ring_.reset(new (ring_)
+                    core::SpscByteBuffer(arena(), ring_chunk_size_, ring_n_chunks_));
+
+    if (!ring_->is_valid()) {
+        roc_log(LogError, "pulseaudio %s: can't allocate ring buffer",
+                device_type_to_str(device_type_));
+        return false;
+    }
+
+    return true;
+}
+
+// Called with mainloop locked, when neither stream callbacks, nor
+// read() and write() can access ring buffer.
+void PulseaudioDevice::reset_ring_() {
+    if (!ring_) {
+        return;
+    }
+
+    while (ring_->begin_read()) {
+        ring_->end_read();
+    }
+
+    user_chunk_ = NULL;
+    user_chunk_pos_ = 0;
+
+    cb_chunk_ = NULL;
+    cb_chunk_pos_ = 0;
+    cb_started_ = false;
+
+    ring_fill_ = 0;
+}
+
+void PulseaudioDevice::set_ring_broken_() {
+    ring_broken_ = 1;
+    ring_sem_.post();
+}
+
+size_t PulseaudioDevice::write_ring_(const uint8_t* data, size_t size) {
+    size_t pos = 0;
+
+    while (pos < size) {
+        if (!user_chunk_) {
+            if (!(user_chunk_ = ring_->begin_write())) {
+                break;
+            }
+            user_chunk_pos_ = 0;
+        }
+
+        const size_t n_bytes = std::min(size - pos, ring_chunk_size_ - user_chunk_pos_);
+
+        memcpy(user_chunk_ + user_chunk_pos_, data + pos, n_bytes);
+
+        pos += n_bytes;
+        user_chunk_pos_ += n_bytes;
+
+        if (user_chunk_pos_ == ring_chunk_size_) {
+            ring_->end_write();
+            user_chunk_ = NULL;
+            user_chunk_pos_ = 0;
+            ring_fill_++;
+        }
+    }
+
+    return pos;
+}
+
+size_t PulseaudioDevice::read_ring_(uint8_t* data, size_t size) {
+    size_t pos = 0;
+
+    while (pos < size) {
+        if (!user_chunk_) {
+            if (!(user_chunk_ = ring_->begin_read())) {
+                break;
+            }
+            user_chunk_pos_ = 0;
+        }
+
+        const size_t n_bytes = std::min(size - pos, ring_chunk_size_ - user_chunk_pos_);
+
+        memcpy(data + pos, user_chunk_ + user_chunk_pos_, n_bytes);
+
+        pos += n_bytes;
+        user_chunk_pos_ += n_bytes;
+
+        if (user_chunk_pos_ == ring_chunk_size_) {
+            ring_->end_read();
+            user_chunk_ = NULL;
+            user_chunk_pos_ = 0;
+            ring_fill_--;
+        }
+    }
+
+    return pos;
+}
+
+// Invoked from mainloop thread when server requests more samples.
+// Drains ring buffer into stream. If ring buffer doesn't have enough
+// samples, the rest is filled with silence.
+void PulseaudioDevice::playback_callback_(size_t length) {
+    start_timer_(CallbackTimeout);
+
+    while (length > 0) {
+        void* buf = NULL;
+        size_t buf_size = length;
+
+        if (int err = pa_stream_begin_write(stream_, &buf, &buf_size)) {
+            roc_log(LogError, "pulseaudio %s: pa_stream_begin_write(): %s",
+                    device_type_to_str(device_type_), pa_strerror(err));
+            set_ring_broken_();
+            return;
+        }
+
+        if (buf_size > length) {
+            buf_size = length;
+        }
+
+        if (buf_size == 0) {
+            pa_stream_cancel_write(stream_);
+            break;
+        }
+
+        uint8_t* data = (uint8_t*)buf;
+        size_t pos = 0;
+
+        while (pos < buf_size) {
+            if (!cb_chunk_) {
+                if (!(cb_chunk_ = ring_->begin_read())) {
+                    break;
+                }
+                cb_chunk_pos_ = 0;
+                cb_started_ = true;
+            }
+
+            const size_t n_bytes =
+                std::min(buf_size - pos, ring_chunk_size_ - cb_chunk_pos_);
+
+            memcpy(data + pos, cb_chunk_ + cb_chunk_pos_, n_bytes);
+
+            pos += n_bytes;
+            cb_chunk_pos_ += n_bytes;
+
+            if (cb_chunk_pos_ == ring_chunk_size_) {
+                ring_->end_read();
+                cb_chunk_ = NULL;
+                cb_chunk_pos_ = 0;
+                ring_fill_--;
+                ring_sem_.post();
+            }
+        }
+
+        if (pos < buf_size) {
+            pa_silence_memory(data + pos, buf_size - pos, &stream_spec_);
+
+            // Don't count underruns until user wrote first samples.
+            if (cb_started_) {
+                n_underruns_++;
+            }
+        }
+
+        const int err =
+            pa_stream_write(stream_, data, buf_size, NULL, 0, PA_SEEK_RELATIVE);
+        if (err != 0) {
+            roc_log(LogError, "pulseaudio %s: pa_stream_write(): %s",
+                    device_type_to_str(device_type_), pa_strerror(err));
+            set_ring_broken_();
+            return;
+        }
+
+        length -= buf_size;
+    }
+
+    update_latency_();
+}
+
+// Invoked from mainloop thread when server has recorded samples.
+// Moves all available fragments from stream into ring buffer. If ring
+// buffer is full, recorded samples are dropped.
+void PulseaudioDevice::record_callback_() {
+    start_timer_(CallbackTimeout);
+
+    for (;;) {
+        const void* fragment = NULL;
+        size_t fragment_size = 0;
+
+        if (int err = pa_stream_peek(stream_, &fragment, &fragment_size)) {
+            roc_log(LogError, "pulseaudio %s: pa_stream_peek(): %s",
+                    device_type_to_str(device_type_), pa_strerror(err));
+            set_ring_broken_();
+            return;
+        }
+
+        if (fragment_size == 0) {
+            // buffer is empty, no need to call drop
+            break;
+        }
+
+        const uint8_t* data = (const uint8_t*)fragment;
+        size_t pos = 0;
+
+        while (pos < fragment_size) {
+            if (!cb_chunk_) {
+                if (!(cb_chunk_ = ring_->begin_write())) {
+                    n_overruns_++;
+                    break;
+                }
+                cb_chunk_pos_ = 0;
+            }
+
+            const size_t n_bytes =
+                std::min(fragment_size - pos, ring_chunk_size_ - cb_chunk_pos_);
+
+            if (data != NULL) {
+                // data is non-null, we got samples from buffer
+                memcpy(cb_chunk_ + cb_chunk_pos_, data + pos, n_bytes);
+            } else {
+                // data is null, we got hole
+                pa_silence_memory(cb_chunk_ + cb_chunk_pos_, n_bytes, &stream_spec_);
+            }
+
+            pos += n_bytes;
+            cb_chunk_pos_ += n_bytes;
+
+            if (cb_chunk_pos_ == ring_chunk_size_) {
+                ring_->end_write();
+                cb_chunk_ = NULL;
+                cb_chunk_pos_ = 0;
+                ring_fill_++;
+                ring_sem_.post();
+            }
+        }
+
+        if (int err = pa_stream_drop(stream_)) {
+            roc_log(LogError, "pulseaudio %s: pa_stream_drop(): %s",
+                    device_type_to_str(device_type_), pa_strerror(err));
+            set_ring_broken_();
+            return;
+        }
+    }
+
+    update_latency_();
+}
+
+core::nanoseconds_t PulseaudioDevice::ring_latency_() const {
+    const int n_chunks = ring_fill_;
+
+    return n_chunks > 0 ? n_chunks * frame_len_ns_ : 0;
+}
+
 bool PulseaudioDevice::get_latency_(core::nanoseconds_t& result) const {
     pa_usec_t latency_us = 0;
     int negative = 0;
@@ -1046,6 +1528,26 @@ bool PulseaudioDevice::get_latency_(core::nanoseconds_t& result) const {
     return true;
 }
 
+// Invoked from stream callbacks in callback mode. Caches latency,
+// so that latency() can be called without locking mainloop.
+void PulseaudioDevice::update_latency_() {
+    if (!pa_stream_get_timing_info(stream_)) {
+        // timing info wasn't received from server yet
+        return;
+    }
+
+    core::nanoseconds_t latency = 0;
+
+    if (!get_latency_(latency)) {
+        return;
+    }
+
+    measured_latency_ = latency;
+    has_measured_latency_ = 1;
+
+    report_latency_();
+}
+
 void PulseaudioDevice::report_latency_() {
     if (!rate_limiter_.allow()) {
         return;
@@ -1057,6 +1559,21 @@ void PulseaudioDevice::report_latency_() {
         return;
     }
 
+    if (callback_mode_) {
+        const core::nanoseconds_t ring_latency = ring_latency_();
+
+        roc_log(LogDebug,
+                "pulseaudio %s: io_latency=%ld(%.3fms) ring_latency=%ld(%.3fms)"
+                " n_underruns=%lu n_overruns=%lu",
+                device_type_to_str(device_type_),
+                (long)sample_spec_.ns_2_stream_timestamp_delta(latency),
+                (double)latency / core::Millisecond,
+                (long)sample_spec_.ns_2_stream_timestamp_delta(ring_latency),
+                (double)ring_latency / core::Millisecond, (unsigned long)n_underruns_,
+                (unsigned long)n_overruns_);
+        return;
+    }
+
     roc_log(LogDebug, "pulseaudio %s: io_latency=%ld(%.3fms)",
             device_type_to_str(device_type_),
             (long)sample_spec_.ns_2_stream_timestamp_delta(latency),
@@ -1106,6 +1623,15 @@ void PulseaudioDevice::timer_cb_(pa_mainloop_api*,
     roc_log(LogTrace, "pulseaudio %s: timer callback",
             device_type_to_str(self.device_type_));
 
+    if (self.callback_mode_ && self.ring_open_) {
+        // Stream callbacks weren't invoked for too long.
+        roc_log(LogInfo, "pulseaudio %s: stream timeout expired: timeout=%.3fms",
+                device_type_to_str(self.device_type_),
+                (double)CallbackTimeout / core::Millisecond);
+
+        self.set_ring_broken_();
+    }
+
     pa_threaded_mainloop_signal(self.mainloop_, 0);
 }
 
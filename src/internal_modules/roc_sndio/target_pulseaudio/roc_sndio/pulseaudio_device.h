@@ -16,9 +16,13 @@
 
 #include "roc_audio/frame.h"
 #include "roc_audio/frame_factory.h"
+#include "roc_core/atomic.h"
 #include "roc_core/attributes.h"
 #include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
 #include "roc_core/rate_limiter.h"
+#include "roc_core/semaphore.h"
+#include "roc_core/spsc_byte_buffer.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/time.h"
 #include "roc_packet/units.h"
@@ -29,8 +33,44 @@
 namespace roc {
 namespace sndio {
 
+//! PulseAudio device metrics.
+struct PulseaudioMetrics {
+    //! How many times playback stream requested data, but ring buffer
+    //! didn't have enough, and silence was written.
+    //! Counted only in callback mode.
+    uint64_t underrun_count;
+
+    //! How many times recording stream provided data, but ring buffer
+    //! was full, and data was dropped.
+    //! Counted only in callback mode.
+    uint64_t overrun_count;
+
+    //! Stream latency reported by server.
+    //! Zero if it wasn't retrieved yet.
+    core::nanoseconds_t stream_latency;
+
+    //! Latency of data queued in ring buffer.
+    //! Zero if callback mode is disabled.
+    core::nanoseconds_t ring_latency;
+
+    PulseaudioMetrics()
+        : underrun_count(0)
+        , overrun_count(0)
+        , stream_latency(0)
+        , ring_latency(0) {
+    }
+};
+
 //! PulseAudio device.
 //! Can be either source or sink depending on constructor parameter.
+//!
+//! Supports two modes:
+//!  - By default, read() and write() lock threaded mainloop and use
+//!    pa_stream_peek() or pa_stream_write() directly.
+//!  - In callback mode (IoConfig::callback_mode), stream read and write
+//!    callbacks move data between stream and a lock-free ring buffer,
+//!    and read() and write() access only the ring buffer. Mainloop is
+//!    locked only when stream is (re)opened.
 class PulseaudioDevice : public ISink, public ISource, public core::NonCopyable<> {
 public:
     //! Initialize.
@@ -75,11 +115,20 @@ public:
     virtual bool has_latency() const;
 
     //! Get latency of the device.
+    //! @remarks
+    //!  Returns latency reported by pa_stream_get_latency(). In callback
+    //!  mode, it is measured in stream callbacks, and also includes data
+    //!  queued in ring buffer, so this method doesn't lock mainloop.
     virtual core::nanoseconds_t latency() const;
 
     //! Check if the device has own clock.
     virtual bool has_clock() const;
 
+    //! Get metrics.
+    //! @remarks
+    //!  In callback mode, doesn't lock mainloop.
+    PulseaudioMetrics metrics() const;
+
     //! Restart reading from beginning.
     virtual ROC_NODISCARD status::StatusCode rewind();
 
@@ -122,6 +171,7 @@ private:
                           void* userdata);
 
     status::StatusCode handle_request_(uint8_t* data, size_t size);
+    status::StatusCode handle_ring_request_(uint8_t* data, size_t size);
 
     void want_mainloop_() const;
     status::StatusCode start_mainloop_();
@@ -146,7 +196,17 @@ private:
     ssize_t read_stream_(uint8_t* data, size_t size);
     ssize_t wait_stream_();
 
+    bool init_ring_(size_t chunk_size);
+    void reset_ring_();
+    void set_ring_broken_();
+    size_t write_ring_(const uint8_t* data, size_t size);
+    size_t read_ring_(uint8_t* data, size_t size);
+    void playback_callback_(size_t length);
+    void record_callback_();
+    core::nanoseconds_t ring_latency_() const;
+
     bool get_latency_(core::nanoseconds_t& latency) const;
+    void update_latency_();
     void report_latency_();
 
     void start_timer_(core::nanoseconds_t timeout);
@@ -167,6 +227,9 @@ private:
     core::nanoseconds_t timeout_ns_;
     packet::stream_timestamp_diff_t timeout_samples_;
 
+    const IoBufferConfig buffer_config_;
+    const bool callback_mode_;
+
     const uint8_t* record_frag_data_;
     size_t record_frag_size_;
     bool record_frag_flag_;
@@ -185,6 +248,30 @@ private:
     pa_sample_spec stream_spec_;
     pa_buffer_attr buff_attrs_;
 
+    // Ring buffer for callback mode.
+    // user_chunk_ is accessed only from read() or write(),
+    // cb_chunk_ is accessed only from stream callbacks.
+    core::Optional<core::SpscByteBuffer> ring_;
+    size_t ring_chunk_size_;
+    size_t ring_n_chunks_;
+    core::Atomic<int> ring_fill_;
+    core::Semaphore ring_sem_;
+    core::Atomic<int> ring_open_;
+    core::Atomic<int> ring_broken_;
+
+    uint8_t* user_chunk_;
+    size_t user_chunk_pos_;
+
+    uint8_t* cb_chunk_;
+    size_t cb_chunk_pos_;
+    bool cb_started_;
+
+    core::Atomic<uint64_t> n_underruns_;
+    core::Atomic<uint64_t> n_overruns_;
+
+    core::Atomic<int64_t> measured_latency_;
+    core::Atomic<int> has_measured_latency_;
+
     core::RateLimiter rate_limiter_;
 
     status::StatusCode init_status_;
@@ -25,6 +25,10 @@ const char* SndfileBackend::name() const {
     return "sndfile";
 }
 
+bool SndfileBackend::is_thread_safe() const {
+    return true;
+}
+
 bool SndfileBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& result) {
     if (!result.push_back(DriverInfo(
             "file", Driver_File | Driver_SupportsSink | Driver_SupportsSource, this))) {
@@ -150,6 +150,12 @@ const char* SoxBackend::name() const {
     return "sox";
 }
 
+bool SoxBackend::is_thread_safe() const {
+    // libsox keeps global state (sox_globals, format handlers registry),
+    // which is accessed during reading and writing too.
+    return false;
+}
+
 bool SoxBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& result) {
     for (size_t n = 0; n < ROC_ARRAY_SIZE(default_drivers); n++) {
         const char* driver = default_drivers[n];
@@ -28,6 +28,9 @@ public:
     //! Returns name of backend.
     virtual const char* name() const;
 
+    //! Check if devices of this backend can be used concurrently.
+    virtual bool is_thread_safe() const;
+
     //! Append supported drivers to the list.
     virtual ROC_NODISCARD bool
     discover_drivers(core::Array<DriverInfo, MaxDrivers>& result);
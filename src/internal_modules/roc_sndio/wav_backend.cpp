@@ -26,6 +26,10 @@ const char* WavBackend::name() const {
     return "wav";
 }
 
+bool WavBackend::is_thread_safe() const {
+    return true;
+}
+
 bool WavBackend::discover_drivers(core::Array<DriverInfo, MaxDrivers>& result) {
     if (!result.push_back(DriverInfo(
             "file", Driver_File | Driver_SupportsSink | Driver_SupportsSource, this))) {
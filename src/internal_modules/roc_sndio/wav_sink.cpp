@@ -31,15 +31,10 @@ bool has_extension(const char* path, const char* ext) {
 
 } // namespace
 
-WavSink::WavSink(audio::FrameFactory& frame_factory,
-                 core::IArena& arena,
-                 const IoConfig& io_config,
-                 const char* path)
-    : IDevice(arena)
-    , ISink(arena)
-    , output_file_(NULL)
-    , is_first_(true)
-    , init_status_(status::NoStatus) {
+status::StatusCode deduce_wav_sink_specs(const IoConfig& io_config,
+                                         const char* path,
+                                         audio::SampleSpec& file_spec,
+                                         audio::SampleSpec& frame_spec) {
     if (io_config.sample_spec.has_format()) {
         if (io_config.sample_spec.format() != audio::Format_Wav) {
             roc_log(LogDebug,
@@ -47,8 +42,7 @@ WavSink::WavSink(audio::FrameFactory& frame_factory,
                     io_config.sample_spec.format_name(),
                     audio::sample_spec_to_str(io_config.sample_spec).c_str());
             // Not a wav file, go to next backend.
-            init_status_ = status::StatusNoFormat;
-            return;
+            return status::StatusNoFormat;
         }
     } else {
         if (!has_extension(path, ".wav")) {
@@ -57,8 +51,7 @@ WavSink::WavSink(audio::FrameFactory& frame_factory,
                 "wav sink: requested file extension not supported by backend: path=%s",
                 path);
             // Not a wav file, go to next backend.
-            init_status_ = status::StatusNoFormat;
-            return;
+            return status::StatusNoFormat;
         }
     }
 
@@ -69,8 +62,7 @@ WavSink::WavSink(audio::FrameFactory& frame_factory,
                     " <subformat> '%s' not allowed when <format> is 'wav':"
                     " <subformat> must be pcm (like s16 or f32)",
                     io_config.sample_spec.subformat_name());
-            init_status_ = status::StatusBadConfig;
-            return;
+            return status::StatusBadConfig;
         }
 
         const audio::PcmTraits subfmt =
@@ -82,8 +74,7 @@ WavSink::WavSink(audio::FrameFactory& frame_factory,
                     " <subformat> '%s' not allowed when <format> is 'wav':"
                     " must be float (like f32) or signed integer (like s16)",
                     io_config.sample_spec.subformat_name());
-            init_status_ = status::StatusBadConfig;
-            return;
+            return status::StatusBadConfig;
         }
 
         if (!subfmt.has_flags(audio::Pcm_IsPacked | audio::Pcm_IsAligned)) {
@@ -93,8 +84,7 @@ WavSink::WavSink(audio::FrameFactory& frame_factory,
                     " must be packed (like s24, not s24_4) and byte-aligned"
                     " (like s16, not s18)",
                     io_config.sample_spec.subformat_name());
-            init_status_ = status::StatusBadConfig;
-            return;
+            return status::StatusBadConfig;
         }
 
         if (io_config.sample_spec.pcm_subformat() != subfmt.default_variant
@@ -104,25 +94,44 @@ WavSink::WavSink(audio::FrameFactory& frame_factory,
                     " <subformat> '%s' not allowed when <format> is 'wav':"
                     " must be default-endian (like s16) or little-endian (like s16_le)",
                     io_config.sample_spec.subformat_name());
-            init_status_ = status::StatusBadConfig;
-            return;
+            return status::StatusBadConfig;
         }
     }
 
-    file_spec_ = io_config.sample_spec;
-    file_spec_.use_defaults(audio::Format_Wav, audio::PcmSubformat_Raw,
-                            audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
-                            audio::ChanMask_Surround_Stereo, 44100);
+    file_spec = io_config.sample_spec;
+    file_spec.use_defaults(audio::Format_Wav, audio::PcmSubformat_Raw,
+                           audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
+                           audio::ChanMask_Surround_Stereo, 44100);
 
     const audio::PcmTraits subfmt =
-        audio::pcm_subformat_traits(file_spec_.pcm_subformat());
+        audio::pcm_subformat_traits(file_spec.pcm_subformat());
+
+    frame_spec = file_spec;
+    frame_spec.set_format(audio::Format_Pcm);
+    if (frame_spec.pcm_subformat() == subfmt.default_variant) {
+        frame_spec.set_pcm_subformat(subfmt.le_variant);
+    }
+
+    return status::StatusOK;
+}
 
-    frame_spec_ = file_spec_;
-    frame_spec_.set_format(audio::Format_Pcm);
-    if (frame_spec_.pcm_subformat() == subfmt.default_variant) {
-        frame_spec_.set_pcm_subformat(subfmt.le_variant);
+WavSink::WavSink(audio::FrameFactory& frame_factory,
+                 core::IArena& arena,
+                 const IoConfig& io_config,
+                 const char* path)
+    : IDevice(arena)
+    , ISink(arena)
+    , output_file_(NULL)
+    , is_first_(true)
+    , init_status_(status::NoStatus) {
+    if ((init_status_ = deduce_wav_sink_specs(io_config, path, file_spec_, frame_spec_))
+        != status::StatusOK) {
+        return;
     }
 
+    const audio::PcmTraits subfmt =
+        audio::pcm_subformat_traits(file_spec_.pcm_subformat());
+
     const uint16_t fmt_code =
         subfmt.has_flags(audio::Pcm_IsInteger) ? WAV_FORMAT_PCM : WAV_FORMAT_IEEE_FLOAT;
 
@@ -22,6 +22,19 @@
 namespace roc {
 namespace sndio {
 
+//! Deduce WAV file and frame sample specs from sink config.
+//! @remarks
+//!  Fills @p file_spec with encoding of output file, and @p frame_spec with
+//!  encoding of frames expected by sink.
+//! @returns
+//!  status::StatusNoFormat if requested format is not WAV, or if format is
+//!  not specified and @p path doesn't have ".wav" extension;
+//!  status::StatusBadConfig if requested encoding can't be used with WAV.
+status::StatusCode deduce_wav_sink_specs(const IoConfig& io_config,
+                                         const char* path,
+                                         audio::SampleSpec& file_spec,
+                                         audio::SampleSpec& frame_spec);
+
 //! WAV sink.
 //! @remarks
 //!  Writes samples to output WAV file.
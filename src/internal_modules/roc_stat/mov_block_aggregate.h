@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_stat/mov_block_aggregate.h
+//! @brief Approximate rolling window average, minimum, maximum.
+
+#ifndef ROC_STAT_MOV_BLOCK_AGGREGATE_H_
+#define ROC_STAT_MOV_BLOCK_AGGREGATE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/panic.h"
+#include "roc_core/ring_queue.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace stat {
+
+//! Approximate rolling window average, minimum, maximum.
+//!
+//! Unlike MovAggregate, doesn't store the whole window. Instead, window is split
+//! into a fixed number of blocks, and only sum, minimum, and maximum is stored
+//! for every completed block.
+//!
+//! Window consists of the last @p n_blocks completed blocks plus the current
+//! incomplete block, i.e. its length varies from win_len to win_len + block_len,
+//! where block_len is win_len / n_blocks rounded up. Hence, the oldest samples
+//! are evicted by blocks instead of one by one.
+//!
+//! Moving minimum/maximum are based on "sorted deque" algorithm (same as in
+//! MovAggregate), but applied to block minimums/maximums.
+//!
+//! Compared to MovAggregate:
+//!  - memory is O(n_blocks) instead of O(win_len)
+//!  - update cost is O(1) amortized, same as in MovAggregate, given that
+//!    n_blocks is not larger than block_len
+//!  - variance is not supported
+//!
+//! @tparam T defines a sample type.
+template <typename T> class MovBlockAggregate {
+public:
+    //! Initialize.
+    MovBlockAggregate(core::IArena& arena, const size_t win_len, const size_t n_blocks)
+        : n_blocks_(std::min(n_blocks, win_len))
+        , block_len_(0)
+        , block_sums_(arena)
+        , block_pos_(0)
+        , n_full_blocks_(0)
+        , block_id_(0)
+        , queue_max_(arena, std::max(n_blocks_, (size_t)1))
+        , queue_min_(arena, std::max(n_blocks_, (size_t)1))
+        , window_sum_(0)
+        , curr_sum_(0)
+        , curr_count_(0)
+        , curr_max_(T(0))
+        , curr_min_(T(0))
+        , valid_(false) {
+        if (win_len == 0 || n_blocks == 0) {
+            roc_panic("mov block stats: window length and number of blocks"
+                      " must be greater than 0");
+        }
+
+        block_len_ = (win_len + n_blocks_ - 1) / n_blocks_;
+
+        if (!queue_max_.is_valid() || !queue_min_.is_valid()) {
+            return;
+        }
+        if (!block_sums_.resize(n_blocks_)) {
+            return;
+        }
+
+        valid_ = true;
+    }
+
+    //! Check that initial allocation succeeded.
+    bool is_valid() const {
+        return valid_;
+    }
+
+    //! Check if the window is fully filled.
+    bool is_full() const {
+        return n_full_blocks_ == n_blocks_;
+    }
+
+    //! Get moving average.
+    //! @note
+    //!  Has O(1) complexity.
+    T mov_avg() const {
+        roc_panic_if(!valid_);
+
+        const size_t count = n_full_blocks_ * block_len_ + curr_count_;
+        if (count == 0) {
+            return T(0);
+        }
+
+        T ret;
+        double_2_t_((window_sum_ + curr_sum_) / (double)count, ret);
+        return ret;
+    }
+
+    //! Min value in sliding window.
+    //! @note
+    //!  Has O(1) complexity.
+    T mov_min() const {
+        roc_panic_if(!valid_);
+
+        if (queue_min_.is_empty()) {
+            return curr_min_;
+        }
+        if (curr_count_ == 0) {
+            return queue_min_.front().value;
+        }
+        return std::min(queue_min_.front().value, curr_min_);
+    }
+
+    //! Max value in sliding window.
+    //! @note
+    //!  Has O(1) complexity.
+    T mov_max() const {
+        roc_panic_if(!valid_);
+
+        if (queue_max_.is_empty()) {
+            return curr_max_;
+        }
+        if (curr_count_ == 0) {
+            return queue_max_.front().value;
+        }
+        return std::max(queue_max_.front().value, curr_max_);
+    }
+
+    //! Shift rolling window by one sample x.
+    //! @note
+    //!  Has amortized O(1) complexity.
+    void add(const T& x) {
+        roc_panic_if(!valid_);
+
+        if (curr_count_ == 0 || curr_max_ < x) {
+            curr_max_ = x;
+        }
+        if (curr_count_ == 0 || curr_min_ > x) {
+            curr_min_ = x;
+        }
+        curr_sum_ += (double)x;
+        curr_count_++;
+
+        if (curr_count_ == block_len_) {
+            complete_block_();
+        }
+    }
+
+private:
+    struct BlockExtremum {
+        T value;
+        size_t block_id;
+
+        BlockExtremum()
+            : value(T(0))
+            , block_id(0) {
+        }
+
+        BlockExtremum(const T& v, size_t id)
+            : value(v)
+            , block_id(id) {
+        }
+    };
+
+    // Move current block into window, evicting the oldest block.
+    void complete_block_() {
+        if (n_full_blocks_ < n_blocks_) {
+            n_full_blocks_++;
+        }
+
+        block_sums_[block_pos_] = curr_sum_;
+        block_pos_ = (block_pos_ + 1) % n_blocks_;
+
+        // Recompute instead of subtracting evicted sum to avoid accumulating
+        // rounding errors; it's cheap since it happens once per block.
+        window_sum_ = 0;
+        for (size_t n = 0; n < n_full_blocks_; n++) {
+            window_sum_ += block_sums_[n];
+        }
+
+        slide_max_(curr_max_);
+        slide_min_(curr_min_);
+
+        block_id_++;
+
+        curr_sum_ = 0;
+        curr_count_ = 0;
+    }
+
+    // Keeping a sliding max of block maximums by using a sorted deque.
+    // The wedge is always sorted in descending order.
+    void slide_max_(const T& x) {
+        if (!queue_max_.is_empty()
+            && queue_max_.front().block_id + n_blocks_ <= block_id_) {
+            queue_max_.pop_front();
+        }
+        while (!queue_max_.is_empty() && queue_max_.back().value < x) {
+            queue_max_.pop_back();
+        }
+        queue_max_.push_back(BlockExtremum(x, block_id_));
+    }
+
+    // Keeping a sliding min of block minimums by using a sorted deque.
+    // The wedge is always sorted in ascending order.
+    void slide_min_(const T& x) {
+        if (!queue_min_.is_empty()
+            && queue_min_.front().block_id + n_blocks_ <= block_id_) {
+            queue_min_.pop_front();
+        }
+        while (!queue_min_.is_empty() && queue_min_.back().value > x) {
+            queue_min_.pop_back();
+        }
+        queue_min_.push_back(BlockExtremum(x, block_id_));
+    }
+
+    template <class TT> void double_2_t_(double in, TT& out) const {
+        out = (TT)round(in);
+    }
+    void double_2_t_(double in, float& out) const {
+        out = (float)in;
+    }
+
+    const size_t n_blocks_;
+    size_t block_len_;
+
+    core::Array<double> block_sums_;
+    size_t block_pos_;
+    size_t n_full_blocks_;
+    size_t block_id_;
+
+    core::RingQueue<BlockExtremum> queue_max_;
+    core::RingQueue<BlockExtremum> queue_min_;
+
+    double window_sum_;
+
+    double curr_sum_;
+    size_t curr_count_;
+    T curr_max_;
+    T curr_min_;
+
+    bool valid_;
+};
+
+} // namespace stat
+} // namespace roc
+
+#endif // ROC_STAT_MOV_BLOCK_AGGREGATE_H_
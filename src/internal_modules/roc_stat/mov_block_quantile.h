@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+//! @file roc_stat/mov_block_quantile.h
+//! @brief Approximate rolling window quantile.
+
+#ifndef ROC_STAT_MOV_BLOCK_QUANTILE_H_
+#define ROC_STAT_MOV_BLOCK_QUANTILE_H_
+
+#include "roc_core/array.h"
+#include "roc_core/iarena.h"
+#include "roc_core/panic.h"
+#include "roc_core/stddefs.h"
+
+namespace roc {
+namespace stat {
+
+//! Approximate rolling window quantile.
+//!
+//! Unlike MovQuantile, doesn't store the whole window. Instead, window is split
+//! into a fixed number of blocks, and only a small summary is stored for every
+//! completed block, similar to the block-based sliding window summaries described
+//! by Arasu and Manku ("Approximate counts and quantiles over sliding windows").
+//!
+//! Summary of a block consists of @p n_points values evenly spaced in the sorted
+//! block, each representing the same share of the block. The quantile is selected
+//! from summaries of the last @p n_blocks completed blocks, and is recomputed only
+//! when a block completes. Until the first block completes, the quantile is
+//! computed exactly from the samples collected so far.
+//!
+//! Compared to MovQuantile:
+//!  - memory is O(n_blocks * n_points + win_len / n_blocks) instead of O(win_len)
+//!  - amortized update cost is O(log(block_len) + n_blocks * n_points / block_len)
+//!    instead of O(log(win_len))
+//!  - the value lags behind by up to one block, and the error is bounded by
+//!    the rank distance between neighbour summary points, i.e. 1/n_points of
+//!    the block rank range
+//!
+//! @tparam T defines a sample type.
+template <typename T> class MovBlockQuantile {
+public:
+    //! Initialize.
+    MovBlockQuantile(core::IArena& arena,
+                     const size_t win_len,
+                     const double quantile,
+                     const size_t n_blocks,
+                     const size_t n_points)
+        : quantile_(quantile)
+        , n_blocks_(std::min(n_blocks, win_len))
+        , block_len_(0)
+        , n_points_(0)
+        , block_(arena)
+        , block_pos_(0)
+        , points_(arena)
+        , points_pos_(0)
+        , n_full_blocks_(0)
+        , scratch_(arena)
+        , value_(T(0))
+        , valid_(false) {
+        if (win_len == 0 || n_blocks == 0 || n_points == 0) {
+            roc_panic("mov block quantile: window length, number of blocks and"
+                      " number of points must be greater than 0");
+        }
+        if (quantile < 0 || quantile > 1) {
+            roc_panic("mov block quantile: quantile should be between 0 and 1");
+        }
+
+        block_len_ = (win_len + n_blocks_ - 1) / n_blocks_;
+        n_points_ = std::min(n_points, block_len_);
+
+        if (!block_.resize(block_len_)) {
+            return;
+        }
+        if (!points_.resize(n_blocks_ * n_points_)) {
+            return;
+        }
+        if (!scratch_.resize(std::max(n_blocks_ * n_points_, block_len_))) {
+            return;
+        }
+
+        valid_ = true;
+    }
+
+    //! Check that initial allocation succeeded.
+    bool is_valid() const {
+        return valid_;
+    }
+
+    //! Check if the window is fully filled.
+    bool is_full() const {
+        return n_full_blocks_ == n_blocks_;
+    }
+
+    //! Returns the moving quantile.
+    //! @note
+    //!  Has O(1) complexity.
+    T mov_quantile() const {
+        roc_panic_if(!valid_);
+
+        return value_;
+    }
+
+    //! Shift rolling window by one sample x.
+    //! @note
+    //!  Has amortized O(log(block_len) + n_blocks * n_points / block_len)
+    //!  complexity, except the first block, which has O(block_len) complexity.
+    void add(const T& x) {
+        roc_panic_if(!valid_);
+
+        block_[block_pos_++] = x;
+
+        if (block_pos_ == block_len_) {
+            complete_block_();
+            block_pos_ = 0;
+        } else if (n_full_blocks_ == 0) {
+            // No summaries yet, compute exact quantile of the first block.
+            value_ = select_(block_.data(), block_pos_);
+        }
+    }
+
+private:
+    // Replace summary of the oldest block with summary of the completed block,
+    // and recompute quantile from all summaries.
+    void complete_block_() {
+        std::sort(block_.data(), block_.data() + block_len_);
+
+        T* points = points_.data() + points_pos_ * n_points_;
+        for (size_t n = 0; n < n_points_; n++) {
+            points[n] = block_[(2 * n + 1) * block_len_ / (2 * n_points_)];
+        }
+
+        points_pos_ = (points_pos_ + 1) % n_blocks_;
+        if (n_full_blocks_ < n_blocks_) {
+            n_full_blocks_++;
+        }
+
+        value_ = select_(points_.data(), n_full_blocks_ * n_points_);
+    }
+
+    // Select quantile from given values, without modifying them.
+    T select_(const T* values, size_t n_values) {
+        roc_panic_if(n_values == 0 || n_values > scratch_.size());
+
+        T* scratch = scratch_.data();
+        std::copy(values, values + n_values, scratch);
+
+        const size_t k = size_t(quantile_ * double(n_values - 1));
+        std::nth_element(scratch, scratch + k, scratch + n_values);
+
+        return scratch[k];
+    }
+
+    const double quantile_;
+
+    const size_t n_blocks_;
+    size_t block_len_;
+    size_t n_points_;
+
+    core::Array<T> block_;
+    size_t block_pos_;
+
+    core::Array<T> points_;
+    size_t points_pos_;
+    size_t n_full_blocks_;
+
+    core::Array<T> scratch_;
+
+    T value_;
+
+    bool valid_;
+};
+
+} // namespace stat
+} // namespace roc
+
+#endif // ROC_STAT_MOV_BLOCK_QUANTILE_H_
@@ -156,6 +156,8 @@ typedef enum roc_protocol {
      * Audio encodings:
      *   - \ref ROC_PACKET_ENCODING_AVP_L16_MONO
      *   - \ref ROC_PACKET_ENCODING_AVP_L16_STEREO
+     *   - \ref ROC_PACKET_ENCODING_OPUS_MONO
+     *   - \ref ROC_PACKET_ENCODING_OPUS_STEREO
      *   - encodings registered using roc_context_register_encoding()
      *
      * FEC encodings:
@@ -262,6 +264,46 @@ typedef enum roc_packet_encoding {
      *  - \ref ROC_PROTO_RTP_LDPC_SOURCE
      */
     ROC_PACKET_ENCODING_AVP_L16_STEREO = 10,
+
+    /** Opus, 1 channel, 48000 rate.
+     *
+     * Represents Opus encoding (RFC 6716, RFC 7587) with one Opus packet per
+     * RTP packet. Encoder uses constant bitrate and in-band FEC, and decoder
+     * can use Opus packet loss concealment (see \ref ROC_PLC_BACKEND_DEFAULT).
+     *
+     * Encoder is tuned for voice (24 kbit/s for mono, 32 kbit/s for stereo),
+     * so that Opus uses SILK or hybrid mode, which carry in-band FEC data.
+     * These modes require packet length of at least 10ms, so shorter packet
+     * length is increased to 10ms. Packet length should be a multiple of 2.5ms
+     * and should not exceed 120ms. In-band FEC is produced only for lengths
+     * natively supported by Opus (10, 20, 40, 60, 80, 100, 120ms).
+     *
+     * Uses RTP payload type 21, which is unassigned in RTP A/V Profile, so that
+     * it doesn't collide with dynamic payload types (96-127).
+     *
+     * Available only if the library was built with libopus support.
+     *
+     * Supported by protocols:
+     *  - \ref ROC_PROTO_RTP
+     *  - \ref ROC_PROTO_RTP_RS8M_SOURCE
+     *  - \ref ROC_PROTO_RTP_LDPC_SOURCE
+     */
+    ROC_PACKET_ENCODING_OPUS_MONO = 21,
+
+    /** Opus, 2 channels, 48000 rate.
+     *
+     * Same as \ref ROC_PACKET_ENCODING_OPUS_MONO, but with 2 channels.
+     *
+     * Uses RTP payload type 20.
+     *
+     * Available only if the library was built with libopus support.
+     *
+     * Supported by protocols:
+     *  - \ref ROC_PROTO_RTP
+     *  - \ref ROC_PROTO_RTP_RS8M_SOURCE
+     *  - \ref ROC_PROTO_RTP_LDPC_SOURCE
+     */
+    ROC_PACKET_ENCODING_OPUS_STEREO = 20,
 } roc_packet_encoding;
 
 /** Forward Error Correction encoding.
@@ -333,6 +375,17 @@ typedef enum roc_format {
      * - supported channels: any
      */
     ROC_FORMAT_PCM = 1,
+
+    /** Opus compressed packets.
+     *
+     * Can be used only for network packets, via roc_context_register_encoding().
+     * Available only if the library was built with libopus support.
+     *
+     * - supported subformats: none (should be zero)
+     * - supported rates: 8000, 12000, 16000, 24000, 48000
+     * - supported channels: mono, stereo
+     */
+    ROC_FORMAT_OPUS = 2,
 } roc_format;
 
 /** Sample sub-format.
@@ -669,7 +722,22 @@ typedef enum roc_resampler_backend {
      *
      * Recommended when CPU resources are extremely limited.
      */
-    ROC_RESAMPLER_BACKEND_SPEEXDEC = 3
+    ROC_RESAMPLER_BACKEND_SPEEXDEC = 3,
+
+    /** CPU-efficient good-quality high-precision built-in resampler.
+     *
+     * Implements the same bandlimited interpolation and uses the same quality
+     * settings as \c ROC_RESAMPLER_BACKEND_BUILTIN, but precomputes a bank of
+     * filters and applies them using vectorized instructions when available.
+     *
+     * Compared to \c ROC_RESAMPLER_BACKEND_BUILTIN, uses significantly less CPU
+     * in exchange for more memory per resampler.
+     *
+     * This backend is always available.
+     *
+     * Recommended for \ref ROC_LATENCY_TUNER_PROFILE_RESPONSIVE on cheap CPUs.
+     */
+    ROC_RESAMPLER_BACKEND_POLYPHASE = 4
 } roc_resampler_backend;
 
 /** Resampler profile.
@@ -706,11 +774,67 @@ typedef enum roc_plc_backend {
     ROC_PLC_BACKEND_DISABLE = -1,
 
     /** Default backend.
-     * Current default is \c ROC_PLC_BACKEND_DISABLE.
+     * If packet encoding has built-in PLC (e.g. Opus), it is used.
+     * Otherwise, current default is \c ROC_PLC_BACKEND_DISABLE.
      */
     ROC_PLC_BACKEND_DEFAULT = 0,
 } roc_plc_backend;
 
+/** Thread scheduling policy.
+ *
+ * Defines how operating system schedules threads created by context.
+ * Realtime policies reduce preemption of network and control threads
+ * by other processes, which otherwise shows up as jitter and underruns.
+ *
+ * Realtime policies usually require privileges (e.g. \c CAP_SYS_NICE
+ * on Linux). If policy can't be applied, the error is logged and
+ * thread runs with default policy.
+ */
+typedef enum roc_thread_policy {
+    /** Default policy.
+     * Scheduling policy of thread is not changed.
+     */
+    ROC_THREAD_POLICY_DEFAULT = 0,
+
+    /** Realtime first-in, first-out policy (SCHED_FIFO).
+     */
+    ROC_THREAD_POLICY_FIFO = 1,
+
+    /** Realtime round-robin policy (SCHED_RR).
+     */
+    ROC_THREAD_POLICY_RR = 2
+} roc_thread_policy;
+
+/** Thread scheduling configuration.
+ *
+ * It is safe to memset() this struct with zeros to get a default config.
+ *
+ * \see roc_context_config
+ */
+typedef struct roc_thread_config {
+    /** Scheduling policy.
+     *
+     * If zero, default value is used (\c ROC_THREAD_POLICY_DEFAULT).
+     */
+    roc_thread_policy policy;
+
+    /** Scheduling priority.
+     *
+     * Used only with realtime policies. On Linux, should be in range [1; 99].
+     *
+     * If zero, minimum priority for policy is used.
+     */
+    int priority;
+
+    /** Bitmask of CPUs on which thread is allowed to run.
+     *
+     * Bit N corresponds to CPU N. Currently supported only on Linux.
+     *
+     * If zero, CPU affinity is not changed.
+     */
+    unsigned long long cpu_mask;
+} roc_thread_config;
+
 /** Context configuration.
  *
  * It is safe to memset() this struct with zeros to get a default config. It is also
@@ -736,6 +860,137 @@ typedef struct roc_context_config {
      * If zero, default value is used.
      */
     unsigned int max_frame_size;
+
+    /** Number of network threads.
+     *
+     * Each network thread runs its own event loop. Sockets opened by senders and
+     * receivers are distributed between threads in round-robin order. Using
+     * multiple threads helps when a context serves many endpoints and a single
+     * thread can't keep up with the packet rate.
+     *
+     * Should not exceed 16.
+     *
+     * If zero, default value is used (one thread).
+     */
+    unsigned int network_threads;
+
+    /** Enable SO_REUSEPORT for receiver sockets.
+     *
+     * When true (non-zero), each receiver endpoint is bound once in every network
+     * thread, with SO_REUSEPORT enabled. Operating system then distributes incoming
+     * packets between those sockets, so that a single endpoint is served by several
+     * threads. Use together with \c network_threads.
+     *
+     * Not supported on platforms without SO_REUSEPORT; binding fails there.
+     *
+     * By default, false.
+     */
+    unsigned int reuse_port;
+
+    /** Use kernel receive timestamps for received packets.
+     *
+     * When true (non-zero), receiver uses the time when a packet was received by
+     * operating system kernel, instead of the time when it was read by network
+     * thread. This excludes network thread scheduling delay from measured jitter,
+     * and allows receiver to select lower latency.
+     *
+     * Timestamps are read together with datagrams (SO_TIMESTAMPNS), without extra
+     * system calls. Difference between user-space and kernel timestamps is reported
+     * in \ref roc_context_metrics.
+     *
+     * If not supported by platform, receiver falls back to user-space timestamps.
+     *
+     * By default, false.
+     */
+    unsigned int kernel_timestamps;
+
+    /** Maximum number of UDP datagrams received by one system call.
+     *
+     * If greater than one, receiver sockets use recvmmsg(), which reduces
+     * number of system calls under high packet rate. Datagrams are received
+     * directly into packet buffers, without extra copying.
+     *
+     * Supported only on Linux. On other platforms, \ref roc_context_open() fails
+     * if this value is greater than one.
+     *
+     * Should not exceed 32.
+     *
+     * If zero, default value is used (one datagram per call).
+     */
+    unsigned int udp_recv_batch;
+
+    /** Maximum number of UDP datagrams sent by one system call.
+     *
+     * If greater than one, packets queued for sending are flushed from network
+     * thread using sendmmsg(), when it's supported by platform.
+     *
+     * Should not exceed 32.
+     *
+     * If zero, default value is used (one datagram per call).
+     */
+    unsigned int udp_send_batch;
+
+    /** Scheduling parameters of network threads.
+     *
+     * Applied to every network thread (see \c network_threads).
+     *
+     * If zero, threads are not changed.
+     */
+    roc_thread_config network_thread;
+
+    /** Scheduling parameters of control thread.
+     *
+     * Control thread runs background tasks, like processing of control
+     * packets and pipeline maintenance.
+     *
+     * If zero, thread is not changed.
+     */
+    roc_thread_config control_thread;
+
+    /** Lock process memory.
+     *
+     * When true (non-zero), context calls \c mlockall() to lock pages of the
+     * process in memory. This prevents page faults in realtime threads.
+     *
+     * Memory locking affects the whole process, not only the context: all
+     * pages mapped at the moment when context is opened are locked, including
+     * memory allocated by application and by other contexts. Memory is locked
+     * after context prewarms its pools (see \c prewarm_packets and
+     * \c prewarm_frames) and starts its threads.
+     *
+     * Pages mapped later are locked too only if \c RLIMIT_MEMLOCK is unlimited
+     * or the process has \c CAP_IPC_LOCK. Otherwise, only current pages are
+     * locked, because locking future pages would make any allocation in the
+     * process fail after reaching the limit.
+     *
+     * Memory stays locked until the last context that locked it is closed.
+     *
+     * Requires privileges or large enough \c RLIMIT_MEMLOCK. If memory can't
+     * be locked, context is still opened; the failure is logged and reported
+     * via \c memory_locked and \c thread_config_failures fields of
+     * \ref roc_context_metrics (see roc_context_query()).
+     *
+     * By default, false.
+     */
+    unsigned int lock_memory;
+
+    /** Number of packets to preallocate.
+     *
+     * Context preallocates memory for this number of network packets during
+     * initialization, so that it's not allocated while streaming.
+     *
+     * If zero, nothing is preallocated.
+     */
+    unsigned int prewarm_packets;
+
+    /** Number of frames to preallocate.
+     *
+     * Context preallocates memory for this number of audio frames during
+     * initialization, so that it's not allocated while streaming.
+     *
+     * If zero, nothing is preallocated.
+     */
+    unsigned int prewarm_frames;
 } roc_context_config;
 
 /** Sender configuration.
@@ -824,6 +1079,21 @@ typedef struct roc_sender_config {
      */
     unsigned int fec_block_repair_packets;
 
+    /** Enable adaptive FEC.
+     * Used if some FEC encoding is selected.
+     *
+     * When true (non-zero), sender adjusts number of repair packets per FEC block
+     * according to packet loss reported by receiver via RTCP. Number of repair
+     * packets grows quickly when loss increases, and is reduced slowly when loss
+     * stays low. \c fec_block_repair_packets defines initial value.
+     *
+     * Has no effect if receiver doesn't send RTCP reports, or if multicast is used
+     * for control endpoint.
+     *
+     * By default, false.
+     */
+    unsigned int fec_adaptive;
+
     /** Clock source to use.
      * Defines whether write operation is blocking or non-blocking.
      *
@@ -922,6 +1192,52 @@ typedef struct roc_sender_config {
      * If you want to enable it, refer to the comment for \c target_latency.
      */
     unsigned long long max_target_latency;
+
+    /** Enable per-stage timing.
+     *
+     * When true (non-zero), sender measures time spent in each stage of its
+     * processing pipeline (resampling, packetization, FEC encoding, etc.) and
+     * reports it via \ref roc_sender_metrics.
+     *
+     * Adds a small overhead for reading clock around every stage.
+     *
+     * By default, false.
+     */
+    unsigned int stage_timing;
+
+    /** Enable metrics snapshots.
+     *
+     * When true (non-zero), sender periodically publishes a snapshot of its
+     * metrics (every 10ms of processed audio), and \ref roc_sender_query() returns the
+     * last published snapshot without waiting for the sender pipeline. This makes
+     * frequent queries cheap and doesn't delay frame processing. Returned metrics
+     * may be up to 10ms behind.
+     *
+     * If snapshot is not available (e.g. no frames were processed yet, or there
+     * are too many connections), metrics are retrieved from pipeline as usual.
+     *
+     * By default, false.
+     */
+    unsigned int metrics_snapshots;
+
+    /** Enable shared encoding.
+     *
+     * When true (non-zero), if sender has multiple slots (see \ref roc_slot) with
+     * identical set of protocols, frames are encoded only once, and every slot
+     * sends copies of the same packets. This reduces CPU usage when sending the
+     * same stream to multiple receivers.
+     *
+     * Slots sharing encoding send identical streams with the same SSRC and
+     * sequence numbers. If SSRC needs to be changed (e.g. because of collision
+     * reported by receiver of one slot), it is changed for all such slots.
+     *
+     * Has effect only if latency tuning is disabled on sender (\ref
+     * ROC_LATENCY_TUNER_PROFILE_INTACT, which is the default on sender) and
+     * \c fec_adaptive is disabled. Otherwise, every slot uses its own encoding.
+     *
+     * By default, false.
+     */
+    unsigned int shared_encoding;
 } roc_sender_config;
 
 /** Receiver configuration.
@@ -1090,6 +1406,48 @@ typedef struct roc_receiver_config {
      * If zero, default value is used. If negative, the check is disabled.
      */
     long long choppy_playback_timeout;
+
+    /** Enable per-stage timing.
+     *
+     * When true (non-zero), receiver measures time spent in each stage of its
+     * processing pipeline (FEC decoding, depacketization, resampling, mixing, etc.)
+     * and reports it via \ref roc_receiver_metrics and \ref roc_connection_metrics.
+     *
+     * Adds a small overhead for reading clock around every stage.
+     *
+     * By default, false.
+     */
+    unsigned int stage_timing;
+
+    /** Enable metrics snapshots.
+     *
+     * When true (non-zero), receiver periodically publishes a snapshot of its
+     * metrics (every 10ms of processed audio), and \ref roc_receiver_query() returns the
+     * last published snapshot without waiting for the receiver pipeline. This makes
+     * frequent queries cheap and doesn't delay frame processing. Returned metrics
+     * may be up to 10ms behind.
+     *
+     * If snapshot is not available (e.g. no frames were processed yet, or there
+     * are too many connections), metrics are retrieved from pipeline as usual.
+     *
+     * By default, false.
+     */
+    unsigned int metrics_snapshots;
+
+    /** Enable incremental FEC decoding.
+     *
+     * When true (non-zero), if receiver detects a loss in FEC block, it passes
+     * packets of the block to FEC decoder as soon as they arrive, instead of
+     * decoding the whole block at once when the lost packet is needed. This
+     * spreads decoding work over time and avoids spikes of processing time.
+     * Decoding is stopped as soon as all lost packets are recovered, and the
+     * rest of the block is not decoded.
+     *
+     * Lost packets may be recovered earlier than their delayed originals arrive.
+     *
+     * By default, false.
+     */
+    unsigned int fec_incremental_decoding;
 } roc_receiver_config;
 
 /** Interface configuration.
@@ -15,6 +15,7 @@
 #define ROC_CONTEXT_H_
 
 #include "roc/config.h"
+#include "roc/metrics.h"
 #include "roc/platform.h"
 #include "roc/plugin.h"
 
@@ -119,6 +120,24 @@ ROC_API int roc_context_register_encoding(roc_context* context,
 ROC_API int
 roc_context_register_plc(roc_context* context, int plugin_id, roc_plugin_plc* plugin);
 
+/** Query context metrics.
+ *
+ * Reads metrics into provided struct.
+ *
+ * **Parameters**
+ *  - \p context should point to an opened context
+ *  - \p metrics defines a struct where to write metrics
+ *
+ * **Returns**
+ *  - returns zero if the metrics were successfully retrieved
+ *  - returns a negative value if the arguments are invalid
+ *
+ * **Ownership**
+ *  - doesn't take or share the ownership of \p metrics; it may be safely
+ *    deallocated after the function returns
+ */
+ROC_API int roc_context_query(roc_context* context, roc_context_metrics* metrics);
+
 /** Close the context.
  *
  * Stops any started background threads, deinitializes and deallocates the context.
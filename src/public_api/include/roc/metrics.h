@@ -20,6 +20,26 @@
 extern "C" {
 #endif
 
+/** Timing of a pipeline stage.
+ *
+ * Describes how much time a stage of sender or receiver pipeline spends to process
+ * one frame (or one packet, for FEC stages). Only the stage's own time is counted:
+ * time of other measured stages invoked by it is excluded.
+ *
+ * Values are computed over a moving window of recent frames. All values are zero
+ * if stage timing is disabled in config or the stage is not used by pipeline.
+ */
+typedef struct roc_stage_timing {
+    /** Median processing time, in nanoseconds. */
+    unsigned long long p50_time;
+
+    /** 99th percentile of processing time, in nanoseconds. */
+    unsigned long long p99_time;
+
+    /** Maximum processing time, in nanoseconds. */
+    unsigned long long max_time;
+} roc_stage_timing;
+
 /** Metrics for a single connection between sender and receiver.
  *
  * On receiver, represents one connected sender. Similarly, on sender  represents one
@@ -105,6 +125,59 @@ typedef struct roc_connection_metrics {
      * Metric is available only on receiver.
      */
     unsigned long long recovered_packets;
+
+    /** Timing of FEC decoder (including repair packet queue) stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing fec_decoder_timing;
+
+    /** Timing of depacketizer (including payload decoder) stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing depacketizer_timing;
+
+    /** Timing of packet loss concealment stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing plc_timing;
+
+    /** Timing of watchdog stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing watchdog_timing;
+
+    /** Timing of channel mapper stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing channel_mapper_timing;
+
+    /** Timing of resampler stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing resampler_timing;
+
+    /** Timing of latency monitor stage.
+     *
+     * Metric is available only on receiver, if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing latency_monitor_timing;
+
+    /** Time spent in FEC decoder per block.
+     *
+     * Unlike \c fec_decoder_timing, which is measured per packet, this is the total
+     * decoder time spent on one FEC block. Only blocks with losses are counted,
+     * since blocks without losses are not decoded.
+     *
+     * Metric is available only on receiver, if FEC is used. Doesn't require
+     * \c stage_timing to be enabled.
+     */
+    roc_stage_timing fec_block_timing;
 } roc_connection_metrics;
 
 /** Receiver metrics.
@@ -119,6 +192,15 @@ typedef struct roc_receiver_metrics {
      * When there are no connections, receiver produces silence.
      */
     unsigned int connection_count;
+
+    /** Timing of mixer stage.
+     *
+     * Doesn't include time spent in connections, which is reported separately
+     * via \ref roc_connection_metrics.
+     *
+     * Metric is available only if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing mixer_timing;
 } roc_receiver_metrics;
 
 /** Sender metrics.
@@ -140,8 +222,94 @@ typedef struct roc_sender_metrics {
      * connections, one per each discovered receiver.
      */
     unsigned int connection_count;
+
+    /** Number of source packets per FEC block.
+     *
+     * Zero if FEC is not used.
+     */
+    unsigned int fec_block_source_packets;
+
+    /** Number of repair packets per FEC block.
+     *
+     * Zero if FEC is not used. If \c fec_adaptive is enabled in config,
+     * changes over time according to packet loss reported by receiver.
+     */
+    unsigned int fec_block_repair_packets;
+
+    /** Timing of feedback monitor stage.
+     *
+     * Metric is available only if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing feedback_monitor_timing;
+
+    /** Timing of resampler stage.
+     *
+     * Metric is available only if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing resampler_timing;
+
+    /** Timing of channel mapper stage.
+     *
+     * Metric is available only if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing channel_mapper_timing;
+
+    /** Timing of packetizer (including payload encoder) stage.
+     *
+     * Metric is available only if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing packetizer_timing;
+
+    /** Timing of FEC encoder stage.
+     *
+     * Metric is available only if \c stage_timing is enabled in config.
+     */
+    roc_stage_timing fec_encoder_timing;
 } roc_sender_metrics;
 
+/** Context metrics.
+ *
+ * Holds metrics of the context and of the process-wide settings applied by it.
+ */
+typedef struct roc_context_metrics {
+    /** Whether process memory was locked by context.
+     *
+     * Non-zero if \c lock_memory was enabled in config and memory was successfully
+     * locked.
+     */
+    unsigned int memory_locked;
+
+    /** Number of failures to apply thread parameters or to lock memory.
+     *
+     * Counts failures to apply \c network_thread and \c control_thread parameters
+     * and to lock memory. Counter is process-wide and includes failures caused by
+     * other contexts, because these settings affect the whole process.
+     */
+    unsigned int thread_config_failures;
+
+    /** Number of received packets with kernel timestamps.
+     *
+     * Non-zero only if \c kernel_timestamps was enabled in config and is supported
+     * by platform.
+     */
+    unsigned long long kernel_timestamped_packets;
+
+    /** Average delay excluded by kernel timestamps, in nanoseconds.
+     *
+     * Average difference between the time when packet was read by network thread
+     * and the time when it was received by kernel, for packets counted in
+     * \c kernel_timestamped_packets.
+     */
+    unsigned long long kernel_timestamp_mean_delay;
+
+    /** Maximum delay excluded by kernel timestamps, in nanoseconds.
+     *
+     * Maximum difference between the time when packet was read by network thread
+     * and the time when it was received by kernel.
+     */
+    unsigned long long kernel_timestamp_max_delay;
+} roc_context_metrics;
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
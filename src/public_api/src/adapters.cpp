@@ -61,6 +61,87 @@ bool context_config_from_user(node::ContextConfig& out, const roc_context_config
         out.max_frame_size = in.max_frame_size;
     }
 
+    if (in.network_threads != 0) {
+        if (in.network_threads > node::Context::MaxNetworkLoops) {
+            roc_log(LogError,
+                    "bad configuration: invalid roc_context_config.network_threads:"
+                    " should be in range [0; %u], got %u",
+                    (unsigned)node::Context::MaxNetworkLoops, in.network_threads);
+            return false;
+        }
+        out.num_network_threads = in.network_threads;
+    }
+
+    out.enable_reuseport = (in.reuse_port != 0);
+    out.enable_kernel_timestamps = (in.kernel_timestamps != 0);
+
+    if (in.udp_recv_batch != 0) {
+        if (in.udp_recv_batch > netio::UdpConfig::MaxBatchSize) {
+            roc_log(LogError,
+                    "bad configuration: invalid roc_context_config.udp_recv_batch:"
+                    " should be in range [0; %u], got %u",
+                    (unsigned)netio::UdpConfig::MaxBatchSize, in.udp_recv_batch);
+            return false;
+        }
+        out.udp_recv_batch_size = in.udp_recv_batch;
+    }
+
+    if (in.udp_send_batch != 0) {
+        if (in.udp_send_batch > netio::UdpConfig::MaxBatchSize) {
+            roc_log(LogError,
+                    "bad configuration: invalid roc_context_config.udp_send_batch:"
+                    " should be in range [0; %u], got %u",
+                    (unsigned)netio::UdpConfig::MaxBatchSize, in.udp_send_batch);
+            return false;
+        }
+        out.udp_send_batch_size = in.udp_send_batch;
+    }
+
+    if (!thread_config_from_user(out.network_thread, in.network_thread)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_context_config.network_thread");
+        return false;
+    }
+
+    if (!thread_config_from_user(out.control_thread, in.control_thread)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_context_config.control_thread");
+        return false;
+    }
+
+    out.enable_mlock = (in.lock_memory != 0);
+    out.prewarm_packets = in.prewarm_packets;
+    out.prewarm_frames = in.prewarm_frames;
+
+    return true;
+}
+
+ROC_NOSANITIZE
+bool thread_config_from_user(core::ThreadConfig& out, const roc_thread_config& in) {
+    if (!thread_policy_from_user(out.policy, in.policy)) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_thread_config.policy:"
+                " should be valid enum value");
+        return false;
+    }
+
+    if (in.priority < 0) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_thread_config.priority:"
+                " should not be negative");
+        return false;
+    }
+
+    if (in.priority != 0 && out.policy == core::ThreadPolicy_Default) {
+        roc_log(LogError,
+                "bad configuration: invalid roc_thread_config.priority:"
+                " priority can be set only for realtime policies");
+        return false;
+    }
+
+    out.priority = in.priority;
+    out.cpu_mask = in.cpu_mask;
+
     return true;
 }
 
@@ -119,6 +200,8 @@ bool sender_config_from_user(node::Context& context,
         out.fec_writer.n_repair_packets = in.fec_block_repair_packets;
     }
 
+    out.enable_adaptive_fec = (in.fec_adaptive != 0);
+
     if (!clock_source_from_user(out.enable_cpu_clock, in.clock_source)) {
         roc_log(LogError,
                 "bad configuration: invalid roc_sender_config.clock_source:"
@@ -173,6 +256,10 @@ bool sender_config_from_user(node::Context& context,
         out.latency.max_target_latency = (core::nanoseconds_t)in.max_target_latency;
     }
 
+    out.enable_stage_profiling = (in.stage_timing != 0);
+    out.enable_metrics_snapshots = (in.metrics_snapshots != 0);
+    out.enable_shared_encoding = (in.shared_encoding != 0);
+
     out.enable_auto_cts = true;
 
     return true;
@@ -266,6 +353,12 @@ bool receiver_config_from_user(node::Context&,
             in.choppy_playback_timeout;
     }
 
+    out.common.enable_stage_profiling = (in.stage_timing != 0);
+    out.common.enable_metrics_snapshots = (in.metrics_snapshots != 0);
+
+    out.session_defaults.fec_reader.incremental_decoding =
+        (in.fec_incremental_decoding != 0);
+
     out.common.enable_auto_reclock = true;
 
     return true;
@@ -514,6 +607,19 @@ bool sample_format_from_user(audio::SampleSpec& out, const roc_media_encoding& i
         break;
     } break; // ROC_FORMAT_PCM
 
+#ifdef ROC_TARGET_LIBOPUS
+    case ROC_FORMAT_OPUS: {
+        out.set_format(audio::Format_Opus);
+
+        if (in.subformat != 0) {
+            roc_log(LogError,
+                    "bad configuration: invalid roc_media_encoding.subformat:"
+                    " ROC_FORMAT_OPUS doesn't support sub-formats, should be zero");
+            return false;
+        }
+    } break; // ROC_FORMAT_OPUS
+#endif // ROC_TARGET_LIBOPUS
+
     default:
         roc_log(LogError,
                 "bad configuration: invalid roc_media_encoding.format:"
@@ -648,6 +754,11 @@ bool sample_format_to_user(roc_media_encoding& out, const audio::SampleSpec& in)
         }
     } break; // audio::Format_Pcm
 
+    case audio::Format_Opus: {
+        out.format = ROC_FORMAT_OPUS;
+        out.subformat = (roc_subformat)0;
+    } break; // audio::Format_Opus
+
     default:
         roc_log(LogError, "bad configuration: unsupported sample format");
         return false;
@@ -732,6 +843,25 @@ bool clock_source_from_user(bool& out_timing, roc_clock_source in) {
     return false;
 }
 
+ROC_NOSANITIZE
+bool thread_policy_from_user(core::ThreadPolicy& out, roc_thread_policy in) {
+    switch (enum_from_user(in)) {
+    case ROC_THREAD_POLICY_DEFAULT:
+        out = core::ThreadPolicy_Default;
+        return true;
+
+    case ROC_THREAD_POLICY_FIFO:
+        out = core::ThreadPolicy_Fifo;
+        return true;
+
+    case ROC_THREAD_POLICY_RR:
+        out = core::ThreadPolicy_RoundRobin;
+        return true;
+    }
+
+    return false;
+}
+
 ROC_NOSANITIZE
 bool latency_tuner_backend_from_user(audio::LatencyTunerBackend& out,
                                      roc_latency_tuner_backend in) {
@@ -790,6 +920,10 @@ bool resampler_backend_from_user(audio::ResamplerBackend& out, roc_resampler_bac
     case ROC_RESAMPLER_BACKEND_SPEEXDEC:
         out = audio::ResamplerBackend_SpeexDec;
         return true;
+
+    case ROC_RESAMPLER_BACKEND_POLYPHASE:
+        out = audio::ResamplerBackend_Polyphase;
+        return true;
     }
 
     return false;
@@ -845,6 +979,14 @@ bool packet_encoding_from_user(unsigned& out_id, roc_packet_encoding in) {
     case ROC_PACKET_ENCODING_AVP_L16_STEREO:
         out_id = rtp::PayloadType_L16_Stereo;
         return true;
+
+    case ROC_PACKET_ENCODING_OPUS_MONO:
+        out_id = rtp::PayloadType_Opus_Mono;
+        return true;
+
+    case ROC_PACKET_ENCODING_OPUS_STEREO:
+        out_id = rtp::PayloadType_Opus_Stereo;
+        return true;
     }
 
     if ((int)in >= (int)ROC_ENCODING_ID_MIN && (int)in <= (int)ROC_ENCODING_ID_MAX) {
@@ -971,6 +1113,18 @@ bool proto_to_user(roc_protocol& out, address::Protocol in) {
 }
 
 ROC_NOSANITIZE
+void context_metrics_to_user(roc_context_metrics& out, const node::ContextMetrics& in) {
+    memset(&out, 0, sizeof(out));
+
+    out.memory_locked = in.memory_locked ? 1 : 0;
+    out.thread_config_failures = (unsigned)in.thread_config_failures;
+
+    out.kernel_timestamped_packets = (unsigned long long)in.kernel_timestamped_packets;
+    out.kernel_timestamp_mean_delay =
+        (unsigned long long)in.kernel_timestamp_mean_delay;
+    out.kernel_timestamp_max_delay = (unsigned long long)in.kernel_timestamp_max_delay;
+}
+
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg) {
     roc_receiver_metrics& out = *(roc_receiver_metrics*)slot_arg;
@@ -978,6 +1132,9 @@ void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_met
     memset(&out, 0, sizeof(out));
 
     out.connection_count = (unsigned)slot_metrics.num_participants;
+
+    stage_metrics_to_user(out.mixer_timing,
+                          slot_metrics.stages[pipeline::Stage_Mixer]);
 }
 
 ROC_NOSANITIZE
@@ -1000,6 +1157,22 @@ void receiver_participant_metrics_to_user(
             party_metrics.depacketizer.recovered_packets, (uint64_t)0,
             party_metrics.link.expected_packets);
     }
+
+    stage_metrics_to_user(out.fec_decoder_timing,
+                          party_metrics.stages[pipeline::Stage_FecDecoder]);
+    stage_metrics_to_user(out.depacketizer_timing,
+                          party_metrics.stages[pipeline::Stage_Depacketizer]);
+    stage_metrics_to_user(out.plc_timing, party_metrics.stages[pipeline::Stage_Plc]);
+    stage_metrics_to_user(out.watchdog_timing,
+                          party_metrics.stages[pipeline::Stage_Watchdog]);
+    stage_metrics_to_user(out.channel_mapper_timing,
+                          party_metrics.stages[pipeline::Stage_ChannelMapper]);
+    stage_metrics_to_user(out.resampler_timing,
+                          party_metrics.stages[pipeline::Stage_Resampler]);
+    stage_metrics_to_user(out.latency_monitor_timing,
+                          party_metrics.stages[pipeline::Stage_LatencyMonitor]);
+
+    fec_reader_metrics_to_user(out.fec_block_timing, party_metrics.fec_reader);
 }
 
 ROC_NOSANITIZE
@@ -1010,6 +1183,20 @@ void sender_slot_metrics_to_user(const pipeline::SenderSlotMetrics& slot_metrics
     memset(&out, 0, sizeof(out));
 
     out.connection_count = (unsigned)slot_metrics.num_participants;
+
+    out.fec_block_source_packets = (unsigned)slot_metrics.fec_source_packets;
+    out.fec_block_repair_packets = (unsigned)slot_metrics.fec_repair_packets;
+
+    stage_metrics_to_user(out.feedback_monitor_timing,
+                          slot_metrics.stages[pipeline::Stage_FeedbackMonitor]);
+    stage_metrics_to_user(out.resampler_timing,
+                          slot_metrics.stages[pipeline::Stage_Resampler]);
+    stage_metrics_to_user(out.channel_mapper_timing,
+                          slot_metrics.stages[pipeline::Stage_ChannelMapper]);
+    stage_metrics_to_user(out.packetizer_timing,
+                          slot_metrics.stages[pipeline::Stage_Packetizer]);
+    stage_metrics_to_user(out.fec_encoder_timing,
+                          slot_metrics.stages[pipeline::Stage_FecEncoder]);
 }
 
 ROC_NOSANITIZE
@@ -1048,6 +1235,28 @@ void link_metrics_to_user(roc_connection_metrics& out, const packet::LinkMetrics
     }
 }
 
+void stage_metrics_to_user(roc_stage_timing& out, const pipeline::StageMetrics& in) {
+    if (!in.is_active) {
+        return;
+    }
+
+    out.p50_time = (unsigned long long)in.p50_time;
+    out.p99_time = (unsigned long long)in.p99_time;
+    out.max_time = (unsigned long long)in.max_time;
+}
+
+ROC_NOSANITIZE
+void fec_reader_metrics_to_user(roc_stage_timing& out,
+                                const fec::BlockReaderMetrics& in) {
+    if (in.decoded_blocks == 0) {
+        return;
+    }
+
+    out.p50_time = (unsigned long long)in.decode_time_p50;
+    out.p99_time = (unsigned long long)in.decode_time_p99;
+    out.max_time = (unsigned long long)in.decode_time_max;
+}
+
 ROC_NOSANITIZE
 LogLevel log_level_from_user(roc_log_level in) {
     switch (enum_from_user(in)) {
@@ -22,6 +22,7 @@ namespace roc {
 namespace api {
 
 bool context_config_from_user(node::ContextConfig& out, const roc_context_config& in);
+bool thread_config_from_user(core::ThreadConfig& out, const roc_thread_config& in);
 
 bool sender_config_from_user(node::Context& context,
                              pipeline::SenderSinkConfig& out,
@@ -48,6 +49,8 @@ bool channel_set_to_user(roc_channel_layout& out_layout,
 
 bool clock_source_from_user(bool& out_timing, roc_clock_source in);
 
+bool thread_policy_from_user(core::ThreadPolicy& out, roc_thread_policy in);
+
 bool latency_tuner_backend_from_user(audio::LatencyTunerBackend& out,
                                      roc_latency_tuner_backend in);
 bool latency_tuner_profile_from_user(audio::LatencyTunerProfile& out,
@@ -66,6 +69,8 @@ bool interface_from_user(address::Interface& out, const roc_interface& in);
 bool proto_from_user(address::Protocol& out, const roc_protocol& in);
 bool proto_to_user(roc_protocol& out, address::Protocol in);
 
+void context_metrics_to_user(roc_context_metrics& out, const node::ContextMetrics& in);
+
 void receiver_slot_metrics_to_user(const pipeline::ReceiverSlotMetrics& slot_metrics,
                                    void* slot_arg);
 void receiver_participant_metrics_to_user(
@@ -83,6 +88,9 @@ void sender_participant_metrics_to_user(
 void latency_metrics_to_user(roc_connection_metrics& out,
                              const audio::LatencyMetrics& in);
 void link_metrics_to_user(roc_connection_metrics& out, const packet::LinkMetrics& in);
+void stage_metrics_to_user(roc_stage_timing& out, const pipeline::StageMetrics& in);
+void fec_reader_metrics_to_user(roc_stage_timing& out,
+                                const fec::BlockReaderMetrics& in);
 
 LogLevel log_level_from_user(roc_log_level level);
 roc_log_level log_level_to_user(LogLevel level);
@@ -40,6 +40,96 @@ TEST(context, open_null) {
     LONGS_EQUAL(-1, roc_context_open(&config, NULL));
 }
 
+TEST(context, thread_config) {
+    { // prewarm pools
+        roc_context_config config;
+        memset(&config, 0, sizeof(config));
+        config.prewarm_packets = 16;
+        config.prewarm_frames = 16;
+
+        roc_context* context = NULL;
+        CHECK(roc_context_open(&config, &context) == 0);
+        CHECK(context);
+
+        LONGS_EQUAL(0, roc_context_close(context));
+    }
+    { // invalid policy
+        roc_context_config config;
+        memset(&config, 0, sizeof(config));
+        config.network_thread.policy = (roc_thread_policy)100;
+
+        roc_context* context = NULL;
+        LONGS_EQUAL(-1, roc_context_open(&config, &context));
+        CHECK(!context);
+    }
+    { // negative priority
+        roc_context_config config;
+        memset(&config, 0, sizeof(config));
+        config.control_thread.policy = ROC_THREAD_POLICY_FIFO;
+        config.control_thread.priority = -1;
+
+        roc_context* context = NULL;
+        LONGS_EQUAL(-1, roc_context_open(&config, &context));
+        CHECK(!context);
+    }
+    { // priority without realtime policy
+        roc_context_config config;
+        memset(&config, 0, sizeof(config));
+        config.network_thread.priority = 10;
+
+        roc_context* context = NULL;
+        LONGS_EQUAL(-1, roc_context_open(&config, &context));
+        CHECK(!context);
+    }
+}
+
+TEST(context, query) {
+    roc_context_config config;
+    memset(&config, 0, sizeof(config));
+
+    roc_context* context = NULL;
+    CHECK(roc_context_open(&config, &context) == 0);
+    CHECK(context);
+
+    roc_context_metrics metrics;
+    memset(&metrics, 0xff, sizeof(metrics));
+
+    LONGS_EQUAL(0, roc_context_query(context, &metrics));
+    UNSIGNED_LONGS_EQUAL(0, metrics.memory_locked);
+    UNSIGNED_LONGS_EQUAL(0, metrics.kernel_timestamped_packets);
+    UNSIGNED_LONGS_EQUAL(0, metrics.kernel_timestamp_mean_delay);
+    UNSIGNED_LONGS_EQUAL(0, metrics.kernel_timestamp_max_delay);
+
+    LONGS_EQUAL(-1, roc_context_query(NULL, &metrics));
+    LONGS_EQUAL(-1, roc_context_query(context, NULL));
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
+TEST(context, lock_memory) {
+    roc_context_config config;
+    memset(&config, 0, sizeof(config));
+    config.lock_memory = 1;
+    config.prewarm_packets = 16;
+    config.prewarm_frames = 16;
+
+    roc_context* context = NULL;
+    CHECK(roc_context_open(&config, &context) == 0);
+    CHECK(context);
+
+    roc_context_metrics metrics;
+    memset(&metrics, 0, sizeof(metrics));
+
+    LONGS_EQUAL(0, roc_context_query(context, &metrics));
+
+    // locking may be not permitted, then failure should be reported
+    if (!metrics.memory_locked) {
+        CHECK(metrics.thread_config_failures != 0);
+    }
+
+    LONGS_EQUAL(0, roc_context_close(context));
+}
+
 TEST(context, close_null) {
     LONGS_EQUAL(-1, roc_context_close(NULL));
 }
@@ -233,6 +233,48 @@ TEST(loopback_sender_2_receiver, rs8m_with_losses) {
     CHECK(proxy.n_dropped_packets() > 0);
 }
 
+TEST(loopback_sender_2_receiver, rs8m_with_losses_incremental) {
+    if (!is_rs8m_supported()) {
+        TEST_SKIP();
+    }
+
+    enum {
+        Flags = test::FlagRS8M | test::FlagLoseSomePkts,
+        SampleRate = 44100,
+        FrameChans = 2,
+        PacketChans = 2
+    };
+
+    init_config(Flags, SampleRate, FrameChans, PacketChans);
+
+    receiver_conf.fec_incremental_decoding = 1;
+
+    test::Context context;
+
+    test::Receiver receiver(context, receiver_conf, sample_step, FrameChans,
+                            test::FrameSamples, Flags);
+
+    receiver.bind();
+
+    test::Proxy proxy(receiver.source_endpoint(), receiver.repair_endpoint(),
+                      test::SourcePackets, test::RepairPackets, Flags);
+
+    test::Sender sender(context, sender_conf, sample_step, FrameChans, test::FrameSamples,
+                        Flags);
+
+    sender.connect(proxy.source_endpoint(), proxy.repair_endpoint(), NULL);
+
+    CHECK(proxy.start());
+    CHECK(sender.start());
+
+    receiver.receive();
+
+    sender.stop_and_join();
+    proxy.stop_and_join();
+
+    CHECK(proxy.n_dropped_packets() > 0);
+}
+
 TEST(loopback_sender_2_receiver, ldpc_without_losses) {
     if (!is_ldpc_supported()) {
         TEST_SKIP();
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/jitter_meter.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_JitterMeter/<estimator>
+//   Cost of JitterMeter::update_jitter() per packet, with default config and
+//   given estimator (0 is exact, 1 is blocks).
+//
+// Output column "memory_bytes" reports how much memory meter allocated.
+// Output columns "mean_error" and "peak_error" report average relative error
+// of mean and peak jitter compared to exact estimator (zero for exact).
+
+enum { NumPackets = 200000 };
+
+core::HeapArena heap_arena;
+
+// Arena that counts how much memory is currently allocated.
+class CountingArena : public core::IArena {
+public:
+    CountingArena()
+        : allocated_(0) {
+    }
+
+    size_t allocated() const {
+        return allocated_;
+    }
+
+    virtual void* allocate(size_t size) {
+        void* ptr = heap_arena.allocate(size);
+        if (ptr) {
+            allocated_ += size;
+        }
+        return ptr;
+    }
+
+    virtual void deallocate(void* ptr) {
+        allocated_ -= heap_arena.allocated_size(ptr);
+        heap_arena.deallocate(ptr);
+    }
+
+    virtual size_t compute_allocated_size(size_t size) const {
+        return heap_arena.compute_allocated_size(size);
+    }
+
+    virtual size_t allocated_size(void* ptr) const {
+        return heap_arena.allocated_size(ptr);
+    }
+
+private:
+    size_t allocated_;
+};
+
+// Gaussian jitter with rare spikes, similar to wireless network.
+const core::nanoseconds_t* get_jitter() {
+    static core::nanoseconds_t jitter[NumPackets];
+    static bool generated = false;
+
+    if (!generated) {
+        for (size_t n = 0; n < NumPackets; n++) {
+            double value = std::abs(core::fast_random_gaussian()) * core::Millisecond;
+            if (core::fast_random_range(0, 200) == 0) {
+                value += (double)core::fast_random_range(5, 50) * core::Millisecond;
+            }
+            jitter[n] = (core::nanoseconds_t)value;
+        }
+        generated = true;
+    }
+
+    return jitter;
+}
+
+JitterMeterConfig make_config(JitterEstimator estimator) {
+    JitterMeterConfig config;
+    config.estimator = estimator;
+    roc_panic_if(!config.deduce_defaults(LatencyTunerProfile_Intact));
+    return config;
+}
+
+double relative_error(core::nanoseconds_t actual, core::nanoseconds_t expected) {
+    if (expected == 0) {
+        return 0;
+    }
+    return std::abs(double(actual - expected)) / double(expected);
+}
+
+void BM_JitterMeter(benchmark::State& state) {
+    const JitterEstimator estimator = (JitterEstimator)state.range(0);
+
+    state.SetLabel(jitter_estimator_to_str(estimator));
+
+    const core::nanoseconds_t* jitter = get_jitter();
+
+    CountingArena arena;
+    JitterMeter meter(make_config(estimator), arena);
+
+    size_t pos = 0;
+
+    while (state.KeepRunning()) {
+        meter.update_jitter(jitter[pos]);
+        pos = (pos + 1) % NumPackets;
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+    state.counters["memory_bytes"] = (double)arena.allocated();
+
+    // Compare with exact meter on the same input.
+    // Skip first jitter window, until both meters are warmed up.
+    JitterMeter test_meter(make_config(estimator), heap_arena);
+    JitterMeter exact_meter(make_config(JitterEstimator_Exact), heap_arena);
+
+    const size_t warmup = make_config(estimator).jitter_window;
+
+    double mean_error = 0, peak_error = 0;
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        test_meter.update_jitter(jitter[n]);
+        exact_meter.update_jitter(jitter[n]);
+
+        if (n >= warmup) {
+            mean_error += relative_error(test_meter.metrics().mean_jitter,
+                                         exact_meter.metrics().mean_jitter);
+            peak_error += relative_error(test_meter.metrics().peak_jitter,
+                                         exact_meter.metrics().peak_jitter);
+        }
+    }
+
+    state.counters["mean_error"] = mean_error / double(NumPackets - warmup);
+    state.counters["peak_error"] = peak_error / double(NumPackets - warmup);
+}
+
+BENCHMARK(BM_JitterMeter)
+    ->Arg(JitterEstimator_Exact)
+    ->Arg(JitterEstimator_Blocks)
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/mixer.h"
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_MixerKernel/<kernel>/<samples>
+//   Throughput of a single kernel call, mixing one buffer into another.
+//
+//  BM_Mixer/<inputs>/<samples>
+//   Throughput of Mixer::read() with given number of inputs and frame size,
+//   using the kernel selected at runtime.
+//
+//  BM_MixerCopy/direct:<direct>/<samples>
+//   Mixer::read() with one input. <direct> is 1 when input has unity gain and
+//   writes directly into output frame, and 0 when non-unity gain forces input
+//   to write into intermediate frame, which is then copied to output (this is
+//   what mixer did for every input before direct reads were added).
+//
+// Output column "items_per_second" reports input samples mixed per second.
+// Output column "copied_bytes_per_frame" reports how much bytes were written
+// by input to intermediate buffer and then copied by mixer, per output frame.
+
+enum { SampleRate = 48000, MaxInputs = 64, MaxSamples = 8192 };
+
+const SampleSpec sample_spec(SampleRate,
+                             PcmSubformat_Raw,
+                             ChanLayout_Surround,
+                             ChanOrder_Smpte,
+                             ChanMask_Surround_Stereo);
+
+core::HeapArena arena;
+
+// Reader that returns same pre-generated samples on every read.
+class BenchReader : public IFrameReader {
+public:
+    BenchReader(FrameFactory& frame_factory)
+        : frame_factory_(frame_factory)
+        , out_data_(NULL)
+        , copied_bytes_(0) {
+        for (size_t n = 0; n < MaxSamples; n++) {
+            samples_[n] = core::fast_random_float() * 0.1f - 0.05f;
+        }
+    }
+
+    virtual status::StatusCode
+    read(Frame& frame, packet::stream_timestamp_t duration, FrameReadMode mode) {
+        const size_t n_samples = duration * sample_spec.num_channels();
+        roc_panic_if(n_samples > MaxSamples);
+
+        if (!frame_factory_.reallocate_frame(
+                frame, sample_spec.stream_timestamp_2_bytes(duration))) {
+            return status::StatusNoMem;
+        }
+
+        frame.set_raw(true);
+        memcpy(frame.raw_samples(), samples_, n_samples * sizeof(sample_t));
+        frame.set_num_raw_samples(n_samples);
+        frame.set_duration(duration);
+
+        if (frame.raw_samples() != out_data_) {
+            copied_bytes_ += n_samples * sizeof(sample_t);
+        }
+
+        return status::StatusOK;
+    }
+
+    // Set buffer of output frame, to detect reads into other buffers.
+    void set_out_data(const sample_t* out_data) {
+        out_data_ = out_data;
+    }
+
+    // Get number of bytes written not into output frame.
+    size_t copied_bytes() const {
+        return copied_bytes_;
+    }
+
+private:
+    FrameFactory& frame_factory_;
+    sample_t samples_[MaxSamples];
+
+    const sample_t* out_data_;
+    size_t copied_bytes_;
+};
+
+void BM_MixerKernel(benchmark::State& state) {
+    const MixerKernel kernel = (MixerKernel)state.range(0);
+    const size_t n_samples = (size_t)state.range(1);
+
+    if (!mixer_kernel_supported(kernel)) {
+        state.SkipWithError("kernel not supported by cpu");
+        return;
+    }
+
+    state.SetLabel(mixer_kernel_to_str(kernel));
+
+    const MixerKernelFunc func = mixer_kernel_func(kernel);
+
+    static sample_t in[MaxSamples];
+    static sample_t mix[MaxSamples];
+
+    for (size_t n = 0; n < n_samples; n++) {
+        in[n] = core::fast_random_float() * 0.1f - 0.05f;
+        mix[n] = 0;
+    }
+
+    while (state.KeepRunning()) {
+        func(mix, in, n_samples, 0.5f);
+        benchmark::DoNotOptimize(mix);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+}
+
+BENCHMARK(BM_MixerKernel)
+    ->Args({ MixerKernel_Scalar, 256 })
+    ->Args({ MixerKernel_Scalar, 2048 })
+    ->Args({ MixerKernel_SSE2, 256 })
+    ->Args({ MixerKernel_SSE2, 2048 })
+    ->Args({ MixerKernel_AVX2, 256 })
+    ->Args({ MixerKernel_AVX2, 2048 })
+    ->Args({ MixerKernel_NEON, 256 })
+    ->Args({ MixerKernel_NEON, 2048 })
+    ->Unit(benchmark::kNanosecond);
+
+void BM_Mixer(benchmark::State& state) {
+    const size_t n_inputs = (size_t)state.range(0);
+    const size_t n_samples = (size_t)state.range(1);
+
+    roc_panic_if(n_inputs > MaxInputs);
+
+    FrameFactory frame_factory(arena, MaxSamples * sizeof(sample_t));
+
+    Mixer mixer(sample_spec, false, frame_factory, arena);
+    roc_panic_if(mixer.init_status() != status::StatusOK);
+
+    BenchReader* readers[MaxInputs];
+
+    for (size_t n = 0; n < n_inputs; n++) {
+        readers[n] = new BenchReader(frame_factory);
+        roc_panic_if(mixer.add_input(*readers[n]) != status::StatusOK);
+    }
+
+    FramePtr frame = frame_factory.allocate_frame(0);
+    roc_panic_if(!frame);
+
+    const packet::stream_timestamp_t duration =
+        packet::stream_timestamp_t(n_samples / sample_spec.num_channels());
+
+    while (state.KeepRunning()) {
+        if (mixer.read(*frame, duration, ModeHard) != status::StatusOK) {
+            roc_panic("bench: mixer read failed");
+        }
+        benchmark::DoNotOptimize(frame->raw_samples());
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples)
+                            * int64_t(n_inputs));
+
+    for (size_t n = 0; n < n_inputs; n++) {
+        mixer.remove_input(*readers[n]);
+        delete readers[n];
+    }
+}
+
+BENCHMARK(BM_Mixer)
+    ->Args({ 1, 480 })
+    ->Args({ 4, 480 })
+    ->Args({ 16, 480 })
+    ->Args({ 32, 480 })
+    ->Args({ 64, 480 })
+    ->Args({ 1, 4800 })
+    ->Args({ 4, 4800 })
+    ->Args({ 16, 4800 })
+    ->Args({ 32, 4800 })
+    ->Args({ 64, 4800 })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_MixerCopy(benchmark::State& state) {
+    const bool direct = state.range(0) != 0;
+    const size_t n_samples = (size_t)state.range(1);
+
+    FrameFactory frame_factory(arena, MaxSamples * sizeof(sample_t));
+
+    Mixer mixer(sample_spec, false, frame_factory, arena);
+    roc_panic_if(mixer.init_status() != status::StatusOK);
+
+    BenchReader reader(frame_factory);
+    roc_panic_if(mixer.add_input(reader) != status::StatusOK);
+
+    if (!direct) {
+        mixer.set_input_gain(reader, 0.5f);
+    }
+
+    const packet::stream_timestamp_t duration =
+        packet::stream_timestamp_t(n_samples / sample_spec.num_channels());
+
+    FramePtr frame = frame_factory.allocate_frame(
+        sample_spec.stream_timestamp_2_bytes(duration));
+    roc_panic_if(!frame);
+
+    frame->set_raw(true);
+    reader.set_out_data(frame->raw_samples());
+
+    while (state.KeepRunning()) {
+        if (mixer.read(*frame, duration, ModeHard) != status::StatusOK) {
+            roc_panic("bench: mixer read failed");
+        }
+        benchmark::DoNotOptimize(frame->raw_samples());
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+    state.counters["copied_bytes_per_frame"] =
+        double(reader.copied_bytes()) / double(state.iterations());
+
+    mixer.remove_input(reader);
+}
+
+BENCHMARK(BM_MixerCopy)
+    ->ArgNames({ "direct", "" })
+    ->ArgsProduct({ { 0, 1 }, { 480, 4800 } })
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef ROC_TARGET_LIBOPUS
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_OpusEncode/<channels>/<samples>
+//   Throughput of OpusEncoder, encoding one packet of given duration
+//   (samples per channel) per iteration.
+//
+//  BM_OpusDecode/<channels>/<samples>
+//   Throughput of OpusDecoder, decoding one packet of given duration
+//   (samples per channel) per iteration.
+//
+// Output column "items_per_second" reports samples per channel per second.
+
+enum { SampleRate = 48000, MaxSamples = 5760, MaxChans = 2, MaxBytes = 4000 };
+
+core::HeapArena arena;
+
+SampleSpec make_spec(size_t n_chans) {
+    SampleSpec spec;
+    spec.set_format(Format_Opus);
+    spec.set_sample_rate(SampleRate);
+    spec.set_channel_set(ChannelSet(ChanLayout_Surround, ChanOrder_Smpte,
+                                    n_chans == 1 ? ChanMask_Surround_Mono
+                                                 : ChanMask_Surround_Stereo));
+    return spec;
+}
+
+void fill_samples(sample_t* samples, size_t n_samples) {
+    for (size_t n = 0; n < n_samples; n++) {
+        samples[n] = core::fast_random_float() * 0.2f - 0.1f;
+    }
+}
+
+size_t encode(OpusEncoder& encoder,
+              uint8_t* bytes,
+              const sample_t* samples,
+              size_t n_samples) {
+    const size_t n_bytes = encoder.encoded_byte_count(n_samples);
+    roc_panic_if(n_bytes > MaxBytes);
+
+    encoder.begin_frame(bytes, n_bytes);
+    if (encoder.write_samples(samples, n_samples) != n_samples) {
+        roc_panic("bench: opus encoder write failed");
+    }
+    encoder.end_frame();
+
+    return n_bytes;
+}
+
+void BM_OpusEncode(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+    const size_t n_samples = (size_t)state.range(1);
+
+    OpusEncoder encoder(make_spec(n_chans), arena);
+    roc_panic_if(encoder.init_status() != status::StatusOK);
+
+    static sample_t samples[MaxSamples * MaxChans];
+    static uint8_t bytes[MaxBytes];
+
+    fill_samples(samples, n_samples * n_chans);
+
+    while (state.KeepRunning()) {
+        encode(encoder, bytes, samples, n_samples);
+        benchmark::DoNotOptimize(bytes);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+}
+
+BENCHMARK(BM_OpusEncode)
+    ->Args({ 1, 240 })
+    ->Args({ 2, 240 })
+    ->Args({ 1, 960 })
+    ->Args({ 2, 960 })
+    ->Args({ 1, 2880 })
+    ->Args({ 2, 2880 })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_OpusDecode(benchmark::State& state) {
+    const size_t n_chans = (size_t)state.range(0);
+    const size_t n_samples = (size_t)state.range(1);
+
+    OpusEncoder encoder(make_spec(n_chans), arena);
+    roc_panic_if(encoder.init_status() != status::StatusOK);
+
+    OpusDecoder decoder(make_spec(n_chans), arena);
+    roc_panic_if(decoder.init_status() != status::StatusOK);
+
+    static sample_t samples[MaxSamples * MaxChans];
+    static uint8_t bytes[MaxBytes];
+
+    fill_samples(samples, n_samples * n_chans);
+
+    const size_t n_bytes = encode(encoder, bytes, samples, n_samples);
+
+    packet::stream_timestamp_t pos = 0;
+
+    while (state.KeepRunning()) {
+        decoder.begin_frame(pos, bytes, n_bytes);
+        if (decoder.read_samples(samples, n_samples) != n_samples) {
+            roc_panic("bench: opus decoder read failed");
+        }
+        decoder.end_frame();
+        benchmark::DoNotOptimize(samples);
+
+        pos += (packet::stream_timestamp_t)n_samples;
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * int64_t(n_samples));
+}
+
+BENCHMARK(BM_OpusDecode)
+    ->Args({ 1, 240 })
+    ->Args({ 2, 240 })
+    ->Args({ 1, 960 })
+    ->Args({ 2, 960 })
+    ->Args({ 1, 2880 })
+    ->Args({ 2, 2880 })
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_TARGET_LIBOPUS
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/pcm_subformat.h"
+#include "roc_audio/sample.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_PcmMapToRaw/<format>/<impl>
+//   Throughput of conversion from given format to raw samples.
+//
+//  BM_PcmMapFromRaw/<format>/<impl>
+//   Throughput of conversion from raw samples to given format.
+//
+// <format> is an index in Formats array (see label for format name).
+// <impl> is 0 for generic mapping function, and 1 for fast path.
+//
+// Output column "items_per_second" reports samples converted per second.
+
+enum { NumSamples = 4800, MaxBytes = NumSamples * 8 };
+
+const PcmSubformat Formats[] = {
+    PcmSubformat_SInt16_Le, PcmSubformat_SInt16_Be, PcmSubformat_SInt24_Le,
+    PcmSubformat_SInt24_Be, PcmSubformat_SInt32_Le, PcmSubformat_SInt32_Be,
+    PcmSubformat_Float32_Le, PcmSubformat_Float32_Be,
+};
+
+enum { NumFormats = ROC_ARRAY_SIZE(Formats) };
+
+uint8_t in_buf[MaxBytes];
+uint8_t out_buf[MaxBytes];
+
+void fill_input(PcmSubformat in_format) {
+    if (in_format == PcmSubformat_Raw) {
+        sample_t* samples = (sample_t*)in_buf;
+        for (size_t n = 0; n < NumSamples; n++) {
+            samples[n] = core::fast_random_float() * 2.2f - 1.1f;
+        }
+    } else {
+        for (size_t n = 0; n < MaxBytes; n++) {
+            in_buf[n] = (uint8_t)core::fast_random_range(0, 255);
+        }
+    }
+}
+
+void run_bench(benchmark::State& state,
+               PcmSubformat in_format,
+               PcmSubformat out_format,
+               bool fast) {
+    state.SetLabel(pcm_subformat_to_str(in_format == PcmSubformat_Raw ? out_format
+                                                                      : in_format));
+
+    fill_input(in_format);
+
+    if (fast) {
+        const PcmFastMapFn fn = pcm_subformat_fast_mapfn(in_format, out_format);
+        if (!fn) {
+            state.SkipWithError("no fast path on this cpu");
+            return;
+        }
+
+        while (state.KeepRunning()) {
+            fn(in_buf, out_buf, NumSamples);
+            benchmark::DoNotOptimize(out_buf);
+        }
+    } else {
+        const PcmMapFn fn = pcm_subformat_mapfn(in_format, out_format);
+        roc_panic_if(!fn);
+
+        while (state.KeepRunning()) {
+            size_t in_off = 0, out_off = 0;
+            fn(in_buf, in_off, out_buf, out_off, NumSamples);
+            benchmark::DoNotOptimize(out_buf);
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()) * NumSamples);
+}
+
+void BM_PcmMapToRaw(benchmark::State& state) {
+    run_bench(state, Formats[state.range(0)], PcmSubformat_Raw, state.range(1) != 0);
+}
+
+BENCHMARK(BM_PcmMapToRaw)
+    ->ArgsProduct({ benchmark::CreateDenseRange(0, NumFormats - 1, 1), { 0, 1 } })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_PcmMapFromRaw(benchmark::State& state) {
+    run_bench(state, PcmSubformat_Raw, Formats[state.range(0)], state.range(1) != 0);
+}
+
+BENCHMARK(BM_PcmMapFromRaw)
+    ->ArgsProduct({ benchmark::CreateDenseRange(0, NumFormats - 1, 1), { 0, 1 } })
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
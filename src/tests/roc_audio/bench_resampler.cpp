@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/processor_map.h"
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+
+namespace roc {
+namespace audio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_Resampler/<backend>/<profile>/<in_rate>
+//   Throughput of IResampler, converting stereo stream from given input rate
+//   to 48000, with small clock drift compensation factor applied on top.
+//
+// Output column "items_per_second" reports output samples produced per second,
+// counting all channels.
+
+enum { OutRate = 48000, OutFrameSize = 960, MaxFrameSize = 8192 };
+
+const float DriftMultiplier = 1.0005f;
+
+core::HeapArena arena;
+ProcessorMap processor_map(arena);
+
+SampleSpec make_spec(size_t rate) {
+    return SampleSpec(rate, PcmSubformat_Raw, ChanLayout_Surround, ChanOrder_Smpte,
+                      ChanMask_Surround_Stereo);
+}
+
+void BM_Resampler(benchmark::State& state) {
+    const ResamplerBackend backend = (ResamplerBackend)state.range(0);
+    const ResamplerProfile profile = (ResamplerProfile)state.range(1);
+    const size_t in_rate = (size_t)state.range(2);
+
+    if (!processor_map.has_resampler_backend(backend)) {
+        state.SkipWithError("backend not available");
+        return;
+    }
+
+    char label[64];
+    snprintf(label, sizeof(label), "%s/%s", resampler_backend_to_str(backend),
+             resampler_profile_to_str(profile));
+    state.SetLabel(label);
+
+    const SampleSpec in_spec = make_spec(in_rate);
+    const SampleSpec out_spec = make_spec(OutRate);
+
+    FrameFactory frame_factory(arena, MaxFrameSize * sizeof(sample_t));
+
+    ResamplerConfig config;
+    config.backend = backend;
+    config.profile = profile;
+
+    core::SharedPtr<IResampler> resampler =
+        processor_map.new_resampler(config, in_spec, out_spec, frame_factory, arena);
+    roc_panic_if(!resampler);
+    roc_panic_if(resampler->init_status() != status::StatusOK);
+
+    if (!resampler->set_scaling(in_rate, OutRate, DriftMultiplier)) {
+        roc_panic("bench: set_scaling() failed");
+    }
+
+    static sample_t noise[MaxFrameSize];
+    for (size_t n = 0; n < MaxFrameSize; n++) {
+        noise[n] = core::fast_random_float() * 0.1f - 0.05f;
+    }
+
+    static sample_t out[OutFrameSize * 2];
+    const size_t out_size = OutFrameSize * out_spec.num_channels();
+
+    size_t n_total = 0;
+
+    while (state.KeepRunning()) {
+        size_t n_out = 0;
+
+        while (n_out < out_size) {
+            const size_t n_popped =
+                resampler->pop_output(out + n_out, out_size - n_out);
+            n_out += n_popped;
+
+            if (n_out < out_size) {
+                const core::Slice<sample_t>& in = resampler->begin_push_input();
+                roc_panic_if(in.size() > MaxFrameSize);
+                memcpy(in.data(), noise, in.size() * sizeof(sample_t));
+                resampler->end_push_input();
+            }
+        }
+
+        benchmark::DoNotOptimize(out);
+        n_total += n_out;
+    }
+
+    state.SetItemsProcessed(int64_t(n_total));
+}
+
+BENCHMARK(BM_Resampler)
+    ->ArgsProduct({ { ResamplerBackend_Builtin, ResamplerBackend_Polyphase,
+                      ResamplerBackend_Speex, ResamplerBackend_SpeexDec },
+                    { ResamplerProfile_Low, ResamplerProfile_Medium,
+                      ResamplerProfile_High },
+                    { 44100, 48000 } })
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace audio
+} // namespace roc
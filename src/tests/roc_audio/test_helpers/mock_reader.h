@@ -34,7 +34,8 @@ public:
         , status_(status::NoStatus)
         , drain_status_(status::NoStatus)
         , last_status_(status::NoStatus)
-        , last_mode_((FrameReadMode)-1) {
+        , last_mode_((FrameReadMode)-1)
+        , last_data_(NULL) {
     }
 
     virtual status::StatusCode read(Frame& frame,
@@ -70,6 +71,8 @@ public:
         frame.set_raw(true);
         frame.set_duration(duration);
 
+        last_data_ = frame.raw_samples();
+
         memcpy(frame.raw_samples(), samples_ + pos_,
                frame.num_raw_samples() * sizeof(sample_t));
 
@@ -154,6 +157,11 @@ public:
         return mode;
     }
 
+    // Buffer into which samples were written during last successful read.
+    const sample_t* last_data() const {
+        return last_data_;
+    }
+
 private:
     enum { MaxSz = 100000 };
 
@@ -177,6 +185,8 @@ private:
     status::StatusCode last_status_;
 
     FrameReadMode last_mode_;
+
+    const sample_t* last_data_;
 };
 
 } // namespace test
@@ -11,6 +11,8 @@
 #include "test_helpers/mock_reader.h"
 
 #include "roc_audio/mixer.h"
+#include "roc_audio/mixer_kernel.h"
+#include "roc_core/fast_random.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/stddefs.h"
 
@@ -120,6 +122,56 @@ TEST(mixer, one_input_big_frame) {
     LONGS_EQUAL(Factor, reader.total_reads());
 }
 
+// With one input, samples are written directly into output frame.
+TEST(mixer, one_input_direct_read) {
+    test::MockReader reader(frame_factory, sample_spec);
+
+    Mixer mixer(sample_spec, true, frame_factory, arena);
+    LONGS_EQUAL(status::StatusOK, mixer.init_status());
+
+    LONGS_EQUAL(status::StatusOK, mixer.add_input(reader));
+
+    reader.add_samples(BufSz * 3, 0.11f);
+
+    FramePtr frame = frame_factory.allocate_frame(0);
+    CHECK(frame);
+
+    LONGS_EQUAL(status::StatusOK, mixer.read(*frame, BufSz, ModeHard));
+    POINTERS_EQUAL(frame->raw_samples(), reader.last_data());
+
+    for (size_t n = 0; n < BufSz; n++) {
+        DOUBLES_EQUAL(0.11, (double)frame->raw_samples()[n], 0.0001);
+    }
+
+    // With non-unity gain, samples are written into intermediate buffer.
+    mixer.set_input_gain(reader, 0.5f);
+
+    LONGS_EQUAL(status::StatusOK, mixer.read(*frame, BufSz, ModeHard));
+    CHECK(frame->raw_samples() != reader.last_data());
+
+    for (size_t n = 0; n < BufSz; n++) {
+        DOUBLES_EQUAL(0.055, (double)frame->raw_samples()[n], 0.0001);
+    }
+
+    // Second input disables direct read.
+    test::MockReader reader2(frame_factory, sample_spec);
+    LONGS_EQUAL(status::StatusOK, mixer.add_input(reader2));
+    mixer.set_input_gain(reader, 1);
+
+    reader2.add_samples(BufSz, 0.22f);
+
+    LONGS_EQUAL(status::StatusOK, mixer.read(*frame, BufSz, ModeHard));
+    CHECK(frame->raw_samples() != reader.last_data());
+    CHECK(frame->raw_samples() != reader2.last_data());
+
+    for (size_t n = 0; n < BufSz; n++) {
+        DOUBLES_EQUAL(0.33, (double)frame->raw_samples()[n], 0.0001);
+    }
+
+    LONGS_EQUAL(0, reader.num_unread());
+    LONGS_EQUAL(0, reader2.num_unread());
+}
+
 TEST(mixer, two_inputs) {
     test::MockReader reader1(frame_factory, sample_spec);
     test::MockReader reader2(frame_factory, sample_spec);
@@ -331,6 +383,48 @@ TEST(mixer, clamp) {
     LONGS_EQUAL(0, reader2.num_unread());
 }
 
+TEST(mixer, gain) {
+    test::MockReader reader1(frame_factory, sample_spec);
+    test::MockReader reader2(frame_factory, sample_spec);
+
+    Mixer mixer(sample_spec, true, frame_factory, arena);
+    LONGS_EQUAL(status::StatusOK, mixer.init_status());
+
+    LONGS_EQUAL(status::StatusOK, mixer.add_input(reader1));
+    LONGS_EQUAL(status::StatusOK, mixer.add_input(reader2));
+
+    DOUBLES_EQUAL(1.0, (double)mixer.input_gain(reader1), 0);
+    DOUBLES_EQUAL(1.0, (double)mixer.input_gain(reader2), 0);
+
+    mixer.set_input_gain(reader1, 0.5f);
+    mixer.set_input_gain(reader2, 2.0f);
+
+    DOUBLES_EQUAL(0.5, (double)mixer.input_gain(reader1), 0);
+    DOUBLES_EQUAL(2.0, (double)mixer.input_gain(reader2), 0);
+
+    reader1.add_samples(BufSz, 0.2f);
+    reader2.add_samples(BufSz, 0.1f);
+
+    expect_output(status::StatusOK, mixer, BufSz, BufSz, 0.3f);
+
+    // clamp is applied after gain
+    reader1.add_samples(BufSz, 0.2f);
+    reader2.add_samples(BufSz, 0.6f);
+
+    expect_output(status::StatusOK, mixer, BufSz, BufSz, 1.0f);
+
+    // mute first input
+    mixer.set_input_gain(reader1, 0.0f);
+
+    reader1.add_samples(BufSz, 0.2f);
+    reader2.add_samples(BufSz, -0.2f);
+
+    expect_output(status::StatusOK, mixer, BufSz, BufSz, -0.4f);
+
+    LONGS_EQUAL(0, reader1.num_unread());
+    LONGS_EQUAL(0, reader2.num_unread());
+}
+
 TEST(mixer, cts_one_reader) {
     // BufSz samples per second
     const SampleSpec sample_spec(BufSz, PcmSubformat_Raw, ChanLayout_Surround,
@@ -1081,5 +1175,61 @@ TEST(mixer, preallocated_buffer) {
     }
 }
 
+TEST_GROUP(mixer_kernel) {};
+
+// Compare every supported kernel with scalar kernel on random input,
+// using sizes that are not multiple of vector width.
+TEST(mixer_kernel, compare_with_scalar) {
+    enum { NumSamples = 1000 };
+
+    const sample_t gain_list[] = { 1.0f, 0.0f, 0.5f, -1.5f };
+
+    const MixerKernelFunc scalar_func = mixer_kernel_func(MixerKernel_Scalar);
+
+    for (int kn = MixerKernel_Scalar; kn < MixerKernel_Max; kn++) {
+        const MixerKernel kernel = (MixerKernel)kn;
+
+        if (!mixer_kernel_supported(kernel)) {
+            continue;
+        }
+
+        const MixerKernelFunc kernel_func = mixer_kernel_func(kernel);
+
+        for (size_t gn = 0; gn < ROC_ARRAY_SIZE(gain_list); gn++) {
+            for (size_t size = 0; size < 40; size++) {
+                for (size_t offset = 0; offset < 3; offset++) {
+                    sample_t in[NumSamples];
+                    sample_t expected[NumSamples];
+                    sample_t actual[NumSamples];
+
+                    for (size_t n = 0; n < NumSamples; n++) {
+                        in[n] = core::fast_random_float() * 2.4f - 1.2f;
+                        expected[n] = actual[n] = core::fast_random_float() * 2 - 1;
+                    }
+
+                    scalar_func(expected + offset, in + offset, size, gain_list[gn]);
+                    kernel_func(actual + offset, in + offset, size, gain_list[gn]);
+
+                    for (size_t n = 0; n < NumSamples; n++) {
+                        DOUBLES_EQUAL((double)expected[n], (double)actual[n], 1e-6);
+                        CHECK(actual[n] >= Sample_Min && actual[n] <= Sample_Max);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(mixer_kernel, resolve) {
+    const MixerKernel kernel = mixer_kernel_resolve(MixerKernel_Auto);
+
+    CHECK(kernel != MixerKernel_Auto);
+    CHECK(mixer_kernel_supported(kernel));
+    CHECK(mixer_kernel_func(kernel) != NULL);
+
+    CHECK(mixer_kernel_supported(MixerKernel_Scalar));
+    LONGS_EQUAL(MixerKernel_Scalar, mixer_kernel_resolve(MixerKernel_Scalar));
+}
+
 } // namespace audio
 } // namespace roc
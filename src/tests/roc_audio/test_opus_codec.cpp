@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifdef ROC_TARGET_LIBOPUS
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_audio/opus_decoder.h"
+#include "roc_audio/opus_encoder.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+
+#include <math.h>
+
+namespace roc {
+namespace audio {
+
+namespace {
+
+enum { SampleRate = 48000, MaxSamples = 5760, MaxChans = 2, MaxBytes = 4000 };
+
+core::HeapArena arena;
+
+SampleSpec make_spec(size_t sample_rate, size_t n_chans) {
+    SampleSpec spec;
+    spec.set_format(Format_Opus);
+    spec.set_sample_rate(sample_rate);
+    spec.set_channel_set(ChannelSet(ChanLayout_Surround, ChanOrder_Smpte,
+                                    n_chans == 1 ? ChanMask_Surround_Mono
+                                                 : ChanMask_Surround_Stereo));
+    return spec;
+}
+
+void fill_samples(sample_t* samples, size_t n_samples, size_t n_chans) {
+    for (size_t n = 0; n < n_samples * n_chans; n++) {
+        samples[n] = sample_t(n % 97) / 97.0f * 0.2f - 0.1f;
+    }
+}
+
+// Voice-like signal: harmonics of a pitch changing from frame to frame.
+void fill_voice(sample_t* samples, size_t n_samples, size_t n_chans, size_t frame_idx) {
+    const double pitch = 120 + double(frame_idx % 7) * 15;
+
+    for (size_t n = 0; n < n_samples; n++) {
+        const double t = double(frame_idx * n_samples + n) / SampleRate;
+
+        double s = 0;
+        for (size_t h = 1; h <= 8; h++) {
+            s += sin(2 * M_PI * pitch * double(h) * t) / double(h);
+        }
+
+        for (size_t c = 0; c < n_chans; c++) {
+            samples[n * n_chans + c] = sample_t(s * 0.2);
+        }
+    }
+}
+
+size_t encode_frame(OpusEncoder& encoder,
+                    uint8_t* bytes,
+                    const sample_t* samples,
+                    size_t n_samples) {
+    const size_t n_bytes = encoder.encoded_byte_count(n_samples);
+    CHECK(n_bytes > 0);
+    CHECK(n_bytes <= MaxBytes);
+
+    encoder.begin_frame(bytes, n_bytes);
+    UNSIGNED_LONGS_EQUAL(n_samples, encoder.write_samples(samples, n_samples));
+    encoder.end_frame();
+
+    return n_bytes;
+}
+
+} // namespace
+
+TEST_GROUP(opus_codec) {};
+
+TEST(opus_codec, bad_spec) {
+    {
+        OpusEncoder encoder(make_spec(44100, 2), arena);
+        LONGS_EQUAL(status::StatusBadConfig, encoder.init_status());
+    }
+    {
+        OpusDecoder decoder(make_spec(44100, 2), arena);
+        LONGS_EQUAL(status::StatusBadConfig, decoder.init_status());
+    }
+}
+
+// Packets of same duration have same size, and decoder reports
+// same duration as was encoded, including non-native durations.
+TEST(opus_codec, encode_decode) {
+    const size_t durations[] = {
+        120,  // 2.5ms
+        240,  // 5ms
+        480,  // 10ms
+        720,  // 15ms, combined from shorter frames
+        960,  // 20ms
+        1440, // 30ms, combined from shorter frames
+        2880, // 60ms
+        5760, // 120ms
+    };
+
+    for (size_t n_chans = 1; n_chans <= MaxChans; n_chans++) {
+        for (size_t d = 0; d < ROC_ARRAY_SIZE(durations); d++) {
+            const size_t n_samples = durations[d];
+
+            OpusEncoder encoder(make_spec(SampleRate, n_chans), arena);
+            LONGS_EQUAL(status::StatusOK, encoder.init_status());
+
+            OpusDecoder decoder(make_spec(SampleRate, n_chans), arena);
+            LONGS_EQUAL(status::StatusOK, decoder.init_status());
+
+            sample_t samples[MaxSamples * MaxChans];
+            fill_samples(samples, n_samples, n_chans);
+
+            uint8_t bytes[MaxBytes];
+
+            for (size_t n = 0; n < 3; n++) {
+                const size_t n_bytes = encode_frame(encoder, bytes, samples, n_samples);
+
+                UNSIGNED_LONGS_EQUAL(n_samples,
+                                     decoder.decoded_sample_count(bytes, n_bytes));
+
+                decoder.begin_frame(
+                    packet::stream_timestamp_t(n * n_samples), bytes, n_bytes);
+                UNSIGNED_LONGS_EQUAL(n_samples, decoder.available());
+
+                sample_t decoded[MaxSamples * MaxChans];
+                UNSIGNED_LONGS_EQUAL(n_samples,
+                                     decoder.read_samples(decoded, n_samples));
+                UNSIGNED_LONGS_EQUAL(0, decoder.available());
+
+                decoder.end_frame();
+            }
+        }
+    }
+}
+
+// Incomplete frame is padded to multiple of 2.5ms.
+TEST(opus_codec, partial_frame) {
+    OpusEncoder encoder(make_spec(SampleRate, 2), arena);
+    LONGS_EQUAL(status::StatusOK, encoder.init_status());
+
+    OpusDecoder decoder(make_spec(SampleRate, 2), arena);
+    LONGS_EQUAL(status::StatusOK, decoder.init_status());
+
+    sample_t samples[MaxSamples * MaxChans];
+    fill_samples(samples, 100, 2);
+
+    uint8_t bytes[MaxBytes];
+    const size_t n_bytes = encode_frame(encoder, bytes, samples, 100);
+
+    UNSIGNED_LONGS_EQUAL(encoder.encoded_byte_count(120), n_bytes);
+    UNSIGNED_LONGS_EQUAL(120, decoder.decoded_sample_count(bytes, n_bytes));
+}
+
+// Concealment produces requested number of samples, both before and
+// after the next frame is started.
+TEST(opus_codec, conceal) {
+    enum { FrameLen = 960 };
+
+    OpusEncoder encoder(make_spec(SampleRate, 2), arena);
+    LONGS_EQUAL(status::StatusOK, encoder.init_status());
+
+    OpusDecoder decoder(make_spec(SampleRate, 2), arena);
+    LONGS_EQUAL(status::StatusOK, decoder.init_status());
+
+    sample_t samples[MaxSamples * MaxChans];
+    fill_samples(samples, FrameLen, 2);
+
+    uint8_t bytes[3][MaxBytes];
+    size_t n_bytes[3];
+
+    for (size_t n = 0; n < 3; n++) {
+        n_bytes[n] = encode_frame(encoder, bytes[n], samples, FrameLen);
+    }
+
+    sample_t decoded[MaxSamples * MaxChans];
+
+    // frame 0 received
+    decoder.begin_frame(0, bytes[0], n_bytes[0]);
+    UNSIGNED_LONGS_EQUAL(FrameLen, decoder.read_samples(decoded, FrameLen));
+    decoder.end_frame();
+
+    // frame 1 lost, frame 2 already started
+    decoder.begin_frame(FrameLen * 2, bytes[2], n_bytes[2]);
+
+    for (size_t n = 0; n < FrameLen * 2; n++) {
+        decoded[n] = 1.0f;
+    }
+    decoder.conceal(decoded, 100);
+    decoder.conceal(decoded + 100 * 2, FrameLen - 100);
+
+    for (size_t n = 0; n < FrameLen * 2; n++) {
+        CHECK(decoded[n] >= -1.0f && decoded[n] < 1.0f);
+    }
+
+    UNSIGNED_LONGS_EQUAL(FrameLen, decoder.read_samples(decoded, FrameLen));
+    decoder.end_frame();
+
+    // frame 3 lost, next frame not known
+    decoder.conceal(decoded, FrameLen);
+}
+
+// Lost packet is recovered from in-band FEC data of the next packet.
+TEST(opus_codec, fec_recovery) {
+    enum { FrameLen = 960, NumFrames = 10, LostFrame = 6 };
+
+    for (size_t n_chans = 1; n_chans <= MaxChans; n_chans++) {
+        OpusEncoder encoder(make_spec(SampleRate, n_chans), arena);
+        LONGS_EQUAL(status::StatusOK, encoder.init_status());
+
+        OpusDecoder decoder(make_spec(SampleRate, n_chans), arena);
+        LONGS_EQUAL(status::StatusOK, decoder.init_status());
+
+        uint8_t bytes[NumFrames][MaxBytes];
+        size_t n_bytes[NumFrames];
+
+        for (size_t n = 0; n < NumFrames; n++) {
+            sample_t samples[MaxSamples * MaxChans];
+            fill_voice(samples, FrameLen, n_chans, n);
+
+            n_bytes[n] = encode_frame(encoder, bytes[n], samples, FrameLen);
+
+            // TOC configs below 16 are SILK and hybrid modes (RFC 6716, 3.1),
+            // only they can carry in-band FEC
+            CHECK((bytes[n][0] >> 3) < 16);
+        }
+
+        // Reference decoders, one recovers loss using FEC, another
+        // uses regular concealment.
+        int err = 0;
+        ::OpusDecoder* fec_ref = opus_decoder_create(SampleRate, (int)n_chans, &err);
+        CHECK(fec_ref);
+        ::OpusDecoder* plc_ref = opus_decoder_create(SampleRate, (int)n_chans, &err);
+        CHECK(plc_ref);
+
+        sample_t decoded[MaxSamples * MaxChans];
+
+        for (size_t n = 0; n < LostFrame; n++) {
+            decoder.begin_frame(packet::stream_timestamp_t(n * FrameLen), bytes[n],
+                                n_bytes[n]);
+            UNSIGNED_LONGS_EQUAL(FrameLen, decoder.read_samples(decoded, FrameLen));
+            decoder.end_frame();
+
+            LONGS_EQUAL(FrameLen,
+                        opus_decode_float(fec_ref, bytes[n], (opus_int32)n_bytes[n],
+                                          decoded, FrameLen, 0));
+            LONGS_EQUAL(FrameLen,
+                        opus_decode_float(plc_ref, bytes[n], (opus_int32)n_bytes[n],
+                                          decoded, FrameLen, 0));
+        }
+
+        // frame LostFrame lost, next frame already started
+        decoder.begin_frame(packet::stream_timestamp_t((LostFrame + 1) * FrameLen),
+                            bytes[LostFrame + 1], n_bytes[LostFrame + 1]);
+
+        sample_t recovered[MaxSamples * MaxChans];
+        decoder.conceal(recovered, FrameLen);
+
+        sample_t expected_fec[MaxSamples * MaxChans];
+        LONGS_EQUAL(FrameLen,
+                    opus_decode_float(fec_ref, bytes[LostFrame + 1],
+                                      (opus_int32)n_bytes[LostFrame + 1], expected_fec,
+                                      FrameLen, 1));
+
+        sample_t expected_plc[MaxSamples * MaxChans];
+        LONGS_EQUAL(FrameLen,
+                    opus_decode_float(plc_ref, NULL, 0, expected_plc, FrameLen, 0));
+
+        bool differs_from_plc = false;
+        for (size_t n = 0; n < FrameLen * n_chans; n++) {
+            DOUBLES_EQUAL(expected_fec[n], recovered[n], 1e-6);
+            if (fabs(double(expected_plc[n] - recovered[n])) > 1e-3) {
+                differs_from_plc = true;
+            }
+        }
+        // if packet had no FEC data, libopus would fall back to concealment
+        CHECK(differs_from_plc);
+
+        UNSIGNED_LONGS_EQUAL(FrameLen, decoder.read_samples(decoded, FrameLen));
+        decoder.end_frame();
+
+        opus_decoder_destroy(fec_ref);
+        opus_decoder_destroy(plc_ref);
+    }
+}
+
+} // namespace audio
+} // namespace roc
+
+#endif // ROC_TARGET_LIBOPUS
@@ -12,6 +12,7 @@
 
 #include "roc_audio/pcm_mapper.h"
 #include "roc_audio/sample.h"
+#include "roc_core/fast_random.h"
 #include "roc_core/log.h"
 #include "roc_core/macro_helpers.h"
 #include "roc_core/print_memory.h"
@@ -880,5 +881,64 @@ TEST(pcm_mapper, int20be_to_raw) {
     compare(expected_output, actual_output, NumSamples);
 }
 
+// Fast path should produce exactly same output as generic mapping.
+TEST(pcm_mapper, fast_path) {
+    const PcmSubformat formats[] = {
+        PcmSubformat_SInt16,    PcmSubformat_SInt16_Be,  PcmSubformat_SInt16_Le,
+        PcmSubformat_SInt24,    PcmSubformat_SInt24_Be,  PcmSubformat_SInt24_Le,
+        PcmSubformat_SInt32,    PcmSubformat_SInt32_Be,  PcmSubformat_SInt32_Le,
+        PcmSubformat_Float32,   PcmSubformat_Float32_Be, PcmSubformat_Float32_Le,
+    };
+
+    enum { MaxSamples = 67, MaxBytes = MaxSamples * 4 };
+
+    // values which require clipping or are close to clipping
+    const sample_t edge_samples[] = {
+        -2.0f, -1.0f, -0.9999999f, -0.5f, 0.0f, 0.5f, 0.9999999f, 1.0f, 2.0f,
+    };
+
+    for (size_t f = 0; f < ROC_ARRAY_SIZE(formats); f++) {
+        for (size_t dir = 0; dir < 2; dir++) {
+            const PcmSubformat in_fmt = dir == 0 ? formats[f] : PcmSubformat_Raw;
+            const PcmSubformat out_fmt = dir == 0 ? PcmSubformat_Raw : formats[f];
+
+            const PcmMapFn map_fn = pcm_subformat_mapfn(in_fmt, out_fmt);
+            const PcmFastMapFn fast_map_fn = pcm_subformat_fast_mapfn(in_fmt, out_fmt);
+
+            CHECK(map_fn);
+            if (!fast_map_fn) {
+                // no fast path on this cpu
+                continue;
+            }
+
+            for (size_t n_samples = 0; n_samples <= MaxSamples; n_samples++) {
+                uint8_t input[MaxBytes];
+
+                if (dir == 0) {
+                    for (size_t n = 0; n < MaxBytes; n++) {
+                        input[n] = (uint8_t)core::fast_random_range(0, 255);
+                    }
+                } else {
+                    sample_t* samples = (sample_t*)input;
+                    for (size_t n = 0; n < MaxSamples; n++) {
+                        samples[n] = n % 3 == 0
+                            ? edge_samples[n / 3 % ROC_ARRAY_SIZE(edge_samples)]
+                            : core::fast_random_float() * 2.4f - 1.2f;
+                    }
+                }
+
+                uint8_t expected_output[MaxBytes] = {};
+                uint8_t actual_output[MaxBytes] = {};
+
+                size_t in_off = 0, out_off = 0;
+                map_fn(input, in_off, expected_output, out_off, n_samples);
+                fast_map_fn(input, actual_output, n_samples);
+
+                compare(expected_output, actual_output, MaxBytes);
+            }
+        }
+    }
+}
+
 } // namespace audio
 } // namespace roc
@@ -271,6 +271,8 @@ double timestamp_allowance(ResamplerBackend backend) {
         return 5;
     case ResamplerBackend_SpeexDec:
         return 2;
+    case ResamplerBackend_Polyphase:
+        return 0.1;
     default:
         break;
     }
@@ -16,7 +16,12 @@ namespace roc {
 namespace core {
 namespace {
 
-enum { BatchSize = 10000, NumIterations = 5000000, NumThreads = 16 };
+enum {
+    BatchSize = 10000,
+    PopBatchSize = 50,
+    NumIterations = 5000000,
+    NumThreads = 16
+};
 
 #if defined(ROC_BENCHMARK_USE_ACCESSORS)
 inline int get_thread_index(const benchmark::State& state) {
@@ -155,6 +160,40 @@ BENCHMARK_REGISTER_F(BM_MpscQueue, TryPopFront)
     ->Iterations(NumIterations)
     ->Unit(benchmark::kMicrosecond);
 
+// Drain queue filled in advance.
+// Arg is 0 to pop one object per call, and 1 to pop PopBatchSize objects per call.
+BENCHMARK_DEFINE_F(BM_MpscQueue, TryPopFrontDrain)(benchmark::State& state) {
+    const bool pop_many = state.range(0) != 0;
+
+    MpscQueue<Object, NoOwnership>& queue = get_queue();
+
+    Object* objs[PopBatchSize];
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        state.PauseTiming();
+        for (int n = 0; n < BatchSize; n++) {
+            queue.push_back(alloc_object(0));
+        }
+        state.ResumeTiming();
+
+        if (pop_many) {
+            for (int n = 0; n < BatchSize; n += PopBatchSize) {
+                queue.try_pop_front_many_exclusive(objs, PopBatchSize);
+            }
+        } else {
+            for (int n = 0; n < BatchSize; n++) {
+                queue.try_pop_front_exclusive();
+            }
+        }
+    }
+}
+
+BENCHMARK_REGISTER_F(BM_MpscQueue, TryPopFrontDrain)
+    ->Arg(0)
+    ->Arg(1)
+    ->Iterations(NumIterations)
+    ->Unit(benchmark::kNanosecond);
+
 BENCHMARK_DEFINE_F(BM_MpscQueue, PopFront)(benchmark::State& state) {
     const int64_t num_push_threads_arg = state.range(0);
 
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_core/slab_pool.h"
+
+namespace roc {
+namespace core {
+namespace {
+
+// Benchmarks:
+//
+//  BM_SlabPool/AllocFree/cache:<cache>/threads:<threads>
+//   Every thread allocates a batch of objects and then deallocates them.
+//   <cache> is 0 for plain pool and 1 for pool with per-thread cache.
+//
+//  BM_SlabPool/AllocFreeOne/cache:<cache>/threads:<threads>
+//   Every thread allocates and immediately deallocates one object.
+
+enum { BatchSize = 64, NumThreads = 16 };
+
+struct Object {
+    char bytes[256];
+};
+
+HeapArena arena;
+
+SlabPool<Object>& get_pool(bool use_cache) {
+    static SlabPool<Object> plain_pool("plain_pool", arena);
+    static SlabPool<Object> cached_pool("cached_pool", arena);
+    static bool cache_enabled = cached_pool.enable_cache();
+
+    roc_panic_if(!cache_enabled);
+
+    return use_cache ? cached_pool : plain_pool;
+}
+
+// Create pools before benchmark threads start.
+struct PoolInit {
+    PoolInit() {
+        (void)get_pool(false);
+        (void)get_pool(true);
+    }
+} pool_init;
+
+void BM_SlabPool_AllocFree(benchmark::State& state) {
+    SlabPool<Object>& pool = get_pool(state.range(0) != 0);
+
+    void* objects[BatchSize];
+
+    while (state.KeepRunningBatch(BatchSize)) {
+        for (size_t n = 0; n < BatchSize; n++) {
+            objects[n] = pool.allocate();
+            roc_panic_if(!objects[n]);
+        }
+        for (size_t n = 0; n < BatchSize; n++) {
+            pool.deallocate(objects[n]);
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+
+BENCHMARK(BM_SlabPool_AllocFree)
+    ->Name("BM_SlabPool/AllocFree")
+    ->ArgName("cache")
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, NumThreads)
+    ->UseRealTime()
+    ->Unit(benchmark::kNanosecond);
+
+void BM_SlabPool_AllocFreeOne(benchmark::State& state) {
+    SlabPool<Object>& pool = get_pool(state.range(0) != 0);
+
+    while (state.KeepRunning()) {
+        void* object = pool.allocate();
+        roc_panic_if(!object);
+        pool.deallocate(object);
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+
+BENCHMARK(BM_SlabPool_AllocFreeOne)
+    ->Name("BM_SlabPool/AllocFreeOne")
+    ->ArgName("cache")
+    ->Arg(0)
+    ->Arg(1)
+    ->ThreadRange(1, NumThreads)
+    ->UseRealTime()
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace core
+} // namespace roc
@@ -8,6 +8,7 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/cpu_features.h"
 #include "roc_core/cpu_traits.h"
 
 namespace roc {
@@ -38,5 +39,28 @@ TEST(cpu, bitness) {
 #endif
 }
 
+TEST(cpu, features) {
+    const unsigned features = cpu_features();
+
+    // Result is cached and stable.
+    UNSIGNED_LONGS_EQUAL(features, cpu_features());
+
+#if defined(ROC_CPU_X86_SIMD) && defined(__x86_64__)
+    // SSE2 is part of x86-64 baseline.
+    CHECK(cpu_supports(CpuFeature_SSE2));
+#endif
+
+#if defined(ROC_CPU_ARM_NEON)
+    CHECK(cpu_supports(CpuFeature_NEON));
+#else
+    CHECK(!cpu_supports(CpuFeature_NEON));
+#endif
+
+    if (cpu_supports(CpuFeature_AVX2)) {
+        CHECK(cpu_supports(CpuFeature_SSE41));
+        CHECK(cpu_supports(CpuFeature_SSSE3));
+    }
+}
+
 } // namespace core
 } // namespace roc
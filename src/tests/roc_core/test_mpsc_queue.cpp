@@ -11,6 +11,7 @@
 #include "roc_core/mpsc_queue.h"
 #include "roc_core/ref_counted.h"
 #include "roc_core/shared_ptr.h"
+#include "roc_core/thread.h"
 
 namespace roc {
 namespace core {
@@ -19,6 +20,34 @@ namespace {
 
 struct Object : RefCounted<Object, NoopAllocation>, MpscQueueNode<> {};
 
+struct SeqObject : MpscQueueNode<> {
+    size_t thread;
+    size_t seq;
+};
+
+class PushThread : public Thread {
+public:
+    enum { NumObjs = 10000 };
+
+    PushThread(MpscQueue<SeqObject, NoOwnership>& queue, size_t thread)
+        : queue_(queue) {
+        for (size_t n = 0; n < NumObjs; n++) {
+            objs_[n].thread = thread;
+            objs_[n].seq = n;
+        }
+    }
+
+private:
+    virtual void run() {
+        for (size_t n = 0; n < NumObjs; n++) {
+            queue_.push_back(objs_[n]);
+        }
+    }
+
+    MpscQueue<SeqObject, NoOwnership>& queue_;
+    SeqObject objs_[NumObjs];
+};
+
 } // namespace
 
 TEST_GROUP(mpsc_queue) {};
@@ -105,6 +134,161 @@ TEST(mpsc_queue, push_pop_many) {
     }
 }
 
+TEST(mpsc_queue, push_back_many) {
+    enum { NumObjs = 10 };
+
+    MpscQueue<Object, NoOwnership> queue;
+    Object objs[NumObjs];
+    Object* ptrs[NumObjs];
+
+    for (int n = 0; n < NumObjs; n++) {
+        ptrs[n] = &objs[n];
+    }
+
+    for (int i = 0; i < 5; i++) {
+        // one object, then two chains, then one object
+        queue.push_back(objs[0]);
+        queue.push_back_many(ptrs + 1, 4);
+        queue.push_back_many(ptrs + 5, 4);
+        queue.push_back_many(ptrs + 9, 1);
+
+        for (int n = 0; n < NumObjs; n++) {
+            POINTERS_EQUAL(&queue, objs[n].mpsc_queue_data()->queue);
+        }
+
+        for (int n = 0; n < NumObjs; n++) {
+            POINTERS_EQUAL(&objs[n], queue.try_pop_front_exclusive());
+            POINTERS_EQUAL(NULL, objs[n].mpsc_queue_data()->queue);
+        }
+
+        POINTERS_EQUAL(NULL, queue.try_pop_front_exclusive());
+    }
+}
+
+TEST(mpsc_queue, try_pop_front_many) {
+    enum { NumObjs = 100 };
+
+    MpscQueue<Object, NoOwnership> queue;
+    Object objs[NumObjs];
+    Object* ptrs[NumObjs];
+
+    UNSIGNED_LONGS_EQUAL(0, queue.try_pop_front_many_exclusive(ptrs, NumObjs));
+
+    for (int i = 0; i < 5; i++) {
+        for (int n = 0; n < NumObjs; n++) {
+            queue.push_back(objs[n]);
+        }
+
+        // partial pop
+        UNSIGNED_LONGS_EQUAL(3, queue.try_pop_front_many_exclusive(ptrs, 3));
+        for (int n = 0; n < 3; n++) {
+            POINTERS_EQUAL(&objs[n], ptrs[n]);
+            POINTERS_EQUAL(NULL, objs[n].mpsc_queue_data()->queue);
+        }
+
+        // pop the rest, more than internal batch
+        UNSIGNED_LONGS_EQUAL(NumObjs - 3,
+                             queue.try_pop_front_many_exclusive(ptrs, NumObjs));
+        for (int n = 0; n < NumObjs - 3; n++) {
+            POINTERS_EQUAL(&objs[n + 3], ptrs[n]);
+            POINTERS_EQUAL(NULL, objs[n + 3].mpsc_queue_data()->queue);
+        }
+
+        UNSIGNED_LONGS_EQUAL(0, queue.try_pop_front_many_exclusive(ptrs, NumObjs));
+        POINTERS_EQUAL(NULL, queue.try_pop_front_exclusive());
+    }
+}
+
+TEST(mpsc_queue, try_pop_front_many_interleaved) {
+    enum { NumObjs = 10 };
+
+    MpscQueue<Object, NoOwnership> queue;
+    Object objs[NumObjs];
+    Object* ptrs[NumObjs];
+
+    // single pop leaves stub at the end of queue
+    queue.push_back(objs[0]);
+    POINTERS_EQUAL(&objs[0], queue.try_pop_front_exclusive());
+
+    // nodes pushed after stub
+    queue.push_back(objs[1]);
+    queue.push_back(objs[2]);
+    queue.push_back(objs[3]);
+
+    // partial batch keeps the rest in queue
+    UNSIGNED_LONGS_EQUAL(2, queue.try_pop_front_many_exclusive(ptrs, 2));
+    POINTERS_EQUAL(&objs[1], ptrs[0]);
+    POINTERS_EQUAL(&objs[2], ptrs[1]);
+
+    // nodes pushed after detached ones
+    queue.push_back(objs[4]);
+    queue.push_back(objs[5]);
+
+    POINTERS_EQUAL(&objs[3], queue.try_pop_front_exclusive());
+
+    queue.push_back(objs[6]);
+
+    UNSIGNED_LONGS_EQUAL(1, queue.try_pop_front_many_exclusive(ptrs, 1));
+    POINTERS_EQUAL(&objs[4], ptrs[0]);
+
+    queue.push_back(objs[7]);
+
+    UNSIGNED_LONGS_EQUAL(3, queue.try_pop_front_many_exclusive(ptrs, NumObjs));
+    POINTERS_EQUAL(&objs[5], ptrs[0]);
+    POINTERS_EQUAL(&objs[6], ptrs[1]);
+    POINTERS_EQUAL(&objs[7], ptrs[2]);
+
+    UNSIGNED_LONGS_EQUAL(0, queue.try_pop_front_many_exclusive(ptrs, NumObjs));
+    POINTERS_EQUAL(NULL, queue.try_pop_front_exclusive());
+
+    for (int n = 0; n < 8; n++) {
+        POINTERS_EQUAL(NULL, objs[n].mpsc_queue_data()->queue);
+    }
+}
+
+TEST(mpsc_queue, try_pop_front_many_threads) {
+    enum { NumThreads = 4, BatchSize = 7 };
+
+    MpscQueue<SeqObject, NoOwnership> queue;
+
+    PushThread* threads[NumThreads];
+    size_t next_seq[NumThreads];
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n] = new PushThread(queue, n);
+        next_seq[n] = 0;
+    }
+    for (size_t n = 0; n < NumThreads; n++) {
+        CHECK(threads[n]->start());
+    }
+
+    size_t n_popped = 0;
+
+    while (n_popped < NumThreads * PushThread::NumObjs) {
+        SeqObject* ptrs[BatchSize];
+
+        const size_t n_ptrs = queue.try_pop_front_many_exclusive(ptrs, BatchSize);
+        CHECK(n_ptrs <= BatchSize);
+
+        for (size_t n = 0; n < n_ptrs; n++) {
+            CHECK(ptrs[n]->thread < NumThreads);
+            // objects from same producer are popped in order, exactly once
+            UNSIGNED_LONGS_EQUAL(next_seq[ptrs[n]->thread], ptrs[n]->seq);
+            POINTERS_EQUAL(NULL, ptrs[n]->mpsc_queue_data()->queue);
+            next_seq[ptrs[n]->thread]++;
+        }
+
+        n_popped += n_ptrs;
+    }
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        threads[n]->join();
+        delete threads[n];
+    }
+
+    POINTERS_EQUAL(NULL, queue.try_pop_front_exclusive());
+}
+
 TEST(mpsc_queue, ownership) {
     MpscQueue<Object, RefCountedOwnership> queue;
 
@@ -135,5 +319,39 @@ TEST(mpsc_queue, ownership) {
     UNSIGNED_LONGS_EQUAL(0, obj2.getref());
 }
 
+TEST(mpsc_queue, ownership_many) {
+    MpscQueue<Object, RefCountedOwnership> queue;
+
+    Object obj1;
+    Object obj2;
+
+    {
+        SharedPtr<Object> ptrs[2] = { &obj1, &obj2 };
+
+        queue.push_back_many(ptrs, 2);
+
+        UNSIGNED_LONGS_EQUAL(2, obj1.getref());
+        UNSIGNED_LONGS_EQUAL(2, obj2.getref());
+    }
+
+    UNSIGNED_LONGS_EQUAL(1, obj1.getref());
+    UNSIGNED_LONGS_EQUAL(1, obj2.getref());
+
+    {
+        SharedPtr<Object> ptrs[2];
+
+        UNSIGNED_LONGS_EQUAL(2, queue.try_pop_front_many_exclusive(ptrs, 2));
+
+        POINTERS_EQUAL(&obj1, ptrs[0].get());
+        POINTERS_EQUAL(&obj2, ptrs[1].get());
+
+        UNSIGNED_LONGS_EQUAL(1, obj1.getref());
+        UNSIGNED_LONGS_EQUAL(1, obj2.getref());
+    }
+
+    UNSIGNED_LONGS_EQUAL(0, obj1.getref());
+    UNSIGNED_LONGS_EQUAL(0, obj2.getref());
+}
+
 } // namespace core
 } // namespace roc
@@ -201,5 +201,44 @@ TEST(parse_units, parse_size_overflow) {
     CHECK_FALSE(parse_size(s, result));
 }
 
+TEST(parse_units, parse_cpu_list) {
+    uint64_t result = 0;
+
+    CHECK(parse_cpu_list("0", result));
+    CHECK(result == 0x1);
+
+    CHECK(parse_cpu_list("3", result));
+    CHECK(result == 0x8);
+
+    CHECK(parse_cpu_list("0,2", result));
+    CHECK(result == 0x5);
+
+    CHECK(parse_cpu_list("1-3", result));
+    CHECK(result == 0xe);
+
+    CHECK(parse_cpu_list("0,4-7,2", result));
+    CHECK(result == 0xf5);
+
+    CHECK(parse_cpu_list("63", result));
+    CHECK(result == ((uint64_t)1 << 63));
+}
+
+TEST(parse_units, parse_cpu_list_error) {
+    uint64_t result = 123;
+
+    CHECK(!parse_cpu_list(NULL, result));
+    CHECK(!parse_cpu_list("", result));
+    CHECK(!parse_cpu_list(",", result));
+    CHECK(!parse_cpu_list("1,", result));
+    CHECK(!parse_cpu_list("-1", result));
+    CHECK(!parse_cpu_list("1-", result));
+    CHECK(!parse_cpu_list("3-1", result));
+    CHECK(!parse_cpu_list("64", result));
+    CHECK(!parse_cpu_list("1 2", result));
+    CHECK(!parse_cpu_list("x", result));
+
+    CHECK(result == 123);
+}
+
 } // namespace core
 } // namespace roc
@@ -9,9 +9,12 @@
 #include <CppUTest/TestHarness.h>
 
 #include "roc_core/heap_arena.h"
+#include "roc_core/limited_arena.h"
+#include "roc_core/memory_limiter.h"
 #include "roc_core/memory_ops.h"
 #include "roc_core/noncopyable.h"
 #include "roc_core/slab_pool.h"
+#include "roc_core/thread.h"
 
 namespace roc {
 namespace core {
@@ -39,6 +42,78 @@ struct TestObject {
     char bytes[1000];
 };
 
+class TestCacheThread : public Thread {
+public:
+    enum { NumIterations = 2000, NumObjects = 50 };
+
+    explicit TestCacheThread(SlabPool<TestObject>& pool)
+        : pool_(pool)
+        , failed_(false) {
+    }
+
+    bool failed() const {
+        return failed_;
+    }
+
+private:
+    virtual void run() {
+        void* objects[NumObjects];
+
+        for (size_t i = 0; i < NumIterations; i++) {
+            for (size_t n = 0; n < NumObjects; n++) {
+                objects[n] = pool_.allocate();
+                if (!objects[n]) {
+                    failed_ = true;
+                    return;
+                }
+                memset(objects[n], (int)n, sizeof(TestObject));
+            }
+            for (size_t n = 0; n < NumObjects; n++) {
+                pool_.deallocate(objects[n]);
+            }
+        }
+    }
+
+    SlabPool<TestObject>& pool_;
+    bool failed_;
+};
+
+class TestAllocThread : public Thread {
+public:
+    enum { MaxObjects = 100 };
+
+    TestAllocThread(SlabPool<TestObject, MaxObjects>& pool, size_t n_objects)
+        : pool_(pool)
+        , n_objects_(n_objects)
+        , failed_(false) {
+    }
+
+    bool failed() const {
+        return failed_;
+    }
+
+private:
+    virtual void run() {
+        void* objects[MaxObjects];
+
+        for (size_t n = 0; n < n_objects_; n++) {
+            objects[n] = pool_.allocate();
+            if (!objects[n]) {
+                failed_ = true;
+                n_objects_ = n;
+                break;
+            }
+        }
+        for (size_t n = 0; n < n_objects_; n++) {
+            pool_.deallocate(objects[n]);
+        }
+    }
+
+    SlabPool<TestObject, MaxObjects>& pool_;
+    size_t n_objects_;
+    bool failed_;
+};
+
 } // namespace
 
 TEST_GROUP(slab_pool) {};
@@ -547,5 +622,199 @@ TEST(slab_pool, object_ownership_guard) {
     pool1.deallocate(pointers[1]);
 }
 
+TEST(slab_pool, cache_allocate_deallocate) {
+    enum { NumObjects = SlabPoolCache::MaxMagazineSize * 3 };
+
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+        CHECK(pool.enable_cache());
+
+        void* pointers[NumObjects] = {};
+
+        for (size_t round = 0; round < 3; round++) {
+            for (size_t n = 0; n < NumObjects; n++) {
+                pointers[n] = pool.allocate();
+                CHECK(pointers[n]);
+            }
+            for (size_t n = 0; n < NumObjects; n++) {
+                pool.deallocate(pointers[n]);
+            }
+        }
+
+        const SlabPoolCacheStats stats = pool.cache_stats();
+
+        LONGS_EQUAL(NumObjects * 3, stats.alloc_hits + stats.alloc_misses);
+        LONGS_EQUAL(NumObjects * 3, stats.dealloc_hits + stats.dealloc_misses);
+
+        // pool is accessed once per magazine, not once per object
+        CHECK(stats.alloc_misses <= NumObjects * 3 / SlabPoolCache::MaxMagazineSize);
+        CHECK(stats.dealloc_misses <= NumObjects * 3 / SlabPoolCache::MaxMagazineSize);
+        CHECK(stats.alloc_hits > stats.alloc_misses);
+        CHECK(stats.dealloc_hits > stats.dealloc_misses);
+
+        LONGS_EQUAL(0, pool.num_guard_failures());
+    }
+
+    // cached slots are returned to pool before checking for leaks
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, cache_guards) {
+    TestArena arena;
+    SlabPool<TestObject> pool("test", arena, sizeof(TestObject), 0, 0,
+                              (SlabPool_DefaultGuards & ~SlabPool_OverflowGuard));
+    CHECK(pool.enable_cache());
+
+    void* pointer = pool.allocate();
+    CHECK(pointer);
+
+    char* data = (char*)pointer;
+    CHECK(*(data - 1) == MemoryOps::Pattern_Canary);
+    CHECK(*(data + sizeof(TestObject)) == MemoryOps::Pattern_Canary);
+
+    *(data - 1) = 0x00;
+    pool.deallocate(pointer);
+
+    LONGS_EQUAL(1, pool.num_guard_failures());
+}
+
+TEST(slab_pool, cache_threads) {
+    enum { NumThreads = 4 };
+
+    TestArena arena;
+
+    {
+        SlabPool<TestObject> pool("test", arena);
+        CHECK(pool.enable_cache());
+
+        TestCacheThread* threads[NumThreads];
+
+        for (size_t n = 0; n < NumThreads; n++) {
+            threads[n] = new TestCacheThread(pool);
+        }
+        for (size_t n = 0; n < NumThreads; n++) {
+            CHECK(threads[n]->start());
+        }
+        for (size_t n = 0; n < NumThreads; n++) {
+            threads[n]->join();
+            CHECK(!threads[n]->failed());
+            delete threads[n];
+        }
+
+        const SlabPoolCacheStats stats = pool.cache_stats();
+
+        // every allocation and deallocation either went through cache
+        // or bypassed it because of contention
+        LONGS_EQUAL(NumThreads * TestCacheThread::NumIterations
+                        * TestCacheThread::NumObjects * 2,
+                    stats.alloc_hits + stats.alloc_misses + stats.dealloc_hits
+                        + stats.dealloc_misses + stats.contended);
+
+        LONGS_EQUAL(0, pool.num_guard_failures());
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, cache_limit) {
+    enum { NumObjects = 200, MagazineSize = 4 };
+
+    TestArena arena;
+
+    { // cache size is limited by magazine size
+        SlabPool<TestObject> pool("test", arena);
+        CHECK(pool.enable_cache(pool.allocation_size() * SlabPoolCache::NumShards * 2
+                                * MagazineSize));
+
+        void* pointers[NumObjects] = {};
+
+        for (size_t n = 0; n < NumObjects; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+        for (size_t n = 0; n < NumObjects; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        const SlabPoolCacheStats stats = pool.cache_stats();
+
+        CHECK(stats.cached_slots > 0);
+        CHECK(stats.cached_slots <= MagazineSize * 2);
+        CHECK(stats.dealloc_misses >= (NumObjects - MagazineSize * 2) / MagazineSize);
+    }
+
+    { // limit is too small, cache is not used
+        SlabPool<TestObject> pool("test", arena);
+        CHECK(pool.enable_cache(pool.allocation_size()));
+
+        void* pointer = pool.allocate();
+        CHECK(pointer);
+        pool.deallocate(pointer);
+
+        const SlabPoolCacheStats stats = pool.cache_stats();
+
+        LONGS_EQUAL(0, stats.alloc_hits + stats.alloc_misses);
+        LONGS_EQUAL(0, stats.dealloc_hits + stats.dealloc_misses);
+        LONGS_EQUAL(0, stats.cached_slots);
+    }
+
+    LONGS_EQUAL(0, arena.num_allocations());
+}
+
+TEST(slab_pool, cache_reclaim) {
+    enum { NumObjects = 40 };
+
+    HeapArena heap_arena;
+
+    {
+        // arena has room only for the cache itself,
+        // so pool can use only embedded slots
+        MemoryLimiter memory_limiter(
+            "test", heap_arena.compute_allocated_size(sizeof(SlabPoolCache)));
+        LimitedArena arena(heap_arena, memory_limiter);
+
+        SlabPool<TestObject, TestAllocThread::MaxObjects> pool("test", arena);
+        CHECK(pool.enable_cache());
+
+        void* pointers[TestAllocThread::MaxObjects] = {};
+
+        // all embedded slots are in use
+        for (size_t n = 0; n < TestAllocThread::MaxObjects; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+        CHECK(!pool.allocate());
+
+        // some slots go to cache shard of this thread
+        for (size_t n = 0; n < NumObjects; n++) {
+            pool.deallocate(pointers[n]);
+        }
+        CHECK(pool.cache_stats().cached_slots > 0);
+
+        // another thread (likely mapped to another shard) can still use them
+        TestAllocThread thread(pool, NumObjects);
+        CHECK(thread.start());
+        thread.join();
+        CHECK(!thread.failed());
+
+        // and this thread too
+        for (size_t n = 0; n < NumObjects; n++) {
+            pointers[n] = pool.allocate();
+            CHECK(pointers[n]);
+        }
+        CHECK(!pool.allocate());
+
+        for (size_t n = 0; n < TestAllocThread::MaxObjects; n++) {
+            pool.deallocate(pointers[n]);
+        }
+
+        LONGS_EQUAL(0, pool.num_guard_failures());
+    }
+
+    LONGS_EQUAL(0, heap_arena.num_allocations());
+}
+
 } // namespace core
 } // namespace roc
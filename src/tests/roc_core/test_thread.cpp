@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/thread.h"
+
+#include <unistd.h>
+
+namespace roc {
+namespace core {
+
+namespace {
+
+class TestThread : public Thread {
+public:
+    TestThread()
+        : tid_(0) {
+    }
+
+    explicit TestThread(const ThreadConfig& config)
+        : Thread(config)
+        , tid_(0) {
+    }
+
+    uint64_t tid() const {
+        return tid_;
+    }
+
+private:
+    virtual void run() {
+        tid_ = get_tid();
+    }
+
+    Atomic<uint64_t> tid_;
+};
+
+} // namespace
+
+TEST_GROUP(thread) {};
+
+TEST(thread, start_join) {
+    TestThread thread;
+
+    CHECK(!thread.is_joinable());
+    CHECK(thread.start());
+    CHECK(thread.is_joinable());
+
+    thread.join();
+
+    CHECK(!thread.is_joinable());
+    CHECK(thread.tid() != 0);
+    CHECK(thread.tid() != Thread::get_tid());
+}
+
+TEST(thread, default_config) {
+    const size_t num_failures = Thread::num_config_failures();
+
+    ThreadConfig config;
+    CHECK(config.is_default());
+
+    CHECK(Thread::apply_config(config));
+
+    TestThread thread(config);
+    CHECK(thread.start());
+    thread.join();
+
+    CHECK(thread.tid() != 0);
+    LONGS_EQUAL(num_failures, Thread::num_config_failures());
+}
+
+TEST(thread, lock_memory) {
+    const size_t num_failures = Thread::num_config_failures();
+
+    // locking may be not permitted, but failure should be counted
+    if (!Thread::lock_memory()) {
+        LONGS_EQUAL(num_failures + 1, Thread::num_config_failures());
+        return;
+    }
+
+    // nested locking is reference-counted
+    CHECK(Thread::lock_memory());
+    Thread::unlock_memory();
+    Thread::unlock_memory();
+
+    LONGS_EQUAL(num_failures, Thread::num_config_failures());
+}
+
+#if defined(__linux__)
+
+TEST(thread, bad_cpu_mask) {
+    if (sysconf(_SC_NPROCESSORS_CONF) >= 64) {
+        return;
+    }
+
+    const size_t num_failures = Thread::num_config_failures();
+
+    ThreadConfig config;
+    config.cpu_mask = (uint64_t)1 << 63;
+
+    // thread should run with default parameters if config can't be applied
+    TestThread thread(config);
+    CHECK(thread.start());
+    thread.join();
+
+    CHECK(thread.tid() != 0);
+    LONGS_EQUAL(num_failures + 1, Thread::num_config_failures());
+}
+
+#endif // defined(__linux__)
+
+} // namespace core
+} // namespace roc
@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/time.h"
+#include "roc_dbgio/packet_capture_reader.h"
+#include "roc_dbgio/packet_capture_writer.h"
+#include "roc_dbgio/temp_file.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace dbgio {
+
+namespace {
+
+enum { MaxBufSize = 200, NumPackets = 50 };
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, MaxBufSize);
+
+packet::PacketPtr new_packet(size_t size, uint8_t seed, core::nanoseconds_t rts) {
+    core::BufferPtr buffer = packet_factory.new_packet_buffer();
+    CHECK(buffer);
+
+    for (size_t n = 0; n < size; n++) {
+        buffer->data()[n] = uint8_t(seed + n);
+    }
+
+    packet::PacketPtr pp = packet_factory.new_packet();
+    CHECK(pp);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+    CHECK(pp->udp()->src_addr.set_host_port_auto("127.0.0.1", 1000 + seed));
+    pp->udp()->receive_timestamp = rts;
+    pp->set_buffer(core::Slice<uint8_t>(*buffer, 0, size));
+
+    return pp;
+}
+
+void check_packet(const packet::PacketPtr& pp,
+                  size_t size,
+                  uint8_t seed,
+                  core::nanoseconds_t rts) {
+    CHECK(pp);
+    CHECK(pp->has_flags(packet::Packet::FlagUDP));
+
+    LONGS_EQUAL(rts, pp->udp()->receive_timestamp);
+    LONGS_EQUAL(1000 + seed, pp->udp()->src_addr.port());
+
+    char host[64] = {};
+    CHECK(pp->udp()->src_addr.get_host(host, sizeof(host)));
+    STRCMP_EQUAL("127.0.0.1", host);
+
+    LONGS_EQUAL(size, pp->buffer().size());
+    for (size_t n = 0; n < size; n++) {
+        LONGS_EQUAL(uint8_t(seed + n), pp->buffer().data()[n]);
+    }
+}
+
+address::Protocol packet_proto(size_t n) {
+    return n % 2 == 0 ? address::Proto_RTP_RS8M_Source : address::Proto_RS8M_Repair;
+}
+
+} // namespace
+
+TEST_GROUP(packet_capture) {};
+
+TEST(packet_capture, write_read) {
+    TempFile file("capture.bin");
+
+    {
+        PacketCaptureConfig config;
+        config.capture_file = file.path();
+        config.max_queued = NumPackets;
+
+        PacketCaptureWriter writer(config, arena);
+        LONGS_EQUAL(status::StatusOK, writer.open());
+
+        for (size_t n = 0; n < NumPackets; n++) {
+            writer.write(new_packet(n * 3, (uint8_t)n,
+                                    core::nanoseconds_t(n + 1) * core::Millisecond),
+                         packet_proto(n));
+        }
+
+        writer.close();
+    }
+
+    {
+        PacketCaptureReader reader(packet_factory);
+        LONGS_EQUAL(status::StatusOK, reader.open(file.path()));
+
+        for (size_t n = 0; n < NumPackets; n++) {
+            packet::PacketPtr pp;
+            address::Protocol proto = address::Proto_None;
+
+            LONGS_EQUAL(status::StatusOK, reader.read(pp, proto));
+
+            LONGS_EQUAL(packet_proto(n), proto);
+            check_packet(pp, n * 3, (uint8_t)n,
+                         core::nanoseconds_t(n + 1) * core::Millisecond);
+        }
+
+        packet::PacketPtr pp;
+        address::Protocol proto = address::Proto_None;
+
+        LONGS_EQUAL(status::StatusFinish, reader.read(pp, proto));
+        LONGS_EQUAL(0, reader.num_skipped());
+    }
+}
+
+TEST(packet_capture, truncated) {
+    TempFile file("capture.bin");
+
+    {
+        PacketCaptureConfig config;
+        config.capture_file = file.path();
+
+        PacketCaptureWriter writer(config, arena);
+        LONGS_EQUAL(status::StatusOK, writer.open());
+
+        writer.write(new_packet(100, 1, core::Second), address::Proto_RTP);
+        writer.write(new_packet(100, 2, core::Second * 2), address::Proto_RTP);
+
+        writer.close();
+    }
+
+    { // cut last record in the middle
+        uint8_t data[1000];
+
+        FILE* fp = fopen(file.path(), "rb");
+        CHECK(fp);
+        const size_t size = fread(data, 1, sizeof(data), fp);
+        fclose(fp);
+
+        fp = fopen(file.path(), "wb");
+        CHECK(fp);
+        CHECK(fwrite(data, size - 50, 1, fp) == 1);
+        fclose(fp);
+    }
+
+    PacketCaptureReader reader(packet_factory);
+    LONGS_EQUAL(status::StatusOK, reader.open(file.path()));
+
+    packet::PacketPtr pp;
+    address::Protocol proto = address::Proto_None;
+
+    LONGS_EQUAL(status::StatusOK, reader.read(pp, proto));
+    check_packet(pp, 100, 1, core::Second);
+
+    LONGS_EQUAL(status::StatusFinish, reader.read(pp, proto));
+}
+
+TEST(packet_capture, skip_large) {
+    TempFile file("capture.bin");
+
+    {
+        PacketCaptureConfig config;
+        config.capture_file = file.path();
+
+        PacketCaptureWriter writer(config, arena);
+        LONGS_EQUAL(status::StatusOK, writer.open());
+
+        writer.write(new_packet(150, 1, core::Second), address::Proto_RTP);
+        writer.write(new_packet(50, 2, core::Second * 2), address::Proto_RTP);
+
+        writer.close();
+    }
+
+    // reader with smaller buffers than writer
+    packet::PacketFactory small_factory(arena, 100);
+
+    PacketCaptureReader reader(small_factory);
+    LONGS_EQUAL(status::StatusOK, reader.open(file.path()));
+
+    packet::PacketPtr pp;
+    address::Protocol proto = address::Proto_None;
+
+    LONGS_EQUAL(status::StatusOK, reader.read(pp, proto));
+    check_packet(pp, 50, 2, core::Second * 2);
+    LONGS_EQUAL(1, reader.num_skipped());
+
+    LONGS_EQUAL(status::StatusFinish, reader.read(pp, proto));
+}
+
+TEST(packet_capture, bad_magic) {
+    TempFile file("capture.bin");
+
+    FILE* fp = fopen(file.path(), "wb");
+    CHECK(fp);
+    const char garbage[] = "not a capture file";
+    CHECK(fwrite(garbage, sizeof(garbage), 1, fp) == 1);
+    fclose(fp);
+
+    PacketCaptureReader reader(packet_factory);
+    LONGS_EQUAL(status::StatusErrFile, reader.open(file.path()));
+}
+
+} // namespace dbgio
+} // namespace roc
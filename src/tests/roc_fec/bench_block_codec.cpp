@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_fec/codec_map.h"
+#include "roc_fec/gf256.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace fec {
+namespace {
+
+// Benchmarks:
+//
+//  BM_BlockEncode/<backend>/<sblen>
+//   Throughput of IBlockEncoder, producing sblen/2 Reed-Solomon repair
+//   packets for a block of sblen source packets.
+//
+//  BM_BlockRepair/<backend>/<sblen>
+//   Throughput of IBlockDecoder, repairing the worst case: sblen/2 source
+//   packets are lost, and all sblen/2 repair packets are used.
+//
+//  BM_Gf256Kernel/<kernel>/<size>
+//   Throughput of GF(2^8) multiply-add kernel used by built-in backend.
+//
+// Output column "bytes_per_second" reports source bytes per second for codec
+// benchmarks, and input bytes per second for kernel benchmark.
+
+enum { PayloadSize = 1024, MaxBlockLength = 255 };
+
+core::HeapArena arena;
+packet::PacketFactory packet_factory(arena, PayloadSize);
+
+struct Block {
+    size_t sblen;
+    size_t rblen;
+    core::Slice<uint8_t> buffers[MaxBlockLength];
+
+    explicit Block(size_t n_source)
+        : sblen(n_source)
+        , rblen(n_source / 2) {
+        roc_panic_if(sblen + rblen > MaxBlockLength);
+
+        for (size_t i = 0; i < sblen + rblen; i++) {
+            buffers[i] = packet_factory.new_packet_buffer();
+            roc_panic_if(!buffers[i]);
+            buffers[i].reslice(0, PayloadSize);
+
+            for (size_t j = 0; j < PayloadSize; j++) {
+                buffers[i].data()[j] = (uint8_t)core::fast_random_range(0, 0xff);
+            }
+        }
+    }
+};
+
+bool make_config(benchmark::State& state, CodecConfig& config) {
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    config.backend = (CodecBackend)state.range(0);
+
+    state.SetLabel(codec_backend_to_str(config.backend));
+
+    if (!CodecMap::instance().has_backend(config.scheme, config.backend)) {
+        state.SkipWithError("backend not available");
+        return false;
+    }
+
+    return true;
+}
+
+void encode(IBlockEncoder& encoder, Block& block) {
+    if (encoder.begin_block(block.sblen, block.rblen, PayloadSize)
+        != status::StatusOK) {
+        roc_panic("bench: begin_block() failed");
+    }
+
+    for (size_t i = 0; i < block.sblen + block.rblen; i++) {
+        encoder.set_buffer(i, block.buffers[i]);
+    }
+
+    encoder.fill_buffers();
+    encoder.end_block();
+}
+
+void BM_BlockEncode(benchmark::State& state) {
+    CodecConfig config;
+    if (!make_config(state, config)) {
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_block_encoder(config, packet_factory, arena));
+    roc_panic_if(!encoder || encoder->init_status() != status::StatusOK);
+
+    Block block((size_t)state.range(1));
+
+    while (state.KeepRunning()) {
+        encode(*encoder, block);
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(block.sblen)
+                            * PayloadSize);
+}
+
+BENCHMARK(BM_BlockEncode)
+    ->ArgsProduct({ { CodecBackend_Builtin, CodecBackend_OpenFEC },
+                    { 10, 20, 50, 100, 150 } })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_BlockRepair(benchmark::State& state) {
+    CodecConfig config;
+    if (!make_config(state, config)) {
+        return;
+    }
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_block_encoder(config, packet_factory, arena));
+    roc_panic_if(!encoder || encoder->init_status() != status::StatusOK);
+
+    core::ScopedPtr<IBlockDecoder> decoder(
+        CodecMap::instance().new_block_decoder(config, packet_factory, arena));
+    roc_panic_if(!decoder || decoder->init_status() != status::StatusOK);
+
+    Block block((size_t)state.range(1));
+
+    encode(*encoder, block);
+
+    while (state.KeepRunning()) {
+        if (decoder->begin_block(block.sblen, block.rblen, PayloadSize)
+            != status::StatusOK) {
+            roc_panic("bench: begin_block() failed");
+        }
+
+        // first rblen source packets are lost
+        for (size_t i = block.rblen; i < block.sblen + block.rblen; i++) {
+            decoder->set_buffer(i, block.buffers[i]);
+        }
+
+        for (size_t i = 0; i < block.rblen; i++) {
+            if (!decoder->repair_buffer(i)) {
+                roc_panic("bench: repair_buffer() failed");
+            }
+        }
+
+        decoder->end_block();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(block.sblen)
+                            * PayloadSize);
+}
+
+BENCHMARK(BM_BlockRepair)
+    ->ArgsProduct({ { CodecBackend_Builtin, CodecBackend_OpenFEC },
+                    { 10, 20, 50, 100, 150 } })
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_Gf256Kernel(benchmark::State& state) {
+    const Gf256Kernel kernel = (Gf256Kernel)state.range(0);
+    const size_t size = (size_t)state.range(1);
+
+    state.SetLabel(gf256_kernel_to_str(kernel));
+
+    if (!gf256_kernel_supported(kernel)) {
+        state.SkipWithError("kernel not supported");
+        return;
+    }
+
+    const Gf256KernelFunc kernel_func = gf256_kernel_func(kernel);
+
+    static uint8_t src[PayloadSize * 4];
+    static uint8_t dst[PayloadSize * 4];
+
+    for (size_t n = 0; n < size; n++) {
+        src[n] = (uint8_t)core::fast_random_range(0, 0xff);
+        dst[n] = (uint8_t)core::fast_random_range(0, 0xff);
+    }
+
+    uint8_t coef = 1;
+
+    while (state.KeepRunning()) {
+        kernel_func(dst, src, size, coef);
+        benchmark::DoNotOptimize(dst);
+
+        coef = uint8_t(coef * 7 + 3) | 1;
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(size));
+}
+
+BENCHMARK(BM_Gf256Kernel)
+    ->ArgsProduct({ { Gf256Kernel_Scalar, Gf256Kernel_SSSE3, Gf256Kernel_AVX2,
+                      Gf256Kernel_NEON },
+                    { 160, 1024, 4096 } })
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace fec
+} // namespace roc
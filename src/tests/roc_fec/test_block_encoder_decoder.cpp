@@ -13,6 +13,7 @@
 #include "roc_core/fast_random.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
+#include "roc_core/macro_helpers.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/secure_random.h"
 #include "roc_fec/codec_map.h"
@@ -280,5 +281,141 @@ TEST(block_encoder_decoder, max_source_block) {
     }
 }
 
+// Reed-Solomon repairs any combination of lost source packets
+// while number of losses does not exceed number of repair packets.
+TEST(block_encoder_decoder, rs8m_max_losses) {
+    enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 251 };
+
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+
+    if (!CodecMap::instance().has_scheme(config.scheme)) {
+        return;
+    }
+
+    Codec code(config);
+
+    for (size_t first_lost = 0; first_lost + NumRepairPackets <= NumSourcePackets;
+         first_lost++) {
+        code.encode(NumSourcePackets, NumRepairPackets, PayloadSize);
+
+        LONGS_EQUAL(
+            status::StatusOK,
+            code.decoder().begin_block(NumSourcePackets, NumRepairPackets, PayloadSize));
+
+        for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; ++i) {
+            if (i >= first_lost && i < first_lost + NumRepairPackets) {
+                continue;
+            }
+            code.decoder().set_buffer(i, code.get_buffer(i));
+        }
+        CHECK(code.decode(NumSourcePackets, PayloadSize));
+
+        code.decoder().end_block();
+    }
+}
+
+// Check repair symbols produced by built-in Reed-Solomon encoder against
+// pre-computed values, to ensure that it stays wire-compatible.
+TEST(block_encoder_decoder, rs8m_builtin_repair_symbols) {
+    enum { NumSourcePackets = 4, NumRepairPackets = 2, PayloadSize = 8 };
+
+    const uint8_t expected[NumRepairPackets][PayloadSize] = {
+        { 0xab, 0xeb, 0x7a, 0xcd, 0x57, 0xa1, 0x2c, 0xae },
+        { 0xfe, 0xf6, 0x29, 0xd6, 0x45, 0xd7, 0xb5, 0x8f },
+    };
+
+    core::HeapArena arena;
+    packet::PacketFactory packet_factory(arena, MaxPayloadSize);
+
+    CodecConfig config;
+    config.scheme = packet::FEC_ReedSolomon_M8;
+    config.backend = CodecBackend_Builtin;
+
+    core::ScopedPtr<IBlockEncoder> encoder(
+        CodecMap::instance().new_block_encoder(config, packet_factory, arena));
+    CHECK(encoder);
+    LONGS_EQUAL(status::StatusOK, encoder->init_status());
+
+    LONGS_EQUAL(status::StatusOK,
+                encoder->begin_block(NumSourcePackets, NumRepairPackets, PayloadSize));
+
+    core::Slice<uint8_t> buffers[NumSourcePackets + NumRepairPackets];
+
+    for (size_t i = 0; i < NumSourcePackets + NumRepairPackets; i++) {
+        buffers[i] = packet_factory.new_packet_buffer();
+        CHECK(buffers[i]);
+        buffers[i].reslice(0, PayloadSize);
+
+        for (size_t j = 0; j < PayloadSize; j++) {
+            buffers[i].data()[j] =
+                i < NumSourcePackets ? uint8_t(i * 37 + j * 11 + 1) : 0;
+        }
+
+        encoder->set_buffer(i, buffers[i]);
+    }
+
+    encoder->fill_buffers();
+    encoder->end_block();
+
+    for (size_t r = 0; r < NumRepairPackets; r++) {
+        for (size_t j = 0; j < PayloadSize; j++) {
+            LONGS_EQUAL(expected[r][j], buffers[NumSourcePackets + r].data()[j]);
+        }
+    }
+}
+
+// If both built-in and OpenFEC Reed-Solomon backends are available,
+// check that each of them can repair packets encoded by another.
+TEST(block_encoder_decoder, rs8m_backends_compatible) {
+    enum { NumSourcePackets = 20, NumRepairPackets = 10, PayloadSize = 251 };
+
+    if (!CodecMap::instance().has_backend(packet::FEC_ReedSolomon_M8,
+                                          CodecBackend_Builtin)
+        || !CodecMap::instance().has_backend(packet::FEC_ReedSolomon_M8,
+                                             CodecBackend_OpenFEC)) {
+        return;
+    }
+
+    const CodecBackend backends[] = { CodecBackend_Builtin, CodecBackend_OpenFEC };
+
+    for (size_t enc_n = 0; enc_n < ROC_ARRAY_SIZE(backends); enc_n++) {
+        for (size_t dec_n = 0; dec_n < ROC_ARRAY_SIZE(backends); dec_n++) {
+            CodecConfig enc_config;
+            enc_config.scheme = packet::FEC_ReedSolomon_M8;
+            enc_config.backend = backends[enc_n];
+
+            CodecConfig dec_config;
+            dec_config.scheme = packet::FEC_ReedSolomon_M8;
+            dec_config.backend = backends[dec_n];
+
+            Codec enc_code(enc_config);
+            Codec dec_code(dec_config);
+
+            enc_code.encode(NumSourcePackets, NumRepairPackets, PayloadSize);
+
+            LONGS_EQUAL(status::StatusOK,
+                        dec_code.decoder().begin_block(NumSourcePackets,
+                                                       NumRepairPackets, PayloadSize));
+
+            // lose first source packets
+            for (size_t i = NumRepairPackets; i < NumSourcePackets + NumRepairPackets;
+                 ++i) {
+                dec_code.decoder().set_buffer(i, enc_code.get_buffer(i));
+            }
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                core::Slice<uint8_t> decoded = dec_code.decoder().repair_buffer(i);
+                CHECK(decoded);
+                CHECK(memcmp(enc_code.get_buffer(i).data(), decoded.data(),
+                             PayloadSize)
+                      == 0);
+            }
+
+            dec_code.decoder().end_block();
+        }
+    }
+}
+
 } // namespace fec
 } // namespace roc
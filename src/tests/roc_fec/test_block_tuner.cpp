@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "test_harness.h"
+
+#include "roc_fec/block_tuner.h"
+
+namespace roc {
+namespace fec {
+
+namespace {
+
+enum { MaxBlockLength = 255, PacketsPerReport = 1000 };
+
+// Simulates receiver reports with cumulative counters.
+struct Reporter {
+    uint64_t expected;
+    int64_t lost;
+    core::nanoseconds_t time;
+
+    Reporter()
+        : expected(0)
+        , lost(0)
+        , time(core::Second) {
+    }
+
+    bool report(BlockTuner& tuner, double loss) {
+        expected += PacketsPerReport;
+        lost += int64_t(loss * PacketsPerReport);
+        time += core::Second;
+        return tuner.update(expected, lost, time);
+    }
+};
+
+BlockWriterConfig make_writer_config(size_t sblen, size_t rblen) {
+    BlockWriterConfig config;
+    config.n_source_packets = sblen;
+    config.n_repair_packets = rblen;
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(block_tuner) {};
+
+TEST(block_tuner, initial_sizes) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 10);
+
+    BlockTunerConfig config;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    LONGS_EQUAL(20, tuner.n_source_packets());
+    LONGS_EQUAL(10, tuner.n_repair_packets());
+    DOUBLES_EQUAL(0.5, tuner.repair_ratio(), 1e-6);
+}
+
+TEST(block_tuner, decrease_on_no_loss) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 10);
+
+    BlockTunerConfig config;
+    config.min_repair_ratio = 0.1f;
+    config.loss_window = 8;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    Reporter reporter;
+
+    // first report only sets baseline
+    CHECK(!reporter.report(tuner, 0));
+
+    // redundancy is not decreased until loss window is filled
+    for (size_t n = 0; n < config.loss_window - 1; n++) {
+        CHECK(!reporter.report(tuner, 0));
+        LONGS_EQUAL(10, tuner.n_repair_packets());
+    }
+
+    CHECK(reporter.report(tuner, 0));
+
+    LONGS_EQUAL(20, tuner.n_source_packets());
+    LONGS_EQUAL(2, tuner.n_repair_packets());
+    DOUBLES_EQUAL(0.1, tuner.repair_ratio(), 1e-6);
+}
+
+TEST(block_tuner, increase_immediately) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 2);
+
+    BlockTunerConfig config;
+    config.min_repair_ratio = 0.1f;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    Reporter reporter;
+
+    CHECK(!reporter.report(tuner, 0));
+    CHECK(!reporter.report(tuner, 0));
+
+    LONGS_EQUAL(2, tuner.n_repair_packets());
+
+    // 30% loss: r/(s+r) should be at least 0.3, i.e. r/s at least 3/7
+    CHECK(reporter.report(tuner, 0.3));
+
+    LONGS_EQUAL(20, tuner.n_source_packets());
+    LONGS_EQUAL(9, tuner.n_repair_packets());
+
+    DOUBLES_EQUAL(0.15, tuner.mean_loss(), 1e-6);
+    DOUBLES_EQUAL(0.3, tuner.peak_loss(), 1e-6);
+
+    CHECK(double(tuner.n_repair_packets())
+              / double(tuner.n_source_packets() + tuner.n_repair_packets())
+          >= 0.3);
+}
+
+TEST(block_tuner, loss_margin) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 2);
+
+    BlockTunerConfig config;
+    config.min_repair_ratio = 0;
+    config.loss_margin = 2;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    Reporter reporter;
+
+    CHECK(!reporter.report(tuner, 0));
+
+    // constant 10% loss, margin 2x: target 20%, r/s = 0.25
+    CHECK(reporter.report(tuner, 0.1));
+
+    LONGS_EQUAL(20, tuner.n_source_packets());
+    LONGS_EQUAL(5, tuner.n_repair_packets());
+
+    for (size_t n = 0; n < 20; n++) {
+        CHECK(!reporter.report(tuner, 0.1));
+    }
+
+    LONGS_EQUAL(5, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, decrease_cooldown) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 2);
+
+    BlockTunerConfig config;
+    config.min_repair_ratio = 0.1f;
+    config.loss_window = 4;
+    config.decrease_cooldown = 10 * core::Second;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    Reporter reporter;
+
+    CHECK(!reporter.report(tuner, 0));
+    CHECK(reporter.report(tuner, 0.3));
+
+    const size_t increased_rblen = tuner.n_repair_packets();
+    CHECK(increased_rblen > 2);
+
+    const core::nanoseconds_t increase_time = reporter.time;
+
+    // loss disappears from window after 4 reports, but redundancy is kept
+    // until cooldown expires
+    while (reporter.time + core::Second < increase_time + config.decrease_cooldown) {
+        CHECK(!reporter.report(tuner, 0));
+        LONGS_EQUAL(increased_rblen, tuner.n_repair_packets());
+    }
+
+    CHECK(reporter.report(tuner, 0));
+    LONGS_EQUAL(2, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, max_repair_ratio) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 10);
+
+    BlockTunerConfig config;
+    config.min_repair_ratio = 0.1f;
+    config.max_repair_ratio = 0.75f;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    Reporter reporter;
+
+    CHECK(!reporter.report(tuner, 0));
+    CHECK(reporter.report(tuner, 0.8));
+
+    LONGS_EQUAL(20, tuner.n_source_packets());
+    LONGS_EQUAL(15, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, max_block_length) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 5);
+
+    BlockTunerConfig config;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, 30);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    Reporter reporter;
+
+    CHECK(!reporter.report(tuner, 0));
+    CHECK(reporter.report(tuner, 0.5));
+
+    LONGS_EQUAL(20, tuner.n_source_packets());
+    LONGS_EQUAL(10, tuner.n_repair_packets());
+}
+
+TEST(block_tuner, block_length_from_burstiness) {
+    const BlockWriterConfig writer_config = make_writer_config(10, 2);
+
+    BlockTunerConfig config;
+    config.min_source_packets = 10;
+    config.max_source_packets = 40;
+    config.min_repair_ratio = 0;
+    config.loss_margin = 1;
+    config.loss_window = 4;
+    config.decrease_cooldown = 0;
+    config.deduce_defaults(writer_config);
+
+    { // uniform loss: shortest blocks
+        BlockTuner tuner(config, writer_config, MaxBlockLength);
+        LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+        Reporter reporter;
+
+        CHECK(!reporter.report(tuner, 0));
+        for (size_t n = 0; n < config.loss_window; n++) {
+            (void)reporter.report(tuner, 0.1);
+        }
+
+        LONGS_EQUAL(10, tuner.n_source_packets());
+        DOUBLES_EQUAL(0.1, tuner.mean_loss(), 1e-6);
+        DOUBLES_EQUAL(0.1, tuner.peak_loss(), 1e-6);
+    }
+
+    { // all loss in one of four intervals: longest blocks
+        BlockTuner tuner(config, writer_config, MaxBlockLength);
+        LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+        Reporter reporter;
+
+        CHECK(!reporter.report(tuner, 0));
+        (void)reporter.report(tuner, 0.4);
+        for (size_t n = 0; n < config.loss_window - 1; n++) {
+            (void)reporter.report(tuner, 0);
+        }
+
+        LONGS_EQUAL(40, tuner.n_source_packets());
+        DOUBLES_EQUAL(0.1, tuner.mean_loss(), 1e-6);
+        DOUBLES_EQUAL(0.4, tuner.peak_loss(), 1e-6);
+
+        // repair packets cover peak loss
+        CHECK(double(tuner.n_repair_packets())
+                  / double(tuner.n_source_packets() + tuner.n_repair_packets())
+              >= 0.4);
+    }
+}
+
+TEST(block_tuner, counters_reset) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 2);
+
+    BlockTunerConfig config;
+    config.min_repair_ratio = 0.1f;
+    config.deduce_defaults(writer_config);
+
+    BlockTuner tuner(config, writer_config, MaxBlockLength);
+    LONGS_EQUAL(status::StatusOK, tuner.init_status());
+
+    CHECK(!tuner.update(5000, 0, core::Second));
+
+    // counters went back, e.g. receiver restarted; should set new baseline
+    // instead of computing loss from difference
+    CHECK(!tuner.update(1000, 500, 2 * core::Second));
+
+    LONGS_EQUAL(2, tuner.n_repair_packets());
+
+    CHECK(tuner.update(2000, 800, 3 * core::Second));
+
+    DOUBLES_EQUAL(0.3, tuner.peak_loss(), 1e-6);
+}
+
+TEST(block_tuner, bad_config) {
+    const BlockWriterConfig writer_config = make_writer_config(20, 10);
+
+    { // min > max
+        BlockTunerConfig config;
+        config.min_source_packets = 30;
+        config.max_source_packets = 20;
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength);
+        LONGS_EQUAL(status::StatusBadConfig, tuner.init_status());
+    }
+    { // max >= max block length
+        BlockTunerConfig config;
+        config.min_source_packets = 10;
+        config.max_source_packets = 255;
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength);
+        LONGS_EQUAL(status::StatusBadConfig, tuner.init_status());
+    }
+    { // bad ratio
+        BlockTunerConfig config;
+        config.min_repair_ratio = 0.5f;
+        config.max_repair_ratio = 0.2f;
+        config.deduce_defaults(writer_config);
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength);
+        LONGS_EQUAL(status::StatusBadConfig, tuner.init_status());
+    }
+    { // bad window
+        BlockTunerConfig config;
+        config.loss_window = 0;
+        config.deduce_defaults(writer_config);
+
+        BlockTuner tuner(config, writer_config, MaxBlockLength);
+        LONGS_EQUAL(status::StatusBadConfig, tuner.init_status());
+    }
+}
+
+} // namespace fec
+} // namespace roc
@@ -7,6 +7,7 @@
  */
 
 #include "test_harness.h"
+#include "test_helpers/counting_decoder.h"
 #include "test_helpers/packet_dispatcher.h"
 
 #include "roc_core/heap_arena.h"
@@ -1038,6 +1039,257 @@ TEST(block_writer_reader, multiple_repair_attempts) {
     }
 }
 
+TEST(block_writer_reader, incremental_decoding) {
+    // 1. Lose two packets in first block, hold repair packets.
+    // 2. Read packets before first loss.
+    // 3. Deliver repair packets one by one, just enough to repair losses.
+    // 4. Check that lost packets are repaired and decoding is stopped early.
+    reader_config.incremental_decoding = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_block_encoder(codec_config, packet_factory, arena));
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_block_decoder(codec_config, packet_factory, arena));
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        BlockWriter writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                           source_composer(), repair_composer(), packet_factory, arena);
+
+        BlockReader reader(reader_config, codec_config.scheme, *decoder,
+                           dispatcher.source_reader(), dispatcher.repair_reader(),
+                           rtp_parser, packet_factory, arena);
+
+        LONGS_EQUAL(status::StatusOK, writer.init_status());
+        LONGS_EQUAL(status::StatusOK, reader.init_status());
+
+        dispatcher.lose(3);
+        dispatcher.lose(11);
+
+        for (size_t n_block = 0; n_block < 2; n_block++) {
+            generate_packet_block(n_block * NumSourcePackets);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+            }
+
+            dispatcher.clear_losses();
+        }
+
+        dispatcher.push_source_stock(NumSourcePackets - 2);
+
+        for (size_t i = 0; i < 3; ++i) {
+            packet::PacketPtr p;
+            LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModeFetch));
+            check_packet(p, i);
+            check_restored(p, false);
+        }
+
+        // Deliver repair packets until both lost packets are repaired.
+        size_t n_repair = 0;
+        for (;;) {
+            packet::PacketPtr p;
+            LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModePeek));
+            CHECK(p);
+            if (p->rtp()->seqnum == 3) {
+                break;
+            }
+            CHECK(n_repair < NumRepairPackets);
+            dispatcher.push_repair_stock(1);
+            n_repair++;
+        }
+
+        for (size_t i = 3; i < NumSourcePackets; ++i) {
+            if (i == 15) {
+                // Remaining repair packets are not needed.
+                dispatcher.push_repair_stock(NumRepairPackets - n_repair);
+            }
+
+            packet::PacketPtr p;
+            LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModeFetch));
+            check_packet(p, i);
+            check_restored(p, i == 3 || i == 11);
+        }
+
+        dispatcher.push_stocks();
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            packet::PacketPtr p;
+            LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModeFetch));
+            check_packet(p, NumSourcePackets + i);
+            check_restored(p, false);
+        }
+
+        // Only first block had losses.
+        const BlockReaderMetrics metrics = reader.metrics();
+        UNSIGNED_LONGS_EQUAL(1, metrics.decoded_blocks);
+        UNSIGNED_LONGS_EQUAL(1, metrics.early_stopped_blocks);
+        CHECK(metrics.decode_time_p50 <= metrics.decode_time_p99);
+        CHECK(metrics.decode_time_p99 <= metrics.decode_time_max);
+
+        UNSIGNED_LONGS_EQUAL(0, dispatcher.source_size());
+    }
+}
+
+TEST(block_writer_reader, incremental_decoding_late_packet) {
+    // 1. Delay one packet in the middle of the block.
+    // 2. Deliver all other packets, including repair packets.
+    // 3. Deliver delayed packet before it is read.
+    // 4. Check that full decoding was not requested, because lost packet
+    //    was not needed before original one arrived.
+    reader_config.incremental_decoding = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_block_encoder(codec_config, packet_factory, arena));
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_block_decoder(codec_config, packet_factory, arena));
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        test::CountingDecoder counting_decoder(*decoder, arena);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        BlockWriter writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                           source_composer(), repair_composer(), packet_factory, arena);
+
+        BlockReader reader(reader_config, codec_config.scheme, counting_decoder,
+                           dispatcher.source_reader(), dispatcher.repair_reader(),
+                           rtp_parser, packet_factory, arena);
+
+        LONGS_EQUAL(status::StatusOK, writer.init_status());
+        LONGS_EQUAL(status::StatusOK, reader.init_status());
+
+        generate_packet_block(0);
+
+        dispatcher.clear_delays();
+        dispatcher.delay(8);
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+        }
+
+        dispatcher.push_stocks();
+
+        for (size_t i = 0; i < NumSourcePackets; ++i) {
+            if (i == 5) {
+                dispatcher.push_delayed(8);
+            }
+
+            packet::PacketPtr p;
+            LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModeFetch));
+            check_packet(p, i);
+            if (i != 8) {
+                // Packet 8 may be either original or recovered by
+                // iterative decoding, depending on codec.
+                check_restored(p, false);
+            }
+        }
+
+        UNSIGNED_LONGS_EQUAL(1, counting_decoder.n_blocks());
+        UNSIGNED_LONGS_EQUAL(0, counting_decoder.n_repair());
+
+        UNSIGNED_LONGS_EQUAL(0, dispatcher.source_size());
+    }
+}
+
+TEST(block_writer_reader, incremental_decoding_invocations) {
+    // 1. Lose two packets in every block.
+    // 2. Deliver packets one by one and peek after every packet, so that
+    //    reader handles every packet separately.
+    // 3. Read block.
+    // 4. Check that full decoding was requested only once per block,
+    //    when first lost packet was needed.
+    enum { NumBlocks = 5 };
+
+    reader_config.incremental_decoding = true;
+
+    for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
+        codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
+
+        core::ScopedPtr<IBlockEncoder> encoder(
+            CodecMap::instance().new_block_encoder(codec_config, packet_factory, arena));
+
+        core::ScopedPtr<IBlockDecoder> decoder(
+            CodecMap::instance().new_block_decoder(codec_config, packet_factory, arena));
+
+        CHECK(encoder);
+        CHECK(decoder);
+
+        test::CountingDecoder counting_decoder(*decoder, arena);
+
+        test::PacketDispatcher dispatcher(source_parser(), repair_parser(),
+                                          packet_factory, NumSourcePackets,
+                                          NumRepairPackets);
+
+        BlockWriter writer(writer_config, codec_config.scheme, *encoder, dispatcher,
+                           source_composer(), repair_composer(), packet_factory, arena);
+
+        BlockReader reader(reader_config, codec_config.scheme, counting_decoder,
+                           dispatcher.source_reader(), dispatcher.repair_reader(),
+                           rtp_parser, packet_factory, arena);
+
+        LONGS_EQUAL(status::StatusOK, writer.init_status());
+        LONGS_EQUAL(status::StatusOK, reader.init_status());
+
+        dispatcher.lose(5);
+        dispatcher.lose(15);
+
+        for (size_t n_block = 0; n_block < NumBlocks; n_block++) {
+            generate_packet_block(n_block * NumSourcePackets);
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                LONGS_EQUAL(status::StatusOK, writer.write(source_packets[i]));
+            }
+
+            for (size_t i = 0; i < NumSourcePackets - 2 + NumRepairPackets; ++i) {
+                if (i < NumSourcePackets - 2) {
+                    dispatcher.push_source_stock(1);
+                } else {
+                    dispatcher.push_repair_stock(1);
+                }
+
+                packet::PacketPtr p;
+                LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModePeek));
+                check_packet(p, n_block * NumSourcePackets);
+            }
+
+            for (size_t i = 0; i < NumSourcePackets; ++i) {
+                packet::PacketPtr p;
+                LONGS_EQUAL(status::StatusOK, reader.read(p, packet::ModeFetch));
+                check_packet(p, n_block * NumSourcePackets + i);
+                check_restored(p, i == 5 || i == 15);
+            }
+
+            UNSIGNED_LONGS_EQUAL(n_block + 1, counting_decoder.n_blocks());
+            UNSIGNED_LONGS_EQUAL(n_block + 1, counting_decoder.n_repair());
+        }
+
+        const BlockReaderMetrics metrics = reader.metrics();
+        UNSIGNED_LONGS_EQUAL(NumBlocks, metrics.decoded_blocks);
+        UNSIGNED_LONGS_EQUAL(NumBlocks, metrics.early_stopped_blocks);
+
+        UNSIGNED_LONGS_EQUAL(0, dispatcher.source_size());
+        UNSIGNED_LONGS_EQUAL(0, dispatcher.repair_size());
+    }
+}
+
 TEST(block_writer_reader, drop_outdated_block) {
     for (size_t n_scheme = 0; n_scheme < CodecMap::instance().num_schemes(); n_scheme++) {
         codec_config.scheme = CodecMap::instance().nth_scheme(n_scheme);
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "test_harness.h"
+
+#include "roc_core/fast_random.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/stddefs.h"
+#include "roc_fec/gf256.h"
+
+namespace roc {
+namespace fec {
+
+TEST_GROUP(gf256) {};
+
+TEST(gf256, mul_div) {
+    for (unsigned a = 0; a < 256; a++) {
+        LONGS_EQUAL(0, gf256_mul((uint8_t)a, 0));
+        LONGS_EQUAL(a, gf256_mul((uint8_t)a, 1));
+
+        for (unsigned b = 1; b < 256; b++) {
+            const uint8_t p = gf256_mul((uint8_t)a, (uint8_t)b);
+
+            LONGS_EQUAL(p, gf256_mul((uint8_t)b, (uint8_t)a));
+            LONGS_EQUAL(a, gf256_div(p, (uint8_t)b));
+        }
+    }
+}
+
+TEST(gf256, exp) {
+    // primitive polynomial is x^8 + x^4 + x^3 + x^2 + 1
+    LONGS_EQUAL(0x01, gf256_exp(0));
+    LONGS_EQUAL(0x02, gf256_exp(1));
+    LONGS_EQUAL(0x80, gf256_exp(7));
+    LONGS_EQUAL(0x1D, gf256_exp(8));
+    LONGS_EQUAL(0x01, gf256_exp(255));
+
+    // primitive element generates all non-zero elements
+    bool seen[256] = {};
+    for (size_t n = 0; n < 255; n++) {
+        const uint8_t x = gf256_exp(n);
+        CHECK(x != 0);
+        CHECK(!seen[x]);
+        seen[x] = true;
+    }
+}
+
+TEST(gf256, invert_matrix) {
+    enum { MaxSize = 20 };
+
+    for (size_t size = 1; size <= MaxSize; size++) {
+        uint8_t matrix[MaxSize * MaxSize];
+        uint8_t copy[MaxSize * MaxSize];
+        uint8_t inverse[MaxSize * MaxSize];
+
+        // Vandermonde matrix with distinct points, always invertible
+        for (size_t row = 0; row < size; row++) {
+            for (size_t col = 0; col < size; col++) {
+                matrix[row * size + col] = gf256_exp(row * col);
+            }
+        }
+        memcpy(copy, matrix, size * size);
+
+        CHECK(gf256_invert_matrix(matrix, inverse, size));
+
+        for (size_t row = 0; row < size; row++) {
+            for (size_t col = 0; col < size; col++) {
+                uint8_t sum = 0;
+                for (size_t k = 0; k < size; k++) {
+                    sum ^= gf256_mul(copy[row * size + k], inverse[k * size + col]);
+                }
+                LONGS_EQUAL(row == col ? 1 : 0, sum);
+            }
+        }
+    }
+}
+
+TEST(gf256, invert_singular_matrix) {
+    enum { Size = 3 };
+
+    uint8_t matrix[Size * Size] = {
+        1, 2, 3, //
+        4, 5, 6, //
+        5, 7, 5, // row0 + row1
+    };
+    uint8_t inverse[Size * Size];
+
+    CHECK(!gf256_invert_matrix(matrix, inverse, Size));
+}
+
+TEST_GROUP(gf256_kernel) {};
+
+// Compare every supported kernel with scalar multiplication on random input,
+// using sizes that are not multiple of vector width.
+TEST(gf256_kernel, compare_with_scalar) {
+    enum { NumBytes = 200 };
+
+    const uint8_t coef_list[] = { 0x00, 0x01, 0x02, 0x53, 0x8e, 0xff };
+
+    for (int kn = Gf256Kernel_Scalar; kn < Gf256Kernel_Max; kn++) {
+        const Gf256Kernel kernel = (Gf256Kernel)kn;
+
+        if (!gf256_kernel_supported(kernel)) {
+            continue;
+        }
+
+        const Gf256KernelFunc kernel_func = gf256_kernel_func(kernel);
+
+        for (size_t cn = 0; cn < ROC_ARRAY_SIZE(coef_list); cn++) {
+            for (size_t size = 0; size < 100; size++) {
+                for (size_t offset = 0; offset < 3; offset++) {
+                    uint8_t src[NumBytes];
+                    uint8_t expected[NumBytes];
+                    uint8_t actual[NumBytes];
+
+                    for (size_t n = 0; n < NumBytes; n++) {
+                        src[n] = (uint8_t)core::fast_random_range(0, 0xff);
+                        expected[n] = actual[n] =
+                            (uint8_t)core::fast_random_range(0, 0xff);
+                    }
+
+                    for (size_t n = offset; n < offset + size; n++) {
+                        expected[n] ^= gf256_mul(coef_list[cn], src[n]);
+                    }
+
+                    kernel_func(actual + offset, src + offset, size, coef_list[cn]);
+
+                    for (size_t n = 0; n < NumBytes; n++) {
+                        LONGS_EQUAL(expected[n], actual[n]);
+                    }
+                }
+            }
+        }
+    }
+}
+
+TEST(gf256_kernel, resolve) {
+    const Gf256Kernel kernel = gf256_kernel_resolve(Gf256Kernel_Auto);
+
+    CHECK(kernel != Gf256Kernel_Auto);
+    CHECK(gf256_kernel_supported(kernel));
+    CHECK(gf256_kernel_func(kernel) != NULL);
+
+    CHECK(gf256_kernel_supported(Gf256Kernel_Scalar));
+    LONGS_EQUAL(Gf256Kernel_Scalar, gf256_kernel_resolve(Gf256Kernel_Scalar));
+}
+
+} // namespace fec
+} // namespace roc
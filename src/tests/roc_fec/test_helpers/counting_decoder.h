@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef ROC_FEC_TEST_HELPERS_COUNTING_DECODER_H_
+#define ROC_FEC_TEST_HELPERS_COUNTING_DECODER_H_
+
+#include "roc_core/iarena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_fec/iblock_decoder.h"
+
+namespace roc {
+namespace fec {
+namespace test {
+
+// Forwards calls to real decoder and counts them.
+class CountingDecoder : public IBlockDecoder, public core::NonCopyable<> {
+public:
+    CountingDecoder(IBlockDecoder& decoder, core::IArena& arena)
+        : IBlockDecoder(arena)
+        , decoder_(decoder)
+        , n_blocks_(0)
+        , n_set_(0)
+        , n_get_(0)
+        , n_repair_(0) {
+    }
+
+    virtual status::StatusCode init_status() const {
+        return decoder_.init_status();
+    }
+
+    virtual size_t max_block_length() const {
+        return decoder_.max_block_length();
+    }
+
+    virtual ROC_NODISCARD status::StatusCode
+    begin_block(size_t sblen, size_t rblen, size_t payload_size) {
+        n_blocks_++;
+        return decoder_.begin_block(sblen, rblen, payload_size);
+    }
+
+    virtual void set_buffer(size_t index, const core::Slice<uint8_t>& buffer) {
+        n_set_++;
+        decoder_.set_buffer(index, buffer);
+    }
+
+    virtual core::Slice<uint8_t> get_buffer(size_t index) {
+        n_get_++;
+        return decoder_.get_buffer(index);
+    }
+
+    virtual core::Slice<uint8_t> repair_buffer(size_t index) {
+        n_repair_++;
+        return decoder_.repair_buffer(index);
+    }
+
+    virtual void end_block() {
+        decoder_.end_block();
+    }
+
+    // Number of begin_block() calls.
+    size_t n_blocks() const {
+        return n_blocks_;
+    }
+
+    // Number of set_buffer() calls.
+    size_t n_set() const {
+        return n_set_;
+    }
+
+    // Number of get_buffer() calls.
+    size_t n_get() const {
+        return n_get_;
+    }
+
+    // Number of repair_buffer() calls, i.e. requests for full decoding.
+    size_t n_repair() const {
+        return n_repair_;
+    }
+
+private:
+    IBlockDecoder& decoder_;
+
+    size_t n_blocks_;
+    size_t n_set_;
+    size_t n_get_;
+    size_t n_repair_;
+};
+
+} // namespace test
+} // namespace fec
+} // namespace roc
+
+#endif // ROC_FEC_TEST_HELPERS_COUNTING_DECODER_H_
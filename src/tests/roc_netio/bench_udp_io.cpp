@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <time.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_netio/network_loop.h"
+#include "roc_netio/socket_ops.h"
+#include "roc_packet/concurrent_queue.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace netio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_UdpIO/<send_batch>/<recv_batch>
+//   Sends bursts of packets from one port to another over loopback, using
+//   two separate network loops, and waits until every burst is received.
+//
+//  BM_UdpRecv/<recv_batch>/<kernel_ts>
+//   Sends bursts of packets from a plain socket in benchmark thread to a port
+//   of network loop, so that only receiving side goes through network loop.
+//
+// Output columns:
+//  - "items_per_second" - packets delivered per second
+//  - "pkt_per_cpu_sec" - packets delivered per second of process cpu time
+//    (network threads plus benchmark thread)
+//  - "rx_pkt_per_call" - packets returned by one receive system call
+//  - "rx_ts_delay_us", "rx_ts_max_delay_us" - mean and max difference between
+//    user-space and kernel receive timestamps (BM_UdpRecv with kernel_ts=1)
+//  - "lost" - packets that didn't arrive within timeout
+
+enum { BufferSize = 200, BurstSize = 64 };
+
+const core::nanoseconds_t RecvTimeout = core::Millisecond * 100;
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    buffer_pool("buffer_pool", arena, sizeof(core::Buffer) + BufferSize);
+
+packet::PacketFactory packet_factory(packet_pool, buffer_pool);
+
+double process_cpu_time() {
+    timespec ts;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts) != 0) {
+        return 0;
+    }
+    return double(ts.tv_sec) + double(ts.tv_nsec) / 1e9;
+}
+
+UdpConfig make_config() {
+    UdpConfig config;
+    if (!config.bind_address.set_host_port(address::Family_IPv4, "127.0.0.1", 0)) {
+        roc_panic("bench: can't set address");
+    }
+    return config;
+}
+
+void add_port(NetworkLoop& loop,
+              UdpConfig& config,
+              packet::IWriter* inbound_writer,
+              packet::IWriter** outbound_writer) {
+    NetworkLoop::Tasks::AddUdpPort add_task(config);
+    if (!loop.schedule_and_wait(add_task)) {
+        roc_panic("bench: can't add port");
+    }
+
+    if (inbound_writer) {
+        NetworkLoop::Tasks::StartUdpRecv recv_task(add_task.get_handle(),
+                                                   *inbound_writer);
+        if (!loop.schedule_and_wait(recv_task)) {
+            roc_panic("bench: can't start recv");
+        }
+    }
+
+    if (outbound_writer) {
+        NetworkLoop::Tasks::StartUdpSend send_task(add_task.get_handle());
+        if (!loop.schedule_and_wait(send_task)) {
+            roc_panic("bench: can't start send");
+        }
+        *outbound_writer = &send_task.get_outbound_writer();
+    }
+}
+
+packet::PacketPtr new_packet(const UdpConfig& tx_config, const UdpConfig& rx_config) {
+    packet::PacketPtr pp = packet_factory.new_packet();
+    roc_panic_if(!pp);
+
+    core::Slice<uint8_t> buf = packet_factory.new_packet_buffer();
+    roc_panic_if(!buf);
+    buf.reslice(0, BufferSize);
+    memset(buf.data(), 0, BufferSize);
+
+    pp->add_flags(packet::Packet::FlagUDP);
+    pp->udp()->src_addr = tx_config.bind_address;
+    pp->udp()->dst_addr = rx_config.bind_address;
+    pp->set_buffer(buf);
+
+    return pp;
+}
+
+size_t wait_burst(packet::ConcurrentQueue& rx_queue) {
+    const core::nanoseconds_t deadline =
+        core::timestamp(core::ClockMonotonic) + RecvTimeout;
+
+    size_t n_burst = 0;
+    while (n_burst < BurstSize) {
+        packet::PacketPtr pp;
+        if (rx_queue.read(pp, packet::ModeFetch) == status::StatusOK) {
+            n_burst++;
+            continue;
+        }
+        if (core::timestamp(core::ClockMonotonic) >= deadline) {
+            break;
+        }
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 10);
+    }
+
+    return n_burst;
+}
+
+void report_recv_stats(benchmark::State& state, const NetworkLoop& rx_loop) {
+    const size_t n_calls = rx_loop.num_received_batches();
+
+    state.counters["rx_pkt_per_call"] =
+        n_calls > 0 ? double(rx_loop.num_received_packets()) / n_calls : 0;
+}
+
+void BM_UdpIO(benchmark::State& state) {
+    if (state.range(1) > 1 && !UdpPort::batched_recv_supported()) {
+        state.SkipWithError("batched receive not supported");
+        return;
+    }
+
+    UdpConfig tx_config = make_config();
+    UdpConfig rx_config = make_config();
+
+    // route all packets through network thread in every variant,
+    // so that only batching differs between them
+    tx_config.enable_non_blocking = false;
+    tx_config.send_batch_size = (size_t)state.range(0);
+    rx_config.recv_batch_size = (size_t)state.range(1);
+
+    NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+    roc_panic_if(tx_loop.init_status() != status::StatusOK);
+
+    NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+    roc_panic_if(rx_loop.init_status() != status::StatusOK);
+
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::NonBlocking);
+
+    packet::IWriter* tx_writer = NULL;
+    add_port(tx_loop, tx_config, NULL, &tx_writer);
+    add_port(rx_loop, rx_config, &rx_queue, NULL);
+
+    size_t n_received = 0;
+    size_t n_lost = 0;
+
+    const double cpu_start = process_cpu_time();
+
+    while (state.KeepRunning()) {
+        for (size_t n = 0; n < BurstSize; n++) {
+            if (tx_writer->write(new_packet(tx_config, rx_config))
+                != status::StatusOK) {
+                roc_panic("bench: write failed");
+            }
+        }
+
+        const size_t n_burst = wait_burst(rx_queue);
+
+        n_received += n_burst;
+        n_lost += BurstSize - n_burst;
+    }
+
+    const double cpu_time = process_cpu_time() - cpu_start;
+
+    state.SetItemsProcessed(int64_t(n_received));
+
+    state.counters["pkt_per_cpu_sec"] = cpu_time > 0 ? double(n_received) / cpu_time : 0;
+    state.counters["lost"] = double(n_lost);
+
+    report_recv_stats(state, rx_loop);
+}
+
+BENCHMARK(BM_UdpIO)
+    ->Args({ 1, 1 })
+    ->Args({ 8, 1 })
+    ->Args({ 32, 1 })
+    ->Args({ 1, 8 })
+    ->Args({ 1, 32 })
+    ->Args({ 8, 8 })
+    ->Args({ 32, 32 })
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+void BM_UdpRecv(benchmark::State& state) {
+    if (state.range(0) > 1 && !UdpPort::batched_recv_supported()) {
+        state.SkipWithError("batched receive not supported");
+        return;
+    }
+
+    UdpConfig tx_config = make_config();
+    UdpConfig rx_config = make_config();
+
+    rx_config.recv_batch_size = (size_t)state.range(0);
+    rx_config.enable_kernel_timestamps = state.range(1) != 0;
+
+    NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+    roc_panic_if(rx_loop.init_status() != status::StatusOK);
+
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::NonBlocking);
+    add_port(rx_loop, rx_config, &rx_queue, NULL);
+
+    SocketHandle tx_sock = SocketInvalid;
+    if (!socket_create(tx_config.bind_address.family(), SocketType_Udp, tx_sock)
+        || !socket_bind(tx_sock, tx_config.bind_address)) {
+        roc_panic("bench: can't create socket");
+    }
+
+    uint8_t payload[BufferSize];
+    memset(payload, 0, sizeof(payload));
+
+    SocketDatagram datagrams[BurstSize];
+    for (size_t n = 0; n < BurstSize; n++) {
+        datagrams[n].buf = payload;
+        datagrams[n].bufsz = sizeof(payload);
+        datagrams[n].remote_address = &rx_config.bind_address;
+    }
+
+    size_t n_received = 0;
+    size_t n_lost = 0;
+
+    const double cpu_start = process_cpu_time();
+
+    while (state.KeepRunning()) {
+        size_t n_sent = 0;
+        while (n_sent < BurstSize) {
+            const ssize_t ret =
+                socket_try_send_batch(tx_sock, datagrams + n_sent, BurstSize - n_sent);
+            if (ret > 0) {
+                n_sent += (size_t)ret;
+            } else if (ret == SockErr_WouldBlock) {
+                core::sleep_for(core::ClockMonotonic, core::Microsecond * 10);
+            } else {
+                roc_panic("bench: send failed");
+            }
+        }
+
+        const size_t n_burst = wait_burst(rx_queue);
+
+        n_received += n_burst;
+        n_lost += BurstSize - n_burst;
+    }
+
+    const double cpu_time = process_cpu_time() - cpu_start;
+
+    if (!socket_close(tx_sock)) {
+        roc_panic("bench: can't close socket");
+    }
+
+    state.SetItemsProcessed(int64_t(n_received));
+
+    state.counters["pkt_per_cpu_sec"] = cpu_time > 0 ? double(n_received) / cpu_time : 0;
+    state.counters["lost"] = double(n_lost);
+
+    report_recv_stats(state, rx_loop);
+
+    if (rx_config.enable_kernel_timestamps) {
+        state.counters["rx_ts_delay_us"] =
+            double(rx_loop.mean_kernel_timestamp_delay()) / core::Microsecond;
+        state.counters["rx_ts_max_delay_us"] =
+            double(rx_loop.max_kernel_timestamp_delay()) / core::Microsecond;
+    }
+}
+
+BENCHMARK(BM_UdpRecv)
+    ->Args({ 1, 0 })
+    ->Args({ 8, 0 })
+    ->Args({ 32, 0 })
+    ->Args({ 1, 1 })
+    ->Args({ 32, 1 })
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace netio
+} // namespace roc
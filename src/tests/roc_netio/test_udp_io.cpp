@@ -11,9 +11,11 @@
 #include "roc_address/socket_addr.h"
 #include "roc_address/socket_addr_to_str.h"
 #include "roc_core/heap_arena.h"
+#include "roc_core/optional.h"
 #include "roc_core/slab_pool.h"
 #include "roc_core/time.h"
 #include "roc_netio/network_loop.h"
+#include "roc_packet/ibatch_writer.h"
 #include "roc_packet/concurrent_queue.h"
 #include "roc_packet/packet_factory.h"
 
@@ -193,6 +195,54 @@ packet::PacketPtr read_packet(packet::IReader& reader) {
     return packet;
 }
 
+
+// Batch writer that forwards packets to queue and counts batches.
+class BatchWriter : public packet::IBatchWriter {
+public:
+    explicit BatchWriter(packet::IWriter& writer)
+        : writer_(writer)
+        , n_batches_(0)
+        , n_packets_(0) {
+    }
+
+    size_t num_batches() const {
+        return n_batches_;
+    }
+
+    size_t num_packets() const {
+        return n_packets_;
+    }
+
+    virtual ROC_NODISCARD status::StatusCode write(const packet::PacketPtr& packet) {
+        n_packets_++;
+        return writer_.write(packet);
+    }
+
+    virtual ROC_NODISCARD status::StatusCode write_batch(const packet::PacketPtr* packets,
+                                                         size_t n_packets) {
+        CHECK(packets);
+        CHECK(n_packets > 0);
+        CHECK(n_packets <= UdpConfig::MaxBatchSize);
+
+        n_batches_++;
+
+        for (size_t n = 0; n < n_packets; n++) {
+            n_packets_++;
+            const status::StatusCode code = writer_.write(packets[n]);
+            if (code != status::StatusOK) {
+                return code;
+            }
+        }
+
+        return status::StatusOK;
+    }
+
+private:
+    packet::IWriter& writer_;
+    size_t n_batches_;
+    size_t n_packets_;
+};
+
 } // namespace
 
 TEST_GROUP(udp_io) {};
@@ -280,6 +330,257 @@ TEST(udp_io, one_sender_one_receiver_separate_loops) {
             check_packet(pp, tx_config, rx_config, p, i);
         }
     }
+
+    LONGS_EQUAL(NumIterations * NumPackets, tx_loop.num_sent_packets());
+    LONGS_EQUAL(0, tx_loop.num_received_packets());
+
+    LONGS_EQUAL(0, rx_loop.num_sent_packets());
+    LONGS_EQUAL(NumIterations * NumPackets, rx_loop.num_received_packets());
+}
+
+TEST(udp_io, one_sender_one_receiver_reuseport) {
+    enum { NumLoops = 3 };
+
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+    UdpConfig tx_config = make_udp_config();
+
+    NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, tx_loop.init_status());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    core::Optional<NetworkLoop> rx_loops[NumLoops];
+    UdpConfig rx_config = make_udp_config();
+    rx_config.enable_reuseport = true;
+
+    for (int n = 0; n < NumLoops; n++) {
+        rx_loops[n].reset(new (rx_loops[n])
+                              NetworkLoop(packet_pool, buffer_pool, arena));
+        LONGS_EQUAL(status::StatusOK, rx_loops[n]->init_status());
+
+        // first port selects random port, others bind to the same port
+        UdpConfig config = rx_config;
+        CHECK(add_udp_receiver(*rx_loops[n], config, rx_queue));
+        if (n == 0) {
+            rx_config.bind_address = config.bind_address;
+        }
+        CHECK(config.bind_address == rx_config.bind_address);
+    }
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            write_packet(*tx_writer, new_packet(tx_config, rx_config, p));
+        }
+    }
+
+    // packets may be reordered between loops, so we only count them
+    for (int n = 0; n < NumIterations * NumPackets; n++) {
+        packet::PacketPtr pp = read_packet(rx_queue);
+        CHECK(pp->udp()->src_addr == tx_config.bind_address);
+    }
+
+    size_t num_received = 0;
+    for (int n = 0; n < NumLoops; n++) {
+        num_received += rx_loops[n]->num_received_packets();
+    }
+    LONGS_EQUAL(NumIterations * NumPackets, num_received);
+}
+
+TEST(udp_io, one_sender_one_receiver_batched) {
+    const size_t batch_list[] = { 2, 8, UdpConfig::MaxBatchSize };
+
+    for (size_t bn = 0; bn < ROC_ARRAY_SIZE(batch_list); bn++) {
+        packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+        UdpConfig tx_config = make_udp_config();
+        UdpConfig rx_config = make_udp_config();
+
+        // force all packets to go through outbound queue
+        tx_config.enable_non_blocking = false;
+        tx_config.send_batch_size = batch_list[bn];
+        if (UdpPort::batched_recv_supported()) {
+            rx_config.recv_batch_size = batch_list[bn];
+        }
+
+        NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+        LONGS_EQUAL(status::StatusOK, tx_loop.init_status());
+
+        packet::IWriter* tx_writer = NULL;
+        CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+        CHECK(tx_writer);
+
+        NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+        LONGS_EQUAL(status::StatusOK, rx_loop.init_status());
+        CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
+
+        for (int i = 0; i < NumIterations; i++) {
+            // write packets without delay, so that they are accumulated in queue
+            for (int p = 0; p < NumPackets; p++) {
+                write_packet(*tx_writer, new_packet(tx_config, rx_config, p));
+            }
+            for (int p = 0; p < NumPackets; p++) {
+                packet::PacketPtr pp = read_packet(rx_queue);
+                check_packet(pp, tx_config, rx_config, p, i);
+            }
+        }
+    }
+}
+
+TEST(udp_io, one_sender_one_receiver_batch_writer) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+    BatchWriter rx_writer(rx_queue);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    tx_config.enable_non_blocking = false;
+    tx_config.send_batch_size = UdpConfig::MaxBatchSize;
+    if (UdpPort::batched_recv_supported()) {
+        rx_config.recv_batch_size = UdpConfig::MaxBatchSize;
+    }
+
+    NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, tx_loop.init_status());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, rx_loop.init_status());
+
+    NetworkLoop::Tasks::AddUdpPort add_task(rx_config);
+    CHECK(rx_loop.schedule_and_wait(add_task));
+    CHECK(add_task.success());
+
+    NetworkLoop::Tasks::StartUdpRecv recv_task(add_task.get_handle(), rx_writer);
+    CHECK(rx_loop.schedule_and_wait(recv_task));
+    CHECK(recv_task.success());
+
+    for (int i = 0; i < NumIterations; i++) {
+        for (int p = 0; p < NumPackets; p++) {
+            write_packet(*tx_writer, new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp = read_packet(rx_queue);
+            check_packet(pp, tx_config, rx_config, p, i);
+        }
+    }
+
+    // all packets should be delivered via batches
+    LONGS_EQUAL(NumIterations * NumPackets, rx_writer.num_packets());
+    CHECK(rx_writer.num_batches() > 0);
+    CHECK(rx_writer.num_batches() <= rx_writer.num_packets());
+
+    // every receive system call returns at least one packet
+    CHECK(rx_loop.num_received_batches() > 0);
+    CHECK(rx_loop.num_received_batches() <= rx_loop.num_received_packets());
+}
+
+TEST(udp_io, one_sender_one_receiver_kernel_timestamps) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    rx_config.enable_kernel_timestamps = true;
+
+    NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, tx_loop.init_status());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, rx_loop.init_status());
+    CHECK(add_udp_receiver(rx_loop, rx_config, rx_queue));
+
+    for (int i = 0; i < NumIterations; i++) {
+        const core::nanoseconds_t send_ts = core::timestamp(core::ClockUnix);
+
+        for (int p = 0; p < NumPackets; p++) {
+            short_delay();
+            write_packet(*tx_writer, new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp = read_packet(rx_queue);
+            check_packet(pp, tx_config, rx_config, p, i);
+
+            CHECK(pp->udp()->receive_timestamp >= send_ts);
+            CHECK(pp->udp()->receive_timestamp <= core::timestamp(core::ClockUnix));
+        }
+    }
+
+    // kernel timestamps may be not supported by platform, in which case
+    // port falls back to user-space timestamps
+    CHECK(rx_loop.num_kernel_timestamped_packets() <= rx_loop.num_received_packets());
+    CHECK(rx_loop.mean_kernel_timestamp_delay() >= 0);
+    CHECK(rx_loop.max_kernel_timestamp_delay() >= rx_loop.mean_kernel_timestamp_delay());
+
+#if defined(__linux__)
+    LONGS_EQUAL(rx_loop.num_received_packets(), rx_loop.num_kernel_timestamped_packets());
+#endif
+
+    LONGS_EQUAL(0, tx_loop.num_kernel_timestamped_packets());
+}
+
+TEST(udp_io, one_sender_one_receiver_kernel_timestamps_batched) {
+    packet::ConcurrentQueue rx_queue(packet::ConcurrentQueue::Blocking);
+    BatchWriter rx_writer(rx_queue);
+
+    UdpConfig tx_config = make_udp_config();
+    UdpConfig rx_config = make_udp_config();
+
+    tx_config.enable_non_blocking = false;
+    tx_config.send_batch_size = UdpConfig::MaxBatchSize;
+    if (UdpPort::batched_recv_supported()) {
+        rx_config.recv_batch_size = UdpConfig::MaxBatchSize;
+    }
+    rx_config.enable_kernel_timestamps = true;
+
+    NetworkLoop tx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, tx_loop.init_status());
+
+    packet::IWriter* tx_writer = NULL;
+    CHECK(add_udp_sender(tx_loop, tx_config, &tx_writer));
+    CHECK(tx_writer);
+
+    NetworkLoop rx_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, rx_loop.init_status());
+
+    NetworkLoop::Tasks::AddUdpPort add_task(rx_config);
+    CHECK(rx_loop.schedule_and_wait(add_task));
+    CHECK(add_task.success());
+
+    NetworkLoop::Tasks::StartUdpRecv recv_task(add_task.get_handle(), rx_writer);
+    CHECK(rx_loop.schedule_and_wait(recv_task));
+    CHECK(recv_task.success());
+
+    for (int i = 0; i < NumIterations; i++) {
+        const core::nanoseconds_t send_ts = core::timestamp(core::ClockUnix);
+
+        for (int p = 0; p < NumPackets; p++) {
+            write_packet(*tx_writer, new_packet(tx_config, rx_config, p));
+        }
+        for (int p = 0; p < NumPackets; p++) {
+            packet::PacketPtr pp = read_packet(rx_queue);
+            check_packet(pp, tx_config, rx_config, p, i);
+
+            CHECK(pp->udp()->receive_timestamp >= send_ts);
+            CHECK(pp->udp()->receive_timestamp <= core::timestamp(core::ClockUnix));
+        }
+    }
+
+    LONGS_EQUAL(NumIterations * NumPackets, rx_writer.num_packets());
+
+#if defined(__linux__)
+    // timestamps are available in batched mode too
+    LONGS_EQUAL(rx_loop.num_received_packets(), rx_loop.num_kernel_timestamped_packets());
+#endif
 }
 
 TEST(udp_io, one_sender_many_receivers) {
@@ -283,6 +283,32 @@ TEST(udp_ports, addrinuse) {
     LONGS_EQUAL(0, net_loop2.num_ports());
 }
 
+TEST(udp_ports, bad_batch_size) {
+    NetworkLoop net_loop(packet_pool, buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, net_loop.init_status());
+
+    { // zero
+        UdpConfig config = make_udp_config("127.0.0.1", 0);
+        config.recv_batch_size = 0;
+
+        CHECK(!add_port(net_loop, config));
+    }
+    { // too large
+        UdpConfig config = make_udp_config("127.0.0.1", 0);
+        config.send_batch_size = UdpConfig::MaxBatchSize + 1;
+
+        CHECK(!add_port(net_loop, config));
+    }
+    if (!UdpPort::batched_recv_supported()) { // not supported
+        UdpConfig config = make_udp_config("127.0.0.1", 0);
+        config.recv_batch_size = 2;
+
+        CHECK(!add_port(net_loop, config));
+    }
+
+    LONGS_EQUAL(0, net_loop.num_ports());
+}
+
 TEST(udp_ports, broadcast_sender) {
     packet::ConcurrentQueue queue(packet::ConcurrentQueue::Blocking);
 
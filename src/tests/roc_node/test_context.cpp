@@ -50,5 +50,91 @@ TEST(context, reference_counting) {
     CHECK(context.getref() == 0);
 }
 
+TEST(context, network_threads) {
+    { // default
+        ContextConfig context_config;
+        Context context(context_config, arena);
+
+        LONGS_EQUAL(status::StatusOK, context.init_status());
+        LONGS_EQUAL(1, context.num_network_loops());
+
+        POINTERS_EQUAL(&context.network_loop(), &context.network_loop(0));
+        POINTERS_EQUAL(&context.network_loop(), &context.select_network_loop());
+        POINTERS_EQUAL(&context.network_loop(), &context.select_network_loop());
+    }
+    { // multiple
+        ContextConfig context_config;
+        context_config.num_network_threads = 3;
+
+        Context context(context_config, arena);
+
+        LONGS_EQUAL(status::StatusOK, context.init_status());
+        LONGS_EQUAL(3, context.num_network_loops());
+
+        POINTERS_EQUAL(&context.network_loop(), &context.network_loop(0));
+        CHECK(&context.network_loop(0) != &context.network_loop(1));
+        CHECK(&context.network_loop(1) != &context.network_loop(2));
+
+        for (size_t n = 0; n < 7; n++) {
+            POINTERS_EQUAL(&context.network_loop(n % 3), &context.select_network_loop());
+        }
+    }
+    { // invalid
+        ContextConfig context_config;
+        context_config.num_network_threads = 0;
+
+        Context context(context_config, arena);
+        LONGS_EQUAL(status::StatusBadConfig, context.init_status());
+    }
+    { // too many
+        ContextConfig context_config;
+        context_config.num_network_threads = Context::MaxNetworkLoops + 1;
+
+        Context context(context_config, arena);
+        LONGS_EQUAL(status::StatusBadConfig, context.init_status());
+    }
+}
+
+TEST(context, udp_batch_size) {
+    { // default
+        ContextConfig context_config;
+        Context context(context_config, arena);
+
+        LONGS_EQUAL(status::StatusOK, context.init_status());
+        LONGS_EQUAL(1, context.udp_recv_batch_size());
+        LONGS_EQUAL(1, context.udp_send_batch_size());
+    }
+    { // custom
+        ContextConfig context_config;
+        context_config.udp_recv_batch_size = 8;
+        context_config.udp_send_batch_size = netio::UdpConfig::MaxBatchSize;
+
+        Context context(context_config, arena);
+
+        if (netio::UdpPort::batched_recv_supported()) {
+            LONGS_EQUAL(status::StatusOK, context.init_status());
+            LONGS_EQUAL(8, context.udp_recv_batch_size());
+            LONGS_EQUAL(netio::UdpConfig::MaxBatchSize, context.udp_send_batch_size());
+        } else {
+            // batched receive can't be honoured
+            LONGS_EQUAL(status::StatusBadConfig, context.init_status());
+        }
+    }
+    { // invalid
+        ContextConfig context_config;
+        context_config.udp_recv_batch_size = 0;
+
+        Context context(context_config, arena);
+        LONGS_EQUAL(status::StatusBadConfig, context.init_status());
+    }
+    { // too large
+        ContextConfig context_config;
+        context_config.udp_send_batch_size = netio::UdpConfig::MaxBatchSize + 1;
+
+        Context context(context_config, arena);
+        LONGS_EQUAL(status::StatusBadConfig, context.init_status());
+    }
+}
+
 } // namespace node
 } // namespace roc
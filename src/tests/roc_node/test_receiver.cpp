@@ -100,6 +100,61 @@ TEST(receiver, bind) {
     }
 }
 
+TEST(receiver, bind_network_threads) {
+    enum { NumThreads = 3, NumSlots = 6 };
+
+    context_config.num_network_threads = NumThreads;
+
+    Context context(context_config, arena);
+    LONGS_EQUAL(status::StatusOK, context.init_status());
+
+    Receiver receiver(context, receiver_config);
+    LONGS_EQUAL(status::StatusOK, receiver.init_status());
+
+    for (size_t n = 0; n < NumSlots; n++) {
+        address::NetworkUri source_endp(arena);
+        parse_uri(source_endp, "rtp://127.0.0.1:0");
+
+        CHECK(receiver.bind(n, address::Iface_AudioSource, source_endp));
+    }
+
+    // ports are distributed between loops in round-robin order
+    for (size_t n = 0; n < NumThreads; n++) {
+        LONGS_EQUAL(NumSlots / NumThreads, context.network_loop(n).num_ports());
+    }
+}
+
+TEST(receiver, bind_reuseport) {
+    enum { NumThreads = 3 };
+
+    context_config.num_network_threads = NumThreads;
+    context_config.enable_reuseport = true;
+
+    Context context(context_config, arena);
+    LONGS_EQUAL(status::StatusOK, context.init_status());
+
+    Receiver receiver(context, receiver_config);
+    LONGS_EQUAL(status::StatusOK, receiver.init_status());
+
+    address::NetworkUri source_endp(arena);
+    parse_uri(source_endp, "rtp://127.0.0.1:0");
+
+    CHECK(source_endp.port() == 0);
+    CHECK(receiver.bind(DefaultSlot, address::Iface_AudioSource, source_endp));
+    CHECK(source_endp.port() != 0);
+
+    // same address is bound in every loop
+    for (size_t n = 0; n < NumThreads; n++) {
+        LONGS_EQUAL(1, context.network_loop(n).num_ports());
+    }
+
+    CHECK(receiver.unlink(DefaultSlot));
+
+    for (size_t n = 0; n < NumThreads; n++) {
+        LONGS_EQUAL(0, context.network_loop(n).num_ports());
+    }
+}
+
 TEST(receiver, configure) {
     { // one slot
         Context context(context_config, arena);
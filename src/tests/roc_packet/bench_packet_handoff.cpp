@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/mpsc_queue.h"
+#include "roc_core/panic.h"
+#include "roc_core/thread.h"
+#include "roc_packet/packet_factory.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// Benchmarks:
+//
+//  BM_PacketHandoff/batch:<batch>
+//   Handoff of packets from network thread to pipeline thread via MpscQueue,
+//   same as done by ReceiverEndpoint. Producer thread writes packets in batches
+//   of <batch> packets using push_back_many(), or using push_back() if <batch>
+//   is 1. Consumer thread concurrently pulls packets using
+//   try_pop_front_many_exclusive(), or try_pop_front_exclusive() if <batch> is 1.
+//
+// Output column "items_per_second" reports packets transferred per second.
+//
+// Output column "handoffs_per_packet" reports number of atomic exchanges of
+// queue tail per packet. Every exchange transfers the tail cache line between
+// producer and consumer CPUs, so this is the number of cross-thread cache misses
+// per packet caused by queue itself (in addition to the misses on packet data,
+// which are the same in all modes). To measure actual cache misses, run the
+// benchmark under "perf stat -e cache-misses".
+
+enum { NumPackets = 4096, MaxPullBatch = 32, MaxBufSize = 100 };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+PacketPtr* get_packets() {
+    static PacketPtr packets[NumPackets];
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        if (!packets[n]) {
+            packets[n] = packet_factory.new_packet();
+            roc_panic_if(!packets[n]);
+        }
+    }
+
+    return packets;
+}
+
+class ProducerThread : public core::Thread {
+public:
+    ProducerThread(core::MpscQueue<Packet>& queue, PacketPtr* packets, size_t batch)
+        : queue_(queue)
+        , packets_(packets)
+        , batch_(batch)
+        , n_handoffs_(0) {
+    }
+
+    size_t num_handoffs() const {
+        return n_handoffs_;
+    }
+
+private:
+    virtual void run() {
+        for (size_t pos = 0; pos < NumPackets; pos += batch_) {
+            if (batch_ == 1) {
+                queue_.push_back(*packets_[pos]);
+            } else {
+                queue_.push_back_many(packets_ + pos, std::min(batch_, NumPackets - pos));
+            }
+            n_handoffs_++;
+        }
+    }
+
+    core::MpscQueue<Packet>& queue_;
+    PacketPtr* packets_;
+    const size_t batch_;
+    size_t n_handoffs_;
+};
+
+void BM_PacketHandoff(benchmark::State& state) {
+    const size_t batch = (size_t)state.range(0);
+
+    PacketPtr* packets = get_packets();
+
+    core::MpscQueue<Packet> queue;
+    PacketPtr pulled[MaxPullBatch];
+
+    size_t n_handoffs = 0;
+
+    while (state.KeepRunningBatch(NumPackets)) {
+        ProducerThread producer(queue, packets, batch);
+        if (!producer.start()) {
+            roc_panic("bench: can't start thread");
+        }
+
+        size_t n_pulled = 0;
+
+        while (n_pulled < NumPackets) {
+            if (batch == 1) {
+                if (PacketPtr pp = queue.try_pop_front_exclusive()) {
+                    n_pulled++;
+                }
+            } else {
+                const size_t n = queue.try_pop_front_many_exclusive(pulled, MaxPullBatch);
+                for (size_t i = 0; i < n; i++) {
+                    pulled[i] = NULL;
+                }
+                n_pulled += n;
+            }
+        }
+
+        producer.join();
+        n_handoffs += producer.num_handoffs();
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+    state.counters["handoffs_per_packet"] =
+        (double)n_handoffs / (double)state.iterations();
+}
+
+BENCHMARK(BM_PacketHandoff)
+    ->ArgName("batch")
+    ->Arg(1)
+    ->Arg(4)
+    ->Arg(16)
+    ->Arg(32)
+    ->UseRealTime()
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/panic.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_packet/sorted_queue.h"
+
+namespace roc {
+namespace packet {
+namespace {
+
+// Benchmarks:
+//
+//  BM_SortedQueue/pattern:<pattern>/window:<window>/depth:<depth>
+//   Steady-state write + read of one packet, while the queue holds about
+//   <depth> packets. <window> is 0 for list-only queue, and 1 for queue
+//   with seqnum window of DefaultSortedQueueWindow.
+//
+// Patterns:
+//   0 - in-order arrival
+//   1 - reordered arrival: every packet is displaced by random distance
+//       within half of queue depth
+//   2 - bursty arrival: bursts of packets are delayed and arrive right
+//       after the following burst
+
+enum { NumPackets = 8192, BurstSize = 32, MaxBufSize = 100 };
+
+enum Pattern { Pattern_InOrder, Pattern_Reordered, Pattern_Bursty };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+const char* pattern_to_str(Pattern pattern) {
+    switch (pattern) {
+    case Pattern_InOrder:
+        return "in_order";
+    case Pattern_Reordered:
+        return "reordered";
+    case Pattern_Bursty:
+        return "bursty";
+    }
+    return "invalid";
+}
+
+// Fill arrival order: order[i] is seqnum offset of i-th arrived packet.
+void make_order(Pattern pattern, size_t depth, seqnum_t* order) {
+    for (size_t i = 0; i < NumPackets; i++) {
+        order[i] = (seqnum_t)i;
+    }
+
+    switch (pattern) {
+    case Pattern_InOrder:
+        break;
+
+    case Pattern_Reordered: {
+        const size_t max_dist = depth / 2;
+        for (size_t i = 0; i + max_dist < NumPackets; i++) {
+            const size_t j = i + core::fast_random_range(0, max_dist);
+            std::swap(order[i], order[j]);
+        }
+    } break;
+
+    case Pattern_Bursty:
+        for (size_t i = 0; i + BurstSize * 2 <= NumPackets; i += BurstSize * 2) {
+            for (size_t j = 0; j < BurstSize; j++) {
+                std::swap(order[i + j], order[i + j + BurstSize]);
+            }
+        }
+        break;
+    }
+}
+
+void BM_SortedQueue(benchmark::State& state) {
+    const Pattern pattern = (Pattern)state.range(0);
+    const bool use_window = state.range(1) != 0;
+    const size_t depth = (size_t)state.range(2);
+
+    state.SetLabel(pattern_to_str(pattern));
+
+    static seqnum_t order[NumPackets];
+    make_order(pattern, depth, order);
+
+    static PacketPtr packets[NumPackets];
+    for (size_t i = 0; i < NumPackets; i++) {
+        if (!packets[i]) {
+            packets[i] = packet_factory.new_packet();
+            roc_panic_if(!packets[i]);
+            packets[i]->add_flags(Packet::FlagRTP);
+        }
+    }
+
+    SortedQueue list_queue(0);
+    SortedQueue ring_queue(0, DefaultSortedQueueWindow, arena);
+    roc_panic_if(ring_queue.init_status() != status::StatusOK);
+
+    SortedQueue& queue = use_window ? ring_queue : list_queue;
+
+    seqnum_t base = 0;
+    size_t pos = 0;
+
+    while (state.KeepRunningBatch(NumPackets)) {
+        for (pos = 0; pos < NumPackets; pos++) {
+            // Packet slots are reused cyclically; by the time a slot is reused,
+            // its previous packet is already read from the queue.
+            Packet& packet = *packets[order[pos]];
+            packet.rtp()->seqnum = seqnum_t(base + order[pos]);
+
+            if (queue.write(&packet) != status::StatusOK) {
+                roc_panic("bench: write() failed");
+            }
+
+            if (queue.size() > depth) {
+                PacketPtr pp;
+                if (queue.read(pp, ModeFetch) != status::StatusOK) {
+                    roc_panic("bench: read() failed");
+                }
+            }
+        }
+
+        base = seqnum_t(base + NumPackets);
+    }
+
+    for (;;) {
+        PacketPtr pp;
+        if (queue.read(pp, ModeFetch) != status::StatusOK) {
+            break;
+        }
+    }
+
+    state.SetItemsProcessed(int64_t(state.iterations()));
+}
+
+BENCHMARK(BM_SortedQueue)
+    ->ArgNames({ "pattern", "window", "depth" })
+    ->ArgsProduct({ { Pattern_InOrder, Pattern_Reordered, Pattern_Bursty },
+                    { 0, 1 },
+                    { 64, 256, 1024 } })
+    ->Unit(benchmark::kNanosecond);
+
+} // namespace
+} // namespace packet
+} // namespace roc
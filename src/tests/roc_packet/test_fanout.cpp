@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_packet/fanout.h"
+#include "roc_packet/fifo_queue.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_status/status_code.h"
+
+namespace roc {
+namespace packet {
+
+namespace {
+
+enum { MaxBufSize = 100 };
+
+core::HeapArena arena;
+PacketFactory packet_factory(arena, MaxBufSize);
+
+PacketPtr new_packet(seqnum_t sn) {
+    PacketPtr packet = packet_factory.new_packet();
+    CHECK(packet);
+
+    packet->add_flags(Packet::FlagUDP | Packet::FlagRTP | Packet::FlagAudio
+                      | Packet::FlagPrepared | Packet::FlagComposed);
+    packet->rtp()->seqnum = sn;
+
+    core::Slice<uint8_t> buffer = packet_factory.new_packet_buffer();
+    CHECK(buffer);
+    buffer.reslice(0, MaxBufSize);
+    packet->set_buffer(buffer);
+
+    return packet;
+}
+
+class FailingWriter : public IWriter, public core::NonCopyable<> {
+public:
+    FailingWriter(status::StatusCode code)
+        : code_(code)
+        , n_writes_(0) {
+    }
+
+    virtual ROC_NODISCARD status::StatusCode write(const PacketPtr&) {
+        n_writes_++;
+        return code_;
+    }
+
+    size_t num_writes() const {
+        return n_writes_;
+    }
+
+private:
+    status::StatusCode code_;
+    size_t n_writes_;
+};
+
+} // namespace
+
+TEST_GROUP(fanout) {};
+
+TEST(fanout, no_outputs) {
+    Fanout fanout(packet_factory, arena);
+    LONGS_EQUAL(status::StatusOK, fanout.init_status());
+
+    PacketPtr wp = new_packet(1);
+    LONGS_EQUAL(status::StatusOK, fanout.write(wp));
+
+    LONGS_EQUAL(1, wp->getref());
+    LONGS_EQUAL(0, fanout.num_copies());
+}
+
+TEST(fanout, one_output) {
+    Fanout fanout(packet_factory, arena);
+    LONGS_EQUAL(status::StatusOK, fanout.init_status());
+
+    FifoQueue queue;
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue));
+
+    PacketPtr wp = new_packet(1);
+    LONGS_EQUAL(status::StatusOK, fanout.write(wp));
+
+    PacketPtr rp;
+    LONGS_EQUAL(status::StatusOK, queue.read(rp, ModeFetch));
+
+    // original packet is passed as is
+    CHECK(wp == rp);
+    LONGS_EQUAL(0, fanout.num_copies());
+}
+
+TEST(fanout, many_outputs) {
+    enum { NumOutputs = 3, NumPackets = 5 };
+
+    Fanout fanout(packet_factory, arena);
+    LONGS_EQUAL(status::StatusOK, fanout.init_status());
+
+    FifoQueue queues[NumOutputs];
+    for (size_t no = 0; no < NumOutputs; no++) {
+        LONGS_EQUAL(status::StatusOK, fanout.add_output(queues[no]));
+        CHECK(fanout.has_output(queues[no]));
+    }
+    LONGS_EQUAL(NumOutputs, fanout.num_outputs());
+
+    PacketPtr packets[NumPackets];
+    for (size_t np = 0; np < NumPackets; np++) {
+        packets[np] = new_packet(seqnum_t(np));
+        LONGS_EQUAL(status::StatusOK, fanout.write(packets[np]));
+    }
+
+    LONGS_EQUAL((NumOutputs - 1) * NumPackets, fanout.num_copies());
+
+    for (size_t np = 0; np < NumPackets; np++) {
+        for (size_t no = 0; no < NumOutputs; no++) {
+            PacketPtr rp;
+            LONGS_EQUAL(status::StatusOK, queues[no].read(rp, ModeFetch));
+
+            if (no == 0) {
+                CHECK(rp == packets[np]);
+            } else {
+                CHECK(rp != packets[np]);
+            }
+
+            // every output gets its own packet with the same buffer
+            LONGS_EQUAL(packets[np]->flags(), rp->flags());
+            LONGS_EQUAL(np, rp->rtp()->seqnum);
+            CHECK(rp->buffer().data() == packets[np]->buffer().data());
+            LONGS_EQUAL(packets[np]->buffer().size(), rp->buffer().size());
+        }
+    }
+}
+
+TEST(fanout, copies_are_independent) {
+    Fanout fanout(packet_factory, arena);
+    LONGS_EQUAL(status::StatusOK, fanout.init_status());
+
+    FifoQueue queue1;
+    FifoQueue queue2;
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue1));
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue2));
+
+    PacketPtr wp = new_packet(1);
+    LONGS_EQUAL(status::StatusOK, fanout.write(wp));
+
+    PacketPtr rp1;
+    PacketPtr rp2;
+    LONGS_EQUAL(status::StatusOK, queue1.read(rp1, ModeFetch));
+    LONGS_EQUAL(status::StatusOK, queue2.read(rp2, ModeFetch));
+
+    CHECK(rp1->udp()->dst_addr.set_host_port(address::Family_IPv4, "127.0.0.1", 111));
+    CHECK(rp2->udp()->dst_addr.set_host_port(address::Family_IPv4, "127.0.0.1", 222));
+
+    CHECK(rp1->udp()->dst_addr != rp2->udp()->dst_addr);
+}
+
+TEST(fanout, remove_output) {
+    Fanout fanout(packet_factory, arena);
+    LONGS_EQUAL(status::StatusOK, fanout.init_status());
+
+    FifoQueue queue1;
+    FifoQueue queue2;
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue1));
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue2));
+
+    fanout.remove_output(queue1);
+
+    CHECK(!fanout.has_output(queue1));
+    CHECK(fanout.has_output(queue2));
+    LONGS_EQUAL(1, fanout.num_outputs());
+
+    PacketPtr wp = new_packet(1);
+    LONGS_EQUAL(status::StatusOK, fanout.write(wp));
+
+    LONGS_EQUAL(0, queue1.size());
+    LONGS_EQUAL(1, queue2.size());
+}
+
+TEST(fanout, failed_output) {
+    Fanout fanout(packet_factory, arena);
+    LONGS_EQUAL(status::StatusOK, fanout.init_status());
+
+    FifoQueue queue1;
+    FailingWriter failing_writer1(status::StatusErrNetwork);
+    FailingWriter failing_writer2(status::StatusNoMem);
+    FifoQueue queue2;
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue1));
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(failing_writer1));
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(failing_writer2));
+    LONGS_EQUAL(status::StatusOK, fanout.add_output(queue2));
+
+    PacketPtr wp = new_packet(1);
+
+    // first error is returned
+    LONGS_EQUAL(status::StatusErrNetwork, fanout.write(wp));
+
+    // all outputs got packet
+    LONGS_EQUAL(1, queue1.size());
+    LONGS_EQUAL(1, failing_writer1.num_writes());
+    LONGS_EQUAL(1, failing_writer2.num_writes());
+    LONGS_EQUAL(1, queue2.size());
+}
+
+} // namespace packet
+} // namespace roc
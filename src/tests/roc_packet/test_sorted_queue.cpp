@@ -8,6 +8,7 @@
 
 #include <CppUTest/TestHarness.h>
 
+#include "roc_core/fast_random.h"
 #include "roc_core/heap_arena.h"
 #include "roc_packet/packet_factory.h"
 #include "roc_packet/sorted_queue.h"
@@ -505,5 +506,124 @@ TEST(sorted_queue, latest) {
     CHECK(queue.latest() == wp4);
 }
 
+TEST(sorted_queue, window_out_of_order) {
+    enum { WindowSize = 16, NumPackets = 12 };
+
+    SortedQueue queue(0, WindowSize, arena);
+    LONGS_EQUAL(status::StatusOK, queue.init_status());
+
+    // even seqnums, then odd seqnums in reverse order
+    for (seqnum_t n = 0; n < NumPackets; n += 2) {
+        expect_write(status::StatusOK, queue, new_packet(n));
+    }
+    for (seqnum_t n = NumPackets - 1; n < NumPackets; n -= 2) {
+        expect_write(status::StatusOK, queue, new_packet(n));
+    }
+
+    // duplicates are dropped
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        expect_write(status::StatusOK, queue, new_packet(n));
+    }
+
+    LONGS_EQUAL(NumPackets, queue.size());
+
+    for (seqnum_t n = 0; n < NumPackets; n++) {
+        PacketPtr pp = expect_read(status::StatusOK, queue, ModeFetch);
+        LONGS_EQUAL(n, pp->rtp()->seqnum);
+    }
+
+    expect_read(status::StatusDrain, queue, ModeFetch);
+}
+
+TEST(sorted_queue, window_overflow) {
+    enum { WindowSize = 4 };
+
+    SortedQueue queue(0, WindowSize, arena);
+    LONGS_EQUAL(status::StatusOK, queue.init_status());
+
+    expect_write(status::StatusOK, queue, new_packet(10));
+    expect_write(status::StatusOK, queue, new_packet(20));
+
+    // outside of window, list is used
+    expect_write(status::StatusOK, queue, new_packet(5));
+    expect_write(status::StatusOK, queue, new_packet(15));
+    expect_write(status::StatusOK, queue, new_packet(10));
+
+    // inside window, ring is used
+    expect_write(status::StatusOK, queue, new_packet(18));
+    expect_write(status::StatusOK, queue, new_packet(19));
+    expect_write(status::StatusOK, queue, new_packet(19));
+
+    const seqnum_t expected[] = { 5, 10, 15, 18, 19, 20 };
+
+    LONGS_EQUAL(6, queue.size());
+
+    for (size_t n = 0; n < 6; n++) {
+        PacketPtr pp = expect_read(status::StatusOK, queue, ModeFetch);
+        LONGS_EQUAL(expected[n], pp->rtp()->seqnum);
+    }
+
+    expect_read(status::StatusDrain, queue, ModeFetch);
+}
+
+TEST(sorted_queue, window_seqnum_overflow) {
+    enum { WindowSize = 8 };
+
+    SortedQueue queue(0, WindowSize, arena);
+    LONGS_EQUAL(status::StatusOK, queue.init_status());
+
+    expect_write(status::StatusOK, queue, new_packet(2));
+    expect_write(status::StatusOK, queue, new_packet(65534));
+    expect_write(status::StatusOK, queue, new_packet(0));
+    expect_write(status::StatusOK, queue, new_packet(65535));
+    expect_write(status::StatusOK, queue, new_packet(1));
+
+    for (seqnum_t n = 65534; n != 3; n++) {
+        PacketPtr pp = expect_read(status::StatusOK, queue, ModeFetch);
+        LONGS_EQUAL(n, pp->rtp()->seqnum);
+    }
+
+    expect_read(status::StatusDrain, queue, ModeFetch);
+}
+
+// Write the same random sequence to queues with and without window,
+// interleaving writes with reads, and check that results are identical.
+TEST(sorted_queue, window_compare_with_list) {
+    enum { WindowSize = 32, NumIterations = 5000, MaxJitter = 48 };
+
+    SortedQueue list_queue(0);
+    SortedQueue ring_queue(0, WindowSize, arena);
+    LONGS_EQUAL(status::StatusOK, ring_queue.init_status());
+
+    seqnum_t sn = 65000;
+
+    for (size_t i = 0; i < NumIterations; i++) {
+        const seqnum_t wsn =
+            seqnum_t(sn - (seqnum_t)core::fast_random_range(0, MaxJitter));
+        sn++;
+
+        expect_write(status::StatusOK, list_queue, new_packet(wsn));
+        expect_write(status::StatusOK, ring_queue, new_packet(wsn));
+
+        LONGS_EQUAL(list_queue.size(), ring_queue.size());
+
+        if (core::fast_random_range(0, 2) == 0) {
+            PacketPtr lp = expect_read(status::StatusOK, list_queue, ModeFetch);
+            PacketPtr rp = expect_read(status::StatusOK, ring_queue, ModeFetch);
+
+            LONGS_EQUAL(lp->rtp()->seqnum, rp->rtp()->seqnum);
+        }
+    }
+
+    while (list_queue.size() != 0) {
+        PacketPtr lp = expect_read(status::StatusOK, list_queue, ModeFetch);
+        PacketPtr rp = expect_read(status::StatusOK, ring_queue, ModeFetch);
+
+        LONGS_EQUAL(lp->rtp()->seqnum, rp->rtp()->seqnum);
+    }
+
+    expect_read(status::StatusDrain, ring_queue, ModeFetch);
+}
+
 } // namespace packet
 } // namespace roc
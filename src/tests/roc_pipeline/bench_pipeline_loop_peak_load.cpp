@@ -6,16 +6,23 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
+#include "roc_audio/mixer.h"
 #include "roc_core/atomic.h"
 #include "roc_core/fast_random.h"
 #include "roc_core/heap_arena.h"
+#include "roc_core/noncopyable.h"
+#include "roc_core/optional.h"
+#include "roc_core/panic.h"
+#include "roc_core/shared_ptr.h"
 #include "roc_core/stddefs.h"
 #include "roc_core/thread.h"
 #include "roc_core/ticker.h"
 #include "roc_core/time.h"
 #include "roc_ctl/control_task_executor.h"
 #include "roc_ctl/control_task_queue.h"
+#include "roc_pipeline/frame_prefetcher.h"
 #include "roc_pipeline/pipeline_loop.h"
+#include "roc_pipeline/prefetch_worker_pool.h"
 
 #include <benchmark/benchmark.h>
 
@@ -46,6 +53,8 @@ namespace {
 // Bench_NoTasks         - frames without tasks
 // Bench_NoPreciseSched  - frames and tasks, precise task scheduling is disabled
 // Bench_Normal          - frames and tasks, precise task scheduling is enabled
+// Bench_MultiSession    - frames and tasks, frame is mixed from multiple sessions,
+//                         which are read sequentially or by worker pool
 //
 // The first benchmark gives us an idea how the unloaded pipeline operates and
 // what are its normal frame processing timings.
@@ -65,6 +74,14 @@ namespace {
 //    cancellations (sc)
 //  - task processing time (t_avg t_p95) is slightly increased
 //
+// The fourth benchmark emulates receiver with many remote senders, where each
+// session has its own computation time, and in sum they take longer than frame
+// duration. It is parameterized by number of sessions and number of workers in
+// PrefetchWorkerPool (0 means that sessions are read sequentially by mixer).
+// When sessions are read sequentially, frame processing time exceeds frame
+// duration and frames are delayed (fb_avg, fb_p95). With enough workers, frame
+// processing time drops roughly proportionally to the number of threads.
+//
 // --------------
 // Output columns
 // --------------
@@ -109,6 +126,9 @@ enum {
 // computation time of a frame
 const core::nanoseconds_t FrameProcessingDuration = 3 * core::Millisecond;
 
+// computation time of one session in multi-session benchmark
+const core::nanoseconds_t SessionProcessingDuration = core::Millisecond;
+
 // computation time of a task
 const core::nanoseconds_t MinTaskProcessingDuration = 5 * core::Microsecond;
 const core::nanoseconds_t MaxTaskProcessingDuration = 15 * core::Microsecond;
@@ -252,6 +272,96 @@ private:
     Counter frame_delay_after_processing_;
 };
 
+audio::SampleSpec make_sample_spec() {
+    return audio::SampleSpec(SampleRate, audio::PcmSubformat_Raw,
+                             audio::ChanLayout_Surround, audio::ChanOrder_Smpte, Chans);
+}
+
+// Emulates session pipeline with heavy processing.
+class TestSession : public audio::IFrameReader {
+public:
+    virtual status::StatusCode read(audio::Frame& frame,
+                                    packet::stream_timestamp_t duration,
+                                    audio::FrameReadMode mode) {
+        if (!frame_factory.reallocate_frame(frame,
+                                            duration * sizeof(audio::sample_t))) {
+            return status::StatusNoMem;
+        }
+
+        busy_wait(SessionProcessingDuration);
+
+        memset(frame.bytes(), 0, duration * sizeof(audio::sample_t));
+
+        frame.set_raw(true);
+        frame.set_duration(duration);
+
+        return status::StatusOK;
+    }
+};
+
+// Emulates session group, which mixes sessions, optionally prefetched
+// in parallel by worker pool.
+class TestSessionGroup : public core::NonCopyable<> {
+public:
+    enum { MaxSessions = 16 };
+
+    TestSessionGroup(size_t num_sessions, size_t num_workers)
+        : mixer_(make_sample_spec(), false, frame_factory, arena)
+        , num_sessions_(num_sessions) {
+        roc_panic_if(num_sessions > MaxSessions);
+        roc_panic_if(mixer_.init_status() != status::StatusOK);
+
+        if (num_workers != 0) {
+            worker_pool_.reset(new (worker_pool_) PrefetchWorkerPool(num_workers, arena));
+            roc_panic_if(worker_pool_->init_status() != status::StatusOK);
+        }
+
+        for (size_t n = 0; n < num_sessions_; n++) {
+            if (worker_pool_) {
+                prefetchers_[n] = new (arena) FramePrefetcher(
+                    sessions_[n], make_sample_spec(), frame_factory, arena);
+                roc_panic_if(!prefetchers_[n]);
+                roc_panic_if(prefetchers_[n]->init_status() != status::StatusOK);
+
+                roc_panic_if(worker_pool_->add_prefetcher(*prefetchers_[n])
+                             != status::StatusOK);
+                roc_panic_if(mixer_.add_input(*prefetchers_[n]) != status::StatusOK);
+            } else {
+                roc_panic_if(mixer_.add_input(sessions_[n]) != status::StatusOK);
+            }
+        }
+    }
+
+    ~TestSessionGroup() {
+        for (size_t n = 0; n < num_sessions_; n++) {
+            if (worker_pool_) {
+                worker_pool_->remove_prefetcher(*prefetchers_[n]);
+                mixer_.remove_input(*prefetchers_[n]);
+            } else {
+                mixer_.remove_input(sessions_[n]);
+            }
+        }
+    }
+
+    status::StatusCode read(audio::Frame& frame,
+                            packet::stream_timestamp_t duration,
+                            audio::FrameReadMode mode) {
+        if (worker_pool_) {
+            worker_pool_->prefetch(duration, mode);
+        }
+        return mixer_.read(frame, duration, mode);
+    }
+
+private:
+    audio::Mixer mixer_;
+
+    TestSession sessions_[MaxSessions];
+    core::SharedPtr<FramePrefetcher> prefetchers_[MaxSessions];
+    size_t num_sessions_;
+
+    core::Optional<PrefetchWorkerPool> worker_pool_;
+};
+
 class TestPipeline : public PipelineLoop,
                      public IPipelineTaskCompleter,
                      private IPipelineTaskScheduler,
@@ -277,18 +387,16 @@ public:
 
     TestPipeline(const PipelineLoopConfig& config,
                  ctl::ControlTaskQueue& control_queue,
-                 DelayStats& stats)
+                 DelayStats& stats,
+                 TestSessionGroup* session_group = NULL)
         : PipelineLoop(*this,
                        config,
-                       audio::SampleSpec(SampleRate,
-                                         audio::PcmSubformat_Raw,
-                                         audio::ChanLayout_Surround,
-                                         audio::ChanOrder_Smpte,
-                                         Chans),
+                       make_sample_spec(),
                        frame_pool,
                        frame_buffer_pool,
                        Dir_WriteFrames)
         , stats_(stats)
+        , session_group_(session_group)
         , control_queue_(control_queue)
         , control_task_(*this) {
     }
@@ -349,10 +457,15 @@ private:
     virtual status::StatusCode process_subframe_imp(audio::Frame& frame,
                                                     packet::stream_timestamp_t duration,
                                                     audio::FrameReadMode mode) {
+        status::StatusCode code = status::StatusOK;
         stats_.frame_processing_started();
-        busy_wait(FrameProcessingDuration);
+        if (session_group_) {
+            code = session_group_->read(frame, duration, mode);
+        } else {
+            busy_wait(FrameProcessingDuration);
+        }
         stats_.frame_processing_finished();
-        return status::StatusOK;
+        return code;
     }
 
     virtual bool process_task_imp(PipelineTask& basic_task) {
@@ -377,6 +490,7 @@ private:
     }
 
     DelayStats& stats_;
+    TestSessionGroup* session_group_;
 
     ctl::ControlTaskQueue& control_queue_;
     BackgroundProcessingTask control_task_;
@@ -534,6 +648,40 @@ BENCHMARK(BM_PipelinePeakLoad_PreciseSchedOn)
     ->UseRealTime()
     ->Unit(benchmark::kMicrosecond);
 
+void BM_PipelinePeakLoad_MultiSession(benchmark::State& state) {
+    ctl::ControlTaskQueue control_queue;
+
+    DelayStats stats;
+
+    TestSessionGroup session_group((size_t)state.range(0), (size_t)state.range(1));
+
+    PipelineLoopConfig config;
+    config.enable_precise_task_scheduling = true;
+
+    TestPipeline pipeline(config, control_queue, stats, &session_group);
+
+    TaskThread task_thr(pipeline);
+
+    FrameWriter frame_wr(pipeline, stats, state);
+
+    (void)task_thr.start();
+
+    frame_wr.run();
+
+    task_thr.stop();
+    task_thr.join();
+
+    stats.export_counters(state);
+    pipeline.export_counters(state);
+}
+
+BENCHMARK(BM_PipelinePeakLoad_MultiSession)
+    ->ArgNames({ "sessions", "workers" })
+    ->ArgsProduct({ { 8 }, { 0, 1, 3, 7 } })
+    ->Iterations(NumIterations)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
 } // namespace
 } // namespace pipeline
 } // namespace roc
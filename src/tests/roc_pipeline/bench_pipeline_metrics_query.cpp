@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_core/atomic.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/thread.h"
+#include "roc_ctl/control_task_executor.h"
+#include "roc_ctl/control_task_queue.h"
+#include "roc_pipeline/receiver_loop.h"
+#include "roc_rtp/encoding_map.h"
+
+namespace roc {
+namespace pipeline {
+namespace {
+
+// This benchmark compares two ways of querying receiver slot metrics from
+// a foreign thread:
+//
+//  - Task: schedule QuerySlot task and wait until pipeline executes it
+//  - Snapshot: read last metrics published by pipeline via seqlock
+//
+// QueryCost measures the cost of a single query while pipeline thread
+// is busy reading frames.
+//
+// FrameCost measures the cost of reading a frame while another thread
+// polls metrics non-stop, i.e. how much querying disturbs frame timing.
+
+enum {
+    MaxBufSize = 4000,
+    FrameSize = 441, // 10ms at 44100Hz
+    NumParties = 4
+};
+
+enum QueryMode { Query_None, Query_Task, Query_Snapshot };
+
+core::HeapArena arena;
+
+core::SlabPool<packet::Packet> packet_pool("packet_pool", arena);
+core::SlabPool<core::Buffer>
+    packet_buffer_pool("packet_buffer_pool", arena, sizeof(core::Buffer) + MaxBufSize);
+
+core::SlabPool<audio::Frame> frame_pool("frame_pool", arena);
+core::SlabPool<core::Buffer>
+    frame_buffer_pool("frame_buffer_pool",
+                      arena,
+                      sizeof(core::Buffer) + MaxBufSize * sizeof(audio::sample_t));
+
+audio::FrameFactory frame_factory(frame_pool, frame_buffer_pool);
+
+audio::ProcessorMap processor_map(arena);
+rtp::EncodingMap encoding_map(arena);
+
+class BenchScheduler : public IPipelineTaskScheduler,
+                       public ctl::ControlTaskExecutor<BenchScheduler> {
+public:
+    BenchScheduler()
+        : pipeline_(NULL)
+        , task_(*this) {
+    }
+
+    ~BenchScheduler() {
+        queue_.async_cancel(task_);
+        queue_.wait(task_);
+    }
+
+    virtual void schedule_task_processing(PipelineLoop& pipeline,
+                                          core::nanoseconds_t deadline) {
+        core::Mutex::Lock lock(mutex_);
+        pipeline_ = &pipeline;
+        queue_.schedule_at(task_, deadline, *this, NULL);
+    }
+
+    virtual void cancel_task_processing(PipelineLoop&) {
+        queue_.async_cancel(task_);
+    }
+
+private:
+    struct ProcessingTask : ctl::ControlTask {
+        ProcessingTask(BenchScheduler& s)
+            : ControlTask(&BenchScheduler::do_processing_)
+            , scheduler(s) {
+        }
+
+        BenchScheduler& scheduler;
+    };
+
+    ctl::ControlTaskResult do_processing_(ctl::ControlTask&) {
+        PipelineLoop* pipeline = NULL;
+        {
+            core::Mutex::Lock lock(mutex_);
+            pipeline = pipeline_;
+        }
+        pipeline->process_tasks();
+        return ctl::ControlTaskSuccess;
+    }
+
+    core::Mutex mutex_;
+    PipelineLoop* pipeline_;
+
+    ctl::ControlTaskQueue queue_;
+    ProcessingTask task_;
+};
+
+class Querier {
+public:
+    Querier(ReceiverLoop& receiver, ReceiverLoop::SlotHandle slot)
+        : receiver_(receiver)
+        , slot_(slot) {
+    }
+
+    bool query(QueryMode mode) {
+        size_t party_count = NumParties;
+
+        switch (mode) {
+        case Query_Task: {
+            ReceiverLoop::Tasks::QuerySlot task(slot_, slot_metrics_, party_metrics_,
+                                                &party_count);
+            return receiver_.schedule_and_wait(task);
+        }
+        case Query_Snapshot:
+            return receiver_.read_slot_metrics(slot_, slot_metrics_, party_metrics_,
+                                               &party_count);
+        case Query_None:
+            break;
+        }
+
+        return true;
+    }
+
+private:
+    ReceiverLoop& receiver_;
+    ReceiverLoop::SlotHandle slot_;
+
+    ReceiverSlotMetrics slot_metrics_;
+    ReceiverParticipantMetrics party_metrics_[NumParties];
+};
+
+class FrameThread : public core::Thread {
+public:
+    FrameThread(ReceiverLoop& receiver)
+        : receiver_(receiver)
+        , stop_(0) {
+    }
+
+    void stop() {
+        stop_ = 1;
+        join();
+    }
+
+private:
+    virtual void run() {
+        audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+        while (!stop_) {
+            roc_panic_if(receiver_.source().read(*frame, FrameSize, audio::ModeHard)
+                         != status::StatusOK);
+        }
+    }
+
+    ReceiverLoop& receiver_;
+    core::Atomic<int> stop_;
+};
+
+class QueryThread : public core::Thread {
+public:
+    QueryThread(Querier& querier, QueryMode mode)
+        : querier_(querier)
+        , mode_(mode)
+        , stop_(0) {
+    }
+
+    void stop() {
+        stop_ = 1;
+        join();
+    }
+
+private:
+    virtual void run() {
+        while (!stop_) {
+            querier_.query(mode_);
+        }
+    }
+
+    Querier& querier_;
+    QueryMode mode_;
+    core::Atomic<int> stop_;
+};
+
+struct BM_MetricsQuery : benchmark::Fixture {
+    BenchScheduler scheduler;
+
+    core::Optional<ReceiverLoop> receiver;
+    ReceiverLoop::SlotHandle slot;
+
+    void SetUp(benchmark::State&) {
+        ReceiverSourceConfig config;
+        config.common.enable_metrics_snapshots = true;
+
+        receiver.reset(new (receiver)
+                           ReceiverLoop(scheduler, config, processor_map, encoding_map,
+                                        packet_pool, packet_buffer_pool, frame_pool,
+                                        frame_buffer_pool, arena));
+        roc_panic_if(receiver->init_status() != status::StatusOK);
+
+        ReceiverSlotConfig slot_config;
+        ReceiverLoop::Tasks::CreateSlot task(slot_config);
+        roc_panic_if(!receiver->schedule_and_wait(task));
+        slot = task.get_handle();
+    }
+
+    void TearDown(benchmark::State&) {
+        ReceiverLoop::Tasks::DeleteSlot task(slot);
+        roc_panic_if(!receiver->schedule_and_wait(task));
+
+        receiver.reset();
+    }
+};
+
+BENCHMARK_DEFINE_F(BM_MetricsQuery, QueryCost)(benchmark::State& state) {
+    const QueryMode mode = (QueryMode)state.range(0);
+
+    FrameThread frame_thread(*receiver);
+    roc_panic_if(!frame_thread.start());
+
+    Querier querier(*receiver, slot);
+    size_t n_failed = 0;
+
+    while (state.KeepRunning()) {
+        if (!querier.query(mode)) {
+            n_failed++;
+        }
+    }
+
+    frame_thread.stop();
+
+    state.counters["failed"] = (double)n_failed;
+}
+
+BENCHMARK_REGISTER_F(BM_MetricsQuery, QueryCost)
+    ->ArgName("mode")
+    ->Arg(Query_Task)
+    ->Arg(Query_Snapshot)
+    ->UseRealTime()
+    ->Unit(benchmark::kNanosecond);
+
+BENCHMARK_DEFINE_F(BM_MetricsQuery, FrameCost)(benchmark::State& state) {
+    const QueryMode mode = (QueryMode)state.range(0);
+
+    Querier querier(*receiver, slot);
+
+    QueryThread query_thread(querier, mode);
+    roc_panic_if(!query_thread.start());
+
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+
+    while (state.KeepRunning()) {
+        roc_panic_if(receiver->source().read(*frame, FrameSize, audio::ModeHard)
+                     != status::StatusOK);
+    }
+
+    query_thread.stop();
+}
+
+BENCHMARK_REGISTER_F(BM_MetricsQuery, FrameCost)
+    ->ArgName("mode")
+    ->Arg(Query_None)
+    ->Arg(Query_Task)
+    ->Arg(Query_Snapshot)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace pipeline
+} // namespace roc
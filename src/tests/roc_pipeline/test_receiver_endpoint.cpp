@@ -7,12 +7,14 @@
  */
 
 #include "test_harness.h"
+#include "test_helpers/packet_writer.h"
 
 #include "roc_address/protocol.h"
 #include "roc_audio/mixer.h"
 #include "roc_audio/sample.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/noop_arena.h"
+#include "roc_packet/fifo_queue.h"
 #include "roc_pipeline/config.h"
 #include "roc_pipeline/receiver_endpoint.h"
 #include "roc_pipeline/receiver_session_group.h"
@@ -32,6 +34,42 @@ audio::FrameFactory frame_factory(arena, PacketSz * sizeof(audio::sample_t));
 audio::ProcessorMap processor_map(arena);
 rtp::EncodingMap encoding_map(arena);
 
+// Arena that fails given number of allocations, then succeeds.
+class FailingArena : public core::IArena, public core::NonCopyable<> {
+public:
+    FailingArena()
+        : n_fails_(0) {
+    }
+
+    virtual void* allocate(size_t size) {
+        if (n_fails_ > 0) {
+            n_fails_--;
+            return NULL;
+        }
+        return ha_.allocate(size);
+    }
+
+    virtual void deallocate(void* ptr) {
+        ha_.deallocate(ptr);
+    }
+
+    virtual size_t compute_allocated_size(size_t size) const {
+        return ha_.compute_allocated_size(size);
+    }
+
+    virtual size_t allocated_size(void* ptr) const {
+        return ha_.allocated_size(ptr);
+    }
+
+    void fail_next(size_t n_fails) {
+        n_fails_ = n_fails;
+    }
+
+private:
+    core::HeapArena ha_;
+    size_t n_fails_;
+};
+
 } // namespace
 
 TEST_GROUP(receiver_endpoint) {};
@@ -44,10 +82,10 @@ TEST(receiver_endpoint, valid) {
     ReceiverSlotConfig slot_config;
     ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
                                        processor_map, encoding_map, packet_factory,
-                                       frame_factory, arena, NULL);
+                                       frame_factory, arena, NULL, NULL, NULL);
 
     ReceiverEndpoint endpoint(address::Proto_RTP, state_tracker, session_group,
-                              encoding_map, address::SocketAddr(), NULL, arena);
+                              encoding_map, address::SocketAddr(), NULL, NULL, arena);
     LONGS_EQUAL(status::StatusOK, endpoint.init_status());
 }
 
@@ -59,13 +97,125 @@ TEST(receiver_endpoint, invalid_proto) {
     ReceiverSlotConfig slot_config;
     ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
                                        processor_map, encoding_map, packet_factory,
-                                       frame_factory, arena, NULL);
+                                       frame_factory, arena, NULL, NULL, NULL);
 
     ReceiverEndpoint endpoint(address::Proto_None, state_tracker, session_group,
-                              encoding_map, address::SocketAddr(), NULL, arena);
+                              encoding_map, address::SocketAddr(), NULL, NULL, arena);
     LONGS_EQUAL(status::StatusBadProtocol, endpoint.init_status());
 }
 
+TEST(receiver_endpoint, write_batch) {
+    enum { NumPackets = 100, BatchSize = 10 };
+
+    audio::Mixer mixer(DefaultSampleSpec, false, frame_factory, arena);
+
+    StateTracker state_tracker;
+    ReceiverSourceConfig source_config;
+    ReceiverSlotConfig slot_config;
+    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
+                                       processor_map, encoding_map, packet_factory,
+                                       frame_factory, arena, NULL, NULL, NULL);
+
+    ReceiverEndpoint endpoint(address::Proto_RTP, state_tracker, session_group,
+                              encoding_map, address::SocketAddr(), NULL, NULL, arena);
+    LONGS_EQUAL(status::StatusOK, endpoint.init_status());
+
+    LONGS_EQUAL(sndio::DeviceState_Idle, state_tracker.get_state());
+
+    packet::PacketPtr packets[NumPackets];
+    for (size_t n = 0; n < NumPackets; n++) {
+        // too short to be parsed, will be dropped by endpoint
+        core::Slice<uint8_t> buffer = packet_factory.new_packet_buffer();
+        CHECK(buffer);
+        buffer.reslice(0, 4);
+
+        packets[n] = packet_factory.new_packet();
+        CHECK(packets[n]);
+        packets[n]->set_buffer(buffer);
+    }
+
+    for (size_t n = 0; n < NumPackets; n += BatchSize) {
+        LONGS_EQUAL(status::StatusOK,
+                    endpoint.inbound_writer().write_batch(packets + n, BatchSize));
+    }
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        // referenced by packet and by queue
+        UNSIGNED_LONGS_EQUAL(2, packets[n]->getref());
+    }
+
+    // packets are pending
+    LONGS_EQUAL(sndio::DeviceState_Active, state_tracker.get_state());
+
+    LONGS_EQUAL(status::StatusOK, endpoint.pull_packets(0));
+
+    // packets are pulled and dropped
+    LONGS_EQUAL(sndio::DeviceState_Idle, state_tracker.get_state());
+
+    for (size_t n = 0; n < NumPackets; n++) {
+        UNSIGNED_LONGS_EQUAL(1, packets[n]->getref());
+    }
+}
+
+TEST(receiver_endpoint, batch_error) {
+    enum { SamplesPerPacket = 100 };
+
+    const address::SocketAddr src_addr1 = test::new_address(1);
+    const address::SocketAddr src_addr2 = test::new_address(2);
+    const address::SocketAddr dst_addr = test::new_address(3);
+
+    FailingArena session_arena;
+
+    audio::Mixer mixer(DefaultSampleSpec, false, frame_factory, arena);
+
+    StateTracker state_tracker;
+    ReceiverSourceConfig source_config;
+    source_config.session_defaults.latency.tuner_backend = audio::LatencyTunerBackend_Niq;
+    source_config.session_defaults.latency.tuner_profile =
+        audio::LatencyTunerProfile_Intact;
+    source_config.session_defaults.plc.backend = audio::PlcBackend_None;
+    ReceiverSlotConfig slot_config;
+    ReceiverSessionGroup session_group(source_config, slot_config, state_tracker, mixer,
+                                       processor_map, encoding_map, packet_factory,
+                                       frame_factory, session_arena, NULL, NULL, NULL);
+    LONGS_EQUAL(status::StatusOK, session_group.init_status());
+
+    ReceiverEndpoint endpoint(address::Proto_RTP, state_tracker, session_group,
+                              encoding_map, address::SocketAddr(), NULL, NULL, arena);
+    LONGS_EQUAL(status::StatusOK, endpoint.init_status());
+
+    packet::FifoQueue queue;
+
+    // two senders, each packet will try to create a new session
+    test::PacketWriter packet_writer1(arena, queue, encoding_map, packet_factory, 11,
+                                      src_addr1, dst_addr,
+                                      rtp::PayloadType_L16_Stereo);
+    test::PacketWriter packet_writer2(arena, queue, encoding_map, packet_factory, 22,
+                                      src_addr2, dst_addr,
+                                      rtp::PayloadType_L16_Stereo);
+
+    packet_writer1.write_packets(1, SamplesPerPacket, DefaultSampleSpec);
+    packet_writer2.write_packets(1, SamplesPerPacket, DefaultSampleSpec);
+
+    packet::PacketPtr packets[2];
+    for (size_t n = 0; n < ROC_ARRAY_SIZE(packets); n++) {
+        LONGS_EQUAL(status::StatusOK, queue.read(packets[n], packet::ModeFetch));
+    }
+
+    LONGS_EQUAL(status::StatusOK,
+                endpoint.inbound_writer().write_batch(packets, ROC_ARRAY_SIZE(packets)));
+
+    // creation of first session fails
+    session_arena.fail_next(1);
+
+    // error from first packet is reported, but second packet is still handled
+    LONGS_EQUAL(status::StatusNoMem, endpoint.pull_packets(0));
+    UNSIGNED_LONGS_EQUAL(1, session_group.num_sessions());
+
+    // first packet is dropped
+    UNSIGNED_LONGS_EQUAL(1, packets[0]->getref());
+}
+
 TEST(receiver_endpoint, no_memory) {
     const address::Protocol protos[] = {
         address::Proto_RTP_LDPC_Source,
@@ -82,10 +232,10 @@ TEST(receiver_endpoint, no_memory) {
         ReceiverSlotConfig slot_config;
         ReceiverSessionGroup session_group(
             source_config, slot_config, state_tracker, mixer, processor_map, encoding_map,
-            packet_factory, frame_factory, core::NoopArena, NULL);
+            packet_factory, frame_factory, core::NoopArena, NULL, NULL, NULL);
 
         ReceiverEndpoint endpoint(protos[n], state_tracker, session_group, encoding_map,
-                                  address::SocketAddr(), NULL, core::NoopArena);
+                                  address::SocketAddr(), NULL, NULL, core::NoopArena);
         LONGS_EQUAL(status::StatusNoMem, endpoint.init_status());
     }
 }
@@ -170,5 +170,51 @@ TEST(receiver_loop, endpoints_async) {
     scheduler.wait_done();
 }
 
+TEST(receiver_loop, metrics_snapshot) {
+    config.common.enable_metrics_snapshots = true;
+
+    ReceiverLoop receiver(scheduler, config, processor_map, encoding_map, packet_pool,
+                          packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+
+    LONGS_EQUAL(status::StatusOK, receiver.init_status());
+
+    ReceiverLoop::SlotHandle slot = NULL;
+
+    {
+        ReceiverSlotConfig config;
+        ReceiverLoop::Tasks::CreateSlot task(config);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+
+        slot = task.get_handle();
+    }
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics[2];
+    size_t party_count = 2;
+
+    // nothing published until first frame
+    CHECK(!receiver.read_slot_metrics(slot, slot_metrics, party_metrics, &party_count));
+    LONGS_EQUAL(2, party_count);
+
+    {
+        audio::FramePtr frame = frame_factory.allocate_frame(0);
+        CHECK(frame);
+
+        LONGS_EQUAL(status::StatusOK,
+                    receiver.source().read(*frame, MaxBufSize / 4, audio::ModeHard));
+    }
+
+    CHECK(receiver.read_slot_metrics(slot, slot_metrics, party_metrics, &party_count));
+    LONGS_EQUAL(0, slot_metrics.num_participants);
+    LONGS_EQUAL(0, party_count);
+
+    {
+        ReceiverLoop::Tasks::DeleteSlot task(slot);
+        CHECK(receiver.schedule_and_wait(task));
+        CHECK(task.success());
+    }
+}
+
 } // namespace pipeline
 } // namespace roc
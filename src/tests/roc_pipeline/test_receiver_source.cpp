@@ -901,6 +901,55 @@ TEST(receiver_source, two_sessions_overlapping) {
     }
 }
 
+// Sessions are read in parallel by worker pool, and then mixed.
+TEST(receiver_source, two_sessions_worker_pool) {
+    init_with_defaults();
+
+    ReceiverSourceConfig config = make_default_config();
+    config.num_session_workers = 2;
+
+    ReceiverSource receiver(config, processor_map, encoding_map, packet_pool,
+                            packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, receiver.init_status());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    packet::IWriter* endpoint_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer1(arena, *endpoint_writer, encoding_map,
+                                      packet_factory, src_id1, src_addr1, dst_addr1,
+                                      PayloadType_Ch2);
+
+    test::PacketWriter packet_writer2(arena, *endpoint_writer, encoding_map,
+                                      packet_factory, src_id2, src_addr2, dst_addr1,
+                                      PayloadType_Ch2);
+
+    for (size_t np = 0; np < Latency / SamplesPerPacket; np++) {
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            refresh_source(receiver, frame_reader.refresh_ts());
+            frame_reader.read_samples(SamplesPerFrame, 2, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(2, receiver.num_sessions());
+        }
+
+        packet_writer1.write_packets(1, SamplesPerPacket, output_sample_spec);
+        packet_writer2.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    // sessions are removed from worker pool when terminated
+    while (receiver.num_sessions() != 0) {
+        refresh_source(receiver, frame_reader.refresh_ts());
+        frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+    }
+}
+
 TEST(receiver_source, two_sessions_two_endpoints) {
     init_with_defaults();
 
@@ -4202,6 +4251,146 @@ TEST(receiver_source, metrics_e2e_latency) {
     }
 }
 
+// Check per-stage timing metrics.
+TEST(receiver_source, metrics_stage_timing) {
+    init_with_defaults();
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.enable_stage_profiling = true;
+
+    ReceiverSource receiver(config, processor_map, encoding_map, packet_pool,
+                            packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, receiver.init_status());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                output_sample_spec);
+
+    for (size_t np = 0; np < ManyPackets; np++) {
+        for (size_t nf = 0; nf < FramesPerPacket; nf++) {
+            refresh_source(receiver, frame_reader.refresh_ts());
+            frame_reader.read_nonzero_samples(SamplesPerFrame, output_sample_spec);
+        }
+
+        packet_writer.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics;
+    size_t party_metrics_size = 1;
+
+    slot->get_metrics(slot_metrics, &party_metrics, &party_metrics_size);
+    UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+
+    for (size_t n = 0; n < Stage_Max; n++) {
+        const PipelineStage stage = (PipelineStage)n;
+
+        const bool expect_slot_stage = (stage == Stage_Mixer);
+        const bool expect_party_stage = (stage == Stage_Depacketizer
+                                         || stage == Stage_Watchdog
+                                         || stage == Stage_LatencyMonitor);
+
+        CHECK_EQUAL(expect_slot_stage, slot_metrics.stages[n].is_active);
+        CHECK_EQUAL(expect_party_stage, party_metrics.stages[n].is_active);
+
+        const StageMetrics& metrics =
+            expect_slot_stage ? slot_metrics.stages[n] : party_metrics.stages[n];
+
+        if (expect_slot_stage || expect_party_stage) {
+            CHECK(metrics.num_calls >= ManyPackets * FramesPerPacket);
+            CHECK(metrics.p50_time <= metrics.p99_time);
+            CHECK(metrics.p99_time <= metrics.max_time);
+        }
+    }
+}
+
+// Check that metrics snapshot is published once per interval, not every frame.
+TEST(receiver_source, metrics_snapshot_interval) {
+    enum { MaxParties = 10 };
+
+    init_with_defaults();
+
+    ReceiverSourceConfig config = make_default_config();
+    config.common.enable_metrics_snapshots = true;
+    config.common.metrics_snapshot_interval =
+        SamplesPerPacket * core::Second / SampleRate + 1;
+
+    ReceiverSource receiver(config, processor_map, encoding_map, packet_pool,
+                            packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, receiver.init_status());
+
+    ReceiverSlot* slot = create_slot(receiver);
+    CHECK(slot);
+
+    packet::IWriter* endpoint_writer =
+        create_transport_endpoint(slot, address::Iface_AudioSource, proto1, dst_addr1);
+    CHECK(endpoint_writer);
+
+    test::FrameReader frame_reader(receiver, frame_factory);
+
+    test::PacketWriter packet_writer(arena, *endpoint_writer, encoding_map,
+                                     packet_factory, src_id1, src_addr1, dst_addr1,
+                                     PayloadType_Ch2);
+
+    ReceiverSlotMetrics slot_metrics;
+    ReceiverParticipantMetrics party_metrics[MaxParties];
+    size_t party_metrics_size = MaxParties;
+
+    // nothing published until first frame
+    CHECK(!slot->read_metrics(slot_metrics, party_metrics, &party_metrics_size));
+
+    // first frame is published immediately
+    refresh_source(receiver, frame_reader.refresh_ts());
+    frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+
+    party_metrics_size = MaxParties;
+    CHECK(slot->read_metrics(slot_metrics, party_metrics, &party_metrics_size));
+    UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+    UNSIGNED_LONGS_EQUAL(0, party_metrics_size);
+
+    packet_writer.write_packets(Latency / SamplesPerPacket, SamplesPerPacket,
+                                output_sample_spec);
+
+    for (size_t n_pass = 0; n_pass < ManyPackets; n_pass++) {
+        // session exists, but snapshot is not updated until interval elapses
+        for (size_t nf = 0; nf < FramesPerPacket - 1; nf++) {
+            refresh_source(receiver, frame_reader.refresh_ts());
+            frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+
+            UNSIGNED_LONGS_EQUAL(1, receiver.num_sessions());
+
+            party_metrics_size = MaxParties;
+            CHECK(slot->read_metrics(slot_metrics, party_metrics, &party_metrics_size));
+            if (n_pass == 0) {
+                UNSIGNED_LONGS_EQUAL(0, slot_metrics.num_participants);
+            }
+        }
+
+        // interval elapses on last frame of packet
+        refresh_source(receiver, frame_reader.refresh_ts());
+        frame_reader.read_any_samples(SamplesPerFrame, output_sample_spec);
+
+        party_metrics_size = MaxParties;
+        CHECK(slot->read_metrics(slot_metrics, party_metrics, &party_metrics_size));
+        UNSIGNED_LONGS_EQUAL(1, slot_metrics.num_participants);
+        UNSIGNED_LONGS_EQUAL(1, party_metrics_size);
+
+        packet_writer.write_packets(1, SamplesPerPacket, output_sample_spec);
+    }
+}
+
 // Check that no reports are generated by receiver when there are no senders.
 TEST(receiver_source, reports_no_senders) {
     init_with_defaults();
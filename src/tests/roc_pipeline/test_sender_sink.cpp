@@ -15,6 +15,7 @@
 #include "roc_core/heap_arena.h"
 #include "roc_core/slab_pool.h"
 #include "roc_core/time.h"
+#include "roc_fec/codec_map.h"
 #include "roc_packet/fifo_queue.h"
 #include "roc_pipeline/sender_sink.h"
 #include "roc_rtp/encoding_map.h"
@@ -951,5 +952,196 @@ TEST(sender_sink, reports_two_receivers) {
     }
 }
 
+// Two slots with identical protocols share encoding pipeline.
+// Both get the same packets, each with its own destination address.
+TEST(sender_sink, shared_encoding) {
+    init_with_defaults();
+
+    packet::FifoQueue queue1;
+    packet::FifoQueue queue2;
+
+    SenderSinkConfig config = make_config();
+    config.enable_shared_encoding = true;
+
+    SenderSink sender(config, processor_map, encoding_map, packet_pool,
+                      packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, sender.init_status());
+
+    SenderSlot* slot1 = create_slot(sender);
+    create_transport_endpoint(slot1, address::Iface_AudioSource, proto, dst_addr1,
+                              queue1);
+
+    SenderSlot* slot2 = create_slot(sender);
+    create_transport_endpoint(slot2, address::Iface_AudioSource, proto, dst_addr2,
+                              queue2);
+
+    LONGS_EQUAL(2, sender.num_sessions());
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        refresh_sink(sender, frame_writer.refresh_ts());
+    }
+
+    LONGS_EQUAL(ManyFrames / FramesPerPacket, queue1.size());
+    LONGS_EQUAL(ManyFrames / FramesPerPacket, queue2.size());
+
+    {
+        SenderSlotMetrics slot_metrics1;
+        SenderSlotMetrics slot_metrics2;
+        slot1->get_metrics(slot_metrics1, NULL, NULL);
+        slot2->get_metrics(slot_metrics2, NULL, NULL);
+
+        CHECK(slot_metrics1.is_complete);
+        CHECK(slot_metrics2.is_complete);
+
+        LONGS_EQUAL(slot_metrics1.source_id, slot_metrics2.source_id);
+
+        LONGS_EQUAL(2, slot_metrics1.shared_encoding_slots);
+        LONGS_EQUAL(2, slot_metrics2.shared_encoding_slots);
+
+        LONGS_EQUAL(ManyFrames / FramesPerPacket, slot_metrics1.shared_packet_copies);
+    }
+
+    for (size_t np = 0; np < ManyFrames / FramesPerPacket; np++) {
+        packet::PacketPtr pp1;
+        packet::PacketPtr pp2;
+        LONGS_EQUAL(status::StatusOK, queue1.read(pp1, packet::ModeFetch));
+        LONGS_EQUAL(status::StatusOK, queue2.read(pp2, packet::ModeFetch));
+
+        CHECK(pp1 != pp2);
+        CHECK(pp1->udp()->dst_addr == dst_addr1);
+        CHECK(pp2->udp()->dst_addr == dst_addr2);
+
+        // Buffer is shared, not copied.
+        CHECK(pp1->buffer().data() == pp2->buffer().data());
+        LONGS_EQUAL(pp1->buffer().size(), pp2->buffer().size());
+    }
+
+    sender.delete_slot(slot1);
+
+    LONGS_EQUAL(1, sender.num_sessions());
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        refresh_sink(sender, frame_writer.refresh_ts());
+    }
+
+    LONGS_EQUAL(0, queue1.size());
+    LONGS_EQUAL(ManyFrames / FramesPerPacket, queue2.size());
+
+    {
+        SenderSlotMetrics slot_metrics;
+        slot2->get_metrics(slot_metrics, NULL, NULL);
+
+        LONGS_EQUAL(1, slot_metrics.shared_encoding_slots);
+    }
+}
+
+// Slots with FEC share both source and repair packets.
+TEST(sender_sink, shared_encoding_fec) {
+    if (!fec::CodecMap::instance().has_scheme(packet::FEC_ReedSolomon_M8)) {
+        return;
+    }
+
+    enum { SourcePackets = 10, RepairPackets = 5 };
+
+    init_with_defaults();
+
+    packet::FifoQueue source_queue1;
+    packet::FifoQueue repair_queue1;
+    packet::FifoQueue source_queue2;
+    packet::FifoQueue repair_queue2;
+
+    SenderSinkConfig config = make_config();
+    config.enable_shared_encoding = true;
+    config.fec_encoder.scheme = packet::FEC_ReedSolomon_M8;
+    config.fec_writer.n_source_packets = SourcePackets;
+    config.fec_writer.n_repair_packets = RepairPackets;
+
+    SenderSink sender(config, processor_map, encoding_map, packet_pool,
+                      packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, sender.init_status());
+
+    SenderSlot* slot1 = create_slot(sender);
+    create_transport_endpoint(slot1, address::Iface_AudioSource,
+                              address::Proto_RTP_RS8M_Source, dst_addr1, source_queue1);
+    create_transport_endpoint(slot1, address::Iface_AudioRepair,
+                              address::Proto_RS8M_Repair, dst_addr1, repair_queue1);
+
+    SenderSlot* slot2 = create_slot(sender);
+    create_transport_endpoint(slot2, address::Iface_AudioSource,
+                              address::Proto_RTP_RS8M_Source, dst_addr2, source_queue2);
+    create_transport_endpoint(slot2, address::Iface_AudioRepair,
+                              address::Proto_RS8M_Repair, dst_addr2, repair_queue2);
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        refresh_sink(sender, frame_writer.refresh_ts());
+    }
+
+    const size_t n_source = ManyFrames / FramesPerPacket;
+    const size_t n_repair = n_source / SourcePackets * RepairPackets;
+
+    LONGS_EQUAL(n_source, source_queue1.size());
+    LONGS_EQUAL(n_source, source_queue2.size());
+    LONGS_EQUAL(n_repair, repair_queue1.size());
+    LONGS_EQUAL(n_repair, repair_queue2.size());
+
+    SenderSlotMetrics slot_metrics;
+    slot2->get_metrics(slot_metrics, NULL, NULL);
+
+    LONGS_EQUAL(2, slot_metrics.shared_encoding_slots);
+    LONGS_EQUAL(n_source + n_repair, slot_metrics.shared_packet_copies);
+}
+
+// Shared encoding is not used with adaptive FEC, since every slot
+// should adjust its own FEC block size.
+TEST(sender_sink, shared_encoding_adaptive_fec) {
+    init_with_defaults();
+
+    packet::FifoQueue queue1;
+    packet::FifoQueue queue2;
+
+    SenderSinkConfig config = make_config();
+    config.enable_shared_encoding = true;
+    config.enable_adaptive_fec = true;
+
+    SenderSink sender(config, processor_map, encoding_map, packet_pool,
+                      packet_buffer_pool, frame_pool, frame_buffer_pool, arena);
+    LONGS_EQUAL(status::StatusOK, sender.init_status());
+
+    SenderSlot* slot1 = create_slot(sender);
+    create_transport_endpoint(slot1, address::Iface_AudioSource, proto, dst_addr1,
+                              queue1);
+
+    SenderSlot* slot2 = create_slot(sender);
+    create_transport_endpoint(slot2, address::Iface_AudioSource, proto, dst_addr2,
+                              queue2);
+
+    test::FrameWriter frame_writer(sender, frame_factory);
+
+    for (size_t nf = 0; nf < ManyFrames; nf++) {
+        frame_writer.write_samples(SamplesPerFrame, input_sample_spec);
+        refresh_sink(sender, frame_writer.refresh_ts());
+    }
+
+    LONGS_EQUAL(ManyFrames / FramesPerPacket, queue1.size());
+    LONGS_EQUAL(ManyFrames / FramesPerPacket, queue2.size());
+
+    SenderSlotMetrics slot_metrics1;
+    SenderSlotMetrics slot_metrics2;
+    slot1->get_metrics(slot_metrics1, NULL, NULL);
+    slot2->get_metrics(slot_metrics2, NULL, NULL);
+
+    CHECK(slot_metrics1.source_id != slot_metrics2.source_id);
+
+    LONGS_EQUAL(0, slot_metrics1.shared_encoding_slots);
+    LONGS_EQUAL(0, slot_metrics2.shared_encoding_slots);
+}
+
 } // namespace pipeline
 } // namespace roc
@@ -62,10 +62,12 @@ TEST_GROUP(session_router) {
 
             sess1 = new (arena)
                 ReceiverSession(session_config, common_config, processor_map,
-                                encoding_map, packet_factory, frame_factory, arena, NULL);
+                                encoding_map, packet_factory, frame_factory, arena, NULL,
+                                NULL);
             sess2 = new (arena)
                 ReceiverSession(session_config, common_config, processor_map,
-                                encoding_map, packet_factory, frame_factory, arena, NULL);
+                                encoding_map, packet_factory, frame_factory, arena, NULL,
+                                NULL);
         }
     }
 };
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "test_harness.h"
+
+#include "roc_audio/frame_factory.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/noop_arena.h"
+#include "roc_core/time.h"
+#include "roc_pipeline/stage_profiler.h"
+#include "roc_pipeline/stage_reader.h"
+#include "roc_pipeline/stage_writer.h"
+
+namespace roc {
+namespace pipeline {
+
+namespace {
+
+const core::nanoseconds_t SleepTime = core::Millisecond * 2;
+
+core::HeapArena arena;
+
+StageProfilerConfig make_config() {
+    StageProfilerConfig config;
+    config.window_length = 10;
+    config.histogram_range = core::Second;
+    config.histogram_bins = 1000;
+    return config;
+}
+
+// Frame reader that sleeps for given time on every read.
+class SleepingReader : public audio::IFrameReader, public core::NonCopyable<> {
+public:
+    SleepingReader(core::nanoseconds_t sleep_time)
+        : sleep_time_(sleep_time) {
+    }
+
+    virtual status::StatusCode
+    read(audio::Frame& frame, packet::stream_timestamp_t, audio::FrameReadMode) {
+        core::sleep_for(core::ClockMonotonic, sleep_time_);
+        return status::StatusOK;
+    }
+
+private:
+    const core::nanoseconds_t sleep_time_;
+};
+
+// Frame writer that sleeps for given time on every write.
+class SleepingWriter : public audio::IFrameWriter, public core::NonCopyable<> {
+public:
+    SleepingWriter(core::nanoseconds_t sleep_time)
+        : sleep_time_(sleep_time) {
+    }
+
+    virtual status::StatusCode write(audio::Frame&) {
+        core::sleep_for(core::ClockMonotonic, sleep_time_);
+        return status::StatusOK;
+    }
+
+private:
+    const core::nanoseconds_t sleep_time_;
+};
+
+} // namespace
+
+TEST_GROUP(stage_profiler) {};
+
+TEST(stage_profiler, bad_config) {
+    StageProfilerConfig config = make_config();
+    config.window_length = 0;
+
+    StageProfiler profiler(config, NULL, arena);
+    LONGS_EQUAL(status::StatusBadConfig, profiler.init_status());
+}
+
+TEST(stage_profiler, no_memory) {
+    StageProfiler profiler(make_config(), NULL, core::NoopArena);
+    LONGS_EQUAL(status::StatusOK, profiler.init_status());
+
+    LONGS_EQUAL(status::StatusNoMem, profiler.add_stage(Stage_Resampler));
+    CHECK(!profiler.get_metrics(Stage_Resampler).is_active);
+}
+
+TEST(stage_profiler, inactive_stages) {
+    StageProfiler profiler(make_config(), NULL, arena);
+    LONGS_EQUAL(status::StatusOK, profiler.init_status());
+
+    LONGS_EQUAL(status::StatusOK, profiler.add_stage(Stage_Resampler));
+
+    for (size_t n = 0; n < Stage_Max; n++) {
+        const StageMetrics metrics = profiler.get_metrics((PipelineStage)n);
+
+        CHECK_EQUAL(n == Stage_Resampler, metrics.is_active);
+        UNSIGNED_LONGS_EQUAL(0, metrics.num_calls);
+        LONGS_EQUAL(0, metrics.p50_time);
+        LONGS_EQUAL(0, metrics.p99_time);
+        LONGS_EQUAL(0, metrics.max_time);
+    }
+}
+
+TEST(stage_profiler, single_stage) {
+    enum { NumCalls = 5 };
+
+    StageProfiler profiler(make_config(), NULL, arena);
+    LONGS_EQUAL(status::StatusOK, profiler.init_status());
+
+    SleepingReader inner_reader(SleepTime);
+
+    StageFrameReader stage_reader(inner_reader, profiler, Stage_Depacketizer);
+    LONGS_EQUAL(status::StatusOK, stage_reader.init_status());
+
+    audio::FrameFactory frame_factory(arena, 0);
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    CHECK(frame);
+
+    for (size_t n = 0; n < NumCalls; n++) {
+        LONGS_EQUAL(status::StatusOK, stage_reader.read(*frame, 0, audio::ModeHard));
+    }
+
+    const StageMetrics metrics = profiler.get_metrics(Stage_Depacketizer);
+
+    CHECK(metrics.is_active);
+    UNSIGNED_LONGS_EQUAL(NumCalls, metrics.num_calls);
+
+    CHECK(metrics.p50_time >= SleepTime);
+    CHECK(metrics.p99_time >= metrics.p50_time);
+    CHECK(metrics.max_time >= metrics.p99_time);
+}
+
+// Time of nested stage is excluded from enclosing stage.
+TEST(stage_profiler, nested_stages) {
+    enum { NumCalls = 5 };
+
+    StageProfiler profiler(make_config(), NULL, arena);
+    LONGS_EQUAL(status::StatusOK, profiler.init_status());
+
+    SleepingReader inner_reader(SleepTime);
+
+    StageFrameReader nested_reader(inner_reader, profiler, Stage_Depacketizer);
+    LONGS_EQUAL(status::StatusOK, nested_reader.init_status());
+
+    StageFrameReader outer_reader(nested_reader, profiler, Stage_LatencyMonitor);
+    LONGS_EQUAL(status::StatusOK, outer_reader.init_status());
+
+    audio::FrameFactory frame_factory(arena, 0);
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    CHECK(frame);
+
+    for (size_t n = 0; n < NumCalls; n++) {
+        LONGS_EQUAL(status::StatusOK, outer_reader.read(*frame, 0, audio::ModeHard));
+    }
+
+    const StageMetrics nested_metrics = profiler.get_metrics(Stage_Depacketizer);
+    const StageMetrics outer_metrics = profiler.get_metrics(Stage_LatencyMonitor);
+
+    UNSIGNED_LONGS_EQUAL(NumCalls, nested_metrics.num_calls);
+    UNSIGNED_LONGS_EQUAL(NumCalls, outer_metrics.num_calls);
+
+    CHECK(nested_metrics.p50_time >= SleepTime);
+    CHECK(outer_metrics.p50_time < SleepTime);
+}
+
+// Time of stages of child profiler is excluded from parent's stage.
+TEST(stage_profiler, parent_profiler) {
+    enum { NumCalls = 5 };
+
+    StageProfiler parent_profiler(make_config(), NULL, arena);
+    LONGS_EQUAL(status::StatusOK, parent_profiler.init_status());
+
+    StageProfiler child_profiler(make_config(), &parent_profiler, arena);
+    LONGS_EQUAL(status::StatusOK, child_profiler.init_status());
+
+    SleepingReader inner_reader(SleepTime);
+
+    StageFrameReader child_reader(inner_reader, child_profiler, Stage_Resampler);
+    LONGS_EQUAL(status::StatusOK, child_reader.init_status());
+
+    StageFrameReader parent_reader(child_reader, parent_profiler, Stage_Mixer);
+    LONGS_EQUAL(status::StatusOK, parent_reader.init_status());
+
+    audio::FrameFactory frame_factory(arena, 0);
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    CHECK(frame);
+
+    for (size_t n = 0; n < NumCalls; n++) {
+        LONGS_EQUAL(status::StatusOK, parent_reader.read(*frame, 0, audio::ModeHard));
+    }
+
+    const StageMetrics child_metrics = child_profiler.get_metrics(Stage_Resampler);
+    const StageMetrics parent_metrics = parent_profiler.get_metrics(Stage_Mixer);
+
+    UNSIGNED_LONGS_EQUAL(NumCalls, child_metrics.num_calls);
+    UNSIGNED_LONGS_EQUAL(NumCalls, parent_metrics.num_calls);
+
+    CHECK(child_metrics.p50_time >= SleepTime);
+    CHECK(parent_metrics.p50_time < SleepTime);
+
+    CHECK(!parent_profiler.get_metrics(Stage_Resampler).is_active);
+    CHECK(!child_profiler.get_metrics(Stage_Mixer).is_active);
+}
+
+TEST(stage_profiler, writer) {
+    enum { NumCalls = 5 };
+
+    StageProfiler profiler(make_config(), NULL, arena);
+    LONGS_EQUAL(status::StatusOK, profiler.init_status());
+
+    SleepingWriter inner_writer(SleepTime);
+
+    StageFrameWriter nested_writer(inner_writer, profiler, Stage_Packetizer);
+    LONGS_EQUAL(status::StatusOK, nested_writer.init_status());
+
+    StageFrameWriter outer_writer(nested_writer, profiler, Stage_Resampler);
+    LONGS_EQUAL(status::StatusOK, outer_writer.init_status());
+
+    audio::FrameFactory frame_factory(arena, 0);
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    CHECK(frame);
+
+    for (size_t n = 0; n < NumCalls; n++) {
+        LONGS_EQUAL(status::StatusOK, outer_writer.write(*frame));
+    }
+
+    const StageMetrics nested_metrics = profiler.get_metrics(Stage_Packetizer);
+    const StageMetrics outer_metrics = profiler.get_metrics(Stage_Resampler);
+
+    UNSIGNED_LONGS_EQUAL(NumCalls, nested_metrics.num_calls);
+    UNSIGNED_LONGS_EQUAL(NumCalls, outer_metrics.num_calls);
+
+    CHECK(nested_metrics.p50_time >= SleepTime);
+    CHECK(outer_metrics.p50_time < SleepTime);
+}
+
+// Only recent calls within window are taken into account.
+TEST(stage_profiler, window) {
+    StageProfilerConfig config = make_config();
+    config.window_length = 3;
+
+    StageProfiler profiler(config, NULL, arena);
+    LONGS_EQUAL(status::StatusOK, profiler.init_status());
+
+    LONGS_EQUAL(status::StatusOK, profiler.add_stage(Stage_Plc));
+
+    profiler.begin_call();
+    core::sleep_for(core::ClockMonotonic, SleepTime);
+    profiler.end_call(Stage_Plc);
+
+    CHECK(profiler.get_metrics(Stage_Plc).max_time >= SleepTime);
+
+    for (size_t n = 0; n < config.window_length; n++) {
+        profiler.begin_call();
+        profiler.end_call(Stage_Plc);
+    }
+
+    const StageMetrics metrics = profiler.get_metrics(Stage_Plc);
+
+    UNSIGNED_LONGS_EQUAL(config.window_length + 1, metrics.num_calls);
+    CHECK(metrics.max_time < SleepTime);
+}
+
+} // namespace pipeline
+} // namespace roc
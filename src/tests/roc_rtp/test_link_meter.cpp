@@ -216,6 +216,48 @@ TEST(link_meter, jitter_test) {
     }
 }
 
+TEST(link_meter, jitter_test_blocks) {
+    audio::JitterMeterConfig config = make_config();
+    config.estimator = audio::JitterEstimator_Blocks;
+
+    packet::FifoQueue queue;
+    LinkMeter meter(queue, config, encoding_map, arena, NULL);
+
+    const size_t num_packets = Duration * 100;
+    core::nanoseconds_t ts_store[num_packets];
+
+    core::nanoseconds_t qts = qts_start;
+    packet::stream_timestamp_t sts = sts_start;
+
+    for (size_t i = 0; i < num_packets; i++) {
+        packet::seqnum_t seqnum = 65500 + i;
+        ts_store[i] = qts;
+        UNSIGNED_LONGS_EQUAL(status::StatusOK, meter.write(new_packet(seqnum, qts, sts)));
+        const core::nanoseconds_t jitter_ns =
+            (core::nanoseconds_t)(core::fast_random_gaussian() * core::Millisecond);
+        qts += qts_step + jitter_ns;
+        sts += sts_step;
+
+        if (i > RunningWindowLen) {
+            // Block-based windows slide by blocks, so compare with exact
+            // statistics with larger tolerance.
+            core::nanoseconds_t peak_jitter = 0;
+            core::nanoseconds_t sum = 0;
+            for (size_t j = 0; j < RunningWindowLen; j++) {
+                core::nanoseconds_t jitter =
+                    std::abs(ts_store[i - j] - ts_store[i - j - 1] - qts_step);
+                peak_jitter = std::max(peak_jitter, jitter);
+                sum += jitter;
+            }
+            const core::nanoseconds_t mean = sum / RunningWindowLen;
+
+            DOUBLES_EQUAL(peak_jitter, meter.metrics().peak_jitter,
+                          core::Millisecond * 3);
+            DOUBLES_EQUAL(mean, meter.metrics().mean_jitter, core::Microsecond * 50);
+        }
+    }
+}
+
 TEST(link_meter, ascending_test) {
     packet::FifoQueue queue;
     LinkMeter meter(queue, make_config(), encoding_map, arena, NULL);
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/pcm_subformat.h"
+#include "roc_audio/sample_spec.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/macro_helpers.h"
+#include "roc_core/panic.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_dbgio/temp_file.h"
+#include "roc_sndio/mmap_wav_source.h"
+#include "roc_sndio/wav_sink.h"
+#include "roc_sndio/wav_source.h"
+
+namespace roc {
+namespace sndio {
+namespace {
+
+// Benchmarks:
+//
+//  BM_WavSource/<format>/<impl>
+//   Throughput of reading WAV file from page cache, frame by frame.
+//   When end of file is reached, source is rewound.
+//
+// <format> is an index in Formats array (see label for format name).
+// <impl> is 0 for stdio-based implementation (WavSource), and 1 for
+// memory-mapped implementation (MmapWavSource).
+//
+// Output column "bytes_per_second" reports file bytes processed per second.
+
+enum {
+    SampleRate = 48000,
+    NumChans = 2,
+    FrameSamples = 4096 * NumChans,
+    FileSamples = SampleRate * NumChans * 30,
+    MaxFrameBytes = FrameSamples * 8
+};
+
+const audio::PcmSubformat Formats[] = {
+    audio::PcmSubformat_SInt16,
+    audio::PcmSubformat_Float32,
+};
+
+enum { NumFormats = ROC_ARRAY_SIZE(Formats) };
+
+core::HeapArena arena;
+audio::FrameFactory frame_factory(arena, MaxFrameBytes);
+
+audio::SampleSpec make_spec(audio::Format format, audio::PcmSubformat subformat) {
+    audio::SampleSpec spec;
+    spec.set_format(format);
+    spec.set_pcm_subformat(subformat);
+    spec.set_sample_rate(SampleRate);
+    spec.channel_set().set_layout(audio::ChanLayout_Surround);
+    spec.channel_set().set_order(audio::ChanOrder_Smpte);
+    spec.channel_set().set_mask(audio::ChanMask_Surround_Stereo);
+    return spec;
+}
+
+ISource* open_source(int impl, const char* path) {
+    IoConfig config;
+
+    core::ScopedPtr<ISource> source;
+    status::StatusCode code = status::NoStatus;
+
+    if (impl == 0) {
+        WavSource* wav_source =
+            new (arena) WavSource(frame_factory, arena, config, path);
+        source.reset(wav_source);
+        code = wav_source->init_status();
+    } else {
+        MmapWavSource* mmap_source =
+            new (arena) MmapWavSource(frame_factory, arena, config, path);
+        source.reset(mmap_source);
+        code = mmap_source->init_status();
+    }
+
+    roc_panic_if_msg(code != status::StatusOK, "bench: can't open source");
+
+    return source.hijack();
+}
+
+void write_file(audio::PcmSubformat subformat, const char* path) {
+    IoConfig config;
+    config.sample_spec = make_spec(audio::Format_Wav, subformat);
+
+    core::ScopedPtr<WavSink> sink(
+        new (arena) WavSink(frame_factory, arena, config, path));
+    roc_panic_if_msg(!sink || sink->init_status() != status::StatusOK,
+                     "bench: can't open sink");
+
+    const audio::SampleSpec frame_spec = sink->sample_spec();
+
+    audio::FramePtr frame =
+        frame_factory.allocate_frame(frame_spec.stream_timestamp_2_bytes(
+            packet::stream_timestamp_t(FrameSamples / NumChans)));
+    roc_panic_if(!frame);
+
+    frame->set_raw(frame_spec.is_raw());
+    frame->set_duration(packet::stream_timestamp_t(FrameSamples / NumChans));
+
+    for (size_t n = 0; n < frame->num_bytes(); n++) {
+        frame->bytes()[n] = uint8_t(n * 7);
+    }
+
+    for (size_t n = 0; n < FileSamples; n += FrameSamples) {
+        roc_panic_if(sink->write(*frame) != status::StatusOK);
+    }
+
+    roc_panic_if(sink->close() != status::StatusOK);
+}
+
+void BM_WavSource(benchmark::State& state) {
+    const audio::PcmSubformat subformat = Formats[state.range(0)];
+    const int impl = (int)state.range(1);
+
+    state.SetLabel(audio::pcm_subformat_to_str(subformat));
+
+    dbgio::TempFile file("bench.wav");
+    write_file(subformat, file.path());
+
+    core::ScopedPtr<ISource> source(open_source(impl, file.path()));
+
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    roc_panic_if(!frame);
+
+    const size_t sample_bytes = audio::pcm_subformat_traits(subformat).bit_width / 8;
+
+    size_t total_bytes = 0;
+
+    while (state.KeepRunning()) {
+        status::StatusCode code = source->read(
+            *frame, packet::stream_timestamp_t(FrameSamples / NumChans), audio::ModeHard);
+
+        if (code == status::StatusFinish) {
+            roc_panic_if(source->rewind() != status::StatusOK);
+            continue;
+        }
+
+        roc_panic_if(code != status::StatusOK && code != status::StatusPart);
+
+        total_bytes += frame->num_raw_samples() * sample_bytes;
+    }
+
+    state.SetBytesProcessed(int64_t(total_bytes));
+}
+
+BENCHMARK(BM_WavSource)
+    ->ArgsProduct({ benchmark::CreateDenseRange(0, NumFormats - 1, 1), { 0, 1 } })
+    ->Unit(benchmark::kMicrosecond);
+
+} // namespace
+} // namespace sndio
+} // namespace roc
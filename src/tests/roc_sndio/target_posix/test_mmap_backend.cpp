@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/mock_sink.h"
+#include "test_helpers/mock_source.h"
+#include "test_helpers/utils.h"
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_dbgio/temp_file.h"
+#include "roc_sndio/mmap_backend.h"
+#include "roc_sndio/wav_backend.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { FrameSize = 500, ManySamples = FrameSize * 20 };
+
+const audio::SampleSpec frame_spec(44100,
+                                   audio::PcmSubformat_Raw,
+                                   audio::ChanLayout_Surround,
+                                   audio::ChanOrder_Smpte,
+                                   audio::ChanMask_Surround_Stereo);
+
+const core::nanoseconds_t frame_len = FrameSize * core::Second
+    / core::nanoseconds_t(frame_spec.sample_rate() * frame_spec.num_channels());
+
+core::HeapArena arena;
+audio::FrameFactory frame_factory(arena, FrameSize * sizeof(audio::sample_t));
+
+// Writes raw WAV file using stdio-based backend.
+void write_wav(const char* path, size_t num_samples) {
+    test::MockSource mock_source(frame_spec, frame_factory, arena);
+    mock_source.add(num_samples);
+
+    IoConfig config;
+    config.sample_spec = frame_spec;
+    config.sample_spec.set_format(audio::Format_Wav);
+    config.frame_length = frame_len;
+
+    WavBackend backend;
+
+    core::ScopedPtr<ISink> sink;
+    test::expect_open_sink(status::StatusOK, backend, frame_factory, arena, "file", path,
+                           config, sink);
+
+    for (;;) {
+        audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+        CHECK(frame);
+
+        const status::StatusCode code =
+            mock_source.read(*frame, FrameSize / frame_spec.num_channels(),
+                             audio::ModeHard);
+        if (code == status::StatusFinish) {
+            break;
+        }
+        CHECK(code == status::StatusOK || code == status::StatusPart);
+
+        LONGS_EQUAL(status::StatusOK, sink->write(*frame));
+    }
+
+    LONGS_EQUAL(status::StatusOK, sink->close());
+}
+
+IoConfig make_config() {
+    IoConfig config;
+    config.frame_length = frame_len;
+    config.enable_mmap = true;
+
+    return config;
+}
+
+} // namespace
+
+TEST_GROUP(mmap_backend) {};
+
+// Backend is not used unless enabled in config.
+TEST(mmap_backend, disabled_by_default) {
+    dbgio::TempFile file("test.wav");
+    write_wav(file.path(), ManySamples);
+
+    MmapBackend backend;
+    IoConfig config = make_config();
+    config.enable_mmap = false;
+
+    core::ScopedPtr<ISource> source;
+    test::expect_open_source(status::StatusNoDriver, backend, frame_factory, arena,
+                             "file", file.path(), config, source);
+}
+
+// Sinks are left to other backends.
+TEST(mmap_backend, no_sinks) {
+    dbgio::TempFile file("test.wav");
+
+    MmapBackend backend;
+
+    IoConfig config = make_config();
+    config.sample_spec = frame_spec;
+    config.sample_spec.set_format(audio::Format_Wav);
+
+    core::ScopedPtr<ISink> sink;
+    test::expect_open_sink(status::StatusNoDriver, backend, frame_factory, arena, "file",
+                           file.path(), config, sink);
+}
+
+TEST(mmap_backend, read_and_rewind) {
+    dbgio::TempFile file("test.wav");
+    write_wav(file.path(), ManySamples);
+
+    MmapBackend backend;
+
+    core::ScopedPtr<ISource> source;
+    test::expect_open_source(status::StatusOK, backend, frame_factory, arena, "file",
+                             file.path(), make_config(), source);
+
+    test::expect_specs_equal(backend.name(), frame_spec, source->sample_spec());
+
+    for (int n_pass = 0; n_pass < 2; n_pass++) {
+        test::MockSink mock_sink(arena);
+
+        for (;;) {
+            audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+            CHECK(frame);
+
+            const status::StatusCode code =
+                source->read(*frame, FrameSize / frame_spec.num_channels(),
+                             audio::ModeHard);
+            if (code == status::StatusFinish) {
+                break;
+            }
+            CHECK(code == status::StatusOK || code == status::StatusPart);
+
+            LONGS_EQUAL(status::StatusOK, mock_sink.write(*frame));
+        }
+
+        mock_sink.check(0, ManySamples);
+
+        LONGS_EQUAL(status::StatusOK, source->rewind());
+    }
+
+    LONGS_EQUAL(status::StatusOK, source->close());
+}
+
+TEST(mmap_backend, bad_path) {
+    MmapBackend backend;
+
+    core::ScopedPtr<ISource> source;
+    test::expect_open_source(status::StatusErrFile, backend, frame_factory, arena, "file",
+                             "/bad/file.wav", make_config(), source);
+}
+
+// Not a WAV file, left to other backends.
+TEST(mmap_backend, bad_format) {
+    dbgio::TempFile file("test.wav");
+
+    FILE* fp = fopen(file.path(), "w");
+    CHECK(fp);
+    for (size_t n = 0; n < FrameSize * 10; n++) {
+        fputc('x', fp);
+    }
+    fclose(fp);
+
+    MmapBackend backend;
+
+    core::ScopedPtr<ISource> source;
+    test::expect_open_source(status::StatusNoFormat, backend, frame_factory, arena,
+                             "file", file.path(), make_config(), source);
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/mock_source.h"
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/time.h"
+#include "roc_sndio/pulseaudio_device.h"
+
+// These tests need a running PulseAudio server. They use default sink
+// and source, which is expected to be a null sink and its monitor, e.g.:
+//  pactl load-module module-null-sink sink_name=roc_test
+//  pactl set-default-sink roc_test
+//  pactl set-default-source roc_test.monitor
+// If server is not available, tests do nothing.
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { SampleRate = 44100, FrameSize = 441, NumFrames = 50 };
+
+const audio::SampleSpec frame_spec(SampleRate,
+                                   audio::PcmSubformat_Raw,
+                                   audio::ChanLayout_Surround,
+                                   audio::ChanOrder_Smpte,
+                                   audio::ChanMask_Surround_Stereo);
+
+const core::nanoseconds_t frame_len = FrameSize * core::Second / SampleRate;
+
+core::HeapArena arena;
+audio::FrameFactory frame_factory(arena,
+                                  FrameSize * frame_spec.num_channels()
+                                      * sizeof(audio::sample_t));
+
+IoConfig make_config(bool callback_mode) {
+    IoConfig config;
+    config.sample_spec = frame_spec;
+    config.frame_length = frame_len;
+    config.latency = frame_len * 4;
+    config.callback_mode = callback_mode;
+
+    return config;
+}
+
+// Returns NULL if PulseAudio is not available.
+PulseaudioDevice* open_device(DeviceType type, bool callback_mode) {
+    core::ScopedPtr<PulseaudioDevice> device(new (arena) PulseaudioDevice(
+        frame_factory, arena, make_config(callback_mode), type, "default"));
+    CHECK(device);
+
+    if (device->init_status() != status::StatusOK) {
+        return NULL;
+    }
+
+    return device.hijack();
+}
+
+void write_frames(PulseaudioDevice& device, test::MockSource& mock_source, size_t count) {
+    for (size_t n = 0; n < count; n++) {
+        audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+        CHECK(frame);
+
+        LONGS_EQUAL(status::StatusOK,
+                    mock_source.read(*frame, FrameSize, audio::ModeHard));
+        LONGS_EQUAL(status::StatusOK, device.write(*frame));
+    }
+}
+
+void read_frames(PulseaudioDevice& device, size_t count) {
+    for (size_t n = 0; n < count; n++) {
+        audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+        CHECK(frame);
+
+        LONGS_EQUAL(status::StatusOK, device.read(*frame, FrameSize, audio::ModeHard));
+        LONGS_EQUAL(FrameSize, frame->duration());
+    }
+}
+
+} // namespace
+
+TEST_GROUP(pulseaudio_device) {};
+
+TEST(pulseaudio_device, playback) {
+    for (int cb_mode = 0; cb_mode <= 1; cb_mode++) {
+        core::ScopedPtr<PulseaudioDevice> device(open_device(DeviceType_Sink, cb_mode));
+        if (!device) {
+            return;
+        }
+
+        CHECK(device->to_sink());
+        CHECK(!device->to_source());
+        LONGS_EQUAL(DeviceState_Active, device->state());
+
+        test::MockSource mock_source(frame_spec, frame_factory, arena);
+        mock_source.add(FrameSize * frame_spec.num_channels() * NumFrames);
+
+        write_frames(*device, mock_source, NumFrames);
+        LONGS_EQUAL(status::StatusOK, device->flush());
+
+        const PulseaudioMetrics metrics = device->metrics();
+        CHECK(metrics.stream_latency >= 0);
+        CHECK(metrics.ring_latency >= 0);
+        if (!cb_mode) {
+            LONGS_EQUAL(0, metrics.underrun_count);
+            LONGS_EQUAL(0, metrics.ring_latency);
+        }
+
+        LONGS_EQUAL(0, metrics.overrun_count);
+
+        LONGS_EQUAL(status::StatusOK, device->close());
+    }
+}
+
+TEST(pulseaudio_device, capture) {
+    for (int cb_mode = 0; cb_mode <= 1; cb_mode++) {
+        core::ScopedPtr<PulseaudioDevice> device(
+            open_device(DeviceType_Source, cb_mode));
+        if (!device) {
+            return;
+        }
+
+        CHECK(device->to_source());
+        CHECK(!device->to_sink());
+        LONGS_EQUAL(DeviceState_Active, device->state());
+
+        read_frames(*device, NumFrames);
+
+        const PulseaudioMetrics metrics = device->metrics();
+        CHECK(metrics.stream_latency >= 0);
+        CHECK(metrics.ring_latency >= 0);
+        if (!cb_mode) {
+            LONGS_EQUAL(0, metrics.overrun_count);
+            LONGS_EQUAL(0, metrics.ring_latency);
+        }
+
+        LONGS_EQUAL(0, metrics.underrun_count);
+
+        LONGS_EQUAL(status::StatusOK, device->close());
+    }
+}
+
+// Pause/resume and rewind close and reopen the stream.
+TEST(pulseaudio_device, restart) {
+    for (int cb_mode = 0; cb_mode <= 1; cb_mode++) {
+        core::ScopedPtr<PulseaudioDevice> sink(open_device(DeviceType_Sink, cb_mode));
+        core::ScopedPtr<PulseaudioDevice> source(
+            open_device(DeviceType_Source, cb_mode));
+        if (!sink || !source) {
+            return;
+        }
+
+        test::MockSource mock_source(frame_spec, frame_factory, arena);
+        mock_source.add(FrameSize * frame_spec.num_channels() * NumFrames * 3);
+
+        for (int n_pass = 0; n_pass < 3; n_pass++) {
+            write_frames(*sink, mock_source, NumFrames);
+            read_frames(*source, NumFrames);
+
+            if (n_pass == 0) {
+                LONGS_EQUAL(status::StatusOK, sink->pause());
+                LONGS_EQUAL(status::StatusOK, source->pause());
+
+                LONGS_EQUAL(DeviceState_Paused, sink->state());
+                LONGS_EQUAL(DeviceState_Paused, source->state());
+
+                LONGS_EQUAL(status::StatusOK, sink->resume());
+                LONGS_EQUAL(status::StatusOK, source->resume());
+            } else {
+                LONGS_EQUAL(status::StatusOK, sink->rewind());
+                LONGS_EQUAL(status::StatusOK, source->rewind());
+            }
+
+            LONGS_EQUAL(DeviceState_Active, sink->state());
+            LONGS_EQUAL(DeviceState_Active, source->state());
+        }
+
+        LONGS_EQUAL(status::StatusOK, sink->close());
+        LONGS_EQUAL(status::StatusOK, source->close());
+    }
+}
+
+// Flush publishes partial chunk, so that it's played without waiting
+// for the rest of it.
+TEST(pulseaudio_device, flush) {
+    for (int cb_mode = 0; cb_mode <= 1; cb_mode++) {
+        core::ScopedPtr<PulseaudioDevice> device(open_device(DeviceType_Sink, cb_mode));
+        if (!device) {
+            return;
+        }
+
+        test::MockSource mock_source(frame_spec, frame_factory, arena);
+        mock_source.add(FrameSize * frame_spec.num_channels() * NumFrames);
+
+        for (size_t n = 0; n < NumFrames; n++) {
+            write_frames(*device, mock_source, 1);
+            LONGS_EQUAL(status::StatusOK, device->flush());
+        }
+
+        // flush on empty buffer is no-op
+        LONGS_EQUAL(status::StatusOK, device->flush());
+        LONGS_EQUAL(status::StatusOK, device->flush());
+
+        const PulseaudioMetrics metrics = device->metrics();
+        CHECK(metrics.stream_latency >= 0);
+        CHECK(metrics.ring_latency >= 0);
+
+        LONGS_EQUAL(status::StatusOK, device->close());
+    }
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "test_helpers/mock_sink.h"
+#include "test_helpers/mock_source.h"
+
+#include "roc_core/heap_arena.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/time.h"
+#include "roc_sndio/async_sink.h"
+#include "roc_sndio/async_source.h"
+#include "roc_sndio/io_pump.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum { FrameSize = 512, ManySamples = FrameSize * 20, NumFrames = 4 };
+
+const audio::SampleSpec frame_spec(48000,
+                                   audio::PcmSubformat_Raw,
+                                   audio::ChanLayout_Surround,
+                                   audio::ChanOrder_Smpte,
+                                   audio::ChanMask_Surround_Stereo);
+
+const core::nanoseconds_t frame_duration = FrameSize * core::Second
+    / core::nanoseconds_t(frame_spec.sample_rate() * frame_spec.num_channels());
+
+core::HeapArena arena;
+
+core::SlabPool<audio::Frame> frame_pool("frame_pool", arena);
+core::SlabPool<core::Buffer> frame_buffer_pool("frame_buffer_pool",
+                                               arena,
+                                               sizeof(core::Buffer)
+                                                   + FrameSize * sizeof(audio::sample_t));
+
+audio::FrameFactory frame_factory(frame_pool, frame_buffer_pool);
+
+audio::sample_t nth_sample(size_t n) {
+    return audio::sample_t(uint8_t(n)) / audio::sample_t(1 << 8);
+}
+
+// Reads source until end and checks that it returns samples starting from given
+// position. Returns number of read samples.
+size_t read_until_end(ISource& source, size_t pos) {
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    CHECK(frame);
+
+    const packet::stream_timestamp_t read_duration =
+        FrameSize / frame_spec.num_channels();
+
+    size_t n_samples = 0;
+
+    for (;;) {
+        const status::StatusCode code =
+            source.read(*frame, read_duration, audio::ModeHard);
+
+        if (code == status::StatusFinish) {
+            break;
+        }
+
+        CHECK(code == status::StatusOK || code == status::StatusPart);
+
+        for (size_t n = 0; n < frame->num_raw_samples(); n++) {
+            DOUBLES_EQUAL((double)nth_sample(pos + n_samples),
+                          (double)frame->raw_samples()[n], 0.0001);
+            n_samples++;
+        }
+    }
+
+    return n_samples;
+}
+
+class FailingSink : public test::MockSink {
+public:
+    FailingSink(core::IArena& arena)
+        : IDevice(arena)
+        , MockSink(arena) {
+    }
+
+    virtual status::StatusCode write(audio::Frame& frame) {
+        return status::StatusErrFile;
+    }
+};
+
+} // namespace
+
+TEST_GROUP(async_io) {
+    AsyncConfig async_config;
+    IoConfig pump_config;
+
+    void setup() {
+        async_config.frame_length = frame_duration;
+        async_config.buffer_length = frame_duration * NumFrames;
+
+        pump_config.sample_spec = frame_spec;
+        pump_config.frame_length = frame_duration;
+    }
+};
+
+TEST(async_io, source_read) {
+    test::MockSource mock_source(frame_spec, frame_factory, arena);
+    mock_source.add(ManySamples);
+
+    AsyncSource async_source(mock_source, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_source.init_status());
+
+    CHECK(!async_source.has_clock());
+    CHECK(async_source.sample_spec() == frame_spec);
+
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    CHECK(frame);
+
+    // Read with duration that doesn't match frame size of background thread,
+    // so that frames are split and merged.
+    const packet::stream_timestamp_t read_duration =
+        FrameSize / frame_spec.num_channels() / 3;
+
+    size_t pos = 0;
+
+    for (;;) {
+        const status::StatusCode code =
+            async_source.read(*frame, read_duration, audio::ModeHard);
+
+        if (code == status::StatusFinish) {
+            break;
+        }
+
+        CHECK(code == status::StatusOK || code == status::StatusPart);
+
+        for (size_t n = 0; n < frame->num_raw_samples(); n++) {
+            DOUBLES_EQUAL((double)nth_sample(pos), (double)frame->raw_samples()[n],
+                          0.0001);
+            pos++;
+        }
+
+        if (code == status::StatusPart) {
+            CHECK(frame->duration() < read_duration);
+        } else {
+            LONGS_EQUAL(read_duration, frame->duration());
+        }
+    }
+
+    UNSIGNED_LONGS_EQUAL(ManySamples, pos);
+    UNSIGNED_LONGS_EQUAL(ManySamples, mock_source.num_returned());
+
+    LONGS_EQUAL(status::StatusFinish,
+                async_source.read(*frame, read_duration, audio::ModeHard));
+
+    LONGS_EQUAL(status::StatusOK, async_source.close());
+}
+
+TEST(async_io, source_lookahead) {
+    test::MockSource mock_source(frame_spec, frame_factory, arena);
+    mock_source.add(ManySamples);
+
+    AsyncSource async_source(mock_source, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_source.init_status());
+
+    // Background thread reads ahead until buffer is full.
+    while (async_source.metrics().buffered_frames < NumFrames) {
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+    }
+
+    AsyncMetrics metrics = async_source.metrics();
+    UNSIGNED_LONGS_EQUAL(NumFrames, metrics.buffered_frames);
+    UNSIGNED_LONGS_EQUAL(NumFrames, metrics.max_frames);
+    UNSIGNED_LONGS_EQUAL(FrameSize * NumFrames, mock_source.num_returned());
+    UNSIGNED_LONGS_EQUAL(0, metrics.stall_count);
+
+    // Reading one frame releases space for one more frame.
+    audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+    LONGS_EQUAL(status::StatusOK,
+                async_source.read(*frame, FrameSize / frame_spec.num_channels(),
+                                  audio::ModeHard));
+
+    while (mock_source.num_returned() < FrameSize * (NumFrames + 1)) {
+        core::sleep_for(core::ClockMonotonic, core::Microsecond * 100);
+    }
+
+    LONGS_EQUAL(status::StatusOK, async_source.close());
+}
+
+TEST(async_io, source_rewind) {
+    test::MockSource mock_source(frame_spec, frame_factory, arena);
+    mock_source.add(ManySamples);
+
+    AsyncSource async_source(mock_source, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_source.init_status());
+
+    { // rewind in the middle
+        audio::FramePtr frame = frame_factory.allocate_frame_no_buffer();
+        for (size_t n = 0; n < NumFrames; n++) {
+            LONGS_EQUAL(status::StatusOK,
+                        async_source.read(*frame, FrameSize / frame_spec.num_channels(),
+                                          audio::ModeHard));
+        }
+
+        LONGS_EQUAL(status::StatusOK, async_source.rewind());
+
+        UNSIGNED_LONGS_EQUAL(ManySamples, read_until_end(async_source, 0));
+    }
+
+    { // rewind after end of stream
+        LONGS_EQUAL(status::StatusOK, async_source.rewind());
+
+        UNSIGNED_LONGS_EQUAL(ManySamples, read_until_end(async_source, 0));
+    }
+
+    LONGS_EQUAL(status::StatusOK, async_source.close());
+}
+
+TEST(async_io, source_pump) {
+    test::MockSource mock_source(frame_spec, frame_factory, arena);
+    mock_source.add(ManySamples);
+
+    AsyncSource async_source(mock_source, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_source.init_status());
+
+    test::MockSink mock_sink(arena);
+
+    IoPump pump(frame_pool, frame_buffer_pool, async_source, NULL, mock_sink,
+                pump_config, IoPump::ModePermanent);
+    LONGS_EQUAL(status::StatusOK, pump.init_status());
+    LONGS_EQUAL(status::StatusOK, pump.run());
+
+    mock_sink.check(0, ManySamples);
+}
+
+TEST(async_io, sink_pump) {
+    test::MockSource mock_source(frame_spec, frame_factory, arena);
+    mock_source.add(ManySamples);
+
+    test::MockSink mock_sink(arena);
+
+    AsyncSink async_sink(mock_sink, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_sink.init_status());
+
+    CHECK(!async_sink.has_clock());
+    UNSIGNED_LONGS_EQUAL(NumFrames, async_sink.metrics().max_frames);
+
+    IoPump pump(frame_pool, frame_buffer_pool, mock_source, NULL, async_sink,
+                pump_config, IoPump::ModePermanent);
+    LONGS_EQUAL(status::StatusOK, pump.init_status());
+    LONGS_EQUAL(status::StatusOK, pump.run());
+
+    // Pump flushes and closes sink, which waits for background thread.
+    UNSIGNED_LONGS_EQUAL(0, async_sink.metrics().buffered_frames);
+    mock_sink.check(0, ManySamples);
+}
+
+TEST(async_io, sink_flush) {
+    test::MockSink mock_sink(arena);
+
+    AsyncSink async_sink(mock_sink, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_sink.init_status());
+
+    size_t pos = 0;
+
+    for (size_t n_frame = 0; n_frame < NumFrames * 3; n_frame++) {
+        audio::FramePtr frame = frame_factory.allocate_frame(FrameSize
+                                                             * sizeof(audio::sample_t));
+        CHECK(frame);
+
+        frame->set_raw(true);
+        for (size_t n = 0; n < FrameSize; n++) {
+            frame->raw_samples()[n] = nth_sample(pos++);
+        }
+        frame->set_duration(FrameSize / frame_spec.num_channels());
+
+        LONGS_EQUAL(status::StatusOK, async_sink.write(*frame));
+    }
+
+    LONGS_EQUAL(status::StatusOK, async_sink.flush());
+
+    UNSIGNED_LONGS_EQUAL(0, async_sink.metrics().buffered_frames);
+    mock_sink.check(0, pos);
+
+    LONGS_EQUAL(status::StatusOK, async_sink.close());
+}
+
+TEST(async_io, sink_close_error) {
+    FailingSink failing_sink(arena);
+
+    AsyncSink async_sink(failing_sink, frame_factory, arena, async_config);
+    LONGS_EQUAL(status::StatusOK, async_sink.init_status());
+
+    audio::FramePtr frame =
+        frame_factory.allocate_frame(FrameSize * sizeof(audio::sample_t));
+    CHECK(frame);
+
+    frame->set_raw(true);
+    frame->set_duration(FrameSize / frame_spec.num_channels());
+
+    // Write is queued and fails later in background thread.
+    LONGS_EQUAL(status::StatusOK, async_sink.write(*frame));
+
+    // Error is reported on close, even if underlying sink closed successfully.
+    LONGS_EQUAL(status::StatusErrFile, async_sink.close());
+}
+
+} // namespace sndio
+} // namespace roc
@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include <stdio.h>
+#include <string.h>
+
+#include "test_helpers/mock_source.h"
+#include "test_helpers/utils.h"
+
+#include "roc_address/io_uri.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/mutex.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/stddefs.h"
+#include "roc_core/thread.h"
+#include "roc_dbgio/temp_file.h"
+#include "roc_sndio/backend_dispatcher.h"
+#include "roc_sndio/backend_map.h"
+#include "roc_sndio/io_config.h"
+#include "roc_sndio/io_pump.h"
+
+namespace roc {
+namespace sndio {
+
+namespace {
+
+enum {
+    FrameSize = 512,
+    ManySamples = FrameSize * 20,
+    NumFiles = 8,
+    NumThreads = 4,
+    MaxFileSize = 1024 * 1024
+};
+
+const audio::SampleSpec frame_spec(48000,
+                                   audio::PcmSubformat_Raw,
+                                   audio::ChanLayout_Surround,
+                                   audio::ChanOrder_Smpte,
+                                   audio::ChanMask_Surround_Stereo);
+
+const core::nanoseconds_t frame_duration = FrameSize * core::Second
+    / core::nanoseconds_t(frame_spec.sample_rate() * frame_spec.num_channels());
+
+core::HeapArena arena;
+
+IoConfig make_file_config() {
+    audio::SampleSpec file_spec;
+    file_spec.set_format(audio::Format_Wav);
+    file_spec.set_pcm_subformat(audio::PcmSubformat_Raw);
+    file_spec.set_sample_rate(frame_spec.sample_rate());
+    file_spec.set_channel_set(frame_spec.channel_set());
+
+    IoConfig config;
+    config.sample_spec = file_spec;
+    config.frame_length = frame_duration;
+    return config;
+}
+
+void make_uri(const char* path, address::IoUri& uri) {
+    char str[1024];
+    snprintf(str, sizeof(str), "file:%s", path);
+    CHECK(address::parse_io_uri(str, uri));
+}
+
+// Write file with generated samples.
+void write_file(const char* path, size_t n_samples) {
+    core::SlabPool<audio::Frame> frame_pool("frame_pool", arena);
+    core::SlabPool<core::Buffer> frame_buffer_pool(
+        "frame_buffer_pool", arena,
+        sizeof(core::Buffer) + FrameSize * sizeof(audio::sample_t));
+    audio::FrameFactory frame_factory(frame_pool, frame_buffer_pool);
+
+    BackendDispatcher dispatcher(frame_pool, frame_buffer_pool, arena);
+
+    address::IoUri uri(arena);
+    make_uri(path, uri);
+
+    core::ScopedPtr<ISink> sink;
+    LONGS_EQUAL(status::StatusOK, dispatcher.open_sink(uri, make_file_config(), sink));
+
+    test::MockSource source(frame_spec, frame_factory, arena);
+    source.add(n_samples);
+
+    IoConfig pump_config;
+    pump_config.sample_spec = frame_spec;
+    pump_config.frame_length = frame_duration;
+
+    IoPump pump(frame_pool, frame_buffer_pool, source, NULL, *sink, pump_config,
+                IoPump::ModeOneshot);
+    LONGS_EQUAL(status::StatusOK, pump.init_status());
+    LONGS_EQUAL(status::StatusOK, pump.run());
+}
+
+// Copy file to another file, like roc-copy does for every job.
+// Doesn't use CppUTest macros because may be called from worker threads.
+status::StatusCode
+copy_file(const char* input_path, const char* output_path, bool thread_safe_only) {
+    core::SlabPool<audio::Frame> frame_pool("frame_pool", arena);
+    core::SlabPool<core::Buffer> frame_buffer_pool(
+        "frame_buffer_pool", arena,
+        sizeof(core::Buffer) + FrameSize * sizeof(audio::sample_t));
+
+    BackendDispatcher dispatcher(frame_pool, frame_buffer_pool, arena);
+    dispatcher.set_thread_safe_only(thread_safe_only);
+
+    char input_str[1024], output_str[1024];
+    snprintf(input_str, sizeof(input_str), "file:%s", input_path);
+    snprintf(output_str, sizeof(output_str), "file:%s", output_path);
+
+    address::IoUri input_uri(arena), output_uri(arena);
+    if (!address::parse_io_uri(input_str, input_uri)
+        || !address::parse_io_uri(output_str, output_uri)) {
+        return status::StatusBadConfig;
+    }
+
+    IoConfig source_config;
+    source_config.frame_length = frame_duration;
+
+    core::ScopedPtr<ISource> source;
+    status::StatusCode code = dispatcher.open_source(input_uri, source_config, source);
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    core::ScopedPtr<ISink> sink;
+    code = dispatcher.open_sink(output_uri, make_file_config(), sink);
+    if (code != status::StatusOK) {
+        return code;
+    }
+
+    IoConfig pump_config;
+    pump_config.sample_spec = frame_spec;
+    pump_config.frame_length = frame_duration;
+
+    IoPump pump(frame_pool, frame_buffer_pool, *source, NULL, *sink, pump_config,
+                IoPump::ModePermanent);
+    if ((code = pump.init_status()) != status::StatusOK) {
+        return code;
+    }
+
+    return pump.run();
+}
+
+size_t read_file(const char* path, char* buf, size_t bufsz) {
+    FILE* fp = fopen(path, "rb");
+    CHECK(fp);
+    const size_t size = fread(buf, 1, bufsz, fp);
+    fclose(fp);
+    CHECK(size > 0);
+    CHECK(size < bufsz);
+    return size;
+}
+
+size_t compare_files(const char* path1, const char* path2) {
+    static char buf1[MaxFileSize], buf2[MaxFileSize];
+
+    const size_t size1 = read_file(path1, buf1, sizeof(buf1));
+    const size_t size2 = read_file(path2, buf2, sizeof(buf2));
+
+    UNSIGNED_LONGS_EQUAL(size1, size2);
+    CHECK(memcmp(buf1, buf2, size1) == 0);
+
+    return size1;
+}
+
+struct Job {
+    const char* input_path;
+    const char* output_path;
+};
+
+// Takes jobs from shared list until it's exhausted, like roc-copy workers.
+class Worker : public core::Thread {
+public:
+    Worker()
+        : jobs_(NULL)
+        , n_jobs_(0)
+        , next_job_(NULL)
+        , mutex_(NULL)
+        , n_failed_(0) {
+    }
+
+    void init(const Job* jobs, size_t n_jobs, size_t& next_job, core::Mutex& mutex) {
+        jobs_ = jobs;
+        n_jobs_ = n_jobs;
+        next_job_ = &next_job;
+        mutex_ = &mutex;
+    }
+
+    size_t n_failed() const {
+        return n_failed_;
+    }
+
+private:
+    virtual void run() {
+        for (;;) {
+            size_t job = 0;
+            {
+                core::Mutex::Lock lock(*mutex_);
+                if (*next_job_ == n_jobs_) {
+                    return;
+                }
+                job = (*next_job_)++;
+            }
+            if (copy_file(jobs_[job].input_path, jobs_[job].output_path, true)
+                != status::StatusOK) {
+                n_failed_++;
+            }
+        }
+    }
+
+    const Job* jobs_;
+    size_t n_jobs_;
+    size_t* next_job_;
+    core::Mutex* mutex_;
+    size_t n_failed_;
+};
+
+} // namespace
+
+TEST_GROUP(backend_dispatcher) {};
+
+// Copy several files sequentially and in parallel, and check that
+// parallel copying produces exactly the same results.
+TEST(backend_dispatcher, parallel_copy) {
+    dbgio::TempFile* input_files[NumFiles];
+    dbgio::TempFile* seq_files[NumFiles];
+    dbgio::TempFile* par_files[NumFiles];
+
+    for (size_t n = 0; n < NumFiles; n++) {
+        input_files[n] = new dbgio::TempFile("input.wav");
+        seq_files[n] = new dbgio::TempFile("seq.wav");
+        par_files[n] = new dbgio::TempFile("par.wav");
+
+        // make files different
+        write_file(input_files[n]->path(), ManySamples + n * FrameSize);
+    }
+
+    // sequential run, all backends allowed
+    for (size_t n = 0; n < NumFiles; n++) {
+        LONGS_EQUAL(status::StatusOK,
+                    copy_file(input_files[n]->path(), seq_files[n]->path(), false));
+    }
+
+    // parallel run, only thread-safe backends allowed
+    {
+        Job jobs[NumFiles];
+        for (size_t n = 0; n < NumFiles; n++) {
+            jobs[n].input_path = input_files[n]->path();
+            jobs[n].output_path = par_files[n]->path();
+        }
+
+        size_t next_job = 0;
+        core::Mutex mutex;
+
+        Worker workers[NumThreads];
+        for (size_t n = 0; n < NumThreads; n++) {
+            workers[n].init(jobs, NumFiles, next_job, mutex);
+            CHECK(workers[n].start());
+        }
+        for (size_t n = 0; n < NumThreads; n++) {
+            workers[n].join();
+            UNSIGNED_LONGS_EQUAL(0, workers[n].n_failed());
+        }
+
+        UNSIGNED_LONGS_EQUAL(NumFiles, next_job);
+    }
+
+    size_t prev_size = 0;
+    for (size_t n = 0; n < NumFiles; n++) {
+        const size_t size = compare_files(seq_files[n]->path(), par_files[n]->path());
+        // each output should match its own input
+        CHECK(size > prev_size);
+        prev_size = size;
+    }
+
+    for (size_t n = 0; n < NumFiles; n++) {
+        delete input_files[n];
+        delete seq_files[n];
+        delete par_files[n];
+    }
+}
+
+// Check that parallel jobs can handle wav files without non-thread-safe backends.
+TEST(backend_dispatcher, thread_safe_only) {
+    size_t n_thread_safe = 0;
+
+    for (size_t n_backend = 0; n_backend < BackendMap::instance().num_backends();
+         n_backend++) {
+        IBackend& backend = BackendMap::instance().nth_backend(n_backend);
+        if (backend.is_thread_safe()
+            && test::backend_supports_format(backend, arena, "wav")) {
+            n_thread_safe++;
+        }
+    }
+
+    CHECK(n_thread_safe > 0);
+}
+
+} // namespace sndio
+} // namespace roc
@@ -84,8 +84,8 @@ public:
     }
 
     virtual status::StatusCode rewind() {
-        FAIL("not implemented");
-        return status::StatusAbort;
+        pos_ = 0;
+        return status::StatusOK;
     }
 
     virtual void reclock(core::nanoseconds_t) {
@@ -21,11 +21,16 @@ namespace sndio {
 namespace test {
 namespace {
 
+// Check if backend can both write and read files of given format.
+// Tests use the same backend to write a file and read it back.
 bool backend_supports_format(IBackend& backend, core::IArena& arena, const char* format) {
+    const unsigned int flags = Driver_SupportsSink | Driver_SupportsSource;
+
     core::Array<FormatInfo, MaxFormats> format_list(arena);
     CHECK(backend.discover_formats(format_list));
     for (size_t n = 0; n < format_list.size(); n++) {
-        if (strcmp(format_list[n].format_name, format) == 0) {
+        if (strcmp(format_list[n].format_name, format) == 0
+            && (format_list[n].driver_flags & flags) == flags) {
             return true;
         }
     }
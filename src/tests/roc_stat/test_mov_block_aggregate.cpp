@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_stat/mov_block_aggregate.h"
+
+namespace roc {
+namespace stat {
+
+namespace {
+
+// Window covers last n_blocks completed blocks and current incomplete block.
+size_t expected_window(size_t n_samples, size_t block_len, size_t n_blocks) {
+    const size_t n_full = std::min(n_samples / block_len, n_blocks);
+    return n_full * block_len + n_samples % block_len;
+}
+
+} // namespace
+
+TEST_GROUP(mov_block_aggregate) {
+    core::HeapArena arena;
+};
+
+TEST(mov_block_aggregate, single_block) {
+    const size_t n = 10;
+    MovBlockAggregate<int64_t> agg(arena, n, 1);
+    CHECK(agg.is_valid());
+
+    for (size_t i = 0; i < n - 1; i++) {
+        agg.add(int64_t(i * 10));
+        CHECK(!agg.is_full());
+    }
+    // 0 .. 80
+    LONGS_EQUAL(40, agg.mov_avg());
+    LONGS_EQUAL(0, agg.mov_min());
+    LONGS_EQUAL(80, agg.mov_max());
+
+    agg.add(90);
+    CHECK(agg.is_full());
+    // 0 .. 90
+    LONGS_EQUAL(45, agg.mov_avg());
+    LONGS_EQUAL(0, agg.mov_min());
+    LONGS_EQUAL(90, agg.mov_max());
+
+    agg.add(1000);
+    // 0 .. 90, 1000
+    LONGS_EQUAL(132, agg.mov_avg());
+    LONGS_EQUAL(0, agg.mov_min());
+    LONGS_EQUAL(1000, agg.mov_max());
+
+    for (size_t i = 0; i < n - 1; i++) {
+        agg.add(500);
+    }
+    // 1000, 500 x 9
+    LONGS_EQUAL(550, agg.mov_avg());
+    LONGS_EQUAL(500, agg.mov_min());
+    LONGS_EQUAL(1000, agg.mov_max());
+}
+
+TEST(mov_block_aggregate, more_blocks_than_samples) {
+    const size_t n = 5;
+    MovBlockAggregate<int64_t> agg(arena, n, 100);
+    CHECK(agg.is_valid());
+
+    for (size_t i = 0; i < n * 3; i++) {
+        agg.add(int64_t(i));
+    }
+
+    // each sample is a separate block
+    CHECK(agg.is_full());
+    LONGS_EQUAL(12, agg.mov_avg());
+    LONGS_EQUAL(10, agg.mov_min());
+    LONGS_EQUAL(14, agg.mov_max());
+}
+
+TEST(mov_block_aggregate, stress_test) {
+    enum { NumElems = 5000 };
+
+    const size_t params[][2] = {
+        // win_len, n_blocks
+        { 1, 1 },     { 10, 1 },   { 10, 3 },   { 100, 10 },
+        { 100, 7 },   { 1000, 64 }, { 999, 100 },
+    };
+
+    for (size_t np = 0; np < sizeof(params) / sizeof(params[0]); np++) {
+        const size_t win_len = params[np][0];
+        const size_t n_blocks = params[np][1];
+        const size_t block_len = (win_len + n_blocks - 1) / n_blocks;
+
+        MovBlockAggregate<int64_t> agg(arena, win_len, n_blocks);
+        CHECK(agg.is_valid());
+
+        int64_t elems[NumElems];
+
+        for (size_t i = 0; i < NumElems; i++) {
+            elems[i] = (int64_t)core::fast_random_range(0, 1000000);
+            agg.add(elems[i]);
+
+            const size_t len = expected_window(i + 1, block_len, n_blocks);
+            if (len == 0) {
+                continue;
+            }
+
+            double sum = 0;
+            int64_t min = elems[i - len + 1], max = elems[i - len + 1];
+            for (size_t j = i + 1 - len; j <= i; j++) {
+                sum += (double)elems[j];
+                min = std::min(min, elems[j]);
+                max = std::max(max, elems[j]);
+            }
+
+            DOUBLES_EQUAL(sum / len, (double)agg.mov_avg(), 1);
+            LONGS_EQUAL(min, agg.mov_min());
+            LONGS_EQUAL(max, agg.mov_max());
+        }
+    }
+}
+
+} // namespace stat
+} // namespace roc
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <CppUTest/TestHarness.h>
+
+#include "roc_core/fast_random.h"
+#include "roc_core/heap_arena.h"
+#include "roc_stat/mov_block_quantile.h"
+#include "roc_stat/mov_quantile.h"
+
+namespace roc {
+namespace stat {
+
+namespace {
+
+enum { MaxElems = 20000 };
+
+int64_t exact_quantile(const int64_t* elems, size_t n_elems, double quantile) {
+    static int64_t sorted[MaxElems];
+    std::copy(elems, elems + n_elems, sorted);
+    std::sort(sorted, sorted + n_elems);
+    return sorted[size_t(quantile * double(n_elems - 1))];
+}
+
+// Fraction of elements less than given value.
+double value_rank(const int64_t* elems, size_t n_elems, int64_t value) {
+    size_t n_less = 0;
+    for (size_t i = 0; i < n_elems; i++) {
+        if (elems[i] < value) {
+            n_less++;
+        }
+    }
+    return double(n_less) / double(n_elems);
+}
+
+} // namespace
+
+TEST_GROUP(mov_block_quantile) {
+    core::HeapArena arena;
+};
+
+// Until first block is completed, quantile is exact.
+TEST(mov_block_quantile, first_block) {
+    const size_t win_len = 100;
+    const size_t n_blocks = 2;
+    const double q = 0.9;
+
+    MovBlockQuantile<int64_t> block_quant(arena, win_len, q, n_blocks, 4);
+    MovQuantile<int64_t> quant(arena, win_len, q);
+    CHECK(block_quant.is_valid());
+    CHECK(quant.is_valid());
+
+    for (size_t i = 0; i < win_len / n_blocks - 1; i++) {
+        const int64_t x = (int64_t)core::fast_random_range(0, 1000);
+        block_quant.add(x);
+        quant.add(x);
+
+        LONGS_EQUAL(quant.mov_quantile(), block_quant.mov_quantile());
+    }
+}
+
+// When every block point is kept, quantile of completed blocks is exact.
+TEST(mov_block_quantile, all_points) {
+    enum { NumElems = 2000 };
+
+    const size_t win_len = 100;
+    const size_t n_blocks = 10;
+    const size_t block_len = win_len / n_blocks;
+
+    const double quantiles[] = { 0, 0.1, 0.5, 0.92, 1 };
+
+    for (size_t nq = 0; nq < sizeof(quantiles) / sizeof(quantiles[0]); nq++) {
+        MovBlockQuantile<int64_t> quant(arena, win_len, quantiles[nq], n_blocks,
+                                        block_len);
+        CHECK(quant.is_valid());
+
+        int64_t elems[NumElems];
+
+        for (size_t i = 0; i < NumElems; i++) {
+            elems[i] = (int64_t)core::fast_random_range(0, 1000000);
+            quant.add(elems[i]);
+
+            if ((i + 1) % block_len != 0) {
+                continue;
+            }
+
+            const size_t len = std::min(i + 1, win_len);
+            LONGS_EQUAL(exact_quantile(elems + i + 1 - len, len, quantiles[nq]),
+                        quant.mov_quantile());
+        }
+
+        CHECK(quant.is_full());
+    }
+}
+
+// Rank of approximate quantile is close to requested quantile.
+TEST(mov_block_quantile, rank_error) {
+    enum { NumElems = MaxElems };
+
+    const size_t win_len = 5000;
+    const size_t n_blocks = 50;
+    const size_t n_points = 16;
+
+    const double quantiles[] = { 0.1, 0.5, 0.92 };
+
+    for (size_t nq = 0; nq < sizeof(quantiles) / sizeof(quantiles[0]); nq++) {
+        MovBlockQuantile<int64_t> quant(arena, win_len, quantiles[nq], n_blocks,
+                                        n_points);
+        CHECK(quant.is_valid());
+
+        static int64_t elems[NumElems];
+
+        for (size_t i = 0; i < NumElems; i++) {
+            elems[i] = (int64_t)core::fast_random_range(0, 1000000);
+            quant.add(elems[i]);
+
+            if (i + 1 < win_len) {
+                continue;
+            }
+
+            // Approximate window is shifted by up to one block.
+            const double rank =
+                value_rank(elems + i + 1 - win_len, win_len, quant.mov_quantile());
+            DOUBLES_EQUAL(quantiles[nq], rank, 0.05);
+        }
+    }
+}
+
+} // namespace stat
+} // namespace roc
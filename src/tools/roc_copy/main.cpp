@@ -10,9 +10,14 @@
 #include "roc_core/crash_handler.h"
 #include "roc_core/heap_arena.h"
 #include "roc_core/log.h"
+#include "roc_core/mutex.h"
+#include "roc_core/optional.h"
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/scoped_release.h"
+#include "roc_core/string_list.h"
+#include "roc_core/thread.h"
+#include "roc_core/time.h"
 #include "roc_dbgio/print_supported.h"
 #include "roc_pipeline/transcoder_sink.h"
 #include "roc_sndio/backend_dispatcher.h"
@@ -55,6 +60,8 @@ bool build_input_config(const gengetopt_args_info& args, sndio::IoConfig& input_
         }
     }
 
+    input_config.enable_mmap = args.input_mmap_flag;
+
     return true;
 }
 
@@ -91,6 +98,9 @@ bool build_transcoder_config(const gengetopt_args_info& args,
     case resampler_backend_arg_speexdec:
         transcoder_config.resampler.backend = audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_polyphase:
+        transcoder_config.resampler.backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -118,22 +128,59 @@ bool build_transcoder_config(const gengetopt_args_info& args,
     return true;
 }
 
+bool build_thread_config(const gengetopt_args_info& args,
+                         core::ThreadConfig& thread_config) {
+    switch (args.sched_policy_arg) {
+    case sched_policy_arg_fifo:
+        thread_config.policy = core::ThreadPolicy_Fifo;
+        break;
+    case sched_policy_arg_rr:
+        thread_config.policy = core::ThreadPolicy_RoundRobin;
+        break;
+    default:
+        break;
+    }
+
+    if (args.sched_priority_given) {
+        if (thread_config.policy == core::ThreadPolicy_Default) {
+            roc_log(LogError,
+                    "invalid --sched-priority: can be used only with --sched-policy"
+                    " set to 'fifo' or 'rr'");
+            return false;
+        }
+        if (args.sched_priority_arg <= 0) {
+            roc_log(LogError, "invalid --sched-priority: should be > 0");
+            return false;
+        }
+        thread_config.priority = args.sched_priority_arg;
+    }
+
+    if (args.cpu_set_given) {
+        if (!core::parse_cpu_list(args.cpu_set_arg, thread_config.cpu_mask)) {
+            roc_log(LogError, "invalid --cpu-set: bad format");
+            return false;
+        }
+    }
+
+    return true;
+}
+
 size_t compute_max_frame_size(const sndio::IoConfig& io_config) {
     audio::SampleSpec spec = io_config.sample_spec;
     spec.use_defaults(audio::Format_Pcm, audio::PcmSubformat_Raw,
                       audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
                       audio::ChanMask_Surround_7_1_4, 48000);
 
-    return spec.ns_2_samples_overall(io_config.frame_length) * sizeof(audio::sample_t);
-}
-
-bool parse_input_uri(const gengetopt_args_info& args, address::IoUri& input_uri) {
-    if (!args.input_given) {
-        roc_log(LogError, "missing mandatory --input URI");
-        return false;
+    core::nanoseconds_t len = io_config.frame_length;
+    if (len == 0) {
+        len = 10 * core::Millisecond;
     }
 
-    if (!address::parse_io_uri(args.input_arg, input_uri)) {
+    return spec.ns_2_samples_overall(len) * sizeof(audio::sample_t);
+}
+
+bool parse_input_uri(const char* input_arg, address::IoUri& input_uri) {
+    if (!address::parse_io_uri(input_arg, input_uri)) {
         roc_log(LogError, "invalid --input URI: bad format");
         return false;
     }
@@ -146,8 +193,10 @@ bool parse_input_uri(const gengetopt_args_info& args, address::IoUri& input_uri)
     return true;
 }
 
-bool parse_output_uri(const gengetopt_args_info& args, address::IoUri& output_uri) {
-    if (!address::parse_io_uri(args.output_arg, output_uri)) {
+bool parse_output_uri(const gengetopt_args_info& args,
+                      const char* output_arg,
+                      address::IoUri& output_uri) {
+    if (!address::parse_io_uri(output_arg, output_uri)) {
         roc_log(LogError, "invalid --output URI: bad format");
         return false;
     }
@@ -209,53 +258,40 @@ bool open_output_sink(sndio::BackendDispatcher& backend_dispatcher,
     return true;
 }
 
-} // namespace
-
-int main(int argc, char** argv) {
-    core::CrashHandler crash_handler;
-
-    core::HeapArena::set_guards(core::HeapArena_DefaultGuards
-                                | core::HeapArena_LeakGuard);
-    core::HeapArena heap_arena;
-
-    gengetopt_args_info args;
-    const int code = cmdline_parser(argc, argv, &args);
-    if (code != 0) {
-        return code;
-    }
-    core::ScopedRelease<gengetopt_args_info> args_releaser(&args, &cmdline_parser_free);
-
-    init_logger(args);
-
+enum { MaxWorkers = 64 };
+
+// Transcode one file.
+// If output_arg is NULL, input is decoded and discarded.
+// If thread_safe_only is true, only backends that allow concurrent use
+// are used, so that file can be transcoded in parallel with other files.
+// On success, sets duration to the duration of transcoded audio.
+bool transcode_file(const gengetopt_args_info& args,
+                    const char* input_arg,
+                    const char* output_arg,
+                    bool thread_safe_only,
+                    core::IArena& arena,
+                    core::nanoseconds_t& duration) {
     sndio::IoConfig input_config;
     if (!build_input_config(args, input_config)) {
-        return 1;
+        return false;
     }
 
-    core::SlabPool<audio::Frame> frame_pool("frame_pool", heap_arena);
+    core::SlabPool<audio::Frame> frame_pool("frame_pool", arena);
     core::SlabPool<core::Buffer> frame_buffer_pool(
-        "frame_buffer_pool", heap_arena,
+        "frame_buffer_pool", arena,
         sizeof(core::Buffer) + compute_max_frame_size(input_config));
 
-    sndio::BackendDispatcher backend_dispatcher(frame_pool, frame_buffer_pool,
-                                                heap_arena);
+    sndio::BackendDispatcher backend_dispatcher(frame_pool, frame_buffer_pool, arena);
+    backend_dispatcher.set_thread_safe_only(thread_safe_only);
 
-    if (args.list_supported_given) {
-        if (!dbgio::print_supported(dbgio::Print_Sndio | dbgio::Print_Audio,
-                                    backend_dispatcher, heap_arena)) {
-            return 1;
-        }
-        return 0;
-    }
-
-    address::IoUri input_uri(heap_arena);
-    if (!parse_input_uri(args, input_uri)) {
-        return 1;
+    address::IoUri input_uri(arena);
+    if (!parse_input_uri(input_arg, input_uri)) {
+        return false;
     }
 
     core::ScopedPtr<sndio::ISource> input_source;
     if (!open_input_source(backend_dispatcher, input_config, input_uri, input_source)) {
-        return 1;
+        return false;
     }
 
     input_config.sample_spec = input_source->sample_spec();
@@ -263,21 +299,21 @@ int main(int argc, char** argv) {
 
     sndio::IoConfig output_config;
     if (!build_output_config(args, input_config, output_config)) {
-        return 1;
+        return false;
     }
 
-    address::IoUri output_uri(heap_arena);
-    if (args.output_given) {
-        if (!parse_output_uri(args, output_uri)) {
-            return 1;
+    address::IoUri output_uri(arena);
+    if (output_arg) {
+        if (!parse_output_uri(args, output_arg, output_uri)) {
+            return false;
         }
     }
 
     core::ScopedPtr<sndio::ISink> output_sink;
-    if (args.output_given) {
+    if (output_arg) {
         if (!open_output_sink(backend_dispatcher, output_config, output_uri,
                               output_sink)) {
-            return 1;
+            return false;
         }
         output_config.sample_spec = output_sink->sample_spec();
     }
@@ -285,18 +321,18 @@ int main(int argc, char** argv) {
     pipeline::TranscoderConfig transcoder_config;
     if (!build_transcoder_config(args, transcoder_config, *input_source,
                                  output_sink.get())) {
-        return 1;
+        return false;
     }
 
-    audio::ProcessorMap processor_map(heap_arena);
+    audio::ProcessorMap processor_map(arena);
 
     pipeline::TranscoderSink transcoder(transcoder_config, output_sink.get(),
                                         processor_map, frame_pool, frame_buffer_pool,
-                                        heap_arena);
+                                        arena);
     if (transcoder.init_status() != status::StatusOK) {
         roc_log(LogError, "can't create transcoder pipeline: status=%s",
                 status::code_to_str(transcoder.init_status()));
-        return 1;
+        return false;
     }
 
     sndio::IoPump pump(frame_pool, frame_buffer_pool, *input_source, NULL, transcoder,
@@ -304,14 +340,342 @@ int main(int argc, char** argv) {
     if (pump.init_status() != status::StatusOK) {
         roc_log(LogError, "can't create io pump: status=%s",
                 status::code_to_str(pump.init_status()));
-        return 1;
+        return false;
     }
 
     const status::StatusCode status = pump.run();
     if (status != status::StatusOK) {
         roc_log(LogError, "io pump failed: status=%s", status::code_to_str(status));
+        return false;
+    }
+
+    duration = pump.transferred_duration();
+
+    return true;
+}
+
+// Read job list for batch mode.
+// Every non-empty line, except comments starting with '#', should contain
+// input and output URIs separated with whitespace. URIs are added to the
+// list in pairs.
+bool load_job_list(const char* path, core::StringList& jobs, core::IArena& arena) {
+    FILE* fp = fopen(path, "r");
+    if (!fp) {
+        roc_log(LogError, "can't open --batch file: path=%s", path);
+        return false;
+    }
+
+    bool ok = true;
+    size_t line_num = 0;
+    char line[4096];
+
+    while (ok && fgets(line, sizeof(line), fp)) {
+        line_num++;
+
+        const char* tokens[3] = { NULL, NULL, NULL };
+        size_t n_tokens = 0;
+
+        for (char* tok = strtok(line, " \t\r\n"); tok; tok = strtok(NULL, " \t\r\n")) {
+            if (n_tokens == 0 && tok[0] == '#') {
+                break;
+            }
+            if (n_tokens == 3) {
+                break;
+            }
+            tokens[n_tokens++] = tok;
+        }
+
+        if (n_tokens == 0) {
+            continue;
+        }
+
+        if (n_tokens != 2) {
+            roc_log(LogError,
+                    "invalid --batch file: expected input and output URI:"
+                    " path=%s line=%lu",
+                    path, (unsigned long)line_num);
+            ok = false;
+            break;
+        }
+
+        for (size_t n = 0; n < n_tokens; n++) {
+            address::IoUri uri(arena);
+            if (address::parse_io_uri(tokens[n], uri) && uri.is_special_file()) {
+                roc_log(LogError,
+                        "invalid --batch file: stdin and stdout are not allowed:"
+                        " path=%s line=%lu",
+                        path, (unsigned long)line_num);
+                ok = false;
+                break;
+            }
+            if (!jobs.push_back(tokens[n])) {
+                roc_log(LogError, "can't allocate job list");
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    fclose(fp);
+
+    if (ok && jobs.is_empty()) {
+        roc_log(LogError, "invalid --batch file: no jobs: path=%s", path);
+        ok = false;
+    }
+
+    return ok;
+}
+
+// Hands out jobs to workers.
+class JobQueue : public core::NonCopyable<> {
+public:
+    explicit JobQueue(const core::StringList& jobs)
+        : jobs_(jobs)
+        , next_(jobs.front()) {
+    }
+
+    // Get URIs of next job.
+    // Returns false if there are no more jobs.
+    bool next(const char*& input_arg, const char*& output_arg) {
+        core::Mutex::Lock lock(mutex_);
+
+        if (!next_) {
+            return false;
+        }
+
+        input_arg = next_;
+        output_arg = jobs_.nextof(input_arg);
+        next_ = jobs_.nextof(output_arg);
+
+        return true;
+    }
+
+private:
+    core::Mutex mutex_;
+    const core::StringList& jobs_;
+    const char* next_;
+};
+
+// Transcodes jobs from queue until it's empty.
+class Worker : public core::Thread {
+public:
+    Worker(const gengetopt_args_info& args,
+           JobQueue& queue,
+           bool parallel,
+           core::IArena& arena,
+           const core::ThreadConfig& thread_config)
+        : core::Thread(thread_config)
+        , args_(args)
+        , queue_(queue)
+        , parallel_(parallel)
+        , arena_(arena)
+        , n_succeeded_(0)
+        , n_failed_(0)
+        , duration_(0) {
+    }
+
+    size_t n_succeeded() const {
+        return n_succeeded_;
+    }
+
+    size_t n_failed() const {
+        return n_failed_;
+    }
+
+    // Total duration of transcoded audio.
+    core::nanoseconds_t duration() const {
+        return duration_;
+    }
+
+private:
+    virtual void run() {
+        const char* input_arg = NULL;
+        const char* output_arg = NULL;
+
+        while (queue_.next(input_arg, output_arg)) {
+            const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+            core::nanoseconds_t duration = 0;
+
+            if (!transcode_file(args_, input_arg, output_arg, parallel_, arena_,
+                                duration)) {
+                roc_log(LogError, "job failed: input=%s output=%s", input_arg,
+                        output_arg);
+                n_failed_++;
+                continue;
+            }
+
+            const core::nanoseconds_t elapsed =
+                core::timestamp(core::ClockMonotonic) - start_time;
+
+            roc_log(LogInfo, "job succeeded: input=%s output=%s speed=%.1fx", input_arg,
+                    output_arg, elapsed > 0 ? (double)duration / elapsed : 0.);
+
+            n_succeeded_++;
+            duration_ += duration;
+        }
+    }
+
+    const gengetopt_args_info& args_;
+    JobQueue& queue_;
+    const bool parallel_;
+    core::IArena& arena_;
+
+    size_t n_succeeded_;
+    size_t n_failed_;
+    core::nanoseconds_t duration_;
+};
+
+void report_speed(core::nanoseconds_t duration, core::nanoseconds_t elapsed) {
+    roc_log(LogInfo, "transcoded %.3fs of audio in %.3fs: speed=%.1fx",
+            (double)duration / core::Second, (double)elapsed / core::Second,
+            elapsed > 0 ? (double)duration / elapsed : 0.);
+}
+
+// Run jobs from --batch file on a pool of --jobs threads.
+bool run_batch(const gengetopt_args_info& args,
+               const core::ThreadConfig& thread_config,
+               core::IArena& arena) {
+    if (args.input_given || args.output_given) {
+        roc_log(LogError, "--input and --output can't be used together with --batch");
+        return false;
+    }
+
+    if (args.jobs_arg <= 0 || args.jobs_arg > MaxWorkers) {
+        roc_log(LogError, "invalid --jobs: should be in range [1; %d]", (int)MaxWorkers);
+        return false;
+    }
+
+    core::StringList jobs(arena);
+    if (!load_job_list(args.batch_arg, jobs, arena)) {
+        return false;
+    }
+
+    const size_t n_jobs = jobs.size() / 2;
+    const size_t n_workers = std::min((size_t)args.jobs_arg, n_jobs);
+
+    roc_log(LogInfo, "starting batch: n_jobs=%lu n_workers=%lu", (unsigned long)n_jobs,
+            (unsigned long)n_workers);
+
+    // Some backends (SoX) use global state of underlying library and can't be
+    // used from multiple threads. Parallel workers skip such backends.
+    const bool parallel = n_workers > 1;
+    if (parallel) {
+        roc_log(LogInfo,
+                "parallel jobs use only thread-safe backends,"
+                " use --jobs=1 to enable all backends");
+    }
+
+    JobQueue queue(jobs);
+
+    core::Optional<Worker> workers[MaxWorkers];
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+
+    size_t n_started = 0;
+    for (; n_started < n_workers; n_started++) {
+        workers[n_started].reset(new (workers[n_started])
+                                     Worker(args, queue, parallel, arena, thread_config));
+        if (!workers[n_started]->start()) {
+            roc_log(LogError, "can't start worker thread");
+            break;
+        }
+    }
+
+    core::nanoseconds_t duration = 0;
+    size_t n_succeeded = 0, n_failed = 0;
+
+    for (size_t n = 0; n < n_started; n++) {
+        workers[n]->join();
+
+        duration += workers[n]->duration();
+        n_succeeded += workers[n]->n_succeeded();
+        n_failed += workers[n]->n_failed();
+    }
+
+    const core::nanoseconds_t elapsed =
+        core::timestamp(core::ClockMonotonic) - start_time;
+
+    roc_log(LogInfo, "finished batch: n_succeeded=%lu n_failed=%lu",
+            (unsigned long)n_succeeded, (unsigned long)n_failed);
+
+    report_speed(duration, elapsed);
+
+    return n_started == n_workers && n_failed == 0 && n_succeeded == n_jobs;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    core::CrashHandler crash_handler;
+
+    core::HeapArena::set_guards(core::HeapArena_DefaultGuards
+                                | core::HeapArena_LeakGuard);
+    core::HeapArena heap_arena;
+
+    gengetopt_args_info args;
+    const int code = cmdline_parser(argc, argv, &args);
+    if (code != 0) {
+        return code;
+    }
+    core::ScopedRelease<gengetopt_args_info> args_releaser(&args, &cmdline_parser_free);
+
+    init_logger(args);
+
+    if (args.list_supported_given) {
+        sndio::IoConfig io_config;
+        if (!build_input_config(args, io_config)) {
+            return 1;
+        }
+
+        core::SlabPool<audio::Frame> frame_pool("frame_pool", heap_arena);
+        core::SlabPool<core::Buffer> frame_buffer_pool(
+            "frame_buffer_pool", heap_arena,
+            sizeof(core::Buffer) + compute_max_frame_size(io_config));
+
+        sndio::BackendDispatcher backend_dispatcher(frame_pool, frame_buffer_pool,
+                                                    heap_arena);
+
+        if (!dbgio::print_supported(dbgio::Print_Sndio | dbgio::Print_Audio,
+                                    backend_dispatcher, heap_arena)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    core::ThreadConfig thread_config;
+    if (!build_thread_config(args, thread_config)) {
         return 1;
     }
 
+    if (args.mlock_flag) {
+        if (!core::Thread::lock_memory()) {
+            roc_log(LogInfo, "continuing without locked memory");
+        }
+    }
+
+    if (args.batch_given) {
+        if (!run_batch(args, thread_config, heap_arena)) {
+            return 1;
+        }
+        return 0;
+    }
+
+    if (!args.input_given) {
+        roc_log(LogError, "missing mandatory --input URI");
+        return 1;
+    }
+
+    core::Thread::apply_config(thread_config);
+
+    const core::nanoseconds_t start_time = core::timestamp(core::ClockMonotonic);
+    core::nanoseconds_t duration = 0;
+
+    if (!transcode_file(args, args.input_arg, args.output_given ? args.output_arg : NULL,
+                        false, heap_arena, duration)) {
+        return 1;
+    }
+
+    report_speed(duration, core::timestamp(core::ClockMonotonic) - start_time);
+
     return 0;
 }
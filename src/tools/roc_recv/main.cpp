@@ -15,10 +15,12 @@
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/scoped_release.h"
+#include "roc_core/thread.h"
 #include "roc_dbgio/print_supported.h"
 #include "roc_node/context.h"
 #include "roc_node/receiver.h"
 #include "roc_pipeline/transcoder_source.h"
+#include "roc_sndio/async_sink.h"
 #include "roc_sndio/backend_dispatcher.h"
 #include "roc_sndio/io_pump.h"
 #include "roc_status/code_to_str.h"
@@ -77,11 +79,104 @@ bool build_io_config(const gengetopt_args_info& args, sndio::IoConfig& io_config
         }
     }
 
+    if (args.io_tlength_given) {
+        if (!core::parse_duration(args.io_tlength_arg, io_config.buffer.target_length)) {
+            roc_log(LogError, "invalid --io-tlength: bad format");
+            return false;
+        }
+        if (io_config.buffer.target_length <= 0) {
+            roc_log(LogError, "invalid --io-tlength: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.io_minreq_given) {
+        if (!core::parse_duration(args.io_minreq_arg, io_config.buffer.min_request)) {
+            roc_log(LogError, "invalid --io-minreq: bad format");
+            return false;
+        }
+        if (io_config.buffer.min_request <= 0) {
+            roc_log(LogError, "invalid --io-minreq: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.io_prebuf_given) {
+        if (!core::parse_duration(args.io_prebuf_arg, io_config.buffer.prebuffer)) {
+            roc_log(LogError, "invalid --io-prebuf: bad format");
+            return false;
+        }
+        if (io_config.buffer.prebuffer < 0) {
+            roc_log(LogError, "invalid --io-prebuf: should be >= 0");
+            return false;
+        }
+    }
+
+    io_config.buffer.adjust_latency = !args.io_no_adjust_latency_flag;
+    io_config.callback_mode = args.io_callback_flag;
+
+    return true;
+}
+
+bool build_thread_config(const gengetopt_args_info& args,
+                         core::ThreadConfig& thread_config) {
+    switch (args.sched_policy_arg) {
+    case sched_policy_arg_fifo:
+        thread_config.policy = core::ThreadPolicy_Fifo;
+        break;
+    case sched_policy_arg_rr:
+        thread_config.policy = core::ThreadPolicy_RoundRobin;
+        break;
+    default:
+        break;
+    }
+
+    if (args.sched_priority_given) {
+        if (thread_config.policy == core::ThreadPolicy_Default) {
+            roc_log(LogError,
+                    "invalid --sched-priority: can be used only with --sched-policy"
+                    " set to 'fifo' or 'rr'");
+            return false;
+        }
+        if (args.sched_priority_arg <= 0) {
+            roc_log(LogError, "invalid --sched-priority: should be > 0");
+            return false;
+        }
+        thread_config.priority = args.sched_priority_arg;
+    }
+
+    if (args.cpu_set_given) {
+        if (!core::parse_cpu_list(args.cpu_set_arg, thread_config.cpu_mask)) {
+            roc_log(LogError, "invalid --cpu-set: bad format");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool build_async_config(const gengetopt_args_info& args,
+                        const sndio::IoConfig& io_config,
+                        const core::ThreadConfig& thread_config,
+                        sndio::AsyncConfig& async_config) {
+    if (!core::parse_duration(args.io_buffer_arg, async_config.buffer_length)) {
+        roc_log(LogError, "invalid --io-buffer: bad format");
+        return false;
+    }
+    if (async_config.buffer_length <= 0) {
+        roc_log(LogError, "invalid --io-buffer: should be > 0");
+        return false;
+    }
+
+    async_config.frame_length = io_config.frame_length;
+    async_config.thread_config = thread_config;
+
     return true;
 }
 
 bool build_context_config(const gengetopt_args_info& args,
                           const sndio::IoConfig& io_config,
+                          const core::ThreadConfig& thread_config,
                           node::ContextConfig& context_config) {
     if (args.max_packet_size_given) {
         if (!core::parse_size(args.max_packet_size_arg, context_config.max_packet_size)) {
@@ -116,6 +211,19 @@ bool build_context_config(const gengetopt_args_info& args,
             spec.ns_2_samples_overall(len) * sizeof(audio::sample_t);
     }
 
+
+    context_config.network_thread = thread_config;
+    context_config.control_thread = thread_config;
+    context_config.enable_mlock = args.mlock_flag;
+
+    if (args.prewarm_given) {
+        if (args.prewarm_arg < 0) {
+            roc_log(LogError, "invalid --prewarm: should be >= 0");
+            return false;
+        }
+        context_config.prewarm_packets = (size_t)args.prewarm_arg;
+        context_config.prewarm_frames = (size_t)args.prewarm_arg;
+    }
     return true;
 }
 
@@ -140,6 +248,9 @@ bool build_receiver_config(const gengetopt_args_info& args,
     }
 
     switch (args.plc_arg) {
+    case plc_arg_codec:
+        receiver_config.session_defaults.plc.backend = audio::PlcBackend_Codec;
+        break;
     case plc_arg_none:
         receiver_config.session_defaults.plc.backend = audio::PlcBackend_None;
         break;
@@ -166,6 +277,10 @@ bool build_receiver_config(const gengetopt_args_info& args,
         receiver_config.session_defaults.resampler.backend =
             audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_polyphase:
+        receiver_config.session_defaults.resampler.backend =
+            audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -332,6 +447,10 @@ bool build_receiver_config(const gengetopt_args_info& args,
         receiver_config.common.dumper.dump_file = args.dump_arg;
     }
 
+    if (args.capture_given) {
+        receiver_config.common.capture.capture_file = args.capture_arg;
+    }
+
     receiver_config.common.enable_cpu_clock = !output_sink.has_clock();
     receiver_config.common.output_sample_spec = output_sink.sample_spec();
 
@@ -462,6 +581,33 @@ bool open_backup_transcoder(
     return true;
 }
 
+bool open_async_sink(audio::FrameFactory& frame_factory,
+                     node::Context& context,
+                     const sndio::AsyncConfig& async_config,
+                     sndio::ISink& output_sink,
+                     core::ScopedPtr<sndio::AsyncSink>& async_sink) {
+    if (output_sink.has_clock()) {
+        roc_log(LogError,
+                "invalid --io-buffer: can be used only when --output is a file");
+        return false;
+    }
+
+    async_sink.reset(new (context.arena()) sndio::AsyncSink(
+        output_sink, frame_factory, context.arena(), async_config));
+    if (!async_sink) {
+        roc_log(LogError, "can't allocate async sink");
+        return false;
+    }
+
+    if (async_sink->init_status() != status::StatusOK) {
+        roc_log(LogError, "can't create async sink: status=%s",
+                status::code_to_str(async_sink->init_status()));
+        return false;
+    }
+
+    return true;
+}
+
 bool prepare_receiver(const gengetopt_args_info& args,
                       node::Context& context,
                       node::Receiver& receiver) {
@@ -618,8 +764,13 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    core::ThreadConfig thread_config;
+    if (!build_thread_config(args, thread_config)) {
+        return 1;
+    }
+
     node::ContextConfig context_config;
-    if (!build_context_config(args, io_config, context_config)) {
+    if (!build_context_config(args, io_config, thread_config, context_config)) {
         return 1;
     }
 
@@ -655,11 +806,34 @@ int main(int argc, char** argv) {
     io_config.sample_spec = output_sink->sample_spec();
     io_config.frame_length = output_sink->frame_length();
 
+    // If requested, write output in background thread, so that slow disk I/O
+    // doesn't stall receiver pipeline.
+    audio::FrameFactory frame_factory(context.frame_pool(), context.frame_buffer_pool());
+    core::ScopedPtr<sndio::AsyncSink> async_sink;
+
+    if (args.io_buffer_given) {
+        sndio::AsyncConfig async_config;
+        if (!build_async_config(args, io_config, thread_config, async_config)) {
+            return 1;
+        }
+
+        if (!open_async_sink(frame_factory, context, async_config, *output_sink,
+                             async_sink)) {
+            return 1;
+        }
+    }
+
+    sndio::ISink& pump_sink = async_sink ? *async_sink : *output_sink;
+
     pipeline::ReceiverSourceConfig receiver_config;
-    if (!build_receiver_config(args, receiver_config, context, *output_sink)) {
+    if (!build_receiver_config(args, receiver_config, context, pump_sink)) {
         return 1;
     }
 
+    // Dumper thread performs blocking file I/O, so it doesn't get realtime
+    // policy, but is kept on the same CPUs as other threads.
+    receiver_config.common.dumper.thread_config.cpu_mask = thread_config.cpu_mask;
+
     core::ScopedPtr<sndio::ISource> backup_source;
     core::ScopedPtr<pipeline::TranscoderSource> backup_transcoder;
 
@@ -695,7 +869,7 @@ int main(int argc, char** argv) {
         args.oneshot_flag ? sndio::IoPump::ModeOneshot : sndio::IoPump::ModePermanent;
 
     sndio::IoPump pump(context.frame_pool(), context.frame_buffer_pool(),
-                       receiver.source(), backup_transcoder.get(), *output_sink,
+                       receiver.source(), backup_transcoder.get(), pump_sink,
                        io_config, pump_mode);
     if (pump.init_status() != status::StatusOK) {
         roc_log(LogError, "can't create io pump: status=%s",
@@ -703,6 +877,9 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // Pump runs in main thread, which is the I/O thread of the tool.
+    core::Thread::apply_config(thread_config);
+
     const status::StatusCode status = pump.run();
     if (status != status::StatusOK) {
         roc_log(LogError, "io pump failed: status=%s", status::code_to_str(status));
@@ -0,0 +1,780 @@
+/*
+ * Copyright (c) 2024 Roc Streaming authors
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "roc_address/io_uri.h"
+#include "roc_address/protocol_map.h"
+#include "roc_audio/frame_factory.h"
+#include "roc_audio/processor_map.h"
+#include "roc_core/crash_handler.h"
+#include "roc_core/heap_arena.h"
+#include "roc_core/log.h"
+#include "roc_core/parse_units.h"
+#include "roc_core/scoped_ptr.h"
+#include "roc_core/scoped_release.h"
+#include "roc_core/slab_pool.h"
+#include "roc_core/time.h"
+#include "roc_dbgio/packet_capture_reader.h"
+#include "roc_packet/packet_factory.h"
+#include "roc_pipeline/receiver_source.h"
+#include "roc_rtp/encoding_map.h"
+#include "roc_sndio/backend_dispatcher.h"
+#include "roc_status/code_to_str.h"
+
+#include "roc_replay/cmdline.h"
+
+using namespace roc;
+
+namespace {
+
+enum { DefaultMaxPacketSize = 2048 };
+
+const core::nanoseconds_t DefaultFrameLength = 10 * core::Millisecond;
+
+void init_logger(const gengetopt_args_info& args) {
+    core::Logger::instance().set_verbosity(args.verbose_given);
+
+    switch (args.color_arg) {
+    case color_arg_auto:
+        core::Logger::instance().set_colors(core::ColorsAuto);
+        break;
+    case color_arg_always:
+        core::Logger::instance().set_colors(core::ColorsEnabled);
+        break;
+    case color_arg_never:
+        core::Logger::instance().set_colors(core::ColorsDisabled);
+        break;
+    default:
+        break;
+    }
+}
+
+bool build_io_config(const gengetopt_args_info& args, sndio::IoConfig& io_config) {
+    if (args.io_encoding_given) {
+        if (!audio::parse_sample_spec(args.io_encoding_arg, io_config.sample_spec)) {
+            roc_log(LogError, "invalid --io-encoding");
+            return false;
+        }
+    }
+
+    if (args.io_frame_len_given) {
+        if (!core::parse_duration(args.io_frame_len_arg, io_config.frame_length)) {
+            roc_log(LogError, "invalid --io-frame-len: bad format");
+            return false;
+        }
+        if (io_config.frame_length <= 0) {
+            roc_log(LogError, "invalid --io-frame-len: should be > 0");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool build_pool_sizes(const gengetopt_args_info& args,
+                      const sndio::IoConfig& io_config,
+                      size_t& max_packet_size,
+                      size_t& max_frame_size) {
+    max_packet_size = DefaultMaxPacketSize;
+
+    if (args.max_packet_size_given) {
+        if (!core::parse_size(args.max_packet_size_arg, max_packet_size)) {
+            roc_log(LogError, "invalid --max-packet-size: bad format");
+            return false;
+        }
+        if (max_packet_size == 0) {
+            roc_log(LogError, "invalid --max-packet-size: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.max_frame_size_given) {
+        if (!core::parse_size(args.max_frame_size_arg, max_frame_size)) {
+            roc_log(LogError, "invalid --max-frame-size: bad format");
+            return false;
+        }
+        if (max_frame_size == 0) {
+            roc_log(LogError, "invalid --max-frame-size: should be > 0");
+            return false;
+        }
+    } else {
+        audio::SampleSpec spec = io_config.sample_spec;
+        spec.use_defaults(audio::Format_Pcm, audio::PcmSubformat_Raw,
+                          audio::ChanLayout_Surround, audio::ChanOrder_Smpte,
+                          audio::ChanMask_Surround_7_1_4, 48000);
+        core::nanoseconds_t len = io_config.frame_length;
+        if (len == 0) {
+            len = DefaultFrameLength;
+        }
+        max_frame_size = spec.ns_2_samples_overall(len) * sizeof(audio::sample_t);
+    }
+
+    return true;
+}
+
+bool build_receiver_config(const gengetopt_args_info& args,
+                           pipeline::ReceiverSourceConfig& receiver_config,
+                           rtp::EncodingMap& encoding_map,
+                           const audio::SampleSpec& output_spec) {
+    for (size_t n = 0; n < args.packet_encoding_given; n++) {
+        rtp::Encoding encoding;
+        if (!rtp::parse_encoding(args.packet_encoding_arg[n], encoding)) {
+            roc_log(LogError, "invalid --packet-encoding");
+            return false;
+        }
+
+        const status::StatusCode code = encoding_map.register_encoding(encoding);
+        if (code != status::StatusOK) {
+            roc_log(LogError, "can't register packet encoding: status=%s",
+                    status::code_to_str(code));
+            return false;
+        }
+    }
+
+    switch (args.plc_arg) {
+    case plc_arg_codec:
+        receiver_config.session_defaults.plc.backend = audio::PlcBackend_Codec;
+        break;
+    case plc_arg_none:
+        receiver_config.session_defaults.plc.backend = audio::PlcBackend_None;
+        break;
+    case plc_arg_beep:
+        receiver_config.session_defaults.plc.backend = audio::PlcBackend_Beep;
+        break;
+    default:
+        break;
+    }
+
+    switch (args.resampler_backend_arg) {
+    case resampler_backend_arg_auto:
+        receiver_config.session_defaults.resampler.backend = audio::ResamplerBackend_Auto;
+        break;
+    case resampler_backend_arg_builtin:
+        receiver_config.session_defaults.resampler.backend =
+            audio::ResamplerBackend_Builtin;
+        break;
+    case resampler_backend_arg_speex:
+        receiver_config.session_defaults.resampler.backend =
+            audio::ResamplerBackend_Speex;
+        break;
+    case resampler_backend_arg_speexdec:
+        receiver_config.session_defaults.resampler.backend =
+            audio::ResamplerBackend_SpeexDec;
+        break;
+    case resampler_backend_arg_polyphase:
+        receiver_config.session_defaults.resampler.backend =
+            audio::ResamplerBackend_Polyphase;
+        break;
+    default:
+        break;
+    }
+
+    switch (args.resampler_profile_arg) {
+    case resampler_profile_arg_low:
+        receiver_config.session_defaults.resampler.profile = audio::ResamplerProfile_Low;
+        break;
+    case resampler_profile_arg_medium:
+        receiver_config.session_defaults.resampler.profile =
+            audio::ResamplerProfile_Medium;
+        break;
+    case resampler_profile_arg_high:
+        receiver_config.session_defaults.resampler.profile = audio::ResamplerProfile_High;
+        break;
+    default:
+        break;
+    }
+
+    switch (args.latency_backend_arg) {
+    case latency_backend_arg_niq:
+        receiver_config.session_defaults.latency.tuner_backend =
+            audio::LatencyTunerBackend_Niq;
+        break;
+    default:
+        break;
+    }
+
+    switch (args.latency_profile_arg) {
+    case latency_profile_arg_auto:
+        receiver_config.session_defaults.latency.tuner_profile =
+            audio::LatencyTunerProfile_Auto;
+        break;
+    case latency_profile_arg_responsive:
+        receiver_config.session_defaults.latency.tuner_profile =
+            audio::LatencyTunerProfile_Responsive;
+        break;
+    case latency_profile_arg_gradual:
+        receiver_config.session_defaults.latency.tuner_profile =
+            audio::LatencyTunerProfile_Gradual;
+        break;
+    case latency_profile_arg_intact:
+        receiver_config.session_defaults.latency.tuner_profile =
+            audio::LatencyTunerProfile_Intact;
+        break;
+    default:
+        break;
+    }
+
+    if (args.target_latency_given) {
+        if (strcmp(args.target_latency_arg, "auto") == 0) {
+            receiver_config.session_defaults.latency.target_latency = 0;
+        } else {
+            if (!core::parse_duration(
+                    args.target_latency_arg,
+                    receiver_config.session_defaults.latency.target_latency)) {
+                roc_log(LogError, "invalid --target-latency: bad format");
+                return false;
+            }
+            if (receiver_config.session_defaults.latency.target_latency <= 0) {
+                roc_log(LogError, "invalid --target-latency: should be 'auto' or > 0");
+                return false;
+            }
+        }
+    }
+
+    if (args.latency_tolerance_given) {
+        if (!core::parse_duration(
+                args.latency_tolerance_arg,
+                receiver_config.session_defaults.latency.latency_tolerance)) {
+            roc_log(LogError, "invalid --latency-tolerance: bad format");
+            return false;
+        }
+        if (receiver_config.session_defaults.latency.latency_tolerance <= 0) {
+            roc_log(LogError, "invalid --latency-tolerance: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.start_latency_given) {
+        if (receiver_config.session_defaults.latency.target_latency != 0) {
+            roc_log(
+                LogError,
+                "--start-latency can be specified only in"
+                " adaptive latency mode (i.e. --target-latency is 'auto' or omitted)");
+            return false;
+        }
+        if (!core::parse_duration(
+                args.start_latency_arg,
+                receiver_config.session_defaults.latency.start_target_latency)) {
+            roc_log(LogError, "invalid --start-latency: bad format");
+            return false;
+        }
+        if (receiver_config.session_defaults.latency.start_target_latency <= 0) {
+            roc_log(LogError, "invalid --start-latency: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.min_latency_given || args.max_latency_given) {
+        if (receiver_config.session_defaults.latency.target_latency != 0) {
+            roc_log(
+                LogError,
+                "--min-latency and --max-latency can be specified only in"
+                " adaptive latency mode (i.e. --target-latency is 'auto' or omitted)");
+            return false;
+        }
+        if (!args.min_latency_given || !args.max_latency_given) {
+            roc_log(LogError,
+                    "--min-latency and --max-latency should be specified together");
+            return false;
+        }
+        if (!core::parse_duration(
+                args.min_latency_arg,
+                receiver_config.session_defaults.latency.min_target_latency)) {
+            roc_log(LogError, "invalid --min-latency: bad format");
+            return false;
+        }
+        if (receiver_config.session_defaults.latency.min_target_latency <= 0) {
+            roc_log(LogError, "invalid --min-latency: should be > 0");
+            return false;
+        }
+        if (!core::parse_duration(
+                args.max_latency_arg,
+                receiver_config.session_defaults.latency.max_target_latency)) {
+            roc_log(LogError, "invalid --max-latency: bad format");
+            return false;
+        }
+        if (receiver_config.session_defaults.latency.max_target_latency <= 0) {
+            roc_log(LogError, "invalid --max-latency: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.no_play_timeout_given) {
+        if (!core::parse_duration(
+                args.no_play_timeout_arg,
+                receiver_config.session_defaults.watchdog.no_playback_timeout)) {
+            roc_log(LogError, "invalid --no-play-timeout: bad format");
+            return false;
+        }
+        if (receiver_config.session_defaults.watchdog.no_playback_timeout <= 0) {
+            roc_log(LogError, "invalid --no-play-timeout: should be > 0");
+            return false;
+        }
+    }
+
+    if (args.choppy_play_timeout_given) {
+        if (!core::parse_duration(
+                args.choppy_play_timeout_arg,
+                receiver_config.session_defaults.watchdog.choppy_playback_timeout)) {
+            roc_log(LogError, "invalid --choppy-play-timeout: bad format");
+            return false;
+        }
+        if (receiver_config.session_defaults.watchdog.choppy_playback_timeout <= 0) {
+            roc_log(LogError, "invalid --choppy-play-timeout: should be > 0");
+            return false;
+        }
+    }
+
+    receiver_config.common.enable_profiling = args.prof_flag;
+
+    if (args.dump_given) {
+        receiver_config.common.dumper.dump_file = args.dump_arg;
+    }
+
+    // Pipeline is driven by virtual clock, see Replayer.
+    receiver_config.common.enable_cpu_clock = false;
+    receiver_config.common.enable_auto_reclock = false;
+    receiver_config.common.enable_virtual_clock = true;
+
+    receiver_config.common.output_sample_spec = output_spec;
+
+    if (!receiver_config.common.output_sample_spec.is_complete()) {
+        roc_log(LogError,
+                "can't detect output encoding, try to set it"
+                " explicitly with --io-encoding option");
+        return false;
+    }
+
+    return true;
+}
+
+bool open_output_sink(const gengetopt_args_info& args,
+                      sndio::BackendDispatcher& backend_dispatcher,
+                      const sndio::IoConfig& io_config,
+                      core::IArena& arena,
+                      core::ScopedPtr<sndio::ISink>& output_sink) {
+    address::IoUri output_uri(arena);
+    if (!address::parse_io_uri(args.output_arg, output_uri)) {
+        roc_log(LogError, "invalid --output file URI");
+        return false;
+    }
+
+    if (!output_uri.is_file()) {
+        roc_log(LogError, "invalid --output file URI: should be file");
+        return false;
+    }
+
+    if (output_uri.is_special_file() && !args.io_encoding_given) {
+        roc_log(LogError, "--io-encoding is required when --output is \"-\"");
+        return false;
+    }
+
+    const status::StatusCode code =
+        backend_dispatcher.open_sink(output_uri, io_config, output_sink);
+
+    if (code != status::StatusOK) {
+        roc_log(LogError, "can't open --output file: status=%s",
+                status::code_to_str(code));
+        return false;
+    }
+
+    if (output_sink->has_clock()) {
+        roc_log(LogError, "unsupported --output type");
+        return false;
+    }
+
+    return true;
+}
+
+// Outbound writer for control endpoint.
+// Replay is offline, so RTCP reports generated by receiver are dropped.
+class DiscardWriter : public packet::IWriter, public core::NonCopyable<> {
+public:
+    virtual ROC_NODISCARD status::StatusCode write(const packet::PacketPtr&) {
+        return status::StatusOK;
+    }
+};
+
+// Feeds captured packets into receiver pipeline using virtual clock.
+//
+// Virtual time starts at receive timestamp of the first captured packet, and
+// advances by one frame per iteration. Before reading each frame, replayer
+// delivers all packets with receive timestamp not later than virtual time,
+// and refreshes and reclocks pipeline using virtual time instead of system
+// clock. Hence, pipeline sees the same packet timing as during capture, but
+// doesn't need to wait for it and runs as fast as it can.
+class Replayer : public core::NonCopyable<> {
+public:
+    Replayer(dbgio::PacketCaptureReader& reader,
+             pipeline::ReceiverSource& source,
+             sndio::ISink* sink,
+             audio::FrameFactory& frame_factory,
+             const audio::SampleSpec& sample_spec,
+             core::nanoseconds_t frame_length,
+             core::nanoseconds_t drain_length)
+        : reader_(reader)
+        , source_(source)
+        , sink_(sink)
+        , frame_factory_(frame_factory)
+        , sample_spec_(sample_spec)
+        , frame_size_(sample_spec.ns_2_bytes(frame_length))
+        , frame_duration_(sample_spec.ns_2_stream_timestamp(frame_length))
+        , drain_length_(drain_length)
+        , slot_(NULL)
+        , pending_proto_(address::Proto_None)
+        , has_more_packets_(true)
+        , last_packet_ts_(0)
+        , virtual_time_(0)
+        , n_packets_(0)
+        , n_dropped_(0)
+        , n_frames_(0) {
+        for (size_t n = 0; n < address::Iface_Max; n++) {
+            endpoints_[n] = NULL;
+            failed_endpoints_[n] = false;
+        }
+    }
+
+    bool run() {
+        slot_ = source_.create_slot(pipeline::ReceiverSlotConfig());
+        if (!slot_) {
+            roc_log(LogError, "can't create receiver slot");
+            return false;
+        }
+
+        frame_ = frame_factory_.allocate_frame(frame_size_);
+        if (!frame_) {
+            roc_log(LogError, "can't allocate frame");
+            return false;
+        }
+
+        if (!fetch_packet_()) {
+            return false;
+        }
+
+        if (!pending_packet_) {
+            roc_log(LogError, "capture file is empty");
+            return false;
+        }
+
+        virtual_time_ = packet_time_(*pending_packet_);
+        if (virtual_time_ <= 0) {
+            virtual_time_ = core::timestamp(core::ClockUnix);
+        }
+
+        const core::nanoseconds_t start_time = virtual_time_;
+        const core::nanoseconds_t start_wall_time = core::timestamp(core::ClockMonotonic);
+
+        while (has_more_packets_ || !is_drained_()) {
+            if (!deliver_packets_()) {
+                return false;
+            }
+            if (!process_frame_()) {
+                return false;
+            }
+            virtual_time_ += sample_spec_.stream_timestamp_2_ns(frame_duration_);
+        }
+
+        if (sink_) {
+            status::StatusCode code = status::NoStatus;
+
+            if ((code = sink_->flush()) != status::StatusOK) {
+                roc_log(LogError, "can't flush --output file: status=%s",
+                        status::code_to_str(code));
+                return false;
+            }
+        }
+
+        const core::nanoseconds_t duration = virtual_time_ - start_time;
+        const core::nanoseconds_t elapsed =
+            core::timestamp(core::ClockMonotonic) - start_wall_time;
+
+        roc_log(LogInfo,
+                "replayed %lu packets, dropped %lu packets, skipped %lu records,"
+                " produced %lu frames",
+                (unsigned long)n_packets_, (unsigned long)n_dropped_,
+                (unsigned long)reader_.num_skipped(), (unsigned long)n_frames_);
+
+        roc_log(LogInfo, "replayed %.3fs of traffic in %.3fs: speed=%.1fx",
+                (double)duration / core::Second, (double)elapsed / core::Second,
+                elapsed > 0 ? (double)duration / elapsed : 0.);
+
+        return true;
+    }
+
+private:
+    static core::nanoseconds_t packet_time_(const packet::Packet& packet) {
+        return packet.udp() ? packet.udp()->receive_timestamp : 0;
+    }
+
+    bool is_drained_() const {
+        return source_.num_sessions() == 0
+            || virtual_time_ - last_packet_ts_ >= drain_length_;
+    }
+
+    bool fetch_packet_() {
+        pending_packet_ = NULL;
+
+        if (!has_more_packets_) {
+            return true;
+        }
+
+        const status::StatusCode code = reader_.read(pending_packet_, pending_proto_);
+
+        if (code == status::StatusFinish) {
+            has_more_packets_ = false;
+            return true;
+        }
+
+        if (code != status::StatusOK) {
+            roc_log(LogError, "can't read --input file: status=%s",
+                    status::code_to_str(code));
+            return false;
+        }
+
+        return true;
+    }
+
+    bool deliver_packets_() {
+        while (pending_packet_) {
+            core::nanoseconds_t packet_ts = packet_time_(*pending_packet_);
+            if (packet_ts > virtual_time_) {
+                break;
+            }
+            if (packet_ts <= 0) {
+                // Missing timestamp, deliver immediately.
+                packet_ts = virtual_time_;
+            }
+
+            pipeline::ReceiverEndpoint* endpoint = get_endpoint_(pending_proto_);
+            if (endpoint) {
+                // Let pipeline measure jitter using original arrival times.
+                pending_packet_->udp()->queue_timestamp = packet_ts;
+
+                const status::StatusCode code =
+                    endpoint->inbound_writer().write(pending_packet_);
+                if (code != status::StatusOK) {
+                    roc_log(LogError, "can't write packet to pipeline: status=%s",
+                            status::code_to_str(code));
+                    return false;
+                }
+                n_packets_++;
+            } else {
+                n_dropped_++;
+            }
+
+            last_packet_ts_ = packet_ts;
+
+            if (!fetch_packet_()) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool process_frame_() {
+        status::StatusCode code = status::NoStatus;
+
+        if ((code = source_.refresh(virtual_time_, NULL)) != status::StatusOK) {
+            roc_log(LogError, "can't refresh pipeline: status=%s",
+                    status::code_to_str(code));
+            return false;
+        }
+
+        if (!frame_factory_.reallocate_frame(*frame_, frame_size_)) {
+            roc_log(LogError, "can't allocate frame");
+            return false;
+        }
+
+        code = source_.read(*frame_, frame_duration_, audio::ModeHard);
+        if (code != status::StatusOK && code != status::StatusPart) {
+            roc_log(LogError, "can't read frame from pipeline: status=%s",
+                    status::code_to_str(code));
+            return false;
+        }
+
+        if (sink_) {
+            if ((code = sink_->write(*frame_)) != status::StatusOK) {
+                roc_log(LogError, "can't write frame to --output file: status=%s",
+                        status::code_to_str(code));
+                return false;
+            }
+        }
+
+        source_.reclock(virtual_time_);
+
+        n_frames_++;
+
+        return true;
+    }
+
+    // Endpoints are created on demand, when first packet of given
+    // interface is found in capture.
+    pipeline::ReceiverEndpoint* get_endpoint_(address::Protocol proto) {
+        const address::ProtocolAttrs* attrs =
+            address::ProtocolMap::instance().find_by_id(proto);
+        roc_panic_if(!attrs);
+
+        const address::Interface iface = attrs->iface;
+        if (iface <= address::Iface_Invalid || iface >= address::Iface_Max) {
+            return NULL;
+        }
+
+        if (!endpoints_[iface] && !failed_endpoints_[iface]) {
+            endpoints_[iface] = slot_->add_endpoint(iface, proto, address::SocketAddr(),
+                                                    &discard_writer_);
+            if (!endpoints_[iface]) {
+                roc_log(LogError, "can't create %s endpoint for %s packets",
+                        address::interface_to_str(iface), address::proto_to_str(proto));
+                // Don't retry for every packet.
+                failed_endpoints_[iface] = true;
+            }
+        }
+
+        if (!endpoints_[iface] || endpoints_[iface]->proto() != proto) {
+            return NULL;
+        }
+
+        return endpoints_[iface];
+    }
+
+    dbgio::PacketCaptureReader& reader_;
+    pipeline::ReceiverSource& source_;
+    sndio::ISink* sink_;
+
+    audio::FrameFactory& frame_factory_;
+    audio::FramePtr frame_;
+
+    const audio::SampleSpec sample_spec_;
+    const size_t frame_size_;
+    const packet::stream_timestamp_t frame_duration_;
+    const core::nanoseconds_t drain_length_;
+
+    pipeline::ReceiverSlot* slot_;
+    pipeline::ReceiverEndpoint* endpoints_[address::Iface_Max];
+    bool failed_endpoints_[address::Iface_Max];
+    DiscardWriter discard_writer_;
+
+    packet::PacketPtr pending_packet_;
+    address::Protocol pending_proto_;
+    bool has_more_packets_;
+
+    core::nanoseconds_t last_packet_ts_;
+    core::nanoseconds_t virtual_time_;
+
+    size_t n_packets_;
+    size_t n_dropped_;
+    size_t n_frames_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    core::CrashHandler crash_handler;
+
+    core::HeapArena::set_guards(core::HeapArena_DefaultGuards
+                                | core::HeapArena_LeakGuard);
+    core::HeapArena heap_arena;
+
+    gengetopt_args_info args;
+    const int code = cmdline_parser(argc, argv, &args);
+    if (code != 0) {
+        return code;
+    }
+    core::ScopedRelease<gengetopt_args_info> args_releaser(&args, &cmdline_parser_free);
+
+    init_logger(args);
+
+    sndio::IoConfig io_config;
+    if (!build_io_config(args, io_config)) {
+        return 1;
+    }
+
+    core::nanoseconds_t drain_length = 0;
+    if (!core::parse_duration(args.drain_arg, drain_length) || drain_length < 0) {
+        roc_log(LogError, "invalid --drain: bad format");
+        return 1;
+    }
+
+    size_t max_packet_size = 0, max_frame_size = 0;
+    if (!build_pool_sizes(args, io_config, max_packet_size, max_frame_size)) {
+        return 1;
+    }
+
+    core::SlabPool<packet::Packet> packet_pool("packet_pool", heap_arena);
+    core::SlabPool<core::Buffer> packet_buffer_pool(
+        "packet_buffer_pool", heap_arena, sizeof(core::Buffer) + max_packet_size);
+    core::SlabPool<audio::Frame> frame_pool("frame_pool", heap_arena);
+    core::SlabPool<core::Buffer> frame_buffer_pool(
+        "frame_buffer_pool", heap_arena, sizeof(core::Buffer) + max_frame_size);
+
+    packet::PacketFactory packet_factory(packet_pool, packet_buffer_pool);
+    audio::FrameFactory frame_factory(frame_pool, frame_buffer_pool);
+
+    audio::ProcessorMap processor_map(heap_arena);
+    rtp::EncodingMap encoding_map(heap_arena);
+
+    sndio::BackendDispatcher backend_dispatcher(frame_pool, frame_buffer_pool,
+                                                heap_arena);
+
+    core::ScopedPtr<sndio::ISink> output_sink;
+    if (args.output_given) {
+        if (!open_output_sink(args, backend_dispatcher, io_config, heap_arena,
+                              output_sink)) {
+            return 1;
+        }
+        io_config.sample_spec = output_sink->sample_spec();
+        if (output_sink->frame_length() != 0) {
+            io_config.frame_length = output_sink->frame_length();
+        }
+    } else {
+        io_config.sample_spec.use_defaults(
+            audio::Format_Pcm, audio::PcmSubformat_Raw, audio::ChanLayout_Surround,
+            audio::ChanOrder_Smpte, audio::ChanMask_Surround_Stereo, 44100);
+    }
+
+    if (io_config.frame_length == 0) {
+        io_config.frame_length = DefaultFrameLength;
+    }
+
+    pipeline::ReceiverSourceConfig receiver_config;
+    if (!build_receiver_config(args, receiver_config, encoding_map,
+                               io_config.sample_spec)) {
+        return 1;
+    }
+
+    dbgio::PacketCaptureReader reader(packet_factory);
+    if (reader.open(args.input_arg) != status::StatusOK) {
+        roc_log(LogError, "can't open --input file: %s", args.input_arg);
+        return 1;
+    }
+
+    pipeline::ReceiverSource receiver(receiver_config, processor_map, encoding_map,
+                                      packet_pool, packet_buffer_pool, frame_pool,
+                                      frame_buffer_pool, heap_arena);
+    if (receiver.init_status() != status::StatusOK) {
+        roc_log(LogError, "can't create receiver pipeline: status=%s",
+                status::code_to_str(receiver.init_status()));
+        return 1;
+    }
+
+    Replayer replayer(reader, receiver, output_sink.get(), frame_factory,
+                      io_config.sample_spec, io_config.frame_length, drain_length);
+
+    const bool ok = replayer.run();
+
+    if (output_sink) {
+        const status::StatusCode close_code = output_sink->close();
+        if (close_code != status::StatusOK) {
+            roc_log(LogError, "can't close --output file: status=%s",
+                    status::code_to_str(close_code));
+            return 1;
+        }
+    }
+
+    return ok ? 0 : 1;
+}
@@ -15,9 +15,11 @@
 #include "roc_core/parse_units.h"
 #include "roc_core/scoped_ptr.h"
 #include "roc_core/scoped_release.h"
+#include "roc_core/thread.h"
 #include "roc_dbgio/print_supported.h"
 #include "roc_node/context.h"
 #include "roc_node/sender.h"
+#include "roc_sndio/async_source.h"
 #include "roc_sndio/backend_dispatcher.h"
 #include "roc_sndio/io_pump.h"
 #include "roc_status/code_to_str.h"
@@ -76,11 +78,83 @@ bool build_io_config(const gengetopt_args_info& args, sndio::IoConfig& io_config
         }
     }
 
+    if (args.io_fragsize_given) {
+        if (!core::parse_duration(args.io_fragsize_arg, io_config.buffer.fragment_size)) {
+            roc_log(LogError, "invalid --io-fragsize: bad format");
+            return false;
+        }
+        if (io_config.buffer.fragment_size <= 0) {
+            roc_log(LogError, "invalid --io-fragsize: should be > 0");
+            return false;
+        }
+    }
+
+    io_config.buffer.adjust_latency = !args.io_no_adjust_latency_flag;
+    io_config.callback_mode = args.io_callback_flag;
+    io_config.enable_mmap = args.io_mmap_flag;
+
+    return true;
+}
+
+bool build_thread_config(const gengetopt_args_info& args,
+                         core::ThreadConfig& thread_config) {
+    switch (args.sched_policy_arg) {
+    case sched_policy_arg_fifo:
+        thread_config.policy = core::ThreadPolicy_Fifo;
+        break;
+    case sched_policy_arg_rr:
+        thread_config.policy = core::ThreadPolicy_RoundRobin;
+        break;
+    default:
+        break;
+    }
+
+    if (args.sched_priority_given) {
+        if (thread_config.policy == core::ThreadPolicy_Default) {
+            roc_log(LogError,
+                    "invalid --sched-priority: can be used only with --sched-policy"
+                    " set to 'fifo' or 'rr'");
+            return false;
+        }
+        if (args.sched_priority_arg <= 0) {
+            roc_log(LogError, "invalid --sched-priority: should be > 0");
+            return false;
+        }
+        thread_config.priority = args.sched_priority_arg;
+    }
+
+    if (args.cpu_set_given) {
+        if (!core::parse_cpu_list(args.cpu_set_arg, thread_config.cpu_mask)) {
+            roc_log(LogError, "invalid --cpu-set: bad format");
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool build_async_config(const gengetopt_args_info& args,
+                        const sndio::IoConfig& io_config,
+                        const core::ThreadConfig& thread_config,
+                        sndio::AsyncConfig& async_config) {
+    if (!core::parse_duration(args.io_buffer_arg, async_config.buffer_length)) {
+        roc_log(LogError, "invalid --io-buffer: bad format");
+        return false;
+    }
+    if (async_config.buffer_length <= 0) {
+        roc_log(LogError, "invalid --io-buffer: should be > 0");
+        return false;
+    }
+
+    async_config.frame_length = io_config.frame_length;
+    async_config.thread_config = thread_config;
+
     return true;
 }
 
 bool build_context_config(const gengetopt_args_info& args,
                           const sndio::IoConfig& io_config,
+                          const core::ThreadConfig& thread_config,
                           node::ContextConfig& context_config) {
     if (args.max_packet_size_given) {
         if (!core::parse_size(args.max_packet_size_arg, context_config.max_packet_size)) {
@@ -115,6 +189,19 @@ bool build_context_config(const gengetopt_args_info& args,
         }
     }
 
+
+    context_config.network_thread = thread_config;
+    context_config.control_thread = thread_config;
+    context_config.enable_mlock = args.mlock_flag;
+
+    if (args.prewarm_given) {
+        if (args.prewarm_arg < 0) {
+            roc_log(LogError, "invalid --prewarm: should be >= 0");
+            return false;
+        }
+        context_config.prewarm_packets = (size_t)args.prewarm_arg;
+        context_config.prewarm_frames = (size_t)args.prewarm_arg;
+    }
     return true;
 }
 
@@ -211,6 +298,9 @@ bool build_sender_config(const gengetopt_args_info& args,
     case resampler_backend_arg_speexdec:
         sender_config.resampler.backend = audio::ResamplerBackend_SpeexDec;
         break;
+    case resampler_backend_arg_polyphase:
+        sender_config.resampler.backend = audio::ResamplerBackend_Polyphase;
+        break;
     default:
         break;
     }
@@ -412,6 +502,32 @@ bool open_input_source(sndio::BackendDispatcher& backend_dispatcher,
     return true;
 }
 
+bool open_async_source(audio::FrameFactory& frame_factory,
+                       node::Context& context,
+                       const sndio::AsyncConfig& async_config,
+                       sndio::ISource& input_source,
+                       core::ScopedPtr<sndio::AsyncSource>& async_source) {
+    if (input_source.has_clock()) {
+        roc_log(LogError, "invalid --io-buffer: can be used only when --input is a file");
+        return false;
+    }
+
+    async_source.reset(new (context.arena()) sndio::AsyncSource(
+        input_source, frame_factory, context.arena(), async_config));
+    if (!async_source) {
+        roc_log(LogError, "can't allocate async source");
+        return false;
+    }
+
+    if (async_source->init_status() != status::StatusOK) {
+        roc_log(LogError, "can't create async source: status=%s",
+                status::code_to_str(async_source->init_status()));
+        return false;
+    }
+
+    return true;
+}
+
 bool prepare_sender(const gengetopt_args_info& args,
                     node::Context& context,
                     node::Sender& sender) {
@@ -552,8 +668,13 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    core::ThreadConfig thread_config;
+    if (!build_thread_config(args, thread_config)) {
+        return 1;
+    }
+
     node::ContextConfig context_config;
-    if (!build_context_config(args, io_config, context_config)) {
+    if (!build_context_config(args, io_config, thread_config, context_config)) {
         return 1;
     }
 
@@ -589,11 +710,34 @@ int main(int argc, char** argv) {
     io_config.sample_spec = input_source->sample_spec();
     io_config.frame_length = input_source->frame_length();
 
+    // If requested, read input in background thread, so that slow disk I/O
+    // doesn't stall sender pipeline.
+    audio::FrameFactory frame_factory(context.frame_pool(), context.frame_buffer_pool());
+    core::ScopedPtr<sndio::AsyncSource> async_source;
+
+    if (args.io_buffer_given) {
+        sndio::AsyncConfig async_config;
+        if (!build_async_config(args, io_config, thread_config, async_config)) {
+            return 1;
+        }
+
+        if (!open_async_source(frame_factory, context, async_config, *input_source,
+                               async_source)) {
+            return 1;
+        }
+    }
+
+    sndio::ISource& pump_source = async_source ? *async_source : *input_source;
+
     pipeline::SenderSinkConfig sender_config;
-    if (!build_sender_config(args, sender_config, context, *input_source)) {
+    if (!build_sender_config(args, sender_config, context, pump_source)) {
         return 1;
     }
 
+    // Dumper thread performs blocking file I/O, so it doesn't get realtime
+    // policy, but is kept on the same CPUs as other threads.
+    sender_config.dumper.thread_config.cpu_mask = thread_config.cpu_mask;
+
     node::Sender sender(context, sender_config);
     if (sender.init_status() != status::StatusOK) {
         roc_log(LogError, "can't create sender node: status=%s",
@@ -605,7 +749,7 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    sndio::IoPump pump(context.frame_pool(), context.frame_buffer_pool(), *input_source,
+    sndio::IoPump pump(context.frame_pool(), context.frame_buffer_pool(), pump_source,
                        NULL, sender.sink(), io_config, sndio::IoPump::ModePermanent);
     if (pump.init_status() != status::StatusOK) {
         roc_log(LogError, "can't create io pump: status=%s",
@@ -613,6 +757,9 @@ int main(int argc, char** argv) {
         return 1;
     }
 
+    // Pump runs in main thread, which is the I/O thread of the tool.
+    core::Thread::apply_config(thread_config);
+
     const status::StatusCode status = pump.run();
     if (status != status::StatusOK) {
         roc_log(LogError, "io pump failed: status=%s", status::code_to_str(status));